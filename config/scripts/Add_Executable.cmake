@@ -49,6 +49,9 @@ if ( USE_PROFILER )
 else()
     target_link_libraries( ${EXECNAME} ${BELFEM_LIBS} ${BELFEM_SOLVER_LIBS} ${BELFEM_MATRIX_LIBS} ${BELFEM_IO_LIBS} ${BELFEM_FORTRANLIBS} ${BELFEM_OPENMPLIBS} )
 endif()
+if( NOT APPLE )
+    target_link_libraries( ${EXECNAME} -pthread )
+endif()
 
 
 if( APPLE )
@@ -10,4 +10,9 @@ if (USE_PROFILER)
         set( BELFEM_CXXFLAGS "${BELFEM_CXXFLAGS} -g" )
         set( BELFEM_CFLAGS "${BELFEM_CFLAGS} -g" )
     endif()
-endif()
\ No newline at end of file
+endif()
+
+# hardware counters for the profiler regions, linux only
+if (USE_PERF_EVENT)
+    list( APPEND BELFEM_DEFS "BELFEM_PERF_EVENT" )
+endif()
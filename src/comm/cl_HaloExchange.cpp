@@ -0,0 +1,242 @@
+//
+// Created by Christian Messe on 17.10.26.
+//
+
+#include "cl_HaloExchange.hpp"
+#include "commtools.hpp"
+#include "assert.hpp"
+
+namespace belfem
+{
+    namespace
+    {
+        // tags of the exchanges count down from the last tag of the block
+        // of each pair of procs that is not used by commtools, see comm_tag
+        const int gHaloExchangeFirstTag = 507 ;
+        const int gHaloExchangeNumberOfTags = 64 ;
+
+        // number of exchanges that were created. Exchanges are created
+        // collectively, so all procs have the same count
+        uint gHaloExchangeCounter = 0 ;
+    }
+
+//------------------------------------------------------------------------------
+
+    HaloExchange::HaloExchange(
+            const Vector< proc_t > & aNeighbors,
+            const Cell< Vector< index_t > > & aSendIndices,
+            const Cell< Vector< index_t > > & aReceiveIndices ) :
+            mNeighbors( aNeighbors ),
+            mSendIndices( aSendIndices ),
+            mReceiveIndices( aReceiveIndices ),
+            mMyRank( comm_rank() ),
+            mTag( gHaloExchangeFirstTag - ( int ) ( gHaloExchangeCounter++ % gHaloExchangeNumberOfTags ) )
+    {
+        BELFEM_ERROR( aSendIndices.size() == aNeighbors.length()
+                   && aReceiveIndices.size() == aNeighbors.length(),
+                   "Number of index lists does not match number of neighbors" );
+
+        mSendBuffers.set_size( mNeighbors.length(), Vector< real >() );
+        mReceiveBuffers.set_size( mNeighbors.length(), Vector< real >() );
+    }
+
+//------------------------------------------------------------------------------
+
+    HaloExchange::~HaloExchange()
+    {
+        this->free_requests() ;
+    }
+
+//------------------------------------------------------------------------------
+
+    void
+    HaloExchange::start( const Cell< Vector< real > * > & aFields )
+    {
+        BELFEM_ERROR( ! mIsActive, "Halo exchange was started twice" );
+
+        uint tNumFields = aFields.size() ;
+
+        // the buffer size depends on the number of fields
+        if( tNumFields != mNumberOfFields )
+        {
+            this->create_requests( tNumFields );
+        }
+
+        index_t tNumNeighbors = mNeighbors.length() ;
+
+        // pack the data, field by field
+        for( index_t p=0; p<tNumNeighbors; ++p )
+        {
+            const Vector< index_t > & tIndices = mSendIndices( p );
+            Vector< real > & tBuffer = mSendBuffers( p );
+
+            index_t tN = tIndices.length() ;
+            index_t tCount = 0 ;
+
+            for( uint f=0; f<tNumFields; ++f )
+            {
+                const Vector< real > & tField = *aFields( f );
+
+                for( index_t k=0; k<tN; ++k )
+                {
+                    tBuffer( tCount++ ) = tField( tIndices( k ) );
+                }
+            }
+        }
+
+#ifdef BELFEM_MPI
+        if( mRequests.size() > 0 )
+        {
+            MPI_Startall( mRequests.size(), mRequests.data() );
+        }
+#endif
+        mIsActive = true ;
+    }
+
+//------------------------------------------------------------------------------
+
+    void
+    HaloExchange::finish( Cell< Vector< real > * > & aFields )
+    {
+        BELFEM_ERROR( mIsActive, "Halo exchange was not started" );
+
+        BELFEM_ERROR( aFields.size() == mNumberOfFields,
+                      "Number of fields does not match the started exchange" );
+
+#ifdef BELFEM_MPI
+        if( mRequests.size() > 0 )
+        {
+            CommIdleTimer tIdleTimer ;
+
+            MPI_Waitall( mRequests.size(), mRequests.data(), MPI_STATUSES_IGNORE );
+        }
+#endif
+        index_t tNumNeighbors = mNeighbors.length() ;
+
+        // data that stays on this proc are not sent
+        for( index_t p=0; p<tNumNeighbors; ++p )
+        {
+            if( mNeighbors( p ) == mMyRank )
+            {
+                BELFEM_ERROR( mSendBuffers( p ).length() == mReceiveBuffers( p ).length(),
+                              "Send and receive lists of proc %i do not match",
+                              ( int ) mMyRank );
+
+                mReceiveBuffers( p ) = mSendBuffers( p );
+            }
+        }
+
+        // unpack the data
+        for( index_t p=0; p<tNumNeighbors; ++p )
+        {
+            const Vector< index_t > & tIndices = mReceiveIndices( p );
+            const Vector< real > & tBuffer = mReceiveBuffers( p );
+
+            index_t tN = tIndices.length() ;
+            index_t tCount = 0 ;
+
+            for( uint f=0; f<mNumberOfFields; ++f )
+            {
+                Vector< real > & tField = *aFields( f );
+
+                for( index_t k=0; k<tN; ++k )
+                {
+                    tField( tIndices( k ) ) = tBuffer( tCount++ );
+                }
+            }
+        }
+
+        mIsActive = false ;
+    }
+
+//------------------------------------------------------------------------------
+
+    void
+    HaloExchange::exchange( Cell< Vector< real > * > & aFields )
+    {
+        this->start( aFields );
+        this->finish( aFields );
+    }
+
+//------------------------------------------------------------------------------
+
+    void
+    HaloExchange::create_requests( const uint aNumberOfFields )
+    {
+        this->free_requests() ;
+
+        mNumberOfFields = aNumberOfFields ;
+
+        index_t tNumNeighbors = mNeighbors.length() ;
+
+        for( index_t p=0; p<tNumNeighbors; ++p )
+        {
+            mSendBuffers( p ).set_size( mSendIndices( p ).length() * aNumberOfFields );
+            mReceiveBuffers( p ).set_size( mReceiveIndices( p ).length() * aNumberOfFields );
+        }
+
+#ifdef BELFEM_MPI
+        const proc_t & tMyRank = mMyRank ;
+
+        comm_data_t tDataType = get_comm_datatype( ( real ) 0 );
+
+        mRequests.clear() ;
+
+        // receives first, so that they are posted before the sends
+        for( index_t p=0; p<tNumNeighbors; ++p )
+        {
+            if( mReceiveBuffers( p ).length() > 0 && mNeighbors( p ) != tMyRank )
+            {
+                MPI_Request tRequest ;
+
+                // the tag of this exchange, so that we don't collide with
+                // send/receive or other exchanges
+                MPI_Recv_init( mReceiveBuffers( p ).data(),
+                               comm_length( mReceiveBuffers( p ) ),
+                               tDataType,
+                               mNeighbors( p ),
+                               comm_tag( mNeighbors( p ), tMyRank ) + mTag,
+                               gComm.world(),
+                               &tRequest );
+
+                mRequests.push( tRequest );
+            }
+        }
+
+        for( index_t p=0; p<tNumNeighbors; ++p )
+        {
+            if( mSendBuffers( p ).length() > 0 && mNeighbors( p ) != tMyRank )
+            {
+                MPI_Request tRequest ;
+
+                MPI_Send_init( mSendBuffers( p ).data(),
+                               comm_length( mSendBuffers( p ) ),
+                               tDataType,
+                               mNeighbors( p ),
+                               comm_tag( tMyRank, mNeighbors( p ) ) + mTag,
+                               gComm.world(),
+                               &tRequest );
+
+                mRequests.push( tRequest );
+            }
+        }
+#endif
+    }
+
+//------------------------------------------------------------------------------
+
+    void
+    HaloExchange::free_requests()
+    {
+#ifdef BELFEM_MPI
+        for( MPI_Request & tRequest : mRequests )
+        {
+            MPI_Request_free( &tRequest );
+        }
+        mRequests.clear() ;
+#endif
+        mNumberOfFields = 0 ;
+    }
+
+//------------------------------------------------------------------------------
+}
@@ -0,0 +1,156 @@
+//
+// Created by Christian Messe on 17.10.26.
+//
+
+#ifndef BELFEM_CL_HALOEXCHANGE_HPP
+#define BELFEM_CL_HALOEXCHANGE_HPP
+
+#include "typedefs.hpp"
+#include "assert.hpp"
+#include "cl_Cell.hpp"
+#include "cl_Vector.hpp"
+#include "comm_typedefs.hpp"
+
+namespace belfem
+{
+//------------------------------------------------------------------------------
+
+    /**
+     * point-to-point exchange of shared entity data between neighboring
+     * procs. The communication pattern is set up once, afterwards, each
+     * exchange is one round trip of persistent nonblocking requests that
+     * talks only to the neighbors, and not to the master.
+     *
+     * Between start() and finish(), the caller can do work that does
+     * not touch the received entities, such as assembling interior
+     * elements.
+     *
+     * Each exchange gets its own message tag, so that several exchanges
+     * can be active at the same time. The tag is counted up with every
+     * new exchange, therefore, all procs must create their exchanges
+     * in the same order.
+     */
+    class HaloExchange
+    {
+        // procs this proc talks to
+        Vector< proc_t > mNeighbors ;
+
+        // local indices of the entries that are sent to each neighbor
+        Cell< Vector< index_t > > mSendIndices ;
+
+        // local indices of the entries that are received from each neighbor
+        Cell< Vector< index_t > > mReceiveIndices ;
+
+        // buffers, must not be moved while requests are active
+        Cell< Vector< real > > mSendBuffers ;
+        Cell< Vector< real > > mReceiveBuffers ;
+
+        // rank of this proc, data for itself are copied without MPI
+        proc_t mMyRank ;
+
+        // offset of the message tag of this exchange
+        int mTag ;
+
+        // number of fields the requests were created for
+        uint mNumberOfFields = 0 ;
+
+        // flag telling if an exchange is running
+        bool mIsActive = false ;
+
+#ifdef BELFEM_MPI
+        // persistent requests, first the receives, then the sends
+        Cell< MPI_Request > mRequests ;
+#endif
+
+//------------------------------------------------------------------------------
+    public:
+//------------------------------------------------------------------------------
+
+        /**
+         * @param aNeighbors      : procs to talk to
+         * @param aSendIndices    : for each neighbor, indices that are sent
+         * @param aReceiveIndices : for each neighbor, indices that are received,
+         *                          must match the send order of the neighbor
+         */
+        HaloExchange( const Vector< proc_t > & aNeighbors,
+                      const Cell< Vector< index_t > > & aSendIndices,
+                      const Cell< Vector< index_t > > & aReceiveIndices );
+
+//------------------------------------------------------------------------------
+
+        ~HaloExchange();
+
+//------------------------------------------------------------------------------
+
+        /**
+         * pack the shared entries and post the requests
+         */
+        void
+        start( const Cell< Vector< real > * > & aFields );
+
+//------------------------------------------------------------------------------
+
+        /**
+         * wait for the requests and unpack the received entries
+         */
+        void
+        finish( Cell< Vector< real > * > & aFields );
+
+//------------------------------------------------------------------------------
+
+        /**
+         * tells if start() was called, but not finish()
+         */
+        bool
+        is_active() const ;
+
+//------------------------------------------------------------------------------
+
+        /**
+         * start and finish in one go
+         */
+        void
+        exchange( Cell< Vector< real > * > & aFields );
+
+//------------------------------------------------------------------------------
+
+        /**
+         * the procs this proc talks to
+         */
+        const Vector< proc_t > &
+        neighbors() const ;
+
+//------------------------------------------------------------------------------
+    private:
+//------------------------------------------------------------------------------
+
+        void
+        create_requests( const uint aNumberOfFields );
+
+//------------------------------------------------------------------------------
+
+        void
+        free_requests();
+
+//------------------------------------------------------------------------------
+    };
+
+//------------------------------------------------------------------------------
+
+    inline const Vector< proc_t > &
+    HaloExchange::neighbors() const
+    {
+        return mNeighbors ;
+    }
+
+//------------------------------------------------------------------------------
+
+    inline bool
+    HaloExchange::is_active() const
+    {
+        return mIsActive ;
+    }
+
+//------------------------------------------------------------------------------
+}
+#endif //BELFEM_CL_HALOEXCHANGE_HPP
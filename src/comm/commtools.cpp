@@ -2,11 +2,20 @@
 // Created by Christian Messe on 2019-01-18.
 //
 
+#include <atomic>
+#include <chrono>
+
 #include "commtools.hpp"
 #include "cl_StringList.hpp"
 
 namespace belfem
 {
+    // time in microseconds that this proc spent waiting in barriers and receives
+    static std::atomic< long long unsigned int > gCommIdleTime( 0 );
+
+    // number of running idle timers of this thread, only the outermost one counts
+    static thread_local uint gCommIdleTimerDepth = 0 ;
+
 //------------------------------------------------------------------------------
 
     proc_t
@@ -29,10 +38,47 @@ namespace belfem
     comm_barrier()
     {
 #ifdef BELFEM_MPI
+        CommIdleTimer tIdleTimer ;
+
         MPI_Barrier( gComm.world() );
 #endif
     }
 
+//------------------------------------------------------------------------------
+
+    real
+    comm_idle_time()
+    {
+        return 0.001 * ( real ) gCommIdleTime.load() ;
+    }
+
+//------------------------------------------------------------------------------
+
+    void
+    comm_reset_idle_time()
+    {
+        gCommIdleTime = 0 ;
+    }
+
+//------------------------------------------------------------------------------
+
+    CommIdleTimer::CommIdleTimer() :
+        mStart( std::chrono::steady_clock::now() )
+    {
+        ++gCommIdleTimerDepth ;
+    }
+
+//------------------------------------------------------------------------------
+
+    CommIdleTimer::~CommIdleTimer()
+    {
+        if( --gCommIdleTimerDepth == 0 )
+        {
+            gCommIdleTime += std::chrono::duration_cast< std::chrono::microseconds >(
+                    std::chrono::steady_clock::now() - mStart ).count() ;
+        }
+    }
+
 //------------------------------------------------------------------------------
 
     void
@@ -5,6 +5,7 @@
 #ifndef BELFEM_COMMTOOLS_HPP
 #define BELFEM_COMMTOOLS_HPP
 #include <limits>
+#include <chrono>
 #include <string>
 #include "typedefs.hpp"
 #include "assert.hpp"
@@ -43,6 +44,39 @@ namespace belfem
     void
     comm_barrier();
 
+//------------------------------------------------------------------------------
+
+    /**
+     * time in ms that this proc has spent waiting in comm_barrier
+     * and in blocking receives since the last reset
+     */
+    real
+    comm_idle_time();
+
+//------------------------------------------------------------------------------
+
+    void
+    comm_reset_idle_time();
+
+//------------------------------------------------------------------------------
+
+    /**
+     * adds the time between construction and destruction to the idle time.
+     * placed around blocking waits for other procs. Nested timers,
+     * for example the receive of a length inside the receive of a vector,
+     * are only counted once.
+     */
+    class CommIdleTimer
+    {
+        std::chrono::steady_clock::time_point mStart ;
+
+    public:
+
+        CommIdleTimer();
+
+        ~CommIdleTimer();
+    };
+
 //------------------------------------------------------------------------------
 
     // default communication list to send information to all other procs
@@ -344,6 +378,9 @@ namespace belfem
     receive(  const proc_t aSource, T & aData )
     {
 #ifdef BELFEM_MPI
+        // time spent waiting for the data
+        CommIdleTimer tIdleTimer ;
+
         // get my id
         proc_t tMyRank = gComm.rank();
 
@@ -435,6 +472,9 @@ namespace belfem
              T                        aMyData=std::numeric_limits<T>::quiet_NaN() )
     {
 #ifdef BELFEM_MPI
+        // time spent waiting for the data
+        CommIdleTimer tIdleTimer ;
+
         // get total number of procs
         proc_t tCommSize = gComm.size();
 
@@ -925,6 +965,8 @@ namespace belfem
           Cell< Vector< T >    > & aData )
     {
 #ifdef BELFEM_MPI
+        // time spent waiting for the data
+        CommIdleTimer tIdleTimer ;
 
         // get total number of procs
         proc_t tCommSize = gComm.size();
@@ -1159,6 +1201,8 @@ namespace belfem
              Vector< T >  & aData )
     {
 #ifdef BELFEM_MPI
+        // time spent waiting for the data
+        CommIdleTimer tIdleTimer ;
 
 		// get total number of procs
         proc_t tCommSize = gComm.size();
@@ -1347,6 +1391,8 @@ namespace belfem
              T             * aData )
     {
 #ifdef BELFEM_MPI
+        // time spent waiting for the data
+        CommIdleTimer tIdleTimer ;
 
         // get total number of procs
         proc_t tCommSize = gComm.size();
@@ -1525,6 +1571,8 @@ namespace belfem
              Matrix< T >  & aData )
     {
 #ifdef BELFEM_MPI
+        // time spent waiting for the data
+        CommIdleTimer tIdleTimer ;
 
         // get total number of procs
         proc_t tCommSize = gComm.size();
@@ -1621,6 +1669,8 @@ namespace belfem
              Cell< Matrix< T >    > & aData )
     {
 #ifdef BELFEM_MPI
+        // time spent waiting for the data
+        CommIdleTimer tIdleTimer ;
 
         // get total number of procs
         proc_t tCommSize = gComm.size();
@@ -1737,6 +1787,122 @@ namespace belfem
 #endif
     }
 
+//==============================================================================
+// VECTOR from all procs to all procs
+//==============================================================================
+
+    /**
+     * every proc sends entry p of aSendData to proc p and receives
+     * the vector that proc p has prepared for him into entry p of
+     * aReceiveData. Must be called by all procs.
+     *
+     * Only the lengths are sent to all procs. The data are sent with
+     * nonblocking requests, and only between procs that actually
+     * share entries. Empty vectors are allowed.
+     *
+     *  @param[ in ]   aSendData    : one vector per target proc
+     *  @param[ out ]  aReceiveData : one vector per source proc
+     */
+    template< typename T >
+    void
+    exchange( Cell< Vector< T > > & aSendData,
+              Cell< Vector< T > > & aReceiveData )
+    {
+        // time spent waiting for the data
+        CommIdleTimer tIdleTimer ;
+
+        // get total number of procs
+        proc_t tCommSize = comm_size();
+
+        // get my rank
+        proc_t tMyRank = comm_rank();
+
+        BELFEM_ASSERT( ( proc_t ) aSendData.size() == tCommSize,
+                       "Send data must contain one vector per proc" );
+
+        aReceiveData.set_size( tCommSize, Vector< T >() );
+
+        // my own data is not sent
+        aReceiveData( tMyRank ) = aSendData( tMyRank );
+
+#ifdef BELFEM_MPI
+        comm_data_t tLengthType = get_comm_datatype( ( int ) 0 );
+        comm_data_t tDataType   = get_comm_datatype( ( T ) 0 );
+
+        Vector< int > tSendLengths( tCommSize, 0 );
+        Vector< int > tReceiveLengths( tCommSize, 0 );
+
+        Cell< MPI_Request > tRequests ;
+
+        // step 1: tell each proc how much data it gets
+        for( proc_t p = 0; p < tCommSize; ++p )
+        {
+            if( p != tMyRank )
+            {
+                MPI_Request tRequest ;
+                MPI_Irecv( &tReceiveLengths( p ), 1, tLengthType, p,
+                           comm_tag( p, tMyRank ) + 508,
+                           gComm.world(), &tRequest );
+                tRequests.push( tRequest );
+            }
+        }
+
+        for( proc_t p = 0; p < tCommSize; ++p )
+        {
+            if( p != tMyRank )
+            {
+                tSendLengths( p ) = comm_length( aSendData( p ) );
+
+                MPI_Request tRequest ;
+                MPI_Isend( &tSendLengths( p ), 1, tLengthType, p,
+                           comm_tag( tMyRank, p ) + 508,
+                           gComm.world(), &tRequest );
+                tRequests.push( tRequest );
+            }
+        }
+
+        MPI_Waitall( tRequests.size(), tRequests.data(), MPI_STATUSES_IGNORE );
+        tRequests.clear() ;
+
+        // step 2: exchange the data with the procs that share entries
+        for( proc_t p = 0; p < tCommSize; ++p )
+        {
+            if( p != tMyRank )
+            {
+                aReceiveData( p ).set_size( tReceiveLengths( p ) );
+
+                if( tReceiveLengths( p ) > 0 )
+                {
+                    MPI_Request tRequest ;
+                    MPI_Irecv( aReceiveData( p ).data(), tReceiveLengths( p ), tDataType, p,
+                               comm_tag( p, tMyRank ) + 509,
+                               gComm.world(), &tRequest );
+                    tRequests.push( tRequest );
+                }
+            }
+        }
+
+        for( proc_t p = 0; p < tCommSize; ++p )
+        {
+            if( p != tMyRank && tSendLengths( p ) > 0 )
+            {
+                MPI_Request tRequest ;
+                MPI_Isend( aSendData( p ).data(), tSendLengths( p ), tDataType, p,
+                           comm_tag( tMyRank, p ) + 509,
+                           gComm.world(), &tRequest );
+                tRequests.push( tRequest );
+            }
+        }
+
+        if( tRequests.size() > 0 )
+        {
+            MPI_Waitall( tRequests.size(), tRequests.data(), MPI_STATUSES_IGNORE );
+        }
+#endif
+    }
+
+//------------------------------------------------------------------------------
+
     /**
      * this is a simple test routine to check the MPI functionality.
      * @param aMessage
@@ -0,0 +1,137 @@
+//
+// Created by Christian Messe on 17.10.26.
+//
+
+#include "cl_AsyncWriter.hpp"
+#include "assert.hpp"
+
+namespace belfem
+{
+//------------------------------------------------------------------------------
+
+    AsyncWriter::AsyncWriter( const luint aMaxBytes ) :
+        mMaxBytes( aMaxBytes ),
+        mThread( &AsyncWriter::run, this )
+    {
+
+    }
+
+//------------------------------------------------------------------------------
+
+    AsyncWriter::~AsyncWriter()
+    {
+        {
+            std::lock_guard< std::mutex > tLock( mMutex );
+            mFinish = true ;
+        }
+        mWakeWriter.notify_one() ;
+
+        // the thread writes all remaining jobs before it returns
+        mThread.join() ;
+    }
+
+//------------------------------------------------------------------------------
+
+    void
+    AsyncWriter::push( std::function< string() > aJob, const luint aBytes )
+    {
+        {
+            std::unique_lock< std::mutex > tLock( mMutex );
+
+            this->check_error() ;
+
+            // a job that is larger than the limit waits until the queue is empty
+            mJobDone.wait( tLock, [ this, aBytes ]
+                { return mStagedBytes == 0 || mStagedBytes + aBytes <= mMaxBytes || ! mError.empty() ; } );
+
+            this->check_error() ;
+
+            mQueue.push_back( { std::move( aJob ), aBytes } );
+            mStagedBytes += aBytes ;
+        }
+        mWakeWriter.notify_one() ;
+    }
+
+//------------------------------------------------------------------------------
+
+    void
+    AsyncWriter::flush()
+    {
+        std::unique_lock< std::mutex > tLock( mMutex );
+
+        mJobDone.wait( tLock, [ this ]
+            { return ( mQueue.empty() && ! mBusy ) || ! mError.empty() ; } );
+
+        this->check_error() ;
+    }
+
+//------------------------------------------------------------------------------
+
+    luint
+    AsyncWriter::staged_bytes()
+    {
+        std::lock_guard< std::mutex > tLock( mMutex );
+        return mStagedBytes ;
+    }
+
+//------------------------------------------------------------------------------
+
+    void
+    AsyncWriter::run()
+    {
+        std::unique_lock< std::mutex > tLock( mMutex );
+
+        while( true )
+        {
+            mWakeWriter.wait( tLock, [ this ] { return mFinish || ! mQueue.empty() ; } );
+
+            if( mQueue.empty() )
+            {
+                // finish flag is set and nothing is left to write
+                break ;
+            }
+
+            Job tJob = std::move( mQueue.front() );
+            mQueue.pop_front() ;
+            mBusy = true ;
+
+            // write without holding the lock
+            tLock.unlock() ;
+
+            string tError ;
+            try
+            {
+                tError = tJob.mFunction() ;
+            }
+            catch( std::exception & aException )
+            {
+                tError = aException.what() ;
+            }
+
+            // free the snapshot before the memory is released for new jobs
+            tJob.mFunction = nullptr ;
+
+            tLock.lock() ;
+
+            if( ! tError.empty() && mError.empty() )
+            {
+                mError = tError ;
+            }
+
+            mStagedBytes -= tJob.mBytes ;
+            mBusy = false ;
+
+            mJobDone.notify_all() ;
+        }
+    }
+
+//------------------------------------------------------------------------------
+
+    void
+    AsyncWriter::check_error()
+    {
+        BELFEM_ERROR( mError.empty(), "asynchronous write failed: %s", mError.c_str() );
+    }
+
+//------------------------------------------------------------------------------
+}
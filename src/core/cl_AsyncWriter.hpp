@@ -0,0 +1,134 @@
+//
+// Created by Christian Messe on 17.10.26.
+//
+
+#ifndef BELFEM_CL_ASYNCWRITER_HPP
+#define BELFEM_CL_ASYNCWRITER_HPP
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <deque>
+
+#include "typedefs.hpp"
+
+namespace belfem
+{
+//------------------------------------------------------------------------------
+
+    /**
+     * runs output jobs on a dedicated thread, so that writing files
+     * overlaps with the computation. The jobs are executed in the order
+     * in which they were pushed. Each job must only work on data that
+     * it owns, usually a snapshot of the fields. A job returns an empty
+     * string on success, or an error message. Jobs must neither throw
+     * nor exit, since they run on another thread. The first error
+     * is raised by the next push or flush.
+     *
+     * The memory of the staged snapshots is bounded: push blocks
+     * until enough jobs are written to make room for the new one.
+     */
+    class AsyncWriter
+    {
+        // a job and the memory of the data it holds
+        struct Job
+        {
+            std::function< string() > mFunction ;
+            luint mBytes ;
+        };
+
+        // maximum memory of all staged jobs
+        const luint mMaxBytes ;
+
+        // memory of all staged jobs, including the running one
+        luint mStagedBytes = 0 ;
+
+        // jobs that are waiting
+        std::deque< Job > mQueue ;
+
+        // tells if the thread is currently writing
+        bool mBusy = false ;
+
+        // tells the thread to stop
+        bool mFinish = false ;
+
+        // message of the first job that failed
+        string mError ;
+
+        std::mutex mMutex ;
+
+        // wakes the writing thread
+        std::condition_variable mWakeWriter ;
+
+        // wakes threads that wait for a job to finish
+        std::condition_variable mJobDone ;
+
+        std::thread mThread ;
+
+//------------------------------------------------------------------------------
+    public:
+//------------------------------------------------------------------------------
+
+        /**
+         * @param aMaxBytes  upper limit for the memory of staged data
+         */
+        AsyncWriter( const luint aMaxBytes = 1073741824 );
+
+//------------------------------------------------------------------------------
+
+        /**
+         * writes all remaining jobs before the thread is stopped
+         */
+        ~AsyncWriter();
+
+//------------------------------------------------------------------------------
+
+        /**
+         * add a job to the queue. Blocks while the staged memory
+         * plus aBytes would exceed the limit
+         */
+        void
+        push( std::function< string() > aJob, const luint aBytes );
+
+//------------------------------------------------------------------------------
+
+        /**
+         * wait until all jobs are written
+         */
+        void
+        flush();
+
+//------------------------------------------------------------------------------
+
+        /**
+         * memory of the data that has not been written yet
+         */
+        luint
+        staged_bytes() ;
+
+//------------------------------------------------------------------------------
+    private:
+//------------------------------------------------------------------------------
+
+        /**
+         * loop of the writing thread
+         */
+        void
+        run();
+
+//------------------------------------------------------------------------------
+
+        /**
+         * throw an error on the calling thread if a job has failed.
+         * Must be called with locked mutex
+         */
+        void
+        check_error();
+
+//------------------------------------------------------------------------------
+    };
+
+//------------------------------------------------------------------------------
+}
+#endif //BELFEM_CL_ASYNCWRITER_HPP
@@ -3,16 +3,151 @@
 //
 
 #include <iostream>
+#include <fstream>
+#include <chrono>
+#include <atomic>
+#include <thread>
 
 #ifdef BELFEM_PROFILER
 #include <gperftools/profiler.h>
 #endif
+#ifdef OMP
+#include <omp.h>
+#endif
+#if defined( BELFEM_PERF_EVENT ) && defined( __linux__ )
+#include <cstring>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
 #include "commtools.hpp"
 #include "cl_Logger.hpp"
+#include "cl_Cell.hpp"
+#include "cl_Map.hpp"
+#include "cl_Vector.hpp"
 #include "cl_Profiler.hpp"
 
 namespace belfem
 {
+//------------------------------------------------------------------------------
+
+    // number of hardware counters per region
+    const uint gProfilerNumCounters = 3 ;
+
+    // accumulated data of one region
+    struct ProfilerRegionData
+    {
+        string mLabel ;
+        uint   mParent = BELFEM_UINT_MAX ;
+        luint  mCalls = 0 ;
+        luint  mNanoseconds = 0 ;
+        luint  mCounters[ gProfilerNumCounters ] = { 0, 0, 0 } ;
+
+        // values when the region was opened
+        luint  mStart = 0 ;
+        luint  mCounterStart[ gProfilerNumCounters ] = { 0, 0, 0 } ;
+
+        Map< string, uint > mChildren ;
+    };
+
+    // read by all threads, the region data are only touched by gProfilerThread
+    static std::atomic< bool > gProfilerEnabled( false );
+
+    // the thread that has switched the timers on
+    static std::thread::id gProfilerThread ;
+
+    // all regions, the first one is the root
+    static Cell< ProfilerRegionData > gProfilerRegions ;
+
+    // the innermost open region
+    static uint gProfilerActive = 0 ;
+
+    // perf_event file descriptors, -1 if not open
+    static int gProfilerCounterFiles[ gProfilerNumCounters ] = { -1, -1, -1 };
+
+//------------------------------------------------------------------------------
+
+    static luint
+    profiler_now()
+    {
+        return std::chrono::duration_cast< std::chrono::nanoseconds >(
+                std::chrono::steady_clock::now().time_since_epoch() ).count() ;
+    }
+
+//------------------------------------------------------------------------------
+
+#if defined( BELFEM_PERF_EVENT ) && defined( __linux__ )
+    static int
+    profiler_open_counter( const luint aConfig )
+    {
+        struct perf_event_attr tAttr ;
+        std::memset( &tAttr, 0, sizeof( tAttr ) );
+
+        tAttr.type           = PERF_TYPE_HARDWARE ;
+        tAttr.size           = sizeof( tAttr );
+        tAttr.config         = aConfig ;
+        tAttr.exclude_kernel = 1 ;
+        tAttr.exclude_hv     = 1 ;
+
+        // this thread, any cpu
+        return ( int ) syscall( __NR_perf_event_open, &tAttr, 0, -1, -1, 0 );
+    }
+#endif
+
+//------------------------------------------------------------------------------
+
+    static void
+    profiler_read_counters( luint * aValues )
+    {
+        for( uint k=0; k<gProfilerNumCounters; ++k )
+        {
+            aValues[ k ] = 0 ;
+#if defined( BELFEM_PERF_EVENT ) && defined( __linux__ )
+            if( gProfilerCounterFiles[ k ] >= 0 )
+            {
+                long long unsigned int tValue = 0 ;
+                if( read( gProfilerCounterFiles[ k ], &tValue, sizeof( tValue ) )
+                    == ( ssize_t ) sizeof( tValue ) )
+                {
+                    aValues[ k ] = tValue ;
+                }
+            }
+#endif
+        }
+    }
+
+//------------------------------------------------------------------------------
+
+    static void
+    profiler_open_region( const uint aIndex )
+    {
+        ProfilerRegionData & tRegion = gProfilerRegions( aIndex );
+        profiler_read_counters( tRegion.mCounterStart );
+        tRegion.mStart = profiler_now() ;
+    }
+
+//------------------------------------------------------------------------------
+
+    static void
+    profiler_close_region( const uint aIndex )
+    {
+        luint tStop = profiler_now() ;
+
+        ProfilerRegionData & tRegion = gProfilerRegions( aIndex );
+
+        luint tCounters[ gProfilerNumCounters ];
+        profiler_read_counters( tCounters );
+
+        tRegion.mNanoseconds += tStop - tRegion.mStart ;
+        ++tRegion.mCalls ;
+
+        for( uint k=0; k<gProfilerNumCounters; ++k )
+        {
+            tRegion.mCounters[ k ] += tCounters[ k ] - tRegion.mCounterStart[ k ];
+        }
+    }
+
+//------------------------------------------------------------------------------
 //------------------------------------------------------------------------------
 
     Profiler::Profiler( const string aLogFile )
@@ -78,5 +213,306 @@ namespace belfem
 #endif
     }
 
+//------------------------------------------------------------------------------
+
+    real
+    Profiler::idle_time()
+    {
+        real aIdleTime = comm_idle_time() ;
+
+        comm_reset_idle_time() ;
+
+#ifdef BELFEM_MPI
+        if( gComm.size() > 1 )
+        {
+            real tMyIdleTime = aIdleTime ;
+
+            MPI_Allreduce( &tMyIdleTime, &aIdleTime, 1, MPI_DOUBLE, MPI_MAX, gComm.world() );
+        }
+#endif
+        return aIdleTime ;
+    }
+
+//------------------------------------------------------------------------------
+
+    void
+    Profiler::enable_regions( const bool aSwitch, const bool aHardwareCounters )
+    {
+        if( aSwitch && ! gProfilerEnabled )
+        {
+            if( gProfilerRegions.size() == 0 )
+            {
+                ProfilerRegionData tRoot ;
+                tRoot.mLabel = "total" ;
+                gProfilerRegions.push( tRoot );
+            }
+
+#if defined( BELFEM_PERF_EVENT ) && defined( __linux__ )
+            if( aHardwareCounters && gProfilerCounterFiles[ 0 ] < 0 )
+            {
+                gProfilerCounterFiles[ 0 ] = profiler_open_counter( PERF_COUNT_HW_CPU_CYCLES );
+                gProfilerCounterFiles[ 1 ] = profiler_open_counter( PERF_COUNT_HW_INSTRUCTIONS );
+                gProfilerCounterFiles[ 2 ] = profiler_open_counter( PERF_COUNT_HW_CACHE_MISSES );
+
+                if( gProfilerCounterFiles[ 0 ] < 0 && gComm.rank() == 0 )
+                {
+                    message( 4, " Warning: could not open hardware counters, check perf_event_paranoid\n" );
+                }
+            }
+#else
+            if( aHardwareCounters && gComm.rank() == 0 )
+            {
+                message( 4, " Warning: hardware counters need a build with USE_PERF_EVENT\n" );
+            }
+#endif
+            gProfilerThread = std::this_thread::get_id() ;
+            gProfilerActive = 0 ;
+            profiler_open_region( 0 );
+        }
+        else if( ! aSwitch && gProfilerEnabled )
+        {
+            profiler_close_region( 0 );
+        }
+
+        gProfilerEnabled = aSwitch ;
+    }
+
+//------------------------------------------------------------------------------
+
+    bool
+    Profiler::regions_enabled()
+    {
+        return gProfilerEnabled ;
+    }
+
+//------------------------------------------------------------------------------
+
+    void
+    Profiler::reset_regions()
+    {
+        bool tEnabled = gProfilerEnabled ;
+
+        gProfilerEnabled = false ;
+        gProfilerRegions.clear() ;
+
+        if( tEnabled )
+        {
+            Profiler::enable_regions( true );
+        }
+    }
+
+//------------------------------------------------------------------------------
+
+    void
+    Profiler::report( const string & aPath )
+    {
+        // the root region is closed for the report and reopened afterwards
+        bool tEnabled = gProfilerEnabled ;
+
+        if( tEnabled )
+        {
+            profiler_close_region( 0 );
+        }
+
+        // paths of the local regions, parents are always listed before their children
+        uint tNumLocal = gProfilerRegions.size() ;
+
+        Cell< string > tPaths( tNumLocal, "" );
+        Map< string, uint > tLocalMap ;
+
+        for( uint r=0; r<tNumLocal; ++r )
+        {
+            const ProfilerRegionData & tRegion = gProfilerRegions( r );
+
+            tPaths( r ) = tRegion.mParent == BELFEM_UINT_MAX ?
+                    tRegion.mLabel : tPaths( tRegion.mParent ) + "/" + tRegion.mLabel ;
+
+            tLocalMap[ tPaths( r ) ] = r ;
+        }
+
+        // the region list of the master is used for all procs
+        if( gComm.size() > 1 )
+        {
+            if( gComm.rank() == 0 )
+            {
+                Vector< proc_t > tCommList ;
+                create_master_commlist( tCommList );
+                send( tCommList, tPaths );
+            }
+            else
+            {
+                receive( 0, tPaths );
+            }
+        }
+
+        uint tNumRegions = tPaths.size() ;
+
+        // times in ms, calls and counters of this proc
+        Vector< real > tTimes( tNumRegions, 0.0 );
+        Vector< real > tCalls( tNumRegions, 0.0 );
+        Vector< real > tCounters( tNumRegions * gProfilerNumCounters, 0.0 );
+
+        for( uint r=0; r<tNumRegions; ++r )
+        {
+            if( tLocalMap.key_exists( tPaths( r ) ) )
+            {
+                const ProfilerRegionData & tRegion = gProfilerRegions( tLocalMap( tPaths( r ) ) );
+
+                tTimes( r ) = 1e-6 * ( real ) tRegion.mNanoseconds ;
+                tCalls( r ) = ( real ) tRegion.mCalls ;
+
+                for( uint k=0; k<gProfilerNumCounters; ++k )
+                {
+                    tCounters( r * gProfilerNumCounters + k ) = ( real ) tRegion.mCounters[ k ];
+                }
+            }
+        }
+
+        Vector< real > tMinTimes( tTimes );
+        Vector< real > tMaxTimes( tTimes );
+        Vector< real > tSumTimes( tTimes );
+
+#ifdef BELFEM_MPI
+        if( gComm.size() > 1 && tNumRegions > 0 )
+        {
+            MPI_Reduce( tTimes.data(), tMinTimes.data(), tNumRegions, MPI_DOUBLE, MPI_MIN, 0, gComm.world() );
+            MPI_Reduce( tTimes.data(), tMaxTimes.data(), tNumRegions, MPI_DOUBLE, MPI_MAX, 0, gComm.world() );
+            MPI_Reduce( tTimes.data(), tSumTimes.data(), tNumRegions, MPI_DOUBLE, MPI_SUM, 0, gComm.world() );
+
+            Vector< real > tMyCalls( tCalls );
+            MPI_Reduce( tMyCalls.data(), tCalls.data(), tNumRegions, MPI_DOUBLE, MPI_SUM, 0, gComm.world() );
+
+            Vector< real > tMyCounters( tCounters );
+            MPI_Reduce( tMyCounters.data(), tCounters.data(), tNumRegions * gProfilerNumCounters,
+                        MPI_DOUBLE, MPI_SUM, 0, gComm.world() );
+        }
+#endif
+
+        if( gComm.rank() == 0 && tNumRegions > 0 )
+        {
+            real tNumProcs = ( real ) gComm.size() ;
+
+            message( 1, "\n Profiler regions ( times in ms over %i procs ):\n\n", ( int ) gComm.size() );
+            message( 1, " %-40s %10s %12s %12s %12s\n", "region", "calls", "min", "avg", "max" );
+
+            // depth and start time of each region, for the indentation and the trace
+            Vector< uint > tDepth( tNumRegions, 0 );
+            Vector< real > tStart( tNumRegions, 0.0 );
+            Vector< real > tNextChild( tNumRegions, 0.0 );
+
+            for( uint r=0; r<tNumRegions; ++r )
+            {
+                const ProfilerRegionData & tRegion = gProfilerRegions( r );
+
+                if( tRegion.mParent != BELFEM_UINT_MAX )
+                {
+                    tDepth( r ) = tDepth( tRegion.mParent ) + 1 ;
+
+                    // children are laid out one after another inside their parent
+                    tStart( r ) = tNextChild( tRegion.mParent );
+                    tNextChild( tRegion.mParent ) += tSumTimes( r ) / tNumProcs ;
+                }
+                tNextChild( r ) = tStart( r );
+
+                string tLabel = string( 2 * tDepth( r ), ' ' ) + tRegion.mLabel ;
+
+                message( 1, " %-40s %10lu %12.3f %12.3f %12.3f\n",
+                         tLabel.c_str(),
+                         ( long unsigned int ) tCalls( r ),
+                         tMinTimes( r ),
+                         tSumTimes( r ) / tNumProcs,
+                         tMaxTimes( r ) );
+            }
+            message( 1, "\n" );
+
+            if( ! aPath.empty() )
+            {
+                std::ofstream tFile( aPath );
+
+                // Chrome trace format, times in microseconds
+                tFile << "{\n  \"displayTimeUnit\": \"ms\",\n  \"traceEvents\": [\n" ;
+
+                for( uint r=0; r<tNumRegions; ++r )
+                {
+                    tFile << "    { \"name\": \"" << gProfilerRegions( r ).mLabel
+                          << "\", \"ph\": \"X\", \"pid\": 0, \"tid\": 0"
+                          << ", \"ts\": " << 1000.0 * tStart( r )
+                          << ", \"dur\": " << 1000.0 * tSumTimes( r ) / tNumProcs
+                          << ", \"args\": { \"path\": \"" << tPaths( r )
+                          << "\", \"calls\": " << ( long unsigned int ) tCalls( r )
+                          << ", \"min_ms\": " << tMinTimes( r )
+                          << ", \"max_ms\": " << tMaxTimes( r )
+                          << ", \"cycles\": " << tCounters( r * gProfilerNumCounters )
+                          << ", \"instructions\": " << tCounters( r * gProfilerNumCounters + 1 )
+                          << ", \"cache_misses\": " << tCounters( r * gProfilerNumCounters + 2 )
+                          << " } }" << ( r + 1 < tNumRegions ? ",\n" : "\n" );
+                }
+
+                tFile << "  ]\n}\n" ;
+                tFile.close() ;
+            }
+        }
+
+        if( tEnabled )
+        {
+            profiler_open_region( 0 );
+        }
+    }
+
+//------------------------------------------------------------------------------
+
+    ProfilerRegion::ProfilerRegion( const char * aLabel )
+    {
+        if( ! gProfilerEnabled )
+        {
+            return ;
+        }
+
+        // regions of background threads, such as the AsyncWriter, are ignored
+        if( std::this_thread::get_id() != gProfilerThread )
+        {
+            return ;
+        }
+#ifdef OMP
+        if( omp_in_parallel() )
+        {
+            return ;
+        }
+#endif
+        ProfilerRegionData & tParent = gProfilerRegions( gProfilerActive );
+
+        if( tParent.mChildren.key_exists( aLabel ) )
+        {
+            mIndex = tParent.mChildren( aLabel );
+        }
+        else
+        {
+            mIndex = gProfilerRegions.size() ;
+            tParent.mChildren[ aLabel ] = mIndex ;
+
+            ProfilerRegionData tRegion ;
+            tRegion.mLabel  = aLabel ;
+            tRegion.mParent = gProfilerActive ;
+
+            // note that tParent is invalid from here on
+            gProfilerRegions.push( tRegion );
+        }
+
+        gProfilerActive = mIndex ;
+        profiler_open_region( mIndex );
+    }
+
+//------------------------------------------------------------------------------
+
+    ProfilerRegion::~ProfilerRegion()
+    {
+        // the region is also closed if the timers were switched off meanwhile
+        if( mIndex != BELFEM_UINT_MAX && mIndex < gProfilerRegions.size() )
+        {
+            profiler_close_region( mIndex );
+            gProfilerActive = gProfilerRegions( mIndex ).mParent ;
+        }
+    }
+
 //------------------------------------------------------------------------------
 }
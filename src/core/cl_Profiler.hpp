@@ -35,6 +35,80 @@ namespace belfem
         void
         stop();
 
+//------------------------------------------------------------------------------
+
+        /**
+         * returns the longest time in ms that any proc spent waiting
+         * in barriers since the last call, and resets the counters.
+         * Must be called by all procs.
+         */
+        static real
+        idle_time();
+
+//------------------------------------------------------------------------------
+
+        /**
+         * switch the timers of the hot path regions on or off.
+         * If aHardwareCounters is set and BELFEM is built with USE_PERF_EVENT,
+         * cycles, instructions and cache misses are counted as well.
+         */
+        static void
+        enable_regions( const bool aSwitch, const bool aHardwareCounters=false );
+
+//------------------------------------------------------------------------------
+
+        /**
+         * tells if the region timers are active
+         */
+        static bool
+        regions_enabled();
+
+//------------------------------------------------------------------------------
+
+        /**
+         * reduce the regions over all procs, print the region tree
+         * with min, avg and max times on the master and write
+         * a Chrome trace to aPath, if a path is given.
+         * Regions that the master has not seen are not listed.
+         * Must be called by all procs.
+         */
+        static void
+        report( const string & aPath="" );
+
+//------------------------------------------------------------------------------
+
+        /**
+         * forget all collected region data
+         */
+        static void
+        reset_regions();
+
+//------------------------------------------------------------------------------
+    };
+
+//------------------------------------------------------------------------------
+
+    /**
+     * scoped timer for a region of the hot path. A region that is opened
+     * while another one is active is listed below it in the report.
+     * Regions inside parallel OpenMP sections and regions on other threads
+     * than the one that has switched the timers on are ignored.
+     */
+    class ProfilerRegion
+    {
+        // index of this region, BELFEM_UINT_MAX if the timers are off
+        uint mIndex = BELFEM_UINT_MAX ;
+
+//------------------------------------------------------------------------------
+    public:
+//------------------------------------------------------------------------------
+
+        ProfilerRegion( const char * aLabel );
+
+//------------------------------------------------------------------------------
+
+        ~ProfilerRegion();
+
 //------------------------------------------------------------------------------
     };
 }
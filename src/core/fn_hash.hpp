@@ -0,0 +1,52 @@
+//
+// Created by Christian Messe on 17.10.26.
+//
+
+#ifndef BELFEM_FN_HASH_HPP
+#define BELFEM_FN_HASH_HPP
+
+#include <cstddef>
+#include "typedefs.hpp"
+
+namespace belfem
+{
+//------------------------------------------------------------------------------
+
+    /**
+     * 64-bit FNV-1a hash of raw data. Not cryptographic, but good enough
+     * to tell if cached data still belong to the current problem.
+     * Hashes can be chained by passing the previous result as seed.
+     */
+    inline luint
+    hash_bytes( const void * aData,
+                const std::size_t aNumberOfBytes,
+                const luint aSeed = 14695981039346656037UL )
+    {
+        const unsigned char * tData = static_cast< const unsigned char * >( aData );
+
+        luint aHash = aSeed ;
+
+        for( std::size_t k=0; k<aNumberOfBytes; ++k )
+        {
+            aHash ^= tData[ k ];
+            aHash *= 1099511628211UL ;
+        }
+
+        return aHash ;
+    }
+
+//------------------------------------------------------------------------------
+
+    /**
+     * add a single value to a hash
+     */
+    template< typename T >
+    inline luint
+    hash_value( const T & aValue, const luint aSeed = 14695981039346656037UL )
+    {
+        return hash_bytes( & aValue, sizeof( T ), aSeed );
+    }
+
+//------------------------------------------------------------------------------
+}
+#endif //BELFEM_FN_HASH_HPP
@@ -0,0 +1,50 @@
+//
+// Created by Christian Messe on 17.10.26.
+//
+
+#ifndef BELFEM_THREADTOOLS_HPP
+#define BELFEM_THREADTOOLS_HPP
+
+#ifdef OMP
+#include <omp.h>
+#endif
+
+#include "typedefs.hpp"
+
+namespace belfem
+{
+//------------------------------------------------------------------------------
+
+    /**
+     * returns the index of the calling thread. Returns zero
+     * outside of a parallel region or if OpenMP is not used
+     */
+    inline uint
+    thread_index()
+    {
+#ifdef OMP
+        return ( uint ) omp_get_thread_num() ;
+#else
+        return 0 ;
+#endif
+    }
+
+//------------------------------------------------------------------------------
+
+    /**
+     * returns the maximum number of threads that are available
+     * for a parallel region. Returns one if OpenMP is not used
+     */
+    inline uint
+    max_number_of_threads()
+    {
+#ifdef OMP
+        return ( uint ) omp_get_max_threads() ;
+#else
+        return 1 ;
+#endif
+    }
+
+//------------------------------------------------------------------------------
+}
+#endif //BELFEM_THREADTOOLS_HPP
@@ -0,0 +1,314 @@
+//
+// Created by Christian Messe on 17.10.26.
+//
+
+#include <cmath>
+
+#include "cl_BS_GasTableBuilder.hpp"
+#include "assert.hpp"
+#include "commtools.hpp"
+#include "threadtools.hpp"
+#include "cl_Logger.hpp"
+#include "cl_Timer.hpp"
+#include "cl_Progressbar.hpp"
+#include "cl_GT_RefGas.hpp"
+
+namespace belfem
+{
+    namespace bspline
+    {
+//------------------------------------------------------------------------------
+
+        GasTableBuilder::GasTableBuilder(
+                const Cell< string >    & aSpecies,
+                const Vector< real >    & aMolarFractions,
+                const Vector< index_t > & aNumberOfElements,
+                const Vector< real >    & aMinPoint,
+                const Vector< real >    & aMaxPoint ) :
+                mSpecies( aSpecies ),
+                mMolarFractions( aMolarFractions ),
+                mMapper( 2, 3, aNumberOfElements, aMinPoint, aMaxPoint )
+        {
+            BELFEM_ERROR( aSpecies.size() == aMolarFractions.length(),
+                          "Number of species does not match number of molar fractions" );
+
+            mElementLength.set_size( 2 );
+            for( uint i=0; i<2; ++i )
+            {
+                mElementLength( i ) = ( aMaxPoint( i ) - aMinPoint( i ) )
+                        / ( real ) aNumberOfElements( i );
+            }
+        }
+
+//------------------------------------------------------------------------------
+
+        void
+        GasTableBuilder::set_molar_fraction_fields( const bool aSwitch )
+        {
+            mMolarFractionFields = aSwitch ;
+        }
+
+//------------------------------------------------------------------------------
+
+        void
+        GasTableBuilder::set_number_of_threads( const uint aNumberOfThreads )
+        {
+            mNumberOfThreads = aNumberOfThreads ;
+        }
+
+//------------------------------------------------------------------------------
+
+        void
+        GasTableBuilder::compute()
+        {
+            const Matrix< real > & tGrid = mMapper.integration_grid() ;
+
+            index_t tGridSize = tGrid.n_cols() ;
+
+            uint tNumProperties = mMolarFractionFields ?
+                    mNumberOfProperties + mSpecies.size() : mNumberOfProperties ;
+
+            // each proc works on one contiguous slice of the grid,
+            // the points are ordered element by element
+            proc_t tNumProcs = comm_size() ;
+            proc_t tMyRank   = comm_rank() ;
+
+            index_t tFirst = ( luint ) tGridSize * tMyRank / tNumProcs ;
+            index_t tLast  = ( luint ) tGridSize * ( tMyRank + 1 ) / tNumProcs ;
+
+            Matrix< real > tValues( tNumProperties, tLast - tFirst, 0.0 );
+
+            // Gas is not thread safe, so each thread gets its own copy.
+            // The copies are created before the parallel region,
+            // since the constructor reads the database
+            uint tNumThreads = mNumberOfThreads > 0 ?
+                    mNumberOfThreads : max_number_of_threads() ;
+
+            message( 4, " Computing equilibrium properties on %u points using %u procs and %u threads\n",
+                     ( unsigned int ) tGridSize,
+                     ( unsigned int ) tNumProcs,
+                     ( unsigned int ) tNumThreads );
+
+            Timer tTimer ;
+
+            Cell< Gas * > tGases( tNumThreads, nullptr );
+            for( uint t=0; t<tNumThreads; ++t )
+            {
+                tGases( t ) = new Gas( mSpecies, mMolarFractions );
+            }
+
+            // one part per thread, also if OpenMP provides fewer threads
+#ifdef OMP
+#pragma omp parallel for num_threads( tNumThreads ) schedule( static, 1 )
+#endif
+            for( uint tThread=0; tThread<tNumThreads; ++tThread )
+            {
+                index_t tN = tLast - tFirst ;
+
+                index_t tThreadFirst = tFirst + ( luint ) tN * tThread / tNumThreads ;
+                index_t tThreadLast  = tFirst + ( luint ) tN * ( tThread + 1 ) / tNumThreads ;
+
+                this->compute_points( *tGases( tThread ),
+                                      tThreadFirst,
+                                      tThreadLast,
+                                      tThreadFirst - tFirst,
+                                      tValues,
+                                      tMyRank == 0 && tThread == 0 );
+            }
+
+            for( Gas * tGas : tGases )
+            {
+                delete tGas ;
+            }
+
+            message( 4, "    Time for computing properties: %u ms\n",
+                     ( unsigned int ) tTimer.stop() );
+
+            if( tMyRank == 0 )
+            {
+                // create the fields in the order that TableGas expects
+                mMapper.create_field( "M" );
+                mMapper.create_field( "h" );
+                mMapper.create_field( "s" );
+                mMapper.create_field( "mu" );
+                mMapper.create_field( "lambda" );
+                mMapper.create_field( "hd" );
+
+                if( mMolarFractionFields )
+                {
+                    for( uint i=0; i<mSpecies.size(); ++i )
+                    {
+                        mMapper.create_field( mSpecies( i ) );
+                    }
+                }
+
+                // collect the slices of the other procs
+                Cell< Matrix< real > > tAllValues ;
+                Vector< proc_t > tCommList ;
+
+                if( tNumProcs > 1 )
+                {
+                    create_master_commlist( tCommList );
+                    receive( tCommList, tAllValues );
+                }
+
+                for( proc_t p=0; p<tNumProcs; ++p )
+                {
+                    const Matrix< real > & tSlice = p == 0 ? tValues : tAllValues( p-1 );
+
+                    index_t tOffset = ( luint ) tGridSize * p / tNumProcs ;
+
+                    for( uint f=0; f<tNumProperties; ++f )
+                    {
+                        Vector< real > & tField = mMapper.field( f );
+
+                        for( index_t k=0; k<tSlice.n_cols(); ++k )
+                        {
+                            tField( tOffset + k ) = tSlice( f, k );
+                        }
+                    }
+                }
+
+                mMapper.compute_node_values() ;
+            }
+            else
+            {
+                send( 0, tValues );
+            }
+        }
+
+//------------------------------------------------------------------------------
+
+        void
+        GasTableBuilder::save( const string & aPath )
+        {
+            if( comm_rank() == 0 )
+            {
+                mMapper.mesh()->save( aPath );
+            }
+        }
+
+//------------------------------------------------------------------------------
+
+        void
+        GasTableBuilder::compute_points(
+                Gas            & aGas,
+                const index_t    aFirst,
+                const index_t    aLast,
+                const index_t    aOffset,
+                Matrix< real >  & aValues,
+                const bool       aShowProgress )
+        {
+            const Matrix< real > & tGrid = mMapper.integration_grid() ;
+
+            uint tNumComponents = aGas.number_of_components() ;
+
+            Cell< gastables::RefGas * > & tComponents = aGas.components() ;
+
+            // composition below the freeze temperature, as normalized by the gas
+            const Vector< real > tX0( aGas.molar_fractions() );
+            Vector< real > tX( tX0 );
+
+            // enthalpies at zero K
+            Vector< real > tHf( tNumComponents );
+
+            // only the thread that shows the progress needs a bar
+            Progressbar * tProgress = aShowProgress ? new Progressbar( aLast - aFirst ) : nullptr ;
+
+            for( index_t k=aFirst; k<aLast; ++k )
+            {
+                if( tProgress != nullptr )
+                {
+                    tProgress->step( k - aFirst );
+                }
+
+                // compute temperature
+                real tT = tGrid( 0, k ) ;
+
+                // compute pressure
+                real tP = std::pow( 10, tGrid( 1, k ) * 0.001 ) ;
+
+                // the equilibrium of the point before is a good guess if
+                // it is close. The element abundances are always taken
+                // from tX0, so the result does not depend on the guess
+                if( k == aFirst
+                    || tGrid( 0, k-1 ) < mFreezeTemperature
+                    || ! this->is_neighbor( k-1, k ) )
+                {
+                    tX = tX0 ;
+                }
+
+                if( tT >= mFreezeTemperature )
+                {
+                    aGas.compute_equilibrium( tT, tP, tX0, tX );
+                }
+                else
+                {
+                    tX = tX0 ;
+                }
+
+                aGas.remix_R( tX );
+                aGas.remix_heat();
+
+                const Vector< real > & tY = aGas.mass_fractions() ;
+
+                index_t j = aOffset + k - aFirst ;
+
+                // molar mass
+                aValues( 0, j ) = aGas.M( tT, tP );
+
+                BELFEM_ERROR( std::abs( aValues( 0, j ) ) > 0, "Error for T= %f, p= %f, M = %f",
+                              ( float ) tT, ( float ) tP, ( float ) aValues( 0, j ) );
+
+                // enthalpy
+                aValues( 1, j ) = aGas.h( tT, tP );
+
+                // entropy
+                aValues( 2, j ) = aGas.s( tT, tP );
+
+                // viscosity
+                aValues( 3, j ) = aGas.cea_mu( tT );
+
+                // thermal conductivity ( frozen )
+                aValues( 4, j ) = aGas.cea_lambda( tT );
+
+                // dissociation enthalpy
+                aGas.Hf( tT, tHf );
+
+                real tHd = 0.0 ;
+                for( uint i=0; i<tNumComponents; ++i )
+                {
+                    tHd += tY( i ) * tHf( i ) / tComponents( i )->M();
+                }
+                aValues( 5, j ) = tHd ;
+
+                if( mMolarFractionFields )
+                {
+                    for( uint i=0; i<tNumComponents; ++i )
+                    {
+                        aValues( mNumberOfProperties + i, j ) = tX( i );
+                    }
+                }
+            }
+
+            if( tProgress != nullptr )
+            {
+                tProgress->finish() ;
+                delete tProgress ;
+            }
+        }
+
+//------------------------------------------------------------------------------
+
+        bool
+        GasTableBuilder::is_neighbor( const index_t aA, const index_t aB ) const
+        {
+            const Matrix< real > & tGrid = mMapper.integration_grid() ;
+
+            return std::abs( tGrid( 0, aA ) - tGrid( 0, aB ) ) <= 2.0 * mElementLength( 0 )
+                && std::abs( tGrid( 1, aA ) - tGrid( 1, aB ) ) <= 2.0 * mElementLength( 1 );
+        }
+
+//------------------------------------------------------------------------------
+    }
+}
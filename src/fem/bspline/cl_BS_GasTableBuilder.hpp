@@ -0,0 +1,156 @@
+//
+// Created by Christian Messe on 17.10.26.
+//
+
+#ifndef BELFEM_CL_BS_GASTABLEBUILDER_HPP
+#define BELFEM_CL_BS_GASTABLEBUILDER_HPP
+
+#include "typedefs.hpp"
+#include "cl_Cell.hpp"
+#include "cl_Vector.hpp"
+#include "cl_Matrix.hpp"
+#include "cl_BS_Mapper.hpp"
+#include "cl_Gas.hpp"
+
+namespace belfem
+{
+    namespace bspline
+    {
+//------------------------------------------------------------------------------
+
+        /**
+         * computes the equilibrium properties of a gas mixture on a
+         * ( T, 1000 * log10( p ) ) grid and fits the B-Spline coefficients,
+         * so that the result can be read by TableGas.
+         *
+         * The grid is split into one slice per proc, and each thread
+         * works on a part of the slice with its own copy of the gas.
+         * Each point starts from the composition of the point before,
+         * if that one is a neighbor. The element abundances always come
+         * from the given composition, so the result does not depend on
+         * how the grid is split.
+         */
+        class GasTableBuilder
+        {
+            const Cell< string > mSpecies ;
+            const Vector< real > mMolarFractions ;
+
+            Mapper mMapper ;
+
+            // size of one element in each direction
+            Vector< real > mElementLength ;
+
+            // below this temperature, the composition is frozen
+            real mFreezeTemperature = 350.0 ;
+
+            // number of properties that are computed for each point
+            const uint mNumberOfProperties = 6 ;
+
+            // also write the molar fractions into the table
+            bool mMolarFractionFields = false ;
+
+            // number of threads, zero: as many as OpenMP provides
+            uint mNumberOfThreads = 0 ;
+
+//------------------------------------------------------------------------------
+        public:
+//------------------------------------------------------------------------------
+
+            /**
+             * @param aSpecies         : species of the mixture
+             * @param aMolarFractions  : composition below the freeze temperature
+             * @param aNumberOfElements: elements in T and log p
+             * @param aMinPoint        : T in K and 1000 * log10( p ) with p in Pa
+             * @param aMaxPoint        : T in K and 1000 * log10( p ) with p in Pa
+             */
+            GasTableBuilder(
+                    const Cell< string >    & aSpecies,
+                    const Vector< real >    & aMolarFractions,
+                    const Vector< index_t > & aNumberOfElements,
+                    const Vector< real >    & aMinPoint,
+                    const Vector< real >    & aMaxPoint );
+
+//------------------------------------------------------------------------------
+
+            ~GasTableBuilder() = default ;
+
+//------------------------------------------------------------------------------
+
+            /**
+             * write the molar fraction of each species into the table,
+             * must be called before compute()
+             */
+            void
+            set_molar_fraction_fields( const bool aSwitch );
+
+//------------------------------------------------------------------------------
+
+            /**
+             * number of threads per proc, zero means as many as
+             * OpenMP provides. Must be called before compute()
+             */
+            void
+            set_number_of_threads( const uint aNumberOfThreads );
+
+//------------------------------------------------------------------------------
+
+            /**
+             * compute the properties on all grid points and the node values.
+             * Must be called by all procs, the result is only on the master.
+             */
+            void
+            compute();
+
+//------------------------------------------------------------------------------
+
+            /**
+             * save the table, only the master writes
+             */
+            void
+            save( const string & aPath="hotair.hdf5" );
+
+//------------------------------------------------------------------------------
+
+            Mapper &
+            mapper();
+
+//------------------------------------------------------------------------------
+        private:
+//------------------------------------------------------------------------------
+
+            /**
+             * compute the properties of the points aFirst to aLast-1,
+             * the values are written column wise into aValues,
+             * starting at column aOffset
+             */
+            void
+            compute_points( Gas            & aGas,
+                            const index_t    aFirst,
+                            const index_t    aLast,
+                            const index_t    aOffset,
+                            Matrix< real >  & aValues,
+                            const bool       aShowProgress );
+
+//------------------------------------------------------------------------------
+
+            /**
+             * tells if two grid points are close enough for a warm start
+             */
+            bool
+            is_neighbor( const index_t aA, const index_t aB ) const ;
+
+//------------------------------------------------------------------------------
+        };
+
+//------------------------------------------------------------------------------
+
+        inline Mapper &
+        GasTableBuilder::mapper()
+        {
+            return mMapper ;
+        }
+
+//------------------------------------------------------------------------------
+    }
+}
+#endif //BELFEM_CL_BS_GASTABLEBUILDER_HPP
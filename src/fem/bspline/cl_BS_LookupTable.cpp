@@ -226,10 +226,7 @@ namespace belfem
             mInterpolationFunction->N( mXi, mN );
 
             // compute the value
-            Vector< real > tVal( ( mN * mValues ) );
-
-            // return the value
-            return  tVal( 0 );
+            return this->contract( mN, 0 );
         }
 
 //------------------------------------------------------------------------------
@@ -337,12 +334,10 @@ namespace belfem
             // compute interpolation function
             mInterpolationFunction->dNdXi( mXi, mdNdxi );
 
-            // compute the values
-            Vector< real > aDerivative( mdNdxi * mValues );
-
-            // transform derivatives
-            aDerivative( 0 ) *= mScaleDX ;
-            aDerivative( 1 ) *= mScaleDY ;
+            // compute the values and transform the derivatives
+            Vector< real > aDerivative( 2 );
+            aDerivative( 0 ) = this->contract( mdNdxi, 0 ) * mScaleDX ;
+            aDerivative( 1 ) = this->contract( mdNdxi, 1 ) * mScaleDY ;
 
             return aDerivative ;
         }
@@ -517,6 +512,216 @@ namespace belfem
             return aDerivative ;
         }
 
+//------------------------------------------------------------------------------
+
+        real
+        LookupTable::compute_value(
+                const index_t aFieldIndex,
+                const real aX,
+                const real aY,
+                Vector< real > & aXi,
+                Matrix< real > & aN ) const
+        {
+            BELFEM_ASSERT( mNumberOfDimensions == 2, "Table must be of dimension 2" );
+
+            mesh::Element * tElement = this->find_element( aX, aY );
+
+            this->compute_xi( tElement, 0, aX, aXi );
+            this->compute_xi( tElement, 1, aY, aXi );
+
+            mInterpolationFunction->N( aXi, aN );
+
+            return this->contract( aN, 0, mMesh->field( aFieldIndex )->data(), tElement );
+        }
+
+//------------------------------------------------------------------------------
+
+        void
+        LookupTable::compute_derivative(
+                const index_t aFieldIndex,
+                const real aX,
+                const real aY,
+                Vector< real > & aXi,
+                Matrix< real > & adNdXi,
+                Vector< real > & aDerivative ) const
+        {
+            BELFEM_ASSERT( mNumberOfDimensions == 2, "Table must be of dimension 2" );
+
+            mesh::Element * tElement = this->find_element( aX, aY );
+
+            this->compute_xi( tElement, 0, aX, aXi );
+            this->compute_xi( tElement, 1, aY, aXi );
+
+            mInterpolationFunction->dNdXi( aXi, adNdXi );
+
+            const Vector< real > & tField = mMesh->field( aFieldIndex )->data() ;
+
+            aDerivative( 0 ) = this->contract( adNdXi, 0, tField, tElement ) * mScaleDX ;
+            aDerivative( 1 ) = this->contract( adNdXi, 1, tField, tElement ) * mScaleDY ;
+        }
+
+//------------------------------------------------------------------------------
+
+        void
+        LookupTable::compute_values(
+                const index_t aFieldIndex,
+                const Vector< real > & aX,
+                const Vector< real > & aY,
+                Vector< real > & aValues )
+        {
+            BELFEM_ASSERT( mNumberOfDimensions == 2, "Table must be of dimension 2" );
+
+            this->collect_batch( aFieldIndex, aX, aY, false );
+
+            this->contract_batch( mBatchN, 1.0, aValues );
+        }
+
+//------------------------------------------------------------------------------
+
+        void
+        LookupTable::compute_derivatives(
+                const index_t aFieldIndex,
+                const Vector< real > & aX,
+                const Vector< real > & aY,
+                Vector< real > & adX,
+                Vector< real > & adY )
+        {
+            BELFEM_ASSERT( mNumberOfDimensions == 2, "Table must be of dimension 2" );
+
+            this->collect_batch( aFieldIndex, aX, aY, true );
+
+            this->contract_batch( mBatchdNdX, mScaleDX, adX );
+            this->contract_batch( mBatchdNdY, mScaleDY, adY );
+        }
+
+//------------------------------------------------------------------------------
+
+        void
+        LookupTable::collect_batch(
+                const index_t aFieldIndex,
+                const Vector< real > & aX,
+                const Vector< real > & aY,
+                const bool aDerivatives )
+        {
+            BELFEM_ASSERT( aX.length() == aY.length(),
+                          "length of x and y do not match ( %lu vs %lu )",
+                          ( long unsigned int ) aX.length(),
+                          ( long unsigned int ) aY.length() );
+
+            index_t tNumPoints = aX.length() ;
+
+            Matrix< real > & tN = aDerivatives ? mBatchdNdX : mBatchN ;
+
+            if( tN.n_rows() != tNumPoints )
+            {
+                tN.set_size( tNumPoints, mNumberOfNodesPerElement );
+            }
+
+            if( aDerivatives && mBatchdNdY.n_rows() != tNumPoints )
+            {
+                mBatchdNdY.set_size( tNumPoints, mNumberOfNodesPerElement );
+            }
+
+            if( mBatchValues.n_rows() != tNumPoints )
+            {
+                mBatchValues.set_size( tNumPoints, mNumberOfNodesPerElement );
+            }
+
+            const Vector< real > & tField = mMesh->field( aFieldIndex )->data();
+
+            for( index_t p=0; p<tNumPoints; ++p )
+            {
+                // select the element and compute the parameter coordinates
+                this->select_element( aX( p ), aY( p ) );
+                this->compute_xi( 0, aX( p ) );
+                this->compute_xi( 1, aY( p ) );
+
+                if( aDerivatives )
+                {
+                    mInterpolationFunction->dNdXi( mXi, mdNdxi );
+
+                    for( uint k=0; k<mNumberOfNodesPerElement; ++k )
+                    {
+                        mBatchdNdX( p, k ) = mdNdxi( 0, k );
+                        mBatchdNdY( p, k ) = mdNdxi( 1, k );
+                    }
+                }
+                else
+                {
+                    mInterpolationFunction->N( mXi, mN );
+
+                    for( uint k=0; k<mNumberOfNodesPerElement; ++k )
+                    {
+                        mBatchN( p, k ) = mN( 0, k );
+                    }
+                }
+
+                for( uint k=0; k<mNumberOfNodesPerElement; ++k )
+                {
+                    mBatchValues( p, k ) = tField( mElement->node( k )->index() );
+                }
+            }
+
+            // the selected element and the parameter coordinates
+            // now belong to the last point
+            if( tNumPoints > 0 )
+            {
+                mX = aX( tNumPoints - 1 );
+                mY = aY( tNumPoints - 1 );
+            }
+        }
+
+//------------------------------------------------------------------------------
+
+        void
+        LookupTable::contract_batch(
+                const Matrix< real > & aN,
+                const real aScale,
+                Vector< real > & aResult ) const
+        {
+            index_t tNumPoints = aN.n_rows() ;
+
+            aResult.set_size( tNumPoints );
+
+            real * tResult = aResult.data() ;
+
+            for( index_t p=0; p<tNumPoints; ++p )
+            {
+                tResult[ p ] = 0.0 ;
+            }
+
+            if( tNumPoints == 0 )
+            {
+                return ;
+            }
+
+            // column major storage, so each column is contiguous over the points.
+            // Columns may be padded, so the offsets are not k * tNumPoints.
+            // The node loop is outside, which keeps the order of the sum
+            // the same as in contract()
+            for( uint k=0; k<mNumberOfNodesPerElement; ++k )
+            {
+                const real * tN = &aN( 0, k );
+                const real * tV = &mBatchValues( 0, k );
+
+#ifdef OMP
+                #pragma omp simd
+#endif
+                for( index_t p=0; p<tNumPoints; ++p )
+                {
+                    tResult[ p ] += tN[ p ] * tV[ p ];
+                }
+            }
+
+            if( aScale != 1.0 )
+            {
+                for( index_t p=0; p<tNumPoints; ++p )
+                {
+                    tResult[ p ] *= aScale ;
+                }
+            }
+        }
+
 //------------------------------------------------------------------------------
     }
-}
\ No newline at end of file
+}
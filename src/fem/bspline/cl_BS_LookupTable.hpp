@@ -91,6 +91,13 @@ namespace belfem
             // remember id of selected element when field was colleted
             index_t mElementID = 0 ;
 
+            // shape functions and node values for batched evaluation,
+            // one row per point, so that the contraction runs over the points
+            Matrix< real > mBatchN ;
+            Matrix< real > mBatchdNdX ;
+            Matrix< real > mBatchdNdY ;
+            Matrix< real > mBatchValues ;
+
 //------------------------------------------------------------------------------
         public:
 //------------------------------------------------------------------------------
@@ -105,7 +112,7 @@ namespace belfem
 
             // get a field index from a lanbel
             inline index_t
-            field_index( const string & aLabel );
+            field_index( const string & aLabel ) const ;
 
 //------------------------------------------------------------------------------
             real
@@ -130,6 +137,19 @@ namespace belfem
                     const real aY,
                     const real & aZ );
 
+//------------------------------------------------------------------------------
+
+            /**
+             * evaluate a 2D table at many points. Gives the same result
+             * as calling compute_value for each point
+             */
+            void
+            compute_values(
+                    const index_t aFieldIndex,
+                    const Vector< real > & aX,
+                    const Vector< real > & aY,
+                    Vector< real > & aValues );
+
 //------------------------------------------------------------------------------
 
             real
@@ -154,6 +174,20 @@ namespace belfem
                     const real aY,
                     const real aZ );
 
+//------------------------------------------------------------------------------
+
+            /**
+             * evaluate the first derivatives of a 2D table at many points.
+             * Gives the same result as calling compute_derivative for each point
+             */
+            void
+            compute_derivatives(
+                    const index_t aFieldIndex,
+                    const Vector< real > & aX,
+                    const Vector< real > & aY,
+                    Vector< real > & adX,
+                    Vector< real > & adY );
+
 //------------------------------------------------------------------------------
 
             real
@@ -178,6 +212,43 @@ namespace belfem
                     const real aY,
                     const real aZ );
 
+//------------------------------------------------------------------------------
+
+            /**
+             * thread safe evaluation of a 2D table. The work arrays are
+             * owned by the caller, see number_of_nodes_per_element().
+             * Gives the same result as compute_value
+             */
+            real
+            compute_value(
+                    const index_t aFieldIndex,
+                    const real aX,
+                    const real aY,
+                    Vector< real > & aXi,
+                    Matrix< real > & aN ) const ;
+
+//------------------------------------------------------------------------------
+
+            /**
+             * thread safe first derivatives of a 2D table.
+             * Gives the same result as compute_derivative
+             */
+            void
+            compute_derivative(
+                    const index_t aFieldIndex,
+                    const real aX,
+                    const real aY,
+                    Vector< real > & aXi,
+                    Matrix< real > & adNdXi,
+                    Vector< real > & aDerivative ) const ;
+
+//------------------------------------------------------------------------------
+
+            inline uint
+            number_of_nodes_per_element() const
+            {
+                return mNumberOfNodesPerElement ;
+            }
 //------------------------------------------------------------------------------
 
             inline const real  &
@@ -220,19 +291,19 @@ namespace belfem
 
             // element grabber for 1D problem
             inline mesh::Element *
-            get_element( const index_t & aI );
+            get_element( const index_t & aI ) const ;
 
 //------------------------------------------------------------------------------
 
             // element grabber for 2D problem
             inline mesh::Element *
-            get_element( const index_t & aI, const index_t & aJ );
+            get_element( const index_t & aI, const index_t & aJ ) const ;
 
 //------------------------------------------------------------------------------
 
             // element grabber for 3D problem
             inline mesh::Element *
-            get_element( const index_t & aI, const index_t & aJ, const index_t & aK );
+            get_element( const index_t & aI, const index_t & aJ, const index_t & aK ) const ;
 
 //------------------------------------------------------------------------------
 
@@ -262,6 +333,63 @@ namespace belfem
             inline void
             compute_xi( const uint & aI, const real aX );
 
+//------------------------------------------------------------------------------
+
+            /**
+             * sum of one row of shape function values times the node values,
+             * always summed in node order, so that the scalar and the batched
+             * evaluation give identical results
+             */
+            inline real
+            contract( const Matrix< real > & aN, const uint aRow ) const ;
+
+//------------------------------------------------------------------------------
+
+            // element finder for 2D problem that does not change the table
+            inline mesh::Element *
+            find_element( const real aX, const real aY ) const ;
+
+//------------------------------------------------------------------------------
+
+            // parameter coordinate that does not change the table
+            inline void
+            compute_xi( mesh::Element * aElement,
+                        const uint aI,
+                        const real aX,
+                        Vector< real > & aXi ) const ;
+
+//------------------------------------------------------------------------------
+
+            // same as contract, but reads the node values from the field
+            inline real
+            contract( const Matrix< real > & aN,
+                      const uint aRow,
+                      const Vector< real > & aField,
+                      mesh::Element * aElement ) const ;
+//------------------------------------------------------------------------------
+
+            /**
+             * select the elements for all points and collect the
+             * shape functions and the node values
+             */
+            void
+            collect_batch(
+                    const index_t aFieldIndex,
+                    const Vector< real > & aX,
+                    const Vector< real > & aY,
+                    const bool aDerivatives );
+
+//------------------------------------------------------------------------------
+
+            /**
+             * row wise contraction of the batch, vectorized over the points
+             */
+            void
+            contract_batch(
+                    const Matrix< real > & aN,
+                    const real aScale,
+                    Vector< real > & aResult ) const ;
+
 //------------------------------------------------------------------------------
         };
 //------------------------------------------------------------------------------
@@ -270,7 +398,7 @@ namespace belfem
 
         // get a field index from a lanbel
         inline index_t
-        LookupTable::field_index( const string & aLabel )
+        LookupTable::field_index( const string & aLabel ) const
         {
             return mFieldMap( aLabel );
         }
@@ -278,7 +406,7 @@ namespace belfem
 //------------------------------------------------------------------------------
         // element grabber for 1D problem
         mesh::Element *
-        LookupTable::get_element( const index_t & aI )
+        LookupTable::get_element( const index_t & aI ) const
         {
             BELFEM_ASSERT( aI < mNumberOfElementsPerDirection( 0 ),
                           "index i out of bounds: %lu > %lu",
@@ -293,7 +421,7 @@ namespace belfem
 
         // element grabber for 2D problem
         mesh::Element *
-        LookupTable::get_element( const index_t & aI, const index_t & aJ )
+        LookupTable::get_element( const index_t & aI, const index_t & aJ ) const
         {
             BELFEM_ASSERT( aI < mNumberOfElementsPerDirection( 0 ),
                           "index i out of bounds: %lu > %lu",
@@ -313,7 +441,7 @@ namespace belfem
 
         // element grabber for 1D problem
         mesh::Element *
-        LookupTable::get_element( const index_t & aI, const index_t & aJ, const index_t & aK )
+        LookupTable::get_element( const index_t & aI, const index_t & aJ, const index_t & aK ) const
         {
             BELFEM_ASSERT( aI < mNumberOfElementsPerDirection( 0 ),
                           "index i out of bounds: %lu > %lu",
@@ -378,6 +506,66 @@ namespace belfem
                     "Wrong element selected" );
         }
 
+//------------------------------------------------------------------------------
+
+        real
+        LookupTable::contract( const Matrix< real > & aN, const uint aRow ) const
+        {
+            real aValue = 0.0 ;
+
+            for( uint k=0; k<mNumberOfNodesPerElement; ++k )
+            {
+                aValue += aN( aRow, k ) * mValues( k );
+            }
+
+            return aValue ;
+        }
+
+//------------------------------------------------------------------------------
+
+        mesh::Element *
+        LookupTable::find_element( const real aX, const real aY ) const
+        {
+            return this->get_element(
+                    std::floor( ( aX - mPmin( 0 ) ) / mElementLength( 0 ) ),
+                    std::floor( ( aY - mPmin( 1 ) ) / mElementLength( 1 ) ) );
+        }
+
+//------------------------------------------------------------------------------
+
+        void
+        LookupTable::compute_xi(
+                mesh::Element * aElement,
+                const uint aI,
+                const real aX,
+                Vector< real > & aXi ) const
+        {
+            aXi( aI ) = 2.0 * ( aX - aElement->node( 0 )->x( aI )) /
+                        mElementLength( aI ) - 1.0;
+
+            BELFEM_ASSERT( aXi( aI ) >= -1.0 && aXi( aI ) <= 1.0,
+                          "Wrong element selected" );
+        }
+
+//------------------------------------------------------------------------------
+
+        real
+        LookupTable::contract(
+                const Matrix< real > & aN,
+                const uint aRow,
+                const Vector< real > & aField,
+                mesh::Element * aElement ) const
+        {
+            real aValue = 0.0 ;
+
+            for( uint k=0; k<mNumberOfNodesPerElement; ++k )
+            {
+                aValue += aN( aRow, k ) * aField( aElement->node( k )->index() );
+            }
+
+            return aValue ;
+        }
+
 //------------------------------------------------------------------------------
     }
 }
@@ -50,6 +50,21 @@ namespace belfem
             return mStatevals.get( BELFEM_STATEVAL_PI );
         }
 
+//----------------------------------------------------------------------------
+
+        void
+        EoS_TableGas::pi( const Vector< real > & aT, const Vector< real > & aP, Vector< real > & aPi )
+        {
+            index_t tN = aP.length() ;
+
+            aPi.set_size( tN );
+
+            for( index_t k=0; k<tN; ++k )
+            {
+                aPi( k ) = std::max( std::min( std::log10( aP( k ) ) * 1000.0, mPimax ), mPimin );
+            }
+        }
+
 //----------------------------------------------------------------------------
 
         real
@@ -63,6 +63,12 @@ namespace belfem
             real
             pi( const real aT, const real aP );
 
+            /**
+             * batched version of pi, gives the same values
+             */
+            void
+            pi( const Vector< real > & aT, const Vector< real > & aP, Vector< real > & aPi );
+
             real
             dpidp(const real &aT, const real &aP);
 
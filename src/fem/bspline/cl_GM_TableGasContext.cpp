@@ -0,0 +1,112 @@
+//
+// Created by Christian Messe on 17.10.26.
+//
+
+#include <cmath>
+
+#include "cl_GM_TableGasContext.hpp"
+#include "constants.hpp"
+
+namespace belfem
+{
+    namespace gasmodels
+    {
+//----------------------------------------------------------------------------
+
+        TableGasContext::TableGasContext(
+                const Gas & aGas,
+                const bspline::LookupTable & aTable ) :
+                GasContext( aGas ),
+                mTable( aTable ),
+                mIndexM( aTable.field_index( "M" ) ),
+                mIndexH( aTable.field_index( "h" ) ),
+                mIndexS( aTable.field_index( "s" ) ),
+                mIndexMu( aTable.field_index( "mu" ) ),
+                mIndexLambda( aTable.field_index( "lambda" ) ),
+                mPimin( aTable.min( 1 ) + 1.0 ),
+                mPimax( aTable.max( 1 ) - 1.0 )
+        {
+            mXi.set_size( 2 );
+            mN.set_size( 1, aTable.number_of_nodes_per_element() );
+            mdNdXi.set_size( 2, aTable.number_of_nodes_per_element() );
+            mDerivative.set_size( 2 );
+        }
+
+//----------------------------------------------------------------------------
+
+        real
+        TableGasContext::pi( const real aT, const real aP )
+        {
+            mStatevals.update_Tp( aT, aP );
+
+            if ( ! mStatevals.test( BELFEM_STATEVAL_PI ) )
+            {
+                mStatevals.set( BELFEM_STATEVAL_PI,
+                        std::max( std::min( std::log10( aP ) * 1000.0, mPimax ), mPimin ) );
+            }
+
+            return mStatevals.get( BELFEM_STATEVAL_PI );
+        }
+
+//----------------------------------------------------------------------------
+
+        real
+        TableGasContext::eval_M( const real aT, const real aP )
+        {
+            return mTable.compute_value( mIndexM, aT, this->pi( aT, aP ), mXi, mN );
+        }
+
+//----------------------------------------------------------------------------
+
+        real
+        TableGasContext::eval_R( const real aT, const real aP )
+        {
+            return constant::Rm / this->M( aT, aP );
+        }
+
+//----------------------------------------------------------------------------
+
+        real
+        TableGasContext::eval_cp( const real aT, const real aP )
+        {
+            mTable.compute_derivative( mIndexH, aT, this->pi( aT, aP ),
+                                       mXi, mdNdXi, mDerivative );
+
+            return mDerivative( 0 );
+        }
+
+//----------------------------------------------------------------------------
+
+        real
+        TableGasContext::eval_h( const real aT, const real aP )
+        {
+            return mTable.compute_value( mIndexH, aT, this->pi( aT, aP ), mXi, mN );
+        }
+
+//----------------------------------------------------------------------------
+
+        real
+        TableGasContext::eval_s( const real aT, const real aP )
+        {
+            return mTable.compute_value( mIndexS, aT, this->pi( aT, aP ), mXi, mN );
+        }
+
+//----------------------------------------------------------------------------
+
+        real
+        TableGasContext::eval_mu( const real aT, const real aP )
+        {
+            return mTable.compute_value( mIndexMu, aT, this->pi( aT, aP ), mXi, mN );
+        }
+
+//----------------------------------------------------------------------------
+
+        real
+        TableGasContext::eval_lambda( const real aT, const real aP )
+        {
+            return mTable.compute_value( mIndexLambda, aT, this->pi( aT, aP ), mXi, mN );
+        }
+
+//----------------------------------------------------------------------------
+    }
+}
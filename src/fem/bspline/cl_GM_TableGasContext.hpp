@@ -0,0 +1,92 @@
+//
+// Created by Christian Messe on 17.10.26.
+//
+
+#ifndef BELFEM_CL_GM_TABLEGASCONTEXT_HPP
+#define BELFEM_CL_GM_TABLEGASCONTEXT_HPP
+
+#include "typedefs.hpp"
+#include "cl_Vector.hpp"
+#include "cl_Matrix.hpp"
+#include "cl_GM_GasContext.hpp"
+#include "cl_BS_LookupTable.hpp"
+
+namespace belfem
+{
+    namespace gasmodels
+    {
+//----------------------------------------------------------------------------
+
+        /**
+         * evaluation context for a TableGas. Uses the thread safe functions
+         * of the lookup table with its own work arrays.
+         */
+        class TableGasContext : public GasContext
+        {
+            const bspline::LookupTable & mTable ;
+
+            const index_t mIndexM ;
+            const index_t mIndexH ;
+            const index_t mIndexS ;
+            const index_t mIndexMu ;
+            const index_t mIndexLambda ;
+
+            // limits of pi = 1000 * log10( p ), same as in EoS_TableGas
+            const real mPimin ;
+            const real mPimax ;
+
+            // work arrays for the table
+            Vector< real > mXi ;
+            Matrix< real > mN ;
+            Matrix< real > mdNdXi ;
+            Vector< real > mDerivative ;
+
+//----------------------------------------------------------------------------
+        public:
+//----------------------------------------------------------------------------
+
+            TableGasContext( const Gas & aGas, const bspline::LookupTable & aTable );
+
+//----------------------------------------------------------------------------
+
+            ~TableGasContext() = default ;
+
+//----------------------------------------------------------------------------
+        protected:
+//----------------------------------------------------------------------------
+
+            real
+            eval_M( const real aT, const real aP );
+
+            real
+            eval_R( const real aT, const real aP );
+
+            real
+            eval_cp( const real aT, const real aP );
+
+            real
+            eval_h( const real aT, const real aP );
+
+            real
+            eval_s( const real aT, const real aP );
+
+            real
+            eval_mu( const real aT, const real aP );
+
+            real
+            eval_lambda( const real aT, const real aP );
+
+//----------------------------------------------------------------------------
+        private:
+//----------------------------------------------------------------------------
+
+            real
+            pi( const real aT, const real aP );
+
+//----------------------------------------------------------------------------
+        };
+
+//----------------------------------------------------------------------------
+    }
+}
+#endif //BELFEM_CL_GM_TABLEGASCONTEXT_HPP
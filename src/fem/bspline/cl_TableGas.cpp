@@ -5,6 +5,7 @@
 #include "cl_TableGas.hpp"
 #include "assert.hpp"
 #include "cl_GM_EoS_TableGas.hpp"
+#include "cl_GM_TableGasContext.hpp"
 
 namespace belfem
 {
@@ -68,7 +69,8 @@ namespace belfem
     TableGas::create_eos()
     {
         // TableGas is always an ideal gas
-        mEoS = new gasmodels::EoS_TableGas( *this );
+        mTableEoS = new gasmodels::EoS_TableGas( *this );
+        mEoS = mTableEoS ;
         mGasModel = GasModel::IDGAS ;
     }
 
@@ -440,5 +442,77 @@ namespace belfem
                                       this->pi( aT, aP ) );
     }
 
+//------------------------------------------------------------------------------
+// Thread Safe Evaluation
+//------------------------------------------------------------------------------
+
+    gasmodels::GasContext *
+    TableGas::create_context() const
+    {
+        return new gasmodels::TableGasContext( *this, *mTable );
+    }
+
+//------------------------------------------------------------------------------
+// Batched Properties
+//------------------------------------------------------------------------------
+
+    void
+    TableGas::M( const Vector< real > & aT, const Vector< real > & aP, Vector< real > & aM )
+    {
+        this->allocate_batch( aT, aP, aM );
+        mTableEoS->pi( aT, aP, mBatchPi );
+        mTable->compute_values( mIndexM, aT, mBatchPi, aM );
+    }
+
+//------------------------------------------------------------------------------
+
+    void
+    TableGas::cp( const Vector< real > & aT, const Vector< real > & aP, Vector< real > & aCp )
+    {
+        this->allocate_batch( aT, aP, aCp );
+        mTableEoS->pi( aT, aP, mBatchPi );
+        mTable->compute_derivatives( mIndexH, aT, mBatchPi, aCp, mBatchWork );
+    }
+
+//------------------------------------------------------------------------------
+
+    void
+    TableGas::h( const Vector< real > & aT, const Vector< real > & aP, Vector< real > & aH )
+    {
+        this->allocate_batch( aT, aP, aH );
+        mTableEoS->pi( aT, aP, mBatchPi );
+        mTable->compute_values( mIndexH, aT, mBatchPi, aH );
+    }
+
+//------------------------------------------------------------------------------
+
+    void
+    TableGas::s( const Vector< real > & aT, const Vector< real > & aP, Vector< real > & aS )
+    {
+        this->allocate_batch( aT, aP, aS );
+        mTableEoS->pi( aT, aP, mBatchPi );
+        mTable->compute_values( mIndexS, aT, mBatchPi, aS );
+    }
+
+//------------------------------------------------------------------------------
+
+    void
+    TableGas::mu( const Vector< real > & aT, const Vector< real > & aP, Vector< real > & aMu )
+    {
+        this->allocate_batch( aT, aP, aMu );
+        mTableEoS->pi( aT, aP, mBatchPi );
+        mTable->compute_values( mIndexMu, aT, mBatchPi, aMu );
+    }
+
+//------------------------------------------------------------------------------
+
+    void
+    TableGas::lambda( const Vector< real > & aT, const Vector< real > & aP, Vector< real > & aLambda )
+    {
+        this->allocate_batch( aT, aP, aLambda );
+        mTableEoS->pi( aT, aP, mBatchPi );
+        mTable->compute_values( mIndexLambda, aT, mBatchPi, aLambda );
+    }
+
 //------------------------------------------------------------------------------
 }
@@ -12,11 +12,23 @@
 
 namespace belfem
 {
+    namespace gasmodels
+    {
+        class EoS_TableGas ;
+    }
+
     class TableGas : public Gas
     {
 
         bspline::LookupTable * mTable;
 
+        // typed pointer to the equation of state, owned by parent
+        gasmodels::EoS_TableGas * mTableEoS = nullptr ;
+
+        // work vectors for batched evaluation
+        Vector< real > mBatchPi ;
+        Vector< real > mBatchWork ;
+
         // index for mass table
         index_t mIndexM;
 
@@ -143,6 +155,34 @@ namespace belfem
         real
         Pr( const real aT, const real aP );
 
+//------------------------------------------------------------------------------
+// Thread Safe Evaluation
+//------------------------------------------------------------------------------
+
+        gasmodels::GasContext *
+        create_context() const ;
+
+//------------------------------------------------------------------------------
+// Batched Properties
+//------------------------------------------------------------------------------
+
+        void
+        M( const Vector< real > & aT, const Vector< real > & aP, Vector< real > & aM );
+
+        void
+        cp( const Vector< real > & aT, const Vector< real > & aP, Vector< real > & aCp );
+
+        void
+        h( const Vector< real > & aT, const Vector< real > & aP, Vector< real > & aH );
+
+        void
+        s( const Vector< real > & aT, const Vector< real > & aP, Vector< real > & aS );
+
+        void
+        mu( const Vector< real > & aT, const Vector< real > & aP, Vector< real > & aMu );
+
+        void
+        lambda( const Vector< real > & aT, const Vector< real > & aP, Vector< real > & aLambda );
 
 
 //------------------------------------------------------------------------------
@@ -14,6 +14,152 @@ namespace belfem
 {
     namespace fem
     {
+        namespace
+        {
+//------------------------------------------------------------------------------
+
+            /**
+             * inverts the D x D matrix J in place and returns its determinant
+             */
+            template< uint D >
+            inline real
+            invert_jacobian( real * aJ );
+
+//------------------------------------------------------------------------------
+
+            template<>
+            inline real
+            invert_jacobian< 1 >( real * aJ )
+            {
+                const real tDet = aJ[ 0 ] ;
+                aJ[ 0 ] = 1.0 / tDet ;
+                return tDet ;
+            }
+
+//------------------------------------------------------------------------------
+
+            template<>
+            inline real
+            invert_jacobian< 2 >( real * aJ )
+            {
+                // row major
+                const real tDet = aJ[ 0 ] * aJ[ 3 ] - aJ[ 1 ] * aJ[ 2 ] ;
+                const real tInv = 1.0 / tDet ;
+
+                const real tJ00 = aJ[ 0 ] ;
+
+                aJ[ 0 ] =   aJ[ 3 ] * tInv ;
+                aJ[ 1 ] = - aJ[ 1 ] * tInv ;
+                aJ[ 2 ] = - aJ[ 2 ] * tInv ;
+                aJ[ 3 ] =   tJ00 * tInv ;
+
+                return tDet ;
+            }
+
+//------------------------------------------------------------------------------
+
+            template<>
+            inline real
+            invert_jacobian< 3 >( real * aJ )
+            {
+                // row major, computed by the adjugate
+                real tA[ 9 ];
+                tA[ 0 ] = aJ[ 4 ] * aJ[ 8 ] - aJ[ 5 ] * aJ[ 7 ] ;
+                tA[ 1 ] = aJ[ 2 ] * aJ[ 7 ] - aJ[ 1 ] * aJ[ 8 ] ;
+                tA[ 2 ] = aJ[ 1 ] * aJ[ 5 ] - aJ[ 2 ] * aJ[ 4 ] ;
+                tA[ 3 ] = aJ[ 5 ] * aJ[ 6 ] - aJ[ 3 ] * aJ[ 8 ] ;
+                tA[ 4 ] = aJ[ 0 ] * aJ[ 8 ] - aJ[ 2 ] * aJ[ 6 ] ;
+                tA[ 5 ] = aJ[ 2 ] * aJ[ 3 ] - aJ[ 0 ] * aJ[ 5 ] ;
+                tA[ 6 ] = aJ[ 3 ] * aJ[ 7 ] - aJ[ 4 ] * aJ[ 6 ] ;
+                tA[ 7 ] = aJ[ 1 ] * aJ[ 6 ] - aJ[ 0 ] * aJ[ 7 ] ;
+                tA[ 8 ] = aJ[ 0 ] * aJ[ 4 ] - aJ[ 1 ] * aJ[ 3 ] ;
+
+                const real tDet = aJ[ 0 ] * tA[ 0 ] + aJ[ 1 ] * tA[ 3 ] + aJ[ 2 ] * tA[ 6 ] ;
+                const real tInv = 1.0 / tDet ;
+
+                for( uint k=0; k<9; ++k )
+                {
+                    aJ[ k ] = tA[ k ] * tInv ;
+                }
+
+                return tDet ;
+            }
+
+//------------------------------------------------------------------------------
+
+            /**
+             * the batched kernel. The dimension is a template parameter,
+             * so that the loops over the dimensions are unrolled and
+             * the loops over the nodes can be vectorized
+             */
+            template< uint D >
+            void
+            compute_dNdX_batch(
+                    const uint   aNumberOfIntegrationPoints,
+                    const uint   aNumberOfGeometryNodes,
+                    const real * adGdXi,
+                    const uint   aNumberOfNodes,
+                    const real * adNdXi,
+                    const uint   aNumberOfElements,
+                    const real * aNodeCoords,
+                    real       * adNdX,
+                    real       * aDetJ )
+            {
+                const uint tGeoStride = aNumberOfGeometryNodes * D ;
+                const uint tStride    = aNumberOfNodes * D ;
+
+                real tJ[ D * D ];
+
+                for( uint e=0; e<aNumberOfElements; ++e )
+                {
+                    const real * tX = aNodeCoords + e * tGeoStride ;
+
+                    for( uint k=0; k<aNumberOfIntegrationPoints; ++k )
+                    {
+                        const real * tdGdXi = adGdXi + k * tGeoStride ;
+                        const real * tdNdXi = adNdXi + k * tStride ;
+                        real       * tdNdX  = adNdX  + ( e * aNumberOfIntegrationPoints + k ) * tStride ;
+
+                        // J( i, j ) = dGdXi( i, n ) * X( n, j )
+                        for( uint l=0; l<D*D; ++l )
+                        {
+                            tJ[ l ] = 0.0 ;
+                        }
+
+                        for( uint n=0; n<aNumberOfGeometryNodes; ++n )
+                        {
+                            for( uint i=0; i<D; ++i )
+                            {
+                                for( uint j=0; j<D; ++j )
+                                {
+                                    tJ[ i * D + j ] += tdGdXi[ n * D + i ] * tX[ n * D + j ];
+                                }
+                            }
+                        }
+
+                        aDetJ[ e * aNumberOfIntegrationPoints + k ]
+                            = std::abs( invert_jacobian< D >( tJ ) );
+
+                        // dNdX( i, n ) = inv( J )( i, j ) * dNdXi( j, n )
+                        for( uint n=0; n<aNumberOfNodes; ++n )
+                        {
+                            for( uint i=0; i<D; ++i )
+                            {
+                                real tValue = 0.0 ;
+                                for( uint j=0; j<D; ++j )
+                                {
+                                    tValue += tJ[ i * D + j ] * tdNdXi[ n * D + j ];
+                                }
+                                tdNdX[ n * D + i ] = tValue ;
+                            }
+                        }
+                    }
+                }
+            }
+
+//------------------------------------------------------------------------------
+        }
+
 //------------------------------------------------------------------------------
 
         IntegrationData::IntegrationData( const ElementType aElementType,
@@ -305,6 +451,112 @@ namespace belfem
             {
                 mShapeFunction->d2NdXi2( mPoints.col( k ), md2NdXi2( k ) );
             }
+
+            mNumberOfNodes = tNumberOfNodes ;
+            mNumberOfDimensions = tNumDim ;
+
+            this->create_tables() ;
+        }
+
+//------------------------------------------------------------------------------
+
+        void
+        IntegrationData::create_tables()
+        {
+            mNumberOfSecondDerivatives = mNumberOfIntegrationPoints > 0 ?
+                    md2NdXi2( 0 ).n_rows() : 0 ;
+
+            mNTable.set_size( mNumberOfIntegrationPoints * mNumberOfNodes );
+            mdNdXiTable.set_size( mNumberOfIntegrationPoints * mNumberOfNodes * mNumberOfDimensions );
+            md2NdXi2Table.set_size( mNumberOfIntegrationPoints * mNumberOfNodes * mNumberOfSecondDerivatives );
+
+            index_t tCount = 0 ;
+            for( uint k=0; k<mNumberOfIntegrationPoints; ++k )
+            {
+                const Matrix< real > & tN = mN( k );
+                for( uint i=0; i<mNumberOfNodes; ++i )
+                {
+                    mNTable( tCount++ ) = tN( 0, i );
+                }
+            }
+
+            tCount = 0 ;
+            for( uint k=0; k<mNumberOfIntegrationPoints; ++k )
+            {
+                const Matrix< real > & tdNdXi = mdNdXi( k );
+                for( uint i=0; i<mNumberOfNodes; ++i )
+                {
+                    for( uint j=0; j<mNumberOfDimensions; ++j )
+                    {
+                        mdNdXiTable( tCount++ ) = tdNdXi( j, i );
+                    }
+                }
+            }
+
+            tCount = 0 ;
+            for( uint k=0; k<mNumberOfIntegrationPoints; ++k )
+            {
+                const Matrix< real > & td2NdXi2 = md2NdXi2( k );
+                for( uint i=0; i<mNumberOfNodes; ++i )
+                {
+                    for( uint j=0; j<mNumberOfSecondDerivatives; ++j )
+                    {
+                        md2NdXi2Table( tCount++ ) = td2NdXi2( j, i );
+                    }
+                }
+            }
+        }
+
+//------------------------------------------------------------------------------
+
+        void
+        IntegrationData::compute_dNdX(
+                const IntegrationData & aGeometry,
+                const uint aNumberOfElements,
+                const real * aNodeCoords,
+                real * adNdX,
+                real * aDetJ ) const
+        {
+            BELFEM_ASSERT( aGeometry.number_of_integration_points() == mNumberOfIntegrationPoints,
+                           "geometry and shape function have different number of integration points ( %u and %u )",
+                           ( unsigned int ) aGeometry.number_of_integration_points(),
+                           ( unsigned int ) mNumberOfIntegrationPoints );
+
+            BELFEM_ASSERT( aGeometry.number_of_dimensions() == mNumberOfDimensions,
+                           "geometry and shape function have different dimensions" );
+
+            switch( mNumberOfDimensions )
+            {
+                case( 1 ) :
+                {
+                    compute_dNdX_batch< 1 >( mNumberOfIntegrationPoints,
+                                             aGeometry.number_of_nodes(), aGeometry.dNdXi_table(),
+                                             mNumberOfNodes, mdNdXiTable.data(),
+                                             aNumberOfElements, aNodeCoords, adNdX, aDetJ );
+                    break ;
+                }
+                case( 2 ) :
+                {
+                    compute_dNdX_batch< 2 >( mNumberOfIntegrationPoints,
+                                             aGeometry.number_of_nodes(), aGeometry.dNdXi_table(),
+                                             mNumberOfNodes, mdNdXiTable.data(),
+                                             aNumberOfElements, aNodeCoords, adNdX, aDetJ );
+                    break ;
+                }
+                case( 3 ) :
+                {
+                    compute_dNdX_batch< 3 >( mNumberOfIntegrationPoints,
+                                             aGeometry.number_of_nodes(), aGeometry.dNdXi_table(),
+                                             mNumberOfNodes, mdNdXiTable.data(),
+                                             aNumberOfElements, aNodeCoords, adNdX, aDetJ );
+                    break ;
+                }
+                default :
+                {
+                    BELFEM_ERROR( false, "invalid number of dimensions: %u",
+                                  ( unsigned int ) mNumberOfDimensions );
+                }
+            }
         }
 
 //------------------------------------------------------------------------------
@@ -36,7 +36,16 @@ namespace belfem
             Cell< Matrix< real > > mdNdXi;
             Cell< Matrix< real > > md2NdXi2;
 
+            // contiguous tables of all integration points, laid out as
+            // [ip][node] for N and [ip][node][dim] for the derivatives
+            Vector< real > mNTable ;
+            Vector< real > mdNdXiTable ;
+            Vector< real > md2NdXi2Table ;
+
             uint mNumberOfIntegrationPoints = 0 ;
+            uint mNumberOfNodes = 0 ;
+            uint mNumberOfDimensions = 0 ;
+            uint mNumberOfSecondDerivatives = 0 ;
 
 //------------------------------------------------------------------------------
         public:
@@ -161,6 +170,66 @@ namespace belfem
              const Matrix< real > &
              d2NdXi2( const uint aIndex ) const ;
 
+//------------------------------------------------------------------------------
+
+            /**
+             * number of nodes of the shape function
+             */
+            uint
+            number_of_nodes() const ;
+
+//------------------------------------------------------------------------------
+
+            /**
+             * number of dimensions of the parameter space
+             */
+            uint
+            number_of_dimensions() const ;
+
+//------------------------------------------------------------------------------
+
+            /**
+             * N of all integration points, laid out as [ip][node]
+             */
+            const real *
+            N_table() const ;
+
+//------------------------------------------------------------------------------
+
+            /**
+             * dNdXi of all integration points, laid out as [ip][node][dim]
+             */
+            const real *
+            dNdXi_table() const ;
+
+//------------------------------------------------------------------------------
+
+            /**
+             * d2NdXi2 of all integration points, laid out as [ip][node][derivative]
+             */
+            const real *
+            d2NdXi2_table() const ;
+
+//------------------------------------------------------------------------------
+
+            /**
+             * compute dNdX and the absolute value of det( J ) for a batch
+             * of elements at all integration points
+             *
+             * @param aGeometry     integration data of the geometry function,
+             *                      can be this object for isogeometric elements
+             * @param aNumberOfElements  number of elements in the batch
+             * @param aNodeCoords   node coordinates, laid out as [element][node][dim]
+             * @param adNdX         result, laid out as [element][ip][node][dim]
+             * @param aDetJ         result, laid out as [element][ip]
+             */
+            void
+            compute_dNdX( const IntegrationData & aGeometry,
+                          const uint aNumberOfElements,
+                          const real * aNodeCoords,
+                          real * adNdX,
+                          real * aDetJ ) const ;
+
 //------------------------------------------------------------------------------
         private :
 //------------------------------------------------------------------------------
@@ -205,6 +274,14 @@ namespace belfem
             void
             evaluate_function();
 
+//------------------------------------------------------------------------------
+
+            /**
+             * copy the shape functions into the contiguous tables
+             */
+            void
+            create_tables();
+
 //------------------------------------------------------------------------------
         };
 
@@ -290,6 +367,46 @@ namespace belfem
                 return md2NdXi2( aIndex );
             }
 
+//------------------------------------------------------------------------------
+
+            inline uint
+            IntegrationData::number_of_nodes() const
+            {
+                return mNumberOfNodes ;
+            }
+
+//------------------------------------------------------------------------------
+
+            inline uint
+            IntegrationData::number_of_dimensions() const
+            {
+                return mNumberOfDimensions ;
+            }
+
+//------------------------------------------------------------------------------
+
+            inline const real *
+            IntegrationData::N_table() const
+            {
+                return mNTable.data() ;
+            }
+
+//------------------------------------------------------------------------------
+
+            inline const real *
+            IntegrationData::dNdXi_table() const
+            {
+                return mdNdXiTable.data() ;
+            }
+
+//------------------------------------------------------------------------------
+
+            inline const real *
+            IntegrationData::d2NdXi2_table() const
+            {
+                return md2NdXi2Table.data() ;
+            }
+
 //------------------------------------------------------------------------------
     }
 }
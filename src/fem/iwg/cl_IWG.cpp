@@ -2044,6 +2044,27 @@ namespace belfem
             }
         }
 
+//------------------------------------------------------------------------------
+
+        void
+        IWG::copy_batch_dNdX( const uint aBatchIndex, const uint aPointIndex, Matrix< real > & aB )
+        {
+            const uint tNumDim   = mGroup->integration()->number_of_dimensions() ;
+            const uint tNumNodes = mGroup->integration()->number_of_nodes() ;
+
+            aB.set_size( tNumDim, tNumNodes );
+
+            const real * tdNdX = mGroup->batch_dNdX( aBatchIndex, aPointIndex );
+
+            for( uint k=0; k<tNumNodes; ++k )
+            {
+                for( uint i=0; i<tNumDim; ++i )
+                {
+                    aB( i, k ) = *tdNdX++ ;
+                }
+            }
+        }
+
 //------------------------------------------------------------------------------
 
         void
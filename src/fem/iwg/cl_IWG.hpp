@@ -188,6 +188,15 @@ namespace belfem
             // alpha is a special boundary condition for convective flow
             bool mHasAlpha = false ;
 
+            // tells if compute_jacobian_and_rhs only writes into the
+            // work containers of the group, so that elements can
+            // be integrated in parallel
+            bool mIsThreadSafe = false ;
+
+            // tells if compute_jacobian_and_rhs reads dNdX and det J
+            // from the batch geometry of the group
+            bool mUsesBatchGeometry = false ;
+
             // list of selected block ids
             Vector< id_t > mBlockIDs;
 
@@ -758,6 +767,22 @@ namespace belfem
              bool
              has_alpha() const ;
 
+//------------------------------------------------------------------------------
+
+            /**
+             * tells if the elements can be integrated in parallel
+             */
+             bool
+             is_thread_safe() const ;
+
+//------------------------------------------------------------------------------
+
+            /**
+             * tells if the geometry of the elements should be precomputed in batches
+             */
+             bool
+             uses_batch_geometry() const ;
+
 //------------------------------------------------------------------------------
 
             /**
@@ -1141,6 +1166,15 @@ namespace belfem
             void
             collect_node_coords( Element * aElement, Matrix< real > & aX );
 
+//------------------------------------------------------------------------------
+
+            /**
+             * copy dNdX of an element in the batch geometry of the group
+             * into a B-Matrix ( dim x nodes )
+             */
+            void
+            copy_batch_dNdX( const uint aBatchIndex, const uint aPointIndex, Matrix< real > & aB );
+
 //------------------------------------------------------------------------------
 
             /**
@@ -1240,6 +1274,22 @@ namespace belfem
             return mHasAlpha ;
          }
 
+//------------------------------------------------------------------------------
+
+         inline bool
+         IWG::is_thread_safe() const
+         {
+            return mIsThreadSafe ;
+         }
+
+//------------------------------------------------------------------------------
+
+         inline bool
+         IWG::uses_batch_geometry() const
+         {
+            return mUsesBatchGeometry ;
+         }
+
 //------------------------------------------------------------------------------
 
         inline const Cell< string > &
@@ -36,6 +36,12 @@ namespace belfem
 
             mFluxFields = { "dotQ" };
 
+            // all element data live in the work containers of the group
+            mIsThreadSafe = true ;
+
+            // dNdX and det J are taken from the batch geometry of the block
+            mUsesBatchGeometry = true ;
+
             this->initialize() ;
         }
 
@@ -68,20 +74,20 @@ namespace belfem
             // collect temperatures from last iteration
             this->collect_node_data( aElement, "T", tThat );
 
+            // position of the element in the batch geometry
+            const uint tBatchIndex = mGroup->batch_index( aElement );
+
             // loop over all integration points
             for( uint k=0; k<mNumberOfIntegrationPoints; ++k )
             {
-                // compute geometry Jacobian
-                Matrix< real > & tJ = aElement->J( k );
-
                 // interpolate temperature for this point
                 real tT = dot( mGroup->n( k ), tThat );
 
                 // determinant
-                real tDetJ = std::abs( det( tJ ) );
+                real tDetJ = mGroup->batch_det_J( tBatchIndex, k );
 
                 // compute B
-                tB = inv( tJ ) * mGroup->dNdXi( k );
+                this->copy_batch_dNdX( tBatchIndex, k, tB );
 
                 // compute thermal conductivity
                 mGroup->thermal_conductivity( tLambda, tT );
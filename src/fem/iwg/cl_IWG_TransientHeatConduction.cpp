@@ -94,19 +94,19 @@ namespace belfem
             // get the density
             const real tRho = mMaterial->rho();
 
+            // position of the element in the batch geometry
+            const uint tBatchIndex = mGroup->batch_index( aElement );
+
             for ( uint k = 0; k < mNumberOfIntegrationPoints; ++k )
             {
-                // compute geometry Jacobian
-                Matrix< real > & tJ = aElement->J( k );
-
                 // determinant
-                real tDetJ = std::abs( det( tJ ) );
+                real tDetJ = mGroup->batch_det_J( tBatchIndex, k );
 
                 // get shape function
                 const Matrix< real > & tN = mGroup->N( k );
 
                 // derivative matrix
-                tB = inv( tJ ) * mGroup->dNdXi( k );
+                this->copy_batch_dNdX( tBatchIndex, k, tB );
 
                 // interpolate temperature for this point
                 real tT = this->compute_T( k );
@@ -4,11 +4,13 @@
 #include "commtools.hpp"
 #include "cl_Logger.hpp"
 #include "cl_Timer.hpp"
+#include "cl_Profiler.hpp"
 #include "cl_FEM_DofManager.hpp"
 #include "cl_FEM_Kernel.hpp"
 #include "en_FEM_DomainType.hpp"
 #include "fn_entity_type.hpp"
 #include "cl_IWG.hpp"
+#include "filetools.hpp"
 
 namespace belfem
 {
@@ -277,6 +279,8 @@ namespace belfem
         void
         DofManager::initialize()
         {
+            ProfilerRegion tRegion( "initialize" );
+
             BELFEM_ASSERT( mIWG->is_initialized(), "initialize iwg first");
             BELFEM_ASSERT( mSolverData->solver() != nullptr, "set solver first" );
 
@@ -332,12 +336,31 @@ namespace belfem
 
             mDofData->init_dirichlet_bcs() ;
 
-            mDofData->compute_dof_indices();
+            mCheckpointLoaded = this->load_checkpoint() ;
 
-            mSolverData->allocate_matrices();
+            if( ! mCheckpointLoaded )
+            {
+                mDofData->compute_dof_indices();
 
-            mSolverData->create_assembly_tables();
+                mSolverData->allocate_matrices();
 
+                mSolverData->create_assembly_tables();
+
+                this->save_checkpoint() ;
+            }
+
+            // sort elements into colors for the threaded assembly
+            if( mNumberOfThreads > 1 )
+            {
+                for ( Block * tBlock : mBlockData->blocks() )
+                {
+                    tBlock->color_elements() ;
+                }
+                for ( SideSet * tSideSet : mSideSetData->sidesets() )
+                {
+                    tSideSet->color_elements() ;
+                }
+            }
 
             if ( mMyRank == mParent->master() )
             {
@@ -352,11 +375,16 @@ namespace belfem
         void
         DofManager::compute_jacobian( const bool aReset )
         {
+            ProfilerRegion tRegion( "assemble_jacobian" );
+
             if( ! mInitializedFlag )
             {
                 this->initialize();
             }
 
+            // these loops do not overlap with the halo exchange
+            mFieldData->finish_synchronize() ;
+
             Timer tTimer;
 
             // in most cases, we want to reset all matrices
@@ -440,11 +468,16 @@ namespace belfem
         void
         DofManager::compute_rhs( const bool aReset )
         {
+            ProfilerRegion tRegion( "assemble_rhs" );
+
             if( ! mInitializedFlag )
             {
                 this->initialize();
             }
 
+            // these loops do not overlap with the halo exchange
+            mFieldData->finish_synchronize() ;
+
             Timer tTimer;
 
             if( mIWG->num_rhs_cols() == 1 )
@@ -496,6 +529,8 @@ namespace belfem
         void
         DofManager::compute_jacobian_and_rhs( const bool aReset )
         {
+            ProfilerRegion tRegion( "assemble" );
+
             if( ! mInitializedFlag )
             {
                 this->initialize();
@@ -511,6 +546,10 @@ namespace belfem
                 mSolverData->reset_rhs_vector() ;
             }
 
+            // if fields are still being exchanged, the interior elements
+            // are computed first, and the others once the data have arrived
+            const bool tOverlap = mFieldData->halo_is_active() ;
+
             // loop over all blocks
             for ( Block * tBlock : mBlockData->blocks() )
             {
@@ -520,29 +559,33 @@ namespace belfem
                     continue ;
                 }
 
-                // get the number of dofs per element
-                uint tN = mDofData->num_dofs_per_element( tBlock->id() );
-
-                // allocate matrix
-                Matrix< real > tJ( tN, tN );
-
-                // allocate element RHS
-                Vector< real > tB( tN );
-
                 // link IWG to block
                 mIWG->link_to_group( tBlock );
 
-                // get elements on block
-                Cell< Element * > & tElements = tBlock->elements();
+                // compute and add element contributions
+                this->assemble_group( tBlock,
+                                      mDofData->num_dofs_per_element( tBlock->id() ),
+                                      & IWG::compute_jacobian_and_rhs,
+                                      tOverlap ? HaloPass::Interior : HaloPass::All );
+            }
 
-                // loop over all elements
-                for ( Element * tElement : tElements )
+            if( tOverlap )
+            {
+                mFieldData->finish_synchronize() ;
+
+                for ( Block * tBlock : mBlockData->blocks() )
                 {
-                    // compute element contribution
-                    mIWG->compute_jacobian_and_rhs( tElement, tJ, tB );
+                    if( ! tBlock->is_active() )
+                    {
+                        continue ;
+                    }
+
+                    mIWG->link_to_group( tBlock );
 
-                    // add contribution to system matrix
-                    mSolverData->assemble_jacobian_and_rhs( tElement, tJ, tB );
+                    this->assemble_group( tBlock,
+                                          mDofData->num_dofs_per_element( tBlock->id() ),
+                                          & IWG::compute_jacobian_and_rhs,
+                                          HaloPass::Halo );
                 }
             }
 
@@ -557,27 +600,10 @@ namespace belfem
                 // link IWG to block
                 mIWG->link_to_group( tSideSet );
 
-                // get the number of dofs per element
-                uint tN = mIWG->number_of_dofs_per_element( tSideSet );
-
-                // allocate matrix
-                Matrix< real > tJ( tN, tN );
-
-                // allocate element RHS
-                Vector< real > tB( tN );
-
-                // get elements on block
-                Cell< Element * > & tElements = tSideSet->elements();
-
-                // loop over all elements
-                for ( Element * tElement : tElements )
-                {
-                    // compute element contribution
-                    mIWG->compute_jacobian_and_rhs( tElement, tJ, tB );
-
-                    // add contribution to system matrix
-                    mSolverData->assemble_jacobian_and_rhs( tElement, tJ, tB );
-                }
+                // compute and add element contributions
+                this->assemble_group( tSideSet,
+                                      mIWG->number_of_dofs_per_element( tSideSet ),
+                                      & IWG::compute_jacobian_and_rhs );
             }
 
             if( mIWG->has_alpha() )
@@ -600,22 +626,9 @@ namespace belfem
                                   mesh::number_of_corner_nodes( tSideSet->element_type() )
                                    :  mesh::number_of_nodes( tSideSet->element_type() );
 
-                        // allocate element Jacobian
-                        Matrix< real > tJ( tN, tN );
-
-                        // allocate element RHS
-                        Vector< real > tB( tN );
-
-                        // get elements on Sideset
-                        Cell< Element * > & tElements = tSideSet->elements();
-
-                        // loop over all elements on this sideset
-                        for ( Element * tElement : tElements )
-                        {
-                            mIWG->compute_alpha_boundary_condition( tElement, tJ, tB );
-                            mSolverData->assemble_jacobian_and_rhs( tElement, tJ, tB );
-                        }
-
+                        // compute and add element contributions
+                        this->assemble_group( tSideSet, tN,
+                                              & IWG::compute_alpha_boundary_condition );
                     }
                 }
             }
@@ -717,19 +730,386 @@ namespace belfem
         }
 
 
+//-----------------------------------------------------------------------------
+
+        void
+        DofManager::set_number_of_threads( const uint aNumberOfThreads )
+        {
+#ifdef OMP
+            mNumberOfThreads = aNumberOfThreads > 0 ? aNumberOfThreads : 1 ;
+#else
+            if( aNumberOfThreads > 1 && mMyRank == mParent->master() )
+            {
+                message( 4, " Warning: code was compiled without OpenMP, using one thread for assembly\n" );
+            }
+            mNumberOfThreads = 1 ;
+#endif
+        }
+
+//-----------------------------------------------------------------------------
+
+        void
+        DofManager::set_distributed_assembly( const bool aSwitch )
+        {
+            BELFEM_ERROR( ! mInitializedFlag,
+                          "distributed assembly must be set before the dof manager is initialized" );
+
+            mSolverData->set_distributed_assembly( aSwitch );
+
+            // the rows of each proc must form a contiguous block
+            mDofData->set_partition_numbering( aSwitch
+                    && mParent->number_of_procs() > 1
+                    && mParent->number_of_procs() == comm_size()
+                    && mParent->master() == 0 );
+        }
+
+//-----------------------------------------------------------------------------
+
+        void
+        DofManager::set_long_indices( const bool aSwitch )
+        {
+            BELFEM_ERROR( ! mInitializedFlag,
+                          "64-bit indices must be set before the dof manager is initialized" );
+
+            mSolverData->set_long_indices( aSwitch );
+        }
+
+//-----------------------------------------------------------------------------
+
+        void
+        DofManager::set_checkpoint( const string & aPath )
+        {
+            BELFEM_ERROR( ! mInitializedFlag,
+                          "the checkpoint must be set before the dof manager is initialized" );
+
+            mCheckpoint = aPath ;
+        }
+
+//-----------------------------------------------------------------------------
+
+        bool
+        DofManager::checkpoint_loaded() const
+        {
+            return mCheckpointLoaded ;
+        }
+
+//-----------------------------------------------------------------------------
+
+        bool
+        DofManager::load_checkpoint()
+        {
+#ifdef BELFEM_HDF5
+            // the flags are the same on all procs
+            if( mCheckpoint.empty() || ! mSolverData->supports_checkpoint() )
+            {
+                return false ;
+            }
+
+            uint tMatch = 0 ;
+
+            if( file_exists( make_path_parallel( mCheckpoint ) ) )
+            {
+                HDF5 tFile( mCheckpoint, FileMode::OPEN_RDONLY, true );
+
+                tMatch = mDofData->checkpoint_matches( tFile )
+                      && mSolverData->checkpoint_matches( tFile ) ? 1 : 0 ;
+
+                tFile.close() ;
+            }
+
+            // all procs must use the checkpoint, or none
+            if( mParent->number_of_procs() > 1 )
+            {
+                if( mMyRank == mParent->master() )
+                {
+                    Vector< uint > tMatches ;
+                    receive( mParent->comm_table(), tMatches, tMatch );
+
+                    for( uint tFlag : tMatches )
+                    {
+                        tMatch = tMatch && tFlag ;
+                    }
+
+                    Vector< uint > tResult( mParent->comm_table().length(), tMatch );
+                    send( mParent->comm_table(), tResult );
+                }
+                else
+                {
+                    send( mParent->master(), tMatch );
+                    receive( mParent->master(), tMatch );
+                }
+            }
+
+            // the ordering is only valid for the same pattern
+            if( mMyRank == mParent->master() )
+            {
+                mSolverData->solver()->wrapper()->set_ordering_file(
+                        this->ordering_path(), tMatch == 1 );
+            }
+
+            if( tMatch == 0 )
+            {
+                return false ;
+            }
+
+            if( mMyRank == mParent->master() )
+            {
+                message( 4, "    reading setup from %s\n", mCheckpoint.c_str() );
+            }
+
+            HDF5 tFile( mCheckpoint, FileMode::OPEN_RDONLY, true );
+
+            mDofData->load_checkpoint( tFile );
+            mSolverData->load_checkpoint( tFile );
+
+            tFile.close() ;
+
+            return true ;
+#else
+            return false ;
+#endif
+        }
+
+//-----------------------------------------------------------------------------
+
+        void
+        DofManager::save_checkpoint()
+        {
+#ifdef BELFEM_HDF5
+            if( mCheckpoint.empty() || ! mSolverData->supports_checkpoint() )
+            {
+                return ;
+            }
+
+            HDF5 tFile( mCheckpoint, FileMode::NEW, true );
+
+            mDofData->save_checkpoint( tFile );
+            mSolverData->save_checkpoint( tFile );
+
+            tFile.close() ;
+#endif
+        }
+
+//-----------------------------------------------------------------------------
+
+        string
+        DofManager::ordering_path() const
+        {
+            return mCheckpoint.substr( 0, mCheckpoint.find_last_of( "." ) ) + "_ordering.umf" ;
+        }
+
+//-----------------------------------------------------------------------------
+
+        void
+        DofManager::assemble_group(
+                Group * aGroup,
+                const uint aNumberOfDofsPerElement,
+                void ( IWG::*aFunction )( Element *, Matrix< real > &, Vector< real > & ),
+                const HaloPass aPass )
+        {
+            const uint & tN = aNumberOfDofsPerElement ;
+
+            // tells if an element is computed in this pass
+            auto tSelect = [ & ]( Element * aElement ) -> bool
+            {
+                return aPass == HaloPass::All
+                    || mFieldData->is_halo_element( aElement ) == ( aPass == HaloPass::Halo ) ;
+            };
+
+            // precompute dNdX and det J for several elements at once
+            const bool tUseBatches = mIWG->uses_batch_geometry()
+                    && aGroup->type() == GroupType::BLOCK ;
+
+            if( mNumberOfThreads == 1 || ! mIWG->is_thread_safe() )
+            {
+                // allocate element Jacobian
+                Matrix< real > tJ( tN, tN );
+
+                // allocate element RHS
+                Vector< real > tB( tN );
+
+                // the elements of this pass, so that the batches stay contiguous
+                Cell< Element * > tSelection ;
+                if( aPass != HaloPass::All )
+                {
+                    for( Element * tElement : aGroup->elements() )
+                    {
+                        if( tSelect( tElement ) )
+                        {
+                            tSelection.push( tElement );
+                        }
+                    }
+                }
+
+                Cell< Element * > & tElements = aPass == HaloPass::All ?
+                        aGroup->elements() : tSelection ;
+                const index_t tNumElements = tElements.size() ;
+
+                // loop over all elements
+                for( index_t f=0; f<tNumElements; f+=mBatchSize )
+                {
+                    const index_t tLast = std::min( f + mBatchSize, tNumElements );
+
+                    if( tUseBatches )
+                    {
+                        aGroup->compute_batch_geometry( tElements.data() + f, tLast - f );
+                    }
+
+                    for( index_t e=f; e<tLast; ++e )
+                    {
+                        Element * tElement = tElements( e );
+
+                        // compute element contribution
+                        ( mIWG->*aFunction )( tElement, tJ, tB );
+
+                        // add contribution to system matrix
+                        mSolverData->assemble_jacobian_and_rhs( tElement, tJ, tB );
+                    }
+                }
+                return;
+            }
+
+            // colors are created by init_matrices, unless the number
+            // of threads was changed afterwards
+            if( aGroup->element_colors().size() == 0 && aGroup->number_of_elements() > 0 )
+            {
+                aGroup->color_elements() ;
+            }
+
+            // the work containers were allocated by link_to_group,
+            // each thread needs its own copy
+            aGroup->replicate_work( mNumberOfThreads );
+
+            Cell< Element * > & tElements = aGroup->elements() ;
+
+            // elements of the same color do not write into the same rows
+            const Cell< Vector< index_t > > & tColors = aGroup->element_colors() ;
+
+            for( uint c=0; c<tColors.size(); ++c )
+            {
+                const Vector< index_t > & tAllColor = tColors( c );
+
+                // the elements of this color that are computed in this pass
+                Vector< index_t > tSelection ;
+                if( aPass != HaloPass::All )
+                {
+                    index_t tCount = 0 ;
+                    for( index_t e : tAllColor )
+                    {
+                        if( tSelect( tElements( e ) ) )
+                        {
+                            ++tCount ;
+                        }
+                    }
+
+                    tSelection.set_size( tCount );
+                    tCount = 0 ;
+
+                    for( index_t e : tAllColor )
+                    {
+                        if( tSelect( tElements( e ) ) )
+                        {
+                            tSelection( tCount++ ) = e ;
+                        }
+                    }
+                }
+
+                const Vector< index_t > & tColor = aPass == HaloPass::All ? tAllColor : tSelection ;
+                const index_t tNumElements = tColor.length() ;
+                const index_t tNumBatches  = ( tNumElements + mBatchSize - 1 ) / mBatchSize ;
+#ifdef OMP
+                #pragma omp parallel num_threads( mNumberOfThreads )
+#endif
+                {
+                    Matrix< real > tJ( tN, tN );
+                    Vector< real > tB( tN );
+
+                    // the elements of a color are not contiguous
+                    Cell< Element * > tBatch( mBatchSize, nullptr );
+#ifdef OMP
+                    #pragma omp for schedule( dynamic, 4 )
+#endif
+                    for( index_t b=0; b<tNumBatches; ++b )
+                    {
+                        const index_t tFirst = b * mBatchSize ;
+                        const uint    tCount = std::min( tNumElements - tFirst, ( index_t ) mBatchSize );
+
+                        for( uint e=0; e<tCount; ++e )
+                        {
+                            tBatch( e ) = tElements( tColor( tFirst + e ) );
+                        }
+
+                        if( tUseBatches )
+                        {
+                            aGroup->compute_batch_geometry( tBatch.data(), tCount );
+                        }
+
+                        for( uint e=0; e<tCount; ++e )
+                        {
+                            Element * tElement = tBatch( e );
+
+                            // compute element contribution
+                            ( mIWG->*aFunction )( tElement, tJ, tB );
+
+                            // add contribution to system matrix
+                            mSolverData->assemble_jacobian_and_rhs( tElement, tJ, tB );
+                        }
+                    }
+                }
+            }
+        }
+
 //-----------------------------------------------------------------------------
 
         void
         DofManager::solve()
         {
+            ProfilerRegion tRegion( "solve" );
+
             // solve the system
             mSolverData->solve();
 
-            // make result available to other procs
-            mFieldData->distribute( mIWG->all_fields() );
+            if( mSolverData->updates_local_dofs() )
+            {
+                // each proc has written the solution and the fixed values
+                // of its own dofs, only the other fields come from the master
+                const Cell< string > & tDofFields = mIWG->dof_fields() ;
+                const Cell< string > & tAllFields = mIWG->all_fields() ;
 
-            // wait for other procs
-            comm_barrier();
+                Cell< string > tOtherFields ;
+                for( uint f=0; f<tAllFields.size(); ++f )
+                {
+                    bool tIsDofField = false ;
+                    for( uint k=0; k<tDofFields.size(); ++k )
+                    {
+                        if( tDofFields( k ) == tAllFields( f ) )
+                        {
+                            tIsDofField = true ;
+                            break ;
+                        }
+                    }
+                    if( ! tIsDofField )
+                    {
+                        tOtherFields.push( tAllFields( f ) );
+                    }
+                }
+
+                if( this->enforce_linear_interpolation() )
+                {
+                    mFieldData->project_linear_field_to_higher_mesh( tDofFields );
+                }
+
+                if( tOtherFields.size() > 0 )
+                {
+                    mFieldData->distribute( tOtherFields );
+                }
+            }
+            else
+            {
+                // make result available to other procs,
+                // the receive is the synchronization point
+                mFieldData->distribute( mIWG->all_fields() );
+            }
         }
 
 //-----------------------------------------------------------------------------
@@ -797,10 +1177,15 @@ namespace belfem
         void
         DofManager::synchronize_fields( const Cell< string > & aFieldLabels )
         {
-            comm_barrier() ;
-            mFieldData->collect( aFieldLabels );
-            comm_barrier();
-            mFieldData->distribute( aFieldLabels );
+            mFieldData->synchronize( aFieldLabels );
+        }
+
+//-----------------------------------------------------------------------------
+
+        void
+        DofManager::start_synchronize_fields( const Cell< string > & aFieldLabels )
+        {
+            mFieldData->start_synchronize( aFieldLabels );
         }
 
 //-----------------------------------------------------------------------------
@@ -888,6 +1273,12 @@ namespace belfem
         {
             mSolverData->load_system( aFile );
         }
+
+        void
+        DofManager::stage_system( dofmgr::SystemSnapshot & aSnapshot )
+        {
+            mSolverData->stage_system( aSnapshot );
+        }
 #endif
 
 //-----------------------------------------------------------------------------
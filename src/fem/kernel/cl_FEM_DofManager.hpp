@@ -36,6 +36,17 @@ namespace belfem
     {
         class Kernel;
 
+        /**
+         * which elements of a group are assembled while a halo
+         * exchange is running
+         */
+        enum class HaloPass
+        {
+            All,       // all elements, no exchange is running
+            Interior,  // elements that do not need data from the neighbors
+            Halo       // elements that touch entities owned by the neighbors
+        };
+
         /**
          * this class creates the DOFs based on the passed equation object.
          */
@@ -68,6 +79,18 @@ namespace belfem
             //! flag telling if system has been initialized
             bool mInitializedFlag = false ;
 
+            //! number of threads used for the element assembly
+            uint mNumberOfThreads = 1 ;
+
+            //! number of elements whose geometry is computed at once
+            const uint mBatchSize = 16 ;
+
+            //! file with the setup of an earlier run, empty if not used
+            string mCheckpoint = "" ;
+
+            //! tells if initialize() has read the setup from the checkpoint
+            bool mCheckpointLoaded = false ;
+
             //! a DOF manager can contain other dof managers
             //! these are used for L2 projection
             //! postprocessors are owned and destroyed by the kernel
@@ -225,6 +248,66 @@ namespace belfem
             void
             set_solver( const SolverType aSolver );
 
+//------------------------------------------------------------------------------
+
+            /**
+             * set the number of threads used for the element assembly.
+             * Only IWGs that are flagged as thread safe are
+             * integrated in parallel.
+             */
+            void
+            set_number_of_threads( const uint aNumberOfThreads );
+
+//------------------------------------------------------------------------------
+
+            /**
+             * the number of threads used for the element assembly
+             */
+            uint
+            number_of_threads() const ;
+
+//------------------------------------------------------------------------------
+
+            /**
+             * keep the rows of the Jacobian on the procs that own them
+             * instead of gathering the matrix on the master.
+             * Only used by solvers that support it, such as PETSc and STRUMPACK.
+             * Must be called before the dof manager is initialized.
+             */
+            void
+            set_distributed_assembly( const bool aSwitch );
+
+//------------------------------------------------------------------------------
+
+            /**
+             * use 64-bit indices for the Jacobian on the master.
+             * Only used by solvers that support it, such as UMFPACK and PARDISO.
+             * Must be called before the dof manager is initialized.
+             */
+            void
+            set_long_indices( const bool aSwitch );
+
+//------------------------------------------------------------------------------
+
+            /**
+             * file that stores the dof numbering, the sparsity pattern,
+             * the assembly tables and the solver ordering. If it matches
+             * the model, initialize() reads the setup from it, otherwise,
+             * the setup is computed and written into the file.
+             * Each proc uses its own file.
+             * Must be called before the dof manager is initialized.
+             */
+            void
+            set_checkpoint( const string & aPath );
+
+//------------------------------------------------------------------------------
+
+            /**
+             * tells if initialize() has read the setup from the checkpoint
+             */
+            bool
+            checkpoint_loaded() const ;
+
 //------------------------------------------------------------------------------
 
             /**
@@ -275,6 +358,16 @@ namespace belfem
             void
             synchronize_fields( const Cell< string > & aFieldLabels ) ;
 
+//-----------------------------------------------------------------------------
+
+            /**
+             * like synchronize_fields, but node and edge fields are only
+             * sent. The next assembly computes the interior elements
+             * before it waits for the received values.
+             */
+            void
+            start_synchronize_fields( const Cell< string > & aFieldLabels ) ;
+
 //-----------------------------------------------------------------------------
 
             void
@@ -320,6 +413,9 @@ namespace belfem
             void
             save_system( HDF5 & aFile );
 
+            void
+            stage_system( dofmgr::SystemSnapshot & aSnapshot );
+
 #endif
 //-----------------------------------------------------------------------------
 
@@ -404,6 +500,41 @@ namespace belfem
             void
             init_matrices();
 
+//-----------------------------------------------------------------------------
+
+            /**
+             * read the setup from the checkpoint, returns false
+             * if the checkpoint does not match on any proc
+             */
+            bool
+            load_checkpoint();
+
+//-----------------------------------------------------------------------------
+
+            void
+            save_checkpoint();
+
+//-----------------------------------------------------------------------------
+
+            /**
+             * path of the ordering file that belongs to the checkpoint
+             */
+            string
+            ordering_path() const ;
+
+//-----------------------------------------------------------------------------
+
+            /**
+             * compute the element contributions of a group and add them
+             * to the system. Elements of the same color are processed in
+             * parallel if more than one thread is used.
+             */
+            void
+            assemble_group(
+                    Group * aGroup,
+                    const uint aNumberOfDofsPerElement,
+                    void ( IWG::*aFunction )( Element *, Matrix< real > &, Vector< real > & ),
+                    const HaloPass aPass = HaloPass::All );
 //-----------------------------------------------------------------------------
 
             void
@@ -447,6 +578,14 @@ namespace belfem
             return mParams->block_integration_order() ;
         }
 
+//------------------------------------------------------------------------------
+
+        inline uint
+        DofManager::number_of_threads() const
+        {
+            return mNumberOfThreads ;
+        }
+
 
 //------------------------------------------------------------------------------
 
@@ -54,6 +54,7 @@ namespace belfem
                 // delete the tables
                 mDofIDs.clear() ;
                 mDofIndices.clear() ;
+                mFreeDofDistribution.set_size( 0 );
 
                 // delete the dofs
                 for ( Dof * tDof : mDOFs )
@@ -2848,6 +2849,11 @@ namespace belfem
                     {
                         tDof->set_index( tIndices( tCount++ ) );
                     }
+
+                    if( mPartitionNumbering )
+                    {
+                        receive( mKernel->master(), mFreeDofDistribution );
+                    }
                 }
                 else
                 {
@@ -2873,6 +2879,11 @@ namespace belfem
                     // get size of communication table
                     uint tNumProcs = mKernel->comm_table().length() ;
 
+                    if( mPartitionNumbering )
+                    {
+                        this->number_free_dofs_by_partition() ;
+                    }
+
                     // this container holds the global indices for all procs
                     Cell< Vector< index_t > > tAllIndices( tNumProcs, {} );
 
@@ -2907,9 +2918,147 @@ namespace belfem
                     tCounters( 0 ) = mNumberOfFreeDofs ;
                     tCounters( 1 ) = mNumberOfFixedDofs ;
                     send_same( mKernel->comm_table(), tCounters );
+
+                    if( mPartitionNumbering )
+                    {
+                        send_same( mKernel->comm_table(), mFreeDofDistribution );
+                    }
                 }
             }
 
+//------------------------------------------------------------------------------
+
+            void
+            DofData::number_free_dofs_by_partition()
+            {
+                // the ranks are used as proc indices
+                proc_t tNumProcs = mKernel->comm_table().length() ;
+
+                BELFEM_ERROR( mKernel->master() == 0 && tNumProcs == comm_size(),
+                              "numbering by partition requires all procs and rank 0 as master" );
+
+                // count the free dofs of each owner
+                mFreeDofDistribution.set_size( tNumProcs + 1, 0 );
+
+                for ( Dof * tDof : mDOFs )
+                {
+                    if ( ! tDof->is_fixed() )
+                    {
+                        // dofs on entities that are not part of the kernel go to the master
+                        proc_t tOwner = tDof->owner() < tNumProcs ? tDof->owner() : mKernel->master() ;
+                        ++mFreeDofDistribution( tOwner + 1 );
+                    }
+                }
+
+                for( proc_t p=0; p<tNumProcs; ++p )
+                {
+                    mFreeDofDistribution( p + 1 ) += mFreeDofDistribution( p );
+                }
+
+                // the owned dofs of each proc form a contiguous range
+                Vector< index_t > tOffsets( tNumProcs );
+                for( proc_t p=0; p<tNumProcs; ++p )
+                {
+                    tOffsets( p ) = mFreeDofDistribution( p );
+                }
+
+                for ( Dof * tDof : mDOFs )
+                {
+                    if ( ! tDof->is_fixed() )
+                    {
+                        proc_t tOwner = tDof->owner() < tNumProcs ? tDof->owner() : mKernel->master() ;
+                        tDof->set_index( tOffsets( tOwner )++ );
+                    }
+                }
+            }
+
+//------------------------------------------------------------------------------
+
+#ifdef BELFEM_HDF5
+            void
+            DofData::save_checkpoint( HDF5 & aFile )
+            {
+                index_t tNumDofs = mDOFs.size() ;
+
+                Vector< id_t >    tIDs( tNumDofs );
+                Vector< uint >    tFixed( tNumDofs );
+                Vector< index_t > tIndices( tNumDofs );
+
+                index_t tCount = 0 ;
+                for( Dof * tDof : mDOFs )
+                {
+                    tIDs( tCount )     = tDof->id() ;
+                    tFixed( tCount )   = tDof->is_fixed() ? 1 : 0 ;
+                    tIndices( tCount ) = tDof->index() ;
+                    ++tCount ;
+                }
+
+                aFile.create_group( "Dofs" );
+                aFile.save_data( "DofIDs", tIDs );
+                aFile.save_data( "FixedFlags", tFixed );
+                aFile.save_data( "Indices", tIndices );
+                aFile.save_data( "NumberOfFreeDofs", mNumberOfFreeDofs );
+                aFile.save_data( "NumberOfFixedDofs", mNumberOfFixedDofs );
+                aFile.close_active_group() ;
+            }
+
+//------------------------------------------------------------------------------
+
+            bool
+            DofData::checkpoint_matches( HDF5 & aFile )
+            {
+                Vector< id_t > tIDs ;
+                Vector< uint > tFixed ;
+
+                aFile.select_group( "Dofs" );
+                aFile.load_data( "DofIDs", tIDs );
+                aFile.load_data( "FixedFlags", tFixed );
+                aFile.close_active_group() ;
+
+                if( tIDs.length() != mDOFs.size() || tFixed.length() != mDOFs.size() )
+                {
+                    return false ;
+                }
+
+                index_t tCount = 0 ;
+                for( Dof * tDof : mDOFs )
+                {
+                    if( tIDs( tCount ) != tDof->id()
+                        || ( tFixed( tCount ) == 1 ) != tDof->is_fixed() )
+                    {
+                        return false ;
+                    }
+                    ++tCount ;
+                }
+
+                return true ;
+            }
+
+//------------------------------------------------------------------------------
+
+            void
+            DofData::load_checkpoint( HDF5 & aFile )
+            {
+                Vector< index_t > tIndices ;
+
+                aFile.select_group( "Dofs" );
+                aFile.load_data( "Indices", tIndices );
+                aFile.load_data( "NumberOfFreeDofs", mNumberOfFreeDofs );
+                aFile.load_data( "NumberOfFixedDofs", mNumberOfFixedDofs );
+                aFile.close_active_group() ;
+
+                BELFEM_ERROR( tIndices.length() == mDOFs.size(),
+                              "Length of indices does not match. ( is %lu, expect %lu )",
+                              ( long unsigned int ) tIndices.length(),
+                              ( long unsigned int ) mDOFs.size() );
+
+                index_t tCount = 0 ;
+                for( Dof * tDof : mDOFs )
+                {
+                    tDof->set_index( tIndices( tCount++ ) );
+                }
+            }
+#endif
 //------------------------------------------------------------------------------
 
             uint
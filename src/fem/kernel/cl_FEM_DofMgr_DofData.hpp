@@ -12,6 +12,7 @@
 #include "cl_Vector.hpp"
 #include "cl_FEM_DofMgr_Parameters.hpp"
 #include "cl_IWG.hpp"
+#include "cl_HDF5.hpp"
 
 namespace belfem
 {
@@ -65,6 +66,12 @@ namespace belfem
                 // system wide dofs
                 index_t mNumberOfFreeDofs;
                 index_t mNumberOfFixedDofs;
+
+                // number the free dofs by the proc that owns them
+                bool mPartitionNumbering = false ;
+
+                // first free dof index of each proc, if numbered by partition
+                Vector< index_t > mFreeDofDistribution ;
                 id_t mNumDofTypes = BELFEM_UINT_MAX ;
 
 //------------------------------------------------------------------------------
@@ -167,6 +174,53 @@ namespace belfem
 
 //------------------------------------------------------------------------------
 
+                /**
+                 * number the free dofs so that the dofs owned by each proc
+                 * form a contiguous range. Must be called on all procs
+                 * before the dof indices are computed.
+                 */
+                void
+                set_partition_numbering( const bool aSwitch );
+
+//------------------------------------------------------------------------------
+
+                /**
+                 * first free dof index of each proc, with one more entry
+                 * than procs. Empty unless numbered by partition.
+                 */
+                const Vector< index_t > &
+                free_dof_distribution() const ;
+
+//------------------------------------------------------------------------------
+
+#ifdef BELFEM_HDF5
+                /**
+                 * write the ids, the fixed flags and the indices of the dofs
+                 * on this proc into the checkpoint
+                 */
+                void
+                save_checkpoint( HDF5 & aFile );
+
+//------------------------------------------------------------------------------
+
+                /**
+                 * tells if the checkpoint was written for the same dofs
+                 * and Dirichlet conditions on this proc
+                 */
+                bool
+                checkpoint_matches( HDF5 & aFile );
+
+//------------------------------------------------------------------------------
+
+                /**
+                 * replaces compute_dof_indices(), needs no communication
+                 */
+                void
+                load_checkpoint( HDF5 & aFile );
+
+//------------------------------------------------------------------------------
+#endif
+
                 const index_t &
                 number_of_free_dofs() const ;
 
@@ -208,6 +262,14 @@ namespace belfem
                 void
                 create_dof_map();
 
+//------------------------------------------------------------------------------
+
+                /**
+                 * renumber the free dofs by their owners, master only
+                 */
+                void
+                number_free_dofs_by_partition();
+
 //------------------------------------------------------------------------------
 
                 /**
@@ -406,6 +468,22 @@ namespace belfem
                 return mDofIndices( aProcIndex );
             }
 
+//------------------------------------------------------------------------------
+
+            inline void
+            DofData::set_partition_numbering( const bool aSwitch )
+            {
+                mPartitionNumbering = aSwitch ;
+            }
+
+//------------------------------------------------------------------------------
+
+            inline const Vector< index_t > &
+            DofData::free_dof_distribution() const
+            {
+                return mFreeDofDistribution ;
+            }
+
 //------------------------------------------------------------------------------
 
         } /* end namespace dofmgr */
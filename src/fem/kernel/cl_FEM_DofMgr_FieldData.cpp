@@ -5,12 +5,14 @@
 #include "cl_FEM_DofMgr_FieldData.hpp"
 
 #include "commtools.hpp"
+#include "cl_HaloExchange.hpp"
 #include "cl_Logger.hpp"
 #include "cl_Timer.hpp"
 #include "cl_FEM_DofMgr_FieldData.hpp"
 #include "cl_Mesh.hpp"
 #include "cl_FEM_Kernel.hpp"
 #include "cl_FEM_DofManager.hpp"
+#include "cl_FEM_Element.hpp"
 #include "cl_IF_InterpolationFunctionFactory.hpp"
 #include "cl_Mesh.hpp"
 #include "fn_max.hpp"
@@ -46,6 +48,21 @@ namespace belfem
             void
             FieldData::reset()
             {
+                if( mNodeHalo != nullptr )
+                {
+                    delete mNodeHalo ;
+                    mNodeHalo = nullptr ;
+                }
+
+                if( mEdgeHalo != nullptr )
+                {
+                    delete mEdgeHalo ;
+                    mEdgeHalo = nullptr ;
+                }
+
+                mHaloNodeFields.clear() ;
+                mHaloEdgeFields.clear() ;
+
                 mMyNumberOfOwnedNodes = 0 ;
                 mMyNumberOfOwnedGhostElements = 0 ;
                 mNodeOwnerList.clear();
@@ -235,6 +252,9 @@ namespace belfem
             void
             FieldData::collect( const string & aLabel )
             {
+                // the fields must not change while a halo exchange is running
+                this->finish_synchronize() ;
+
                 EntityType tType = mMesh->field( aLabel )->entity_type() ;
 
                 BELFEM_ASSERT( tType == EntityType::NODE ||
@@ -346,6 +366,9 @@ namespace belfem
             void
             FieldData::collect( const Cell< string > & aLabels )
             {
+                // the fields must not change while a halo exchange is running
+                this->finish_synchronize() ;
+
                 if( mCommSize > 1 )
                 {
 
@@ -1152,6 +1175,9 @@ namespace belfem
             void
             FieldData::distribute( const Cell< string > & aFieldLabels )
             {
+                // the fields must not change while a halo exchange is running
+                this->finish_synchronize() ;
+
                 // get number of fields
                 uint tNumberOfFields = aFieldLabels.size();
 
@@ -1253,6 +1279,274 @@ namespace belfem
                 }
             }
 
+//-----------------------------------------------------------------------------
+
+            void
+            FieldData::synchronize( const Cell< string > & aFieldLabels )
+            {
+                this->start_synchronize( aFieldLabels );
+                this->finish_synchronize() ;
+            }
+
+//-----------------------------------------------------------------------------
+
+            void
+            FieldData::start_synchronize( const Cell< string > & aFieldLabels )
+            {
+                // an exchange that is still running must be completed first
+                this->finish_synchronize() ;
+
+                if( this->use_halo( aFieldLabels ) )
+                {
+                    mHaloNodeFields.clear() ;
+                    mHaloEdgeFields.clear() ;
+
+                    for( uint f=0; f<aFieldLabels.size(); ++f )
+                    {
+                        mesh::Field * tField = mMesh->field( aFieldLabels( f ) );
+
+                        if( tField->entity_type() == EntityType::NODE )
+                        {
+                            mHaloNodeFields.push( & tField->data() );
+                        }
+                        else
+                        {
+                            mHaloEdgeFields.push( & tField->data() );
+                        }
+                    }
+
+                    // the halos are created on all procs, since the
+                    // labels are the same everywhere
+                    if( mHaloNodeFields.size() > 0 )
+                    {
+                        if( mNodeHalo == nullptr )
+                        {
+                            mNodeHalo = this->create_halo( EntityType::NODE );
+                        }
+                        mNodeHalo->start( mHaloNodeFields );
+                    }
+
+                    if( mHaloEdgeFields.size() > 0 )
+                    {
+                        if( mEdgeHalo == nullptr )
+                        {
+                            mEdgeHalo = this->create_halo( EntityType::EDGE );
+                        }
+                        mEdgeHalo->start( mHaloEdgeFields );
+                    }
+                }
+                else
+                {
+                    comm_barrier() ;
+                    this->collect( aFieldLabels );
+                    comm_barrier();
+                    this->distribute( aFieldLabels );
+                }
+            }
+
+//-----------------------------------------------------------------------------
+
+            void
+            FieldData::finish_synchronize()
+            {
+                if( mNodeHalo != nullptr && mNodeHalo->is_active() )
+                {
+                    mNodeHalo->finish( mHaloNodeFields );
+                }
+
+                if( mEdgeHalo != nullptr && mEdgeHalo->is_active() )
+                {
+                    mEdgeHalo->finish( mHaloEdgeFields );
+                }
+            }
+
+//-----------------------------------------------------------------------------
+
+            bool
+            FieldData::halo_is_active() const
+            {
+                return ( mNodeHalo != nullptr && mNodeHalo->is_active() )
+                    || ( mEdgeHalo != nullptr && mEdgeHalo->is_active() );
+            }
+
+//-----------------------------------------------------------------------------
+
+            bool
+            FieldData::is_halo_element( Element * aElement ) const
+            {
+                mesh::Element * tElement = aElement->element() ;
+
+                for( uint k=0; k<tElement->number_of_nodes(); ++k )
+                {
+                    if( tElement->node( k )->owner() != mMyRank )
+                    {
+                        return true ;
+                    }
+                }
+
+                if( mEdgeHalo != nullptr && tElement->has_edges() )
+                {
+                    for( uint k=0; k<tElement->number_of_edges(); ++k )
+                    {
+                        if( tElement->edge( k )->owner() != mMyRank )
+                        {
+                            return true ;
+                        }
+                    }
+                }
+
+                return false ;
+            }
+
+//-----------------------------------------------------------------------------
+
+            bool
+            FieldData::use_halo( const Cell< string > & aFieldLabels )
+            {
+                // the halo needs all procs, and the projection needs the master
+                if( mCommSize < 2 || mCommSize != comm_size()
+                    || mParent->enforce_linear_interpolation() )
+                {
+                    return false ;
+                }
+
+                for( uint f=0; f<aFieldLabels.size(); ++f )
+                {
+                    EntityType tType = mMesh->field( aFieldLabels( f ) )->entity_type() ;
+
+                    if( tType != EntityType::NODE && tType != EntityType::EDGE )
+                    {
+                        return false ;
+                    }
+                }
+
+                return true ;
+            }
+
+//-----------------------------------------------------------------------------
+
+            HaloExchange *
+            FieldData::create_halo( const EntityType aType )
+            {
+                Timer tTimer ;
+
+                proc_t tCommSize = comm_size() ;
+
+                const bool tUseEdges = aType == EntityType::EDGE ;
+
+                // edge fields store several values per edge
+                const index_t tMultiplicity = tUseEdges ?
+                        mParent->iwg()->edge_multiplicity() : 1 ;
+
+                const index_t tNumEntities = tUseEdges ?
+                        mMesh->number_of_edges() : mMesh->number_of_nodes() ;
+
+                auto tEntity = [ & ]( const index_t aIndex ) -> graph::Vertex *
+                {
+                    return tUseEdges ?
+                           static_cast< graph::Vertex * >( mMesh->edges()( aIndex ) ) :
+                           static_cast< graph::Vertex * >( mMesh->nodes()( aIndex ) );
+                };
+
+                auto tEntityIndex = [ & ]( const id_t aID ) -> index_t
+                {
+                    return tUseEdges ? mMesh->edge( aID )->index() : mMesh->node( aID )->index() ;
+                };
+
+                // ids of the entities this proc needs, sorted by owner.
+                // on the master, this contains all entities owned by others
+                Cell< Vector< id_t > > tRequests( tCommSize, Vector< id_t >() );
+                Vector< index_t > tCount( tCommSize, 0 );
+
+                for( index_t k=0; k<tNumEntities; ++k )
+                {
+                    proc_t tOwner = tEntity( k )->owner() ;
+
+                    // entities that are not part of the kernel have no owner
+                    if( tOwner != mMyRank && tOwner < tCommSize )
+                    {
+                        ++tCount( tOwner );
+                    }
+                }
+
+                for( proc_t p=0; p<tCommSize; ++p )
+                {
+                    tRequests( p ).set_size( tCount( p ) );
+                }
+
+                tCount.fill( 0 );
+
+                for( index_t k=0; k<tNumEntities; ++k )
+                {
+                    proc_t tOwner = tEntity( k )->owner() ;
+
+                    if( tOwner != mMyRank && tOwner < tCommSize )
+                    {
+                        tRequests( tOwner )( tCount( tOwner )++ ) = tEntity( k )->id() ;
+                    }
+                }
+
+                // tell the owners what we need, this is only done once
+                Cell< Vector< id_t > > tRequested ;
+                exchange( tRequests, tRequested );
+
+                // count neighbors
+                uint tNumNeighbors = 0 ;
+                for( proc_t p=0; p<tCommSize; ++p )
+                {
+                    if( tRequests( p ).length() > 0 || ( p != mMyRank && tRequested( p ).length() > 0 ) )
+                    {
+                        ++tNumNeighbors ;
+                    }
+                }
+
+                Vector< proc_t > tNeighbors( tNumNeighbors );
+                Cell< Vector< index_t > > tSendIndices( tNumNeighbors, Vector< index_t >() );
+                Cell< Vector< index_t > > tReceiveIndices( tNumNeighbors, Vector< index_t >() );
+
+                // converts entity ids into positions in the field
+                auto tFieldIndices = [ & ]( const Vector< id_t > & aIDs, Vector< index_t > & aIndices )
+                {
+                    aIndices.set_size( aIDs.length() * tMultiplicity );
+
+                    index_t tPosition = 0 ;
+
+                    for( index_t k=0; k<aIDs.length(); ++k )
+                    {
+                        index_t tIndex = tEntityIndex( aIDs( k ) ) * tMultiplicity ;
+
+                        for( index_t i=0; i<tMultiplicity; ++i )
+                        {
+                            aIndices( tPosition++ ) = tIndex + i ;
+                        }
+                    }
+                };
+
+                tNumNeighbors = 0 ;
+                for( proc_t p=0; p<tCommSize; ++p )
+                {
+                    if( tRequests( p ).length() > 0 || ( p != mMyRank && tRequested( p ).length() > 0 ) )
+                    {
+                        tNeighbors( tNumNeighbors ) = p ;
+
+                        // the entities that I own and the neighbor needs
+                        tFieldIndices( tRequested( p ), tSendIndices( tNumNeighbors ) );
+
+                        // the entities that the neighbor owns and I need
+                        tFieldIndices( tRequests( p ), tReceiveIndices( tNumNeighbors ) );
+
+                        ++tNumNeighbors ;
+                    }
+                }
+
+                message( 4, "    ... time for creating %s halo with %u neighbors : %u ms\n",
+                         tUseEdges ? "edge" : "node",
+                         ( unsigned int ) tNumNeighbors,
+                         ( unsigned int ) tTimer.stop() );
+
+                return new HaloExchange( tNeighbors, tSendIndices, tReceiveIndices );
+            }
+
 //-----------------------------------------------------------------------------
 
             const Vector< index_t > &
@@ -15,6 +15,8 @@ namespace belfem
 {
     class Mesh;
 
+    class HaloExchange;
+
     namespace fem
     {
         class Bearing;
@@ -64,6 +66,14 @@ namespace belfem
 
                 Vector< index_t > mMyNonCornerNodeIndices ;
 
+                // exchange of shared nodes and edges between neighbors, created on demand
+                HaloExchange * mNodeHalo = nullptr ;
+                HaloExchange * mEdgeHalo = nullptr ;
+
+                // fields of the running exchange
+                Cell< Vector< real > * > mHaloNodeFields ;
+                Cell< Vector< real > * > mHaloEdgeFields ;
+
 //------------------------------------------------------------------------------
             public:
 //------------------------------------------------------------------------------
@@ -118,6 +128,52 @@ namespace belfem
                 void
                 distribute( const Cell< string > & aFieldLabels );
 
+//------------------------------------------------------------------------------
+
+                /**
+                 * makes the shared entries of the fields consistent on all
+                 * procs. Node and edge fields are exchanged between neighbors,
+                 * everything else goes through the master.
+                 */
+                void
+                synchronize( const Cell< string > & aFieldLabels );
+
+//------------------------------------------------------------------------------
+
+                /**
+                 * same as synchronize, but node and edge fields are only
+                 * sent. The received values are written by finish_synchronize,
+                 * until then, only elements that are not halo elements
+                 * may be computed.
+                 */
+                void
+                start_synchronize( const Cell< string > & aFieldLabels );
+
+//------------------------------------------------------------------------------
+
+                /**
+                 * waits for a running exchange and writes the received values
+                 */
+                void
+                finish_synchronize();
+
+//------------------------------------------------------------------------------
+
+                /**
+                 * tells if an exchange was started but not finished
+                 */
+                bool
+                halo_is_active() const ;
+
+//------------------------------------------------------------------------------
+
+                /**
+                 * tells if the element touches nodes or edges that are
+                 * owned by another proc, and therefore must wait for the halo
+                 */
+                bool
+                is_halo_element( Element * aElement ) const ;
+
 //------------------------------------------------------------------------------
 
                 void
@@ -130,6 +186,23 @@ namespace belfem
 
 //------------------------------------------------------------------------------
             private:
+//------------------------------------------------------------------------------
+
+                /**
+                 * tells if the fields can be synchronized by the halos
+                 */
+                bool
+                use_halo( const Cell< string > & aFieldLabels );
+
+//------------------------------------------------------------------------------
+
+                /**
+                 * each proc asks the owners of its shared nodes or edges
+                 * for their data. must be called by all procs.
+                 */
+                HaloExchange *
+                create_halo( const EntityType aType );
+
 //------------------------------------------------------------------------------
 
                 void
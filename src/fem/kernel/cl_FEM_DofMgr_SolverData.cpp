@@ -16,10 +16,12 @@
 #include "fn_unique.hpp"
 #include "fn_norm.hpp"
 #include "cl_Timer.hpp"
+#include "cl_Profiler.hpp"
 #include "meshtools.hpp"
 #include "fn_max.hpp"
 #include "fn_min.hpp"
 #include "fn_entity_type.hpp"
+#include "fn_hash.hpp"
 
 namespace belfem
 {
@@ -76,6 +78,12 @@ namespace belfem
                     mDirichletMatrix = nullptr ;
                 }
 
+                if( mRowBlockExchange != nullptr )
+                {
+                    delete mRowBlockExchange ;
+                    mRowBlockExchange = nullptr ;
+                }
+
                 mJacobianTable.clear() ;
                 mDirichletTable.clear() ;
             }
@@ -92,16 +100,60 @@ namespace belfem
                 Vector< id_t > tElementWiseData ;
                 this->compute_element_dof_connectivity( tElementWiseData );
 
-                // local dof-to-element adjacency
-                Vector< id_t > tDofWiseData ;
-                this->compute_dof_element_connectivity( tDofWiseData );
-
                 // create dof wise data
                 Vector< id_t > tData ;
 
-                if( mKernel->number_of_procs() > 1 )
+                // check if the rows of the Jacobian can be kept on the procs,
+                // the solvers expect that all procs are used and rank 0 is the master
+                mUseRowBlocks = mDistributedAssembly
+                        && mKernel->number_of_procs() > 1
+                        && mKernel->number_of_procs() == comm_size()
+                        && mKernel->master() == 0 ;
+
+                if( mUseRowBlocks )
+                {
+                    BELFEM_ASSERT( mSolver != nullptr, "no solver created" );
+
+                    if( ! mSolver->wrapper()->supports_distributed_assembly() )
+                    {
+                        if( mParent->is_master() )
+                        {
+                            message( 4, " Warning: %s does not support distributed assembly, gathering Jacobian on master\n",
+                                     mSolver->wrapper()->label().c_str() );
+                        }
+                        mUseRowBlocks = false ;
+                    }
+                }
+
+                // index type of the global Jacobian, the local matrices are always small
+                SpMatrixIndexType tIndexType = SpMatrixIndexType::Int32 ;
+
+                if( mLongIndices && mMyRank == mKernel->master() && ! mUseRowBlocks )
+                {
+                    BELFEM_ASSERT( mSolver != nullptr, "no solver created" );
+
+                    if( mSolver->wrapper()->supports_long_indices() )
+                    {
+                        tIndexType = SpMatrixIndexType::Int64 ;
+                    }
+                    else
+                    {
+                        message( 4, " Warning: %s does not support 64-bit indices, using 32-bit indices\n",
+                                 mSolver->wrapper()->label().c_str() );
+                    }
+                }
+
+                // proc wise connectivities, needed by the master.
+                // In distributed mode, each proc only knows its own elements
+                Cell< Vector< id_t > > tConnectivities ;
+
+                if( mKernel->number_of_procs() > 1 && ! mUseRowBlocks )
                 {
-                    Cell< Vector< id_t > > tConnectivities( mKernel->number_of_procs(),
+                    // local dof-to-element adjacency
+                    Vector< id_t > tDofWiseData ;
+                    this->compute_dof_element_connectivity( tDofWiseData );
+
+                    tConnectivities.set_size( mKernel->number_of_procs(),
                                                             Vector< id_t >());
                     Vector< id_t > & tConnectivity = mMyRank == mKernel->master() ? tConnectivities( 0 ) : tData;
                     this->compute_dof_dof_connectivity( tDofWiseData, tElementWiseData, tConnectivity );
@@ -118,34 +170,126 @@ namespace belfem
                         send( mKernel->master(), tData );
                     }
                 }
-                else
-                {
-                    this->compute_dof_dof_connectivity( tDofWiseData, tElementWiseData, tData );
-                }
 
                 // - - - - - - - - - - - - - - - - - - - - - - - - - - -
                 // write local node indices
                 // - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-                mMyNumberOfFixedDofs = 0 ;
-                mMyNumberOfFreeDofs = 0 ;
+                this->compute_local_indices() ;
 
-                for( Dof * tDof : mDOFs )
+                // - - - - - - - - - - - - - - - - - - - - - - - - - - -
+                // create the graph and initialize the matrices
+                // - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+                SpMatrixType tType = this->matrix_type() ;
+
+                // only the master in parallel mode needs the united pattern
+                // of all procs, all other matrices are built from the local elements
+                bool tUseGraph = mKernel->number_of_procs() > 1
+                        && mMyRank == mKernel->master()
+                        && ! mUseRowBlocks ;
+
+                if( tUseGraph )
                 {
-                    if( tDof->is_fixed() )
+                    Cell< graph::Vertex * > tGraph ;
+                    if( mMyNumberOfFixedDofs > 0 )
                     {
-                        tDof->set_my_index( mMyNumberOfFixedDofs++ );
+                        this->populate_graph( tData, true, tGraph );
+                        mDirichletMatrix = new SpMatrix( tGraph, SpMatrixType::CSR,
+                                                         mNumberOfFreeDofs, mNumberOfFixedDofs );
+
+                        tGraph.clear() ;
                     }
-                    else
+
+                    this->populate_graph( tData, false, tGraph );
+
+                    mJacobian = new SpMatrix( tGraph, tType,
+                                              mNumberOfFreeDofs, mNumberOfFreeDofs,
+                                              tIndexType );
+                }
+
+                if( mJacobian == nullptr )
+                {
+                    // graph free count and fill from the element tables
+                    Vector< index_t > tOffsets ;
+                    Vector< index_t > tFreeIndices ;
+                    Vector< index_t > tFixedIndices ;
+
+                    this->create_pattern_tables( tElementWiseData, tOffsets, tFreeIndices, tFixedIndices );
+
+                    // in row block mode, the local matrices use the local indices,
+                    // which are the global ones on the master
+                    index_t tNumberOfFreeDofs  = mUseRowBlocks ? mMyNumberOfFreeDofs  : mNumberOfFreeDofs ;
+                    index_t tNumberOfFixedDofs = mUseRowBlocks ? mMyNumberOfFixedDofs : mNumberOfFixedDofs ;
+
+                    if( ! tUseGraph && mMyNumberOfFixedDofs > 0 )
                     {
-                        tDof->set_my_index( mMyNumberOfFreeDofs++ );
+                        mDirichletMatrix = new SpMatrix( tOffsets, tFreeIndices, tFixedIndices,
+                                                         SpMatrixType::CSR,
+                                                         tNumberOfFreeDofs, tNumberOfFixedDofs,
+                                                         mParent->number_of_threads() );
                     }
+
+                    mJacobian = new SpMatrix( tOffsets, tFreeIndices, tFreeIndices, tType,
+                                              tNumberOfFreeDofs, tNumberOfFreeDofs,
+                                              mParent->number_of_threads(),
+                                              tIndexType );
+                }
+
+                if( mUseRowBlocks )
+                {
+                    // the solver takes the rows directly from each proc
+                    mSolver->wrapper()->set_row_block( & mRowBlock );
                 }
 
                 // - - - - - - - - - - - - - - - - - - - - - - - - - - -
-                // create the graph and initialize the matrices
+                // allocate RHS
                 // - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
+                this->allocate_rhs() ;
+            }
+
+//------------------------------------------------------------------------------
+
+            void
+            SolverData::compute_local_indices()
+            {
+                mMyNumberOfFixedDofs = 0 ;
+                mMyNumberOfFreeDofs = 0 ;
+
+                if( mMyRank == mKernel->master() )
+                {
+                    // the master has all dofs, so the local indices are
+                    // the global ones, even if the free dofs are numbered by partition
+                    for( Dof * tDof : mDOFs )
+                    {
+                        tDof->set_my_index( tDof->index() );
+
+                        if( tDof->is_fixed() )
+                        {
+                            ++mMyNumberOfFixedDofs ;
+                        }
+                        else
+                        {
+                            ++mMyNumberOfFreeDofs ;
+                        }
+                    }
+                }
+                else
+                {
+                    for( Dof * tDof : mDOFs )
+                    {
+                        if( tDof->is_fixed() )
+                        {
+                            tDof->set_my_index( mMyNumberOfFixedDofs++ );
+                        }
+                        else
+                        {
+                            tDof->set_my_index( mMyNumberOfFreeDofs++ );
+                        }
+                    }
+                }
+
                 // needed to find worst dof
                 if( mParent->is_master() )
                 {
@@ -158,31 +302,13 @@ namespace belfem
                         }
                     }
                 }
+            }
 
-                Cell< graph::Vertex * > tGraph ;
-                if( mMyNumberOfFixedDofs > 0 )
-                {
-                    this->populate_graph( tData, true, tGraph );
-                    mDirichletMatrix = new SpMatrix( tGraph, SpMatrixType::CSR,
-                                                     mNumberOfFreeDofs, mNumberOfFixedDofs );
-
-                    tGraph.clear() ;
-                }
-
-                this->populate_graph( tData, false, tGraph );
-
-                BELFEM_ASSERT( mSolver != nullptr, "no solver created" );
-
-                mJacobian =  new SpMatrix( tGraph,
-                                           ( mSolver->type() == SolverType::PETSC ) ||
-                                                 ( mSolver->type() == SolverType::STRUMPACK ) ?
-                                           SpMatrixType::CSR : SpMatrixType::CSC,
-                                           mNumberOfFreeDofs, mNumberOfFreeDofs );
-
-                // - - - - - - - - - - - - - - - - - - - - - - - - - - -
-                // allocate RHS
-                // - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//------------------------------------------------------------------------------
 
+            void
+            SolverData::allocate_rhs()
+            {
                 // allocate right hand side
                 if( mParent->iwg()->num_rhs_cols() <= 1 )
                 {
@@ -210,6 +336,18 @@ namespace belfem
                 }
             }
 
+//------------------------------------------------------------------------------
+
+            SpMatrixType
+            SolverData::matrix_type() const
+            {
+                BELFEM_ASSERT( mSolver != nullptr, "no solver created" );
+
+                return ( mSolver->type() == SolverType::PETSC ) ||
+                       ( mSolver->type() == SolverType::STRUMPACK ) ?
+                       SpMatrixType::CSR : SpMatrixType::CSC ;
+            }
+
 //------------------------------------------------------------------------------
 
             void
@@ -218,7 +356,13 @@ namespace belfem
                 // get master proc
                 proc_t tMaster = mKernel->master();
 
-                if ( mMyRank == tMaster )
+                // in distributed mode, the master does not collect any matrix
+                if( mUseRowBlocks )
+                {
+                    // compute the tables for the distributed Jacobian
+                    this->create_row_block_tables() ;
+                }
+                else if ( mMyRank == tMaster )
                 {
                     const Vector< proc_t > & tComm = mKernel->comm_table();
 
@@ -227,12 +371,12 @@ namespace belfem
                     Cell< Vector< int > > tDirichletRows;
                     Cell< Vector< int > > tDirichletCols;
 
+                    uint tNumberOfProcs = tComm.length();
+
                     // get data
                     receive( tComm, tJacobianRows );
                     receive( tComm, tJacobianCols );
 
-                    uint tNumberOfProcs = tComm.length();
-
                     // allocate memory
                     mJacobianTable.set_size( tNumberOfProcs, {} );
 
@@ -330,139 +474,505 @@ namespace belfem
                         send( tMaster, mDirichletMatrix->number_of_nonzeros(), mDirichletMatrix->cols() );
                     }
                 }
+
+                // precompute the scatter tables for the assembled elements
+                Cell< Element * > tElements ;
+                this->collect_table_elements( tElements );
+                this->create_element_tables( tElements );
             }
 
 //------------------------------------------------------------------------------
 
             void
-            SolverData::populate_graph( const Vector< id_t > & aData,
-                                        const bool      aFixedFlag,
-                                        Cell< graph::Vertex * > & aGraph )
+            SolverData::create_element_tables( Cell< Element * > & aElements )
             {
-                aGraph.set_size( mMyNumberOfFreeDofs, nullptr );
-
-                index_t tPivot = 0 ;
-
-                // total number of dofs
-                index_t tNumberOfDofs = aData( tPivot++ );
-
-                index_t tNumDofs ;
-
-                Cell< Dof * > tDofs( 1024, nullptr );
-                index_t tCount ;
-
-                // loop over all dofs
-                for( index_t k=0; k<tNumberOfDofs; ++k )
+                for( Element * tElement : aElements )
                 {
-                    // grab dof
-                    Dof * tA = mDofData->dof( aData( tPivot++ ) );
-                    tA->reset_vertex_container() ;
+                    uint tN = tElement->number_of_dofs() ;
 
-                    tNumDofs = aData( tPivot++ );
+                    Vector< index_t > & tJacobianTable  = tElement->jacobian_table() ;
+                    Vector< index_t > & tDirichletTable = tElement->dirichlet_table() ;
 
-                    BELFEM_ASSERT( tNumDofs < 1024, "Too many dofs" );
+                    // check if this element has any fixed dofs
+                    bool tHasFixedDofs = false ;
+                    for( uint k=0; k<tN; ++k )
+                    {
+                        if( tElement->dof( k )->is_fixed() )
+                        {
+                            tHasFixedDofs = true ;
+                            break ;
+                        }
+                    }
 
-                    // check if dof is fidex
-                    if( tA->is_fixed() )
+                    tJacobianTable.set_size( tN * tN, gNoIndex );
+
+                    if( tHasFixedDofs && mDirichletMatrix != nullptr )
                     {
-                        tPivot += tNumDofs ;
+                        tDirichletTable.set_size( tN * tN, gNoIndex );
                     }
                     else
                     {
+                        tDirichletTable.set_size( 0 );
+                    }
 
-                        tCount = 0 ;
+                    // the tables are stored column wise
+                    index_t tCount = 0 ;
+                    for( uint j=0; j<tN; ++j )
+                    {
+                        Dof * tCol = tElement->dof( j );
 
-                        for( index_t i=0; i<tNumDofs; ++i )
+                        for( uint i=0; i<tN; ++i )
                         {
-                            // get other dof
-                            Dof * tB = mDofData->dof( aData( tPivot++ ) );
+                            Dof * tRow = tElement->dof( i );
 
-                            // check flag
-                            if( tB->is_fixed() == aFixedFlag )
+                            if( ! tRow->is_fixed() )
                             {
-                                tDofs( tCount++ ) = tB ;
+                                if( tCol->is_fixed() )
+                                {
+                                    index_t tIndex = mDirichletMatrix->index( this->matrix_index( tRow ),
+                                                                              this->matrix_index( tCol ) );
+
+                                    BELFEM_ERROR( tIndex < mDirichletMatrix->number_of_nonzeros(),
+                                                  "entry ( %lu, %lu ) of element %lu is not in the pattern of the Dirichlet matrix",
+                                                  ( long unsigned int ) this->matrix_index( tRow ),
+                                                  ( long unsigned int ) this->matrix_index( tCol ),
+                                                  ( long unsigned int ) tElement->id() );
+
+                                    tDirichletTable( tCount ) = tIndex ;
+                                }
+                                else
+                                {
+                                    index_t tIndex = mJacobian->index( this->matrix_index( tRow ),
+                                                                       this->matrix_index( tCol ) );
+
+                                    BELFEM_ERROR( tIndex < mJacobian->number_of_nonzeros(),
+                                                  "entry ( %lu, %lu ) of element %lu is not in the pattern of the Jacobian",
+                                                  ( long unsigned int ) this->matrix_index( tRow ),
+                                                  ( long unsigned int ) this->matrix_index( tCol ),
+                                                  ( long unsigned int ) tElement->id() );
+
+                                    tJacobianTable( tCount ) = tIndex ;
+                                }
                             }
+                            ++tCount ;
                         }
+                    }
+                }
+            }
 
-                        // allocate memory
-                        tA->init_vertex_container( tCount );
+//------------------------------------------------------------------------------
 
-                        for( index_t i=0; i<tCount; ++i )
-                        {
-                            tA->insert_vertex( tDofs( i )  );
-                        }
+            void
+            SolverData::create_row_block_tables()
+            {
+                proc_t tNumberOfProcs = mKernel->number_of_procs() ;
 
-                        aGraph( tA->my_index() ) = tA ;
+                // make sure that the local matrix has coordinate indices
+                mJacobian->create_coo_indices() ;
+
+                index_t tMyNNZ = mJacobian->number_of_nonzeros() ;
+                const int * tMyRows = mJacobian->rows() ;
+                const int * tMyCols = mJacobian->cols() ;
+
+                // - - - - - - - - - - - - - - - - - - - - - - - - - - -
+                // the free dofs are numbered by partition,
+                // so each proc owns a contiguous range of rows
+                // - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+                const Vector< index_t > & tFreeDofs = mDofData->free_dof_distribution() ;
+
+                BELFEM_ERROR( tFreeDofs.length() == ( index_t ) tNumberOfProcs + 1,
+                              "The free dofs must be numbered by partition for a distributed Jacobian" );
+
+                Vector< int > & tDistribution = mRowBlock.mDistribution ;
+                tDistribution.set_size( tNumberOfProcs + 1 );
+                for( proc_t p=0; p<=tNumberOfProcs; ++p )
+                {
+                    tDistribution( p ) = tFreeDofs( p );
+                }
+
+                int tFirstRow = tDistribution( mMyRank );
+                int tLastRow  = tDistribution( mMyRank + 1 );
+
+                // global index of each local free dof
+                Vector< int > tGlobal( mMyNumberOfFreeDofs );
+                for( Dof * tDof : mDOFs )
+                {
+                    if( ! tDof->is_fixed() )
+                    {
+                        tGlobal( tDof->my_index() ) = tDof->index() ;
                     }
                 }
 
+                // - - - - - - - - - - - - - - - - - - - - - - - - - - -
+                // sort the local nonzeros by the owners of their rows
+                // - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
+                Vector< proc_t > tOwners( tMyNNZ );
+                Vector< index_t > tCount( tNumberOfProcs, 0 );
 
-#if !defined( NDEBUG ) || defined( DEBUG )
-                // check that graph is ok
-                for( index_t k=0; k<aGraph.size(); ++k )
+                for( index_t k=0; k<tMyNNZ; ++k )
                 {
-                    BELFEM_ERROR( aGraph( k ) != nullptr, "entry %lu in graph is empty",
-                                 ( long unsigned int ) k );
+                    int tRow = tGlobal( tMyRows[ k ] );
+
+                    tOwners( k ) = std::upper_bound( tDistribution.data(),
+                                                     tDistribution.data() + tNumberOfProcs + 1,
+                                                     tRow ) - tDistribution.data() - 1 ;
+
+                    ++tCount( tOwners( k ) );
                 }
-#endif
 
-            }
+                // local nonzeros for each target, and their global coordinates
+                Cell< Vector< index_t > > tSendEntries( tNumberOfProcs, Vector< index_t >() );
+                Cell< Vector< int > > tSendCoords( tNumberOfProcs, Vector< int >() );
 
-//------------------------------------------------------------------------------
+                for( proc_t q=0; q<tNumberOfProcs; ++q )
+                {
+                    tSendEntries( q ).set_size( tCount( q ) );
+                    tSendCoords( q ).set_size( 2 * tCount( q ) );
+                }
 
-            void
-            SolverData::collect_fields( Cell< mesh::Field * > & aFields )
-            {
-                // get IWG
-                IWG * tIWG = mParent->iwg() ;
-                BELFEM_ERROR( tIWG != nullptr, "no equation was set" );
+                tCount.fill( 0 );
 
-                // grab field data
-                const Cell< string > & tFieldLabels = tIWG->all_fields() ;
+                for( index_t k=0; k<tMyNNZ; ++k )
+                {
+                    proc_t q = tOwners( k );
+                    index_t tIndex = tCount( q )++ ;
 
-                // how many fields exist on the mesh
-                uint tNumFields = tFieldLabels.size() ;
+                    tSendEntries( q )( tIndex ) = k ;
+                    tSendCoords( q )( 2 * tIndex )     = tGlobal( tMyRows[ k ] );
+                    tSendCoords( q )( 2 * tIndex + 1 ) = tGlobal( tMyCols[ k ] );
+                }
 
-                // count fields ( need to account for multiplicities )
-                uint tCount = 0 ;
-                for ( uint f = 0; f < tNumFields; ++f )
+                // the coordinates of my own entries are kept
+                mOwnEntries = tSendEntries( mMyRank );
+
+                // only the neighbors send something
+                Cell< Vector< int > > tReceivedCoords ;
+                exchange( tSendCoords, tReceivedCoords );
+
+                // - - - - - - - - - - - - - - - - - - - - - - - - - - -
+                // create the pattern of my rows
+                // - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+                index_t tMyNumberOfRows = tLastRow - tFirstRow ;
+
+                // columns of each row
+                Cell< Vector< int > > tRowColumns( tMyNumberOfRows, Vector< int >() );
+                Vector< index_t > tRowLength( tMyNumberOfRows, 0 );
+
+                for( proc_t p=0; p<tNumberOfProcs; ++p )
                 {
-                    switch ( mParent->mesh()->field( tFieldLabels( f ))->entity_type())
+                    const Vector< int > & tCoords = tReceivedCoords( p );
+                    for( index_t k=0; k<tCoords.length(); k+=2 )
                     {
-                        case ( EntityType::EDGE ) :
-                        {
-                            tCount += tIWG->edge_multiplicity();
-                            break;
-                        }
-                        case ( EntityType::FACE ) :
-                        {
-                            tCount += tIWG->face_multiplicity();
-                            break;
-                        }
-                        case ( EntityType::FACET ) :
-                        {
-                            tCount += tIWG->lambda_multiplicity();
-                            break;
-                        }
-                        default :
-                        {
-                            tCount += 1;
-                            break;
-                        }
+                        ++tRowLength( tCoords( k ) - tFirstRow );
                     }
                 }
 
-                // allocate container
-                aFields.set_size( tCount, nullptr );
+                for( index_t r=0; r<tMyNumberOfRows; ++r )
+                {
+                    tRowColumns( r ).set_size( tRowLength( r ) );
+                }
 
-                // reset counter
-                tCount = 0 ;
+                tRowLength.fill( 0 );
 
-                for ( uint f = 0; f < tNumFields; ++f )
+                for( proc_t p=0; p<tNumberOfProcs; ++p )
                 {
-                    // grab field
-                    mesh::Field * tField = mParent->mesh()->field( tFieldLabels( f ));
+                    const Vector< int > & tCoords = tReceivedCoords( p );
+                    for( index_t k=0; k<tCoords.length(); k+=2 )
+                    {
+                        index_t r = tCoords( k ) - tFirstRow ;
+                        tRowColumns( r )( tRowLength( r )++ ) = tCoords( k + 1 );
+                    }
+                }
+
+                Vector< int > & tPointers = mRowBlock.mPointers ;
+                tPointers.set_size( tMyNumberOfRows + 1 );
+                tPointers( 0 ) = 0 ;
+
+                for( index_t r=0; r<tMyNumberOfRows; ++r )
+                {
+                    unique( tRowColumns( r ) );
+                    tPointers( r + 1 ) = tPointers( r ) + tRowColumns( r ).length() ;
+                }
+
+                Vector< int > & tColumns = mRowBlock.mColumns ;
+                tColumns.set_size( tPointers( tMyNumberOfRows ) );
+
+                for( index_t r=0; r<tMyNumberOfRows; ++r )
+                {
+                    std::copy( tRowColumns( r ).data(),
+                               tRowColumns( r ).data() + tRowColumns( r ).length(),
+                               tColumns.data() + tPointers( r ) );
+                }
+
+                tRowColumns.clear() ;
+
+                // - - - - - - - - - - - - - - - - - - - - - - - - - - -
+                // positions of the entries in the row block
+                // - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+                // the columns in each row are sorted
+                auto tPosition = [ & ]( const int aRow, const int aCol ) -> index_t
+                {
+                    const int * tBegin = tColumns.data() + tPointers( aRow - tFirstRow );
+                    const int * tEnd   = tColumns.data() + tPointers( aRow - tFirstRow + 1 );
+
+                    return std::lower_bound( tBegin, tEnd, aCol ) - tColumns.data() ;
+                };
+
+                mOwnPositions.set_size( mOwnEntries.length() );
+                for( index_t k=0; k<mOwnEntries.length(); ++k )
+                {
+                    mOwnPositions( k ) = tPosition( tGlobal( tMyRows[ mOwnEntries( k ) ] ),
+                                                    tGlobal( tMyCols[ mOwnEntries( k ) ] ) );
+                }
+
+                // the neighbors, and the slots for the values they send
+                Vector< proc_t > tNeighbors( tNumberOfProcs );
+                Cell< Vector< index_t > > tSendIndices ;
+                Cell< Vector< index_t > > tReceiveIndices ;
+
+                index_t tNumberOfNeighbors = 0 ;
+                index_t tNumberOfReceived = 0 ;
+
+                for( proc_t p=0; p<tNumberOfProcs; ++p )
+                {
+                    if( p != mMyRank
+                        && ( tSendEntries( p ).length() > 0 || tReceivedCoords( p ).length() > 0 ) )
+                    {
+                        tNeighbors( tNumberOfNeighbors++ ) = p ;
+                        tSendIndices.push( tSendEntries( p ) );
+
+                        index_t tN = tReceivedCoords( p ).length() / 2 ;
+                        Vector< index_t > tSlots( tN );
+                        for( index_t k=0; k<tN; ++k )
+                        {
+                            tSlots( k ) = tNumberOfReceived++ ;
+                        }
+                        tReceiveIndices.push( tSlots );
+                    }
+                }
+                tNeighbors.set_size( tNumberOfNeighbors );
+
+                mReceivePositions.set_size( tNumberOfReceived );
+                tNumberOfReceived = 0 ;
+
+                for( proc_t p=0; p<tNumberOfProcs; ++p )
+                {
+                    if( p != mMyRank )
+                    {
+                        const Vector< int > & tCoords = tReceivedCoords( p );
+                        for( index_t k=0; k<tCoords.length(); k+=2 )
+                        {
+                            mReceivePositions( tNumberOfReceived++ ) = tPosition( tCoords( k ), tCoords( k + 1 ) );
+                        }
+                    }
+                }
+
+                mRowBlockExchange = new HaloExchange( tNeighbors, tSendIndices, tReceiveIndices );
+
+                mLocalValues.set_size( tMyNNZ );
+                mReceivedValues.set_size( tNumberOfReceived );
+
+                // - - - - - - - - - - - - - - - - - - - - - - - - - - -
+                // initialize the row block
+                // - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+                mRowBlock.mNumberOfRows   = mNumberOfFreeDofs ;
+                mRowBlock.mRowOffset      = tFirstRow ;
+                mRowBlock.mMyNumberOfRows = tMyNumberOfRows ;
+                mRowBlock.mValues.set_size( tColumns.length(), 0.0 );
+            }
+
+//------------------------------------------------------------------------------
+
+            void
+            SolverData::populate_graph( const Vector< id_t > & aData,
+                                        const bool      aFixedFlag,
+                                        Cell< graph::Vertex * > & aGraph )
+            {
+                aGraph.set_size( mMyNumberOfFreeDofs, nullptr );
+
+                index_t tPivot = 0 ;
+
+                // total number of dofs
+                index_t tNumberOfDofs = aData( tPivot++ );
+
+                index_t tNumDofs ;
+
+                Cell< Dof * > tDofs( 1024, nullptr );
+                index_t tCount ;
+
+                // loop over all dofs
+                for( index_t k=0; k<tNumberOfDofs; ++k )
+                {
+                    // grab dof
+                    Dof * tA = mDofData->dof( aData( tPivot++ ) );
+                    tA->reset_vertex_container() ;
+
+                    tNumDofs = aData( tPivot++ );
+
+                    BELFEM_ASSERT( tNumDofs < 1024, "Too many dofs" );
+
+                    // check if dof is fidex
+                    if( tA->is_fixed() )
+                    {
+                        tPivot += tNumDofs ;
+                    }
+                    else
+                    {
+
+                        tCount = 0 ;
+
+                        for( index_t i=0; i<tNumDofs; ++i )
+                        {
+                            // get other dof
+                            Dof * tB = mDofData->dof( aData( tPivot++ ) );
+
+                            // check flag
+                            if( tB->is_fixed() == aFixedFlag )
+                            {
+                                tDofs( tCount++ ) = tB ;
+                            }
+                        }
+
+                        // allocate memory
+                        tA->init_vertex_container( tCount );
+
+                        for( index_t i=0; i<tCount; ++i )
+                        {
+                            tA->insert_vertex( tDofs( i )  );
+                        }
+
+                        aGraph( tA->my_index() ) = tA ;
+                    }
+                }
+
+
+
+#if !defined( NDEBUG ) || defined( DEBUG )
+                // check that graph is ok
+                for( index_t k=0; k<aGraph.size(); ++k )
+                {
+                    BELFEM_ERROR( aGraph( k ) != nullptr, "entry %lu in graph is empty",
+                                 ( long unsigned int ) k );
+                }
+#endif
+
+            }
+
+//------------------------------------------------------------------------------
+
+            void
+            SolverData::create_pattern_tables( const Vector< id_t > & aElementWiseData,
+                                               Vector< index_t > & aOffsets,
+                                               Vector< index_t > & aFreeIndices,
+                                               Vector< index_t > & aFixedIndices )
+            {
+                index_t tPivot = 0 ;
+
+                // number of elements
+                index_t tNumElems = aElementWiseData( tPivot++ );
+
+                // each element has an ID and a dof counter
+                index_t tNumEntries = aElementWiseData.length() - 1 - 2 * tNumElems ;
+
+                aOffsets.set_size( tNumElems + 1 );
+                aFreeIndices.set_size( tNumEntries );
+                aFixedIndices.set_size( tNumEntries );
+
+                index_t tCount = 0 ;
+
+                for( index_t e=0; e<tNumElems; ++e )
+                {
+                    aOffsets( e ) = tCount ;
+
+                    // skip element ID
+                    ++tPivot ;
+
+                    index_t tNumDofs = aElementWiseData( tPivot++ );
+
+                    for( index_t i=0; i<tNumDofs; ++i )
+                    {
+                        // the element wise data contain the position in the dof container
+                        Dof * tDof = mDOFs( aElementWiseData( tPivot++ ) );
+
+                        if( tDof->is_fixed() )
+                        {
+                            aFreeIndices( tCount ) = gNoIndex ;
+                            aFixedIndices( tCount ) = this->matrix_index( tDof ) ;
+                        }
+                        else
+                        {
+                            aFreeIndices( tCount ) = this->matrix_index( tDof ) ;
+                            aFixedIndices( tCount ) = gNoIndex ;
+                        }
+                        ++tCount ;
+                    }
+                }
+
+                aOffsets( tNumElems ) = tCount ;
+
+                BELFEM_ASSERT( tCount == tNumEntries && tPivot == aElementWiseData.length(),
+                               "memory error" );
+            }
+
+//------------------------------------------------------------------------------
+
+            void
+            SolverData::collect_fields( Cell< mesh::Field * > & aFields )
+            {
+                // get IWG
+                IWG * tIWG = mParent->iwg() ;
+                BELFEM_ERROR( tIWG != nullptr, "no equation was set" );
+
+                // grab field data
+                const Cell< string > & tFieldLabels = tIWG->all_fields() ;
+
+                // how many fields exist on the mesh
+                uint tNumFields = tFieldLabels.size() ;
+
+                // count fields ( need to account for multiplicities )
+                uint tCount = 0 ;
+                for ( uint f = 0; f < tNumFields; ++f )
+                {
+                    switch ( mParent->mesh()->field( tFieldLabels( f ))->entity_type())
+                    {
+                        case ( EntityType::EDGE ) :
+                        {
+                            tCount += tIWG->edge_multiplicity();
+                            break;
+                        }
+                        case ( EntityType::FACE ) :
+                        {
+                            tCount += tIWG->face_multiplicity();
+                            break;
+                        }
+                        case ( EntityType::FACET ) :
+                        {
+                            tCount += tIWG->lambda_multiplicity();
+                            break;
+                        }
+                        default :
+                        {
+                            tCount += 1;
+                            break;
+                        }
+                    }
+                }
+
+                // allocate container
+                aFields.set_size( tCount, nullptr );
+
+                // reset counter
+                tCount = 0 ;
+
+                for ( uint f = 0; f < tNumFields; ++f )
+                {
+                    // grab field
+                    mesh::Field * tField = mParent->mesh()->field( tFieldLabels( f ));
 
                     uint tMultiplicity;
 
@@ -1040,12 +1550,25 @@ namespace belfem
                     Element * aElement,
                     const Matrix< real > & aJacobian )
             {
-                SpMatrix & J       =  *mJacobian;
-                SpMatrix & D       =  *mDirichletMatrix;
-
                 // get dimension of element Jacobian
                 uint tN = aElement->number_of_dofs() ;
 
+                // use the precomputed tables if they exist
+                if( aElement->jacobian_table().length() == tN * tN
+                    && aJacobian.n_rows() == tN && aJacobian.n_cols() == tN )
+                {
+                    mJacobian->scatter_add( aElement->jacobian_table(), aJacobian );
+
+                    if( aElement->dirichlet_table().length() > 0 )
+                    {
+                        mDirichletMatrix->scatter_add( aElement->dirichlet_table(), aJacobian, -1.0 );
+                    }
+                    return;
+                }
+
+                SpMatrix & J       =  *mJacobian;
+                SpMatrix & D       =  *mDirichletMatrix;
+
                 // add element jacobian to system matrices
                 for ( uint i = 0; i < tN; ++i )
                 {
@@ -1058,11 +1581,11 @@ namespace belfem
 
                             if ( tCol->is_fixed() )
                             {
-                                D( tRow->index(), tCol->index() ) -= aJacobian( i, j );
+                                D( this->matrix_index( tRow ), this->matrix_index( tCol ) ) -= aJacobian( i, j );
                             }
                             else
                             {
-                                J( tRow->index(), tCol->index() ) += aJacobian( i, j );
+                                J( this->matrix_index( tRow ), this->matrix_index( tCol ) ) += aJacobian( i, j );
                             }
                         }
                     }
@@ -1076,36 +1599,12 @@ namespace belfem
                                                    const Matrix< real > & aJacobian,
                                                    const Vector< real > & aResidual )
             {
-                SpMatrix & J       =  *mJacobian;
-                SpMatrix & D       =  *mDirichletMatrix;
+                // add element jacobian to system matrices
+                this->assemble_jacobian( aElement, aJacobian );
 
                 // get dimension of element Jacobian
                 uint tN = aElement->number_of_dofs() ;
 
-                // add element jacobian to system matrices
-                for ( uint i = 0; i < tN; ++i )
-                {
-                    Dof * tRow = aElement->dof( i );
-                    if ( !tRow->is_fixed() )
-                    {
-                        for ( uint j = 0; j < tN; ++j )
-                        {
-                            Dof * tCol = aElement->dof( j );
-
-                            if ( !tCol->is_fixed() )
-                            {
-                                J( tRow->index(), tCol->index() ) += aJacobian( i, j );
-                            }
-                            else
-                            {
-                                D( tRow->index(), tCol->index() ) -= aJacobian( i, j );
-                            }
-                        }
-                    }
-                }
-
-
-
                 // add residual to vector
                 for ( uint i = 0; i < tN; ++i )
                 {
@@ -1209,6 +1708,16 @@ namespace belfem
             void
             SolverData::collect_jacobian()
             {
+                ProfilerRegion tRegion( "collect_jacobian" );
+
+                // in distributed mode, each proc collects the rows it owns,
+                // and the Dirichlet matrices stay local
+                if( mUseRowBlocks )
+                {
+                    this->collect_row_blocks() ;
+                    return ;
+                }
+
                 if ( mMyRank == mKernel->master() )
                 {
 
@@ -1296,7 +1805,7 @@ namespace belfem
                     // send my data to master
                     send( mKernel->master(),
                           mJacobian->number_of_nonzeros(),
-                          mJacobian->data());
+                          mJacobian->data() );
 
                     if ( mMyNumberOfFixedDofs > 0 )
                     {
@@ -1311,12 +1820,87 @@ namespace belfem
 //------------------------------------------------------------------------------
 
             void
-            SolverData::collect_rhs_vector()
+            SolverData::collect_row_blocks()
             {
-                this->collect_vector( mRhsVector );
-            }
+                // send the values to the procs that own the rows
+                index_t tMyNNZ = mJacobian->number_of_nonzeros() ;
+                for( index_t k=0; k<tMyNNZ; ++k )
+                {
+                    mLocalValues( k ) = mJacobian->data( k );
+                }
 
-//------------------------------------------------------------------------------
+                mRowBlockExchange->start( { &mLocalValues } );
+
+                // add my own values while the messages are on their way
+                mRowBlock.mValues.fill( 0.0 );
+
+                index_t tN = mOwnEntries.length() ;
+                for( index_t k=0; k<tN; ++k )
+                {
+                    mRowBlock.mValues( mOwnPositions( k ) ) += mLocalValues( mOwnEntries( k ) );
+                }
+
+                Cell< Vector< real > * > tReceived = { &mReceivedValues };
+                mRowBlockExchange->finish( tReceived );
+
+                // add the values of the neighbors
+                tN = mReceivePositions.length() ;
+                for( index_t k=0; k<tN; ++k )
+                {
+                    mRowBlock.mValues( mReceivePositions( k ) ) += mReceivedValues( k );
+                }
+            }
+
+//------------------------------------------------------------------------------
+
+            void
+            SolverData::add_dirichlet_loads()
+            {
+                // the global number of fixed dofs is known on all procs
+                if( mNumberOfFixedDofs == 0 )
+                {
+                    return ;
+                }
+
+                // the fixed values of this proc
+                Vector< real > tFixed( mMyNumberOfFixedDofs, 0.0 );
+
+                for( Dof * tDof : mDOFs )
+                {
+                    if( tDof->is_fixed() )
+                    {
+                        tFixed( tDof->my_index() ) = tDof->value() ;
+                    }
+                }
+
+                // the loads of the local elements
+                Vector< real > tLoads( mMyNumberOfFreeDofs, 0.0 );
+
+                if( mDirichletMatrix != nullptr )
+                {
+                    mDirichletMatrix->multiply( tFixed, tLoads );
+                }
+
+                // sum up the loads on the master
+                this->collect_vector( tLoads );
+
+                if( mMyRank == mKernel->master() )
+                {
+                    mRhsVector += tLoads ;
+                }
+            }
+
+//------------------------------------------------------------------------------
+
+            void
+            SolverData::collect_rhs_vector()
+            {
+                ProfilerRegion tRegion( "collect_rhs" );
+
+                this->collect_vector( mRhsVector );
+            }
+
+//------------------------------------------------------------------------------
 
             void
             SolverData::collect_vector( Vector< real > & aVector )
@@ -1419,12 +2003,18 @@ namespace belfem
             void
             SolverData::update_field_values()
             {
-                if ( mMyRank == mKernel->master() )
+                // in distributed mode, each proc needs the values
+                // of its own dofs to compute the residual
+                if ( mMyRank == mKernel->master() || mUseRowBlocks )
                 {
+                    // the local matrices use the local indices,
+                    // which are the global ones on the master
+                    index_t tNumberOfFreeDofs = mUseRowBlocks ? mMyNumberOfFreeDofs : mNumberOfFreeDofs ;
+
                     // allocate vector
-                    if ( mFieldValues.length() != mNumberOfFreeDofs )
+                    if ( mFieldValues.length() != tNumberOfFreeDofs )
                     {
-                        mFieldValues.set_size( mNumberOfFreeDofs, 0.0 );
+                        mFieldValues.set_size( tNumberOfFreeDofs, 0.0 );
                     }
 
                     // collect values for free dofs
@@ -1432,7 +2022,7 @@ namespace belfem
                     {
                         if ( !tDof->is_fixed() )
                         {
-                            mFieldValues( tDof->index() ) = tDof->value();
+                            mFieldValues( this->matrix_index( tDof ) ) = tDof->value();
                         }
                     }
                 }
@@ -1460,6 +2050,8 @@ namespace belfem
             void
             SolverData::solve()
             {
+                ProfilerRegion tRegion( "linear_solve" );
+
                 // get pointer to the equation
                 IWG * tIWG = mParent->iwg() ;
                 BELFEM_ERROR( tIWG != nullptr, "no equation was set" );
@@ -1468,6 +2060,12 @@ namespace belfem
 
                 this->collect_fields( tFields );
 
+                // in distributed mode, each proc multiplies its own Dirichlet matrix
+                if( mUseRowBlocks )
+                {
+                    this->add_dirichlet_loads() ;
+                }
+
                 if ( mKernel->is_master() )
                 {
 
@@ -1499,7 +2097,7 @@ namespace belfem
                         mRhsVector += mVolumeLoads ;
                     }
 
-                    if ( mNumberOfFixedDofs != 0 )
+                    if ( mNumberOfFixedDofs != 0 && ! mUseRowBlocks )
                     {
                         BELFEM_ASSERT( tIWG->num_rhs_cols() == 1,
                                       "Can only impose values of RHS is a vector, not a matrix!");
@@ -1516,26 +2114,13 @@ namespace belfem
                         {
                             case( IwgMode::Direct ) :
                             {
-                                // wait for other procs
-                                comm_barrier() ;
-
                                 // solve the system
                                 mSolver->solve( *mJacobian, mLhsVector, mRhsVector ) ;
 
                                 // write values into field
-                                for ( Dof * tDof: mDOFs )
+                                if( ! mUseRowBlocks )
                                 {
-                                    if ( tDof->is_fixed() )
-                                    {
-                                        tFields( tDof->type_id() )->value(
-                                                tDof->dof_index_on_field() ) = tDof->value();
-                                    }
-                                    else
-                                    {
-                                        tFields( tDof->type_id() )->value(
-                                                tDof->dof_index_on_field() )
-                                                = mLhsVector( tDof->index() );
-                                    }
+                                    this->update_dofs( mLhsVector, tFields );
                                 }
 
                                 break ;
@@ -1555,57 +2140,30 @@ namespace belfem
                                     case( SolverAlgorithm::NewtonRaphson ) :
                                     {
                                         // compute the residual as r = A * x - b and write it into RHS vector
-                                        mJacobian->multiply( mFieldValues, mRhsVector, 1.0, -1.0 );
-
-                                        // wait for other procs
-                                        comm_barrier() ;
+                                        this->compute_residual_vector() ;
 
                                         // solve the system
                                         mSolver->solve( *mJacobian, mLhsVector, mRhsVector ) ;
 
-                                        for ( Dof * tDof: mDOFs )
+                                        if( ! mUseRowBlocks )
                                         {
-                                            // update DOF values
-                                            if ( !tDof->is_fixed() )
-                                            {
-                                                tDof->value() -= tIWG->omega() * mLhsVector( tDof->index() );
-                                            }
-
-                                            // update value in field
-                                            tFields( tDof->type_id() )->value(
-                                                    tDof->dof_index_on_field() ) = tDof->value();
+                                            this->update_dofs( mLhsVector, tFields );
                                         }
 
                                         break ;
                                     }
                                     case( SolverAlgorithm::Picard ) :
                                     {
-                                        // wait for other procs
-                                        comm_barrier() ;
-
                                         // solve the system
                                         mSolver->solve( *mJacobian, mLhsVector, mRhsVector ) ;
 
-
-                                        real tA = 1. - tIWG->omega() ;
-                                        real tB = tIWG->omega() ;
-
-                                        for ( Dof * tDof: mDOFs )
+                                        if( ! mUseRowBlocks )
                                         {
-                                            // update DOF values
-                                            if ( !tDof->is_fixed() )
-                                            {
-                                                tDof->value() *= tA ;
-                                                tDof->value() += tB * mLhsVector( tDof->index() );
-                                            }
-
-                                            // update value in field
-                                            tFields( tDof->type_id() )->value(
-                                                    tDof->dof_index_on_field() ) = tDof->value() ;
+                                            this->update_dofs( mLhsVector, tFields );
                                         }
 
                                         // compute the residual as r = A * x - b and write it into RHS vector
-                                        mJacobian->multiply( mFieldValues, mRhsVector, 1.0, -1.0 );
+                                        this->compute_residual_vector() ;
 
 
                                         break ;
@@ -1643,8 +2201,6 @@ namespace belfem
                                          "Edge DOFs not supported if using an RHS matrix" );
                         }
                         // note: this only works for node fields
-                        // wait for other procs
-                        comm_barrier() ;
                         mSolver->solve( *mJacobian, mLhsMatrix, mRhsMatrix );
 
                         uint k = 0;
@@ -1685,21 +2241,199 @@ namespace belfem
                 {
                     if ( tIWG->num_rhs_cols() == 1 )
                     {
-                        // wait for other procs
-                        comm_barrier() ;
+                        // in distributed mode, the residual needs the local matrices
+                        bool tComputeResidual = mUseRowBlocks && tIWG->mode() == IwgMode::Iterative ;
+
+                        if( tComputeResidual && tIWG->algorithm() == SolverAlgorithm::NewtonRaphson )
+                        {
+                            this->compute_residual_vector() ;
+                        }
+
                         mSolver->solve( *mJacobian, mLhsVector, mRhsVector ) ;
+
+                        if( tComputeResidual && tIWG->algorithm() == SolverAlgorithm::Picard )
+                        {
+                            this->compute_residual_vector() ;
+                        }
                     }
                     else
                     {
-                        // wait for other procs
-                        comm_barrier() ;
                         mSolver->solve( *mJacobian, mLhsMatrix, mRhsMatrix ) ;
                     }
                 }
+                // other procs with a serial solver don't need to wait here,
+                // they will block when the solution is distributed
+
+                // in distributed mode, each proc updates its own dofs
+                if( this->updates_local_dofs() )
+                {
+                    if( mKernel->is_master() )
+                    {
+                        this->scatter_solution( mLhsVector );
+                        this->update_dofs( mLhsVector, tFields );
+                    }
+                    else
+                    {
+                        Vector< real > tMyLhs ;
+                        this->scatter_solution( tMyLhs );
+                        this->update_dofs( tMyLhs, tFields );
+                    }
+                }
+            }
+
+//------------------------------------------------------------------------------
+
+            bool
+            SolverData::updates_local_dofs() const
+            {
+                return mUseRowBlocks && mParent->iwg()->num_rhs_cols() == 1 ;
+            }
+
+//------------------------------------------------------------------------------
+
+            void
+            SolverData::scatter_solution( Vector< real > & aLhs )
+            {
+                if ( mMyRank == mKernel->master() )
+                {
+                    const Vector< proc_t > & tComm = mKernel->comm_table() ;
+
+                    Cell< Vector< real > > tAllVectors( tComm.length(), {} );
+
+                    // the same order as in collect_vector
+                    for ( uint p = 1; p < tComm.length(); ++p )
+                    {
+                        // get dof table for this proc
+                        const Vector< index_t > & tDOFs = mDofData->dof_indices( p );
+
+                        index_t tNumDOFs = tDOFs.length();
+
+                        index_t tCount = 0 ;
+                        for ( index_t i = 0; i < tNumDOFs; ++i )
+                        {
+                            if ( ! mDOFs( tDOFs( i ) )->is_fixed() )
+                            {
+                                ++tCount ;
+                            }
+                        }
+
+                        Vector< real > & tVector = tAllVectors( p );
+                        tVector.set_size( tCount );
+
+                        tCount = 0 ;
+                        for ( index_t i = 0; i < tNumDOFs; ++i )
+                        {
+                            Dof * tDOF = mDOFs( tDOFs( i ) );
+
+                            if ( ! tDOF->is_fixed() )
+                            {
+                                tVector( tCount++ ) = aLhs( tDOF->index() );
+                            }
+                        }
+                    }
+
+                    send( tComm, tAllVectors );
+                }
                 else
                 {
-                    // wait for other procs
-                    comm_barrier() ;
+                    receive( mKernel->master(), aLhs );
+
+                    BELFEM_ASSERT( aLhs.length() == mMyNumberOfFreeDofs,
+                                  "Length of received solution does not match ( %lu vs. %lu )",
+                                  ( long unsigned int ) aLhs.length(),
+                                  ( long unsigned int ) mMyNumberOfFreeDofs );
+                }
+            }
+
+//------------------------------------------------------------------------------
+
+            void
+            SolverData::update_dofs( const Vector< real > & aLhs, Cell< mesh::Field * > & aFields )
+            {
+                IWG * tIWG = mParent->iwg() ;
+
+                if( tIWG->mode() == IwgMode::Direct )
+                {
+                    // the fixed values are imposed by each proc
+                    for ( Dof * tDof: mDOFs )
+                    {
+                        if ( tDof->is_fixed() )
+                        {
+                            aFields( tDof->type_id() )->value(
+                                    tDof->dof_index_on_field() ) = tDof->value();
+                        }
+                        else
+                        {
+                            aFields( tDof->type_id() )->value(
+                                    tDof->dof_index_on_field() )
+                                    = aLhs( this->matrix_index( tDof ) );
+                        }
+                    }
+                }
+                else if( tIWG->algorithm() == SolverAlgorithm::NewtonRaphson )
+                {
+                    for ( Dof * tDof: mDOFs )
+                    {
+                        // update DOF values
+                        if ( !tDof->is_fixed() )
+                        {
+                            tDof->value() -= tIWG->omega() * aLhs( this->matrix_index( tDof ) );
+                        }
+
+                        // update value in field
+                        aFields( tDof->type_id() )->value(
+                                tDof->dof_index_on_field() ) = tDof->value();
+                    }
+                }
+                else
+                {
+                    real tA = 1. - tIWG->omega() ;
+                    real tB = tIWG->omega() ;
+
+                    for ( Dof * tDof: mDOFs )
+                    {
+                        // update DOF values
+                        if ( !tDof->is_fixed() )
+                        {
+                            tDof->value() *= tA ;
+                            tDof->value() += tB * aLhs( this->matrix_index( tDof ) );
+                        }
+
+                        // update value in field
+                        aFields( tDof->type_id() )->value(
+                                tDof->dof_index_on_field() ) = tDof->value() ;
+                    }
+                }
+            }
+
+//------------------------------------------------------------------------------
+
+            void
+            SolverData::compute_residual_vector()
+            {
+                if( mUseRowBlocks )
+                {
+                    // the Jacobian is the sum of the local matrices,
+                    // so each proc multiplies its own part
+                    if( mMyRank == mKernel->master() )
+                    {
+                        mJacobian->multiply( mFieldValues, mRhsVector, 1.0, -1.0 );
+
+                        // add the products of the other procs
+                        this->collect_vector( mRhsVector );
+                    }
+                    else
+                    {
+                        Vector< real > tMyY( mMyNumberOfFreeDofs );
+                        mJacobian->multiply( mFieldValues, tMyY, 1.0, 0.0 );
+
+                        // send my product to the master
+                        this->collect_vector( tMyY );
+                    }
+                }
+                else
+                {
+                    mJacobian->multiply( mFieldValues, mRhsVector, 1.0, -1.0 );
                 }
             }
 
@@ -1780,12 +2514,15 @@ namespace belfem
             void
             SolverData::save_system( const string & aPath )
             {
+                ProfilerRegion tRegion( "save_system" );
+
 #ifdef BELFEM_HDF5
 
                 if( mParent->parent()->is_master() )
                 {
 
                     HDF5 tFile( aPath, FileMode::NEW );
+                    tFile.set_compression( 4 );
 
                     this->save_system( tFile ) ;
 
@@ -1821,9 +2558,13 @@ namespace belfem
             {
                 herr_t tError = 0 ;
 
-                hid_t tGroup = aFile.select_group("Matrix");
-                mJacobian->load( tGroup, tError );
-                aFile.close_active_group() ;
+                // in distributed mode, the master does not have the whole matrix
+                if( ! mUseRowBlocks )
+                {
+                    hid_t tGroup = aFile.select_group( "Matrix" );
+                    mJacobian->load( tGroup, tError );
+                    aFile.close_active_group();
+                }
                 if( mRhsVector.length() > 0 )
                 {
                     aFile.load_data( "LHS", mLhsVector );
@@ -1857,12 +2598,74 @@ namespace belfem
 
             void
             SolverData::save_system( HDF5 & aFile )
+            {
+                SystemSnapshot tSnapshot ;
+                this->stage_system( tSnapshot );
+                tSnapshot.save( aFile );
+            }
+
+//------------------------------------------------------------------------------
+
+            void
+            SolverData::stage_system( SystemSnapshot & aSnapshot )
+            {
+                // in distributed mode, the master does not have the whole matrix
+                aSnapshot.mHasJacobian = ! mUseRowBlocks ;
+                if( aSnapshot.mHasJacobian )
+                {
+                    aSnapshot.mJacobian = *mJacobian ;
+                }
+
+                if( mRhsVector.length() > 0 )
+                {
+                    aSnapshot.mLhsVector = mLhsVector ;
+                    aSnapshot.mRhsVector = mRhsVector ;
+                }
+                else
+                {
+                    aSnapshot.mLhsMatrix = mLhsMatrix ;
+                    aSnapshot.mRhsMatrix = mRhsMatrix ;
+                }
+                aSnapshot.mConvection  = mConvection ;
+                aSnapshot.mVolumeLoads = mVolumeLoads ;
+                aSnapshot.mFieldValues = mFieldValues ;
+            }
+
+//------------------------------------------------------------------------------
+
+            luint
+            SystemSnapshot::memory() const
+            {
+                luint aBytes = ( mLhsVector.length() + mRhsVector.length()
+                               + mLhsMatrix.n_rows() * mLhsMatrix.n_cols()
+                               + mRhsMatrix.n_rows() * mRhsMatrix.n_cols()
+                               + mConvection.length() + mVolumeLoads.length()
+                               + mFieldValues.length() ) * sizeof( real );
+
+                if( mHasJacobian )
+                {
+                    // values, column indices and row pointers
+                    aBytes += mJacobian.number_of_nonzeros()
+                            * ( sizeof( real ) + sizeof( index_t ) )
+                            + ( mJacobian.n_rows() + 1 ) * sizeof( index_t );
+                }
+
+                return aBytes ;
+            }
+
+//------------------------------------------------------------------------------
+
+            void
+            SystemSnapshot::save( HDF5 & aFile )
             {
                 herr_t tError = 0 ;
 
-                hid_t tGroup = aFile.create_group("Matrix");
-                mJacobian->save( tGroup, tError );
-                aFile.close_active_group() ;
+                if( mHasJacobian )
+                {
+                    hid_t tGroup = aFile.create_group( "Matrix" );
+                    mJacobian.save( tGroup, tError );
+                    aFile.close_active_group();
+                }
                 if( mRhsVector.length() > 0 )
                 {
                     aFile.save_data( "LHS", mLhsVector );
@@ -1881,15 +2684,374 @@ namespace belfem
                 {
                     aFile.save_data( "VolumeLoads", mVolumeLoads );
                 }
-		if( mFieldValues.length() > 0 )
-		{
-		    aFile.save_data( "FieldValues", mFieldValues );
-		}
+                if( mFieldValues.length() > 0 )
+                {
+                    aFile.save_data( "FieldValues", mFieldValues );
+                }
+            }
+
+//------------------------------------------------------------------------------
+
+            void
+            SolverData::save_checkpoint( HDF5 & aFile )
+            {
+                BELFEM_ASSERT( this->supports_checkpoint(),
+                               "checkpoints are not supported for this matrix layout" );
+
+                herr_t & tStatus = aFile.status() ;
+
+                aFile.create_group( "Solver" );
+
+                uint tNumProcs = mKernel->number_of_procs() ;
+                aFile.save_data( "NumberOfProcs", tNumProcs );
+                aFile.save_data( "MatrixType",
+                                 this->matrix_type() == SpMatrixType::CSR ? "CSR" : "CSC" );
+
+                bool tHaveDirichlet = mDirichletMatrix != nullptr ;
+                aFile.save_data( "HaveDirichletMatrix", tHaveDirichlet );
+
+                // tables of the master
+                for( uint p=1; p<mJacobianTable.size(); ++p )
+                {
+                    aFile.save_data( sprint( "JacobianTable%u", p ), mJacobianTable( p ) );
+                }
+                for( uint p=1; p<mDirichletTable.size(); ++p )
+                {
+                    aFile.save_data( sprint( "DirichletTable%u", p ), mDirichletTable( p ) );
+                }
+                if( mMyRank == mKernel->master() )
+                {
+                    aFile.save_data( "NumberOfFreeDofsPerProc", mNumberOfFreeDofsPerProc );
+                    aFile.save_data( "NumberOfFixedDofsPerProc", mNumberOfFixedDofsPerProc );
+                }
+
+                // element tables, in the same order as in create_assembly_tables()
+                Cell< Element * > tElements ;
+                this->collect_table_elements( tElements );
+
+                index_t tNumElements = tElements.size() ;
+                index_t tJacobianLength = 0 ;
+                index_t tDirichletLength = 0 ;
+
+                Vector< index_t > tDirichletLengths( tNumElements );
+
+                for( index_t e=0; e<tNumElements; ++e )
+                {
+                    tJacobianLength += tElements( e )->jacobian_table().length() ;
+                    tDirichletLengths( e ) = tElements( e )->dirichlet_table().length() ;
+                    tDirichletLength += tDirichletLengths( e );
+                }
+
+                Vector< index_t > tJacobianTables( tJacobianLength );
+                Vector< index_t > tDirichletTables( tDirichletLength );
+
+                tJacobianLength = 0 ;
+                tDirichletLength = 0 ;
+
+                for( Element * tElement : tElements )
+                {
+                    for( index_t k : tElement->jacobian_table() )
+                    {
+                        tJacobianTables( tJacobianLength++ ) = k ;
+                    }
+                    for( index_t k : tElement->dirichlet_table() )
+                    {
+                        tDirichletTables( tDirichletLength++ ) = k ;
+                    }
+                }
+
+                aFile.save_data( "ElementJacobianTables", tJacobianTables );
+                aFile.save_data( "ElementDirichletLengths", tDirichletLengths );
+                aFile.save_data( "ElementDirichletTables", tDirichletTables );
+
+                // the tables are only valid for the same element dofs and patterns
+                aFile.save_data( "ElementDofHash", this->element_dof_hash( tElements ) );
+                aFile.save_data( "JacobianPatternHash", mJacobian->pattern_hash() );
+                if( tHaveDirichlet )
+                {
+                    aFile.save_data( "DirichletPatternHash", mDirichletMatrix->pattern_hash() );
+                }
+
+                aFile.close_active_group() ;
+
+                // the sparsity patterns, values are written as well
+                hid_t tGroup = aFile.create_group( "Jacobian" );
+                mJacobian->save( tGroup, tStatus );
+                aFile.close_active_group() ;
+
+                if( tHaveDirichlet )
+                {
+                    tGroup = aFile.create_group( "DirichletMatrix" );
+                    mDirichletMatrix->save( tGroup, tStatus );
+                    aFile.close_active_group() ;
+                }
+            }
+
+//------------------------------------------------------------------------------
+
+            bool
+            SolverData::checkpoint_matches( HDF5 & aFile )
+            {
+                uint   tNumProcs = 0 ;
+                string tMatrixType ;
+                bool   tHaveDirichlet = false ;
+
+                hid_t tGroup = aFile.select_group( "Solver" );
+
+                // files from older versions have no hashes
+                if( ! hdf5::dataset_exists( tGroup, "ElementDofHash" ) )
+                {
+                    aFile.close_active_group() ;
+                    return false ;
+                }
+
+                luint tElementDofHash = 0 ;
+                luint tJacobianHash = 0 ;
+                luint tDirichletHash = 0 ;
+
+                aFile.load_data( "NumberOfProcs", tNumProcs );
+                aFile.load_data( "MatrixType", tMatrixType );
+                aFile.load_data( "HaveDirichletMatrix", tHaveDirichlet );
+                aFile.load_data( "ElementDofHash", tElementDofHash );
+                aFile.load_data( "JacobianPatternHash", tJacobianHash );
+                if( tHaveDirichlet )
+                {
+                    aFile.load_data( "DirichletPatternHash", tDirichletHash );
+                }
+                aFile.close_active_group() ;
+
+                string tExpect = this->matrix_type() == SpMatrixType::CSR ? "CSR" : "CSC" ;
+
+                if( tNumProcs != ( uint ) mKernel->number_of_procs() || tMatrixType != tExpect )
+                {
+                    return false ;
+                }
+
+                // the elements must be connected to the same dofs
+                Cell< Element * > tElements ;
+                this->collect_table_elements( tElements );
+
+                if( tElementDofHash != this->element_dof_hash( tElements ) )
+                {
+                    return false ;
+                }
+
+                // the stored patterns must not be damaged
+                herr_t & tStatus = aFile.status() ;
+                SpMatrix tPattern ;
+
+                tGroup = aFile.select_group( "Jacobian" );
+                tPattern.load( tGroup, tStatus );
+                aFile.close_active_group() ;
+
+                if( tPattern.pattern_hash() != tJacobianHash )
+                {
+                    return false ;
+                }
+
+                if( tHaveDirichlet )
+                {
+                    tGroup = aFile.select_group( "DirichletMatrix" );
+                    tPattern.load( tGroup, tStatus );
+                    aFile.close_active_group() ;
+
+                    return tPattern.pattern_hash() == tDirichletHash ;
+                }
+
+                return true ;
+            }
+
+//------------------------------------------------------------------------------
+
+            void
+            SolverData::load_checkpoint( HDF5 & aFile )
+            {
+                // restore factory settings
+                this->reset() ;
+
+                mUseRowBlocks = false ;
+
+                this->compute_local_indices() ;
+
+                herr_t & tStatus = aFile.status() ;
+
+                aFile.select_group( "Solver" );
+
+                bool tHaveDirichlet = false ;
+                aFile.load_data( "HaveDirichletMatrix", tHaveDirichlet );
+
+                if( mMyRank == mKernel->master() && mKernel->number_of_procs() > 1 )
+                {
+                    uint tNumProcs = mKernel->comm_table().length() ;
+
+                    mJacobianTable.set_size( tNumProcs, {} );
+                    for( uint p=1; p<tNumProcs; ++p )
+                    {
+                        aFile.load_data( sprint( "JacobianTable%u", p ), mJacobianTable( p ) );
+                    }
+
+                    if( tHaveDirichlet )
+                    {
+                        mDirichletTable.set_size( tNumProcs, {} );
+                        for( uint p=1; p<tNumProcs; ++p )
+                        {
+                            aFile.load_data( sprint( "DirichletTable%u", p ), mDirichletTable( p ) );
+                        }
+                    }
+                }
+
+                Vector< index_t > tJacobianTables ;
+                Vector< index_t > tDirichletLengths ;
+                Vector< index_t > tDirichletTables ;
+
+                aFile.load_data( "ElementJacobianTables", tJacobianTables );
+                aFile.load_data( "ElementDirichletLengths", tDirichletLengths );
+                aFile.load_data( "ElementDirichletTables", tDirichletTables );
+
+                aFile.close_active_group() ;
+
+                Cell< Element * > tElements ;
+                this->collect_table_elements( tElements );
+
+                BELFEM_ERROR( tDirichletLengths.length() == tElements.size(),
+                              "Number of elements in checkpoint does not match ( is %lu, expect %lu )",
+                              ( long unsigned int ) tDirichletLengths.length(),
+                              ( long unsigned int ) tElements.size() );
+
+                index_t tJacobianCount = 0 ;
+                index_t tDirichletCount = 0 ;
+                index_t tCount = 0 ;
+
+                for( Element * tElement : tElements )
+                {
+                    index_t tN = tElement->number_of_dofs() ;
+
+                    Vector< index_t > & tJacobianTable  = tElement->jacobian_table() ;
+                    Vector< index_t > & tDirichletTable = tElement->dirichlet_table() ;
+
+                    tJacobianTable.set_size( tN * tN );
+                    for( index_t & k : tJacobianTable )
+                    {
+                        k = tJacobianTables( tJacobianCount++ );
+                    }
+
+                    tDirichletTable.set_size( tDirichletLengths( tCount++ ) );
+                    for( index_t & k : tDirichletTable )
+                    {
+                        k = tDirichletTables( tDirichletCount++ );
+                    }
+                }
+
+                BELFEM_ERROR( tJacobianCount == tJacobianTables.length()
+                           && tDirichletCount == tDirichletTables.length(),
+                              "Element tables in checkpoint do not match the elements" );
+
+                hid_t tGroup = aFile.select_group( "Jacobian" );
+                mJacobian = new SpMatrix() ;
+                mJacobian->load( tGroup, tStatus );
+                mJacobian->set_indexing_base( SpMatrixIndexingBase::Cpp );
+                aFile.close_active_group() ;
+
+                if( tHaveDirichlet )
+                {
+                    tGroup = aFile.select_group( "DirichletMatrix" );
+                    mDirichletMatrix = new SpMatrix() ;
+                    mDirichletMatrix->load( tGroup, tStatus );
+                    mDirichletMatrix->set_indexing_base( SpMatrixIndexingBase::Cpp );
+                    aFile.close_active_group() ;
+                }
+
+                this->allocate_rhs() ;
+
+                // the dof counters must be the same as when the file was written
+                if( mMyRank == mKernel->master() )
+                {
+                    Vector< index_t > tNumberOfFreeDofsPerProc ;
+                    Vector< index_t > tNumberOfFixedDofsPerProc ;
+
+                    aFile.select_group( "Solver" );
+                    aFile.load_data( "NumberOfFreeDofsPerProc", tNumberOfFreeDofsPerProc );
+                    aFile.load_data( "NumberOfFixedDofsPerProc", tNumberOfFixedDofsPerProc );
+                    aFile.close_active_group() ;
+
+                    bool tDofsMatch = tNumberOfFreeDofsPerProc.length() == mNumberOfFreeDofsPerProc.length()
+                            && tNumberOfFixedDofsPerProc.length() == mNumberOfFixedDofsPerProc.length() ;
+
+                    for( index_t p=0; tDofsMatch && p<mNumberOfFreeDofsPerProc.length(); ++p )
+                    {
+                        tDofsMatch = tNumberOfFreeDofsPerProc( p ) == mNumberOfFreeDofsPerProc( p )
+                                && tNumberOfFixedDofsPerProc( p ) == mNumberOfFixedDofsPerProc( p );
+                    }
+
+                    BELFEM_ERROR( tDofsMatch, "Number of dofs per proc in checkpoint does not match" );
+                }
             }
 
 #endif
 //------------------------------------------------------------------------------
 
+            luint
+            SolverData::element_dof_hash( Cell< Element * > & aElements )
+            {
+                luint aHash = hash_value( aElements.size() );
+
+                for( Element * tElement : aElements )
+                {
+                    aHash = hash_value( tElement->id(), aHash );
+                    aHash = hash_value( tElement->number_of_dofs(), aHash );
+
+                    for( uint k=0; k<tElement->number_of_dofs(); ++k )
+                    {
+                        aHash = hash_value( tElement->dof( k )->id(), aHash );
+                    }
+                }
+
+                return aHash ;
+            }
+
+//------------------------------------------------------------------------------
+
+            bool
+            SolverData::supports_checkpoint() const
+            {
+                return ! mLongIndices
+                    && ! ( mDistributedAssembly && mKernel->number_of_procs() > 1 ) ;
+            }
+
+//------------------------------------------------------------------------------
+
+            void
+            SolverData::collect_table_elements( Cell< Element * > & aElements )
+            {
+                aElements.clear() ;
+
+                // only groups that are part of the sparsity pattern
+                // and that are assembled get tables
+                for( Block * tBlock : mBlockData->blocks() )
+                {
+                    if( tBlock->is_active() )
+                    {
+                        for( Element * tElement : tBlock->elements() )
+                        {
+                            aElements.push( tElement );
+                        }
+                    }
+                }
+                for( id_t tID : mParent->iwg()->selected_sidesets() )
+                {
+                    SideSet * tSideSet = mSideSetData->sideset( tID );
+
+                    if( tSideSet->is_active() )
+                    {
+                        for( Element * tElement : tSideSet->elements() )
+                        {
+                            aElements.push( tElement );
+                        }
+                    }
+                }
+            }
+//------------------------------------------------------------------------------
+
             void
             SolverData::print_worst_dof()
             {
@@ -10,12 +10,14 @@
 #include "cl_Map.hpp"
 #include "cl_Vector.hpp"
 #include "cl_SpMatrix.hpp"
+#include "st_SpMatrixRowBlock.hpp"
 
 #include "cl_Solver.hpp"
 
 #include "cl_IWG.hpp"
 #include "cl_FEM_Dof.hpp"
 #include "cl_HDF5.hpp"
+#include "cl_HaloExchange.hpp"
 
 namespace belfem
 {
@@ -34,6 +36,34 @@ namespace belfem
             class BlockData ;
             class SideSetData ;
 
+#ifdef BELFEM_HDF5
+            /**
+             * a copy of the linear system that can be written
+             * to a backup file while the solver continues
+             */
+            struct SystemSnapshot
+            {
+                bool           mHasJacobian = false ;
+                SpMatrix       mJacobian ;
+                Vector< real > mLhsVector ;
+                Vector< real > mRhsVector ;
+                Matrix< real > mLhsMatrix ;
+                Matrix< real > mRhsMatrix ;
+                Vector< real > mConvection ;
+                Vector< real > mVolumeLoads ;
+                Vector< real > mFieldValues ;
+
+                // memory needed by this snapshot in bytes
+                luint
+                memory() const ;
+
+                // write the snapshot into an open HDF5 file
+                void
+                save( HDF5 & aFile ) ;
+            };
+#endif
+//------------------------------------------------------------------------------
+
             class SolverData
             {
                 //! the parent object
@@ -69,6 +99,33 @@ namespace belfem
                 Cell< Vector< index_t > > mJacobianTable;
                 Cell< Vector< index_t > > mDirichletTable;
 
+                // flag telling if the distributed assembly was requested
+                bool mDistributedAssembly = false ;
+
+                // request 64-bit indices for the global Jacobian
+                bool mLongIndices = false ;
+
+                // flag telling if each proc keeps the rows of the Jacobian it owns.
+                // The local matrices then use the local dof indices
+                bool mUseRowBlocks = false ;
+
+                // the rows of the Jacobian that belong to this proc
+                SpMatrixRowBlock mRowBlock ;
+
+                // sends the local nonzeros to the procs that own their rows
+                HaloExchange * mRowBlockExchange = nullptr ;
+
+                // local nonzeros in rows of this proc and their positions in the row block
+                Vector< index_t > mOwnEntries ;
+                Vector< index_t > mOwnPositions ;
+
+                // positions in the row block of the values received from the neighbors
+                Vector< index_t > mReceivePositions ;
+
+                // buffers for the exchange of the row block values
+                Vector< real > mLocalValues ;
+                Vector< real > mReceivedValues ;
+
                 // left hand side ( field values or deltas )
                 Vector< real > mLhsVector;
                 Matrix< real > mLhsMatrix;
@@ -127,6 +184,45 @@ namespace belfem
                 void
                 create_assembly_tables();
 
+//------------------------------------------------------------------------------
+
+                /**
+                 * keep the Jacobian distributed by rows instead of
+                 * gathering it on the master. Only used if the solver
+                 * supports it and more than one proc is running.
+                 * Must be called before the matrices are allocated.
+                 */
+                void
+                set_distributed_assembly( const bool aSwitch );
+
+//------------------------------------------------------------------------------
+
+                /**
+                 * tells if the Jacobian is kept distributed by rows
+                 */
+                bool
+                uses_distributed_assembly() const ;
+
+//------------------------------------------------------------------------------
+
+                /**
+                 * tells if each proc writes the solution of its own dofs
+                 * into its fields, so that they need not be distributed
+                 */
+                bool
+                updates_local_dofs() const ;
+
+//------------------------------------------------------------------------------
+
+                /**
+                 * use 64-bit indices for the Jacobian on the master,
+                 * needed if the number of nonzeros exceeds the 32-bit range.
+                 * Only used if the solver supports it.
+                 * Must be called before the matrices are allocated.
+                 */
+                void
+                set_long_indices( const bool aSwitch );
+
 //------------------------------------------------------------------------------
 
                 void
@@ -313,8 +409,44 @@ namespace belfem
 
                 void
                 load_system( HDF5 & aFile );
+
+                /**
+                 * copy the current system so that it can be saved
+                 * by a background writer
+                 */
+                void
+                stage_system( SystemSnapshot & aSnapshot );
+
+                /**
+                 * write the sparsity pattern and the assembly tables,
+                 * must be called right after create_assembly_tables()
+                 */
+                void
+                save_checkpoint( HDF5 & aFile );
+
+                /**
+                 * tells if the checkpoint was written with the same
+                 * number of procs and matrix layout
+                 */
+                bool
+                checkpoint_matches( HDF5 & aFile );
+
+                /**
+                 * replaces allocate_matrices() and create_assembly_tables()
+                 */
+                void
+                load_checkpoint( HDF5 & aFile );
 #endif
 
+//------------------------------------------------------------------------------
+
+                /**
+                 * checkpoints are not written if the Jacobian is kept
+                 * in row blocks or uses 64-bit indices
+                 */
+                bool
+                supports_checkpoint() const ;
+
 //------------------------------------------------------------------------------
             private:
 //------------------------------------------------------------------------------
@@ -349,11 +481,139 @@ namespace belfem
                                 const bool aFixedFlag,
                                 Cell< graph::Vertex * > & aGraph );
 
+//----------------------------------------------------------------------------
+
+                /**
+                 * flatten the element wise data into the tables for the
+                 * graph free SpMatrix constructor. Free and fixed indices
+                 * are gNoIndex if the dof is of the other kind.
+                 */
+                void
+                create_pattern_tables( const Vector< id_t > & aElementWiseData,
+                                       Vector< index_t > & aOffsets,
+                                       Vector< index_t > & aFreeIndices,
+                                       Vector< index_t > & aFixedIndices );
+
+//-----------------------------------------------------------------------------
+
+                /**
+                 * index of a dof in the local matrices, which is the
+                 * local index if the Jacobian is kept distributed
+                 */
+                index_t
+                matrix_index( Dof * aDof ) const ;
+
+//-----------------------------------------------------------------------------
+
+                /**
+                 * compute the positions of the element matrix entries
+                 * in the Jacobian and the Dirichlet matrix.
+                 * Throws an error if an entry is not in the pattern
+                 */
+                void
+                create_element_tables( Cell< Element * > & aElements );
+
+//-----------------------------------------------------------------------------
+
+                /**
+                 * compute the row ownership and the tables that are needed
+                 * to send the local nonzeros to the procs that own the rows
+                 */
+                void
+                create_row_block_tables();
+
+//-----------------------------------------------------------------------------
+
+                /**
+                 * send the local nonzeros to their owners
+                 * and add them into the row block
+                 */
+                void
+                collect_row_blocks();
+
+//-----------------------------------------------------------------------------
+
+                /**
+                 * in distributed mode, multiply the local Dirichlet matrix
+                 * with the fixed values and add the sum to the rhs on the master
+                 */
+                void
+                add_dirichlet_loads();
+
+//-----------------------------------------------------------------------------
+
+                /**
+                 * compute r = A * x - b and write it into the rhs vector
+                 * of the master. In distributed mode, each proc
+                 * multiplies its own part and must call this function.
+                 */
+                void
+                compute_residual_vector();
+//-----------------------------------------------------------------------------
+
+                /**
+                 * send the solution of the free dofs of each proc from the
+                 * master, in the order of the local indices
+                 */
+                void
+                scatter_solution( Vector< real > & aLhs );
+
+//-----------------------------------------------------------------------------
+
+                /**
+                 * update the dofs of this proc with the solution
+                 * and write them and the fixed values into the fields
+                 */
+                void
+                update_dofs( const Vector< real > & aLhs, Cell< mesh::Field * > & aFields );
+
 //-----------------------------------------------------------------------------
 
                 void
                 collect_fields( Cell< mesh::Field * > & aFields );
 
+//------------------------------------------------------------------------------
+
+                /**
+                 * write the local indices into the dofs
+                 */
+                void
+                compute_local_indices();
+
+//------------------------------------------------------------------------------
+
+                /**
+                 * allocate the right hand side and
+                 * send the dof counters to the master
+                 */
+                void
+                allocate_rhs();
+
+//------------------------------------------------------------------------------
+
+                /**
+                 * elements of the active blocks and the selected sidesets,
+                 * in the order in which the element tables are written
+                 */
+                void
+                collect_table_elements( Cell< Element * > & aElements );
+
+//------------------------------------------------------------------------------
+
+                /**
+                 * hash of the dof ids of the table elements
+                 */
+                luint
+                element_dof_hash( Cell< Element * > & aElements );
+
+//------------------------------------------------------------------------------
+
+                /**
+                 * the matrix layout the current solver expects
+                 */
+                SpMatrixType
+                matrix_type() const ;
+
 //------------------------------------------------------------------------------
             };
 //------------------------------------------------------------------------------
@@ -425,9 +685,44 @@ namespace belfem
             inline void
             SolverData::use_reset_values( const bool aFlag )
             {
+                BELFEM_ERROR( ! ( aFlag && mUseRowBlocks ),
+                              "Reset values can not be used with distributed assembly" );
+
                 mUseResetValues = aFlag ;
             }
 
+//------------------------------------------------------------------------------
+
+            inline void
+            SolverData::set_distributed_assembly( const bool aSwitch )
+            {
+                mDistributedAssembly = aSwitch ;
+            }
+
+//------------------------------------------------------------------------------
+
+            inline bool
+            SolverData::uses_distributed_assembly() const
+            {
+                return mUseRowBlocks ;
+            }
+
+//------------------------------------------------------------------------------
+
+            inline index_t
+            SolverData::matrix_index( Dof * aDof ) const
+            {
+                return mUseRowBlocks ? aDof->my_index() : aDof->index() ;
+            }
+
+//------------------------------------------------------------------------------
+
+            inline void
+            SolverData::set_long_indices( const bool aSwitch )
+            {
+                mLongIndices = aSwitch ;
+            }
+
 //------------------------------------------------------------------------------
         } /* end namespace dofmgr */
     } /* end namespace fem */
@@ -46,6 +46,11 @@ namespace belfem
             Dof ** mDOFs = nullptr ;
             uint mNumberOfDofs = 0 ;
 
+            // positions of the element matrix entries in the data
+            // containers of the Jacobian and the Dirichlet matrix
+            Vector< index_t > mJacobianTable ;
+            Vector< index_t > mDirichletTable ;
+
             // pointer to L-Matrix function
             void
             ( Element::*mL )( Matrix< real > & aJ, Matrix< real > & aL );
@@ -129,6 +134,24 @@ namespace belfem
             uint
             number_of_dofs() const ;
 
+//------------------------------------------------------------------------------
+
+            /**
+             * expose the precomputed positions of the element
+             * matrix entries in the system Jacobian
+             */
+            Vector< index_t > &
+            jacobian_table();
+
+//------------------------------------------------------------------------------
+
+            /**
+             * expose the precomputed positions of the element
+             * matrix entries in the Dirichlet matrix
+             */
+            Vector< index_t > &
+            dirichlet_table();
+
 //------------------------------------------------------------------------------
 
             /**
@@ -529,6 +552,22 @@ namespace belfem
             return mDOFs[ aIndex ];
         }
 
+//------------------------------------------------------------------------------
+
+        inline Vector< index_t > &
+        Element::jacobian_table()
+        {
+            return mJacobianTable ;
+        }
+
+//------------------------------------------------------------------------------
+
+        inline Vector< index_t > &
+        Element::dirichlet_table()
+        {
+            return mDirichletTable ;
+        }
+
 //------------------------------------------------------------------------------
 
         inline uint
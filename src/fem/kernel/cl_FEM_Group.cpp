@@ -37,9 +37,23 @@ namespace belfem
                 mMyRank( comm_rank()),
                 mMeshID( aID )
         {
+            // work containers for the first thread
+            mWork.set_size( 1, nullptr );
+            mWork( 0 ) = new GroupWork ;
+
             this->link_material_functions();
         }
 
+//------------------------------------------------------------------------------
+
+        Group::~Group()
+        {
+            for( GroupWork * tWork : mWork )
+            {
+                delete tWork ;
+            }
+        }
+
 //------------------------------------------------------------------------------
         void
         Group::delete_pointers()
@@ -275,6 +289,241 @@ namespace belfem
             return BELFEM_QUIET_NAN ;
         }
 
+//------------------------------------------------------------------------------
+
+        void
+        Group::replicate_work( const uint aNumberOfThreads )
+        {
+            // delete copies that are no longer needed
+            for( uint t=aNumberOfThreads; t<mWork.size(); ++t )
+            {
+                delete mWork( t );
+            }
+
+            // existing copies are kept, new entries are nullptr
+            mWork.set_size( aNumberOfThreads, nullptr );
+
+            const GroupWork & tMaster = *mWork( 0 );
+
+            for( uint t=1; t<aNumberOfThreads; ++t )
+            {
+                if( mWork( t ) == nullptr )
+                {
+                    mWork( t ) = new GroupWork( tMaster );
+                }
+                else
+                {
+                    // the containers keep their memory if the sizes match
+                    *mWork( t ) = tMaster ;
+                }
+            }
+        }
+
+//------------------------------------------------------------------------------
+
+        void
+        Group::compute_batch_geometry( Element * const * aElements, const uint aNumberOfElements )
+        {
+            BELFEM_ASSERT( mType == GroupType::BLOCK,
+                           "batch geometry can only be computed for blocks" );
+
+            GroupWork & tWork = this->work() ;
+
+            const uint tNumDim   = mGeometryIntegrationData->number_of_dimensions() ;
+            const uint tNumNodes = mGeometryIntegrationData->number_of_nodes() ;
+            const uint tNumPoints = mIntegrationData->number_of_integration_points() ;
+
+            // grow the containers if needed
+            if( tWork.mBatchElements.size() < aNumberOfElements )
+            {
+                tWork.mBatchElements.set_size( aNumberOfElements, nullptr );
+                tWork.mBatchX.set_size( aNumberOfElements * tNumNodes * tNumDim );
+                tWork.mBatchdNdX.set_size( aNumberOfElements * tNumPoints
+                    * mIntegrationData->number_of_nodes() * tNumDim );
+                tWork.mBatchDetJ.set_size( aNumberOfElements * tNumPoints );
+            }
+
+            // collect the node coordinates
+            real * tX = tWork.mBatchX.data() ;
+            for( uint e=0; e<aNumberOfElements; ++e )
+            {
+                mesh::Element * tElement = aElements[ e ]->element() ;
+                tWork.mBatchElements( e ) = aElements[ e ];
+
+                for( uint k=0; k<tNumNodes; ++k )
+                {
+                    const mesh::Node * tNode = tElement->node( k );
+                    for( uint i=0; i<tNumDim; ++i )
+                    {
+                        *tX++ = tNode->x( i );
+                    }
+                }
+            }
+
+            mIntegrationData->compute_dNdX( *mGeometryIntegrationData,
+                                            aNumberOfElements,
+                                            tWork.mBatchX.data(),
+                                            tWork.mBatchdNdX.data(),
+                                            tWork.mBatchDetJ.data() );
+
+            tWork.mBatchSize  = aNumberOfElements ;
+            tWork.mBatchIndex = 0 ;
+        }
+
+//------------------------------------------------------------------------------
+
+        uint
+        Group::batch_index( Element * aElement )
+        {
+            GroupWork & tWork = this->work() ;
+
+            // the elements are usually requested in the order of the batch
+            for( uint e=tWork.mBatchIndex; e<tWork.mBatchSize; ++e )
+            {
+                if( tWork.mBatchElements( e ) == aElement )
+                {
+                    tWork.mBatchIndex = e ;
+                    return e ;
+                }
+            }
+
+            for( uint e=0; e<tWork.mBatchIndex && e<tWork.mBatchSize; ++e )
+            {
+                if( tWork.mBatchElements( e ) == aElement )
+                {
+                    tWork.mBatchIndex = e ;
+                    return e ;
+                }
+            }
+
+            // not in batch, compute this element only
+            this->compute_batch_geometry( & aElement, 1 );
+
+            return 0 ;
+        }
+
+//------------------------------------------------------------------------------
+
+        void
+        Group::color_elements()
+        {
+            mElementColors.clear() ;
+
+            index_t tNumElements = mElements.size() ;
+
+            if( tNumElements == 0 )
+            {
+                return;
+            }
+
+            // count the free dofs
+            index_t tNumDofs = 0 ;
+            for( Element * tElement : mElements )
+            {
+                for( uint k=0; k<tElement->number_of_dofs(); ++k )
+                {
+                    Dof * tDof = tElement->dof( k );
+                    if( ! tDof->is_fixed() )
+                    {
+                        tNumDofs = std::max( tNumDofs, tDof->my_index() + 1 );
+                    }
+                }
+            }
+
+            // compute the dof to element connectivity in compressed form
+            Vector< index_t > tPointers( tNumDofs + 1, 0 );
+            for( Element * tElement : mElements )
+            {
+                for( uint k=0; k<tElement->number_of_dofs(); ++k )
+                {
+                    Dof * tDof = tElement->dof( k );
+                    if( ! tDof->is_fixed() )
+                    {
+                        ++tPointers( tDof->my_index() + 1 );
+                    }
+                }
+            }
+            for( index_t d=0; d<tNumDofs; ++d )
+            {
+                tPointers( d + 1 ) += tPointers( d );
+            }
+
+            Vector< index_t > tOffset( tNumDofs );
+            for( index_t d=0; d<tNumDofs; ++d )
+            {
+                tOffset( d ) = tPointers( d );
+            }
+
+            Vector< index_t > tDofElements( tPointers( tNumDofs ) );
+            for( index_t e=0; e<tNumElements; ++e )
+            {
+                Element * tElement = mElements( e );
+                for( uint k=0; k<tElement->number_of_dofs(); ++k )
+                {
+                    Dof * tDof = tElement->dof( k );
+                    if( ! tDof->is_fixed() )
+                    {
+                        tDofElements( tOffset( tDof->my_index() )++ ) = e ;
+                    }
+                }
+            }
+
+            // greedy coloring. The forbidden array contains
+            // the index of the last element that blocked the color
+            Vector< index_t > tColor( tNumElements, gNoIndex );
+            Vector< index_t > tForbidden( tNumElements, gNoIndex );
+            index_t tNumColors = 0 ;
+
+            for( index_t e=0; e<tNumElements; ++e )
+            {
+                Element * tElement = mElements( e );
+                for( uint k=0; k<tElement->number_of_dofs(); ++k )
+                {
+                    Dof * tDof = tElement->dof( k );
+                    if( ! tDof->is_fixed() )
+                    {
+                        index_t d = tDof->my_index() ;
+                        for( index_t i=tPointers( d ); i<tPointers( d + 1 ); ++i )
+                        {
+                            index_t f = tDofElements( i );
+                            if( tColor( f ) != gNoIndex )
+                            {
+                                tForbidden( tColor( f ) ) = e ;
+                            }
+                        }
+                    }
+                }
+
+                index_t c = 0 ;
+                while( tForbidden( c ) == e )
+                {
+                    ++c ;
+                }
+                tColor( e ) = c ;
+                tNumColors = std::max( tNumColors, c + 1 );
+            }
+
+            // count the elements per color
+            Vector< index_t > tCount( tNumColors, 0 );
+            for( index_t e=0; e<tNumElements; ++e )
+            {
+                ++tCount( tColor( e ) );
+            }
+
+            mElementColors.set_size( tNumColors, Vector< index_t >() );
+            for( index_t c=0; c<tNumColors; ++c )
+            {
+                mElementColors( c ).set_size( tCount( c ) );
+                tCount( c ) = 0 ;
+            }
+
+            for( index_t e=0; e<tNumElements; ++e )
+            {
+                index_t c = tColor( e );
+                mElementColors( c )( tCount( c )++ ) = e ;
+            }
+        }
+
 //------------------------------------------------------------------------------
 
         const IntegrationData *
@@ -17,6 +17,7 @@
 #include "cl_Material.hpp"
 #include "en_FEM_DomainType.hpp"
 #include "cl_IF_IntegrationData.hpp"
+#include "threadtools.hpp"
 
 namespace belfem
 {
@@ -32,54 +33,21 @@ namespace belfem
 
 //------------------------------------------------------------------------------
 
-        class Group
+        /**
+         * work containers used by the IWG during element integration.
+         * The group owns one of these per thread, so that elements
+         * of the same group can be integrated in parallel.
+         */
+        struct GroupWork
         {
-//------------------------------------------------------------------------------
-        protected:
-//------------------------------------------------------------------------------
-
-            // pointer to parent
-            DofManagerBase * mParent ;
-
-            // either block or sideset
-            const GroupType mType ;
-
-            const ElementType mElementType;
-
-            const id_t mID;
-
-            const index_t mNumberOfElements;
-
-            // flag that tells if elements are destoyed by destructor
-            const bool mOwnElements ;
-
-            const proc_t  mMyRank;
-
-            // detailed domain type, mainly used for Maxwell
-            DomainType mDomainType = DomainType::Default ;
-
             // container for node coordinates
             Matrix< real > mNodeCoords ;
 
-            // must be set by child
-            uint mNumberOfNodesPerElement = BELFEM_UINT_MAX ;
-
-            bool mIsIsogeometric = true ;
-
-            IntegrationData * mIntegrationData = nullptr ;
-            IntegrationData * mGeometryIntegrationData = nullptr ;
-
-            // shape function for element boundaries
-            Cell< Cell< Matrix < real > > > mBoundaryN ;
-
             // edge shape function
             Matrix< real >         mWorkE ;
             Matrix< real >         mWorkDEDXi;
             Matrix< real >         mWorkDEDX;
 
-            // Element container
-            Cell< Element * > mElements;
-
             Matrix< real > mWorkDNDX;    // work matrix for dNdX
 
             // Work matrices for geometry transformation
@@ -138,6 +106,64 @@ namespace belfem
 
             Vector< real > mWorkNormal ;
 
+            // geometry of a batch of elements, see Group::compute_batch_geometry
+            Cell< Element * > mBatchElements ;
+            Vector< real > mBatchX ;      // node coordinates [element][node][dim]
+            Vector< real > mBatchdNdX ;   // derivatives [element][ip][node][dim]
+            Vector< real > mBatchDetJ ;   // abs of det J [element][ip]
+            uint mBatchSize  = 0 ;
+            uint mBatchIndex = 0 ;
+        };
+
+//------------------------------------------------------------------------------
+
+        class Group
+        {
+//------------------------------------------------------------------------------
+        protected:
+//------------------------------------------------------------------------------
+
+            // pointer to parent
+            DofManagerBase * mParent ;
+
+            // either block or sideset
+            const GroupType mType ;
+
+            const ElementType mElementType;
+
+            const id_t mID;
+
+            const index_t mNumberOfElements;
+
+            // flag that tells if elements are destoyed by destructor
+            const bool mOwnElements ;
+
+            const proc_t  mMyRank;
+
+            // detailed domain type, mainly used for Maxwell
+            DomainType mDomainType = DomainType::Default ;
+
+            // must be set by child
+            uint mNumberOfNodesPerElement = BELFEM_UINT_MAX ;
+
+            bool mIsIsogeometric = true ;
+
+            IntegrationData * mIntegrationData = nullptr ;
+            IntegrationData * mGeometryIntegrationData = nullptr ;
+
+            // shape function for element boundaries
+            Cell< Cell< Matrix < real > > > mBoundaryN ;
+
+            // Element container
+            Cell< Element * > mElements;
+
+            // work containers, one per thread
+            Cell< GroupWork * > mWork ;
+
+            // element indices sorted by color. Elements of the same
+            // color do not share any free dof
+            Cell< Vector< index_t > > mElementColors ;
+
             // pointer to material ( owned by kernel )
             Material * mMaterial = nullptr;
 
@@ -176,7 +202,7 @@ namespace belfem
 
 //------------------------------------------------------------------------------
 
-            virtual ~Group() = default ;
+            virtual ~Group() ;
 
 //------------------------------------------------------------------------------
 
@@ -351,6 +377,77 @@ namespace belfem
             const Matrix< real > &
             d2GdXi2( const uint aIndex ) const;
 
+//------------------------------------------------------------------------------
+
+            /**
+             * the work containers of the calling thread
+             */
+            GroupWork &
+            work() const ;
+
+//------------------------------------------------------------------------------
+
+            /**
+             * copy the work containers of the first thread,
+             * which have been allocated by the IWG, to all other threads.
+             * Existing copies are reused.
+             */
+            void
+            replicate_work( const uint aNumberOfThreads );
+
+//------------------------------------------------------------------------------
+
+            /**
+             * sort the elements into colors, so that no two elements
+             * of the same color share a free dof. Must be called
+             * after the dofs have been fixed and numbered
+             */
+            void
+            color_elements();
+
+//------------------------------------------------------------------------------
+
+            /**
+             * the element indices per color
+             */
+            const Cell< Vector< index_t > > &
+            element_colors() const ;
+
+//------------------------------------------------------------------------------
+
+            /**
+             * compute dNdX and det J for all integration points of a batch of
+             * elements and store them in the work containers of the calling thread.
+             * Only available for blocks
+             */
+            void
+            compute_batch_geometry( Element * const * aElements, const uint aNumberOfElements );
+
+//------------------------------------------------------------------------------
+
+            /**
+             * position of the element in the current batch. If the element
+             * is not part of the batch, a batch with only this element is computed
+             */
+            uint
+            batch_index( Element * aElement );
+
+//------------------------------------------------------------------------------
+
+            /**
+             * dNdX of an element in the current batch, laid out as [node][dim]
+             */
+            const real *
+            batch_dNdX( const uint aBatchIndex, const uint aPointIndex ) const ;
+
+//------------------------------------------------------------------------------
+
+            /**
+             * abs of det J of an element in the current batch
+             */
+            real
+            batch_det_J( const uint aBatchIndex, const uint aPointIndex ) const ;
+
 //------------------------------------------------------------------------------
 
             /**
@@ -897,7 +994,7 @@ namespace belfem
         inline Matrix< real > &
         Group::node_coords()
         {
-            return mNodeCoords ;
+            return this->work().mNodeCoords ;
         }
 
 //------------------------------------------------------------------------------
@@ -956,12 +1053,57 @@ namespace belfem
             return mGeometryIntegrationData->d2NdXi2( aIndex );
         }
 
+//------------------------------------------------------------------------------
+
+        inline GroupWork &
+        Group::work() const
+        {
+            BELFEM_ASSERT( thread_index() < mWork.size(),
+                           "no work containers allocated for thread %u",
+                           ( unsigned int ) thread_index() );
+
+            return * mWork( thread_index() );
+        }
+
+//------------------------------------------------------------------------------
+
+        inline const Cell< Vector< index_t > > &
+        Group::element_colors() const
+        {
+            return mElementColors ;
+        }
+
+//------------------------------------------------------------------------------
+
+        inline const real *
+        Group::batch_dNdX( const uint aBatchIndex, const uint aPointIndex ) const
+        {
+            const GroupWork & tWork = this->work() ;
+
+            BELFEM_ASSERT( aBatchIndex < tWork.mBatchSize, "invalid batch index" );
+
+            return tWork.mBatchdNdX.data() + ( aBatchIndex * mIntegrationData->number_of_integration_points() + aPointIndex )
+                * mIntegrationData->number_of_nodes() * mIntegrationData->number_of_dimensions() ;
+        }
+
+//------------------------------------------------------------------------------
+
+        inline real
+        Group::batch_det_J( const uint aBatchIndex, const uint aPointIndex ) const
+        {
+            const GroupWork & tWork = this->work() ;
+
+            BELFEM_ASSERT( aBatchIndex < tWork.mBatchSize, "invalid batch index" );
+
+            return tWork.mBatchDetJ( aBatchIndex * mIntegrationData->number_of_integration_points() + aPointIndex );
+        }
+
 //------------------------------------------------------------------------------
 
         inline uint &
         Group::work_index()
         {
-            return mWorkIndex;
+            return this->work().mWorkIndex ;
         }
 
 
@@ -970,7 +1112,7 @@ namespace belfem
         inline Matrix< real > &
         Group::work_H()
         {
-            return mWorkH;
+            return this->work().mWorkH ;
         }
 
 //------------------------------------------------------------------------------
@@ -978,7 +1120,7 @@ namespace belfem
         inline Matrix< real > &
         Group::work_E()
         {
-            return mWorkE;
+            return this->work().mWorkE ;
         }
 
 //------------------------------------------------------------------------------
@@ -986,7 +1128,7 @@ namespace belfem
         inline Matrix< real > &
         Group::work_dEdXi()
         {
-            return mWorkDEDXi ;
+            return this->work().mWorkDEDXi ;
         }
 
 //------------------------------------------------------------------------------
@@ -994,7 +1136,7 @@ namespace belfem
         inline Matrix< real > &
         Group::work_dEdX()
         {
-            return mWorkDEDX ;
+            return this->work().mWorkDEDX ;
         }
 
 //------------------------------------------------------------------------------
@@ -1002,7 +1144,7 @@ namespace belfem
         inline Matrix< real > &
         Group::work_M()
         {
-            return mWorkM;
+            return this->work().mWorkM ;
         }
 
 //------------------------------------------------------------------------------
@@ -1010,7 +1152,7 @@ namespace belfem
         inline Matrix< real > &
         Group::work_G()
         {
-            return mWorkG;
+            return this->work().mWorkG ;
         }
 
 //------------------------------------------------------------------------------
@@ -1018,7 +1160,7 @@ namespace belfem
         inline Matrix< real > &
         Group::work_J()
         {
-            return mWorkJ;
+            return this->work().mWorkJ ;
         }
 
 //------------------------------------------------------------------------------
@@ -1026,7 +1168,7 @@ namespace belfem
         inline Matrix< real > &
         Group::work_invJ()
         {
-            return mWorkinvJ;
+            return this->work().mWorkinvJ ;
         }
 
 //------------------------------------------------------------------------------
@@ -1034,7 +1176,7 @@ namespace belfem
         inline real &
         Group::work_det_J()
         {
-            return mWorkDetJ ;
+            return this->work().mWorkDetJ ;
         }
 
 //------------------------------------------------------------------------------
@@ -1042,7 +1184,7 @@ namespace belfem
         inline real
         Group::dx() const
         {
-            return mWorkDetJ ;
+            return this->work().mWorkDetJ ;
         }
 
 //------------------------------------------------------------------------------
@@ -1050,7 +1192,7 @@ namespace belfem
         inline real &
         Group::work_det_invJ()
         {
-            return mWorkDetInvJ ;
+            return this->work().mWorkDetInvJ ;
         }
 
 //------------------------------------------------------------------------------
@@ -1058,7 +1200,7 @@ namespace belfem
         inline Matrix< real > &
         Group::work_K()
         {
-            return mWorkK;
+            return this->work().mWorkK ;
         }
 
 //------------------------------------------------------------------------------
@@ -1066,7 +1208,7 @@ namespace belfem
         inline Matrix< real > &
         Group::work_L()
         {
-            return mWorkL;
+            return this->work().mWorkL ;
         }
 
 //------------------------------------------------------------------------------
@@ -1074,7 +1216,7 @@ namespace belfem
         inline Matrix< real > &
         Group::work_dNdX()
         {
-            return mWorkDNDX;
+            return this->work().mWorkDNDX ;
         }
 
 //------------------------------------------------------------------------------
@@ -1082,7 +1224,7 @@ namespace belfem
         inline Matrix< real > &
         Group::work_C()
         {
-            return mWorkC;
+            return this->work().mWorkC ;
         }
 
 //------------------------------------------------------------------------------
@@ -1090,7 +1232,7 @@ namespace belfem
         inline Matrix< real > &
         Group::work_D()
         {
-            return mWorkD;
+            return this->work().mWorkD ;
         }
 
 //------------------------------------------------------------------------------
@@ -1098,7 +1240,7 @@ namespace belfem
         inline Matrix< real > &
         Group::work_N()
         {
-            return mWorkN;
+            return this->work().mWorkN ;
         }
 
 //------------------------------------------------------------------------------
@@ -1106,7 +1248,7 @@ namespace belfem
         inline Matrix< real > &
         Group::work_B()
         {
-            return mWorkB;
+            return this->work().mWorkB ;
         }
 
 //------------------------------------------------------------------------------
@@ -1114,7 +1256,7 @@ namespace belfem
         inline Vector< real > &
         Group::work_rhs()
         {
-            return mWorkRhs;
+            return this->work().mWorkRhs ;
         }
 
 //------------------------------------------------------------------------------
@@ -1122,7 +1264,7 @@ namespace belfem
         inline Vector< real > &
         Group::work_phi()
         {
-            return mWorkphi;
+            return this->work().mWorkphi ;
         }
 
 //------------------------------------------------------------------------------
@@ -1130,7 +1272,7 @@ namespace belfem
         inline Matrix< real > &
         Group::work_Phi()
         {
-            return mWorkPhi;
+            return this->work().mWorkPhi ;
         }
 
 //------------------------------------------------------------------------------
@@ -1138,7 +1280,7 @@ namespace belfem
         inline Vector< real > &
         Group::work_psi()
         {
-            return mWorkpsi;
+            return this->work().mWorkpsi ;
         }
 
 //------------------------------------------------------------------------------
@@ -1146,14 +1288,14 @@ namespace belfem
         inline Matrix< real > &
         Group::work_Psi()
         {
-            return mWorkPsi;
+            return this->work().mWorkPsi ;
         }
 //------------------------------------------------------------------------------
 
         inline Vector< real > &
         Group::work_chi()
         {
-            return mWorkchi;
+            return this->work().mWorkchi ;
         }
 
 //------------------------------------------------------------------------------
@@ -1161,7 +1303,7 @@ namespace belfem
         inline Matrix< real > &
         Group::work_Chi()
         {
-            return mWorkChi;
+            return this->work().mWorkChi ;
         }
 
 //------------------------------------------------------------------------------
@@ -1169,7 +1311,7 @@ namespace belfem
         inline Vector< real > &
         Group::work_sigma()
         {
-            return mWorksigma;
+            return this->work().mWorksigma ;
         }
 
 //------------------------------------------------------------------------------
@@ -1177,7 +1319,7 @@ namespace belfem
         inline Matrix< real > &
         Group::work_Sigma()
         {
-            return mWorkSigma;
+            return this->work().mWorkSigma ;
         }
 
 //------------------------------------------------------------------------------
@@ -1185,7 +1327,7 @@ namespace belfem
         inline Vector< real > &
         Group::work_tau()
         {
-            return mWorktau;
+            return this->work().mWorktau ;
         }
 
 //------------------------------------------------------------------------------
@@ -1193,7 +1335,7 @@ namespace belfem
         inline Matrix< real > &
         Group::work_Tau()
         {
-            return mWorkTau;
+            return this->work().mWorkTau ;
         }
 
 //------------------------------------------------------------------------------
@@ -1201,21 +1343,21 @@ namespace belfem
         inline Vector< real > &
         Group::work_gamma()
         {
-            return mWorkgamma;
+            return this->work().mWorkgamma ;
         }
 //------------------------------------------------------------------------------
 
         inline Vector< real > &
         Group::work_theta()
         {
-            return mWorktheta;
+            return this->work().mWorktheta ;
         }
 //------------------------------------------------------------------------------
 
         inline Matrix< real > &
         Group::work_Gamma()
         {
-            return mWorkGamma;
+            return this->work().mWorkGamma ;
         }
 
 //------------------------------------------------------------------------------
@@ -1223,7 +1365,7 @@ namespace belfem
         inline Matrix< real > &
         Group::work_X()
         {
-            return mWorkX;
+            return this->work().mWorkX ;
         }
 
 //------------------------------------------------------------------------------
@@ -1231,7 +1373,7 @@ namespace belfem
         inline Matrix< real > &
         Group::work_Xm()
         {
-            return mWorkXm;
+            return this->work().mWorkXm ;
         }
 
 //------------------------------------------------------------------------------
@@ -1239,7 +1381,7 @@ namespace belfem
         inline Matrix< real > &
         Group::work_Xs()
         {
-            return mWorkXs;
+            return this->work().mWorkXs ;
         }
 
 //------------------------------------------------------------------------------
@@ -1247,7 +1389,7 @@ namespace belfem
         inline Vector< real > &
         Group::work_nedelec()
         {
-            return mWorkNedelec ;
+            return this->work().mWorkNedelec ;
         }
 
 //------------------------------------------------------------------------------
@@ -1405,7 +1547,7 @@ namespace belfem
         inline Vector< real > &
         Group:: work_geo()
         {
-            return mWorkgeo ;
+            return this->work().mWorkgeo ;
         }
 
 //------------------------------------------------------------------------------
@@ -1413,7 +1555,7 @@ namespace belfem
         inline Vector< real > &
         Group:: work_normal()
         {
-            return mWorkNormal ;
+            return this->work().mWorkNormal ;
         }
 
 //------------------------------------------------------------------------------
@@ -1,6 +1,8 @@
 //
 // Created by Christian Messe on 24.10.19.
 //
+#include <cstring>
+
 #include "cl_FEM_Kernel.hpp"
 
 #include "cl_Map.hpp"
@@ -16,6 +18,8 @@
 #include "cl_MaterialFactory.hpp"
 #include "cl_IwgFactory.hpp"
 #include "cl_FEM_DofManager.hpp"
+#include "cl_HDF5.hpp"
+#include "filetools.hpp"
 
 #include "cl_Pipette.hpp"
 #include "fn_sum.hpp"
@@ -24,6 +28,46 @@ namespace belfem
 {
     namespace fem
     {
+#ifdef BELFEM_HDF5
+        namespace
+        {
+            // write the proc owners of a list of mesh entities
+            template< typename T >
+            void
+            save_owners( HDF5 & aFile, const string & aLabel, Cell< T * > & aEntities )
+            {
+                Vector< proc_t > tOwners( aEntities.size() );
+
+                index_t tCount = 0 ;
+                for( T * tEntity : aEntities )
+                {
+                    tOwners( tCount++ ) = tEntity->owner() ;
+                }
+
+                aFile.save_data( aLabel, tOwners );
+            }
+
+//------------------------------------------------------------------------------
+
+            // restore the proc owners of a list of mesh entities
+            template< typename T >
+            void
+            load_owners( HDF5 & aFile, const string & aLabel, Cell< T * > & aEntities )
+            {
+                Vector< proc_t > tOwners ;
+                aFile.load_data( aLabel, tOwners );
+
+                BELFEM_ERROR( tOwners.length() == aEntities.size(),
+                              "partition file does not fit the mesh ( %s )", aLabel.c_str() );
+
+                index_t tCount = 0 ;
+                for( T * tEntity : aEntities )
+                {
+                    tEntity->set_owner( tOwners( tCount++ ) );
+                }
+            }
+        }
+#endif
 //------------------------------------------------------------------------------
 
         Kernel::Kernel( KernelParameters * aKernelParameters, bool aLegacyMode ) :
@@ -65,87 +109,20 @@ namespace belfem
             // causes an error on c4.mesh
             // this->symrcm();
 
+            // check if the submeshes can be read from a file
+            this->open_partition_file() ;
+
             // partition the mesh if in parallel mode
             if ( mNumberOfProcs > 1 && mMyRank == mMesh->master() )
             {
-                if( mParams->auto_partition() )
+                if( mLoadPartitions )
                 {
-                    if ( mParams->selected_blocks().length() > 0 )
-                    {
-                        mMesh->partition( mNumberOfProcs, mParams->selected_blocks());
-
-                        mMesh->unflag_all_elements();
-                        mMesh->unflag_all_facets();
-                        if ( mMesh->ghost_block_ids().length() > 0 )
-                        {
-                            mMesh->partition( mNumberOfProcs, mMesh->ghost_block_ids(), true, false );
-
-                            Cell< mesh::Element * > & tLayer0 = mMesh->block( mMesh->ghost_block_ids()( 0 ) )->elements() ;
-
-                            index_t tNumElemsPerLayer = tLayer0.size();
-
-
-                            Vector< proc_t > tOwners( tNumElemsPerLayer, mNumberOfProcs );
-
-                            // loop over all thin shell sidesets
-                            for ( id_t tID: mMesh->ghost_sideset_ids())
-                            {
-                                // grab facets
-                                Cell< mesh::Facet * > & tFacets = mMesh->sideset( tID )->facets();
-
-                                index_t tCount = 0;
-                                for ( mesh::Facet * tFacet: tFacets )
-                                {
-                                    // get owner
-                                    proc_t tOwner = tLayer0( tCount )->owner();
-                                    tOwners( tCount++ ) = tOwner ;
-
-                                    tFacet->set_owner( tOwner );
-                                    tFacet->master()->set_owner( tOwner );
-                                    tFacet->slave()->set_owner( tOwner );
-                                    tFacet->master()->flag();
-                                    tFacet->slave()->flag();
-                                    tFacet->flag();
-                                }
-                            }
-
-                            // fix ownership of other layers
-                            uint tNumLayers = mMesh->ghost_block_ids().length() ;
-                            for( uint l=1; l<tNumLayers; ++l )
-                            {
-                                Cell< mesh::Element * > & tLayer
-                                    = mMesh->block( mMesh->ghost_block_ids()( l ) )->elements() ;
-                                index_t tCount = 0;
-                                for( mesh::Element * tElement : tLayer )
-                                {
-                                    tElement->set_owner( tOwners( tCount++ ) );
-                                }
-                            }
-
-                            // now we need to fix the ownerships of the original facets
-                            // that describe the thin shell, but are not part of the ghost
-                            // block
-
-                            // grab all facet on mesh
-                            Cell< mesh::Facet * > & tFacets = mMesh->facets();
-
-                            // and now let's make sure that the ownerships are correct
-                            for ( mesh::Facet * tFacet: tFacets )
-                            {
-                                if ( !tFacet->is_flagged())
-                                {
-                                    if ( tFacet->has_master())
-                                    {
-                                        tFacet->set_owner( tFacet->master()->owner());
-                                    }
-                                }
-                            }
-                        }
-                    }
-                    else
-                    {
-                        mMesh->partition( mNumberOfProcs );
-                    }
+                    // restore the ownerships that were computed in an earlier run
+                    this->load_partition_owners() ;
+                }
+                else if( mParams->auto_partition() )
+                {
+                    this->partition_mesh() ;
                 }
 
                 // allocate memory for node table
@@ -363,6 +340,100 @@ namespace belfem
             }
         }
 
+//------------------------------------------------------------------------------
+
+        void
+        Kernel::partition_mesh()
+        {
+            // weight elements by their dofs and the cost of their block
+            if ( mParams->weighted_partition() )
+            {
+                mMesh->set_partition_weights(
+                        max( mParams->num_dofs_per_node() ),
+                        max( mParams->num_dofs_per_edge() ),
+                        mParams->partition_block_costs(),
+                        mParams->partition_block_dofs(),
+                        mParams->balance_partition_dofs() );
+            }
+
+            if ( mParams->selected_blocks().length() > 0 )
+            {
+                mMesh->partition( mNumberOfProcs, mParams->selected_blocks());
+
+                mMesh->unflag_all_elements();
+                mMesh->unflag_all_facets();
+                if ( mMesh->ghost_block_ids().length() > 0 )
+                {
+                    mMesh->partition( mNumberOfProcs, mMesh->ghost_block_ids(), true, false );
+
+                    Cell< mesh::Element * > & tLayer0 = mMesh->block( mMesh->ghost_block_ids()( 0 ) )->elements() ;
+
+                    index_t tNumElemsPerLayer = tLayer0.size();
+
+
+                    Vector< proc_t > tOwners( tNumElemsPerLayer, mNumberOfProcs );
+
+                    // loop over all thin shell sidesets
+                    for ( id_t tID: mMesh->ghost_sideset_ids())
+                    {
+                        // grab facets
+                        Cell< mesh::Facet * > & tFacets = mMesh->sideset( tID )->facets();
+
+                        index_t tCount = 0;
+                        for ( mesh::Facet * tFacet: tFacets )
+                        {
+                            // get owner
+                            proc_t tOwner = tLayer0( tCount )->owner();
+                            tOwners( tCount++ ) = tOwner ;
+
+                            tFacet->set_owner( tOwner );
+                            tFacet->master()->set_owner( tOwner );
+                            tFacet->slave()->set_owner( tOwner );
+                            tFacet->master()->flag();
+                            tFacet->slave()->flag();
+                            tFacet->flag();
+                        }
+                    }
+
+                    // fix ownership of other layers
+                    uint tNumLayers = mMesh->ghost_block_ids().length() ;
+                    for( uint l=1; l<tNumLayers; ++l )
+                    {
+                        Cell< mesh::Element * > & tLayer
+                            = mMesh->block( mMesh->ghost_block_ids()( l ) )->elements() ;
+                        index_t tCount = 0;
+                        for( mesh::Element * tElement : tLayer )
+                        {
+                            tElement->set_owner( tOwners( tCount++ ) );
+                        }
+                    }
+
+                    // now we need to fix the ownerships of the original facets
+                    // that describe the thin shell, but are not part of the ghost
+                    // block
+
+                    // grab all facet on mesh
+                    Cell< mesh::Facet * > & tFacets = mMesh->facets();
+
+                    // and now let's make sure that the ownerships are correct
+                    for ( mesh::Facet * tFacet: tFacets )
+                    {
+                        if ( !tFacet->is_flagged())
+                        {
+                            if ( tFacet->has_master())
+                            {
+                                tFacet->set_owner( tFacet->master()->owner());
+                            }
+                        }
+                    }
+                }
+            }
+            else
+            {
+                mMesh->partition( mNumberOfProcs );
+            }
+        }
+
 //------------------------------------------------------------------------------
 
         void
@@ -375,18 +446,38 @@ namespace belfem
 
                 if ( mMyRank == mMasterRank )
                 {
-                    message( 4, " Distributing Mesh to %u procs...",
-                             ( unsigned int ) mNumberOfProcs );
-
                     // start the timer
                     Timer tTimer;
 
-                    // loop over all procs
-                    for( proc_t p=0; p<mNumberOfProcs; ++p )
+                    if( mLoadPartitions )
                     {
-                        this->send_submesh( mCommTable( p ) );
+                        message( 4, " Reading partitions from %s ...",
+                                 mParams->partition_file().c_str() );
+
+                        // the other procs read their submeshes themselves
+                        this->load_partition_tables() ;
                     }
+                    else
+                    {
+                        message( 4, " Distributing Mesh to %u procs...",
+                                 ( unsigned int ) mNumberOfProcs );
+
+                        if( mPartitionFile != nullptr )
+                        {
+                            this->save_partition_owners() ;
+                        }
 
+                        // loop over all procs
+                        for( proc_t p=0; p<mNumberOfProcs; ++p )
+                        {
+                            this->send_submesh( mCommTable( p ) );
+                        }
+
+                        if( mPartitionFile != nullptr )
+                        {
+                            this->save_partition_tables() ;
+                        }
+                    }
 
                     // merge tables in order to master mesh synch
                     this->merge_facet_and_connector_tables();
@@ -399,12 +490,345 @@ namespace belfem
                 {
                     this->receive_submesh();
                 }
+
+                this->close_partition_file() ;
             }
 
             // tidy up memory
             this->delete_maps();
         }
 
+//------------------------------------------------------------------------------
+
+        void
+        Kernel::open_partition_file()
+        {
+            if( mNumberOfProcs < 2 || mParams->partition_file().size() == 0 )
+            {
+                return ;
+            }
+#ifdef BELFEM_HDF5
+            const string & tPath = mParams->partition_file() ;
+
+            // 0: no file, 1: read partitions, 2: write partitions
+            uint tMode = 0 ;
+
+            if( mMyRank == mMasterRank )
+            {
+                tMode = this->partition_file_fits( tPath ) ? 1 : 2 ;
+
+                send( mCommTable, tMode );
+
+                if( tMode == 2 && file_exists( tPath ) )
+                {
+                    message( 4, " Warning: %s does not fit the mesh and will be recreated.\n",
+                             tPath.c_str() );
+                }
+            }
+            else
+            {
+                receive( mMasterRank, tMode );
+            }
+
+            mLoadPartitions = tMode == 1 ;
+
+            if( mLoadPartitions )
+            {
+                mPartitionFile = new HDF5( tPath, FileMode::OPEN_RDONLY );
+                if( mMyRank != mMasterRank )
+                {
+                    mPartitionFile->select_group( sprint( "Partition_%u", ( unsigned int ) mMyRank ) );
+                    mPartitionRecord = 0 ;
+                }
+            }
+            else if( mMyRank == mMasterRank )
+            {
+                mPartitionFile = new HDF5( tPath, FileMode::NEW );
+            }
+#else
+            message( 4, " Warning: partition file %s ignored, HDF5 is not linked.\n",
+                     mParams->partition_file().c_str() );
+#endif
+        }
+
+//------------------------------------------------------------------------------
+
+        bool
+        Kernel::partition_file_fits( const string & aPath )
+        {
+#ifdef BELFEM_HDF5
+            if( ! file_exists( aPath ) )
+            {
+                return false ;
+            }
+
+            HDF5 tFile( aPath, FileMode::OPEN_RDONLY );
+
+            Vector< uint > tHeader ;
+            tFile.load_data( "Header", tHeader );
+            tFile.close() ;
+
+            Vector< uint > tExpect ;
+            this->partition_header( tExpect );
+
+            if( tHeader.length() != tExpect.length() )
+            {
+                return false ;
+            }
+            for( index_t k=0; k<tExpect.length(); ++k )
+            {
+                if( tHeader( k ) != tExpect( k ) )
+                {
+                    return false ;
+                }
+            }
+            return true ;
+#else
+            return false ;
+#endif
+        }
+
+//------------------------------------------------------------------------------
+
+        void
+        Kernel::partition_header( Vector< uint > & aHeader )
+        {
+            const Vector< id_t > & tBlocks = mParams->selected_blocks() ;
+            Cell< mesh::SideSet * > & tSideSets = mMesh->sidesets() ;
+
+            Cell< mesh::Block * > & tMeshBlocks = mMesh->blocks() ;
+
+            // the weights change the partitioning of the same mesh
+            index_t tNumWeights = mParams->weighted_partition() ?
+                    5 + 6 * tMeshBlocks.size() : 1 ;
+
+            aHeader.set_size( 14 + tBlocks.length() + tSideSets.size() + tNumWeights, 0 );
+            aHeader( 0 ) = mNumberOfProcs ;
+            aHeader( 1 ) = mMasterRank ;
+            aHeader( 2 ) = mMesh->number_of_dimensions() ;
+            aHeader( 3 ) = mMesh->number_of_nodes() ;
+            aHeader( 4 ) = mMesh->number_of_elements() ;
+            aHeader( 5 ) = mMesh->number_of_edges() ;
+            aHeader( 6 ) = mMesh->number_of_faces() ;
+            aHeader( 7 ) = mMesh->number_of_facets() ;
+            aHeader( 8 ) = mMesh->number_of_connectors() ;
+            aHeader( 9 ) = mMesh->vertices().size() ;
+
+            // the counts alone do not detect moved nodes or a renumbering
+            luint tChecksum = mMesh->checksum() ;
+            aHeader( 10 ) = tChecksum & 0xFFFFFFFF ;
+            aHeader( 11 ) = tChecksum >> 32 ;
+
+            index_t tCount = 12 ;
+
+            aHeader( tCount++ ) = tBlocks.length() ;
+            for( id_t tID : tBlocks )
+            {
+                aHeader( tCount++ ) = tID ;
+            }
+
+            aHeader( tCount++ ) = tSideSets.size() ;
+            for( mesh::SideSet * tSideSet : tSideSets )
+            {
+                aHeader( tCount++ ) = tSideSet->id() ;
+            }
+
+            if( ! mParams->weighted_partition() )
+            {
+                return ;
+            }
+
+            const Map< id_t, real > & tCosts = mParams->partition_block_costs() ;
+            const Map< id_t, Vector< uint > > & tDofs = mParams->partition_block_dofs() ;
+
+            aHeader( tCount++ ) = 1 ;
+            aHeader( tCount++ ) = mParams->balance_partition_dofs() ? 1 : 0 ;
+            aHeader( tCount++ ) = max( mParams->num_dofs_per_node() ) ;
+            aHeader( tCount++ ) = max( mParams->num_dofs_per_edge() ) ;
+            aHeader( tCount++ ) = tMeshBlocks.size() ;
+
+            for( mesh::Block * tBlock : tMeshBlocks )
+            {
+                const id_t tID = tBlock->id() ;
+                aHeader( tCount++ ) = tID ;
+
+                // the bits of the cost, so that any change is detected
+                real tCost = tCosts.key_exists( tID ) ? tCosts( tID ) : 1.0 ;
+                luint tBits ;
+                std::memcpy( & tBits, & tCost, sizeof( real ) );
+                aHeader( tCount++ ) = tBits & 0xFFFFFFFF ;
+                aHeader( tCount++ ) = tBits >> 32 ;
+
+                // dofs per node, edge and face, zero for the kernel default
+                if( tDofs.key_exists( tID ) )
+                {
+                    for( uint k=0; k<3; ++k )
+                    {
+                        aHeader( tCount++ ) = tDofs( tID )( k );
+                    }
+                }
+                else
+                {
+                    tCount += 3 ;
+                }
+            }
+        }
+
+//------------------------------------------------------------------------------
+
+        void
+        Kernel::save_partition_owners()
+        {
+#ifdef BELFEM_HDF5
+            Vector< uint > tHeader ;
+            this->partition_header( tHeader );
+            mPartitionFile->save_data( "Header", tHeader );
+
+            mPartitionFile->create_group( "Owners" );
+            save_owners( *mPartitionFile, "NodeOwner", mMesh->nodes() );
+            save_owners( *mPartitionFile, "ElementOwner", mMesh->elements() );
+            save_owners( *mPartitionFile, "EdgeOwner", mMesh->edges() );
+            save_owners( *mPartitionFile, "FaceOwner", mMesh->faces() );
+            save_owners( *mPartitionFile, "FacetOwner", mMesh->facets() );
+            save_owners( *mPartitionFile, "ConnectorOwner", mMesh->connectors() );
+            save_owners( *mPartitionFile, "VertexOwner", mMesh->vertices() );
+            mPartitionFile->close_active_group() ;
+#endif
+        }
+
+//------------------------------------------------------------------------------
+
+        void
+        Kernel::load_partition_owners()
+        {
+#ifdef BELFEM_HDF5
+            mPartitionFile->select_group( "Owners" );
+            load_owners( *mPartitionFile, "NodeOwner", mMesh->nodes() );
+            load_owners( *mPartitionFile, "ElementOwner", mMesh->elements() );
+            load_owners( *mPartitionFile, "EdgeOwner", mMesh->edges() );
+            load_owners( *mPartitionFile, "FaceOwner", mMesh->faces() );
+            load_owners( *mPartitionFile, "FacetOwner", mMesh->facets() );
+            load_owners( *mPartitionFile, "ConnectorOwner", mMesh->connectors() );
+            load_owners( *mPartitionFile, "VertexOwner", mMesh->vertices() );
+            mPartitionFile->close_active_group() ;
+
+            if( mParams->auto_partition() )
+            {
+                mMesh->set_number_of_partitions( mNumberOfProcs );
+            }
+#endif
+        }
+
+//------------------------------------------------------------------------------
+
+        void
+        Kernel::save_partition_tables()
+        {
+#ifdef BELFEM_HDF5
+            mPartitionFile->create_group( "Tables" );
+            for( proc_t p=0; p<mNumberOfProcs; ++p )
+            {
+                mPartitionFile->save_data( sprint( "NodeTable_%u", ( unsigned int ) p ), mNodeTable( p ) );
+                mPartitionFile->save_data( sprint( "ElementTable_%u", ( unsigned int ) p ), mElementTable( p ) );
+                mPartitionFile->save_data( sprint( "EdgeTable_%u", ( unsigned int ) p ), mEdgeTable( p ) );
+                mPartitionFile->save_data( sprint( "FaceTable_%u", ( unsigned int ) p ), mFaceTable( p ) );
+                mPartitionFile->save_data( sprint( "FacetTable_%u", ( unsigned int ) p ), mFacetTable( p ) );
+                mPartitionFile->save_data( sprint( "ConnectorTable_%u", ( unsigned int ) p ), mConnectorTable( p ) );
+            }
+            mPartitionFile->close_active_group() ;
+#endif
+        }
+
+//------------------------------------------------------------------------------
+
+        void
+        Kernel::load_partition_tables()
+        {
+#ifdef BELFEM_HDF5
+            mPartitionFile->select_group( "Tables" );
+            for( proc_t p=0; p<mNumberOfProcs; ++p )
+            {
+                mPartitionFile->load_data( sprint( "NodeTable_%u", ( unsigned int ) p ), mNodeTable( p ) );
+                mPartitionFile->load_data( sprint( "ElementTable_%u", ( unsigned int ) p ), mElementTable( p ) );
+                mPartitionFile->load_data( sprint( "EdgeTable_%u", ( unsigned int ) p ), mEdgeTable( p ) );
+                mPartitionFile->load_data( sprint( "FaceTable_%u", ( unsigned int ) p ), mFaceTable( p ) );
+                mPartitionFile->load_data( sprint( "FacetTable_%u", ( unsigned int ) p ), mFacetTable( p ) );
+                mPartitionFile->load_data( sprint( "ConnectorTable_%u", ( unsigned int ) p ), mConnectorTable( p ) );
+            }
+            mPartitionFile->close_active_group() ;
+#endif
+        }
+
+//------------------------------------------------------------------------------
+
+        void
+        Kernel::close_partition_file()
+        {
+            if( mPartitionFile != nullptr )
+            {
+                mPartitionFile->close() ;
+                delete mPartitionFile ;
+                mPartitionFile = nullptr ;
+            }
+        }
+
+//------------------------------------------------------------------------------
+
+        template< typename T >
+        void
+        Kernel::send_submesh_data( const proc_t aTarget, T & aData )
+        {
+#ifdef BELFEM_HDF5
+            if( mPartitionFile != nullptr )
+            {
+                mPartitionFile->save_data( sprint( "Record_%u", mPartitionRecord++ ), aData );
+            }
+#endif
+            send( aTarget, aData );
+        }
+
+//------------------------------------------------------------------------------
+
+        template< typename T >
+        void
+        Kernel::receive_submesh_data( T & aData )
+        {
+#ifdef BELFEM_HDF5
+            if( mPartitionFile != nullptr )
+            {
+                mPartitionFile->load_data( sprint( "Record_%u", mPartitionRecord++ ), aData );
+                return ;
+            }
+#endif
+            receive( mMasterRank, aData );
+        }
+
+//------------------------------------------------------------------------------
+
+        template< typename T >
+        void
+        Kernel::broadcast_submesh_data( T & aData )
+        {
+#ifdef BELFEM_HDF5
+            if( mPartitionFile != nullptr )
+            {
+                const string tLabel = sprint( "Record_%u", mPartitionRecord++ );
+
+                if( mMyRank == mMasterRank )
+                {
+                    broadcast( mMasterRank, aData );
+                    mPartitionFile->save_data( tLabel, aData );
+                }
+                else
+                {
+                    mPartitionFile->load_data( tLabel, aData );
+                }
+                return ;
+            }
+#endif
+            broadcast( mMasterRank, aData );
+        }
+
 //------------------------------------------------------------------------------
 
         void
@@ -415,6 +839,15 @@ namespace belfem
             BELFEM_ASSERT( mMyRank == mMasterRank,
                            "send_submesh() must only be called by maste proc only" );
 
+#ifdef BELFEM_HDF5
+            // each proc gets its own group in the partition file
+            if( mPartitionFile != nullptr )
+            {
+                mPartitionFile->create_group( sprint( "Partition_%u", ( unsigned int ) aTarget ) );
+                mPartitionRecord = 0 ;
+            }
+#endif
+
             // get ref to all elements on mesh
             Cell< mesh::Element * > & tElements = mMesh->elements();
             Cell< mesh::Facet * > & tFacets = mMesh->facets();
@@ -574,7 +1007,7 @@ namespace belfem
             tNumEntities( 7 ) = mMesh->vertices().size() ;
 
 
-            send( aTarget, tNumEntities );
+            this->send_submesh_data( aTarget, tNumEntities );
 
 
             this->send_nodes( aTarget );
@@ -626,11 +1059,34 @@ namespace belfem
                 Vector< id_t > tNedelecSideSets( mMesh->nedelec_sidesets());
 
                 // send nedelec data
-                send( aTarget, tNedelecBlocks );
-                send( aTarget, tNedelecSideSets );
+                this->send_submesh_data( aTarget, tNedelecBlocks );
+                this->send_submesh_data( aTarget, tNedelecSideSets );
+            }
+
+            // ghost sidesets of thin shells
+            Vector< id_t > tGhostBlocks( mMesh->ghost_block_ids() );
+            Vector< id_t > tGhostSideSets( mMesh->ghost_sideset_ids() );
+
+            this->send_submesh_data( aTarget, tGhostBlocks );
+            this->send_submesh_data( aTarget, tGhostSideSets );
+
+            if( tGhostSideSets.length() > 0 )
+            {
+                Vector< id_t > tFacetIDs ;
+                Matrix< id_t > tTapeFacetTable ;
+
+                mMesh->collect_ghost_facets( aTarget, tFacetIDs, tTapeFacetTable );
+
+                this->send_submesh_data( aTarget, tFacetIDs );
+                this->send_submesh_data( aTarget, tTapeFacetTable );
             }
 
-            mMesh->distribute_ghost_sidesets( aTarget, mMyRank );
+#ifdef BELFEM_HDF5
+            if( mPartitionFile != nullptr )
+            {
+                mPartitionFile->close_active_group() ;
+            }
+#endif
         }
 
 //------------------------------------------------------------------------------
@@ -640,7 +1096,7 @@ namespace belfem
         {
             // receive dimension
             Vector< index_t > tNumEntities( 8 );
-            receive( mMasterRank, tNumEntities );
+            this->receive_submesh_data( tNumEntities );
 
             uint tDimension = tNumEntities( 0 );
 
@@ -677,8 +1133,8 @@ namespace belfem
 
             if ( tNumEntities( 3 ) > 0 )
             {
-                receive( mMasterRank, tNedelecBlocks );
-                receive( mMasterRank, tNedelecSideSets );
+                this->receive_submesh_data( tNedelecBlocks );
+                this->receive_submesh_data( tNedelecSideSets );
             }
 
             mSubMesh->set_number_of_partitions( mNumberOfProcs ) ;
@@ -697,7 +1153,23 @@ namespace belfem
 
             if( tNumEntities( 4 ) > 0 ) mSubMesh->finalize_faces() ;
 
-            mSubMesh->distribute_ghost_sidesets( mMyRank, this->master() );
+            // ghost sidesets of thin shells
+            Vector< id_t > tGhostBlockIDs ;
+            Vector< id_t > tGhostSideSetIDs ;
+            Vector< id_t > tFacetIDs ;
+            Matrix< id_t > tTapeFacetTable ;
+
+            this->receive_submesh_data( tGhostBlockIDs );
+            this->receive_submesh_data( tGhostSideSetIDs );
+
+            if( tGhostSideSetIDs.length() > 0 )
+            {
+                this->receive_submesh_data( tFacetIDs );
+                this->receive_submesh_data( tTapeFacetTable );
+            }
+
+            mSubMesh->set_ghost_facets( tGhostBlockIDs, tGhostSideSetIDs,
+                                        tFacetIDs, tTapeFacetTable );
 
         }
 
@@ -790,11 +1262,11 @@ namespace belfem
 
 
             // send data
-            send( aTarget, tIDs );
-            send( aTarget, tOwners );
-            send( aTarget, tX );
-            send( aTarget, tY );
-            send( aTarget, tZ );
+            this->send_submesh_data( aTarget, tIDs );
+            this->send_submesh_data( aTarget, tOwners );
+            this->send_submesh_data( aTarget, tX );
+            this->send_submesh_data( aTarget, tY );
+            this->send_submesh_data( aTarget, tZ );
 
             /*for( uint s=0; s<2; ++s )
             {
@@ -866,7 +1338,7 @@ namespace belfem
                     }
                 }
 
-                send( aTarget, tIDs );
+                this->send_submesh_data( aTarget, tIDs );
             }
         }
 
@@ -880,7 +1352,7 @@ namespace belfem
             index_t tNumberOfEdges = tEdges.size() ;
 
             // send number of edges to other procs
-            broadcast( mMasterRank, tNumberOfEdges );
+            this->broadcast_submesh_data( tNumberOfEdges );
 
             if (  mMesh->edges_exist() )
             {
@@ -974,11 +1446,11 @@ namespace belfem
                 }
 
                 // send data to target
-                send( aTarget, tEdgeIDs );
-                send( aTarget, tEdgeOwners );
-                send( aTarget, tNumNodes );
-                send( aTarget, tNodeIDs );
-                send( aTarget, tEdgesPerElements );
+                this->send_submesh_data( aTarget, tEdgeIDs );
+                this->send_submesh_data( aTarget, tEdgeOwners );
+                this->send_submesh_data( aTarget, tNumNodes );
+                this->send_submesh_data( aTarget, tNodeIDs );
+                this->send_submesh_data( aTarget, tEdgesPerElements );
 
             }
         }
@@ -990,29 +1462,29 @@ namespace belfem
         {
             // check if edges exist
             index_t tNumberOfEdges = 0 ;
-            broadcast( mMasterRank, tNumberOfEdges );
+            this->broadcast_submesh_data( tNumberOfEdges );
 
             if( tNumberOfEdges > 0 )
             {
                 // edge IDs
                 Vector< id_t > tEdgeIDs ;
-                receive( mMasterRank, tEdgeIDs );
+                this->receive_submesh_data( tEdgeIDs );
 
                 // edge owners
                 Vector< proc_t > tEdgeOwners ;
-                receive( mMasterRank, tEdgeOwners );
+                this->receive_submesh_data( tEdgeOwners );
 
                 // number of nodes per edge
                 Vector< uint > tNumNodes ;
-                receive( mMasterRank, tNumNodes );
+                this->receive_submesh_data( tNumNodes );
 
                 // node IDs
                 Vector< id_t > tNodeIDs ;
-                receive( mMasterRank, tNodeIDs );
+                this->receive_submesh_data( tNodeIDs );
 
                 // edge ids per element
                 Vector< id_t > tEdgesPerElements ;
-                receive( mMasterRank, tEdgesPerElements );
+                this->receive_submesh_data( tEdgesPerElements );
 
                 // initialize counters
                 index_t tCount = 0 ;
@@ -1088,7 +1560,7 @@ namespace belfem
             index_t tNumberOfFaces = tFaces.size();
 
             // send number of edges to other procs
-            broadcast( mMasterRank, tNumberOfFaces );
+            this->broadcast_submesh_data( tNumberOfFaces );
 
             if ( mMesh->faces_exist() )
             {
@@ -1128,8 +1600,8 @@ namespace belfem
                         }
                     }
 
-                    send( aTarget, tFaceIDs );
-                    send( aTarget, tMasterIDs );
+                    this->send_submesh_data( aTarget, tFaceIDs );
+                    this->send_submesh_data( aTarget, tMasterIDs );
 
                 }
                 else if( mMesh->number_of_dimensions() == 3 )
@@ -1165,11 +1637,11 @@ namespace belfem
                         }
                     }
 
-                    send( aTarget, tFaceIDs );
-                    send( aTarget, tMasterIDs );
-                    send( aTarget, tIndexOnMaster );
-                    send( aTarget, tSlaveIDs );
-                    send( aTarget, tIndexOnSlave );
+                    this->send_submesh_data( aTarget, tFaceIDs );
+                    this->send_submesh_data( aTarget, tMasterIDs );
+                    this->send_submesh_data( aTarget, tIndexOnMaster );
+                    this->send_submesh_data( aTarget, tSlaveIDs );
+                    this->send_submesh_data( aTarget, tIndexOnSlave );
                 }
             }
         }
@@ -1181,17 +1653,17 @@ namespace belfem
         {
             // check if edges exist
             index_t tNumberOfFaces = 0 ;
-            broadcast( mMasterRank, tNumberOfFaces );
+            this->broadcast_submesh_data( tNumberOfFaces );
 
             if( tNumberOfFaces > 0 )
             {
                 Cell< mesh::Face * > & tFaces = mSubMesh->faces();
 
                 Vector< id_t > tFaceIDs ;
-                receive( mMasterRank, tFaceIDs );
+                this->receive_submesh_data( tFaceIDs );
 
                 Vector< id_t > tMasterIDs ;
-                receive( mMasterRank, tMasterIDs );
+                this->receive_submesh_data( tMasterIDs );
 
                 // get the number of faces
                 tNumberOfFaces = tFaceIDs.length() ;
@@ -1227,13 +1699,13 @@ namespace belfem
                 else if( mMesh->number_of_dimensions() == 3 )
                 {
                     Vector< uint > tIndexOnMaster ;
-                    receive( mMasterRank, tIndexOnMaster );
+                    this->receive_submesh_data( tIndexOnMaster );
 
                     Vector< id_t > tSlaveIDs ;
-                    receive( mMasterRank, tSlaveIDs );
+                    this->receive_submesh_data( tSlaveIDs );
 
                     Vector< uint > tIndexOnSlave ;
-                    receive( mMasterRank, tIndexOnSlave );
+                    this->receive_submesh_data( tIndexOnSlave );
 
                     // create faces
                     for( index_t f=0; f<tNumberOfFaces; ++f )
@@ -1293,11 +1765,11 @@ namespace belfem
             Cell< mesh::Node    * > & tNodes = mSubMesh->nodes();
 
             // get number of nodes
-            receive( mMasterRank, tIDs );
-            receive( mMasterRank, tOwners );
-            receive( mMasterRank, tX );
-            receive( mMasterRank, tY );
-            receive( mMasterRank, tZ );
+            this->receive_submesh_data( tIDs );
+            this->receive_submesh_data( tOwners );
+            this->receive_submesh_data( tX );
+            this->receive_submesh_data( tY );
+            this->receive_submesh_data( tZ );
             //receive( mMasterRank, mSubMesh->node_cut_table() );
             //receive( mMasterRank, mSubMesh->node_tape_table() );
 
@@ -1320,7 +1792,7 @@ namespace belfem
                 }
 
                 // receive duplicates
-                receive( mMasterRank, tIDs );
+                this->receive_submesh_data( tIDs );
                 index_t tCount = 0;
                 for ( mesh::Node * tNode: tNodes )
                 {
@@ -1347,7 +1819,7 @@ namespace belfem
             uint tNumBlocks = mMesh->number_of_blocks();
 
             // send number of blocks
-            send( aTarget, tNumBlocks );
+            this->send_submesh_data( aTarget, tNumBlocks );
 
             Cell< mesh::Block * > & tBlocks = mMesh->blocks();
 
@@ -1369,7 +1841,7 @@ namespace belfem
                 tAllElementCount += tElementCount ;
 
                 // send number of elements
-                send( aTarget, tElementCount );
+                this->send_submesh_data( aTarget, tElementCount );
 
                 if( tElementCount > 0 )
                 {
@@ -1407,26 +1879,26 @@ namespace belfem
 
                     // send block id
                     uint tID = tBlocks( b )->id();
-                    send( aTarget, tID );
+                    this->send_submesh_data( aTarget, tID );
 
                     // send element type
                     int tType = static_cast< int >( tElementType );
-                    send( aTarget, tType );
+                    this->send_submesh_data( aTarget, tType );
 
                     // send IDs
-                    send( aTarget, tIDs );
+                    this->send_submesh_data( aTarget, tIDs );
 
                     // send Geometry tags
-                    send( aTarget, tGeometryTags );
+                    this->send_submesh_data( aTarget, tGeometryTags );
 
                     // send physical tags
-                    send( aTarget, tPhysicalTags );
+                    this->send_submesh_data( aTarget, tPhysicalTags );
 
                     // send Owners
-                    send( aTarget, tOwners );
+                    this->send_submesh_data( aTarget, tOwners );
 
                     // send node ids
-                    send( aTarget, tNodes );
+                    this->send_submesh_data( aTarget, tNodes );
                 }
             }
 
@@ -1464,7 +1936,7 @@ namespace belfem
             }
 
             // send number of vertices
-            send( aTarget, tVertexCount );
+            this->send_submesh_data( aTarget, tVertexCount );
 
             if ( tVertexCount > 0 )
             {
@@ -1492,19 +1964,19 @@ namespace belfem
                 }
 
                 // send IDs
-                send( aTarget, tIDs );
+                this->send_submesh_data( aTarget, tIDs );
 
                 // send Geometry tags
-                send( aTarget, tGeometryTags );
+                this->send_submesh_data( aTarget, tGeometryTags );
 
                 // send physical tags
-                send( aTarget, tPhysicalTags );
+                this->send_submesh_data( aTarget, tPhysicalTags );
 
                 // send Owners
-                send( aTarget, tOwners );
+                this->send_submesh_data( aTarget, tOwners );
 
                 // send node ids
-                send( aTarget, tNodes );
+                this->send_submesh_data( aTarget, tNodes );
             }
         }
 
@@ -1518,7 +1990,7 @@ namespace belfem
 
             // get number of blocks
             uint tNumBlocks = 1;
-            receive( mMasterRank, tNumBlocks );
+            this->receive_submesh_data( tNumBlocks );
 
             tBlocks.set_size( tNumBlocks, nullptr );
 
@@ -1532,17 +2004,17 @@ namespace belfem
             {
                 // get number of elements
                 index_t tNumberOfElements = 0;
-                receive( mMasterRank, tNumberOfElements );
+                this->receive_submesh_data( tNumberOfElements );
 
                 if( tNumberOfElements > 0 )
                 {
                     // get id
                     uint tID = 0;
-                    receive( mMasterRank, tID );
+                    this->receive_submesh_data( tID );
 
                     // get block type
                     int tType = 0 ;
-                    receive( mMasterRank, tType );
+                    this->receive_submesh_data( tType );
                     ElementType tElementType = static_cast< ElementType >( tType );
 
                     // number of nodes per element
@@ -1550,23 +2022,23 @@ namespace belfem
 
                     // Element IDs
                     Vector<id_t> tIDs;
-                    receive( mMasterRank, tIDs );
+                    this->receive_submesh_data( tIDs );
 
                     // Geometry Tags
                     Vector<uint> tGeometryTags;
-                    receive( mMasterRank, tGeometryTags );
+                    this->receive_submesh_data( tGeometryTags );
 
                     // Physical Tags
                     Vector<uint> tPhysicalTags;
-                    receive( mMasterRank, tPhysicalTags );
+                    this->receive_submesh_data( tPhysicalTags );
 
                     // owners
                     Vector<proc_t> tOwners;
-                    receive( mMasterRank, tOwners );
+                    this->receive_submesh_data( tOwners );
 
                     // Node IDs
                     Vector<id_t> tNodes;
-                    receive( mMasterRank, tNodes );
+                    this->receive_submesh_data( tNodes );
 
                     mesh::Block * tBlock = new mesh::Block( tID, tNumberOfElements );
 
@@ -1623,7 +2095,7 @@ namespace belfem
 
             // get number of elements
             index_t tNumberOfVertices = 0;
-            receive( mMasterRank, tNumberOfVertices );
+            this->receive_submesh_data( tNumberOfVertices );
 
             if( tNumberOfVertices > 0 )
             {
@@ -1633,23 +2105,23 @@ namespace belfem
 
                 // Element IDs
                 Vector<id_t> tIDs;
-                receive( mMasterRank, tIDs );
+                this->receive_submesh_data( tIDs );
 
                 // Geometry Tags
                 Vector<uint> tGeometryTags;
-                receive( mMasterRank, tGeometryTags );
+                this->receive_submesh_data( tGeometryTags );
 
                 // Physical Tags
                 Vector<uint> tPhysicalTags;
-                receive( mMasterRank, tPhysicalTags );
+                this->receive_submesh_data( tPhysicalTags );
 
                 // owners
                 Vector<proc_t> tOwners;
-                receive( mMasterRank, tOwners );
+                this->receive_submesh_data( tOwners );
 
                 // Node IDs
                 Vector<id_t> tNodes;
-                receive( mMasterRank, tNodes );
+                this->receive_submesh_data( tNodes );
 
                 Cell< mesh::Element * > & tVertices = mSubMesh->vertices();
 
@@ -1686,7 +2158,7 @@ namespace belfem
                                 mMesh->number_of_sidesets() ;
 
             // send number of blocks
-            send( aTarget, tNumSideSets );
+            this->send_submesh_data( aTarget, tNumSideSets );
 
 
             Cell< mesh::SideSet * > & tSideSets =
@@ -1875,13 +2347,13 @@ namespace belfem
                 }
 
                 // send counter
-                send( aTarget, tCount );
+                this->send_submesh_data( aTarget, tCount );
 
                 if( tCount > 0 )
                 {
                     // send the ID of this sideset
                     id_t tID = tSideSets( s )->id();
-                    send( aTarget, tID );
+                    this->send_submesh_data( aTarget, tID );
 
                     // initialize id vectors
                     Vector<id_t> tIDs( tCount );
@@ -1893,10 +2365,10 @@ namespace belfem
                     }
 
                     // communicate IDs
-                    send( aTarget, tIDs );
+                    this->send_submesh_data( aTarget, tIDs );
 
                     // communicate tags
-                    send( aTarget, tTags );
+                    this->send_submesh_data( aTarget, tTags );
 
                     if( aConnectorSwitch )
                     {
@@ -1905,21 +2377,21 @@ namespace belfem
                         {
                             tIDs( k ) = tFacets( k )->node( 0 )->id() ;
                         }
-                        send( aTarget, tIDs );
+                        this->send_submesh_data( aTarget, tIDs );
 
                         // collect IDs from second node
                         for ( index_t k = 0; k < tCount; ++k )
                         {
                             tIDs( k ) = tFacets( k )->node( 1 )->id() ;
                         }
-                        send( aTarget, tIDs );
+                        this->send_submesh_data( aTarget, tIDs );
 
                         // collect block IDS
                         for ( index_t k = 0; k < tCount; ++k )
                         {
                             tIDs( k ) = tFacets( k )->element()->block_id() ;
                         }
-                        send( aTarget, tIDs );
+                        this->send_submesh_data( aTarget, tIDs );
                     }
                     else
                     {
@@ -1929,7 +2401,7 @@ namespace belfem
                             tIDs( k ) = tFacets( k )->master()->id();
                         }
 
-                        send( aTarget, tIDs );
+                        this->send_submesh_data( aTarget, tIDs );
 
                         // collect slave IDs
                         for ( index_t k = 0; k < tCount; ++k )
@@ -1944,7 +2416,7 @@ namespace belfem
                             }
                         }
 
-                        send( aTarget, tIDs );
+                        this->send_submesh_data( aTarget, tIDs );
 
                         Vector< uint > tFacetIndices( tCount );
 
@@ -1953,14 +2425,14 @@ namespace belfem
                         {
                             tFacetIndices( k ) = tFacets( k )->master_index();
                         }
-                        send( aTarget, tFacetIndices );
+                        this->send_submesh_data( aTarget, tFacetIndices );
 
                         // collect slave indices
                         for ( index_t k = 0; k < tCount; ++k )
                         {
                             tFacetIndices( k ) = tFacets( k )->slave_index();
                         }
-                        send( aTarget, tFacetIndices );
+                        this->send_submesh_data( aTarget, tFacetIndices );
 
                         // collect node ids
                         tIDs.set_size( tNodeCount );
@@ -1974,7 +2446,7 @@ namespace belfem
                                 tIDs( tNodeCount++ ) = tElement->node( i )->id() ;
                             }
                         }
-                        send( aTarget, tIDs );
+                        this->send_submesh_data( aTarget, tIDs );
 
                     }
                 }
@@ -1983,10 +2455,10 @@ namespace belfem
             if( ! aConnectorSwitch )
             {
 
-                send( aTarget, tElementsWithEdges );
-                send( aTarget, tEdgeIDs );
-                send( aTarget, tElementsWithFaces );
-                send( aTarget, tFaceIDs );
+                this->send_submesh_data( aTarget, tElementsWithEdges );
+                this->send_submesh_data( aTarget, tEdgeIDs );
+                this->send_submesh_data( aTarget, tElementsWithFaces );
+                this->send_submesh_data( aTarget, tFaceIDs );
             }
         }
 
@@ -2001,7 +2473,7 @@ namespace belfem
 
             // get number of blocks
             uint tNumSideSets = 0;
-            receive( mMasterRank, tNumSideSets );
+            this->receive_submesh_data( tNumSideSets );
             tSideSets.set_size( tNumSideSets, nullptr );
 
             // sideset counter
@@ -2015,21 +2487,21 @@ namespace belfem
             {
                 // get number of facets
                 index_t tNumFacets = 0;
-                receive( mMasterRank, tNumFacets );
+                this->receive_submesh_data( tNumFacets );
 
                 if( tNumFacets > 0 )
                 {
                     // get the ID of this sideset
                     id_t tID;
-                    receive( mMasterRank, tID );
+                    this->receive_submesh_data( tID );
 
                     // IDs for the elements
                     Vector< id_t > tIDs;
-                    receive( mMasterRank, tIDs );
+                    this->receive_submesh_data( tIDs );
 
                     // id for tags
                     Matrix< uint > tTags ;
-                    receive( mMasterRank, tTags );
+                    this->receive_submesh_data( tTags );
 
                     // Master IDs  or first node ID
                     Vector< id_t > tMasteIDs;
@@ -2061,21 +2533,21 @@ namespace belfem
                     // node ids
                     Vector< id_t > tNodeIDs ;
 
-                    receive( mMasterRank, tMasteIDs );
+                    this->receive_submesh_data( tMasteIDs );
 
-                    receive( mMasterRank, tSlaveIDs );
+                    this->receive_submesh_data( tSlaveIDs );
 
                     if( aConnectorSwitch )
                     {
-                        receive( mMasterRank, tBlockIDs );
+                        this->receive_submesh_data( tBlockIDs );
                     }
                     else
                     {
-                        receive( mMasterRank, tMasterIndices );
+                        this->receive_submesh_data( tMasterIndices );
 
-                        receive( mMasterRank, tSlaveIndices );
+                        this->receive_submesh_data( tSlaveIndices );
 
-                        receive( mMasterRank, tNodeIDs );
+                        this->receive_submesh_data( tNodeIDs );
                     }
 
                     // create a new sideset
@@ -2200,10 +2672,10 @@ namespace belfem
                 Vector< id_t > tElementsWithEdges ;
                 Vector< id_t > tElementsWithFaces ;
 
-                receive( mMasterRank, tElementsWithEdges );
-                receive( mMasterRank, tEdgeIDs );
-                receive( mMasterRank, tElementsWithFaces );
-                receive( mMasterRank, tFaceIDs );
+                this->receive_submesh_data( tElementsWithEdges );
+                this->receive_submesh_data( tEdgeIDs );
+                this->receive_submesh_data( tElementsWithFaces );
+                this->receive_submesh_data( tFaceIDs );
 
                 // initialize counter
                 index_t tCount = 0 ;
@@ -28,6 +28,8 @@
 
 namespace belfem
 {
+    class HDF5 ;
+
 //------------------------------------------------------------------------------
 
     namespace fem
@@ -93,6 +95,15 @@ namespace belfem
             Cell< Vector< index_t > > mFacetTable;
             Cell< Vector< index_t > > mConnectorTable;
 
+            // cached submeshes, see KernelParameters::set_partition_file
+            HDF5 * mPartitionFile = nullptr ;
+
+            // flag telling if the submeshes are read from the partition file
+            bool mLoadPartitions = false ;
+
+            // counter for the records of a submesh in the partition file
+            uint mPartitionRecord = 0 ;
+
 //------------------------------------------------------------------------------
         public:
 //------------------------------------------------------------------------------
@@ -263,6 +274,17 @@ namespace belfem
              void
              claim_parameter_ownership( const bool aFlag = true );
 
+//------------------------------------------------------------------------------
+
+            /**
+             * numbers that identify the mesh, the selected blocks and
+             * sidesets, the number of procs and the partition weights.
+             * A partition file is only used if its header is identical.
+             * Master only.
+             */
+            void
+            partition_header( Vector< uint > & aHeader );
+
 
 //------------------------------------------------------------------------------
         private:
@@ -284,6 +306,14 @@ namespace belfem
             void
             symrcm();
 
+//------------------------------------------------------------------------------
+
+            /**
+             * run metis on the master mesh and fix the thin shell ownerships
+             */
+            void
+            partition_mesh();
+
 //------------------------------------------------------------------------------
 
             /**
@@ -292,6 +322,69 @@ namespace belfem
             void
             distribute_mesh();
 
+//------------------------------------------------------------------------------
+
+            /**
+             * decide if the partitions are read from or written to
+             * the partition file and open it
+             */
+            void
+            open_partition_file();
+
+//------------------------------------------------------------------------------
+
+            bool
+            partition_file_fits( const string & aPath );
+
+//------------------------------------------------------------------------------
+
+            void
+            save_partition_owners();
+
+//------------------------------------------------------------------------------
+
+            void
+            load_partition_owners();
+
+//------------------------------------------------------------------------------
+
+            void
+            save_partition_tables();
+
+//------------------------------------------------------------------------------
+
+            void
+            load_partition_tables();
+
+//------------------------------------------------------------------------------
+
+            void
+            close_partition_file();
+
+//------------------------------------------------------------------------------
+
+            /**
+             * send data to a submesh and record it in the partition file
+             */
+            template< typename T >
+            void
+            send_submesh_data( const proc_t aTarget, T & aData );
+
+//------------------------------------------------------------------------------
+
+            /**
+             * receive data from the master or read it from the partition file
+             */
+            template< typename T >
+            void
+            receive_submesh_data( T & aData );
+
+//------------------------------------------------------------------------------
+
+            template< typename T >
+            void
+            broadcast_submesh_data( T & aData );
+
 //------------------------------------------------------------------------------
 
             void
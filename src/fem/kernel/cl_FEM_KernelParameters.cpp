@@ -258,6 +258,69 @@ namespace belfem
             mAutoPartition = aFlag ;
         }
 
+//------------------------------------------------------------------------------
+
+        void
+        KernelParameters::set_partition_file( const string & aPath )
+        {
+            mPartitionFile = aPath ;
+        }
+
+//------------------------------------------------------------------------------
+
+        void
+        KernelParameters::set_partition_weights(
+                const Vector< id_t > & aBlockIDs,
+                const Vector< real > & aBlockCosts,
+                const bool aBalanceDofs )
+        {
+            BELFEM_ERROR( aBlockIDs.length() == aBlockCosts.length(),
+                         "Length of block IDs and costs does not match ( %u vs %u )",
+                         ( unsigned int ) aBlockIDs.length(),
+                         ( unsigned int ) aBlockCosts.length() );
+
+            mPartitionBlockCosts.clear() ;
+
+            for( uint b=0; b<aBlockIDs.length(); ++b )
+            {
+                BELFEM_ERROR( aBlockCosts( b ) > 0.0,
+                             "Partition cost of block %lu must be positive",
+                             ( long unsigned int ) aBlockIDs( b ) );
+
+                mPartitionBlockCosts[ aBlockIDs( b ) ] = aBlockCosts( b );
+            }
+
+            mWeightedPartition = true ;
+            mBalancePartitionDofs = aBalanceDofs ;
+        }
+
+//------------------------------------------------------------------------------
+
+        void
+        KernelParameters::set_partition_dofs(
+                const Vector< id_t > & aBlockIDs,
+                const Vector< uint > & aDofsPerNode,
+                const Vector< uint > & aDofsPerEdge,
+                const Vector< uint > & aDofsPerFace )
+        {
+            BELFEM_ERROR( aBlockIDs.length() == aDofsPerNode.length()
+                         && aBlockIDs.length() == aDofsPerEdge.length()
+                         && aBlockIDs.length() == aDofsPerFace.length(),
+                         "Length of block IDs and dofs does not match" );
+
+            mPartitionBlockDofs.clear() ;
+
+            for( uint b=0; b<aBlockIDs.length(); ++b )
+            {
+                Vector< uint > tDofs( 3 );
+                tDofs( 0 ) = aDofsPerNode( b );
+                tDofs( 1 ) = aDofsPerEdge( b );
+                tDofs( 2 ) = aDofsPerFace( b );
+
+                mPartitionBlockDofs[ aBlockIDs( b ) ] = tDofs ;
+            }
+        }
+
 //------------------------------------------------------------------------------
     }
 }
@@ -53,6 +53,17 @@ namespace belfem
             // flag telling if we use metis to create the partitioning
             bool mAutoPartition = true ;
 
+            // HDF5 file that caches the partitioned submeshes ( default: none )
+            string mPartitionFile = "" ;
+
+            // cost factors for weighted partitioning ( default: unweighted )
+            bool mWeightedPartition = false ;
+            bool mBalancePartitionDofs = true ;
+            Map< id_t, real > mPartitionBlockCosts ;
+
+            // dofs per node, edge and face of blocks for the partitioner
+            Map< id_t, Vector< uint > > mPartitionBlockDofs ;
+
 //------------------------------------------------------------------------------
         public:
 //------------------------------------------------------------------------------
@@ -241,6 +252,66 @@ namespace belfem
             void
             set_auto_partition( const bool aFlag );
 
+//------------------------------------------------------------------------------
+
+            /**
+             * set the path of a file that stores the submeshes.
+             * If the file exists and fits the mesh, each proc reads its own
+             * partition from it, otherwise the master creates it.
+             */
+            void
+            set_partition_file( const string & aPath );
+
+//------------------------------------------------------------------------------
+
+            const string &
+            partition_file() const ;
+
+//------------------------------------------------------------------------------
+
+            /**
+             * weight the elements during partitioning. Blocks that are not
+             * listed have a cost factor of one. If aBalanceDofs is set,
+             * the number of dofs per proc is balanced as well.
+             */
+            void
+            set_partition_weights( const Vector< id_t > & aBlockIDs,
+                                   const Vector< real > & aBlockCosts,
+                                   const bool aBalanceDofs = true );
+
+//------------------------------------------------------------------------------
+
+            bool
+            weighted_partition() const ;
+
+//------------------------------------------------------------------------------
+
+            bool
+            balance_partition_dofs() const ;
+
+//------------------------------------------------------------------------------
+
+            const Map< id_t, real > &
+            partition_block_costs() const ;
+
+//------------------------------------------------------------------------------
+
+            /**
+             * tell the partitioner how many dofs sit on each node, edge and
+             * face of the listed blocks. Other blocks use the dofs per node
+             * and per edge of the kernel.
+             */
+            void
+            set_partition_dofs( const Vector< id_t > & aBlockIDs,
+                                const Vector< uint > & aDofsPerNode,
+                                const Vector< uint > & aDofsPerEdge,
+                                const Vector< uint > & aDofsPerFace );
+
+//------------------------------------------------------------------------------
+
+            const Map< id_t, Vector< uint > > &
+            partition_block_dofs() const ;
+
 //------------------------------------------------------------------------------
         private:
 //------------------------------------------------------------------------------
@@ -370,6 +441,46 @@ namespace belfem
             return mAutoPartition ;
         }
 
+//------------------------------------------------------------------------------
+
+        inline const string &
+        KernelParameters::partition_file() const
+        {
+            return mPartitionFile ;
+        }
+
+//------------------------------------------------------------------------------
+
+        inline bool
+        KernelParameters::weighted_partition() const
+        {
+            return mWeightedPartition ;
+        }
+
+//------------------------------------------------------------------------------
+
+        inline bool
+        KernelParameters::balance_partition_dofs() const
+        {
+            return mBalancePartitionDofs ;
+        }
+
+//------------------------------------------------------------------------------
+
+        inline const Map< id_t, real > &
+        KernelParameters::partition_block_costs() const
+        {
+            return mPartitionBlockCosts ;
+        }
+
+//------------------------------------------------------------------------------
+
+        inline const Map< id_t, Vector< uint > > &
+        KernelParameters::partition_block_dofs() const
+        {
+            return mPartitionBlockDofs ;
+        }
+
 //------------------------------------------------------------------------------
     }
 }
@@ -147,7 +147,8 @@ namespace belfem
                 {
                     this->compute_current_densities_2d( tI );
 
-                    mParent->synchronize_fields( mCurrentFields );
+                    // the exchange runs while the interior elements are assembled
+                    mParent->start_synchronize_fields( mCurrentFields );
 
                     break ;
                 }
@@ -162,8 +163,8 @@ namespace belfem
                     // values for superconductors will be overwritten by L2
                     this->compute_current_densities_2d( tI );
 
-
-                    mParent->synchronize_fields( mCurrentFields );
+                    // the exchange runs while the interior elements are assembled
+                    mParent->start_synchronize_fields( mCurrentFields );
 
                     break;
                 }
@@ -2,6 +2,8 @@
 // Created by christian on 12/16/21.
 //
 
+#include <memory>
+
 #include "cl_IWG_Maxwell.hpp"
 #include "commtools.hpp"
 #include "meshtools.hpp"
@@ -19,6 +21,8 @@
 #include "fn_crossmat.hpp"
 #include "cl_FEM_Kernel.hpp"
 #include "fn_sum.hpp"
+#include "cl_AsyncWriter.hpp"
+#include "fn_entity_type.hpp"
 
 namespace belfem
 {
@@ -145,6 +149,72 @@ namespace belfem
                     mFaceDofMultiplicity : mNumberOfRhsDofsPerFace ;
         }
 
+//------------------------------------------------------------------------------
+
+        void
+        IWG_Maxwell::dofs_per_domain( const DomainType aType, Vector< uint > & aDofs ) const
+        {
+            aDofs.set_size( 3, 0 );
+
+            const Cell< string > * tFields = nullptr ;
+
+            switch( aType )
+            {
+                case( DomainType::Conductor ) :
+                {
+                    tFields = & mFields.Superconductor ;
+                    break ;
+                }
+                case( DomainType::Coil ) :
+                {
+                    tFields = & mFields.Coil ;
+                    break ;
+                }
+                case( DomainType::Ferro ) :
+                {
+                    tFields = & mFields.Ferro ;
+                    break ;
+                }
+                case( DomainType::Air ) :
+                {
+                    tFields = & mFields.Air ;
+                    break ;
+                }
+                default :
+                {
+                    // no dofs on this block
+                    return ;
+                }
+            }
+
+            for( uint k=0; k<tFields->size(); ++k )
+            {
+                switch( entity_type( ( *tFields )( k ) ) )
+                {
+                    case( EntityType::NODE ) :
+                    {
+                        ++aDofs( 0 );
+                        break ;
+                    }
+                    case( EntityType::EDGE ) :
+                    {
+                        aDofs( 1 ) += mEdgeDofMultiplicity ;
+                        break ;
+                    }
+                    case( EntityType::FACE ) :
+                    {
+                        aDofs( 2 ) += mFaceDofMultiplicity ;
+                        break ;
+                    }
+                    default :
+                    {
+                        // cell dofs are not considered by the partitioner
+                        break ;
+                    }
+                }
+            }
+        }
+
 //------------------------------------------------------------------------------
 
         void
@@ -453,6 +523,97 @@ namespace belfem
 #endif
         }
 
+//------------------------------------------------------------------------------
+
+        void
+        IWG_Maxwell::save( const string & aPath, AsyncWriter & aWriter )
+        {
+#ifdef BELFEM_HDF5
+            if( mField->is_master() )
+            {
+                // everything the writer thread needs, copied at this step
+                struct Backup
+                {
+                    index_t mNumNodes ;
+                    index_t mNumEdges ;
+                    index_t mNumElements ;
+                    real    mTimeStamp ;
+                    uint    mTimeStep ;
+                    uint    mTimeLoop ;
+                    Cell< string > mLabels ;
+                    Cell< Vector< real > > mData ;
+                    dofmgr::SystemSnapshot mSystem ;
+                };
+
+                std::shared_ptr< Backup > tBackup = std::make_shared< Backup >();
+
+                tBackup->mNumNodes    = mMesh->number_of_nodes() ;
+                tBackup->mNumEdges    = mMesh->number_of_edges() ;
+                tBackup->mNumElements = mMesh->number_of_elements() ;
+                tBackup->mTimeStamp   = mMesh->time_stamp() ;
+                tBackup->mTimeStep    = mMesh->time_step() ;
+                tBackup->mTimeLoop    = this->time_loop() ;
+
+                Cell< string > tLabels ;
+                for( string tDofLabel : mAllFields )
+                {
+                    tLabels.push( tDofLabel );
+                }
+
+                // check if temperature exists
+                if( mMesh->field_exists("T") )
+                {
+                    tLabels.push( "T" );
+                }
+
+                luint tBytes = 0 ;
+                for( index_t k=0; k<tLabels.size(); ++k )
+                {
+                    tBackup->mLabels.push( tLabels( k ) );
+                    tBackup->mData.push( mMesh->field_data( tLabels( k ) ) );
+                    tBytes += tBackup->mData( k ).length() * sizeof( real );
+                }
+
+                // also copy matrix
+                reinterpret_cast< DofManager * > ( mField )->stage_system( tBackup->mSystem );
+                tBytes += tBackup->mSystem.memory() ;
+
+                aWriter.push( [ aPath, tBackup ]()
+                {
+                    // create a new HDF5 file
+                    HDF5 tFile( aPath, FileMode::NEW );
+
+                    tFile.create_group("MeshInfo");
+                    tFile.save_data( "numNodes", tBackup->mNumNodes );
+                    tFile.save_data( "numEdges", tBackup->mNumEdges );
+                    tFile.save_data( "numElements", tBackup->mNumElements );
+                    tFile.close_active_group();
+
+                    tFile.create_group("TimeInfo");
+                    tFile.save_data( "timestamp", tBackup->mTimeStamp );
+                    tFile.save_data( "timestep", tBackup->mTimeStep );
+                    tFile.save_data( "timeloop", tBackup->mTimeLoop );
+                    tFile.close_active_group();
+
+                    tFile.create_group("Fields");
+                    for( index_t k=0; k<tBackup->mLabels.size(); ++k )
+                    {
+                        tFile.save_data( tBackup->mLabels( k ), tBackup->mData( k ) );
+                    }
+                    tFile.close_active_group() ;
+
+                    tBackup->mSystem.save( tFile );
+
+                    tFile.close() ;
+
+                    return string() ;
+                }, tBytes );
+            }
+#else
+            this->save( aPath );
+#endif
+        }
+
 //------------------------------------------------------------------------------
 
         int
@@ -32,6 +32,8 @@
 
 namespace belfem
 {
+    class AsyncWriter ;
+
     namespace fem
     {
 
@@ -175,6 +177,16 @@ namespace belfem
             bool
             has_edge_dofs() const ;
 
+//------------------------------------------------------------------------------
+
+            /**
+             * number of dofs per node, edge and face that this formulation
+             * creates on a block of the given type. Used by the factory
+             * to weight the partitioning before the IWG is initialized.
+             */
+            void
+            dofs_per_domain( const DomainType aType, Vector< uint > & aDofs ) const ;
+
 //------------------------------------------------------------------------------
 
             // copy dofs into fields from last timestep
@@ -189,6 +201,15 @@ namespace belfem
             void
             save( const string & aPath );
 
+//------------------------------------------------------------------------------
+
+            /**
+             * copy the backup data and let the writer thread
+             * create the HDF5 file
+             */
+            void
+            save( const string & aPath, AsyncWriter & aWriter );
+
 //------------------------------------------------------------------------------
 
             /**
@@ -393,6 +393,25 @@ namespace belfem
                    "memdump.hdf5" ;
         }
 
+//------------------------------------------------------------------------------
+
+        string
+        MaxwellFactory::setupfile( const MaxwellFieldType aFieldType ) const
+        {
+            const string tKey = aFieldType == MaxwellFieldType::THERMAL ?
+                    "thermalSetupFile" : "setupFile" ;
+
+            if( mInputFile.section("output")->key_exists( tKey ) )
+            {
+                return mInputFile.section("output")->get_string( tKey );
+            }
+
+            const string tOutFile = this->outfile() ;
+
+            return tOutFile.substr( 0, tOutFile.find_last_of( "." ) )
+                + ( aFieldType == MaxwellFieldType::THERMAL ? "_thermal_setup.hdf5" : "_setup.hdf5" );
+        }
+
 //------------------------------------------------------------------------------
 
         bool
@@ -822,6 +841,12 @@ namespace belfem
                     aMaterial->set_rrr( aInput->get_real( "rrr" ) );
                 }
 
+                // tolerance for the property tables
+                if( aInput->key_exists( "tables" ) )
+                {
+                    aMaterial->use_tables( true, aInput->get_real( "tables" ) );
+                }
+
                 return aMaterial ;
             }
             else
@@ -1048,6 +1073,12 @@ namespace belfem
                 {
                     aMaterial->set_thermal_material( aInput->get_string( "thermal" ) );
                 }
+
+                // tolerance for the property tables
+                if( aInput->key_exists( "tables" ) )
+                {
+                    aMaterial->use_tables( true, aInput->get_real( "tables" ) );
+                }
                 return aMaterial;
             }
         }
@@ -1602,6 +1633,16 @@ namespace belfem
                 mMagneticParameters->select_blocks( tSelectedBlocks );
             }
 
+            // read the submeshes from a file if it exists
+            if( mInputFile.section( "mesh" )->key_exists( "partitionFile" ) )
+            {
+                mMagneticParameters->set_partition_file(
+                        mInputFile.section( "mesh" )->get_string( "partitionFile" ) );
+            }
+
+            // conductors are more expensive to assemble than air
+            this->set_partition_weights( mMagneticParameters );
+
             // create the kernel
             mMagneticKernel = new Kernel( mMagneticParameters );
 
@@ -1609,6 +1650,69 @@ namespace belfem
             mMagneticKernel->claim_parameter_ownership( true );
         }
 
+//------------------------------------------------------------------------------
+
+        void
+        MaxwellFactory::set_partition_weights( KernelParameters * aParameters )
+        {
+            const input::Section * tSection = mInputFile.section( "mesh" );
+
+            // cost factor for nonlinear domains, relative to air
+            real tConductorCost = tSection->key_exists( "conductorWeight" ) ?
+                    tSection->get_real( "conductorWeight" ) : 4.0 ;
+
+            // balance the dofs as a second constraint
+            bool tBalanceDofs = tSection->key_exists( "balanceDofs" ) ?
+                    tSection->get_bool( "balanceDofs" ) : true ;
+
+            Vector< id_t > tBlockIDs( mBlockIDs.length() );
+            Vector< real > tCosts( mBlockIDs.length() );
+
+            // the dofs on each block depend on the formulation,
+            // e.g. edge dofs on conductors and node dofs in air
+            Vector< uint > tDofsPerNode( mBlockIDs.length() );
+            Vector< uint > tDofsPerEdge( mBlockIDs.length() );
+            Vector< uint > tDofsPerFace( mBlockIDs.length() );
+
+            IWG_Maxwell * tFormulation = this->create_iwg( mFormulation );
+
+            Vector< uint > tDofs ;
+
+            uint tCount = 0 ;
+
+            for( uint b=0; b<mBlockTypes.size(); ++b )
+            {
+                tFormulation->dofs_per_domain( mBlockTypes( b ), tDofs );
+                tDofsPerNode( b ) = tDofs( 0 );
+                tDofsPerEdge( b ) = tDofs( 1 );
+                tDofsPerFace( b ) = tDofs( 2 );
+
+                switch( mBlockTypes( b ) )
+                {
+                    case( DomainType::Conductor ) :
+                    case( DomainType::Ferro ) :
+                    {
+                        tBlockIDs( tCount ) = mBlockIDs( b );
+                        tCosts( tCount++ ) = tConductorCost ;
+                        break ;
+                    }
+                    default :
+                    {
+                        // air and coils have the default cost
+                        break ;
+                    }
+                }
+            }
+
+            delete tFormulation ;
+
+            tBlockIDs.set_size( tCount );
+            tCosts.set_size( tCount );
+
+            aParameters->set_partition_weights( tBlockIDs, tCosts, tBalanceDofs );
+            aParameters->set_partition_dofs( mBlockIDs, tDofsPerNode, tDofsPerEdge, tDofsPerFace );
+        }
+
 //------------------------------------------------------------------------------
 
         IWG_Maxwell *
@@ -1907,6 +2011,24 @@ namespace belfem
 
             aDofMaganer->set_solver( tSolverType );
 
+            // number of threads for the element assembly
+            if( aSection->key_exists( "assemblythreads" ) )
+            {
+                aDofMaganer->set_number_of_threads( aSection->get_int( "assemblythreads" ) );
+            }
+
+            // keep the Jacobian distributed by rows ( PETSc and STRUMPACK only )
+            if( aSection->key_exists( "distributedassembly" ) )
+            {
+                aDofMaganer->set_distributed_assembly( aSection->get_bool( "distributedassembly" ) );
+            }
+
+            // 64-bit indices for very large Jacobians ( UMFPACK and PARDISO only )
+            if( aSection->key_exists( "longindices" ) )
+            {
+                aDofMaganer->set_long_indices( aSection->get_bool( "longindices" ) );
+            }
+
             if( tSolverType == SolverType::PETSC )
             {
                 KrylovMethod tMethod = aSection->key_exists("krylovmethod") ?
@@ -1922,6 +2044,41 @@ namespace belfem
                 aDofMaganer->solver()->set_petsc( tPreconditioner, tMethod, tEpsilon );
 
             }
+            else if( tSolverType == SolverType::KRYLOV )
+            {
+                // AUTO picks CG for SPD systems and GMRES otherwise
+                KrylovMethod tMethod = aSection->key_exists("krylovmethod") ?
+                                       krylov_method( aSection->get_string("krylovmethod" )) :
+                                       KrylovMethod::AUTO ;
+
+                // UNDEFINED picks IC(0) for CG and ILU(0) otherwise
+                Preconditioner tPreconditioner = aSection->key_exists("preconditioner") ?
+                                                 preconditioner( aSection->get_string("preconditioner") ) :
+                                                 Preconditioner::UNDEFINED ;
+
+                real tEpsilon = aSection->key_exists("epsilon") ? aSection->get_real( "epsilon") : 1e-8 ;
+
+                uint tMaxIter = aSection->key_exists("maxiter") ? aSection->get_int( "maxiter") : 1000 ;
+
+                bool tWarmStart = aSection->key_exists("warmstart") ? aSection->get_bool( "warmstart") : true ;
+
+                aDofMaganer->solver()->set_krylov( tPreconditioner, tMethod, tEpsilon, tMaxIter, tWarmStart );
+            }
+            // keep the numeric factorization between nonlinear iterations
+            if( aSection->key_exists( "reusefactorization" ) )
+            {
+                if( aSection->get_bool( "reusefactorization" ) )
+                {
+                    uint tMaxSteps = aSection->key_exists( "refinementsteps" ) ?
+                                     aSection->get_int( "refinementsteps" ) : 5 ;
+
+                    real tContraction = aSection->key_exists( "refinementcontraction" ) ?
+                                        aSection->get_real( "refinementcontraction" ) : 0.25 ;
+
+                    aDofMaganer->solver()->set_factorization_reuse( true, tMaxSteps, tContraction );
+                }
+            }
+
             if( tSolverType == SolverType::MUMPS )
             {
                 SerialReodrdering   tSerial   = aSection->key_exists( "serialreordering") ?
@@ -269,6 +269,14 @@ namespace belfem
             string
             backupfile() const ;
 
+            /**
+             * return the name of the checkpoint with the setup of a field,
+             * set by setupFile or thermalSetupFile, otherwise derived
+             * from the name of the exodus file
+             */
+            string
+            setupfile( const MaxwellFieldType aFieldType = MaxwellFieldType::MAGNETIC ) const ;
+
             bool
             restart() const ;
 
@@ -403,6 +411,14 @@ namespace belfem
             void
             create_kernel();
 
+//------------------------------------------------------------------------------
+
+            /**
+             * weight the blocks for the partitioner
+             */
+            void
+            set_partition_weights( KernelParameters * aParameters );
+
 //------------------------------------------------------------------------------
 
             void
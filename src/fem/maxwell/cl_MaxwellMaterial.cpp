@@ -49,6 +49,10 @@ namespace belfem
         {
             delete mRhoSpline ;
         }
+        if( mRhoTable != nullptr )
+        {
+            delete mRhoTable ;
+        }
         if( mThermalMaterial != nullptr )
         {
             delete mThermalMaterial ;
@@ -331,5 +335,40 @@ namespace belfem
         mThermalMaterial = tFactory.create_material( aLabel );
     }
 
+//----------------------------------------------------------------------------
+
+    void
+    MaxwellMaterial::use_tables( const bool aSwitch, const real aTolerance )
+    {
+        if( mRhoTable != nullptr )
+        {
+            delete mRhoTable ;
+            mRhoTable = nullptr ;
+        }
+
+        // only the temperature dependent resistivity is tabulated
+        if( mFunRho == & MaxwellMaterial::rho_el_spline_t
+            || mFunRho == & MaxwellMaterial::rho_el_table_t )
+        {
+            mFunRho = & MaxwellMaterial::rho_el_spline_t ;
+            mFunRhoJcrit = & MaxwellMaterial::rho_el_jc_spline_t ;
+
+            if( aSwitch )
+            {
+                mRhoTable = new MaterialTable(
+                        [ this ]( const real aT ) { return mRhoSpline->eval( aT ); },
+                        mRhoSpline->x_min(), mRhoSpline->x_max(), aTolerance );
+
+                mFunRho = & MaxwellMaterial::rho_el_table_t ;
+                mFunRhoJcrit = & MaxwellMaterial::rho_el_jc_table_t ;
+            }
+        }
+
+        if( mThermalMaterial != nullptr )
+        {
+            mThermalMaterial->use_tables( aSwitch, aTolerance );
+        }
+    }
+
 //----------------------------------------------------------------------------
 }
\ No newline at end of file
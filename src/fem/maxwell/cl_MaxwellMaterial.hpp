@@ -8,6 +8,7 @@
 #include "cl_IsotropicMaterial.hpp"
 #include "en_FEM_DomainType.hpp"
 #include "cl_Spline.hpp"
+#include "cl_MaterialTable.hpp"
 #include "cl_Database.hpp"
 
 namespace belfem
@@ -22,6 +23,9 @@ namespace belfem
         // spline if resisivity is only temperature dependent
         Spline * mRhoSpline = nullptr ;
 
+        // table for the resistivity spline, only if use_tables is switched on
+        MaterialTable * mRhoTable = nullptr ;
+
         // for jc database
         Database * mJcData = nullptr ;
 
@@ -258,6 +262,15 @@ namespace belfem
         real
         creep_expinent_minus_1() const ;
 
+//----------------------------------------------------------------------------
+
+        /**
+         * tabulate the temperature dependent resistivity
+         * and the properties of the thermal material
+         */
+        void
+        use_tables( const bool aSwitch, const real aTolerance=1e-6 ) ;
+
 //----------------------------------------------------------------------------
 
         void
@@ -326,6 +339,9 @@ namespace belfem
 
         real
         rho_el_spline_t( const real aJ, const real aT=BELFEM_TREF, const real aB=0, const real aAngle=0   ) const ;
+
+        real
+        rho_el_table_t( const real aJ, const real aT=BELFEM_TREF, const real aB=0, const real aAngle=0   ) const ;
 //----------------------------------------------------------------------------
 
         real
@@ -337,6 +353,9 @@ namespace belfem
         real
         rho_el_jc_spline_t( const real aJ, const real aJc, const real aT=BELFEM_TREF, const real aB=0, const real aAngle=0 ) const ;
 
+        real
+        rho_el_jc_table_t( const real aJ, const real aJc, const real aT=BELFEM_TREF, const real aB=0, const real aAngle=0 ) const ;
+
 //---------------------------------------------------------------------------
     };
 
@@ -435,6 +454,22 @@ namespace belfem
             return mRhoSpline->eval( aT );
         }
 
+//----------------------------------------------------------------------------
+
+        inline real
+        MaxwellMaterial::rho_el_jc_table_t( const real aJ, const real aJc, const real aT, const real aB, const real aAngle ) const
+        {
+            return  mRhoTable->eval( aT );
+        }
+
+//----------------------------------------------------------------------------
+
+        inline real
+        MaxwellMaterial::rho_el_table_t( const real aJ, const real aT, const real aB, const real aAngle ) const
+        {
+            return mRhoTable->eval( aT );
+        }
+
 //----------------------------------------------------------------------------
 
         inline real
@@ -7,6 +7,8 @@
 
 #ifdef BELFEM_HDF5
 #include <cstring>
+#include <algorithm>
+#include <type_traits>
 #include <hdf5.h>
 #else
 namespace belfem
@@ -166,6 +168,121 @@ namespace belfem
 #endif
         }
 
+//------------------------------------------------------------------------------
+
+        /**
+         * settings for chunked and compressed datasets
+         */
+        struct Compression
+        {
+            // deflate level from 1 to 9, 0: no compression
+            uint Level = 0 ;
+
+            // shuffle bytes before compressing
+            bool Shuffle = true ;
+
+            // use szip instead of deflate if the library supports it
+            bool Szip = false ;
+
+            // number of entries per chunk
+            hsize_t ChunkSize = 16384 ;
+
+            // decimal digits kept in real data, negative: lossless
+            int Digits = -1 ;
+        };
+
+//------------------------------------------------------------------------------
+
+        /**
+         * creates the property list for a new dataset.
+         * Returns H5P_DEFAULT if the data is not compressed.
+         * The list must be closed with close_properties.
+         */
+        template < typename T >
+        hid_t
+        create_dataset_properties(
+                const Compression * aCompression,
+                const int           aRank,
+                const hsize_t     * aDims,
+                const T           & aSample )
+        {
+#ifdef BELFEM_HDF5
+            if( aCompression == nullptr )
+            {
+                return H5P_DEFAULT ;
+            }
+
+            bool tLossy = aCompression->Digits >= 0 && std::is_floating_point< T >::value ;
+
+            if( aCompression->Level == 0 && ! aCompression->Szip && ! tLossy )
+            {
+                return H5P_DEFAULT ;
+            }
+
+            // chunks must not be empty
+            for( int k=0; k<aRank; ++k )
+            {
+                if( aDims[ k ] == 0 )
+                {
+                    return H5P_DEFAULT ;
+                }
+            }
+
+            // the last dimension is contiguous
+            hsize_t tChunk[ 2 ];
+            if( aRank == 1 )
+            {
+                tChunk[ 0 ] = std::min( aDims[ 0 ], aCompression->ChunkSize );
+            }
+            else
+            {
+                tChunk[ 1 ] = std::min( aDims[ 1 ], aCompression->ChunkSize );
+                tChunk[ 0 ] = std::max( std::min( aDims[ 0 ],
+                        aCompression->ChunkSize / tChunk[ 1 ] ), ( hsize_t ) 1 );
+            }
+
+            hid_t aProperties = H5Pcreate( H5P_DATASET_CREATE );
+
+            H5Pset_chunk( aProperties, aRank, tChunk );
+
+            // filters are applied in the order they are set
+            if( tLossy )
+            {
+                H5Pset_scaleoffset( aProperties, H5Z_SO_FLOAT_DSCALE, aCompression->Digits );
+            }
+            else if( aCompression->Shuffle )
+            {
+                H5Pset_shuffle( aProperties );
+            }
+
+            if( aCompression->Szip && H5Zfilter_avail( H5Z_FILTER_SZIP ) > 0 )
+            {
+                H5Pset_szip( aProperties, H5_SZIP_NN_OPTION_MASK, 16 );
+            }
+            else if( aCompression->Level > 0 || aCompression->Szip )
+            {
+                H5Pset_deflate( aProperties, aCompression->Szip ? 6 : aCompression->Level );
+            }
+
+            return aProperties ;
+#else
+            return 0 ;
+#endif
+        }
+
+//------------------------------------------------------------------------------
+
+        inline void
+        close_properties( hid_t aProperties )
+        {
+#ifdef BELFEM_HDF5
+            if( aProperties != H5P_DEFAULT )
+            {
+                H5Pclose( aProperties );
+            }
+#endif
+        }
+
 //------------------------------------------------------------------------------
 
         /**
@@ -498,7 +615,8 @@ namespace belfem
                 hid_t         & aFileID,
                 const std::string   & aLabel,
                 const Vector< T >   & aVector,
-                herr_t        & aStatus )
+                herr_t        & aStatus,
+                const Compression * aCompression = nullptr )
         {
 #ifdef BELFEM_HDF5
             // create a sample
@@ -531,6 +649,9 @@ namespace belfem
             hid_t  tDataSpace
                     = H5Screate_simple( 1, tDims, nullptr );
 
+            // chunking and filters
+            hid_t tProperties = create_dataset_properties( aCompression, 1, tDims, tSample );
+
             // create new dataset
             tDataSet = H5Dcreate(
                     aFileID,
@@ -538,9 +659,11 @@ namespace belfem
                     tDataType,
                     tDataSpace,
                     H5P_DEFAULT,
-                    H5P_DEFAULT,
+                    tProperties,
                     H5P_DEFAULT );
 
+            close_properties( tProperties );
+
             // test if vector is not empty
             if( tLength > 0 )
             {
@@ -675,7 +798,8 @@ namespace belfem
                 hid_t               & aFileID,
                 const std::string   & aLabel,
                 const Matrix< T >   & aMatrix,
-                herr_t              & aStatus )
+                herr_t              & aStatus,
+                const Compression   * aCompression = nullptr )
         {
 #ifdef BELFEM_HDF5
             // create a sample
@@ -708,6 +832,9 @@ namespace belfem
             hid_t  tDataSpace
                     = H5Screate_simple( 2, tDims, nullptr );
 
+            // chunking and filters
+            hid_t tProperties = create_dataset_properties( aCompression, 2, tDims, tSample );
+
             // create new dataset
             tDataSet = H5Dcreate(
                     aFileID,
@@ -715,9 +842,11 @@ namespace belfem
                     tDataType,
                     tDataSpace,
                     H5P_DEFAULT,
-                    H5P_DEFAULT,
+                    tProperties,
                     H5P_DEFAULT );
 
+            close_properties( tProperties );
+
             // test if vector is not empty
             if( tDims[ 0 ]*tDims[ 1 ] > 0 )
             {
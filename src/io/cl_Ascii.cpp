@@ -15,7 +15,7 @@ namespace belfem
 {
 //------------------------------------------------------------------------------
 
-    Ascii::Ascii( const string & aPath, const FileMode & aMode ) :
+    Ascii::Ascii( const string & aPath, const FileMode & aMode, const bool aLoadBuffer ) :
         mMode( aMode )
     {
 
@@ -33,12 +33,18 @@ namespace belfem
         {
             case( FileMode::OPEN_RDONLY ) :
             {
-                this->load_buffer( false );
+                if( aLoadBuffer )
+                {
+                    this->load_buffer( false );
+                }
                 break;
             }
             case( FileMode::OPEN_RDONLY_PARALLEL ) :
             {
-                this->load_buffer( true );
+                if( aLoadBuffer )
+                {
+                    this->load_buffer( true );
+                }
                 break ;
             }
             case( FileMode::NEW ) :
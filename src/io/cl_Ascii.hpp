@@ -31,8 +31,14 @@ namespace belfem
     public:
 //------------------------------------------------------------------------------
 
+        /**
+         * @param aLoadBuffer  if false, a read only file is not loaded
+         *                     into the buffer, so that a derived class
+         *                     can parse it on its own
+         */
         Ascii( const string        & aPath,
-               const enum FileMode & aMode );
+               const enum FileMode & aMode,
+               const bool            aLoadBuffer = true );
 
 //------------------------------------------------------------------------------
 
@@ -15,12 +15,17 @@ namespace belfem
     HDF5::HDF5(
             const string & aPath,
             const enum FileMode aMode,
-            const bool aParallelMode )
+            const bool aParallelMode,
+            const bool aCollective ) :
+            mCollective( aCollective )
     {
 #ifdef BELFEM_HDF5
         // make sure that file path is given
         BELFEM_ERROR( ! aPath.empty(), "No file path given." );
 
+        BELFEM_ERROR( ! ( aParallelMode && aCollective ),
+                      "A file can't be both parallel and collective" );
+
         if( aParallelMode )
         {
             // make path parallel
@@ -30,8 +35,11 @@ namespace belfem
         {
             mPath = aPath;
         }
-        if( aParallelMode || gComm.rank() == 0 )
+        if( aParallelMode || aCollective || gComm.rank() == 0 )
         {
+            // access properties, all procs share one file if collective
+            hid_t tAccess = this->create_access_properties() ;
+
             switch( aMode )
             {
                 case( FileMode::NEW ) :
@@ -41,7 +49,7 @@ namespace belfem
                             mPath.c_str(),
                             H5F_ACC_TRUNC, // If file exists, erasing all existing data.
                             H5P_DEFAULT,   // File creation property list identifier
-                            H5P_DEFAULT);  // Access property list identifier.
+                            tAccess );     // Access property list identifier.
 
                     BELFEM_ERROR( mFile > 0,
                         "Something went wrong while trying to create file %s\nIs it in use?",
@@ -61,7 +69,7 @@ namespace belfem
                     mFile = H5Fopen(
                             mPath.c_str(),
                             H5F_ACC_RDONLY,   // File creation property list identifier
-                            H5P_DEFAULT);  // Access property list identifier.
+                            tAccess );     // Access property list identifier.
 
                     BELFEM_ERROR( mFile > 0,
                                        "Something went wrong while trying to open file %s.\nIs it in use?",
@@ -81,7 +89,7 @@ namespace belfem
                     mFile = H5Fopen(
                             mPath.c_str(),
                             H5F_ACC_RDWR,   // File creation property list identifier
-                            H5P_DEFAULT);  // Access property list identifier.
+                            tAccess );     // Access property list identifier.
 
                     BELFEM_ERROR( mFile > 0,
                                "Something went wrong while trying to open file %s.\nIs it in use?",
@@ -96,6 +104,11 @@ namespace belfem
                 }
             }
 
+            if( tAccess != H5P_DEFAULT )
+            {
+                H5Pclose( tAccess );
+            }
+
             // set flag for file is open
             mFileIsOpen = true;
 
@@ -131,6 +144,60 @@ namespace belfem
 #endif
     }
 
+//------------------------------------------------------------------------------
+
+    void
+    HDF5::set_compression( const uint aLevel, const bool aShuffle, const bool aSzip )
+    {
+        BELFEM_ERROR( aLevel <= 9, "Compression level must be between 0 and 9" );
+
+        mCompression.Level   = aLevel ;
+        mCompression.Shuffle = aShuffle ;
+        mCompression.Szip    = aSzip ;
+    }
+
+//------------------------------------------------------------------------------
+
+    void
+    HDF5::set_chunk_size( const index_t aChunkSize )
+    {
+        BELFEM_ERROR( aChunkSize > 0, "Chunk size must be positive" );
+
+        mCompression.ChunkSize = aChunkSize ;
+    }
+
+//------------------------------------------------------------------------------
+
+    void
+    HDF5::set_lossy_precision( const int aDigits )
+    {
+        mCompression.Digits = aDigits ;
+    }
+
+//------------------------------------------------------------------------------
+
+    hid_t
+    HDF5::create_access_properties()
+    {
+#ifdef BELFEM_HDF5
+        if( mCollective )
+        {
+#if defined( BELFEM_MPI ) && defined( H5_HAVE_PARALLEL )
+            hid_t aAccess = H5Pcreate( H5P_FILE_ACCESS );
+            H5Pset_fapl_mpio( aAccess, gComm.world(), MPI_INFO_NULL );
+            return aAccess ;
+#else
+            BELFEM_ERROR( false,
+                          "Can't open %s collectively, since HDF5 was built without MPI support",
+                          mPath.c_str() );
+#endif
+        }
+        return H5P_DEFAULT ;
+#else
+        return 0 ;
+#endif
+    }
+
 //------------------------------------------------------------------------------
 
     herr_t &
@@ -502,7 +569,8 @@ namespace belfem
                 mActiveGroup,
                 aLabel,
                 aVector,
-                mStatus );
+                mStatus,
+                &mCompression );
     }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -516,7 +584,8 @@ namespace belfem
                 mActiveGroup,
                 aLabel,
                 aVector,
-                mStatus );
+                mStatus,
+                &mCompression );
     }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -530,7 +599,8 @@ namespace belfem
                 mActiveGroup,
                 aLabel,
                 aVector,
-                mStatus );
+                mStatus,
+                &mCompression );
     }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -544,7 +614,8 @@ namespace belfem
                 mActiveGroup,
                 aLabel,
                 aVector,
-                mStatus );
+                mStatus,
+                &mCompression );
     }
 //------------------------------------------------------------------------------
 // Load Vectors
@@ -617,7 +688,8 @@ namespace belfem
                 mActiveGroup,
                 aLabel,
                 aMatrix,
-                mStatus );
+                mStatus,
+                &mCompression );
     }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -631,7 +703,8 @@ namespace belfem
                 mActiveGroup,
                 aLabel,
                 aMatrix,
-                mStatus );
+                mStatus,
+                &mCompression );
     }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -645,7 +718,8 @@ namespace belfem
                 mActiveGroup,
                 aLabel,
                 aMatrix,
-                mStatus );
+                mStatus,
+                &mCompression );
     }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -659,7 +733,8 @@ namespace belfem
                 mActiveGroup,
                 aLabel,
                 aMatrix,
-                mStatus );
+                mStatus,
+                &mCompression );
     }
 
 //------------------------------------------------------------------------------
@@ -752,6 +827,171 @@ namespace belfem
                 mStatus );
     }
 
+//------------------------------------------------------------------------------
+// Distributed Vectors
+//------------------------------------------------------------------------------
+
+    void
+    HDF5::save_distributed( const string         & aLabel,
+                            const Vector< real > & aVector )
+    {
+        if( ! mCollective )
+        {
+            this->save_data( aLabel, aVector );
+            return ;
+        }
+#if defined( BELFEM_HDF5 ) && defined( BELFEM_MPI ) && defined( H5_HAVE_PARALLEL )
+        BELFEM_ERROR( ! hdf5::dataset_exists( mActiveGroup, aLabel ),
+                      "Dataset %s does already exist.", aLabel.c_str() );
+
+        hsize_t tOffset ;
+        hsize_t tDims[ 1 ];
+        hsize_t tCount[ 1 ] = { aVector.length() };
+
+        this->distributed_layout( tCount[ 0 ], tOffset, tDims[ 0 ] );
+
+        // select datatype for data to save
+        hid_t tDataType = H5Tcopy( H5T_NATIVE_DOUBLE );
+        mStatus = H5Tset_order( tDataType, H5T_ORDER_LE );
+
+        hid_t tFileSpace = H5Screate_simple( 1, tDims, nullptr );
+        hid_t tMemSpace  = H5Screate_simple( 1, tCount, nullptr );
+
+        // dataset creation is collective
+        hid_t tProperties = hdf5::create_dataset_properties( &mCompression, 1, tDims, ( real ) 0 );
+
+        hid_t tDataSet = H5Dcreate(
+                mActiveGroup,
+                aLabel.c_str(),
+                tDataType,
+                tFileSpace,
+                H5P_DEFAULT,
+                tProperties,
+                H5P_DEFAULT );
+
+        hdf5::close_properties( tProperties );
+
+        // each proc writes its own part
+        this->select_distributed_part( tFileSpace, tMemSpace, tOffset, tCount[ 0 ] );
+
+        hid_t tTransfer = H5Pcreate( H5P_DATASET_XFER );
+        H5Pset_dxpl_mpio( tTransfer, H5FD_MPIO_COLLECTIVE );
+
+        mStatus = H5Dwrite( tDataSet, H5T_NATIVE_DOUBLE, tMemSpace, tFileSpace,
+                            tTransfer, aVector.data() );
+
+        H5Pclose( tTransfer );
+        H5Sclose( tMemSpace );
+        H5Sclose( tFileSpace );
+        H5Tclose( tDataType );
+        H5Dclose( tDataSet );
+
+        BELFEM_ERROR( mStatus >= 0,
+                      "Something went wrong while trying to store distributed vector %s",
+                      aLabel.c_str() );
+#endif
+    }
+
+//------------------------------------------------------------------------------
+
+    void
+    HDF5::load_distributed( const string         & aLabel,
+                                  Vector< real > & aVector )
+    {
+        if( ! mCollective )
+        {
+            this->load_data( aLabel, aVector );
+            return ;
+        }
+#if defined( BELFEM_HDF5 ) && defined( BELFEM_MPI ) && defined( H5_HAVE_PARALLEL )
+        BELFEM_ERROR( hdf5::dataset_exists( mActiveGroup, aLabel ),
+                      "Dataset %s does not exist.", aLabel.c_str() );
+
+        hsize_t tOffset ;
+        hsize_t tTotal ;
+        hsize_t tCount[ 1 ] = { aVector.length() };
+
+        this->distributed_layout( tCount[ 0 ], tOffset, tTotal );
+
+        hid_t tDataSet   = H5Dopen2( mActiveGroup, aLabel.c_str(), H5P_DEFAULT );
+        hid_t tFileSpace = H5Dget_space( tDataSet );
+        hid_t tMemSpace  = H5Screate_simple( 1, tCount, nullptr );
+
+        hsize_t tDims[ 1 ];
+        H5Sget_simple_extent_dims( tFileSpace, tDims, nullptr );
+
+        BELFEM_ERROR( tDims[ 0 ] == tTotal,
+                      "Length of %s does not match the parts: is %lu, expect %lu.",
+                      aLabel.c_str(),
+                      ( long unsigned int ) tDims[ 0 ],
+                      ( long unsigned int ) tTotal );
+
+        this->select_distributed_part( tFileSpace, tMemSpace, tOffset, tCount[ 0 ] );
+
+        hid_t tTransfer = H5Pcreate( H5P_DATASET_XFER );
+        H5Pset_dxpl_mpio( tTransfer, H5FD_MPIO_COLLECTIVE );
+
+        mStatus = H5Dread( tDataSet, H5T_NATIVE_DOUBLE, tMemSpace, tFileSpace,
+                           tTransfer, aVector.data() );
+
+        H5Pclose( tTransfer );
+        H5Sclose( tMemSpace );
+        H5Sclose( tFileSpace );
+        H5Dclose( tDataSet );
+
+        BELFEM_ERROR( mStatus >= 0,
+                      "Something went wrong while trying to load distributed vector %s",
+                      aLabel.c_str() );
+#endif
+    }
+
+//------------------------------------------------------------------------------
+
+    void
+    HDF5::distributed_layout( const hsize_t aLength, hsize_t & aOffset, hsize_t & aTotal )
+    {
+        aOffset = 0 ;
+        aTotal = aLength ;
+#ifdef BELFEM_MPI
+        long long unsigned int tLength = aLength ;
+        long long unsigned int tOffset = 0 ;
+        long long unsigned int tTotal  = 0 ;
+
+        // the offset is the sum of the lengths on the lower ranks
+        MPI_Exscan( &tLength, &tOffset, 1, MPI_UNSIGNED_LONG_LONG, MPI_SUM, gComm.world() );
+        MPI_Allreduce( &tLength, &tTotal, 1, MPI_UNSIGNED_LONG_LONG, MPI_SUM, gComm.world() );
+
+        // the result of exscan is undefined on rank 0
+        aOffset = gComm.rank() == 0 ? 0 : tOffset ;
+        aTotal  = tTotal ;
+#endif
+    }
+
+//------------------------------------------------------------------------------
+
+    void
+    HDF5::select_distributed_part(
+            hid_t aFileSpace,
+            hid_t aMemSpace,
+            const hsize_t aOffset,
+            const hsize_t aCount )
+    {
+#ifdef BELFEM_HDF5
+        if( aCount > 0 )
+        {
+            hsize_t tStart[ 1 ] = { aOffset };
+            hsize_t tCount[ 1 ] = { aCount };
+            H5Sselect_hyperslab( aFileSpace, H5S_SELECT_SET, tStart, nullptr, tCount, nullptr );
+        }
+        else
+        {
+            // procs without data must still take part
+            H5Sselect_none( aFileSpace );
+            H5Sselect_none( aMemSpace );
+        }
+#endif
+    }
+
 //------------------------------------------------------------------------------
 
     hid_t
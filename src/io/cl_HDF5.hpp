@@ -44,16 +44,27 @@ namespace belfem
         Cell< string > mTreeLabels ;
         Cell< hid_t  > mTree ;
 
+        // all procs write into the same file using MPI-IO
+        const bool mCollective = false ;
+
+        // chunking and filters for new vectors and matrices
+        hdf5::Compression mCompression ;
+
 //------------------------------------------------------------------------------
     public:
 //------------------------------------------------------------------------------
 
         /**
          * constructor
+         *
+         * @param aParallelMode : each proc writes its own file
+         * @param aCollective   : all procs share one file through MPI-IO,
+         *                        all calls must then be made by all procs
          */
          HDF5(   const string & aPath,
                  const enum FileMode aMode=FileMode::NEW,
-                 const bool aParallelMode=false );
+                 const bool aParallelMode=false,
+                 const bool aCollective=false );
 
 //------------------------------------------------------------------------------
 
@@ -76,6 +87,35 @@ namespace belfem
          herr_t &
          status();
 
+//------------------------------------------------------------------------------
+
+        /**
+         * compress vectors and matrices that are written from now on.
+         * The level is between 1 and 9, 0 switches compression off.
+         * Szip is only used if the library provides it, otherwise deflate.
+         */
+        void
+        set_compression( const uint aLevel,
+                         const bool aShuffle=true,
+                         const bool aSzip=false );
+
+//------------------------------------------------------------------------------
+
+        /**
+         * number of entries per chunk of compressed datasets
+         */
+        void
+        set_chunk_size( const index_t aChunkSize );
+
+//------------------------------------------------------------------------------
+
+        /**
+         * keep only the given number of decimal digits of real data,
+         * a negative value means lossless
+         */
+        void
+        set_lossy_precision( const int aDigits );
+
 //------------------------------------------------------------------------------
 // GROUP FUNCTIONS
 //------------------------------------------------------------------------------
@@ -336,6 +376,48 @@ namespace belfem
         load_data( const string         & aLabel,
                          Matrix< real > & aMatrix );
 
+//------------------------------------------------------------------------------
+// Distributed Vectors
+//------------------------------------------------------------------------------
+
+        /**
+         * each proc writes its part into one dataset, ordered by rank.
+         * Behaves like save_data if the file is not collective.
+         */
+        void
+        save_distributed( const string         & aLabel,
+                          const Vector< real > & aVector );
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+        /**
+         * each proc reads its part, the vector must have the length
+         * of that part. Behaves like load_data if the file is not collective.
+         */
+        void
+        load_distributed( const string         & aLabel,
+                                Vector< real > & aVector );
+
+//------------------------------------------------------------------------------
+    private:
+//------------------------------------------------------------------------------
+
+        hid_t
+        create_access_properties();
+
+//------------------------------------------------------------------------------
+
+        void
+        distributed_layout( const hsize_t aLength, hsize_t & aOffset, hsize_t & aTotal );
+
+//------------------------------------------------------------------------------
+
+        void
+        select_distributed_part( hid_t aFileSpace,
+                                 hid_t aMemSpace,
+                                 const hsize_t aOffset,
+                                 const hsize_t aCount );
+
 //------------------------------------------------------------------------------
     };
 
@@ -12,6 +12,7 @@
 #include "cl_InputFile.hpp"
 #include "cl_MaxwellFactory.hpp"
 #include "cl_Profiler.hpp"
+#include "cl_AsyncWriter.hpp"
 #include "fn_FEM_compute_normb.hpp"
 #include "fn_sum.hpp"
 #include "fn_max.hpp"
@@ -49,6 +50,9 @@ int main( int    argc,
     // initialize job
     // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
+    // time the hot path regions
+    Profiler::enable_regions( true );
+
     // read the input file
     InputFile tInputFile( "input.txt" );
 
@@ -82,6 +86,10 @@ int main( int    argc,
     // get the name of the backup file
     const string tBackupFile = tFactory->backupfile() ;
 
+    // get the names of the checkpoints with the setup of the fields
+    const string tSetupFile = tFactory->setupfile() ;
+    const string tThermalSetupFile = tFactory->setupfile( MaxwellFieldType::THERMAL );
+
     // get the restart flag
     const bool tRestart =  tFactory->restart();
 
@@ -125,11 +133,16 @@ int main( int    argc,
     // get the timestep
     uint & tTimeCount = tMesh->time_step() ;
 
+    // the dof numbering, the matrix pattern and the ordering are reused
+    // from an earlier run, as long as the model did not change
+    tMagfield->set_checkpoint( tSetupFile );
+
     // check if we have to load a field from HDF5
     tMagfield->initialize() ; // must be called before loading mesh data
 
     if( tHaveThermal )
     {
+        tThermalField->set_checkpoint( tThermalSetupFile );
         tThermalField->initialize() ;
     }
 
@@ -191,6 +204,8 @@ int main( int    argc,
     //tMesh->save( tOutFile );
    uint tTimeLoopCSV = 1 ;
 
+   // writes mesh dumps and backups while the next timestep is computed
+   AsyncWriter tWriter ;
 
 
    while( tTime < tMaxTime )
@@ -214,7 +229,7 @@ int main( int    argc,
            tFormulation->save( tString ); */
 
            // save backup
-           tFormulation->save( tBackupFile );
+           tFormulation->save( tBackupFile, tWriter );
 
            // todo: move this somewhere else
            if( tMesh->number_of_dimensions() == 3 )
@@ -234,10 +249,10 @@ int main( int    argc,
                compute_normb( tMagfield, false );
            }
 
-           // save mesh
+           // append the fields to the time series
            real tOldTime = tTime;
            tTime *= 1000.0;
-           tMesh->save( tOutFile );
+           tMesh->append( tOutFile, tWriter );
            tTime = tOldTime;
            tTimeLoop = 1;
        }
@@ -552,7 +567,20 @@ int main( int    argc,
         compute_normb( tMagfield, false );
     }
 
-    tMesh->save( tOutFile );
+    // wait until all pending dumps are on disk
+    tWriter.flush() ;
+
+    tMesh->append( tOutFile );
+    tMesh->close_time_series() ;
+
+    // time the slowest proc waited for the others during the run,
+    // reduced only once so that the iterations are not synchronized
+    real tIdleTime = Profiler::idle_time() ;
+
+    if ( tKernel->is_master() )
+    {
+        gLog.message( 1, "    idle time of slowest proc: %4.2f seconds", ( float ) tIdleTime * 0.001 );
+    }
 
     // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
     // tidy up
@@ -568,6 +596,9 @@ int main( int    argc,
     delete tKernel ;
     delete tMesh ;
 
+    // print the region tree and write it for regression tracking
+    Profiler::report( tOutFile.substr( 0, tOutFile.find_last_of( "." ) ) + "_profile.json" );
+
     // close communicator
     return gComm.finalize();
 }
@@ -1,9 +1,13 @@
 //
 // Created by Christian Messe on 2019-07-25.
 //
+#include <memory>
+#include <cmath>
+
 #include "cl_Block.hpp"
 #include "cl_Mesh.hpp"
 #include "cl_Mesh_ExodusWriter.hpp"
+#include "cl_AsyncWriter.hpp"
 #include "fn_unique.hpp"
 #include "stringtools.hpp"
 #include "cl_Mesh_GmshReader.hpp"
@@ -18,8 +22,10 @@
 #include "commtools.hpp"
 #include "assert.hpp"
 #include "cl_EdgeFactory.hpp"
+#include "fn_hash.hpp"
 #include "cl_FaceFactory.hpp"
 #include "fn_max.hpp"
+#include "meshtools.hpp"
 
 namespace belfem
 {
@@ -131,6 +137,9 @@ namespace belfem
 
     Mesh::~Mesh()
     {
+        // close the time series
+        this->close_time_series() ;
+
         // delete global variables
         for( auto tVariable: mGlobalVariables )
         {
@@ -253,7 +262,7 @@ namespace belfem
             if( tType == "hdf5" )
             {
                 // create writer object and save file
-                mesh::HDF5Writer tWriter( aFilePath, this );
+                mesh::HDF5Writer tWriter( aFilePath, this, mFieldDigits );
             }
             else if( tType == "vtk" && comm_rank() == mMasterProc )
             {
@@ -321,6 +330,156 @@ namespace belfem
         }
     }
 
+//------------------------------------------------------------------------------
+
+    void
+    Mesh::append( const string & aFilePath )
+    {
+        if( string_to_lower( filetype( aFilePath ) ) != "exo" )
+        {
+            this->save( aFilePath );
+            return;
+        }
+
+        if( comm_rank() == mMasterProc )
+        {
+            // start the timer
+            Timer tTimer;
+
+            message( 2, "\n    Appending time %g to %s ...",
+                     ( double ) mTimeStamp, filename( aFilePath ).c_str() );
+
+            // finish the steps that are written in the background
+            if( mAsyncWriter != nullptr )
+            {
+                mAsyncWriter->flush() ;
+                mAsyncWriter = nullptr ;
+            }
+
+            if( mTimeSeriesWriter == nullptr )
+            {
+                mTimeSeriesWriter = new mesh::ExodusWriter( this );
+            }
+
+            mTimeSeriesWriter->append( aFilePath );
+
+            message( 2, "    Time %u ms.\n",
+                     ( unsigned int ) tTimer.stop() );
+        }
+    }
+
+//------------------------------------------------------------------------------
+
+    void
+    Mesh::append( const string & aFilePath, AsyncWriter & aWriter )
+    {
+        if( string_to_lower( filetype( aFilePath ) ) != "exo" )
+        {
+            // other writers read the mesh directly
+            aWriter.flush() ;
+            this->save( aFilePath );
+            return;
+        }
+
+        if( comm_rank() == mMasterProc )
+        {
+            // the writer thread may still use the old writer object
+            if( mAsyncWriter != nullptr && mAsyncWriter != & aWriter )
+            {
+                mAsyncWriter->flush() ;
+            }
+            mAsyncWriter = & aWriter ;
+
+            if( mTimeSeriesWriter == nullptr )
+            {
+                mTimeSeriesWriter = new mesh::ExodusWriter( this );
+            }
+
+            // copy the fields on this thread
+            std::shared_ptr< mesh::ExodusSnapshot > tSnapshot
+                = std::make_shared< mesh::ExodusSnapshot >() ;
+
+            mTimeSeriesWriter->stage( *tSnapshot );
+
+            // pending steps belong to the old file
+            if( mTimeSeriesWriter->needs_new_file( aFilePath, *tSnapshot ) )
+            {
+                aWriter.flush() ;
+            }
+
+            // the file is created here, the thread only writes the fields
+            mTimeSeriesWriter->open_step( aFilePath, *tSnapshot );
+
+            const mesh::ExodusWriter * tWriter = mTimeSeriesWriter ;
+
+            aWriter.push( [ tWriter, tSnapshot ]()
+                              {
+                                  return tWriter->write( *tSnapshot );
+                              },
+                          tSnapshot->memory() );
+        }
+    }
+
+//------------------------------------------------------------------------------
+
+    void
+    Mesh::close_time_series()
+    {
+        // wait until all pending steps are written
+        if( mAsyncWriter != nullptr )
+        {
+            mAsyncWriter->flush() ;
+            mAsyncWriter = nullptr ;
+        }
+
+        if( mTimeSeriesWriter != nullptr )
+        {
+            delete mTimeSeriesWriter ;
+            mTimeSeriesWriter = nullptr ;
+        }
+    }
+
+//------------------------------------------------------------------------------
+
+    luint
+    Mesh::checksum()
+    {
+        luint aHash = hash_value( mNumberOfDimensions );
+
+        for( mesh::Node * tNode : mNodes )
+        {
+            aHash = hash_value( tNode->id(), aHash );
+            aHash = hash_value( tNode->x(), aHash );
+            aHash = hash_value( tNode->y(), aHash );
+            aHash = hash_value( tNode->z(), aHash );
+        }
+
+        for( mesh::Element * tElement : mElements )
+        {
+            aHash = hash_value( tElement->id(), aHash );
+            aHash = hash_value( tElement->type(), aHash );
+
+            for( uint k=0; k<tElement->number_of_nodes(); ++k )
+            {
+                aHash = hash_value( tElement->node( k )->id(), aHash );
+            }
+        }
+
+        for( mesh::Block * tBlock : mBlocks )
+        {
+            aHash = hash_value( tBlock->id(), aHash );
+            aHash = hash_value( tBlock->number_of_elements(), aHash );
+        }
+
+        for( mesh::SideSet * tSideSet : mSideSets )
+        {
+            aHash = hash_value( tSideSet->id(), aHash );
+            aHash = hash_value( tSideSet->number_of_facets(), aHash );
+        }
+
+        return aHash ;
+    }
+
 //------------------------------------------------------------------------------
 
     void
@@ -1818,6 +1977,59 @@ namespace belfem
         }
     }
 
+//------------------------------------------------------------------------------
+
+    void
+    Mesh::set_partition_weights( const uint aDofsPerNode,
+                                 const uint aDofsPerEdge,
+                                 const Map< id_t, real > & aBlockCosts,
+                                 const Map< id_t, Vector< uint > > & aBlockDofs,
+                                 const bool aBalanceDofs )
+    {
+        mWeightedPartition     = true ;
+        mPartitionDofsPerNode  = aDofsPerNode ;
+        mPartitionDofsPerEdge  = aDofsPerEdge ;
+        mPartitionBlockCosts   = aBlockCosts ;
+        mPartitionBlockDofs    = aBlockDofs ;
+        mBalancePartitionDofs  = aBalanceDofs ;
+    }
+
+//------------------------------------------------------------------------------
+
+    uint
+    Mesh::partition_dofs( const mesh::Element * aElement ) const
+    {
+        if( mPartitionBlockDofs.key_exists( aElement->block_id() ) )
+        {
+            // node, edge and face dofs of this block
+            const Vector< uint > & tDofs = mPartitionBlockDofs( aElement->block_id() );
+
+            return aElement->number_of_nodes() * tDofs( 0 )
+                 + mesh::number_of_edges( aElement->type() ) * tDofs( 1 )
+                 + mesh::number_of_faces( aElement->type() ) * tDofs( 2 );
+        }
+        else
+        {
+            return aElement->number_of_nodes() * mPartitionDofsPerNode
+                 + mesh::number_of_edges( aElement->type() ) * mPartitionDofsPerEdge ;
+        }
+    }
+
+//------------------------------------------------------------------------------
+
+    real
+    Mesh::partition_work( const mesh::Element * aElement ) const
+    {
+        // cost factor of the block, elements without block count as air
+        real tCost = mPartitionBlockCosts.key_exists( aElement->block_id() ) ?
+                mPartitionBlockCosts( aElement->block_id() ) : 1.0 ;
+
+        real tNumDofs = this->partition_dofs( aElement );
+
+        // assembly work scales with the size of the element matrix
+        return std::ceil( tCost * tNumDofs * tNumDofs );
+    }
+
 //------------------------------------------------------------------------------
 
     void
@@ -2406,72 +2618,109 @@ namespace belfem
 
                 if( mGhostSideSetIDs.length() > 0 )
                 {
+                    Vector< id_t > tFacetIDs ;
+                    Matrix< id_t > tTapeFacetTable ;
 
-                    // count facets per proc
-                    index_t tCount = 0 ;
+                    this->collect_ghost_facets( aTarget, tFacetIDs, tTapeFacetTable );
 
-                    for ( id_t tID: mGhostFacetIDs )
-                    {
-                        if( this->facet( tID )->owner() == aTarget )
-                        {
-                            ++tCount ;
-                        }
-                    }
+                    // send data
+                    send( aTarget, tFacetIDs );
+                    send( aTarget, tTapeFacetTable );
+                }
+            }
+            else
+            {
+                Vector< id_t > tGhostBlockIDs ;
+                Vector< id_t > tGhostSideSetIDs ;
+                Vector< id_t > tFacetIDs ;
+                Matrix< id_t > tTapeFacetTable ;
 
-                    // create data that need to be sent
-                    Vector< id_t > tFacetIDs( tCount );
+                receive( aMasterProc, tGhostBlockIDs );
+                receive( aMasterProc, tGhostSideSetIDs );
 
+                if( tGhostSideSetIDs.length() > 0 )
+                {
+                    receive( aMasterProc, tFacetIDs );
+                    receive( aMasterProc, tTapeFacetTable );
+                }
 
-                    // reset the counter
-                    tCount = 0 ;
+                this->set_ghost_facets( tGhostBlockIDs, tGhostSideSetIDs,
+                                        tFacetIDs, tTapeFacetTable );
+            }
+        }
+    }
 
-                    for ( id_t tID: mGhostFacetIDs )
-                    {
-                        if( this->facet( tID )->owner() == aTarget )
-                        {
-                            tFacetIDs( tCount++ ) = tID ;
-                        }
-                    }
+//------------------------------------------------------------------------------
 
-                    uint tNumLayers = this->number_of_thin_shell_layers();
+    void
+    Mesh::collect_ghost_facets( const proc_t aTarget,
+                                Vector< id_t > & aFacetIDs,
+                                Matrix< id_t > & aTapeFacetTable )
+    {
+        // count facets per proc
+        index_t tCount = 0 ;
 
-                    Matrix< id_t > tTapeFacetTable( 2, tNumLayers * tCount );
+        for ( id_t tID: mGhostFacetIDs )
+        {
+            if( this->facet( tID )->owner() == aTarget )
+            {
+                ++tCount ;
+            }
+        }
 
-                    tCount = 0 ;
-                    for( uint l=0; l<tNumLayers; ++l )
-                    {
-                        for ( id_t tID: tFacetIDs )
-                        {
-                            tTapeFacetTable( 0, tCount )
-                                = this->ghost_facet( tID, l )->id() ;
-                            tTapeFacetTable( 1, tCount++ ) = tID ;
-                        }
-                    }
+        // create data that need to be sent
+        aFacetIDs.set_size( tCount );
 
-                    // send data
-                    send( aTarget, tFacetIDs );
-                    send( aTarget, tTapeFacetTable );
-                }
+        // reset the counter
+        tCount = 0 ;
+
+        for ( id_t tID: mGhostFacetIDs )
+        {
+            if( this->facet( tID )->owner() == aTarget )
+            {
+                aFacetIDs( tCount++ ) = tID ;
             }
-            else
+        }
+
+        uint tNumLayers = this->number_of_thin_shell_layers();
+
+        aTapeFacetTable.set_size( 2, tNumLayers * tCount );
+
+        tCount = 0 ;
+        for( uint l=0; l<tNumLayers; ++l )
+        {
+            for ( id_t tID: aFacetIDs )
             {
-                receive( aMasterProc, mGhostBlockIDs );
-                receive( aMasterProc, mGhostSideSetIDs );
+                aTapeFacetTable( 0, tCount )
+                    = this->ghost_facet( tID, l )->id() ;
+                aTapeFacetTable( 1, tCount++ ) = tID ;
+            }
+        }
+    }
 
-                // create the map
-                mGhostFacetMap.clear() ;
+//------------------------------------------------------------------------------
 
-                if( mGhostSideSetIDs.length() > 0 )
-                {
-                    receive( aMasterProc, mGhostFacetIDs );
-                    receive( aMasterProc, mTapeFacetTable );
+    void
+    Mesh::set_ghost_facets( const Vector< id_t > & aGhostBlocks,
+                            const Vector< id_t > & aGhostSideSets,
+                            const Vector< id_t > & aFacetIDs,
+                            const Matrix< id_t > & aTapeFacetTable )
+    {
+        mGhostBlockIDs   = aGhostBlocks ;
+        mGhostSideSetIDs = aGhostSideSets ;
 
-                    index_t tCount = 0;
-                    for ( id_t tID: mGhostFacetIDs )
-                    {
-                        mGhostFacetMap[ tID ] = tCount++;
-                    }
-                }
+        // create the map
+        mGhostFacetMap.clear() ;
+
+        if( mGhostSideSetIDs.length() > 0 )
+        {
+            mGhostFacetIDs  = aFacetIDs ;
+            mTapeFacetTable = aTapeFacetTable ;
+
+            index_t tCount = 0;
+            for ( id_t tID: mGhostFacetIDs )
+            {
+                mGhostFacetMap[ tID ] = tCount++;
             }
         }
     }
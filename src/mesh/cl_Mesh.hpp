@@ -22,9 +22,13 @@ namespace belfem
 {
 //------------------------------------------------------------------------------
 
+    class AsyncWriter ;
+
     namespace mesh
     {
         class GmshReader;
+        class ExodusWriter;
+        class Partitioner;
     }
 
     class Mesh
@@ -61,13 +65,32 @@ namespace belfem
         // how many partitions is this mesh split into?
         proc_t mNumberOfPartitions = 1;
 
+        // weights for the partitioner, all elements cost the same if not set
+        bool mWeightedPartition = false ;
+        bool mBalancePartitionDofs = false ;
+        uint mPartitionDofsPerNode = 1 ;
+        uint mPartitionDofsPerEdge = 0 ;
+        Map< id_t, real > mPartitionBlockCosts ;
+
+        // dofs per node, edge and face of blocks that differ from the defaults
+        Map< id_t, Vector< uint > > mPartitionBlockDofs ;
+
         uint mNumberOfDimensions = 0;
         uint mNumberOfGlobalVariables = 0;
         uint mNumberOfFields = 0;
 
         real mTimeStamp = 0.0;
+
+        // writer for exodus time series, created by append
+        mesh::ExodusWriter * mTimeSeriesWriter = nullptr ;
+
+        // thread that writes the time series in the background, not owned
+        AsyncWriter * mAsyncWriter = nullptr ;
         uint mTimeStep = 1; // << -- timestep is 1-based for exodus compatibility
 
+        //! decimal digits of the fields in hdf5 files, negative means lossless
+        int mFieldDigits = -1 ;
+
         // flag that tells if connectivities other than element to node are to be computed
         // this flag must be on if a FEM model is supposed to be run on the mesh
         const bool mComputeConnectivities;
@@ -76,6 +99,7 @@ namespace belfem
         bool mFacetsAreLinked = false;
 
         friend mesh::GmshReader;
+        friend mesh::Partitioner;
 
         Map< id_t, mesh::Node * >    mNodeMap;
         Map< id_t, mesh::Element * > mElementMap;
@@ -165,6 +189,54 @@ namespace belfem
         void
         save( const string & aFilePath );
 
+//------------------------------------------------------------------------------
+
+        /**
+         * keep only the given number of decimal digits of the fields
+         * when saving hdf5 files. The geometry is always lossless.
+         */
+        void
+        set_field_precision( const int aDigits );
+
+//------------------------------------------------------------------------------
+
+        /**
+         * append the current fields as a new time step to an exodus file.
+         * The geometry is only written by the first call.
+         * Other file types are saved as usual
+         */
+        void
+        append( const string & aFilePath );
+
+//------------------------------------------------------------------------------
+
+        /**
+         * copy the current fields and let the writer thread append them
+         * to the exodus file while the computation continues.
+         * Fields must not be created or deleted while writes are pending.
+         * The writer must live until close_time_series() is called
+         * or the mesh is destroyed.
+         */
+        void
+        append( const string & aFilePath, AsyncWriter & aWriter );
+
+//------------------------------------------------------------------------------
+
+        /**
+         * close the time series that was written by append
+         */
+        void
+        close_time_series();
+
+//------------------------------------------------------------------------------
+
+        /**
+         * hash of the node coordinates, the connectivity, the blocks
+         * and the sidesets, used to tell if cached data fit the mesh
+         */
+        luint
+        checksum() ;
+
 //------------------------------------------------------------------------------
 
         uint
@@ -608,6 +680,39 @@ namespace belfem
                    const bool aForceContinuousPartition = true );
 
 
+//------------------------------------------------------------------------------
+
+        /**
+         * tell the partitioner to weight the elements. The work of an
+         * element is its number of dofs squared, scaled by the cost
+         * of its block ( default 1 ). If aBalanceDofs is set, the number
+         * of dofs is balanced as second constraint.
+         * aBlockDofs contains the dofs per node, edge and face of blocks
+         * that do not use the default dofs per node and edge.
+         */
+        void
+        set_partition_weights( const uint aDofsPerNode,
+                               const uint aDofsPerEdge,
+                               const Map< id_t, real > & aBlockCosts,
+                               const Map< id_t, Vector< uint > > & aBlockDofs,
+                               const bool aBalanceDofs = true );
+
+//------------------------------------------------------------------------------
+
+        /**
+         * number of dofs on an element, as seen by the partitioner
+         */
+        uint
+        partition_dofs( const mesh::Element * aElement ) const ;
+
+//------------------------------------------------------------------------------
+
+        /**
+         * assembly work of an element, as seen by the partitioner
+         */
+        real
+        partition_work( const mesh::Element * aElement ) const ;
+
 //------------------------------------------------------------------------------
 
         void
@@ -853,6 +958,27 @@ namespace belfem
          void
          distribute_ghost_sidesets( const proc_t aTarget, const proc_t aMasterProc=0 );
 
+//------------------------------------------------------------------------------
+
+        /**
+         * collect the ghost facets of the master mesh that belong to the target
+         */
+         void
+         collect_ghost_facets( const proc_t aTarget,
+                               Vector< id_t > & aFacetIDs,
+                               Matrix< id_t > & aTapeFacetTable );
+
+//------------------------------------------------------------------------------
+
+        /**
+         * set the ghost data of a submesh
+         */
+         void
+         set_ghost_facets( const Vector< id_t > & aGhostBlocks,
+                           const Vector< id_t > & aGhostSideSets,
+                           const Vector< id_t > & aFacetIDs,
+                           const Matrix< id_t > & aTapeFacetTable );
+
 
 //------------------------------------------------------------------------------
 
@@ -1271,6 +1397,14 @@ namespace belfem
         mTimeStep = aTimeStep;
     }
 
+//------------------------------------------------------------------------------
+
+    inline void
+    Mesh::set_field_precision( const int aDigits )
+    {
+        mFieldDigits = aDigits ;
+    }
+
 //------------------------------------------------------------------------------
 
     inline void
@@ -15,11 +15,31 @@
 #include "cl_StringList.hpp"
 #include "cl_Mesh_Field.hpp"
 #include "commtools.hpp"
+#include "cl_Logger.hpp"
+#include "cl_Profiler.hpp"
+#include "stringtools.hpp"
 
 namespace belfem
 {
     namespace mesh
     {
+#ifdef BELFEM_EXODUS
+        namespace
+        {
+//------------------------------------------------------------------------------
+
+            /**
+             * error message of a failed exodus call. Used on the writer
+             * thread, which must not throw or exit
+             */
+            string
+            exodus_error( const string & aRoutine, const int aError )
+            {
+                return sprint( "Exodus call %s has thrown an error: %d",
+                               aRoutine.c_str(), aError );
+            }
+        }
+#endif
 //------------------------------------------------------------------------------
 
         ExodusWriter::ExodusWriter( Mesh * aMesh )
@@ -30,14 +50,363 @@ namespace belfem
 
         }
 
+//------------------------------------------------------------------------------
+
+        ExodusWriter::~ExodusWriter()
+        {
+            this->close() ;
+        }
+
 //------------------------------------------------------------------------------
 
         void
         ExodusWriter::save( const string & aPath )
         {
+            ProfilerRegion tRegion( "write_exodus" );
+
 #ifdef BELFEM_EXODUS
+            // a snapshot never shares the file with a time series
+            this->close() ;
+
             mPath = aPath;
 
+            ExodusSnapshot tSnapshot ;
+            this->stage( tSnapshot );
+            this->create_file( tSnapshot ) ;
+
+            tSnapshot.mHandle   = mHandle ;
+            tSnapshot.mTimeStep = mTimeStep ;
+
+            string tStatus = this->write( tSnapshot );
+
+            this->close_file();
+
+            BELFEM_ERROR( tStatus.empty(), "%s", tStatus.c_str() );
+#else
+            BELFEM_ERROR( false, "Exodus is not linked in this runtime." );
+#endif
+        }
+
+//------------------------------------------------------------------------------
+
+        void
+        ExodusWriter::append( const string & aPath )
+        {
+            ProfilerRegion tRegion( "append_exodus" );
+
+#ifdef BELFEM_EXODUS
+            ExodusSnapshot tSnapshot ;
+            this->stage( tSnapshot );
+            this->open_step( aPath, tSnapshot );
+
+            string tStatus = this->write( tSnapshot );
+
+            BELFEM_ERROR( tStatus.empty(), "%s", tStatus.c_str() );
+#else
+            BELFEM_ERROR( false, "Exodus is not linked in this runtime." );
+#endif
+        }
+
+//------------------------------------------------------------------------------
+
+        void
+        ExodusWriter::stage( ExodusSnapshot & aSnapshot ) const
+        {
+#ifdef BELFEM_EXODUS
+            aSnapshot.mTimeStamp = mMesh->time_stamp() ;
+
+            uint tNumGlobalVariables = mMesh->number_of_global_variables();
+            aSnapshot.mGlobalLabels.set_size( tNumGlobalVariables, "" );
+            aSnapshot.mGlobalValues.set_size( tNumGlobalVariables );
+
+            for( uint k=0; k<tNumGlobalVariables; ++k )
+            {
+                aSnapshot.mGlobalLabels( k ) = mMesh->global_variable( k )->label() ;
+                aSnapshot.mGlobalValues( k ) = mMesh->global_variable( k )->value() ;
+            }
+
+            Cell< mesh::Field * > tNodeFields ;
+            Cell< mesh::Field * > tElementFields ;
+            this->collect_fields( tNodeFields, tElementFields );
+
+            // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+            // node variables, the first two are the IDs and the owners
+            // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+            index_t tNumNodes = mMesh->number_of_nodes() ;
+
+            aSnapshot.mNodeLabels.set_size( tNodeFields.size(), "" );
+            aSnapshot.mNodeData.set_size( tNodeFields.size() + 2, Vector< real >( tNumNodes ) );
+
+            index_t tCount = 0 ;
+            for( mesh::Node * tNode : mMesh->nodes() )
+            {
+                aSnapshot.mNodeData( 0 )( tCount ) = ( real ) tNode->id() ;
+                aSnapshot.mNodeData( 1 )( tCount++ ) = ( real ) tNode->owner() ;
+            }
+
+            for( uint f=0; f<tNodeFields.size(); ++f )
+            {
+                aSnapshot.mNodeLabels( f ) = tNodeFields( f )->label() ;
+                aSnapshot.mNodeData( f + 2 ) = tNodeFields( f )->data() ;
+            }
+
+            // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+            // element variables per block, the first four are the IDs,
+            // the owners, the geometry tags and the physical tags
+            // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+            Cell< mesh::Block * > & tBlocks = mMesh->blocks();
+
+            uint tNumBlocks = tBlocks.size() ;
+            uint tNumVariables = tElementFields.size() + 4 ;
+
+            aSnapshot.mElementLabels.set_size( tElementFields.size(), "" );
+            for( uint f=0; f<tElementFields.size(); ++f )
+            {
+                aSnapshot.mElementLabels( f ) = tElementFields( f )->label() ;
+            }
+
+            aSnapshot.mBlockIDs.set_size( tNumBlocks );
+            aSnapshot.mElementData.set_size( tNumVariables * tNumBlocks, Vector< real >() );
+
+            for( uint b=0; b<tNumBlocks; ++b )
+            {
+                mesh::Block * tBlock = tBlocks( b );
+
+                aSnapshot.mBlockIDs( b ) = tBlock->id() ;
+
+                index_t tNumElements = tBlock->number_of_elements() ;
+
+                for( uint v=0; v<tNumVariables; ++v )
+                {
+                    aSnapshot.mElementData( v * tNumBlocks + b ).set_size( tNumElements );
+                }
+
+                for( index_t e=0; e<tNumElements; ++e )
+                {
+                    mesh::Element * tElement = tBlock->element( e );
+
+                    aSnapshot.mElementData( b )( e )                  = ( real ) tElement->id() ;
+                    aSnapshot.mElementData( tNumBlocks + b )( e )     = ( real ) tElement->owner() ;
+                    aSnapshot.mElementData( 2 * tNumBlocks + b )( e ) = ( real ) tElement->geometry_tag() ;
+                    aSnapshot.mElementData( 3 * tNumBlocks + b )( e ) = ( real ) tElement->physical_tag() ;
+
+                    for( uint f=0; f<tElementFields.size(); ++f )
+                    {
+                        aSnapshot.mElementData( ( f + 4 ) * tNumBlocks + b )( e )
+                            = tElementFields( f )->data()( tElement->index() );
+                    }
+                }
+            }
+
+            // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+            // layout of the file, which must not change during a time series
+            // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+            aSnapshot.mLayout.clear() ;
+            aSnapshot.mLayout.push( sprint( "%lu", ( long unsigned int ) mMesh->number_of_nodes() ) );
+            aSnapshot.mLayout.push( sprint( "%lu", ( long unsigned int ) mMesh->number_of_elements() ) );
+
+            for( uint k=0; k<aSnapshot.mGlobalLabels.size(); ++k )
+            {
+                aSnapshot.mLayout.push( aSnapshot.mGlobalLabels( k ) );
+            }
+            for( uint k=0; k<aSnapshot.mNodeLabels.size(); ++k )
+            {
+                aSnapshot.mLayout.push( aSnapshot.mNodeLabels( k ) );
+            }
+            for( uint k=0; k<aSnapshot.mElementLabels.size(); ++k )
+            {
+                aSnapshot.mLayout.push( aSnapshot.mElementLabels( k ) );
+            }
+#endif
+        }
+
+//------------------------------------------------------------------------------
+
+        bool
+        ExodusWriter::needs_new_file( const string & aPath, const ExodusSnapshot & aSnapshot ) const
+        {
+#ifdef BELFEM_EXODUS
+            if( ! mIsOpen || aPath != mPath )
+            {
+                return true ;
+            }
+
+            // the variables of an exodus file can not be changed
+            // once the first step has been written
+            if( aSnapshot.mLayout.size() != mVariableLabels.size() )
+            {
+                return true ;
+            }
+
+            for( uint k=0; k<mVariableLabels.size(); ++k )
+            {
+                if( aSnapshot.mLayout( k ) != mVariableLabels( k ) )
+                {
+                    return true ;
+                }
+            }
+#endif
+            return false ;
+        }
+
+//------------------------------------------------------------------------------
+
+        void
+        ExodusWriter::open_step( const string & aPath, ExodusSnapshot & aSnapshot )
+        {
+#ifdef BELFEM_EXODUS
+            if( this->needs_new_file( aPath, aSnapshot ) )
+            {
+                if( mIsOpen && aPath == mPath )
+                {
+                    message( 4, " Warning: fields of mesh have changed, recreating %s\n", mPath.c_str() );
+                }
+
+                this->close() ;
+
+                mPath = aPath ;
+                this->create_file( aSnapshot ) ;
+                mIsOpen = true ;
+            }
+            else
+            {
+                ++mTimeStep ;
+            }
+
+            aSnapshot.mHandle   = mHandle ;
+            aSnapshot.mTimeStep = mTimeStep ;
+#else
+            BELFEM_ERROR( false, "Exodus is not linked in this runtime." );
+#endif
+        }
+
+//------------------------------------------------------------------------------
+
+        string
+        ExodusWriter::write( const ExodusSnapshot & aSnapshot ) const
+        {
+#ifdef BELFEM_EXODUS
+            const int tHandle = aSnapshot.mHandle ;
+            const int tStep   = aSnapshot.mTimeStep ;
+
+            real tTime = aSnapshot.mTimeStamp ;
+
+            int tError = ex_put_time( tHandle, tStep, & tTime );
+
+            if( tError != 0 )
+            {
+                return exodus_error( "ex_put_time", tError );
+            }
+
+            if( aSnapshot.mGlobalValues.length() > 0 )
+            {
+                tError = ex_put_var(
+                        tHandle,
+                        tStep,
+                        EX_GLOBAL,
+                        1,
+                        0,
+                        aSnapshot.mGlobalValues.length(),
+                        aSnapshot.mGlobalValues.data() );
+
+                if( tError != 0 )
+                {
+                    return exodus_error( "ex_put_var (global)", tError );
+                }
+            }
+
+            for( uint v=0; v<aSnapshot.mNodeData.size(); ++v )
+            {
+                tError = ex_put_var(
+                        tHandle,
+                        tStep,
+                        EX_NODAL,
+                        v + 1,
+                        1,
+                        aSnapshot.mNodeData( v ).length(),
+                        aSnapshot.mNodeData( v ).data() );
+
+                if( tError != 0 )
+                {
+                    return exodus_error( "ex_put_var (node)", tError );
+                }
+            }
+
+            uint tNumBlocks = aSnapshot.mBlockIDs.length() ;
+
+            for( uint k=0; k<aSnapshot.mElementData.size(); ++k )
+            {
+                tError = ex_put_var(
+                        tHandle,
+                        tStep,
+                        EX_ELEM_BLOCK,
+                        k / tNumBlocks + 1,
+                        aSnapshot.mBlockIDs( k % tNumBlocks ),
+                        aSnapshot.mElementData( k ).length(),
+                        aSnapshot.mElementData( k ).data() );
+
+                if( tError != 0 )
+                {
+                    return exodus_error( "ex_put_var (element)", tError );
+                }
+            }
+
+            // flush the step, so that the file is readable while we run
+            tError = ex_update( tHandle );
+
+            if( tError != 0 )
+            {
+                return exodus_error( "ex_update", tError );
+            }
+
+            return "" ;
+#else
+            return "Exodus is not linked in this runtime." ;
+#endif
+        }
+
+//------------------------------------------------------------------------------
+
+        luint
+        ExodusSnapshot::memory() const
+        {
+            luint aBytes = mGlobalValues.length() ;
+
+            for( uint f=0; f<mNodeData.size(); ++f )
+            {
+                aBytes += mNodeData( f ).length() ;
+            }
+            for( uint f=0; f<mElementData.size(); ++f )
+            {
+                aBytes += mElementData( f ).length() ;
+            }
+
+            return aBytes * sizeof( real ) ;
+        }
+
+//------------------------------------------------------------------------------
+
+        void
+        ExodusWriter::close()
+        {
+#ifdef BELFEM_EXODUS
+            if( mIsOpen )
+            {
+                this->close_file() ;
+                mIsOpen = false ;
+            }
+#endif
+        }
+
+//------------------------------------------------------------------------------
+
+        void
+        ExodusWriter::create_file( const ExodusSnapshot & aSnapshot )
+        {
+#ifdef BELFEM_EXODUS
             // count number of entities
             uint tCount = mMesh->number_of_blocks() ;
             for ( SideSet * tSideSet : mMesh->sidesets() )
@@ -58,10 +427,14 @@ namespace belfem
             {
                 this->populate_sidesets( tProgressbar );
             }
-            this->populate_time();
-            this->populate_global_variables();
-            this->populate_fields();
-            this->close_file();
+
+            // define the variables, which must not change during a time series
+            mVariableLabels = aSnapshot.mLayout ;
+            this->define_global_variables( aSnapshot.mGlobalLabels );
+            this->define_node_fields( aSnapshot.mNodeLabels );
+            this->define_element_fields( aSnapshot.mElementLabels );
+
+            mTimeStep = 1 ;
 
             // delete progressbar
             if( tProgressbar != nullptr )
@@ -69,9 +442,6 @@ namespace belfem
                 tProgressbar->finish() ;
                 delete tProgressbar ;
             }
-
-#else
-            BELFEM_ERROR( false, "Exodus is not linked in this runtime." );
 #endif
         }
 
@@ -93,6 +463,7 @@ namespace belfem
         {
 #ifdef BELFEM_EXODUS
             ex_close( mHandle );
+            mHandle = -1 ;
 #endif
         }
 
@@ -468,7 +839,9 @@ namespace belfem
 //------------------------------------------------------------------------------
 
         void
-        ExodusWriter::populate_fields()
+        ExodusWriter::collect_fields(
+                Cell< mesh::Field * > & aNodeFields,
+                Cell< mesh::Field * > & aElementFields ) const
         {
 #ifdef BELFEM_EXODUS
 
@@ -513,9 +886,9 @@ namespace belfem
                 }
             }
 
-            // allocate matrices
-            Cell< mesh::Field * > tNodeFields( tNodeFieldCount, nullptr );
-            Cell< mesh::Field * > tElementFields( tElementFieldCount, nullptr );
+            // allocate containers
+            aNodeFields.set_size( tNodeFieldCount, nullptr );
+            aElementFields.set_size( tElementFieldCount, nullptr );
 
             // reset counters
             tNodeFieldCount = 0;
@@ -531,12 +904,12 @@ namespace belfem
                     {
                         case ( EntityType::NODE ) :
                         {
-                            tNodeFields( tNodeFieldCount++ ) = tField;
+                            aNodeFields( tNodeFieldCount++ ) = tField;
                             break;
                         }
                         case ( EntityType::ELEMENT ):
                         {
-                            tElementFields( tElementFieldCount++ ) = tField;
+                            aElementFields( tElementFieldCount++ ) = tField;
                             break;
                         }
                         default:
@@ -547,43 +920,16 @@ namespace belfem
                     }
                 }
             }
-            this->populate_node_fields( tNodeFields );
-            this->populate_element_fields( tElementFields );
-
-
-            tNodeFields.clear();
-            tElementFields.clear();
-
-            mError = ex_update( mHandle );
-            this->check( "ex_update");
 #endif
         }
 
 //------------------------------------------------------------------------------
 
         void
-        ExodusWriter:: populate_time()
+        ExodusWriter::define_global_variables( const Cell< string > & aLabels )
         {
 #ifdef BELFEM_EXODUS
-
-            mTimeValue = mMesh->time_stamp();
-
-            /* write time value */
-            mError = ex_put_time(
-                    mHandle,
-                    mTimeStep,
-                    &mTimeValue );
-
-            this->check( "ex_put_time" );
-#endif
-        }
-//------------------------------------------------------------------------------
-        void
-        ExodusWriter::populate_global_variables()
-        {
-#ifdef BELFEM_EXODUS
-            // get number of global variables from mesh
-            uint tNumGlobalVariables = mMesh->number_of_global_variables();
+            uint tNumGlobalVariables = aLabels.size() ;
 
             if ( tNumGlobalVariables > 0 )
             {
@@ -592,7 +938,7 @@ namespace belfem
 
                 for( uint k=0; k<tNumGlobalVariables; ++k )
                 {
-                    tFieldLabels.push( mMesh->global_variable( k )->label() );
+                    tFieldLabels.push( aLabels( k ) );
                 }
 
                 /* initialize field data container */
@@ -611,29 +957,6 @@ namespace belfem
                         tFieldLabels.data() );
 
                 this->check( "ex_put_variable_names (global)");
-
-                /* assemble values of global variables */
-                real * tGlobalVars = ( real * ) malloc( tNumGlobalVariables * sizeof( real ) );
-
-                for( uint k=0; k<tNumGlobalVariables; ++k )
-                {
-                    tGlobalVars[ k ] = mMesh->global_variable( k )->value();
-                }
-
-                /* push variables */
-                ex_put_var(
-                        mHandle,
-                        mTimeStep,
-                        EX_GLOBAL,
-                        1,
-                        0,
-                        tNumGlobalVariables,
-                        tGlobalVars );
-
-                this->check( "ex_put_var (global)");
-
-                // tidy up memory
-                free( tGlobalVars );
             }
 #endif
         }
@@ -641,22 +964,10 @@ namespace belfem
 //------------------------------------------------------------------------------
 
         void
-        ExodusWriter::populate_node_fields( Cell< mesh::Field * > & aFields )
+        ExodusWriter::define_node_fields( const Cell< string > & aLabels )
         {
 #ifdef BELFEM_EXODUS
-            uint tNumNodes = mMesh->number_of_nodes();
-            uint tNumNodeFields = 2;
-
-            // count fields that are to be written
-            for ( mesh::Field * tField : aFields )
-            {
-                if( tField->write_field_to_file() )
-                {
-                    ++tNumNodeFields ;
-                }
-            }
-
-            int tID = 1;
+            uint tNumNodeFields = aLabels.size() + 2;
 
             // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
             // collect field names
@@ -665,12 +976,9 @@ namespace belfem
             tFieldLabels.push("NodeID");
             tFieldLabels.push("NodeOwner");
 
-            for ( mesh::Field * tField : aFields )
+            for ( uint k=0; k<aLabels.size(); ++k )
             {
-                if( tField->write_field_to_file() )
-                {
-                    tFieldLabels.push( tField->label() );
-                }
+                tFieldLabels.push( aLabels( k ) );
             }
 
             /*  initialize data container */
@@ -689,96 +997,16 @@ namespace belfem
                     tFieldLabels.data() );
 
             this->check( "ex_put_variable_param (node)");
-
-            // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-
-            // create field with node ids
-            real * tNodeData = ( real * ) malloc( tNumNodes * sizeof( real ) );
-
-            uint k=0;
-
-            for( mesh::Node * tNode : mMesh->nodes() )
-            {
-                tNodeData[ k++ ] = ( real )  tNode->id();
-            }
-
-            // write node IDs
-            /* write nodal variables */
-            mError = ex_put_var(
-                    mHandle,
-                    mTimeStep,
-                    EX_NODAL,
-                    tID++,
-                    1,
-                    tNumNodes,
-                    tNodeData );
-
-            this->check( "ex_put_var (node IDs)");
-
-            k = 0;
-            for( mesh::Node * tNode : mMesh->nodes() )
-            {
-                tNodeData[ k++ ] = ( real )  tNode->owner();
-            }
-
-            // write node IDs
-            /* write nodal variables */
-            mError = ex_put_var(
-                    mHandle,
-                    mTimeStep,
-                    EX_NODAL,
-                    tID++,
-                    1,
-                    tNumNodes,
-                    tNodeData );
-
-            this->check( "ex_put_var (node owners)");
-
-            free( tNodeData );
-
-            // write other fields
-            for ( mesh::Field * tField : aFields )
-            {
-                // check if field is to be written
-                if( tField->write_field_to_file() )
-                {
-                    // write nodal variables
-                    mError = ex_put_var(
-                            mHandle,
-                            mTimeStep,
-                            EX_NODAL,
-                            tID++,
-                            1,
-                            mMesh->number_of_nodes(),
-                            tField->data().data() );
-
-                    this->check( "ex_put_var (node data)" );
-                }
-            }
 #endif
         }
 
 //------------------------------------------------------------------------------
 
         void
-        ExodusWriter::populate_element_fields( Cell< mesh::Field * > & aFields )
+        ExodusWriter::define_element_fields( const Cell< string > & aLabels )
         {
 #ifdef BELFEM_EXODUS
-
-            uint tNumBlocks = mMesh->number_of_blocks();
-
-            int tID = 0;
-
-            // count fields with write flag
-            uint tNumElementFields = 4;
-
-            for ( mesh::Field * tField : aFields )
-            {
-                if( tField->write_field_to_file() )
-                {
-                    ++ tNumElementFields ;
-                }
-            }
+            uint tNumElementFields = aLabels.size() + 4;
 
             // get field titles
             StringList tFieldLabels( tNumElementFields );
@@ -788,12 +1016,9 @@ namespace belfem
             tFieldLabels.push( "GeometryTag");
             tFieldLabels.push( "PhysicalTag");
 
-            for ( mesh::Field * tField : aFields )
+            for ( uint k=0; k<aLabels.size(); ++k )
             {
-                if( tField->write_field_to_file() )
-                {
-                    tFieldLabels.push( tField->label() );
-                }
+                tFieldLabels.push( aLabels( k ) );
             }
 
             /*  initialize data container */
@@ -814,7 +1039,7 @@ namespace belfem
             this->check( "ex_put_variable_names (element)");
 
             // create the truth table for the element fields
-            uint tSize = tNumElementFields * mMesh->number_of_elements();
+            uint tSize = tNumElementFields * mMesh->number_of_blocks();
 
             int * tTruthTable = ( int * ) malloc( tSize * sizeof( int  ));
 
@@ -834,134 +1059,6 @@ namespace belfem
 
             // tidy up mempry
             free( tTruthTable );
-
-            // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-            // Intrinsic Fields
-            // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-
-            Cell< mesh::Block * > & tBlocks = mMesh->blocks();
-
-            for( uint k=0; k<4; ++k )
-            {
-                // increment id counter
-                ++tID;
-
-                // loop over all blocks
-                for ( uint b = 0; b < tNumBlocks; ++b )
-                {
-                    // get block
-                    mesh::Block * tBlock = tBlocks( b );
-
-                    uint tNumElements = tBlock->number_of_elements();
-
-                    // allocate data object
-                    real * tBlockData = ( real * ) malloc( tNumElements * sizeof( real ) );
-
-                    switch( k )
-                    {
-                        case ( 0 ):
-                        {
-                            for ( uint e = 0; e < tNumElements; ++e )
-                            {
-                                tBlockData[ e ] = ( real ) tBlock->element( e )->id();
-                            }
-                            break;
-                        }
-                        case ( 1 ):
-                        {
-                            for ( uint e = 0; e < tNumElements; ++e )
-                            {
-                                tBlockData[ e ] = ( real ) tBlock->element( e )->owner();
-                            }
-                            break;
-                        }
-                        case ( 2 ):
-                        {
-                            for ( uint e = 0; e < tNumElements; ++e )
-                            {
-                                tBlockData[ e ] = ( real ) tBlock->element( e )->geometry_tag();
-                            }
-                            break;
-                        }
-                        case ( 3 ):
-                        {
-                            for ( uint e = 0; e < tNumElements; ++e )
-                            {
-                                tBlockData[ e ] = ( real ) tBlock->element( e )->physical_tag();
-                            }
-                            break;
-                        }
-                        default:
-                        {
-                            break;
-                        }
-
-                    }
-
-
-                    // push data
-                    mError = ex_put_var(
-                            mHandle,
-                            mTimeStep,
-                            EX_ELEM_BLOCK,
-                            tID,
-                            tBlock->id(),
-                            tNumElements,
-                            tBlockData );
-
-                    this->check( "ex_put_var (element, intrinsic)");
-
-                    free( tBlockData );
-                }
-            }
-
-            // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-            // Other fields
-            // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-            for( mesh::Field * tField : aFields )
-            {
-                if( tField->write_field_to_file() )
-                {
-                    // increment id counter
-                    ++tID;
-
-                    // get field data
-                    Vector< real > tData = tField->data();
-
-                    // loop over all blocks
-                    for ( uint b = 0; b < tNumBlocks; ++b )
-                    {
-                        // get block
-                        mesh::Block * tBlock = tBlocks( b );
-
-                        uint tNumElements = tBlock->number_of_elements();
-
-                        // allocate data object
-                        real * tBlockData = ( real * ) malloc( tNumElements * sizeof( real ));
-
-                        // assemble data blockwise
-                        for ( uint e = 0; e < tNumElements; ++e )
-                        {
-                            tBlockData[ e ] = tData( tBlock->element( e )->index() );
-                        }
-
-                        // push data
-                        mError = ex_put_var(
-                                mHandle,
-                                mTimeStep,
-                                EX_ELEM_BLOCK,
-                                tID,
-                                tBlock->id(),
-                                tNumElements,
-                                tBlockData );
-
-                        this->check( "ex_put_var (element)");
-                        // tidy up memory
-                        free( tBlockData );
-                    }
-                }
-            }
-
 #endif
         }
 
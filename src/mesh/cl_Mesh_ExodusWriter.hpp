@@ -14,6 +14,50 @@ namespace belfem
 {
     namespace mesh
     {
+//------------------------------------------------------------------------------
+
+        /**
+         * copy of the time dependent data of a mesh, so that a time step
+         * can be written while the mesh is already being changed
+         */
+        struct ExodusSnapshot
+        {
+            real mTimeStamp = 0.0 ;
+
+            // file and step, set by ExodusWriter::open_step
+            int mHandle = -1 ;
+            int mTimeStep = 1 ;
+
+            Cell< string > mGlobalLabels ;
+            Vector< real > mGlobalValues ;
+
+            // labels of the node and element fields
+            Cell< string > mNodeLabels ;
+            Cell< string > mElementLabels ;
+
+            // node variables, starting with node IDs and owners
+            Cell< Vector< real > > mNodeData ;
+
+            // IDs of the element blocks
+            Vector< id_t > mBlockIDs ;
+
+            // element variables per block, variable v of block b is at
+            // v * number of blocks + b. The first four variables are
+            // the element IDs, owners, geometry and physical tags
+            Cell< Vector< real > > mElementData ;
+
+            // sizes and labels that define the layout of the file
+            Cell< string > mLayout ;
+
+            /**
+             * memory of the staged data in bytes
+             */
+            luint
+            memory() const ;
+        };
+
+//------------------------------------------------------------------------------
+
         class ExodusWriter
         {
 #ifdef BELFEM_EXODUS
@@ -42,7 +86,12 @@ namespace belfem
             int64_t mNumNodeSets = 0;
 
             int mTimeStep = 1;
-            double mTimeValue = 0.0;
+
+            // tells if a time series is open for appending
+            bool mIsOpen = false ;
+
+            // layout of the variables that have been defined in the file
+            Cell< string > mVariableLabels ;
 
 #endif
 
@@ -54,13 +103,75 @@ namespace belfem
 
 //------------------------------------------------------------------------------
 
-            ~ExodusWriter() = default;
+            ~ExodusWriter();
 
 //------------------------------------------------------------------------------
 
+            /**
+             * write the mesh and the current fields into a new file
+             */
             void
             save( const string & aPath );
 
+//------------------------------------------------------------------------------
+
+            /**
+             * append the current fields as a new time step. The first call
+             * writes the geometry, all following calls only write the fields.
+             * If the path, the mesh or the set of fields changes,
+             * the file is created again.
+             */
+            void
+            append( const string & aPath );
+
+//------------------------------------------------------------------------------
+
+            /**
+             * copy everything a time step writes into a snapshot.
+             * Does not change the writer, so it can be called while
+             * another thread writes an older snapshot
+             */
+            void
+            stage( ExodusSnapshot & aSnapshot ) const ;
+
+//------------------------------------------------------------------------------
+
+            /**
+             * tells if open_step will create a new file for this snapshot.
+             * Steps of the old file that are still pending must be
+             * written before
+             */
+            bool
+            needs_new_file( const string & aPath, const ExodusSnapshot & aSnapshot ) const ;
+
+//------------------------------------------------------------------------------
+
+            /**
+             * prepare a staged snapshot as the next step of the time series.
+             * If needed, the file is created with geometry and variable
+             * definitions. Must be called on the thread that owns the mesh.
+             */
+            void
+            open_step( const string & aPath, ExodusSnapshot & aSnapshot );
+
+//------------------------------------------------------------------------------
+
+            /**
+             * write a prepared snapshot. Only reads the snapshot, so it can
+             * run on a writer thread. Returns an empty string on success,
+             * or the error message
+             */
+            string
+            write( const ExodusSnapshot & aSnapshot ) const ;
+
+//------------------------------------------------------------------------------
+
+            /**
+             * close a time series that was opened by append
+             */
+            void
+            close();
+
 //------------------------------------------------------------------------------
         private:
 //------------------------------------------------------------------------------
@@ -72,6 +183,14 @@ namespace belfem
             void
             close_file();
 
+//------------------------------------------------------------------------------
+
+            /**
+             * create the file and write geometry and variable definitions
+             */
+            void
+            create_file( const ExodusSnapshot & aSnapshot );
+
 //------------------------------------------------------------------------------
 
             void
@@ -109,28 +228,27 @@ namespace belfem
 
 //------------------------------------------------------------------------------
 
+            /**
+             * collect the fields that are to be written, sorted by label
+             */
             void
-            populate_time();
-
-//------------------------------------------------------------------------------
-
-            void
-            populate_global_variables();
+            collect_fields( Cell< mesh::Field * > & aNodeFields,
+                            Cell< mesh::Field * > & aElementFields ) const ;
 
 //------------------------------------------------------------------------------
 
             void
-            populate_fields();
+            define_global_variables( const Cell< string > & aLabels );
 
 //------------------------------------------------------------------------------
 
             void
-            populate_node_fields( Cell< mesh::Field * > & aFields );
+            define_node_fields( const Cell< string > & aLabels );
 
 //------------------------------------------------------------------------------
 
             void
-            populate_element_fields( Cell< mesh::Field * > & aFields );
+            define_element_fields( const Cell< string > & aLabels );
 
 //------------------------------------------------------------------------------
 
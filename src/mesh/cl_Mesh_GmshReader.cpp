@@ -18,24 +18,42 @@
 #include "fn_unique.hpp"
 #include "cl_Mesh_OrientationChecker.hpp"
 
+#include <cctype>
+#include <cstring>
+#include <cstdlib>
+#include <algorithm>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
 namespace belfem
 {
     namespace mesh
     {
 //------------------------------------------------------------------------------
 
+        // the file is mapped into memory, the ascii buffer is only
+        // populated for old v2.2 files
         GmshReader::GmshReader( const string & aPath, Mesh * aMesh, const real aMeshScale ) :
-            Ascii( aPath, FileMode::OPEN_RDONLY ),
+            Ascii( aPath, FileMode::OPEN_RDONLY, false ),
             mMeshScale( aMeshScale )
         {
             // remember name
             mFilename = basename( aPath );
 
-            this->tidy_up_buffer();
+            this->map_file();
             this->read_version();
 
             if( mVersion == 2.2 )
             {
+                BELFEM_ERROR( ! mBinary,
+                              "Binary GMSH files are only supported for version 4.1 ( file %s )",
+                              mFilename.c_str() );
+
+                this->load_lines();
+                this->unmap_file();
+                this->tidy_up_buffer();
                 this->read_tags_v22();
                 this->check_tag_existence();
                 this->read_nodes_v22();
@@ -45,6 +63,7 @@ namespace belfem
             else if ( mVersion == 4.1 )
             {
                 this->read_mesh_v41();
+                this->unmap_file();
                 this->check_tag_existence();
             }
             else
@@ -90,12 +109,81 @@ namespace belfem
 
         GmshReader::~GmshReader()
         {
+            this->unmap_file();
+
             if( mOwnMesh )
             {
                 delete mMesh;
             }
         }
 
+//------------------------------------------------------------------------------
+
+        void
+        GmshReader::map_file()
+        {
+            int tHandle = open( mPath.c_str(), O_RDONLY );
+
+            BELFEM_ERROR( tHandle >= 0, "Could not open file %s", mPath.c_str() );
+
+            struct stat tStat ;
+            BELFEM_ERROR( fstat( tHandle, & tStat ) == 0, "Could not stat file %s", mPath.c_str() );
+
+            mDataLength = tStat.st_size ;
+
+            BELFEM_ERROR( mDataLength > 0, "The file %s is empty", mPath.c_str() );
+
+            void * tData = mmap( nullptr, mDataLength, PROT_READ, MAP_PRIVATE, tHandle, 0 );
+
+            close( tHandle );
+
+            BELFEM_ERROR( tData != MAP_FAILED, "Could not map file %s into memory", mPath.c_str() );
+
+            mData = static_cast< const char * >( tData );
+        }
+
+//------------------------------------------------------------------------------
+
+        void
+        GmshReader::unmap_file()
+        {
+            if( mData != nullptr )
+            {
+                munmap( const_cast< char * >( mData ), mDataLength );
+                mData = nullptr ;
+                mDataLength = 0 ;
+            }
+        }
+
+//------------------------------------------------------------------------------
+
+        void
+        GmshReader::load_lines()
+        {
+            mBuffer.clear() ;
+
+            size_t tStart = 0 ;
+
+            while( tStart < mDataLength )
+            {
+                const char * tEnd = static_cast< const char * >(
+                        std::memchr( mData + tStart, '\n', mDataLength - tStart ) );
+
+                size_t tStop = tEnd == nullptr ? mDataLength : tEnd - mData ;
+
+                // remove windows line endings
+                size_t tLength = tStop - tStart ;
+                if( tLength > 0 && mData[ tStop - 1 ] == '\r' )
+                {
+                    --tLength ;
+                }
+
+                mBuffer.push( string( mData + tStart, tLength ) );
+
+                tStart = tStop + 1 ;
+            }
+        }
+
 //------------------------------------------------------------------------------
 
         void
@@ -114,11 +202,11 @@ namespace belfem
         void
         GmshReader::check_tag_existence()
         {
-            BELFEM_ERROR( mNodesTag > 0,
+            BELFEM_ERROR( mNodesTag > 0 || mNodesOffset > 0,
                     "$Nodes tag not found in file %s",
                     mFilename.c_str() );
 
-            BELFEM_ERROR( mElementsTag > 0,
+            BELFEM_ERROR( mElementsTag > 0 || mElementsOffset > 0,
                          "$Elements tag not found in file %s",
                          mFilename.c_str() );
         }
@@ -128,26 +216,39 @@ namespace belfem
         void
         GmshReader::read_version()
         {
-            // counter
-            size_t tCount = 0;
+            const string tTag = "$MeshFormat" ;
 
-            // loop over all possible lines
-            for( auto tLine: mBuffer )
-            {
-                if ( tLine == "$MeshFormat")
-                {
-                    break;
-                }
-                ++tCount;
-            }
+            const char * tFound = std::search( mData, mData + mDataLength, tTag.begin(), tTag.end() );
 
             // make sure that a version was found
-            BELFEM_ERROR( tCount < mBuffer.size(),
+            BELFEM_ERROR( tFound != mData + mDataLength,
                     "The file %s does not seem to be a GMSH mesh file",
                          mFilename.c_str() );
 
-            // read version string
-            mVersion = std::stod( first_word( mBuffer( ++tCount ) ) );
+            size_t tOffset = ( tFound - mData ) + tTag.length() ;
+
+            // read version, file type and data size, the header is always ascii
+            mBinary = false ;
+            mVersion = this->read_real( tOffset );
+            int tFileType = this->read_int( tOffset );
+            mSizeOfSize = this->read_int( tOffset );
+            mBinary = tFileType == 1 ;
+
+            if( mBinary )
+            {
+                BELFEM_ERROR( mSizeOfSize == 4 || mSizeOfSize == 8,
+                              "Unsupported data size %u in file %s",
+                              ( unsigned int ) mSizeOfSize, mFilename.c_str() );
+
+                // the binary one that tells the endianness follows the line break
+                this->skip_lines( tOffset, 1 );
+
+                int tOne = this->read_int( tOffset );
+
+                BELFEM_ERROR( tOne == 1,
+                              "The file %s was written on a machine with a different endianness",
+                              mFilename.c_str() );
+            }
         }
 
 //------------------------------------------------------------------------------
@@ -335,78 +436,379 @@ namespace belfem
         void
         GmshReader::read_mesh_v41()
         {
-            // line counter
-            size_t tCount = 0;
+            // byte offset in file
+            size_t tOffset = 0;
 
-            // number of lines
-            size_t tN = mBuffer.size();
+            string tLabel ;
 
-            while( tCount < tN )
+            while( this->next_section( tOffset, tLabel ) )
             {
-                if ( mBuffer( tCount ) == "$PhysicalNames" )
+                if ( tLabel == "Nodes" )
                 {
-                    this->read_physical_tag( tCount );
+                    this->read_nodes_v41( tOffset );
+                    this->end_section( tOffset, tLabel );
+                }
+                else if ( tLabel == "Elements" )
+                {
+                    this->read_elements_v41( tOffset );
+                    this->end_section( tOffset, tLabel );
+                }
+                else
+                {
+                    if( tLabel == "PhysicalNames" )
+                    {
+                        mPhysicalOffset = tOffset ;
+                    }
+
+                    // entities, physical names and other data are not needed
+                    this->skip_section( tOffset, tLabel );
+                }
+            }
+        }
+
+//------------------------------------------------------------------------------
+
+        bool
+        GmshReader::next_section( size_t & aOffset, string & aLabel )
+        {
+            // skip whitespace
+            while( aOffset < mDataLength && std::isspace( mData[ aOffset ] ) )
+            {
+                ++aOffset ;
+            }
+
+            if( aOffset >= mDataLength )
+            {
+                return false ;
+            }
+
+            BELFEM_ERROR( mData[ aOffset ] == '$',
+                          "Unexpected content at byte %lu in file %s",
+                          ( long unsigned int ) aOffset, mFilename.c_str() );
+
+            size_t tStart = ++aOffset ;
+
+            while( aOffset < mDataLength && ! std::isspace( mData[ aOffset ] ) )
+            {
+                ++aOffset ;
+            }
+
+            aLabel = string( mData + tStart, aOffset - tStart );
+
+            // move to next line
+            this->skip_lines( aOffset, 1 );
+
+            return true ;
+        }
+
+//------------------------------------------------------------------------------
+
+        void
+        GmshReader::skip_section( size_t & aOffset, const string & aLabel )
+        {
+            const string tTag = "$End" + aLabel ;
+
+            const char * tFound = std::search( mData + aOffset, mData + mDataLength,
+                                               tTag.begin(), tTag.end() );
+
+            BELFEM_ERROR( tFound != mData + mDataLength,
+                          "%s tag not found in file %s",
+                          tTag.c_str(), mFilename.c_str() );
+
+            aOffset = ( tFound - mData ) + tTag.length() ;
+        }
+
+//------------------------------------------------------------------------------
+
+        void
+        GmshReader::end_section( size_t & aOffset, const string & aLabel )
+        {
+            const string tTag = "$End" + aLabel ;
+
+            while( aOffset < mDataLength && std::isspace( mData[ aOffset ] ) )
+            {
+                ++aOffset ;
+            }
+
+            BELFEM_ERROR( aOffset + tTag.length() <= mDataLength
+                          && std::memcmp( mData + aOffset, tTag.c_str(), tTag.length() ) == 0,
+                          "%s tag expected at byte %lu in file %s",
+                          tTag.c_str(), ( long unsigned int ) aOffset, mFilename.c_str() );
+
+            aOffset += tTag.length() ;
+        }
+
+//------------------------------------------------------------------------------
+
+        luint
+        GmshReader::read_size( size_t & aOffset ) const
+        {
+            luint aValue = 0 ;
+
+            BELFEM_ERROR( this->parse_size( aOffset, aValue ),
+                          "Integer expected at byte %lu in file %s",
+                          ( long unsigned int ) aOffset, mFilename.c_str() );
+
+            return aValue ;
+        }
+
+//------------------------------------------------------------------------------
+
+        int
+        GmshReader::read_int( size_t & aOffset ) const
+        {
+            int aValue = 0 ;
+
+            BELFEM_ERROR( this->parse_int( aOffset, aValue ),
+                          "Integer expected at byte %lu in file %s",
+                          ( long unsigned int ) aOffset, mFilename.c_str() );
+
+            return aValue ;
+        }
+
+//------------------------------------------------------------------------------
+
+        real
+        GmshReader::read_real( size_t & aOffset ) const
+        {
+            real aValue = 0.0 ;
+
+            BELFEM_ERROR( this->parse_real( aOffset, aValue ),
+                          "Number expected at byte %lu in file %s",
+                          ( long unsigned int ) aOffset, mFilename.c_str() );
+
+            return aValue ;
+        }
+
+//------------------------------------------------------------------------------
+
+        bool
+        GmshReader::parse_size( size_t & aOffset, luint & aValue ) const
+        {
+            if( mBinary )
+            {
+                if( aOffset + mSizeOfSize > mDataLength )
+                {
+                    return false ;
                 }
-                else if ( mBuffer( tCount ) == "$Entities" )
+
+                if( mSizeOfSize == 8 )
                 {
-                    this->read_entity_tag_v41( tCount );
+                    uint64_t tValue ;
+                    std::memcpy( & tValue, mData + aOffset, 8 );
+                    aValue = tValue ;
                 }
-                if ( mBuffer( tCount ) == "$Nodes" )
+                else
+                {
+                    uint32_t tValue ;
+                    std::memcpy( & tValue, mData + aOffset, 4 );
+                    aValue = tValue ;
+                }
+                aOffset += mSizeOfSize ;
+                return true ;
+            }
+            else
+            {
+                // skip whitespace
+                while( aOffset < mDataLength && ( mData[ aOffset ] == ' ' || mData[ aOffset ] == '\t'
+                    || mData[ aOffset ] == '\r' || mData[ aOffset ] == '\n' ) )
                 {
-                    this->read_nodes_v41( tCount );
-                    this->create_node_map();
+                    ++aOffset ;
                 }
-                else if ( mBuffer( tCount ) == "$Elements" )
+
+                if( aOffset >= mDataLength || mData[ aOffset ] < '0' || mData[ aOffset ] > '9' )
                 {
-                    this->read_elements_v41( tCount );
+                    return false ;
                 }
 
-                // increment counter
-                ++tCount;
+                aValue = 0 ;
+                while( aOffset < mDataLength && mData[ aOffset ] >= '0' && mData[ aOffset ] <= '9' )
+                {
+                    aValue = 10 * aValue + ( mData[ aOffset++ ] - '0' );
+                }
+                return true ;
             }
         }
 
+//------------------------------------------------------------------------------
+
+        bool
+        GmshReader::parse_int( size_t & aOffset, int & aValue ) const
+        {
+            if( mBinary )
+            {
+                if( aOffset + sizeof( int ) > mDataLength )
+                {
+                    return false ;
+                }
+
+                std::memcpy( & aValue, mData + aOffset, sizeof( int ) );
+                aOffset += sizeof( int );
+                return true ;
+            }
+            else
+            {
+                char tWord[ 32 ];
+                size_t tStart = aOffset ;
+
+                if( ! this->copy_word( aOffset, tWord, sizeof( tWord ) ) )
+                {
+                    aOffset = tStart ;
+                    return false ;
+                }
+
+                char * tEnd ;
+                aValue = std::strtol( tWord, & tEnd, 10 );
+
+                if( tEnd == tWord || *tEnd != '\0' )
+                {
+                    aOffset = tStart ;
+                    return false ;
+                }
+                return true ;
+            }
+        }
+
+//------------------------------------------------------------------------------
+
+        bool
+        GmshReader::parse_real( size_t & aOffset, real & aValue ) const
+        {
+            if( mBinary )
+            {
+                if( aOffset + sizeof( real ) > mDataLength )
+                {
+                    return false ;
+                }
+
+                std::memcpy( & aValue, mData + aOffset, sizeof( real ) );
+                aOffset += sizeof( real );
+                return true ;
+            }
+            else
+            {
+                char tWord[ 64 ];
+                size_t tStart = aOffset ;
+
+                if( ! this->copy_word( aOffset, tWord, sizeof( tWord ) ) )
+                {
+                    aOffset = tStart ;
+                    return false ;
+                }
+
+                char * tEnd ;
+                aValue = std::strtod( tWord, & tEnd );
+
+                if( tEnd == tWord || *tEnd != '\0' )
+                {
+                    aOffset = tStart ;
+                    return false ;
+                }
+                return true ;
+            }
+        }
+
+//------------------------------------------------------------------------------
+
+        bool
+        GmshReader::copy_word( size_t & aOffset, char * aWord, const size_t aMaxLength ) const
+        {
+            // skip whitespace
+            while( aOffset < mDataLength && std::isspace( mData[ aOffset ] ) )
+            {
+                ++aOffset ;
+            }
+
+            size_t tLength = 0 ;
+
+            while( aOffset < mDataLength && ! std::isspace( mData[ aOffset ] ) )
+            {
+                // the word does not fit into the buffer
+                if( tLength + 1 >= aMaxLength )
+                {
+                    return false ;
+                }
+                aWord[ tLength++ ] = mData[ aOffset++ ];
+            }
+
+            aWord[ tLength ] = '\0' ;
+
+            return tLength > 0 ;
+        }
+
 //------------------------------------------------------------------------------
 
         void
-        GmshReader::read_entity_tag_v41( size_t & aCount )
+        GmshReader::check_end_of_line( size_t & aOffset ) const
         {
-            // convert next line to words
-            Cell< string > tWords = string_to_words( mBuffer( ++aCount ) );
+            BELFEM_ERROR( this->parse_end_of_line( aOffset ),
+                          "Unexpected entry at byte %lu in file %s",
+                          ( long unsigned int ) aOffset, mFilename.c_str() );
+        }
 
-            // increment counter
-            for( uint k=0; k<tWords.size(); ++k )
+//------------------------------------------------------------------------------
+
+        bool
+        GmshReader::parse_end_of_line( size_t & aOffset ) const
+        {
+            while( aOffset < mDataLength && ( mData[ aOffset ] == ' '
+                || mData[ aOffset ] == '\t' || mData[ aOffset ] == '\r' ) )
+            {
+                ++aOffset ;
+            }
+
+            return aOffset >= mDataLength || mData[ aOffset ] == '\n' ;
+        }
+
+//------------------------------------------------------------------------------
+
+        void
+        GmshReader::skip_lines( size_t & aOffset, const luint aCount ) const
+        {
+            for( luint k=0; k<aCount; ++k )
             {
-                aCount += std::stoi( tWords( k ) );
+                const char * tEnd = aOffset < mDataLength ? static_cast< const char * >(
+                        std::memchr( mData + aOffset, '\n', mDataLength - aOffset ) ) : nullptr ;
+
+                BELFEM_ERROR( tEnd != nullptr, "Unexpected end of file %s",
+                              mFilename.c_str() );
+
+                aOffset = ( tEnd - mData ) + 1 ;
             }
         }
 
 //------------------------------------------------------------------------------
 
         void
-        GmshReader::read_nodes_v41( size_t & aCount )
+        GmshReader::read_nodes_v41( size_t & aOffset )
         {
             // remember the tag
-            mNodesTag = aCount++;
+            mNodesOffset = aOffset ;
 
-            Cell< string > tWords = string_to_words( mBuffer( aCount++ ) );
+            luint tNumBlocks = this->read_size( aOffset );
 
-            // get number of elements
-            mNumberOfNodes = std::stoi( tWords( 1 ) );
+            // get number of nodes
+            mNumberOfNodes = this->read_size( aOffset );
 
-            // node counter
-            uint tNodeCount = 0;
+            luint tMinTag = this->read_size( aOffset );
+            luint tMaxTag = this->read_size( aOffset );
 
-            // vector containing node IDs
-            Vector< id_t > mNodeIDs( mNumberOfNodes );
-            Matrix< real > mNodeCoords( 3, mNumberOfNodes );
+            // first pass: find the entity blocks
+            Vector< luint >   tBlockOffsets( tNumBlocks );
+            Vector< index_t > tBlockSizes( tNumBlocks );
+            Vector< index_t > tFirstNodes( tNumBlocks );
 
-            while( tNodeCount < mNumberOfNodes )
+            // node counter
+            index_t tNodeCount = 0;
+
+            for( luint b=0; b<tNumBlocks; ++b )
             {
-                tWords = string_to_words( mBuffer( aCount++ ) );
+                // entity dimension and tag are not needed
+                this->read_int( aOffset );
+                this->read_int( aOffset );
 
                 // read parametric flag
-                uint tParametric = std::stoi( tWords( 2 ) );
+                int tParametric = this->read_int( aOffset );
 
                 // make sure that there are no parametric nodes
                 BELFEM_ERROR( tParametric == 0,
@@ -414,42 +816,93 @@ namespace belfem
                     mFilename.c_str() );
 
                 // read number of nodes
-                uint tN = std::stoi( tWords( 3 ) );
+                luint tN = this->read_size( aOffset );
+
+                tBlockOffsets( b ) = aOffset ;
+                tBlockSizes( b )   = tN ;
+                tFirstNodes( b )   = tNodeCount ;
+
+                tNodeCount += tN ;
+
+                // jump to the next block
+                if( mBinary )
+                {
+                    aOffset += tN * ( mSizeOfSize + 3 * sizeof( real ) );
+                }
+                else
+                {
+                    this->skip_lines( aOffset, 1 + 2 * tN );
+                }
+            }
+
+            BELFEM_ERROR( tNodeCount == mNumberOfNodes && aOffset <= mDataLength,
+                          "Corrupt $Nodes tag in file %s", mFilename.c_str() );
+
+            // create nodes
+            mNodes.set_size( mNumberOfNodes, nullptr );
+
+            Vector< id_t > tNodeIDs( mNumberOfNodes );
+
+            // byte where a block failed, errors are raised after the loop
+            Vector< luint > tErrorOffsets( tNumBlocks, 0 );
+
+            // second pass: the blocks are independent and parsed in parallel
+#ifdef OMP
+            #pragma omp parallel for schedule( dynamic )
+#endif
+            for( index_t b=0; b<tNumBlocks; ++b )
+            {
+                size_t tOffset = tBlockOffsets( b );
+                index_t tFirst = tFirstNodes( b );
+                index_t tN = tBlockSizes( b );
+
+                bool tOK = true ;
 
                 // read node ids
-                for( uint k=0; k<tN; ++k )
+                for( index_t k=0; k<tN && tOK; ++k )
                 {
-                    mNodeIDs( tNodeCount + k ) = std::stoi( mBuffer( aCount++ ) );
+                    luint tID = 0 ;
+                    tOK = this->parse_size( tOffset, tID );
+                    tNodeIDs( tFirst + k ) = tID ;
                 }
 
                 // read node coordinates
-                for( uint k=0; k<tN; ++k )
+                for( index_t k=0; k<tN && tOK; ++k )
                 {
-                    tWords = string_to_words( mBuffer( aCount++ ) );
-                    mNodeCoords( 0, tNodeCount + k ) = std::stod( tWords( 0 ) ) * mMeshScale ;
-                    mNodeCoords( 1, tNodeCount + k ) = std::stod( tWords( 1 ) ) * mMeshScale ;
-                    mNodeCoords( 2, tNodeCount + k ) = std::stod( tWords( 2 ) ) * mMeshScale ;
+                    real tX = 0.0 ;
+                    real tY = 0.0 ;
+                    real tZ = 0.0 ;
+
+                    tOK = this->parse_real( tOffset, tX )
+                       && this->parse_real( tOffset, tY )
+                       && this->parse_real( tOffset, tZ );
+
+                    if( tOK )
+                    {
+                        mNodes( tFirst + k ) = new Node( tNodeIDs( tFirst + k ),
+                                                         tX * mMeshScale,
+                                                         tY * mMeshScale,
+                                                         tZ * mMeshScale );
+                    }
                 }
 
-                tNodeCount += tN;
+                if( ! tOK )
+                {
+                    // an offset of zero can not fail, since the header is before
+                    tErrorOffsets( b ) = tOffset ;
+                }
             }
 
-            // create nodes
-            mNodes.set_size( mNumberOfNodes, nullptr );
-
-            for ( uint k=0; k<mNumberOfNodes; ++k )
+            for( index_t b=0; b<tNumBlocks; ++b )
             {
-                mNodes( k ) = new Node(
-                        mNodeIDs( k ),
-                        mNodeCoords( 0, k ),
-                        mNodeCoords( 1, k ),
-                        mNodeCoords( 2, k ) );
+                BELFEM_ERROR( tErrorOffsets( b ) == 0,
+                              "Corrupt node at byte %lu in file %s",
+                              ( long unsigned int ) tErrorOffsets( b ), mFilename.c_str() );
             }
 
+            this->create_node_lookup( tMinTag, tMaxTag );
         }
 
-//------------------------------------------------------------------------------
-
         void
         GmshReader::convert_orders_for_quadratic_volume_elements_to_exo()
         {
@@ -527,87 +980,157 @@ namespace belfem
 //------------------------------------------------------------------------------
 
         void
-        GmshReader::read_elements_v41( size_t & aCount )
+        GmshReader::read_elements_v41( size_t & aOffset )
         {
             // this routine assumes that a node map was already created.
             // therefore, check for that
-            BELFEM_ERROR( mNodesTag > 0,
+            BELFEM_ERROR( mNodesOffset > 0,
                 "$Elements tag must be after $Nodes tag in file %s",
                 mFilename.c_str() );
 
             // remember the element tag
-            mElementsTag = aCount++;
+            mElementsOffset = aOffset ;
 
-            Cell<string> tWords = string_to_words( mBuffer( aCount++ ));
+            luint tNumBlocks = this->read_size( aOffset );
 
             // get number of elements
-            mNumberOfElements = std::stoi( tWords( 1 ));
+            mNumberOfElements = this->read_size( aOffset );
 
-            // allocate  container
-            mElements.set_size( mNumberOfElements, nullptr );
+            // min and max tag are not needed
+            this->read_size( aOffset );
+            this->read_size( aOffset );
 
-            uint tElementCount = 0;
+            // first pass: find the entity blocks
+            Vector< luint >   tBlockOffsets( tNumBlocks );
+            Vector< index_t > tBlockSizes( tNumBlocks );
+            Vector< index_t > tFirstElements( tNumBlocks );
+            Vector< uint >    tGeometryTags( tNumBlocks );
+            Cell< ElementType > tTypes( tNumBlocks, ElementType::UNDEFINED );
 
-            // create the factory
-            ElementFactory tFactory;
+            index_t tElementCount = 0;
 
-            while ( tElementCount < mNumberOfElements )
+            for( luint b=0; b<tNumBlocks; ++b )
             {
-                // get next line
-                tWords = string_to_words( mBuffer( aCount++ ));
+                // entity dimension is not needed
+                this->read_int( aOffset );
 
                 // get geometry tag
-                uint tGeometryTag = std::stoi( tWords( 1 ));
+                tGeometryTags( b ) = this->read_int( aOffset );
 
                 // get element type
-                ElementType tType = element_type_from_gmsh( std::stoi(  tWords( 2 ) ));
+                tTypes( b ) = element_type_from_gmsh( this->read_int( aOffset ) );
 
                 // number of elements in this block
-                uint tNumElements = std::stoi( tWords( 3 ) );
+                luint tN = this->read_size( aOffset );
 
-                // get number of nodes
-                size_t tNumNodes = number_of_nodes( tType );
+                // catch special case for vertex
+                BELFEM_ERROR( tTypes( b ) != ElementType::VERTEX || tN == 1,
+                              "Don't understand input file." );
 
-                for ( uint k = 0; k < tNumElements; ++k )
+                tBlockOffsets( b )  = aOffset ;
+                tBlockSizes( b )    = tN ;
+                tFirstElements( b ) = tElementCount ;
+
+                tElementCount += tN ;
+
+                // jump to the next block
+                if( mBinary )
                 {
-                    // read buffer
-                    tWords = string_to_words( mBuffer( aCount++ ) );
+                    aOffset += tN * ( number_of_nodes( tTypes( b ) ) + 1 ) * mSizeOfSize ;
+                }
+                else
+                {
+                    this->skip_lines( aOffset, 1 + tN );
+                }
+            }
 
-                    // read element ID
-                    id_t tID = std::stoi( tWords( 0 ) );
+            BELFEM_ERROR( tElementCount == mNumberOfElements && aOffset <= mDataLength,
+                          "Corrupt $Elements tag in file %s", mFilename.c_str() );
+
+            // allocate  container
+            mElements.set_size( mNumberOfElements, nullptr );
+
+            // create the factory
+            ElementFactory tFactory;
+
+            // byte where a block failed, errors are raised after the loop
+            Vector< luint > tErrorOffsets( tNumBlocks, 0 );
+
+            // second pass: the blocks are independent and parsed in parallel
+#ifdef OMP
+            #pragma omp parallel for schedule( dynamic )
+#endif
+            for ( index_t b=0; b<tNumBlocks; ++b )
+            {
+                size_t tOffset = tBlockOffsets( b );
+                ElementType tType = tTypes( b );
+
+                // get number of nodes
+                uint tNumNodes = number_of_nodes( tType );
 
-                    // make sure that number of elements is correct
-                    BELFEM_ERROR( tWords.size() == tNumNodes + 1,
-                                 "Number of nodes for element %ui does not match. Is: %u, Expect %u",
-                                 ( unsigned int ) tID,
-                                 ( unsigned int ) tWords.size()-1,
-                                 ( unsigned int ) tNumNodes );
+                bool tOK = true ;
+
+                for ( index_t k = 0; k < tBlockSizes( b ) && tOK; ++k )
+                {
+                    // read element ID
+                    luint tID = 0 ;
+                    tOK = this->parse_size( tOffset, tID );
 
-                    // catch special case for vertex
+                    // we want to use the GeometryTag as Entity ID
                     if( tType == ElementType::VERTEX )
                     {
-                        BELFEM_ERROR( tNumElements == 1, "Don't understand input file." );
-
-                        // we want to use the GeometryTag as Entity ID
-                        tID = tGeometryTag ;
+                        tID = tGeometryTags( b );
                     }
 
                     // create an element
                     Element * tElement = tFactory.create_element( tType, tID );
 
                     // add nodes
-                    for( uint i=0; i < tNumNodes; ++i )
+                    for( uint i=0; i < tNumNodes && tOK; ++i )
                     {
-                        tElement->insert_node( mNodeMap( std::stoi( tWords( i + 1 ) ) ), i );
+                        luint tTag = 0 ;
+                        Node * tNode = this->parse_size( tOffset, tTag ) ?
+                                this->node_by_tag( tTag ) : nullptr ;
+
+                        tOK = tNode != nullptr ;
+
+                        if( tOK )
+                        {
+                            tElement->insert_node( tNode, i );
+                        }
+                    }
+
+                    // make sure that number of nodes is correct
+                    if( tOK && ! mBinary )
+                    {
+                        tOK = this->parse_end_of_line( tOffset );
+                    }
+
+                    if( ! tOK )
+                    {
+                        delete tElement ;
+                        break ;
                     }
 
                     // set the geometry tag
-                    tElement->set_geometry_tag( tGeometryTag );
+                    tElement->set_geometry_tag( tGeometryTags( b ) );
 
                     // add element to list
-                    mElements( tElementCount++ ) = tElement;
+                    mElements( tFirstElements( b ) + k ) = tElement;
+                }
+
+                if( ! tOK )
+                {
+                    tErrorOffsets( b ) = tOffset ;
                 }
             }
+
+            for( index_t b=0; b<tNumBlocks; ++b )
+            {
+                BELFEM_ERROR( tErrorOffsets( b ) == 0,
+                              "Corrupt element or unknown node at byte %lu in file %s",
+                              ( long unsigned int ) tErrorOffsets( b ), mFilename.c_str() );
+            }
         }
 
 //------------------------------------------------------------------------------
@@ -624,6 +1147,51 @@ namespace belfem
             }
         }
 
+//------------------------------------------------------------------------------
+
+        void
+        GmshReader::create_node_lookup( const luint aMinTag, const luint aMaxTag )
+        {
+            mNodeLookup.clear() ;
+
+            // gmsh usually numbers nodes continuously, use the map otherwise
+            if( mNumberOfNodes > 0 && aMaxTag >= aMinTag
+                && aMaxTag - aMinTag < 4 * ( luint ) mNumberOfNodes )
+            {
+                mMinNodeTag = aMinTag ;
+                mNodeLookup.set_size( aMaxTag - aMinTag + 1, nullptr );
+
+                for ( Node * tNode: mNodes )
+                {
+                    BELFEM_ERROR( tNode->id() >= aMinTag && tNode->id() <= aMaxTag,
+                                  "Node %lu is out of range in file %s",
+                                  ( long unsigned int ) tNode->id(), mFilename.c_str() );
+
+                    mNodeLookup( tNode->id() - mMinNodeTag ) = tNode ;
+                }
+            }
+            else
+            {
+                this->create_node_map() ;
+            }
+        }
+
+//------------------------------------------------------------------------------
+
+        Node *
+        GmshReader::node_by_tag( const luint aTag )
+        {
+            if( mNodeLookup.size() > 0 )
+            {
+                return aTag >= mMinNodeTag && aTag - mMinNodeTag < mNodeLookup.size() ?
+                    mNodeLookup( aTag - mMinNodeTag ) : nullptr ;
+            }
+            else
+            {
+                return mNodeMap.key_exists( aTag ) ? mNodeMap( aTag ) : nullptr ;
+            }
+        }
+
 //------------------------------------------------------------------------------
 
         void
@@ -38,15 +38,30 @@ namespace belfem
 
             real   mVersion = 0.0;
 
+            // flag telling if this is a binary file
+            bool   mBinary = false ;
+
+            // size of size_t in the file
+            uint   mSizeOfSize = 8 ;
+
+            // memory mapped content of the file
+            const char * mData = nullptr ;
+            size_t       mDataLength = 0 ;
+
             uint   mNumberOfNodes = 0;
             uint   mNumberOfElements = 0;
             uint   mNumberOfPhysicalGroups = 0;
 
-            // tags in the file
+            // lines of the tags in the buffer ( v2.2 )
             size_t mNodesTag = 0;
             size_t mElementsTag = 0;
             size_t mPhysicalTag = 0;
 
+            // byte offsets of the sections in the mapped file ( v4.1 )
+            size_t mNodesOffset = 0;
+            size_t mElementsOffset = 0;
+            size_t mPhysicalOffset = 0;
+
             // Pointer to mesh object
             Mesh * mMesh;
 
@@ -62,6 +77,10 @@ namespace belfem
             // map managing Nodes by index
             Map< id_t, Node* > mNodeMap;
 
+            // direct lookup table for dense node tags ( v4.1 )
+            Cell< Node * > mNodeLookup ;
+            id_t mMinNodeTag = 0 ;
+
             // number of elements per dimension
             Vector< index_t > mNumberOfElementsPerDimension;
 
@@ -107,6 +126,28 @@ namespace belfem
 
 //------------------------------------------------------------------------------
         private:
+//------------------------------------------------------------------------------
+
+            /**
+             * map the file into memory, so that it can be parsed
+             * without copying it into strings
+             */
+            void
+            map_file();
+
+//------------------------------------------------------------------------------
+
+            void
+            unmap_file();
+
+//------------------------------------------------------------------------------
+
+            /**
+             * split the mapped file into lines, needed for v2.2
+             */
+            void
+            load_lines();
+
 //------------------------------------------------------------------------------
 
             void
@@ -157,20 +198,91 @@ namespace belfem
             void
             read_mesh_v41();
 
+//------------------------------------------------------------------------------
+
+            /**
+             * find the next $Section tag, returns false at the end of the file
+             */
+            bool
+            next_section( size_t & aOffset, string & aLabel );
+
 //------------------------------------------------------------------------------
 
             void
-            read_entity_tag_v41( size_t & aCount );
+            skip_section( size_t & aOffset, const string & aLabel );
 
 //------------------------------------------------------------------------------
 
             void
-            read_nodes_v41( size_t & aCount );
+            end_section( size_t & aOffset, const string & aLabel );
 
 //------------------------------------------------------------------------------
 
             void
-            read_elements_v41( size_t & aCount );
+            read_nodes_v41( size_t & aOffset );
+
+//------------------------------------------------------------------------------
+
+            void
+            read_elements_v41( size_t & aOffset );
+
+//------------------------------------------------------------------------------
+
+            /**
+             * read a size_t, int or double from the ascii or binary stream
+             */
+            luint
+            read_size( size_t & aOffset ) const ;
+
+            int
+            read_int( size_t & aOffset ) const ;
+
+            real
+            read_real( size_t & aOffset ) const ;
+
+//------------------------------------------------------------------------------
+
+            /**
+             * same as read_size, read_int and read_real, but return false
+             * instead of throwing an error, so that they can be used
+             * inside of parallel loops
+             */
+            bool
+            parse_size( size_t & aOffset, luint & aValue ) const ;
+
+            bool
+            parse_int( size_t & aOffset, int & aValue ) const ;
+
+            bool
+            parse_real( size_t & aOffset, real & aValue ) const ;
+
+//------------------------------------------------------------------------------
+
+            /**
+             * copy the next ascii word into a null terminated buffer,
+             * since the mapped file is not null terminated
+             */
+            bool
+            copy_word( size_t & aOffset, char * aWord, const size_t aMaxLength ) const ;
+
+//------------------------------------------------------------------------------
+
+            /**
+             * make sure that an ascii line has no further entries
+             */
+            void
+            check_end_of_line( size_t & aOffset ) const ;
+
+            bool
+            parse_end_of_line( size_t & aOffset ) const ;
+
+//------------------------------------------------------------------------------
+
+            /**
+             * move the offset behind the next aCount line breaks
+             */
+            void
+            skip_lines( size_t & aOffset, const luint aCount ) const ;
 
 //------------------------------------------------------------------------------
 
@@ -182,6 +294,22 @@ namespace belfem
             void
             create_node_map();
 
+//------------------------------------------------------------------------------
+
+            /**
+             * use a table instead of the map if the tags are dense
+             */
+            void
+            create_node_lookup( const luint aMinTag, const luint aMaxTag );
+
+//------------------------------------------------------------------------------
+
+            /**
+             * returns a nullptr if the node does not exist
+             */
+            Node *
+            node_by_tag( const luint aTag );
+
 //------------------------------------------------------------------------------
 
             /**
@@ -13,12 +13,14 @@ namespace belfem
     {
 //------------------------------------------------------------------------------
 
-        HDF5Writer::HDF5Writer( const string & aFilePath, Mesh * aMesh   ) :
+        HDF5Writer::HDF5Writer( const string & aFilePath, Mesh * aMesh, const int aFieldDigits ) :
         mFilePath( aFilePath ),
         mFile( aFilePath, FileMode::NEW ),
-        mMesh( aMesh )
+        mMesh( aMesh ),
+        mFieldDigits( aFieldDigits )
         {
-
+            // connectivities and fields compress well, and are written only once
+            mFile.set_compression( 4 );
 
             mMesh->update_node_indices();
             mMesh->update_element_indices();
@@ -523,6 +525,9 @@ namespace belfem
 
             mFile.save_data( "NumberOfFields", tNumberOfFields );
 
+            // only the field data may be lossy
+            mFile.set_lossy_precision( mFieldDigits );
+
             for( uint f=0; f<tNumberOfFields; ++f )
             {
                 mFile.create_group( sprint( "Field_%u", f+1 ) );
@@ -531,6 +536,8 @@ namespace belfem
                 mFile.save_data( "Data", mMesh->field( f )->data() );
             }
             mFile.close_active_group();
+
+            mFile.set_lossy_precision( -1 );
 #endif
         }
     }
@@ -20,13 +20,19 @@ namespace belfem
 
             Mesh * mMesh;
 
+            // decimal digits of the field data, negative means lossless
+            const int mFieldDigits ;
 
 
 //------------------------------------------------------------------------------
             public:
 //------------------------------------------------------------------------------
 
-            HDF5Writer( const string & aFilePath, Mesh * aMesh  );
+            /**
+             * @param aFieldDigits : decimal digits of the fields,
+             *                       negative means lossless
+             */
+            HDF5Writer( const string & aFilePath, Mesh * aMesh, const int aFieldDigits=-1 );
 
 //------------------------------------------------------------------------------
 
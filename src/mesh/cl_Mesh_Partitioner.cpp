@@ -8,6 +8,8 @@
 #include "cl_Vector.hpp"
 #include "cl_Logger.hpp"
 
+#include <cmath>
+
 
 namespace belfem
 {
@@ -81,6 +83,10 @@ namespace belfem
             {
                 free( mAdjacency );
             }
+            if( mVertexWeights != nullptr )
+            {
+                free( mVertexWeights );
+            }
         }
 
 //------------------------------------------------------------------------------
@@ -165,6 +171,12 @@ namespace belfem
 
             mElementPointers[ mNumberOfElements ] = tCount;
 
+            // the weights need the graph indices
+            if( mMesh->mWeightedPartition )
+            {
+                this->compute_vertex_weights();
+            }
+
             // reset element index
             tCount = 0 ;
             for( Element * tElement : tElements )
@@ -176,6 +188,56 @@ namespace belfem
 
         }
 
+//------------------------------------------------------------------------------
+
+        void
+        Partitioner::compute_vertex_weights()
+        {
+            mNumberOfConstraints = mMesh->mBalancePartitionDofs ? 2 : 1 ;
+
+            mVertexWeights = ( metis_t * ) malloc(
+                    mNumberOfElements * mNumberOfConstraints * sizeof( metis_t ) );
+
+            real tWork = 0.0 ;
+            real tMaxWork = 0.0 ;
+            real tTotalWork = 0.0 ;
+
+            for( Element * tElement : mMesh->elements() )
+            {
+                if( tElement->is_flagged() )
+                {
+                    // the dofs that live on this element
+                    metis_t tNumDofs = mMesh->partition_dofs( tElement );
+
+                    // assembly work scales with the size of the element matrix
+                    tWork = mMesh->partition_work( tElement );
+
+                    tTotalWork += tWork ;
+
+                    if( tWork > tMaxWork )
+                    {
+                        tMaxWork = tWork ;
+                    }
+
+                    metis_t * tWeight = mVertexWeights + tElement->index() * mNumberOfConstraints ;
+
+                    tWeight[ 0 ] = tWork < 1.0 ? 1 : ( metis_t ) tWork ;
+
+                    if( mNumberOfConstraints > 1 )
+                    {
+                        tWeight[ 1 ] = tNumDofs < 1 ? 1 : tNumDofs ;
+                    }
+                }
+            }
+
+            // metis sums up the weights, this must not overflow
+            BELFEM_ERROR( tTotalWork < BELFEM_INT_MAX,
+                         "The partition weights are too large for METIS" );
+
+            message( 4, "    Computed element weights with %i constraints, max work : %u",
+                     ( int ) mNumberOfConstraints, ( unsigned int ) tMaxWork );
+        }
+
 //------------------------------------------------------------------------------
 
         void
@@ -206,8 +268,6 @@ namespace belfem
             // allocate the element data
             mPartition.set_size( mNumberOfElements );
 
-            metis_t tNumberOfConstraints = 1;
-
             message( 3, "    Starting METIS ..." );
 
             // start the timer
@@ -216,10 +276,10 @@ namespace belfem
             int tStatus =
                     METIS_PartGraphKway(
                             &mNumberOfElements,     // The number of vertices in the graph.
-                            &tNumberOfConstraints,  // The number of balancing constraints. It should be at least 1.
+                            &mNumberOfConstraints,  // The number of balancing constraints. It should be at least 1.
                             mElementPointers,       // The adjacency structure of the graph
                             mAdjacency,             // The adjacency structure of the graph
-                            NULL,                   // The weights of the vertices
+                            mVertexWeights,         // The weights of the vertices, NULL if unweighted
                             NULL,                   // The size of the vertices for computing the total communication volume
                             NULL,                   // The weights of the edges
                             &mNumberOfPartitions,   // The number of parts to partition the graph.
@@ -51,6 +51,12 @@ namespace belfem
             metis_t * mElementPointers;
             metis_t * mAdjacency;
 
+            // number of balancing constraints, 2 if dofs are balanced too
+            metis_t   mNumberOfConstraints = 1 ;
+
+            // element weights, only allocated if the mesh is weighted
+            metis_t * mVertexWeights = nullptr ;
+
             Vector< metis_t > mPartition;
 
             bool mForceContiguousPartitions = true ;
@@ -83,6 +89,14 @@ namespace belfem
             void
             create_graph();
 
+//------------------------------------------------------------------------------
+
+            /**
+             * compute the work and dof weights of the flagged elements
+             */
+            void
+            compute_vertex_weights();
+
 //------------------------------------------------------------------------------
 
             void
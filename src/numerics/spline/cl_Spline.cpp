@@ -15,7 +15,6 @@
 #include "fn_norm.hpp"
 #include "fn_sort.hpp"
 
-#include "cl_Solver.hpp"
 #include "fn_Create_Truss_Poly.hpp"
 #include "cl_HDF5.hpp"
 
@@ -101,6 +100,55 @@ namespace belfem
             aA = tA;
         }
 
+//------------------------------------------------------------------------------
+
+        void
+        solve_helpmatrix(
+                const SpMatrix       & aA,
+                const Vector< real > & aB,
+                      Vector< real > & aX )
+        {
+            index_t tN = aB.length();
+
+            BELFEM_ASSERT( aA.n_rows() == tN && aA.n_cols() == tN,
+                           "Size of help matrix does not match" );
+
+            BELFEM_ASSERT( ( index_t ) aA.number_of_nonzeros() == 3 * tN - 2,
+                           "Help matrix must be tridiagonal" );
+
+            aX.set_size( tN );
+
+            // upper diagonal after the elimination
+            Vector< real > tC( tN, 0.0 );
+
+            // forward elimination
+            real tDiag = aA( 0, 0 );
+            tC( 0 ) = aA( 0, 1 ) / tDiag;
+            aX( 0 ) = aB( 0 ) / tDiag;
+
+            for ( index_t k = 1; k < tN; ++k )
+            {
+                real tLower = aA( k, k - 1 );
+
+                tDiag = aA( k, k ) - tLower * tC( k - 1 );
+
+                BELFEM_ASSERT( tDiag != 0.0, "Help matrix is singular" );
+
+                if ( k < tN - 1 )
+                {
+                    tC( k ) = aA( k, k + 1 ) / tDiag;
+                }
+
+                aX( k ) = ( aB( k ) - tLower * aX( k - 1 ) ) / tDiag;
+            }
+
+            // back substitution
+            for ( index_t k = tN - 1; k > 0; --k )
+            {
+                aX( k - 1 ) -= tC( k - 1 ) * aX( k );
+            }
+        }
+
 //------------------------------------------------------------------------------
     } /* namespace spline */
 
@@ -185,14 +233,8 @@ namespace belfem
             // derivatives for spline
             Vector<real> tDYDX( tB.length(), 0 );
 
-            // create a solver
-            Solver tSolver( SolverType::UMFPACK ) ;
-
             // solve system
-            tSolver.solve( aA, tDYDX, tB ) ;
-
-            // delete the solver
-            tSolver.free();
+            spline::solve_helpmatrix( aA, tB, tDYDX );
 
             // create polynomial coefficients from derivatives
             this->create_coeffs( aX, aY, tDYDX );
@@ -257,13 +299,8 @@ namespace belfem
             // derivatives for spline
             Vector<real> tDYDX( tB.length(), 0.0 );
 
-            // create a solver
-            Solver tSolver( SolverType::UMFPACK ) ;
-
             // solve system
-            tSolver.solve( aHelpMatrix, tDYDX, tB ) ;
-
-            tSolver.free();
+            spline::solve_helpmatrix( aHelpMatrix, tB, tDYDX );
 
             // create polynomial coefficients from derivatives
             this->create_coeffs( aValues, tDYDX );
@@ -276,6 +313,80 @@ namespace belfem
         }
     }
 
+//------------------------------------------------------------------------------
+
+    void
+    Spline::eval( const Vector< real > & aX, Vector< real > & aY ) const
+    {
+        index_t tN = aX.length();
+
+        aY.set_size( tN );
+
+        const real * tX = aX.data();
+        real       * tY = aY.data();
+
+#ifdef OMP
+        #pragma omp simd
+#endif
+        for( index_t k=0; k<tN; ++k )
+        {
+            const real * tC = this->coeffs( this->find_col( tX[ k ] ) );
+
+            tY[ k ] = ( ( tC[ 0 ]   * tX[ k ]
+                        + tC[ 1 ] ) * tX[ k ]
+                        + tC[ 2 ] ) * tX[ k ]
+                        + tC[ 3 ];
+        }
+    }
+
+//------------------------------------------------------------------------------
+
+    void
+    Spline::deval( const Vector< real > & aX, Vector< real > & aY ) const
+    {
+        index_t tN = aX.length();
+
+        aY.set_size( tN );
+
+        const real * tX = aX.data();
+        real       * tY = aY.data();
+
+#ifdef OMP
+        #pragma omp simd
+#endif
+        for( index_t k=0; k<tN; ++k )
+        {
+            const real * tC = this->coeffs( this->find_col( tX[ k ] ) );
+
+            tY[ k ] = ( 3.0 * tC[ 0 ]   * tX[ k ]
+                      + 2.0 * tC[ 1 ] ) * tX[ k ]
+                      +       tC[ 2 ];
+        }
+    }
+
+//------------------------------------------------------------------------------
+
+    void
+    Spline::ddeval( const Vector< real > & aX, Vector< real > & aY ) const
+    {
+        index_t tN = aX.length();
+
+        aY.set_size( tN );
+
+        const real * tX = aX.data();
+        real       * tY = aY.data();
+
+#ifdef OMP
+        #pragma omp simd
+#endif
+        for( index_t k=0; k<tN; ++k )
+        {
+            const real * tC = this->coeffs( this->find_col( tX[ k ] ) );
+
+            tY[ k ] = 6.0 * tC[ 0 ] * tX[ k ] + 2.0 * tC[ 1 ];
+        }
+    }
+
 //------------------------------------------------------------------------------
 // private :
 //------------------------------------------------------------------------------
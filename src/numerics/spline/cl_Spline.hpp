@@ -22,6 +22,16 @@ namespace belfem
                 const real & aSize,
                 const real & aDeltaX,
                   SpMatrix & aA );
+
+        /**
+         * solve the tridiagonal system of the helpmatrix
+         * with the Thomas algorithm
+         */
+        void
+        solve_helpmatrix(
+                const SpMatrix       & aA,
+                const Vector< real > & aB,
+                      Vector< real > & aX );
     }
 
 //------------------------------------------------------------------------------
@@ -112,6 +122,30 @@ namespace belfem
         inline real
         ddeval( const real aX ) const;
 
+//------------------------------------------------------------------------------
+
+        /**
+         * interpolate the function for several points
+         */
+        void
+        eval( const Vector< real > & aX, Vector< real > & aY ) const;
+
+//------------------------------------------------------------------------------
+
+        /**
+         * interpolate first derivative for several points
+         */
+        void
+        deval( const Vector< real > & aX, Vector< real > & aY ) const;
+
+//------------------------------------------------------------------------------
+
+        /**
+         * interpolate second derivative for several points
+         */
+        void
+        ddeval( const Vector< real > & aX, Vector< real > & aY ) const;
+
 //------------------------------------------------------------------------------
 
         /**
@@ -194,6 +228,16 @@ namespace belfem
 
 //------------------------------------------------------------------------------
     private:
+//------------------------------------------------------------------------------
+
+        /**
+         * the coefficients of one column, which are contiguous
+         * since the matrix is stored column major. Columns may
+         * be padded, so the address comes from the matrix itself.
+         */
+        inline const real *
+        coeffs( const index_t aCol ) const;
+
 //------------------------------------------------------------------------------
 
         /**
@@ -317,17 +361,25 @@ namespace belfem
         return std::floor( ( aX - mXmin ) * mInvDeltaX );
     }
 
+//------------------------------------------------------------------------------
+
+    const real *
+    Spline::coeffs( const index_t aCol ) const
+    {
+        return &mData( 0, aCol );
+    }
+
 //------------------------------------------------------------------------------
 
     real
     Spline::eval( const real aX ) const
     {
-	    index_t tCol = find_col( aX );
+        const real * tC = this->coeffs( find_col( aX ) );
 
-        return (   ( mData( 0, tCol )   * aX
-                   + mData( 1, tCol ) ) * aX
-                   + mData( 2, tCol ) ) * aX
-                   + mData( 3, tCol );
+        return (   ( tC[ 0 ]   * aX
+                   + tC[ 1 ] ) * aX
+                   + tC[ 2 ] ) * aX
+                   + tC[ 3 ];
     }
 
 //------------------------------------------------------------------------------
@@ -335,11 +387,11 @@ namespace belfem
     real
     Spline::deval( const real aX ) const
     {
-        auto tCol = find_col( aX );
+        const real * tC = this->coeffs( find_col( aX ) );
 
-        return ( ( 3.0 * mData( 0, tCol )   * aX
-                 + 2.0 * mData( 1, tCol ) ) * aX
-                 +       mData( 2, tCol ) );
+        return ( ( 3.0 * tC[ 0 ]   * aX
+                 + 2.0 * tC[ 1 ] ) * aX
+                 +       tC[ 2 ] );
     }
 
 //------------------------------------------------------------------------------
@@ -347,9 +399,9 @@ namespace belfem
     real
     Spline::ddeval( const real aX ) const
     {
-        auto tCol = find_col( aX );
+        const real * tC = this->coeffs( find_col( aX ) );
 
-        return 6.0 * mData( 0, tCol ) * aX + 2.0 * mData( 1, tCol );
+        return 6.0 * tC[ 0 ] * aX + 2.0 * tC[ 1 ];
     }
 
 //------------------------------------------------------------------------------
@@ -0,0 +1,257 @@
+//
+// Created by Christian Messe on 17.10.26.
+//
+
+#include <cmath>
+
+#include "cl_GM_GasContext.hpp"
+#include "cl_Gas.hpp"
+#include "assert.hpp"
+#include "GT_globals.hpp"
+
+namespace belfem
+{
+    namespace gasmodels
+    {
+//----------------------------------------------------------------------------
+
+        GasContext::GasContext( const Gas & aGas ) :
+            mGas( aGas )
+        {
+            // real gases and helmholtz models keep a state in their EoS
+            BELFEM_ERROR( aGas.is_idgas(),
+                          "A gas context can only be created for an ideal gas" );
+        }
+
+//----------------------------------------------------------------------------
+
+        const real &
+        GasContext::M( const real aT, const real aP )
+        {
+            mStatevals.update_Tp( aT, aP );
+
+            if ( ! mStatevals.test( BELFEM_STATEVAL_M ) )
+            {
+                mStatevals.set( BELFEM_STATEVAL_M, this->eval_M( aT, aP ) );
+            }
+
+            return mStatevals.get( BELFEM_STATEVAL_M );
+        }
+
+//----------------------------------------------------------------------------
+
+        const real &
+        GasContext::R( const real aT, const real aP )
+        {
+            mStatevals.update_Tp( aT, aP );
+
+            if ( ! mStatevals.test( BELFEM_STATEVAL_R ) )
+            {
+                mStatevals.set( BELFEM_STATEVAL_R, this->eval_R( aT, aP ) );
+            }
+
+            return mStatevals.get( BELFEM_STATEVAL_R );
+        }
+
+//----------------------------------------------------------------------------
+
+        real
+        GasContext::cp( const real aT, const real aP )
+        {
+            mStatevals.update_Tp( aT, aP );
+
+            if ( ! mStatevals.test( BELFEM_STATEVAL_CP ) )
+            {
+                mStatevals.set( BELFEM_STATEVAL_CP, this->eval_cp( aT, aP ) );
+            }
+
+            return mStatevals.get( BELFEM_STATEVAL_CP );
+        }
+
+//----------------------------------------------------------------------------
+
+        real
+        GasContext::cv( const real aT, const real aP )
+        {
+            mStatevals.update_Tp( aT, aP );
+
+            if ( ! mStatevals.test( BELFEM_STATEVAL_CV ) )
+            {
+                mStatevals.set( BELFEM_STATEVAL_CV,
+                                this->cp( aT, aP ) - this->R( aT, aP ) );
+            }
+
+            return mStatevals.get( BELFEM_STATEVAL_CV );
+        }
+
+//----------------------------------------------------------------------------
+
+        real
+        GasContext::gamma( const real aT, const real aP )
+        {
+            mStatevals.update_Tp( aT, aP );
+
+            if ( ! mStatevals.test( BELFEM_STATEVAL_GAMMA ) )
+            {
+                real tCp = this->cp( aT, aP );
+
+                mStatevals.set( BELFEM_STATEVAL_GAMMA,
+                                tCp / ( tCp - this->R( aT, aP ) ) );
+            }
+
+            return mStatevals.get( BELFEM_STATEVAL_GAMMA );
+        }
+
+//----------------------------------------------------------------------------
+
+        real
+        GasContext::c( const real aT, const real aP )
+        {
+            mStatevals.update_Tp( aT, aP );
+
+            if ( ! mStatevals.test( BELFEM_STATEVAL_C ) )
+            {
+                mStatevals.set( BELFEM_STATEVAL_C,
+                                std::sqrt( this->gamma( aT, aP ) * this->R( aT, aP ) * aT ) );
+            }
+
+            return mStatevals.get( BELFEM_STATEVAL_C );
+        }
+
+//----------------------------------------------------------------------------
+
+        real
+        GasContext::h( const real aT, const real aP )
+        {
+            mStatevals.update_Tp( aT, aP );
+
+            if ( ! mStatevals.test( BELFEM_STATEVAL_H ) )
+            {
+                mStatevals.set( BELFEM_STATEVAL_H, this->eval_h( aT, aP ) );
+            }
+
+            return mStatevals.get( BELFEM_STATEVAL_H );
+        }
+
+//----------------------------------------------------------------------------
+
+        real
+        GasContext::s( const real aT, const real aP )
+        {
+            mStatevals.update_Tp( aT, aP );
+
+            if ( ! mStatevals.test( BELFEM_STATEVAL_S ) )
+            {
+                mStatevals.set( BELFEM_STATEVAL_S, this->eval_s( aT, aP ) );
+            }
+
+            return mStatevals.get( BELFEM_STATEVAL_S );
+        }
+
+//----------------------------------------------------------------------------
+
+        real
+        GasContext::mu( const real aT, const real aP )
+        {
+            mStatevals.update_Tp( aT, aP );
+
+            if ( ! mStatevals.test( BELFEM_STATEVAL_MU ) )
+            {
+                mStatevals.set( BELFEM_STATEVAL_MU, this->eval_mu( aT, aP ) );
+            }
+
+            return mStatevals.get( BELFEM_STATEVAL_MU );
+        }
+
+//----------------------------------------------------------------------------
+
+        real
+        GasContext::lambda( const real aT, const real aP )
+        {
+            mStatevals.update_Tp( aT, aP );
+
+            if ( ! mStatevals.test( BELFEM_STATEVAL_LAMBDA ) )
+            {
+                mStatevals.set( BELFEM_STATEVAL_LAMBDA, this->eval_lambda( aT, aP ) );
+            }
+
+            return mStatevals.get( BELFEM_STATEVAL_LAMBDA );
+        }
+
+//----------------------------------------------------------------------------
+
+        real
+        GasContext::Pr( const real aT, const real aP )
+        {
+            mStatevals.update_Tp( aT, aP );
+
+            if ( ! mStatevals.test( BELFEM_STATEVAL_PR ) )
+            {
+                mStatevals.set( BELFEM_STATEVAL_PR,
+                                this->cp( aT, aP ) * this->mu( aT, aP ) /
+                                this->lambda( aT, aP ) );
+            }
+
+            return mStatevals.get( BELFEM_STATEVAL_PR );
+        }
+
+//----------------------------------------------------------------------------
+
+        real
+        GasContext::eval_M( const real aT, const real aP )
+        {
+            return mGas.mM ;
+        }
+
+//----------------------------------------------------------------------------
+
+        real
+        GasContext::eval_R( const real aT, const real aP )
+        {
+            return mGas.mR ;
+        }
+
+//----------------------------------------------------------------------------
+
+        real
+        GasContext::eval_cp( const real aT, const real aP )
+        {
+            return mGas.mHeatSpline.deval( aT );
+        }
+
+//----------------------------------------------------------------------------
+
+        real
+        GasContext::eval_h( const real aT, const real aP )
+        {
+            return mGas.mHeatSpline.eval( aT );
+        }
+
+//----------------------------------------------------------------------------
+
+        real
+        GasContext::eval_s( const real aT, const real aP )
+        {
+            return ( std::log( gastables::gPref / aP ) + mGas.mMixtureEntropy )
+                   * this->R( aT, aP )  + mGas.mHeatSpline.entropy( aT ) ;
+        }
+
+//----------------------------------------------------------------------------
+
+        real
+        GasContext::eval_mu( const real aT, const real aP )
+        {
+            return mGas.mViscositySpline.eval( aT );
+        }
+
+//----------------------------------------------------------------------------
+
+        real
+        GasContext::eval_lambda( const real aT, const real aP )
+        {
+            return mGas.mConductivitySpline.eval( aT );
+        }
+
+//----------------------------------------------------------------------------
+    }
+}
@@ -0,0 +1,129 @@
+//
+// Created by Christian Messe on 17.10.26.
+//
+
+#ifndef BELFEM_CL_GM_GASCONTEXT_HPP
+#define BELFEM_CL_GM_GASCONTEXT_HPP
+
+#include "typedefs.hpp"
+#include "cl_GM_Statevals.hpp"
+
+namespace belfem
+{
+    class Gas ;
+
+    namespace gasmodels
+    {
+//----------------------------------------------------------------------------
+
+        /**
+         * evaluation context of a gas for one thread.
+         *
+         * The context only reads the mixture data of the gas and keeps
+         * the cached values of the last state itself, so that several
+         * threads can evaluate the same gas, each with its own context.
+         * The gas must not be remixed while contexts are in use.
+         *
+         * Contexts are created by Gas::create_context(). The values
+         * are the same as the ones of the scalar functions of the gas.
+         */
+        class GasContext
+        {
+        protected:
+
+            // the gas, which is never changed by the context
+            const Gas & mGas ;
+
+            // cached values of the last state
+            Statevals mStatevals ;
+
+//----------------------------------------------------------------------------
+        public:
+//----------------------------------------------------------------------------
+
+            GasContext( const Gas & aGas );
+
+//----------------------------------------------------------------------------
+
+            virtual ~GasContext() = default ;
+
+//----------------------------------------------------------------------------
+
+            // molar mass in kg/mol
+            const real &
+            M( const real aT, const real aP );
+
+            // specific gas constant in J/(kg*K)
+            const real &
+            R( const real aT, const real aP );
+
+//----------------------------------------------------------------------------
+
+            real
+            cp( const real aT, const real aP );
+
+            real
+            cv( const real aT, const real aP );
+
+            real
+            gamma( const real aT, const real aP );
+
+            real
+            c( const real aT, const real aP );
+
+            real
+            h( const real aT, const real aP );
+
+            real
+            s( const real aT, const real aP );
+
+//----------------------------------------------------------------------------
+
+            // dynamic viscosity in Pa*s
+            real
+            mu( const real aT, const real aP );
+
+            // thermal conductivity in W/(m*K)
+            real
+            lambda( const real aT, const real aP );
+
+            // Prandtl number
+            real
+            Pr( const real aT, const real aP );
+
+//----------------------------------------------------------------------------
+        protected:
+//----------------------------------------------------------------------------
+
+            /**
+             * the uncached property functions, the default
+             * implementation is for ideal gas mixtures
+             */
+            virtual real
+            eval_M( const real aT, const real aP );
+
+            virtual real
+            eval_R( const real aT, const real aP );
+
+            virtual real
+            eval_cp( const real aT, const real aP );
+
+            virtual real
+            eval_h( const real aT, const real aP );
+
+            virtual real
+            eval_s( const real aT, const real aP );
+
+            virtual real
+            eval_mu( const real aT, const real aP );
+
+            virtual real
+            eval_lambda( const real aT, const real aP );
+
+//----------------------------------------------------------------------------
+        };
+
+//----------------------------------------------------------------------------
+    }
+}
+#endif //BELFEM_CL_GM_GASCONTEXT_HPP
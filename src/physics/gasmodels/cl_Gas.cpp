@@ -18,6 +18,7 @@
 #include "cl_GT_RefGasFactory.hpp"
 
 #include "cl_GM_Statevals.hpp"
+#include "cl_GM_GasContext.hpp"
 #include "cl_GM_EoS.hpp"
 #include "cl_GM_EoS_Idgas.hpp"
 #include "cl_GM_EoS_Cubic.hpp"
@@ -1693,6 +1694,123 @@ namespace belfem
         return mStatevals.get( BELFEM_STATEVAL_PR );
     }
 
+//------------------------------------------------------------------------------
+// Thread Safe Evaluation
+//------------------------------------------------------------------------------
+
+    gasmodels::GasContext *
+    Gas::create_context() const
+    {
+        return new gasmodels::GasContext( *this );
+    }
+
+//------------------------------------------------------------------------------
+// Batched Properties
+//------------------------------------------------------------------------------
+
+    void
+    Gas::allocate_batch( const Vector< real > & aT,
+                         const Vector< real > & aP,
+                               Vector< real > & aValues ) const
+    {
+        BELFEM_ERROR( aT.length() == aP.length(),
+                      "length of T and p do not match ( %lu vs %lu )",
+                      ( long unsigned int ) aT.length(),
+                      ( long unsigned int ) aP.length() );
+
+        aValues.set_size( aT.length() );
+    }
+
+//------------------------------------------------------------------------------
+
+    void
+    Gas::M( const Vector< real > & aT, const Vector< real > & aP, Vector< real > & aM )
+    {
+        this->allocate_batch( aT, aP, aM );
+
+        index_t tN = aT.length() ;
+
+        for( index_t k=0; k<tN; ++k )
+        {
+            aM( k ) = this->M( aT( k ), aP( k ) ) ;
+        }
+    }
+
+//------------------------------------------------------------------------------
+
+    void
+    Gas::cp( const Vector< real > & aT, const Vector< real > & aP, Vector< real > & aCp )
+    {
+        this->allocate_batch( aT, aP, aCp );
+
+        index_t tN = aT.length() ;
+
+        for( index_t k=0; k<tN; ++k )
+        {
+            aCp( k ) = ( this->*mFunctionCp )( aT( k ), aP( k ) ) ;
+        }
+    }
+
+//------------------------------------------------------------------------------
+
+    void
+    Gas::h( const Vector< real > & aT, const Vector< real > & aP, Vector< real > & aH )
+    {
+        this->allocate_batch( aT, aP, aH );
+
+        index_t tN = aT.length() ;
+
+        for( index_t k=0; k<tN; ++k )
+        {
+            aH( k ) = ( this->*mFunctionH )( aT( k ), aP( k ) ) ;
+        }
+    }
+
+//------------------------------------------------------------------------------
+
+    void
+    Gas::s( const Vector< real > & aT, const Vector< real > & aP, Vector< real > & aS )
+    {
+        this->allocate_batch( aT, aP, aS );
+
+        index_t tN = aT.length() ;
+
+        for( index_t k=0; k<tN; ++k )
+        {
+            aS( k ) = ( this->*mFunctionS )( aT( k ), aP( k ) ) ;
+        }
+    }
+
+//------------------------------------------------------------------------------
+
+    void
+    Gas::mu( const Vector< real > & aT, const Vector< real > & aP, Vector< real > & aMu )
+    {
+        this->allocate_batch( aT, aP, aMu );
+
+        index_t tN = aT.length() ;
+
+        for( index_t k=0; k<tN; ++k )
+        {
+            aMu( k ) = ( this->*mFunctionMU )( aT( k ), aP( k ) ) ;
+        }
+    }
+
+//------------------------------------------------------------------------------
+
+    void
+    Gas::lambda( const Vector< real > & aT, const Vector< real > & aP, Vector< real > & aLambda )
+    {
+        this->allocate_batch( aT, aP, aLambda );
+
+        index_t tN = aT.length() ;
+
+        for( index_t k=0; k<tN; ++k )
+        {
+            aLambda( k ) = ( this->*mFunctionLAMBDA )( aT( k ), aP( k ) ) ;
+        }
+    }
+
 //------------------------------------------------------------------------------
 
     // create the table needed for formation enthalpy
@@ -1831,6 +1949,19 @@ namespace belfem
 
     void
     Gas::compute_equilibrium( const real aT, const real aP, Vector< real > & aX )
+    {
+        // the abundances are computed before aX is changed
+        this->compute_equilibrium( aT, aP, aX, aX );
+    }
+
+//------------------------------------------------------------------------------
+
+    void
+    Gas::compute_equilibrium(
+            const real aT,
+            const real aP,
+            const Vector< real > & aX0,
+                  Vector< real > & aX )
     {
         if( mNumberOfComponents > 1 )
         {
@@ -1894,7 +2025,7 @@ namespace belfem
             this->Gibbs( aT, tMu0 );
 
             // compute mass balance constraint
-            tB0 = trans( tA ) * aX;
+            tB0 = trans( tA ) * aX0;
 
             // start loop
             uint tCount = 0;
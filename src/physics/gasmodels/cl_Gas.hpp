@@ -36,6 +36,12 @@ namespace belfem
         class Statevals;
         class EoS;
         class HelmholtzTransport ;
+        class GasContext ;
+    }
+
+    namespace bspline
+    {
+        class GasTableBuilder ;
     }
 
 //------------------------------------------------------------------------------
@@ -44,6 +50,12 @@ namespace belfem
        */
     class Gas
     {
+        // needs the remix functions for the table generation
+        friend class bspline::GasTableBuilder ;
+
+        // reads the splines of the mixture
+        friend class gasmodels::GasContext ;
+
     protected:
         //const proc_t mMasterRank = 0;
         const proc_t mMyRank = comm_rank();
@@ -480,6 +492,46 @@ namespace belfem
         real
         Pr( const real aT, const real aP );
 
+//------------------------------------------------------------------------------
+// Thread Safe Evaluation
+//------------------------------------------------------------------------------
+
+        /**
+         * create an evaluation context, which can be used by one thread
+         * while other threads use their own contexts of the same gas.
+         * The caller owns the context. Currently only for ideal gases.
+         */
+        virtual gasmodels::GasContext *
+        create_context() const ;
+
+//------------------------------------------------------------------------------
+// Batched Properties
+//------------------------------------------------------------------------------
+
+        /**
+         * evaluate a property for many ( T, p ) points at once.
+         * The output vector is resized to the number of points.
+         * These functions do not use the state cache, and give
+         * the same values as the scalar functions.
+         */
+        virtual void
+        M( const Vector< real > & aT, const Vector< real > & aP, Vector< real > & aM );
+
+        virtual void
+        cp( const Vector< real > & aT, const Vector< real > & aP, Vector< real > & aCp );
+
+        virtual void
+        h( const Vector< real > & aT, const Vector< real > & aP, Vector< real > & aH );
+
+        virtual void
+        s( const Vector< real > & aT, const Vector< real > & aP, Vector< real > & aS );
+
+        virtual void
+        mu( const Vector< real > & aT, const Vector< real > & aP, Vector< real > & aMu );
+
+        virtual void
+        lambda( const Vector< real > & aT, const Vector< real > & aP, Vector< real > & aLambda );
+
 //------------------------------------------------------------------------------
 // Thermodynamic Coefficients
 //------------------------------------------------------------------------------
@@ -546,6 +598,16 @@ namespace belfem
          void
          compute_equilibrium( const real aT, const real aP, Vector< real > & aX );
 
+         /**
+          * equilibrium for the element abundances of the reference
+          * composition aX0, aX is the initial guess and the result
+          */
+         void
+         compute_equilibrium( const real aT,
+                              const real aP,
+                              const Vector< real > & aX0,
+                                    Vector< real > & aX );
+
 //------------------------------------------------------------------------------
 // State relevant methods
 // -----------------------------------------------------------------------------
@@ -711,6 +773,22 @@ namespace belfem
         void
         create_eos( const GasModel & aGasModel );
 
+//------------------------------------------------------------------------------
+    protected:
+//------------------------------------------------------------------------------
+
+        /**
+         * check the input of a batched function and allocate the output
+         */
+        void
+        allocate_batch( const Vector< real > & aT,
+                        const Vector< real > & aP,
+                              Vector< real > & aValues ) const ;
+
+//------------------------------------------------------------------------------
+    private:
+//------------------------------------------------------------------------------
+
 //------------------------------------------------------------------------------
 
         void
@@ -82,6 +82,14 @@ namespace belfem
                       mLabel.c_str() );
     }
 
+//----------------------------------------------------------------------------
+
+    void
+    Material::use_tables( const bool aSwitch, const real aTolerance )
+    {
+        // the tables are optional, so there is nothing to do here
+    }
+
 //----------------------------------------------------------------------------
 
 
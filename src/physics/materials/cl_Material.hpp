@@ -28,6 +28,9 @@ namespace belfem
         // maximum temperture
         real mTmax = BELFEM_REAL_MAX ;
 
+        // lookup tables start at this temperature
+        real mTableTmin = 1.0 ;
+
         // flag telling if this material is used
         bool mFlag = false ;
 
@@ -342,6 +345,16 @@ namespace belfem
         virtual void
         use_splines( const bool aSwitch ) ;
 
+//----------------------------------------------------------------------------
+
+        /**
+         * replace the property functions by lookup tables, which
+         * are created with the given relative tolerance.
+         * Materials without tables keep their functions.
+         */
+        virtual void
+        use_tables( const bool aSwitch, const real aTolerance=1e-6 ) ;
+
 //----------------------------------------------------------------------------
     };
 
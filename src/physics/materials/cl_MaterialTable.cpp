@@ -0,0 +1,161 @@
+//
+// Created by Christian Messe on 17.10.26.
+//
+
+#include "cl_MaterialTable.hpp"
+#include "assert.hpp"
+#include "cl_Logger.hpp"
+
+namespace belfem
+{
+//----------------------------------------------------------------------------
+
+    MaterialTable::MaterialTable(
+            const std::function< real( const real ) > & aFunction,
+            const real    aTmin,
+            const real    aTmax,
+            const real    aTolerance,
+            const real    aFloor,
+            const index_t aMaxNumberOfCells ) :
+            mTmin( aTmin ),
+            mTmax( aTmax )
+    {
+        BELFEM_ERROR( aTmin < aTmax, "Invalid temperature range for material table" );
+        BELFEM_ERROR( aTolerance > 0, "Tolerance for material table must be positive" );
+        BELFEM_ERROR( aFloor >= 0, "Floor for material table must not be negative" );
+
+        index_t tNumberOfCells = 64 ;
+
+        mError = this->create_coefficients( aFunction, tNumberOfCells, aFloor );
+
+        // each refinement reduces the error by about a factor of 16
+        while( mError > aTolerance && 2 * tNumberOfCells <= aMaxNumberOfCells )
+        {
+            tNumberOfCells *= 2 ;
+            mError = this->create_coefficients( aFunction, tNumberOfCells, aFloor );
+        }
+
+        if( mError > aTolerance )
+        {
+            message( 4, " Warning: material table with %u cells only reaches a relative error of %8.3e\n",
+                     ( unsigned int ) mNumberOfCells, ( double ) mError );
+        }
+    }
+
+//----------------------------------------------------------------------------
+
+    void
+    MaterialTable::eval( const Vector< real > & aT, Vector< real > & aValues ) const
+    {
+        index_t tN = aT.length() ;
+
+        aValues.set_size( tN );
+
+        const real * tT = aT.data() ;
+        real * tValues = aValues.data() ;
+
+#ifdef OMP
+        #pragma omp simd
+#endif
+        for( index_t k=0; k<tN; ++k )
+        {
+            tValues[ k ] = this->eval( tT[ k ] );
+        }
+    }
+
+//----------------------------------------------------------------------------
+
+    real
+    MaterialTable::create_coefficients(
+            const std::function< real( const real ) > & aFunction,
+            const index_t aNumberOfCells,
+            const real    aFloor )
+    {
+        mNumberOfCells = aNumberOfCells ;
+        mLastCell = ( real ) ( aNumberOfCells - 1 );
+
+        real tStep = ( mTmax - mTmin ) / ( real ) aNumberOfCells ;
+        mInvStep = 1.0 / tStep ;
+
+        // step for the finite differences
+        real tDelta = 1e-4 * tStep ;
+
+        // values and derivatives on the grid points
+        Vector< real > tF( aNumberOfCells + 1 );
+        Vector< real > tdFdT( aNumberOfCells + 1 );
+
+        real tScale = 0.0 ;
+
+        for( index_t k=0; k<=aNumberOfCells; ++k )
+        {
+            real tT = mTmin + k * tStep ;
+
+            tF( k ) = aFunction( tT );
+
+            tScale = std::max( tScale, std::abs( tF( k ) ) );
+
+            // the function is not sampled outside of the table
+            if( k == 0 )
+            {
+                tdFdT( k ) = ( 4.0 * aFunction( tT + tDelta ) - aFunction( tT + 2.0 * tDelta )
+                               - 3.0 * tF( k ) ) / ( 2.0 * tDelta );
+            }
+            else if( k == aNumberOfCells )
+            {
+                tdFdT( k ) = ( 3.0 * tF( k ) - 4.0 * aFunction( tT - tDelta )
+                               + aFunction( tT - 2.0 * tDelta ) ) / ( 2.0 * tDelta );
+            }
+            else
+            {
+                tdFdT( k ) = ( aFunction( tT + tDelta ) - aFunction( tT - tDelta ) )
+                             / ( 2.0 * tDelta );
+            }
+        }
+
+        // values below the floor are compared absolutely
+        real tFloor = aFloor > 0.0 ? aFloor : 1e-9 * tScale ;
+
+        if( tFloor == 0.0 )
+        {
+            tFloor = 1.0 ;
+        }
+
+        // Hermite polynomials in local coordinates xi = 0 ... 1
+        mCoeffs.set_size( 4 * aNumberOfCells );
+
+        for( index_t k=0; k<aNumberOfCells; ++k )
+        {
+            real tF0 = tF( k );
+            real tF1 = tF( k + 1 );
+            real tD0 = tdFdT( k ) * tStep ;
+            real tD1 = tdFdT( k + 1 ) * tStep ;
+
+            mCoeffs( 4 * k     ) = tF0 ;
+            mCoeffs( 4 * k + 1 ) = tD0 ;
+            mCoeffs( 4 * k + 2 ) = 3.0 * ( tF1 - tF0 ) - 2.0 * tD0 - tD1 ;
+            mCoeffs( 4 * k + 3 ) = 2.0 * ( tF0 - tF1 ) + tD0 + tD1 ;
+        }
+
+        // the error is checked between the grid points, relative to the
+        // local value, so that small values are resolved as well
+        real tError = 0.0 ;
+
+        for( index_t k=0; k<aNumberOfCells; ++k )
+        {
+            for( uint i=1; i<4; ++i )
+            {
+                real tT = mTmin + ( k + 0.25 * i ) * tStep ;
+
+                real tF = aFunction( tT );
+
+                tError = std::max( tError,
+                                   std::abs( this->eval( tT ) - tF )
+                                   / std::max( std::abs( tF ), tFloor ) );
+            }
+        }
+
+        return tError ;
+    }
+
+//----------------------------------------------------------------------------
+}
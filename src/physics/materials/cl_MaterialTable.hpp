@@ -0,0 +1,160 @@
+//
+// Created by Christian Messe on 17.10.26.
+//
+
+#ifndef BELFEM_CL_MATERIALTABLE_HPP
+#define BELFEM_CL_MATERIALTABLE_HPP
+
+#include <cmath>
+#include <functional>
+
+#include "typedefs.hpp"
+#include "cl_Vector.hpp"
+
+namespace belfem
+{
+//----------------------------------------------------------------------------
+
+    /**
+     * lookup table for a temperature dependent material property.
+     *
+     * The property is interpolated by cubic Hermite polynomials on an
+     * equidistant grid, which is refined until the error between the
+     * grid points is below the tolerance. The error is relative to the
+     * local value of the property, values whose magnitude is below the
+     * floor are compared against the floor instead.
+     *
+     * Outside of the table, the values at the boundaries are returned.
+     * Once created, the table is only read, so that it can be shared
+     * by several threads.
+     */
+    class MaterialTable
+    {
+        // lower temperature of the table
+        const real mTmin ;
+
+        // upper temperature of the table
+        const real mTmax ;
+
+        // number of cells
+        index_t mNumberOfCells = 0 ;
+
+        // inverse of the cell width
+        real mInvStep = 0.0 ;
+
+        // index of the last cell as real number
+        real mLastCell = 0.0 ;
+
+        // relative error that was reached
+        real mError = 0.0 ;
+
+        // four polynomial coefficients per cell
+        Vector< real > mCoeffs ;
+
+//----------------------------------------------------------------------------
+    public:
+//----------------------------------------------------------------------------
+
+        /**
+         * @param aFunction        : the property function
+         * @param aTmin            : lower temperature of the table
+         * @param aTmax            : upper temperature of the table
+         * @param aTolerance       : relative tolerance of the interpolation
+         * @param aFloor           : smallest magnitude used for the relative error,
+         *                           zero means 1e-9 of the largest value
+         * @param aMaxNumberOfCells: maximum size of the table
+         */
+        MaterialTable( const std::function< real( const real ) > & aFunction,
+                       const real    aTmin,
+                       const real    aTmax,
+                       const real    aTolerance=1e-6,
+                       const real    aFloor=0.0,
+                       const index_t aMaxNumberOfCells=65536 );
+
+//----------------------------------------------------------------------------
+
+        ~MaterialTable() = default ;
+
+//----------------------------------------------------------------------------
+
+        /**
+         * evaluate the property
+         */
+        real
+        eval( const real aT ) const ;
+
+//----------------------------------------------------------------------------
+
+        /**
+         * evaluate the property for several temperatures
+         */
+        void
+        eval( const Vector< real > & aT, Vector< real > & aValues ) const ;
+
+//----------------------------------------------------------------------------
+
+        index_t
+        number_of_cells() const ;
+
+//----------------------------------------------------------------------------
+
+        /**
+         * the relative error of the table
+         */
+        real
+        error() const ;
+
+//----------------------------------------------------------------------------
+    private:
+//----------------------------------------------------------------------------
+
+        /**
+         * compute the coefficients for a given number of cells
+         * and return the largest relative error
+         */
+        real
+        create_coefficients( const std::function< real( const real ) > & aFunction,
+                             const index_t aNumberOfCells,
+                             const real    aFloor );
+
+//----------------------------------------------------------------------------
+    };
+
+//----------------------------------------------------------------------------
+
+    inline real
+    MaterialTable::eval( const real aT ) const
+    {
+        // position in the table, clamped to its boundaries
+        real tX = std::min( std::max( ( aT - mTmin ) * mInvStep, 0.0 ),
+                            ( real ) mNumberOfCells );
+
+        // the last cell also takes the upper boundary
+        real tCell = std::min( std::floor( tX ), mLastCell );
+
+        real tXi = tX - tCell ;
+
+        const real * tC = mCoeffs.data() + 4 * ( index_t ) tCell ;
+
+        return ( ( tC[ 3 ] * tXi + tC[ 2 ] ) * tXi + tC[ 1 ] ) * tXi + tC[ 0 ] ;
+    }
+
+//----------------------------------------------------------------------------
+
+    inline index_t
+    MaterialTable::number_of_cells() const
+    {
+        return mNumberOfCells ;
+    }
+
+//----------------------------------------------------------------------------
+
+    inline real
+    MaterialTable::error() const
+    {
+        return mError ;
+    }
+
+//----------------------------------------------------------------------------
+}
+#endif //BELFEM_CL_MATERIALTABLE_HPP
@@ -47,6 +47,7 @@ namespace belfem
         {
             delete mCpSpline ;
             delete mRhoSpline ;
+            this->delete_tables() ;
         }
 //----------------------------------------------------------------------------
 
@@ -60,6 +61,12 @@ namespace belfem
             mRhoRef = this->rho_el0_nist( mTref );
 
             this->create_conductivity_polys() ;
+
+            // the tables depend on the purity
+            if( mRhoTable != nullptr )
+            {
+                this->use_tables( true, mTableTolerance );
+            }
         }
 
 
@@ -836,6 +843,10 @@ namespace belfem
         void
         Copper::use_splines( const bool aSwitch )
         {
+            this->delete_tables() ;
+
+            mUseSplines = aSwitch ;
+
             if( aSwitch )
             {
                 mCpFunction   = & Copper::c_spline ;
@@ -850,6 +861,58 @@ namespace belfem
             }
         }
 
+//----------------------------------------------------------------------------
+
+        void
+        Copper::use_tables( const bool aSwitch, const real aTolerance )
+        {
+            // go back to the functions that are tabulated
+            this->use_splines( mUseSplines );
+
+            if( aSwitch )
+            {
+                mTableTolerance = aTolerance ;
+
+                mCpTable = new MaterialTable(
+                        [ this ]( const real aT ) { return this->c( aT ); },
+                        mTableTmin, mTmax, aTolerance );
+
+                mLambdaTable = new MaterialTable(
+                        [ this ]( const real aT ) { return this->lambda( aT ); },
+                        mTableTmin, mTmax, aTolerance );
+
+                mRhoTable = new MaterialTable(
+                        [ this ]( const real aT ) { return this->rho_el0( aT ); },
+                        mTableTmin, mTmax, aTolerance );
+
+                mCpFunction      = & Copper::c_table ;
+                mLambda0Function = & Copper::lambda_table ;
+                mRho0Function    = & Copper::rho_el0_table ;
+            }
+        }
+
+//----------------------------------------------------------------------------
+
+        void
+        Copper::delete_tables()
+        {
+            if( mCpTable != nullptr )
+            {
+                delete mCpTable ;
+                mCpTable = nullptr ;
+            }
+            if( mLambdaTable != nullptr )
+            {
+                delete mLambdaTable ;
+                mLambdaTable = nullptr ;
+            }
+            if( mRhoTable != nullptr )
+            {
+                delete mRhoTable ;
+                mRhoTable = nullptr ;
+            }
+        }
+
 
 //----------------------------------------------------------------------------
     } /* end namespace material */
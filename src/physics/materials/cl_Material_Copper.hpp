@@ -11,6 +11,7 @@
 
 #include "cl_IsotropicMaterial.hpp"
 #include "cl_Spline.hpp"
+#include "cl_MaterialTable.hpp"
 
 namespace belfem
 {
@@ -24,6 +25,16 @@ namespace belfem
             Spline * mCpSpline = nullptr ;
             Spline * mRhoSpline = nullptr ;
 
+            // lookup tables, only if use_tables is switched on
+            MaterialTable * mCpTable = nullptr ;
+            MaterialTable * mLambdaTable = nullptr ;
+            MaterialTable * mRhoTable = nullptr ;
+
+            // tells which functions are tabulated
+            bool mUseSplines = true ;
+
+            real mTableTolerance = 0.0 ;
+
             const real mSwitchCT0 = 9.;
             const real mSwitchCT1 = 15.;
             const real mSwitchCT2 = 50.;
@@ -199,6 +210,11 @@ namespace belfem
             void
             use_splines( const bool aSwitch ) ;
 
+//----------------------------------------------------------------------------
+
+            void
+            use_tables( const bool aSwitch, const real aTolerance=1e-6 ) ;
+
 //----------------------------------------------------------------------------
         private:
 //----------------------------------------------------------------------------
@@ -301,6 +317,22 @@ namespace belfem
             real
             compute_T_lambda_peak() ;
 
+//----------------------------------------------------------------------------
+
+            void
+            delete_tables();
+
+//----------------------------------------------------------------------------
+
+            real
+            c_table( const real aT ) const;
+
+            real
+            lambda_table( const real aT ) const;
+
+            real
+            rho_el0_table( const real aT ) const;
+
 //----------------------------------------------------------------------------
         };
 //----------------------------------------------------------------------------
@@ -320,6 +352,30 @@ namespace belfem
             return mCpSpline->eval( aT );
         }
 
+//----------------------------------------------------------------------------
+
+        inline real
+        Copper::c_table( const real aT ) const
+        {
+            return mCpTable->eval( aT );
+        }
+
+//----------------------------------------------------------------------------
+
+        inline real
+        Copper::lambda_table( const real aT ) const
+        {
+            return mLambdaTable->eval( aT );
+        }
+
+//----------------------------------------------------------------------------
+
+        inline real
+        Copper::rho_el0_table( const real aT ) const
+        {
+            return mRhoTable->eval( aT );
+        }
+
 //----------------------------------------------------------------------------
 
         inline real
@@ -29,12 +29,21 @@ namespace belfem
             this->create_expansion_poly();
             this->create_density_poly( 8890.0, 295.372 );
 
+            this->use_tables( false );
+
             mHasThermal = true;
             mHasMechanical = false ;
             mHasExpansion = true;
             mHasResistivity = false ;
         }
 
+//----------------------------------------------------------------------------
+
+        HastelloyC276::~HastelloyC276()
+        {
+            this->delete_tables() ;
+        }
+
 //----------------------------------------------------------------------------
 
         void
@@ -161,7 +170,7 @@ namespace belfem
 //----------------------------------------------------------------------------
 
         real
-        HastelloyC276::rho_el( const real aJ, const real aT, const real aB, const real aAngle ) const
+        HastelloyC276::rho_el_poly( const real aT ) const
         {
             if ( aT < mSwitchRhoT0 )
             {
@@ -180,7 +189,7 @@ namespace belfem
 //----------------------------------------------------------------------------
 
         real
-        HastelloyC276::c( const real aT ) const
+        HastelloyC276::c_poly( const real aT ) const
         {
             if ( aT < mSwitchCT1 )
             {
@@ -263,7 +272,7 @@ namespace belfem
 //----------------------------------------------------------------------------
 
         real
-        HastelloyC276::lambda( const real aT ) const
+        HastelloyC276::lambda_poly( const real aT ) const
         {
             if ( aT < mSwitchLambdaT0 )
             {
@@ -288,6 +297,60 @@ namespace belfem
                    - polyval( mIntAlphaPoly, aTref ) - 1.0 ;
         }
 
+//----------------------------------------------------------------------------
+
+        void
+        HastelloyC276::use_tables( const bool aSwitch, const real aTolerance )
+        {
+            // go back to the functions that are tabulated
+            this->delete_tables() ;
+
+            mCpFunction     = & HastelloyC276::c_poly ;
+            mLambdaFunction = & HastelloyC276::lambda_poly ;
+            mRhoFunction    = & HastelloyC276::rho_el_poly ;
+
+            if( aSwitch )
+            {
+                mCpTable = new MaterialTable(
+                        [ this ]( const real aT ) { return this->c_poly( aT ); },
+                        mTableTmin, mTmax, aTolerance );
+
+                mLambdaTable = new MaterialTable(
+                        [ this ]( const real aT ) { return this->lambda_poly( aT ); },
+                        mTableTmin, mTmax, aTolerance );
+
+                mRhoTable = new MaterialTable(
+                        [ this ]( const real aT ) { return this->rho_el_poly( aT ); },
+                        mTableTmin, mTmax, aTolerance );
+
+                mCpFunction     = & HastelloyC276::c_table ;
+                mLambdaFunction = & HastelloyC276::lambda_table ;
+                mRhoFunction    = & HastelloyC276::rho_el_table ;
+            }
+        }
+
+//----------------------------------------------------------------------------
+
+        void
+        HastelloyC276::delete_tables()
+        {
+            if( mCpTable != nullptr )
+            {
+                delete mCpTable ;
+                mCpTable = nullptr ;
+            }
+            if( mLambdaTable != nullptr )
+            {
+                delete mLambdaTable ;
+                mLambdaTable = nullptr ;
+            }
+            if( mRhoTable != nullptr )
+            {
+                delete mRhoTable ;
+                mRhoTable = nullptr ;
+            }
+        }
+
 //----------------------------------------------------------------------------
     }
 }
\ No newline at end of file
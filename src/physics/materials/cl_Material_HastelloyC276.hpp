@@ -10,6 +10,7 @@
 #include "cl_Vector.hpp"
 
 #include "cl_IsotropicMaterial.hpp"
+#include "cl_MaterialTable.hpp"
 
 namespace belfem
 {
@@ -49,6 +50,20 @@ namespace belfem
 
             Vector< real > mIntAlphaPoly ;
 
+            // lookup tables, only if use_tables is switched on
+            MaterialTable * mCpTable = nullptr ;
+            MaterialTable * mLambdaTable = nullptr ;
+            MaterialTable * mRhoTable = nullptr ;
+
+            real
+            ( HastelloyC276::*mCpFunction )( const real aT ) const ;
+
+            real
+            ( HastelloyC276::*mLambdaFunction )( const real aT ) const ;
+
+            real
+            ( HastelloyC276::*mRhoFunction )( const real aT ) const ;
+
 //----------------------------------------------------------------------------
         public:
 //----------------------------------------------------------------------------
@@ -57,7 +72,7 @@ namespace belfem
 
 //----------------------------------------------------------------------------
 
-            ~HastelloyC276() = default;
+            ~HastelloyC276();
 
 //----------------------------------------------------------------------------
 
@@ -105,6 +120,11 @@ namespace belfem
             real
             mu( const real aT=BELFEM_TREF, const real aTref=BELFEM_TREF ) const ;
 
+//----------------------------------------------------------------------------
+
+            void
+            use_tables( const bool aSwitch, const real aTolerance=1e-6 ) ;
+
 //----------------------------------------------------------------------------
         private:
 //----------------------------------------------------------------------------
@@ -137,9 +157,84 @@ namespace belfem
             void
             create_expansion_poly();
 
+//----------------------------------------------------------------------------
+
+            real
+            c_poly( const real aT ) const;
+
+            real
+            lambda_poly( const real aT ) const;
+
+            real
+            rho_el_poly( const real aT ) const;
+
+//----------------------------------------------------------------------------
+
+            void
+            delete_tables();
+
+//----------------------------------------------------------------------------
+
+            real
+            c_table( const real aT ) const;
+
+            real
+            lambda_table( const real aT ) const;
+
+            real
+            rho_el_table( const real aT ) const;
+
 //----------------------------------------------------------------------------
         };
 
+//----------------------------------------------------------------------------
+
+        inline real
+        HastelloyC276::c( const real aT ) const
+        {
+            return ( this->*mCpFunction )( aT );
+        }
+
+//----------------------------------------------------------------------------
+
+        inline real
+        HastelloyC276::lambda( const real aT ) const
+        {
+            return ( this->*mLambdaFunction )( aT );
+        }
+
+//----------------------------------------------------------------------------
+
+        inline real
+        HastelloyC276::rho_el( const real aJ, const real aT, const real aB, const real aAngle ) const
+        {
+            return ( this->*mRhoFunction )( aT );
+        }
+
+//----------------------------------------------------------------------------
+
+        inline real
+        HastelloyC276::c_table( const real aT ) const
+        {
+            return mCpTable->eval( aT );
+        }
+
+//----------------------------------------------------------------------------
+
+        inline real
+        HastelloyC276::lambda_table( const real aT ) const
+        {
+            return mLambdaTable->eval( aT );
+        }
+
+//----------------------------------------------------------------------------
+
+        inline real
+        HastelloyC276::rho_el_table( const real aT ) const
+        {
+            return mRhoTable->eval( aT );
+        }
+
 //----------------------------------------------------------------------------
 
         inline real
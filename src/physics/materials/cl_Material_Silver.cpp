@@ -46,6 +46,7 @@ namespace belfem
         {
             delete mCpSpline ;
             delete mRhoSpline ;
+            this->delete_tables() ;
         }
 
 //----------------------------------------------------------------------------
@@ -57,6 +58,12 @@ namespace belfem
             this->create_resistivity_polys() ;
             this->create_resistivity_spline();
             mRhoRef = this->rho_el0_nist( mTref );
+
+            // the tables depend on the purity
+            if( mRhoTable != nullptr )
+            {
+                this->use_tables( true, mTableTolerance );
+            }
         }
 
 //----------------------------------------------------------------------------
@@ -444,7 +451,7 @@ namespace belfem
 //----------------------------------------------------------------------------
 
         real
-        Silver::lambda( const real aT ) const
+        Silver::lambda_poly( const real aT ) const
         {
 
             real tW0 = 0.7323 / ( mRRR * aT );
@@ -486,6 +493,12 @@ namespace belfem
         void
         Silver::use_splines( const bool aSwitch )
         {
+            this->delete_tables() ;
+
+            mUseSplines = aSwitch ;
+
+            mLambdaFunction = & Silver::lambda_poly ;
+
             if( aSwitch )
             {
                 mCpFunction   = & Silver::c_spline ;
@@ -498,6 +511,58 @@ namespace belfem
             }
         }
 
+//----------------------------------------------------------------------------
+
+        void
+        Silver::use_tables( const bool aSwitch, const real aTolerance )
+        {
+            // go back to the functions that are tabulated
+            this->use_splines( mUseSplines );
+
+            if( aSwitch )
+            {
+                mTableTolerance = aTolerance ;
+
+                mCpTable = new MaterialTable(
+                        [ this ]( const real aT ) { return this->c( aT ); },
+                        mTableTmin, mTmax, aTolerance );
+
+                mLambdaTable = new MaterialTable(
+                        [ this ]( const real aT ) { return this->lambda( aT ); },
+                        mTableTmin, mTmax, aTolerance );
+
+                mRhoTable = new MaterialTable(
+                        [ this ]( const real aT ) { return this->rho_el0( aT ); },
+                        mTableTmin, mTmax, aTolerance );
+
+                mCpFunction     = & Silver::c_table ;
+                mLambdaFunction = & Silver::lambda_table ;
+                mRho0Function   = & Silver::rho_el0_table ;
+            }
+        }
+
+//----------------------------------------------------------------------------
+
+        void
+        Silver::delete_tables()
+        {
+            if( mCpTable != nullptr )
+            {
+                delete mCpTable ;
+                mCpTable = nullptr ;
+            }
+            if( mLambdaTable != nullptr )
+            {
+                delete mLambdaTable ;
+                mLambdaTable = nullptr ;
+            }
+            if( mRhoTable != nullptr )
+            {
+                delete mRhoTable ;
+                mRhoTable = nullptr ;
+            }
+        }
+
 //----------------------------------------------------------------------------
     }
 }
\ No newline at end of file
@@ -10,6 +10,7 @@
 
 #include "cl_IsotropicMaterial.hpp"
 #include "cl_Spline.hpp"
+#include "cl_MaterialTable.hpp"
 
 namespace belfem
 {
@@ -26,6 +27,16 @@ namespace belfem
             Spline * mCpSpline = nullptr ;
             Spline * mRhoSpline = nullptr ;
 
+            // lookup tables, only if use_tables is switched on
+            MaterialTable * mCpTable = nullptr ;
+            MaterialTable * mLambdaTable = nullptr ;
+            MaterialTable * mRhoTable = nullptr ;
+
+            // tells which functions are tabulated
+            bool mUseSplines = true ;
+
+            real mTableTolerance = 0.0 ;
+
             real mRhoRef ; // density at reference temperature
 
             const real mSwitchET0 = 300.0;
@@ -93,6 +104,9 @@ namespace belfem
             real
             ( Silver::*mRho0Function )( const real aT ) const ;
 
+            real
+            ( Silver::*mLambdaFunction )( const real aT ) const ;
+
 //----------------------------------------------------------------------------
         public:
 //----------------------------------------------------------------------------
@@ -163,6 +177,11 @@ namespace belfem
             void
             use_splines( const bool aSwitch );
 
+//----------------------------------------------------------------------------
+
+            void
+            use_tables( const bool aSwitch, const real aTolerance=1e-6 );
+
 //----------------------------------------------------------------------------
         private:
 //----------------------------------------------------------------------------
@@ -230,6 +249,27 @@ namespace belfem
             real
             c_spline( const real aT ) const;
 
+//--------------------------------------------------------------------------
+
+            real
+            lambda_poly( const real aT ) const;
+
+//--------------------------------------------------------------------------
+
+            void
+            delete_tables();
+
+//--------------------------------------------------------------------------
+
+            real
+            c_table( const real aT ) const;
+
+            real
+            lambda_table( const real aT ) const;
+
+            real
+            rho_el0_table( const real aT ) const;
+
 //--------------------------------------------------------------------------
         };
 
@@ -241,6 +281,38 @@ namespace belfem
             return ( this->*mCpFunction )( aT );
         }
 
+//----------------------------------------------------------------------------
+
+        inline real
+        Silver::lambda( const real aT ) const
+        {
+            return ( this->*mLambdaFunction )( aT );
+        }
+
+//----------------------------------------------------------------------------
+
+        inline real
+        Silver::c_table( const real aT ) const
+        {
+            return mCpTable->eval( aT );
+        }
+
+//----------------------------------------------------------------------------
+
+        inline real
+        Silver::lambda_table( const real aT ) const
+        {
+            return mLambdaTable->eval( aT );
+        }
+
+//----------------------------------------------------------------------------
+
+        inline real
+        Silver::rho_el0_table( const real aT ) const
+        {
+            return mRhoTable->eval( aT );
+        }
+
 //----------------------------------------------------------------------------
 
         inline real
@@ -13,6 +13,7 @@
 #include "cl_SolverPARDISO.hpp"
 #include "cl_SolverPETSC.hpp"
 #include "cl_SolverSTRUMPACK.hpp"
+#include "cl_SolverKrylov.hpp"
 
 namespace belfem
 {
@@ -75,6 +76,11 @@ namespace belfem
 #endif
                 break;
             }
+            case( SolverType::KRYLOV ) :
+            {
+                mWrapper = new solver::Krylov();
+                break;
+            }
             default:
             {
                 BELFEM_ERROR( false, "unknown solver type" );
@@ -116,6 +122,7 @@ namespace belfem
         // make sure that the wrapper has been initialized
         if ( !mWrapper->is_initialized() )
         {
+            this->check_index_type( aMatrix );
             mWrapper->initialize( aMatrix, mSymmetryMode, 1 );
         }
 
@@ -149,6 +156,7 @@ namespace belfem
         // make sure that the wrapper has been initialized
         if( ! mWrapper->is_initialized() )
         {
+            this->check_index_type( aMatrix );
             mWrapper->initialize(
                     aMatrix,
                     mSymmetryMode,
@@ -168,6 +176,17 @@ namespace belfem
         mWrapper->free() ;
     }
 
+//------------------------------------------------------------------------------
+
+    void
+    Solver::check_index_type( const SpMatrix & aMatrix ) const
+    {
+        BELFEM_ERROR( aMatrix.index_type() == SpMatrixIndexType::Int32
+                      || mWrapper->supports_long_indices(),
+                      "%s does not support matrices with 64-bit indices",
+                      mWrapper->label().c_str() );
+    }
+
 //------------------------------------------------------------------------------
 
     void
@@ -190,6 +209,34 @@ namespace belfem
         }
     }
 
+//------------------------------------------------------------------------------
+
+    void
+    Solver::set_krylov(
+            const Preconditioner aPreconditioner,
+            const KrylovMethod   aKrylovMethod,
+            const real           aEpsilon,
+            const uint           aMaxIterations,
+            const bool           aWarmStart )
+    {
+        if( mType == SolverType::KRYLOV )
+        {
+            // get wrapper
+            solver::Krylov * tKrylov =
+                    reinterpret_cast< solver::Krylov * >( mWrapper ) ;
+
+            // write information
+            tKrylov->set(
+                    aPreconditioner,
+                    aKrylovMethod,
+                    aEpsilon,
+                    aMaxIterations,
+                    aWarmStart );
+        }
+    }
+
+//------------------------------------------------------------------------------
+
     void
     Solver::set_mumps_reordering(
             const SerialReodrdering   aSerial,
@@ -241,6 +288,26 @@ namespace belfem
         }
     }
 
+//------------------------------------------------------------------------------
+
+    void
+    Solver::set_factorization_reuse(
+            const bool aSwitch,
+            const uint aMaxSteps,
+            const real aMaxContraction,
+            const real aEpsilon )
+    {
+        mWrapper->set_factorization_reuse( aSwitch, aMaxSteps, aMaxContraction, aEpsilon );
+    }
+
+//------------------------------------------------------------------------------
+
+    void
+    Solver::request_refactorization()
+    {
+        mWrapper->request_refactorization() ;
+    }
+
 //------------------------------------------------------------------------------
 
     /**
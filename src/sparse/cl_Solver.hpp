@@ -111,6 +111,25 @@ namespace belfem
                 const KrylovMethod   aKrylovMethod,
                 const real           aEpsilon = 1e-8 );
 
+//------------------------------------------------------------------------------
+
+        /**
+         * this does only do something if the native Krylov solver is used
+         *
+         * @param aPreconditioner  NONE, JACOBI, ILU or ICC
+         * @param aKrylovMethod    CG, GMRES, BCGS or AUTO
+         * @param aEpsilon         relative residual for convergence
+         * @param aMaxIterations   maximum number of iterations
+         * @param aWarmStart       use the incoming LHS as initial guess
+         */
+        void
+        set_krylov(
+                const Preconditioner aPreconditioner,
+                const KrylovMethod   aKrylovMethod,
+                const real           aEpsilon       = 1e-8,
+                const uint           aMaxIterations = 1000,
+                const bool           aWarmStart     = true );
+
 //------------------------------------------------------------------------------
 
         /**
@@ -130,6 +149,33 @@ namespace belfem
         set_mumps_error_analysis(
                 const MumpsErrorAnalysis aSetting );
 
+//------------------------------------------------------------------------------
+
+        /**
+         * keep the numeric factorization between two solves and use it
+         * for iterative refinement if the matrix has changed.
+         * Currently supported by UMFPACK and PARDISO.
+         *
+         * @param aSwitch          turn the reuse mode on or off
+         * @param aMaxSteps        maximum number of refinement steps
+         * @param aMaxContraction  refactorize if the residual contracts slower
+         * @param aEpsilon         relative residual for convergence
+         */
+        void
+        set_factorization_reuse(
+                const bool aSwitch,
+                const uint aMaxSteps       = 5,
+                const real aMaxContraction = 0.25,
+                const real aEpsilon        = 1e-10 );
+
+//------------------------------------------------------------------------------
+
+        /**
+         * enforce a new numeric factorization during the next solve
+         */
+        void
+        request_refactorization() ;
+
 //------------------------------------------------------------------------------
 
         /**
@@ -156,6 +202,16 @@ namespace belfem
         solver::Wrapper *
         wrapper() ;
 
+//------------------------------------------------------------------------------
+    private:
+//------------------------------------------------------------------------------
+
+        /**
+         * make sure that the wrapper can handle the index type of the matrix
+         */
+        void
+        check_index_type( const SpMatrix & aMatrix ) const ;
+
 //------------------------------------------------------------------------------
     };
 
@@ -0,0 +1,930 @@
+//
+// Created by Christian Messe on 17.10.26.
+//
+
+#include <cmath>
+#include <utility>
+
+#include "cl_SolverKrylov.hpp"
+#include "assert.hpp"
+#include "cl_Logger.hpp"
+#include "fn_dot.hpp"
+#include "fn_norm.hpp"
+
+namespace belfem
+{
+    namespace solver
+    {
+//------------------------------------------------------------------------------
+
+        Krylov::Krylov() :
+            Wrapper( "Krylov   " )
+        {
+        }
+
+//------------------------------------------------------------------------------
+
+        Krylov::~Krylov()
+        {
+            this->free();
+        }
+
+//------------------------------------------------------------------------------
+
+        void
+        Krylov::set(
+                const Preconditioner aPreconditioner,
+                const KrylovMethod   aKrylovMethod,
+                const real           aEpsilon,
+                const uint           aMaxIterations,
+                const bool           aWarmStart )
+        {
+            BELFEM_ERROR( ! this->is_initialized(),
+                          "Krylov solver settings must be set before the first solve" );
+
+            mPreconditioner = aPreconditioner ;
+            mKrylovMethod   = aKrylovMethod ;
+            mEpsilon        = aEpsilon ;
+            mMaxIterations  = aMaxIterations ;
+            mWarmStart      = aWarmStart ;
+        }
+
+//------------------------------------------------------------------------------
+
+        void
+        Krylov::initialize(
+                SpMatrix & aMatrix,
+                const SymmetryMode aSymmetryMode,
+                const int aNumRhsColumns )
+        {
+            // call initialize function from parent
+            Wrapper::initialize();
+
+            BELFEM_ERROR( aMatrix.n_rows() == aMatrix.n_cols(),
+                          "Krylov solver needs a square matrix ( is %lu x %lu )",
+                          ( long unsigned int ) aMatrix.n_rows(),
+                          ( long unsigned int ) aMatrix.n_cols() );
+
+            bool tIsSPD = aSymmetryMode == SymmetryMode::PositiveDefiniteSymmetric ;
+
+            // select the method
+            switch( mKrylovMethod )
+            {
+                case( KrylovMethod::CG ) :
+                case( KrylovMethod::GMRES ) :
+                case( KrylovMethod::BCGS ) :
+                {
+                    mMethod = mKrylovMethod ;
+                    break ;
+                }
+                case( KrylovMethod::AUTO ) :
+                case( KrylovMethod::UNDEFINED ) :
+                {
+                    mMethod = tIsSPD ? KrylovMethod::CG : KrylovMethod::GMRES ;
+                    break ;
+                }
+                default:
+                {
+                    BELFEM_ERROR( false, "Krylov method %s is not supported by the native solver",
+                                  to_string( mKrylovMethod ).c_str() );
+                }
+            }
+
+            // select the preconditioner
+            switch( mPreconditioner )
+            {
+                case( Preconditioner::NONE ) :
+                case( Preconditioner::JACOBI ) :
+                case( Preconditioner::ILU ) :
+                case( Preconditioner::ICC ) :
+                {
+                    mPrecond = mPreconditioner ;
+                    break ;
+                }
+                case( Preconditioner::UNDEFINED ) :
+                {
+                    mPrecond = mMethod == KrylovMethod::CG ? Preconditioner::ICC : Preconditioner::ILU ;
+                    break ;
+                }
+                default:
+                {
+                    BELFEM_ERROR( false, "Preconditioner %s is not supported by the native solver",
+                                  to_string( mPreconditioner ).c_str() );
+                }
+            }
+
+            mNumRows = aMatrix.n_rows() ;
+
+            // the CSR copy is only needed to compute the preconditioner
+            if( mPrecond != Preconditioner::NONE )
+            {
+                this->create_pattern( aMatrix );
+            }
+
+            switch( mPrecond )
+            {
+                case( Preconditioner::JACOBI ) :
+                {
+                    mFactor.set_size( mNumRows );
+                    break ;
+                }
+                case( Preconditioner::ILU ) :
+                case( Preconditioner::ICC ) :
+                {
+                    mFactor.set_size( aMatrix.number_of_nonzeros() );
+                    break ;
+                }
+                default:
+                {
+                    break ;
+                }
+            }
+
+            // allocate work vectors
+            mR.set_size( mNumRows );
+            mZ.set_size( mNumRows );
+            mP.set_size( mNumRows );
+            mQ.set_size( mNumRows );
+
+            if( mMethod == KrylovMethod::BCGS )
+            {
+                mS.set_size( mNumRows );
+                mT.set_size( mNumRows );
+                mWork.set_size( mNumRows );
+            }
+            else if( mMethod == KrylovMethod::GMRES )
+            {
+                mBasis.set_size( mRestart + 1, Vector< real >( mNumRows ) );
+            }
+        }
+
+//------------------------------------------------------------------------------
+
+        void
+        Krylov::create_pattern( SpMatrix & aMatrix )
+        {
+            const int tN     = mNumRows ;
+            const int tNNZ   = aMatrix.number_of_nonzeros() ;
+            const int tBase  = aMatrix.indexing_base() ;
+
+            const int * tPointers = aMatrix.pointers() ;
+            const int * tIndices  = aMatrix.indices() ;
+
+            mPointers.set_size( tN + 1, 0 );
+            mColumns.set_size( tNNZ );
+            mMap.set_size( tNNZ );
+
+            if( aMatrix.type() == SpMatrixType::CSR )
+            {
+                for( int i=0; i<=tN; ++i )
+                {
+                    mPointers( i ) = tPointers[ i ] - tBase ;
+                }
+
+                for( int i=0; i<tN; ++i )
+                {
+                    for( int p=mPointers( i ); p<mPointers( i+1 ); ++p )
+                    {
+                        mColumns( p ) = tIndices[ p ] - tBase ;
+                        mMap( p ) = p ;
+
+                        // make sure that the columns are sorted
+                        for( int q=p; q>mPointers( i ) && mColumns( q-1 ) > mColumns( q ); --q )
+                        {
+                            std::swap( mColumns( q ), mColumns( q-1 ) );
+                            std::swap( mMap( q ), mMap( q-1 ) );
+                        }
+                    }
+                }
+            }
+            else
+            {
+                // count the entries per row
+                for( int k=0; k<tNNZ; ++k )
+                {
+                    ++mPointers( tIndices[ k ] - tBase + 1 );
+                }
+                for( int i=0; i<tN; ++i )
+                {
+                    mPointers( i+1 ) += mPointers( i );
+                }
+
+                // transpose, looping over the columns keeps them sorted
+                Vector< int > tCount( tN );
+                for( int i=0; i<tN; ++i )
+                {
+                    tCount( i ) = mPointers( i );
+                }
+
+                for( int j=0; j<tN; ++j )
+                {
+                    for( int p=tPointers[ j ]-tBase; p<tPointers[ j+1 ]-tBase; ++p )
+                    {
+                        int q = tCount( tIndices[ p ] - tBase )++ ;
+                        mColumns( q ) = j ;
+                        mMap( q ) = p ;
+                    }
+                }
+            }
+
+            // find the diagonal entries
+            mDiagonal.set_size( tN, -1 );
+            for( int i=0; i<tN; ++i )
+            {
+                for( int p=mPointers( i ); p<mPointers( i+1 ); ++p )
+                {
+                    if( mColumns( p ) == i )
+                    {
+                        mDiagonal( i ) = p ;
+                        break ;
+                    }
+                }
+
+                BELFEM_ERROR( mDiagonal( i ) >= 0,
+                              "row %i has no diagonal entry, can't compute %s preconditioner",
+                              i, to_string( mPrecond ).c_str() );
+            }
+        }
+
+//------------------------------------------------------------------------------
+
+        void
+        Krylov::compute_preconditioner( const SpMatrix & aMatrix )
+        {
+            switch( mPrecond )
+            {
+                case( Preconditioner::JACOBI ) :
+                {
+                    this->compute_jacobi( aMatrix.data() );
+                    break ;
+                }
+                case( Preconditioner::ILU ) :
+                {
+                    this->compute_ilu0( aMatrix.data() );
+                    break ;
+                }
+                case( Preconditioner::ICC ) :
+                {
+                    this->compute_ic0( aMatrix.data() );
+                    break ;
+                }
+                default:
+                {
+                    break ;
+                }
+            }
+        }
+
+//------------------------------------------------------------------------------
+
+        void
+        Krylov::compute_jacobi( const real * aValues )
+        {
+            for( index_t i=0; i<mNumRows; ++i )
+            {
+                real tD = aValues[ mMap( mDiagonal( i ) ) ] ;
+
+                BELFEM_ERROR( tD != 0.0, "zero diagonal in row %lu, can't compute Jacobi preconditioner",
+                              ( long unsigned int ) i );
+
+                mFactor( i ) = 1.0 / tD ;
+            }
+        }
+
+//------------------------------------------------------------------------------
+
+        void
+        Krylov::compute_ilu0( const real * aValues )
+        {
+            const int tN = mNumRows ;
+
+            const int * tPointers = mPointers.data() ;
+            const int * tColumns  = mColumns.data() ;
+            const int * tDiagonal = mDiagonal.data() ;
+            real      * tLU       = mFactor.data() ;
+
+            for( index_t k=0; k<mMap.length(); ++k )
+            {
+                tLU[ k ] = aValues[ mMap( k ) ];
+            }
+
+            // position of the columns of the current row
+            Vector< int > tPosition( tN, -1 );
+
+            for( int i=0; i<tN; ++i )
+            {
+                for( int p=tPointers[ i ]; p<tPointers[ i+1 ]; ++p )
+                {
+                    tPosition( tColumns[ p ] ) = p ;
+                }
+
+                // eliminate the lower part of this row
+                for( int p=tPointers[ i ]; p<tDiagonal[ i ]; ++p )
+                {
+                    int k = tColumns[ p ] ;
+
+                    tLU[ p ] /= tLU[ tDiagonal[ k ] ];
+
+                    // only update entries that exist in the pattern
+                    for( int q=tDiagonal[ k ]+1; q<tPointers[ k+1 ]; ++q )
+                    {
+                        int w = tPosition( tColumns[ q ] );
+                        if( w >= 0 )
+                        {
+                            tLU[ w ] -= tLU[ p ] * tLU[ q ];
+                        }
+                    }
+                }
+
+                BELFEM_ERROR( tLU[ tDiagonal[ i ] ] != 0.0, "zero pivot in row %i during ILU(0)", i );
+
+                for( int p=tPointers[ i ]; p<tPointers[ i+1 ]; ++p )
+                {
+                    tPosition( tColumns[ p ] ) = -1 ;
+                }
+            }
+        }
+
+//------------------------------------------------------------------------------
+
+        void
+        Krylov::compute_ic0( const real * aValues )
+        {
+            const int tN = mNumRows ;
+
+            const int * tPointers = mPointers.data() ;
+            const int * tColumns  = mColumns.data() ;
+            const int * tDiagonal = mDiagonal.data() ;
+            real      * tU        = mFactor.data() ;
+
+            // relative shift of the diagonal if the factorization breaks down
+            real tShift = 0.0 ;
+
+            for( uint tAttempt=0; tAttempt<10; ++tAttempt )
+            {
+                // copy the upper triangle, A = U^T * U
+                for( int i=0; i<tN; ++i )
+                {
+                    for( int p=tDiagonal[ i ]; p<tPointers[ i+1 ]; ++p )
+                    {
+                        tU[ p ] = aValues[ mMap( p ) ];
+                    }
+                    tU[ tDiagonal[ i ] ] *= 1.0 + tShift ;
+                }
+
+                bool tOK = true ;
+
+                for( int k=0; k<tN; ++k )
+                {
+                    real & tD = tU[ tDiagonal[ k ] ];
+
+                    if( tD <= 0.0 )
+                    {
+                        tOK = false ;
+                        break ;
+                    }
+
+                    tD = std::sqrt( tD );
+
+                    for( int p=tDiagonal[ k ]+1; p<tPointers[ k+1 ]; ++p )
+                    {
+                        tU[ p ] /= tD ;
+                    }
+
+                    // update the trailing rows within the pattern
+                    for( int p=tDiagonal[ k ]+1; p<tPointers[ k+1 ]; ++p )
+                    {
+                        int i = tColumns[ p ];
+                        int r = tDiagonal[ i ];
+
+                        for( int q=p; q<tPointers[ k+1 ]; ++q )
+                        {
+                            int j = tColumns[ q ];
+
+                            while( r < tPointers[ i+1 ] && tColumns[ r ] < j )
+                            {
+                                ++r ;
+                            }
+
+                            if( r == tPointers[ i+1 ] )
+                            {
+                                break ;
+                            }
+
+                            if( tColumns[ r ] == j )
+                            {
+                                tU[ r ] -= tU[ p ] * tU[ q ];
+                            }
+                        }
+                    }
+                }
+
+                if( tOK )
+                {
+                    return ;
+                }
+
+                tShift = tShift == 0.0 ? 1e-3 : 2.0 * tShift ;
+
+                message( 4, "    ... IC(0) broke down, retrying with diagonal shift %8.3e\n", tShift );
+            }
+
+            BELFEM_ERROR( false, "IC(0) failed, matrix does not seem to be positive definite" );
+        }
+
+//------------------------------------------------------------------------------
+
+        void
+        Krylov::precondition( const Vector< real > & aR, Vector< real > & aZ )
+        {
+            const int tN = mNumRows ;
+
+            const real * tR = aR.data() ;
+            real       * tZ = aZ.data() ;
+
+            switch( mPrecond )
+            {
+                case( Preconditioner::JACOBI ) :
+                {
+                    for( int i=0; i<tN; ++i )
+                    {
+                        tZ[ i ] = mFactor( i ) * tR[ i ];
+                    }
+                    break ;
+                }
+                case( Preconditioner::ILU ) :
+                {
+                    const int  * tPointers = mPointers.data() ;
+                    const int  * tColumns  = mColumns.data() ;
+                    const int  * tDiagonal = mDiagonal.data() ;
+                    const real * tLU       = mFactor.data() ;
+
+                    // L has a unit diagonal
+                    for( int i=0; i<tN; ++i )
+                    {
+                        real tValue = tR[ i ];
+                        for( int p=tPointers[ i ]; p<tDiagonal[ i ]; ++p )
+                        {
+                            tValue -= tLU[ p ] * tZ[ tColumns[ p ] ];
+                        }
+                        tZ[ i ] = tValue ;
+                    }
+
+                    for( int i=tN-1; i>=0; --i )
+                    {
+                        real tValue = tZ[ i ];
+                        for( int p=tDiagonal[ i ]+1; p<tPointers[ i+1 ]; ++p )
+                        {
+                            tValue -= tLU[ p ] * tZ[ tColumns[ p ] ];
+                        }
+                        tZ[ i ] = tValue / tLU[ tDiagonal[ i ] ];
+                    }
+                    break ;
+                }
+                case( Preconditioner::ICC ) :
+                {
+                    const int  * tPointers = mPointers.data() ;
+                    const int  * tColumns  = mColumns.data() ;
+                    const int  * tDiagonal = mDiagonal.data() ;
+                    const real * tU        = mFactor.data() ;
+
+                    for( int i=0; i<tN; ++i )
+                    {
+                        tZ[ i ] = tR[ i ];
+                    }
+
+                    // solve U^T * y = r, U is traversed by rows
+                    for( int k=0; k<tN; ++k )
+                    {
+                        tZ[ k ] /= tU[ tDiagonal[ k ] ];
+                        for( int p=tDiagonal[ k ]+1; p<tPointers[ k+1 ]; ++p )
+                        {
+                            tZ[ tColumns[ p ] ] -= tU[ p ] * tZ[ k ];
+                        }
+                    }
+
+                    // solve U * z = y
+                    for( int k=tN-1; k>=0; --k )
+                    {
+                        real tValue = tZ[ k ];
+                        for( int p=tDiagonal[ k ]+1; p<tPointers[ k+1 ]; ++p )
+                        {
+                            tValue -= tU[ p ] * tZ[ tColumns[ p ] ];
+                        }
+                        tZ[ k ] = tValue / tU[ tDiagonal[ k ] ];
+                    }
+                    break ;
+                }
+                default:
+                {
+                    for( int i=0; i<tN; ++i )
+                    {
+                        tZ[ i ] = tR[ i ];
+                    }
+                    break ;
+                }
+            }
+        }
+
+//------------------------------------------------------------------------------
+
+        void
+        Krylov::solve(
+                SpMatrix & aMatrix,
+                Vector< real > & aLHS,
+                Vector< real > & aRHS )
+        {
+            // the old solution is the initial guess, eg. from the last timestep
+            if( ! mWarmStart || aLHS.length() != mNumRows )
+            {
+                aLHS.set_size( mNumRows, 0.0 );
+            }
+
+            mNumberOfIterations = 0 ;
+            mResidual = 0.0 ;
+
+            real tNormB = norm( aRHS );
+
+            if( tNormB == 0.0 )
+            {
+                aLHS.fill( 0.0 );
+                return ;
+            }
+
+            this->compute_preconditioner( aMatrix );
+
+            switch( mMethod )
+            {
+                case( KrylovMethod::CG ) :
+                {
+                    this->solve_cg( aMatrix, aLHS, aRHS, tNormB );
+                    break ;
+                }
+                case( KrylovMethod::BCGS ) :
+                {
+                    this->solve_bicgstab( aMatrix, aLHS, aRHS, tNormB );
+                    break ;
+                }
+                case( KrylovMethod::GMRES ) :
+                {
+                    this->solve_gmres( aMatrix, aLHS, aRHS, tNormB );
+                    break ;
+                }
+                default:
+                {
+                    BELFEM_ERROR( false, "Krylov solver has not been initialized" );
+                }
+            }
+
+            if( mResidual > mEpsilon )
+            {
+                message( 4, " Warning: %s-%s did not converge after %u iterations, residual %8.3e\n",
+                         to_string( mMethod ).c_str(),
+                         to_string( mPrecond ).c_str(),
+                         ( unsigned int ) mNumberOfIterations,
+                         ( double ) mResidual );
+            }
+            else
+            {
+                message( 5, "    ... %s-%s converged after %u iterations, residual %8.3e\n",
+                         to_string( mMethod ).c_str(),
+                         to_string( mPrecond ).c_str(),
+                         ( unsigned int ) mNumberOfIterations,
+                         ( double ) mResidual );
+            }
+        }
+
+//------------------------------------------------------------------------------
+
+        void
+        Krylov::solve(
+                SpMatrix & aMatrix,
+                Matrix< real > & aLHS,
+                Matrix< real > & aRHS )
+        {
+            const index_t tNumCols = aRHS.n_cols() ;
+
+            if( aLHS.n_rows() != mNumRows || aLHS.n_cols() != tNumCols )
+            {
+                aLHS.set_size( mNumRows, tNumCols, 0.0 );
+            }
+
+            Vector< real > tX( mNumRows );
+            Vector< real > tB( mNumRows );
+
+            // solve each column separately
+            for( index_t j=0; j<tNumCols; ++j )
+            {
+                for( index_t i=0; i<mNumRows; ++i )
+                {
+                    tX( i ) = aLHS( i, j );
+                    tB( i ) = aRHS( i, j );
+                }
+
+                this->solve( aMatrix, tX, tB );
+
+                for( index_t i=0; i<mNumRows; ++i )
+                {
+                    aLHS( i, j ) = tX( i );
+                }
+            }
+        }
+
+//------------------------------------------------------------------------------
+
+        void
+        Krylov::solve_cg(
+                SpMatrix & aMatrix,
+                Vector< real > & aX,
+                const Vector< real > & aB,
+                const real aNormB )
+        {
+            // r = b - A * x
+            mR = aB ;
+            aMatrix.multiply( aX, mR, -1.0, 1.0 );
+
+            this->precondition( mR, mZ );
+            mP = mZ ;
+
+            real tRZ = dot( mR, mZ );
+
+            mResidual = norm( mR ) / aNormB ;
+
+            while( mResidual > mEpsilon && mNumberOfIterations < mMaxIterations )
+            {
+                ++mNumberOfIterations ;
+
+                // q = A * p
+                aMatrix.multiply( mP, mQ );
+
+                real tPQ = dot( mP, mQ );
+
+                if( tPQ == 0.0 )
+                {
+                    break ;
+                }
+
+                real tAlpha = tRZ / tPQ ;
+
+                aX += tAlpha * mP ;
+                mR -= tAlpha * mQ ;
+
+                mResidual = norm( mR ) / aNormB ;
+
+                this->precondition( mR, mZ );
+
+                real tRZnew = dot( mR, mZ );
+                real tBeta = tRZnew / tRZ ;
+                tRZ = tRZnew ;
+
+                // p = z + beta * p
+                mP *= tBeta ;
+                mP += mZ ;
+            }
+        }
+
+//------------------------------------------------------------------------------
+
+        void
+        Krylov::solve_bicgstab(
+                SpMatrix & aMatrix,
+                Vector< real > & aX,
+                const Vector< real > & aB,
+                const real aNormB )
+        {
+            // r = b - A * x
+            mR = aB ;
+            aMatrix.multiply( aX, mR, -1.0, 1.0 );
+
+            // shadow residual
+            mWork = mR ;
+
+            mP.fill( 0.0 );
+            mQ.fill( 0.0 );
+
+            real tRho   = 1.0 ;
+            real tAlpha = 1.0 ;
+            real tOmega = 1.0 ;
+
+            mResidual = norm( mR ) / aNormB ;
+
+            while( mResidual > mEpsilon && mNumberOfIterations < mMaxIterations )
+            {
+                ++mNumberOfIterations ;
+
+                real tRhoNew = dot( mWork, mR );
+
+                if( tRhoNew == 0.0 || tOmega == 0.0 )
+                {
+                    break ;
+                }
+
+                real tBeta = ( tRhoNew / tRho ) * ( tAlpha / tOmega );
+                tRho = tRhoNew ;
+
+                // p = r + beta * ( p - omega * v ), v is stored in q
+                mP -= tOmega * mQ ;
+                mP *= tBeta ;
+                mP += mR ;
+
+                // v = A * M^-1 * p
+                this->precondition( mP, mZ );
+                aMatrix.multiply( mZ, mQ );
+
+                real tRV = dot( mWork, mQ );
+
+                if( tRV == 0.0 )
+                {
+                    break ;
+                }
+
+                tAlpha = tRho / tRV ;
+
+                // s = r - alpha * v
+                mS = mR ;
+                mS -= tAlpha * mQ ;
+
+                aX += tAlpha * mZ ;
+
+                mResidual = norm( mS ) / aNormB ;
+
+                if( mResidual <= mEpsilon )
+                {
+                    break ;
+                }
+
+                // t = A * M^-1 * s
+                this->precondition( mS, mZ );
+                aMatrix.multiply( mZ, mT );
+
+                real tTT = dot( mT, mT );
+
+                tOmega = tTT > 0.0 ? dot( mT, mS ) / tTT : 0.0 ;
+
+                aX += tOmega * mZ ;
+
+                // r = s - omega * t
+                mR = mS ;
+                mR -= tOmega * mT ;
+
+                mResidual = norm( mR ) / aNormB ;
+            }
+        }
+
+//------------------------------------------------------------------------------
+
+        void
+        Krylov::solve_gmres(
+                SpMatrix & aMatrix,
+                Vector< real > & aX,
+                const Vector< real > & aB,
+                const real aNormB )
+        {
+            const uint tM = mRestart ;
+
+            // Hessenberg matrix, Givens rotations and rhs of least squares problem
+            Matrix< real > tH( tM + 1, tM, 0.0 );
+            Vector< real > tCos( tM, 0.0 );
+            Vector< real > tSin( tM, 0.0 );
+            Vector< real > tG( tM + 1, 0.0 );
+            Vector< real > tY( tM, 0.0 );
+
+            // r = b - A * x
+            mR = aB ;
+            aMatrix.multiply( aX, mR, -1.0, 1.0 );
+
+            real tBeta = norm( mR );
+            mResidual = tBeta / aNormB ;
+
+            while( mResidual > mEpsilon && mNumberOfIterations < mMaxIterations )
+            {
+                mBasis( 0 ) = mR ;
+                mBasis( 0 ) /= tBeta ;
+
+                tG.fill( 0.0 );
+                tG( 0 ) = tBeta ;
+
+                uint tK = 0 ;
+
+                for( uint j=0; j<tM && mNumberOfIterations < mMaxIterations; ++j )
+                {
+                    ++mNumberOfIterations ;
+
+                    // w = A * M^-1 * v_j
+                    this->precondition( mBasis( j ), mZ );
+                    Vector< real > & tW = mBasis( j+1 );
+                    aMatrix.multiply( mZ, tW );
+
+                    // modified Gram-Schmidt
+                    for( uint i=0; i<=j; ++i )
+                    {
+                        tH( i, j ) = dot( tW, mBasis( i ) );
+                        tW -= tH( i, j ) * mBasis( i );
+                    }
+
+                    tH( j+1, j ) = norm( tW );
+
+                    if( tH( j+1, j ) > 0.0 )
+                    {
+                        tW /= tH( j+1, j );
+                    }
+
+                    // apply the previous rotations to the new column
+                    for( uint i=0; i<j; ++i )
+                    {
+                        real tTemp    =  tCos( i ) * tH( i, j ) + tSin( i ) * tH( i+1, j );
+                        tH( i+1, j )  = -tSin( i ) * tH( i, j ) + tCos( i ) * tH( i+1, j );
+                        tH( i, j )    = tTemp ;
+                    }
+
+                    // compute the new rotation
+                    real tDenom = std::hypot( tH( j, j ), tH( j+1, j ) );
+
+                    tK = j + 1 ;
+
+                    if( tDenom == 0.0 )
+                    {
+                        // lucky breakdown with singular H
+                        tK = j ;
+                        break ;
+                    }
+
+                    tCos( j ) = tH( j, j ) / tDenom ;
+                    tSin( j ) = tH( j+1, j ) / tDenom ;
+
+                    tH( j, j ) = tDenom ;
+                    tH( j+1, j ) = 0.0 ;
+
+                    tG( j+1 ) = -tSin( j ) * tG( j );
+                    tG( j ) *= tCos( j );
+
+                    mResidual = std::abs( tG( j+1 ) ) / aNormB ;
+
+                    if( mResidual <= mEpsilon )
+                    {
+                        break ;
+                    }
+                }
+
+                if( tK == 0 )
+                {
+                    break ;
+                }
+
+                // solve the upper triangular system H * y = g
+                for( int i=tK-1; i>=0; --i )
+                {
+                    real tValue = tG( i );
+                    for( uint l=i+1; l<tK; ++l )
+                    {
+                        tValue -= tH( i, l ) * tY( l );
+                    }
+                    tY( i ) = tValue / tH( i, i );
+                }
+
+                // x += M^-1 * V * y
+                mQ.fill( 0.0 );
+                for( uint i=0; i<tK; ++i )
+                {
+                    mQ += tY( i ) * mBasis( i );
+                }
+                this->precondition( mQ, mZ );
+                aX += mZ ;
+
+                // true residual for the restart
+                mR = aB ;
+                aMatrix.multiply( aX, mR, -1.0, 1.0 );
+
+                tBeta = norm( mR );
+                mResidual = tBeta / aNormB ;
+            }
+        }
+
+//------------------------------------------------------------------------------
+
+        void
+        Krylov::free()
+        {
+            if( this->is_initialized() )
+            {
+                mPointers.set_size( 0 );
+                mColumns.set_size( 0 );
+                mMap.set_size( 0 );
+                mDiagonal.set_size( 0 );
+                mFactor.set_size( 0 );
+                mR.set_size( 0 );
+                mZ.set_size( 0 );
+                mP.set_size( 0 );
+                mQ.set_size( 0 );
+                mS.set_size( 0 );
+                mT.set_size( 0 );
+                mWork.set_size( 0 );
+                mBasis.clear();
+
+                Wrapper::free();
+            }
+        }
+
+//------------------------------------------------------------------------------
+    }
+}
@@ -0,0 +1,239 @@
+//
+// Created by Christian Messe on 17.10.26.
+//
+
+#ifndef BELFEM_CL_SOLVERKRYLOV_HPP
+#define BELFEM_CL_SOLVERKRYLOV_HPP
+
+#include "cl_SolverWrapper.hpp"
+#include "cl_Cell.hpp"
+
+namespace belfem
+{
+    namespace solver
+    {
+//------------------------------------------------------------------------------
+
+        /**
+         * native preconditioned Krylov solver that runs on the master
+         * and does not need any external library.
+         *
+         * Supported methods       : CG, GMRES, BCGS ( BiCGStab )
+         * Supported preconditioners: NONE, JACOBI, ILU ( ILU(0) ), ICC ( IC(0) )
+         */
+        class Krylov : public Wrapper
+        {
+            // selected krylov method
+            KrylovMethod mKrylovMethod = KrylovMethod::AUTO ;
+
+            // selected preconditioner
+            Preconditioner mPreconditioner = Preconditioner::UNDEFINED ;
+
+            // convergence criterion for the relative residual
+            real mEpsilon = 1e-8 ;
+
+            // maximum number of iterations
+            uint mMaxIterations = 1000 ;
+
+            // restart length for GMRES
+            uint mRestart = 30 ;
+
+            // use the incoming LHS as initial guess
+            bool mWarmStart = true ;
+
+            // method and preconditioner that are actually used
+            KrylovMethod   mMethod  = KrylovMethod::UNDEFINED ;
+            Preconditioner mPrecond = Preconditioner::UNDEFINED ;
+
+            // number of rows of the system
+            index_t mNumRows = 0 ;
+
+            // zero based CSR copy of the pattern with sorted columns
+            Vector< int > mPointers ;
+            Vector< int > mColumns ;
+
+            // position of each CSR entry in the data container of the matrix
+            Vector< index_t > mMap ;
+
+            // position of the diagonal entry in each row
+            Vector< int > mDiagonal ;
+
+            // values of the preconditioner
+            Vector< real > mFactor ;
+
+            // work vectors
+            Vector< real > mR ;
+            Vector< real > mZ ;
+            Vector< real > mP ;
+            Vector< real > mQ ;
+            Vector< real > mS ;
+            Vector< real > mT ;
+            Vector< real > mWork ;
+
+            // search space for GMRES
+            Cell< Vector< real > > mBasis ;
+
+            // statistics of the last solve
+            uint mNumberOfIterations = 0 ;
+            real mResidual = 0.0 ;
+
+//------------------------------------------------------------------------------
+        public:
+//------------------------------------------------------------------------------
+
+            Krylov() ;
+
+//------------------------------------------------------------------------------
+
+            ~Krylov() ;
+
+//------------------------------------------------------------------------------
+
+            /**
+             * select method and preconditioner. AUTO and UNDEFINED
+             * pick CG with IC(0) for symmetric positive definite
+             * systems and GMRES with ILU(0) otherwise.
+             */
+            void
+            set(
+                    const Preconditioner aPreconditioner,
+                    const KrylovMethod   aKrylovMethod,
+                    const real           aEpsilon       = 1e-8,
+                    const uint           aMaxIterations = 1000,
+                    const bool           aWarmStart     = true );
+
+//------------------------------------------------------------------------------
+
+            void
+            solve(
+                    SpMatrix & aMatrix,
+                    Vector< real > & aLHS,
+                    Vector< real > & aRHS );
+
+//------------------------------------------------------------------------------
+
+            void
+            solve(
+                    SpMatrix & aMatrix,
+                    Matrix< real > & aLHS,
+                    Matrix< real > & aRHS );
+
+//------------------------------------------------------------------------------
+
+            void
+            free();
+
+//------------------------------------------------------------------------------
+
+            /**
+             * number of iterations of the last solve
+             */
+            uint
+            number_of_iterations() const ;
+
+//------------------------------------------------------------------------------
+
+            /**
+             * relative residual of the last solve
+             */
+            real
+            residual() const ;
+
+//------------------------------------------------------------------------------
+        protected :
+//------------------------------------------------------------------------------
+
+            void
+            initialize( SpMatrix & aMatrix,
+                        const SymmetryMode aSymmetryMode = SymmetryMode::Unsymmetric,
+                        const int aNumRhsColumns = 1 );
+
+//------------------------------------------------------------------------------
+        private:
+//------------------------------------------------------------------------------
+
+            /**
+             * create the CSR copy of the pattern and the map
+             * into the data container of the matrix
+             */
+            void
+            create_pattern( SpMatrix & aMatrix );
+
+//------------------------------------------------------------------------------
+
+            /**
+             * compute the preconditioner from the current matrix values
+             */
+            void
+            compute_preconditioner( const SpMatrix & aMatrix );
+
+//------------------------------------------------------------------------------
+
+            void
+            compute_jacobi( const real * aValues );
+
+//------------------------------------------------------------------------------
+
+            void
+            compute_ilu0( const real * aValues );
+
+//------------------------------------------------------------------------------
+
+            void
+            compute_ic0( const real * aValues );
+
+//------------------------------------------------------------------------------
+
+            /**
+             * z = M^-1 * r
+             */
+            void
+            precondition( const Vector< real > & aR, Vector< real > & aZ );
+
+//------------------------------------------------------------------------------
+
+            void
+            solve_cg( SpMatrix & aMatrix,
+                      Vector< real > & aX,
+                      const Vector< real > & aB,
+                      const real aNormB );
+
+//------------------------------------------------------------------------------
+
+            void
+            solve_bicgstab( SpMatrix & aMatrix,
+                            Vector< real > & aX,
+                            const Vector< real > & aB,
+                            const real aNormB );
+
+//------------------------------------------------------------------------------
+
+            void
+            solve_gmres( SpMatrix & aMatrix,
+                         Vector< real > & aX,
+                         const Vector< real > & aB,
+                         const real aNormB );
+
+//------------------------------------------------------------------------------
+        };
+
+//------------------------------------------------------------------------------
+
+        inline uint
+        Krylov::number_of_iterations() const
+        {
+            return mNumberOfIterations ;
+        }
+
+//------------------------------------------------------------------------------
+
+        inline real
+        Krylov::residual() const
+        {
+            return mResidual ;
+        }
+
+//------------------------------------------------------------------------------
+    }
+}
+#endif //BELFEM_CL_SOLVERKRYLOV_HPP
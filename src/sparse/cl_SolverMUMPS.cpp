@@ -115,10 +115,27 @@ namespace belfem
         void
         MUMPS::free()
         {
-            // call function from parent, nothing else to be done here
+#ifdef BELFEM_MUMPS
+            // destroy the kept instance
+            if( mHandle != 0 )
+            {
+                mumpstools_finalize( mHandle );
+                mHandle = 0 ;
+                mPatternHash = 0 ;
+            }
+#endif
+            // call function from parent
             Wrapper::free();
         }
 
+//------------------------------------------------------------------------------
+
+        bool
+        MUMPS::supports_factorization_reuse() const
+        {
+            return true ;
+        }
+
 //------------------------------------------------------------------------------
 
         void MUMPS::solve( SpMatrix & aMatrix,
@@ -139,6 +156,13 @@ namespace belfem
                 aLHS.set_size( aRHS.length(), 0.0 );
             }
 
+            // keep the analysis and the numeric factorization if requested
+            if( this->reuses_factorization() )
+            {
+                this->solve_with_reuse( aMatrix, aLHS, aRHS );
+                return;
+            }
+
             if( this->rank() == mMasterRank )
             {
                 // make sure that all indices have been created
@@ -181,18 +205,7 @@ namespace belfem
             }
 
             // check result
-            if( mInfo( 0 ) != 0 )
-            {
-                std::string tMessage = this->error_message(
-                        mInfo.data(),
-                        aMatrix.n_rows(),
-                        aMatrix.number_of_nonzeros() );
-
-                BELFEM_ERROR( false,
-                       "MUMPS has thrown the error: %i\n%s",
-                        mInfo( 0 ),
-                        tMessage.c_str() );
-            }
+            this->check_info( aMatrix );
 #else
             BELFEM_ERROR( false, "We are not linked against MUMPS" );
 #endif
@@ -292,6 +305,150 @@ namespace belfem
             }
 
             // check result
+            this->check_info( aMatrix );
+#else
+            BELFEM_ERROR( false, "We are not linked against MUMPS" );
+#endif
+
+        }
+
+//------------------------------------------------------------------------------
+
+        void
+        MUMPS::factorize( SpMatrix & aMatrix )
+        {
+#ifdef BELFEM_MUMPS
+            // reset info vector
+            mInfo.fill( 0 );
+
+            // the analysis is needed for a new instance or a new pattern
+            int tAnalyze = mHandle == 0 ? 1 : 0 ;
+
+            if( this->rank() == mMasterRank )
+            {
+                // make sure that all indices have been created
+                aMatrix.create_coo_indices() ;
+
+                // make sure that matrix is stored one-based
+                aMatrix.set_indexing_base( SpMatrixIndexingBase::Fortran );
+
+                luint tHash = aMatrix.pattern_hash() ;
+                if( tHash != mPatternHash )
+                {
+                    mPatternHash = tHash ;
+                    tAnalyze = 1 ;
+                }
+            }
+
+            broadcast( mMasterRank, tAnalyze );
+
+            const bool tIsMaster = this->rank() == mMasterRank ;
+            const int tN   = tIsMaster ? aMatrix.n_rows() : 0 ;
+            const int tNNZ = tIsMaster ? aMatrix.number_of_nonzeros() : 0 ;
+
+            if( tAnalyze == 1 )
+            {
+                mumpstools_analyze(
+                        mHandle,
+                        mIParameters.data(),
+                        mRParameters.data(),
+                        tN,
+                        tNNZ,
+                        tIsMaster ? aMatrix.rows() : NULL,
+                        tIsMaster ? aMatrix.cols() : NULL,
+                        tIsMaster ? aMatrix.data() : NULL,
+                        mInfo.data(),
+                        mRInfoG.data() );
+
+                BELFEM_ERROR( mHandle != 0,
+                              "Too many MUMPS instances are kept at the same time" );
+
+                this->check_info( aMatrix );
+            }
+
+            mumpstools_factorize(
+                    mHandle,
+                    tN,
+                    tNNZ,
+                    tIsMaster ? aMatrix.rows() : NULL,
+                    tIsMaster ? aMatrix.cols() : NULL,
+                    tIsMaster ? aMatrix.data() : NULL,
+                    mInfo.data(),
+                    mRInfoG.data() );
+
+            this->check_info( aMatrix );
+#else
+            BELFEM_ERROR( false, "We are not linked against MUMPS" );
+#endif
+        }
+
+//------------------------------------------------------------------------------
+
+        void
+        MUMPS::backsubstitute(
+                SpMatrix       & aMatrix,
+                Vector< real > & aLHS,
+                Vector< real > & aRHS )
+        {
+#ifdef BELFEM_MUMPS
+            BELFEM_ASSERT( mHandle != 0,
+                           "MUMPS has no numeric factorization" );
+
+            // reset info vector
+            mInfo.fill( 0 );
+
+            if( aLHS.length() != aRHS.length() )
+            {
+                aLHS.set_size( aRHS.length(), 0.0 );
+            }
+
+            const bool tIsMaster = this->rank() == mMasterRank ;
+            const int tN = tIsMaster ? aMatrix.n_rows() : 0 ;
+
+            mumpstools_backsubstitute(
+                    mHandle,
+                    tN,
+                    1,
+                    tIsMaster ? aLHS.data() : NULL,
+                    tIsMaster ? aRHS.data() : NULL,
+                    mInfo.data(),
+                    mRInfoG.data() );
+
+            this->check_info( aMatrix );
+#else
+            BELFEM_ERROR( false, "We are not linked against MUMPS" );
+#endif
+        }
+
+//------------------------------------------------------------------------------
+
+        bool
+        MUMPS::computes_residual() const
+        {
+#ifdef BELFEM_MUMPS
+            return this->rank() == mMasterRank ;
+#else
+            return true ;
+#endif
+        }
+
+//------------------------------------------------------------------------------
+
+        int
+        MUMPS::share_decision( const int aDecision )
+        {
+            int aShared = aDecision ;
+#ifdef BELFEM_MUMPS
+            broadcast( mMasterRank, aShared );
+#endif
+            return aShared ;
+        }
+
+//------------------------------------------------------------------------------
+
+        void
+        MUMPS::check_info( SpMatrix & aMatrix )
+        {
             if( mInfo( 0 ) != 0 )
             {
                 std::string tMessage = this->error_message(
@@ -304,10 +461,6 @@ namespace belfem
                         mInfo( 0 ),
                         tMessage.c_str() );
             }
-#else
-            BELFEM_ERROR( false, "We are not linked against MUMPS" );
-#endif
-
         }
 
 //------------------------------------------------------------------------------
@@ -16,6 +16,12 @@ namespace belfem
 #ifdef BELFEM_MUMPS
             // Rank of HOST
             const proc_t mMasterRank ;
+
+            // index of the kept MUMPS instance in reuse mode, 0 if none
+            int mHandle = 0 ;
+
+            // pattern of the last analysis in reuse mode
+            luint mPatternHash = 0 ;
 #endif
             // vector containing user parameters
             Vector< int >  mIParameters ;
@@ -56,6 +62,11 @@ namespace belfem
             void
             free();
 
+//------------------------------------------------------------------------------
+
+            bool
+            supports_factorization_reuse() const ;
+
 //------------------------------------------------------------------------------
 
             void
@@ -116,6 +127,31 @@ namespace belfem
                     const SymmetryMode aSymmetryMode = SymmetryMode::Unsymmetric,
                     const int aNumRhsColumns=1 );
 
+//------------------------------------------------------------------------------
+
+            /**
+             * numeric factorization ( JOB=2 ), the analysis ( JOB=1 )
+             * is only repeated if the pattern of the matrix has changed
+             */
+            void
+            factorize( SpMatrix & aMatrix );
+
+//------------------------------------------------------------------------------
+
+            void
+            backsubstitute( SpMatrix & aMatrix,
+                            Vector< real > & aLHS,
+                            Vector< real > & aRHS );
+
+//------------------------------------------------------------------------------
+
+            bool
+            computes_residual() const ;
+
+//------------------------------------------------------------------------------
+
+            int
+            share_decision( const int aDecision ) ;
 
 //------------------------------------------------------------------------------
 
@@ -132,6 +168,14 @@ namespace belfem
             void
             init_defaults();
 
+//------------------------------------------------------------------------------
+
+            /**
+             * throws an error if MUMPS reported one
+             */
+            void
+            check_info( SpMatrix & aMatrix );
+
 //------------------------------------------------------------------------------
         };
     }
@@ -47,28 +47,20 @@ namespace belfem
                 aLHS.set_size( aRHS.length(), 0.0 );
             }
 
+            // keep the numeric factorization if requested
+            if( this->reuses_factorization() )
+            {
+                this->solve_with_reuse( aMatrix, aLHS, aRHS );
+                return;
+            }
+
             aMatrix.set_indexing_base( mIndexingBase );
 
-            int tStatus = pardisotools_symbolic_factorization(
-                aMatrix.n_rows(),
-                aMatrix.number_of_nonzeros(),
-                1,
-                aMatrix.pointers(),
-                aMatrix.indices(),
-                aMatrix.data() );
+            int tStatus = this->symbolic_factorization( aMatrix, 1 );
 
             this->check_status( tStatus );
 
-            tStatus = pardisotools_solve(
-                    aMatrix.n_rows(),
-                    aMatrix.number_of_nonzeros(),
-                    1,
-                    aMatrix.pointers(),
-                    aMatrix.indices(),
-                    aMatrix.data(),
-                    aLHS.data(),
-                    aRHS.data(),
-                    mInfo.data() );
+            tStatus = this->factorize_and_solve( aMatrix, 1, aLHS.data(), aRHS.data() );
 
             // check for error
             this->check_status( tStatus );
@@ -101,16 +93,7 @@ namespace belfem
 
 #ifdef BELFEM_ARMADILLO
 
-        int tStatus = pardisotools_solve(
-                    aMatrix.n_rows(),
-                    aMatrix.number_of_nonzeros(),
-                    aRHS.n_cols(),
-                    aMatrix.pointers(),
-                    aMatrix.indices(),
-                    aMatrix.data(),
-                    aLHS.data(),
-                    aRHS.data(),
-                    mInfo.data() );
+        int tStatus = this->factorize_and_solve( aMatrix, aRHS.n_cols(), aLHS.data(), aRHS.data() );
 #else
            // flatten matrix to vector
            Vector< real > tX;
@@ -121,22 +104,210 @@ namespace belfem
            tX.set_size( tY.length() );
 
            // call pardiso
-           int tStatus = pardisotools_solve(
+           int tStatus = this->factorize_and_solve( aMatrix, aRHS.n_cols(), tX.data(), tY.data() );
+
+           // unflatten vector to matrix
+           this->vec2mat( tX, aLHS );
+#endif
+           // check for error
+           this->check_status( tStatus );
+#else
+            BELFEM_ERROR( false, "We are not linked against PARDISO" );
+#endif
+        }
+
+//------------------------------------------------------------------------------
+
+        bool
+        PARDISO::supports_factorization_reuse() const
+        {
+            return true ;
+        }
+
+//------------------------------------------------------------------------------
+
+        bool
+        PARDISO::supports_long_indices() const
+        {
+            return true ;
+        }
+
+//------------------------------------------------------------------------------
+
+        int
+        PARDISO::symbolic_factorization( SpMatrix & aMatrix, const int aNumRhsColumns )
+        {
+#ifdef BELFEM_PARDISO
+            if( aMatrix.index_type() == SpMatrixIndexType::Int64 )
+            {
+                return pardisotools_symbolic_factorization_64(
+                        aMatrix.n_rows(),
+                        ( long int ) aMatrix.number_of_nonzeros(),
+                        aNumRhsColumns,
+                        aMatrix.long_pointers(),
+                        aMatrix.long_indices(),
+                        aMatrix.data() );
+            }
+            else
+            {
+                return pardisotools_symbolic_factorization(
+                        aMatrix.n_rows(),
+                        aMatrix.number_of_nonzeros(),
+                        aNumRhsColumns,
+                        aMatrix.pointers(),
+                        aMatrix.indices(),
+                        aMatrix.data() );
+            }
+#else
+            return 0 ;
+#endif
+        }
+
+//------------------------------------------------------------------------------
+
+        int
+        PARDISO::numeric_factorization( SpMatrix & aMatrix )
+        {
+#ifdef BELFEM_PARDISO
+            if( aMatrix.index_type() == SpMatrixIndexType::Int64 )
+            {
+                return pardisotools_numeric_factorization_64(
+                        aMatrix.n_rows(),
+                        ( long int ) aMatrix.number_of_nonzeros(),
+                        1,
+                        aMatrix.long_pointers(),
+                        aMatrix.long_indices(),
+                        aMatrix.data() );
+            }
+            else
+            {
+                return pardisotools_numeric_factorization(
+                        aMatrix.n_rows(),
+                        aMatrix.number_of_nonzeros(),
+                        1,
+                        aMatrix.pointers(),
+                        aMatrix.indices(),
+                        aMatrix.data() );
+            }
+#else
+            return 0 ;
+#endif
+        }
+
+//------------------------------------------------------------------------------
+
+        int
+        PARDISO::backsubstitution(
+                SpMatrix   & aMatrix,
+                const int    aNumRhsColumns,
+                real       * aLHS,
+                const real * aRHS )
+        {
+#ifdef BELFEM_PARDISO
+            if( aMatrix.index_type() == SpMatrixIndexType::Int64 )
+            {
+                return pardisotools_backsubstitution_64(
+                        aMatrix.n_rows(),
+                        ( long int ) aMatrix.number_of_nonzeros(),
+                        aNumRhsColumns,
+                        aMatrix.long_pointers(),
+                        aMatrix.long_indices(),
+                        aMatrix.data(),
+                        aLHS,
+                        aRHS );
+            }
+            else
+            {
+                return pardisotools_backsubstitution(
+                        aMatrix.n_rows(),
+                        aMatrix.number_of_nonzeros(),
+                        aNumRhsColumns,
+                        aMatrix.pointers(),
+                        aMatrix.indices(),
+                        aMatrix.data(),
+                        aLHS,
+                        aRHS );
+            }
+#else
+            return 0 ;
+#endif
+        }
+
+//------------------------------------------------------------------------------
+
+        int
+        PARDISO::factorize_and_solve(
+                SpMatrix   & aMatrix,
+                const int    aNumRhsColumns,
+                real       * aLHS,
+                const real * aRHS )
+        {
+#ifdef BELFEM_PARDISO
+            if( aMatrix.index_type() == SpMatrixIndexType::Int64 )
+            {
+                // the 64-bit interface has no combined call
+                int tStatus = this->numeric_factorization( aMatrix );
+
+                if( tStatus == 0 )
+                {
+                    tStatus = this->backsubstitution( aMatrix, aNumRhsColumns, aLHS, aRHS );
+                }
+
+                return tStatus ;
+            }
+            else
+            {
+                return pardisotools_solve(
                         aMatrix.n_rows(),
                         aMatrix.number_of_nonzeros(),
-                        aRHS.n_cols(),
+                        aNumRhsColumns,
                         aMatrix.pointers(),
                         aMatrix.indices(),
                         aMatrix.data(),
-                        tX.data(),
-                        tY.data(),
+                        aLHS,
+                        aRHS,
                         mInfo.data() );
+            }
+#else
+            return 0 ;
+#endif
+        }
 
-           // unflatten vector to matrix
-           this->vec2mat( tX, aLHS );
+//------------------------------------------------------------------------------
+
+        void
+        PARDISO::factorize( SpMatrix & aMatrix )
+        {
+#ifdef BELFEM_PARDISO
+            aMatrix.set_indexing_base( mIndexingBase );
+
+            int tStatus = this->numeric_factorization( aMatrix );
+
+            this->check_status( tStatus );
+#else
+            BELFEM_ERROR( false, "We are not linked against PARDISO" );
 #endif
-           // check for error
-           this->check_status( tStatus );
+        }
+
+//------------------------------------------------------------------------------
+
+        void
+        PARDISO::backsubstitute(
+                SpMatrix & aMatrix,
+                Vector< real > & aLHS,
+                Vector< real > & aRHS )
+        {
+#ifdef BELFEM_PARDISO
+            if( aLHS.length() != aRHS.length() )
+            {
+                aLHS.set_size( aRHS.length(), 0.0 );
+            }
+
+            aMatrix.set_indexing_base( mIndexingBase );
+
+            int tStatus = this->backsubstitution( aMatrix, 1, aLHS.data(), aRHS.data() );
+
+            this->check_status( tStatus );
 #else
             BELFEM_ERROR( false, "We are not linked against PARDISO" );
 #endif
@@ -267,13 +438,7 @@ namespace belfem
             // perform the symbolic factorization
             aMatrix.set_indexing_base( mIndexingBase );
 
-            tStatus = pardisotools_symbolic_factorization(
-                aMatrix.n_rows(),
-                aMatrix.number_of_nonzeros(),
-                aNumRhsColumns,
-                aMatrix.pointers(),
-                aMatrix.indices(),
-                aMatrix.data() );
+            tStatus = this->symbolic_factorization( aMatrix, aNumRhsColumns );
 
             if( tStatus != 0 )
             {
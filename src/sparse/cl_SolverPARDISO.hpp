@@ -91,6 +91,16 @@ namespace belfem
             void
             free();
 
+//------------------------------------------------------------------------------
+
+            bool
+            supports_factorization_reuse() const ;
+
+//------------------------------------------------------------------------------
+
+            bool
+            supports_long_indices() const ;
+
 //------------------------------------------------------------------------------
         protected :
 //------------------------------------------------------------------------------
@@ -100,6 +110,18 @@ namespace belfem
                         const SymmetryMode aSymmetryMode = SymmetryMode::Unsymmetric,
                         const int aNumRhsColumns = 1);
 
+//------------------------------------------------------------------------------
+
+            void
+            factorize( SpMatrix & aMatrix );
+
+//------------------------------------------------------------------------------
+
+            void
+            backsubstitute( SpMatrix & aMatrix,
+                            Vector< real > & aLHS,
+                            Vector< real > & aRHS );
+
 //------------------------------------------------------------------------------
 
             string
@@ -110,6 +132,42 @@ namespace belfem
             void
             check_status( const int aStatus ) ;
 
+//------------------------------------------------------------------------------
+        private:
+//------------------------------------------------------------------------------
+
+            /**
+             * the following functions call the 32-bit or the 64-bit
+             * interface of pardisotools, depending on the matrix
+             */
+            int
+            symbolic_factorization( SpMatrix & aMatrix,
+                                    const int  aNumRhsColumns );
+
+//------------------------------------------------------------------------------
+
+            int
+            numeric_factorization( SpMatrix & aMatrix );
+
+//------------------------------------------------------------------------------
+
+            int
+            backsubstitution( SpMatrix   & aMatrix,
+                              const int    aNumRhsColumns,
+                              real       * aLHS,
+                              const real * aRHS );
+
+//------------------------------------------------------------------------------
+
+            /**
+             * numeric factorization followed by backsubstitution
+             */
+            int
+            factorize_and_solve( SpMatrix   & aMatrix,
+                                 const int    aNumRhsColumns,
+                                 real       * aLHS,
+                                 const real * aRHS );
+
 //------------------------------------------------------------------------------
         };
     }
@@ -201,7 +201,7 @@ namespace belfem
             if( this->comm_size() > 1 ) // parallel mode
             {
                 // create the distributor
-                mDistributor = new PetscDistributor( mData, aMatrix );
+                mDistributor = new PetscDistributor( mData, aMatrix, this->row_block() );
             }
             else // sequential mode
             {
@@ -256,6 +256,14 @@ namespace belfem
 
         }
 
+//------------------------------------------------------------------------------
+
+        bool
+        PETSC::supports_distributed_assembly() const
+        {
+            return true ;
+        }
+
 //------------------------------------------------------------------------------
 
         void
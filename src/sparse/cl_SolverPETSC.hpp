@@ -66,6 +66,11 @@ namespace belfem
             void
             free();
 
+//------------------------------------------------------------------------------
+
+            bool
+            supports_distributed_assembly() const ;
+
 //------------------------------------------------------------------------------
         protected :
 //------------------------------------------------------------------------------
@@ -12,28 +12,40 @@ namespace belfem
     {
 //------------------------------------------------------------------------------
 
-        PetscDistributor::PetscDistributor( PetscData & aData, SpMatrix & aMatrix ) :
+        PetscDistributor::PetscDistributor(
+                PetscData & aData,
+                SpMatrix & aMatrix,
+                SpMatrixRowBlock * aRowBlock ) :
                 mMyRank( comm_rank() ),
                 mCommSize( comm_size() ),
 #ifdef BELFEM_PETSC
                 mData( aData ),
-                mMatrix( aMatrix )
+                mMatrix( aMatrix ),
 #else
-                mData( aData )
+                mData( aData ),
 #endif
+                mRowBlock( aRowBlock )
         {
 #ifdef BELFEM_PETSC
             // split the indices of the matrix among the other procs
             this->create_communication_list() ;
 
-            // make sure that matrix is cpp based and has both indices
-            // also enforces cpp indexing (zero-based)
-            mMatrix.create_coo_indices();
+            if( mRowBlock == nullptr )
+            {
+                // make sure that matrix is cpp based and has both indices
+                // also enforces cpp indexing (zero-based)
+                mMatrix.create_coo_indices();
 
-            this->split_ownership();
+                this->split_ownership();
 
-            // compute how the memory is distributed
-            this->compute_memory() ;
+                // compute how the memory is distributed
+                this->compute_memory();
+            }
+            else
+            {
+                // each proc already knows its rows
+                this->link_row_block() ;
+            }
 
             // create the matrix on the data stricture
             this->initialize_matrix() ;
@@ -272,6 +284,48 @@ namespace belfem
 #endif
         }
 
+//------------------------------------------------------------------------------
+
+        void
+        PetscDistributor::link_row_block()
+        {
+#ifdef BELFEM_PETSC
+            mData.mNumRows     = mRowBlock->mNumberOfRows ;
+            mData.mNumCols     = mRowBlock->mNumberOfRows ;
+            mData.mMyNumRows   = mRowBlock->mMyNumberOfRows ;
+            mData.mMyNumCols   = PETSC_DECIDE ;
+            mData.mMyRowOffset = mRowBlock->mRowOffset ;
+            mData.mMyNumNnz    = mRowBlock->mColumns.length() ;
+
+            // copy the indices, PetscInt might be a long integer
+            mData.mMyPointers.set_size( mRowBlock->mPointers.length() );
+            for( index_t k=0; k<mRowBlock->mPointers.length(); ++k )
+            {
+                mData.mMyPointers( k ) = mRowBlock->mPointers( k );
+            }
+
+            mData.mMyColumns.set_size( mRowBlock->mColumns.length() );
+            for( index_t k=0; k<mRowBlock->mColumns.length(); ++k )
+            {
+                mData.mMyColumns( k ) = mRowBlock->mColumns( k );
+            }
+
+            // the master needs the number of rows per proc
+            // to distribute and collect the vectors
+            if( mMyRank == 0 )
+            {
+                mNumRowsPerProc.set_size( mCommSize );
+                for( PetscInt p=0; p<mCommSize; ++p )
+                {
+                    mNumRowsPerProc( p ) = mRowBlock->mDistribution( p+1 )
+                            - mRowBlock->mDistribution( p );
+                }
+            }
+
+            mMatrixData = mRowBlock->mValues.data() ;
+#endif
+        }
+
 //------------------------------------------------------------------------------
 
         PetscErrorCode
@@ -358,29 +412,37 @@ namespace belfem
         {
 #ifdef BELFEM_PETSC
 
-            // enforce zero based indexing for the sparse matrix
-            mMatrix.set_indexing_base( SpMatrixIndexingBase::Cpp );
-
-            if( mMyRank == 0 )
+            if( mRowBlock != nullptr )
             {
-                // offset in array
-                PetscInt tOffset = mNumNnzPerProc( 0 ) ;
+                // the values were assembled on this proc
+                mMatrixData = mRowBlock->mValues.data() ;
+            }
+            else
+            {
+                // enforce zero based indexing for the sparse matrix
+                mMatrix.set_indexing_base( SpMatrixIndexingBase::Cpp );
 
-                // get raw pointer of vector
-                real * tData = mMatrix.data() ;
+                if( mMyRank == 0 )
+                {
+                    // offset in array
+                    PetscInt tOffset = mNumNnzPerProc( 0 ) ;
 
-                // loop over all procs
-                for( proc_t p = 1; p < mCommSize; ++p )
+                    // get raw pointer of vector
+                    real * tData = mMatrix.data() ;
+
+                    // loop over all procs
+                    for( proc_t p = 1; p < mCommSize; ++p )
+                    {
+                        index_t tNumSamples =  mNumNnzPerProc( p ) ;
+                        send( p, tNumSamples, &tData[ tOffset ] );
+                        tOffset +=tNumSamples ;
+                    }
+                }
+                else
                 {
-                    index_t tNumSamples =  mNumNnzPerProc( p ) ;
-                    send( p, tNumSamples, &tData[ tOffset ] );
-                    tOffset +=tNumSamples ;
+                    receive( 0, mSwap );
                 }
             }
-            else
-            {
-                receive( 0, mSwap );
-            }
 
             // loop over all rows
             PetscErrorCode aStatus ;
@@ -11,6 +11,7 @@
 #include "petsctools.hpp"
 #include "cl_Vector.hpp"
 #include "cl_SpMatrix.hpp"
+#include "st_SpMatrixRowBlock.hpp"
 #include "st_SolverPetscData.hpp"
 
 namespace belfem
@@ -38,6 +39,10 @@ namespace belfem
             // the sparse matrix we want to solve
             SpMatrix  & mMatrix ;
 #endif
+            // rows of the matrix that were assembled on this proc,
+            // nullptr if the values are sent by the master
+            SpMatrixRowBlock * mRowBlock ;
+
             // data container for vector
             Vector< PetscReal > mRHS ; //?
             Vector< PetscReal > mLHS ; //?
@@ -66,7 +71,15 @@ namespace belfem
         public:
 //------------------------------------------------------------------------------
 
-            PetscDistributor( PetscData & aData, SpMatrix & aMatrix ) ;
+            /**
+             * @param aData      the data object of the PETSc wrapper
+             * @param aMatrix    the matrix on the master
+             * @param aRowBlock  if set, each proc provides its own rows
+             *                   and the master does not distribute the values
+             */
+            PetscDistributor( PetscData & aData,
+                              SpMatrix & aMatrix,
+                              SpMatrixRowBlock * aRowBlock = nullptr ) ;
 
 //------------------------------------------------------------------------------
 
@@ -108,6 +121,15 @@ namespace belfem
             void
             compute_memory();
 
+//------------------------------------------------------------------------------
+
+            /**
+             * take the ownership and the indices from the row block
+             * instead of splitting the matrix of the master
+             */
+            void
+            link_row_block();
+
 //------------------------------------------------------------------------------
 
             /**
@@ -123,7 +145,8 @@ namespace belfem
 
             /**
              * distribute the data of the matrix from the master proc
-             * and copy the values into the Mat container
+             * and copy the values into the Mat container. In row block
+             * mode, each proc copies its own rows.
              */
             PetscErrorCode
             update_matrix() ;
@@ -94,6 +94,25 @@ namespace belfem
                         aMatrix.data(),
                         false );
             }
+            else if ( this->row_block() != nullptr )
+            {
+                // each proc has assembled its own rows
+                mDistributor = new StrumpackDistributor( *this->row_block() );
+
+                // create a parallel solver
+                mDistSolver = new strumpack::StrumpackSparseSolverMPIDist<real, int>( gComm.world(),
+                                                                                      mArgC,
+                                                                                      mArgV->data(),
+                                                                                      gLog.info_level() >= 5 );
+
+                // link the local rows to the solver
+                mDistSolver->set_distributed_csr_matrix(
+                        mDistributor->n_rows(),
+                        mDistributor->pointers(),
+                        mDistributor->indices(),
+                        mDistributor->values(),
+                        mDistributor->dist() );
+            }
             else if ( gComm.rank() == 0 )
             {
                 // build the distribution object
@@ -140,6 +159,14 @@ namespace belfem
 #endif
         }
 
+//------------------------------------------------------------------------------
+
+        bool
+        STRUMPACK::supports_distributed_assembly() const
+        {
+            return true ;
+        }
+
 //------------------------------------------------------------------------------
 
         void
@@ -191,6 +218,16 @@ namespace belfem
                 {
                     this->initialize( aMatrix );
                 }
+                else if( this->row_block() != nullptr )
+                {
+                    // the values were assembled on this proc
+                    mDistSolver->update_matrix_values(
+                            mDistributor->n_rows(),
+                            mDistributor->pointers(),
+                            mDistributor->indices(),
+                            mDistributor->values(),
+                            mDistributor->dist() );
+                }
                 else if( gComm.rank() == 0 )
                 {
                     // update the matrix values
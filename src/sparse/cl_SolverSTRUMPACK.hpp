@@ -61,6 +61,11 @@ namespace belfem
                     Vector< real > & aLHS,
                     Vector< real > & aRHS );
 
+//------------------------------------------------------------------------------
+
+            bool
+            supports_distributed_assembly() const ;
+
 //------------------------------------------------------------------------------
 
             /*void
@@ -36,6 +36,23 @@ namespace belfem
             mMyLhs.set_size( mMyNumRows, 0.0 );
         }
 
+//------------------------------------------------------------------------------
+
+        StrumpackDistributor::StrumpackDistributor( const SpMatrixRowBlock & aRowBlock ) :
+                mMyRank( comm_rank() ),
+                mCommSize( comm_size() ),
+                mRowBlock( & aRowBlock )
+        {
+            mMyNumRows  = aRowBlock.mMyNumberOfRows ;
+            mMyNNZ      = aRowBlock.mColumns.length() ;
+            mDist       = aRowBlock.mDistribution ;
+            mMyPointers = aRowBlock.mPointers ;
+            mMyIndices  = aRowBlock.mColumns ;
+
+            mMyRhs.set_size( mMyNumRows, 0.0 );
+            mMyLhs.set_size( mMyNumRows, 0.0 );
+        }
+
 //------------------------------------------------------------------------------
 
         void
@@ -156,11 +173,9 @@ namespace belfem
         {
             if ( mMyRank == 0 )
             {
-                int tOff = mMyNumRows ;
                 for( proc_t p=1; p<mCommSize; ++p )
                 {
-                    send( p, mNumRowsOther, aRHS.data() + tOff );
-                    tOff += mNumRowsOther ;
+                    send( p, mDist( p+1 ) - mDist( p ), aRHS.data() + mDist( p ) );
                 }
             }
             else
@@ -176,11 +191,9 @@ namespace belfem
         {
             if ( mMyRank == 0 )
             {
-                int tOff = mMyNumRows ;
                 for( proc_t p=1; p<mCommSize; ++p )
                 {
-                    receive( p, aLHS.data() + tOff );
-                    tOff += mNumRowsOther ;
+                    receive( p, aLHS.data() + mDist( p ) );
                 }
             }
             else
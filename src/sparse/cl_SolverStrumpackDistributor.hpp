@@ -8,6 +8,7 @@
 #include "typedefs.hpp"
 #include "cl_SpMatrix.hpp"
 #include "cl_Vector.hpp"
+#include "st_SpMatrixRowBlock.hpp"
 
 namespace belfem
 {
@@ -44,6 +45,9 @@ namespace belfem
             Vector< real > mMyRhs ;
             Vector< real > mMyLhs ;
 
+            // rows that were assembled on this proc, if distributed assembly is used
+            const SpMatrixRowBlock * mRowBlock = nullptr ;
+
 //------------------------------------------------------------------------------
         public:
 //------------------------------------------------------------------------------
@@ -54,6 +58,15 @@ namespace belfem
 
             StrumpackDistributor();
 
+//------------------------------------------------------------------------------
+
+            /**
+             * constructor for distributed assembly, called by all procs.
+             * The pattern is taken from the row block and no values
+             * are sent by the master.
+             */
+            StrumpackDistributor( const SpMatrixRowBlock & aRowBlock );
+
 //------------------------------------------------------------------------------
 
             ~StrumpackDistributor() = default ;
@@ -182,7 +195,7 @@ namespace belfem
         inline const real *
         StrumpackDistributor::values() const
         {
-            return mMyValues.data() ;
+            return mRowBlock == nullptr ? mMyValues.data() : mRowBlock->mValues.data() ;
         }
 
 //------------------------------------------------------------------------------
@@ -6,7 +6,12 @@
 #ifdef BELFEM_SUITESPARSE
 #include <umfpack.h>
 #endif
+#include <cstdio>
+#include <fstream>
+
 #include "cl_SolverUMFPACK.hpp"
+#include "filetools.hpp"
+#include "cl_Logger.hpp"
 namespace belfem
 {
     namespace solver
@@ -74,16 +79,59 @@ namespace belfem
             // create a null pointer
             double *null = ( double * ) nullptr;
 
+            // remember which interface is used for the factorizations
+            mLongIndices = aMatrix.index_type() == SpMatrixIndexType::Int64 ;
+
+            // an ordering of another pattern is useless or even harmful
+            if( this->loads_ordering() && file_exists( this->ordering_file() )
+                && ! this->ordering_matches( aMatrix ) )
+            {
+                message( 4, " Warning: UMFPACK ordering %s does not fit the matrix, dropping it\n",
+                         this->ordering_file().c_str() );
+
+                std::remove( this->ordering_file().c_str() );
+                std::remove( this->ordering_key_file().c_str() );
+            }
+
+            // read the ordering of an earlier run
+            if( this->loads_ordering() && file_exists( this->ordering_file() ) )
+            {
+                // older versions of UMFPACK expect a non const path
+                string tPath = this->ordering_file() ;
+
+                int tStatus = mLongIndices ?
+                        ( int ) umfpack_dl_load_symbolic( &mSymbolic, &tPath[ 0 ] ) :
+                        umfpack_di_load_symbolic( &mSymbolic, &tPath[ 0 ] );
+
+                if( tStatus == 0 )
+                {
+                    return ;
+                }
+
+                // fall back to a new symbolic factorization
+                mSymbolic = nullptr ;
+            }
+
             // create symbolic factorization
-            int tStatus = umfpack_di_symbolic (
-                    aMatrix.n_rows(),
-                    aMatrix.n_cols(),
-                    aMatrix.pointers(),
-                    aMatrix.indices(),
-                    null,
-                    &mSymbolic,
-                    null,
-                    null );
+            int tStatus = mLongIndices ?
+                    ( int ) umfpack_dl_symbolic (
+                        aMatrix.n_rows(),
+                        aMatrix.n_cols(),
+                        ( const SuiteSparse_long * ) aMatrix.long_pointers(),
+                        ( const SuiteSparse_long * ) aMatrix.long_indices(),
+                        null,
+                        &mSymbolic,
+                        null,
+                        null ) :
+                    umfpack_di_symbolic (
+                        aMatrix.n_rows(),
+                        aMatrix.n_cols(),
+                        aMatrix.pointers(),
+                        aMatrix.indices(),
+                        null,
+                        &mSymbolic,
+                        null,
+                        null );
 
             // check for error
             if( tStatus != 0 )
@@ -93,11 +141,31 @@ namespace belfem
 
                 // throw error
                 BELFEM_ERROR( false,
-                    "UMFPACK has thrown the error: %i at umfpack_di_symbolic():\n%s",
+                    "UMFPACK has thrown the error: %i at umfpack_symbolic():\n%s",
                     tStatus,
                     tMessage.c_str() );
             }
 
+            // keep the ordering for the next run
+            if( ! this->ordering_file().empty() )
+            {
+                string tPath = this->ordering_file() ;
+
+                tStatus = mLongIndices ?
+                        ( int ) umfpack_dl_save_symbolic( mSymbolic, &tPath[ 0 ] ) :
+                        umfpack_di_save_symbolic( mSymbolic, &tPath[ 0 ] );
+
+                if( tStatus != 0 )
+                {
+                    message( 4, " Warning: could not write UMFPACK ordering to %s\n",
+                             tPath.c_str() );
+                }
+                else
+                {
+                    this->save_ordering_key( aMatrix );
+                }
+            }
+
 #endif
         }
 
@@ -107,9 +175,21 @@ namespace belfem
         UMFPACK::free()
         {
 #ifdef BELFEM_SUITESPARSE
+            if( mNumeric != nullptr )
+            {
+                this->free_numeric( &mNumeric );
+                mNumeric = nullptr ;
+            }
             if( this->is_initialized() )
             {
-                umfpack_di_free_symbolic ( &mSymbolic );
+                if( mLongIndices )
+                {
+                    umfpack_dl_free_symbolic ( &mSymbolic );
+                }
+                else
+                {
+                    umfpack_di_free_symbolic ( &mSymbolic );
+                }
                 mSymbolic = nullptr ;
             }
 #endif
@@ -136,52 +216,27 @@ namespace belfem
                 aLHS.set_size( aRHS.length() );
             }
 
+            // keep the numeric factorization if requested
+            if( this->reuses_factorization() )
+            {
+                this->solve_with_reuse( aMatrix, aLHS, aRHS );
+                return;
+            }
+
             // make sure that matrix is stored zero-based
             aMatrix.set_indexing_base( SpMatrixIndexingBase::Cpp );
 
-            // create a null pointer
-            double *null = ( double * ) nullptr;
-
             // numeric factorization
             void * tNumeric  = nullptr ;
 
             // From the symbolic factorization information, carry out the numeric factorization.
-            int tStatus = umfpack_di_numeric (
-                    aMatrix.pointers(),
-                    aMatrix.indices(),
-                    aMatrix.data(),
-                    mSymbolic,
-                    &tNumeric,
-                    null,
-                    null );
-
-            // check for error
-            if( tStatus != 0 )
-            {
-                // create error message
-                string tMessage = this->error_message( tStatus );
-
-                // throw error
-                BELFEM_ERROR( false,
-                             "UMFPACK has thrown the error: %i at  umfpack_di_numeric():\n%s",
-                             tStatus,
-                             tMessage.c_str() );
-            }
+            this->compute_numeric( aMatrix, &tNumeric );
 
             // Using the numeric factorization, solve the linear system.
-            tStatus = umfpack_di_solve (
-                    mTransposedFlag,
-                    aMatrix.pointers(),
-                    aMatrix.indices(),
-                    aMatrix.data(),
-                    aLHS.data(),
-                    aRHS.data(),
-                    tNumeric,
-                    null,
-                    null );
+            int tStatus = this->solve_numeric( aMatrix, aLHS.data(), aRHS.data(), tNumeric );
 
             // Free the numeric factorization.
-            umfpack_di_free_numeric ( &tNumeric );
+            this->free_numeric( &tNumeric );
 
             // check for error
             if( tStatus != 0 )
@@ -191,7 +246,7 @@ namespace belfem
 
                 // throw error
                 BELFEM_ERROR( tStatus == 0,
-                             "UMFPACK has thrown the error: %i at  umfpack_di_solve():\n%s",
+                             "UMFPACK has thrown the error: %i at  umfpack_solve():\n%s",
                              tStatus,
                              tMessage.c_str() );
             }
@@ -223,34 +278,11 @@ namespace belfem
             // make sure that matrix is stored zero-based
             aMatrix.set_indexing_base( SpMatrixIndexingBase::Cpp );
 
-            // create a null pointer
-            double *null = ( double * ) nullptr;
-
             // numeric factorization
             void * tNumeric  = nullptr ;
 
             // From the symbolic factorization information, carry out the numeric factorization.
-            int tStatus = umfpack_di_numeric (
-                    aMatrix.pointers(),
-                    aMatrix.indices(),
-                    aMatrix.data(),
-                    mSymbolic,
-                    &tNumeric,
-                    null,
-                    null );
-
-            // check for error
-            if( tStatus != 0 )
-            {
-                // create error message
-                string tMessage = this->error_message( tStatus );
-
-                // throw error
-                BELFEM_ERROR( false,
-                             "UMFPACK has thrown the error: %i at  umfpack_di_numeric():\n%s",
-                             tStatus,
-                             tMessage.c_str() );
-            }
+            this->compute_numeric( aMatrix, &tNumeric );
 
             // temporary vector for LHS
             Vector< real > tX( aRHS.n_rows() );
@@ -268,16 +300,7 @@ namespace belfem
                 tY = aRHS.col( k );
 
                 // Using the numeric factorization, solve the linear system.
-                tStatus = umfpack_di_solve(
-                        mTransposedFlag,
-                        aMatrix.pointers(),
-                        aMatrix.indices(),
-                        aMatrix.data(),
-                        tX.data(),
-                        tY.data(),
-                        tNumeric,
-                        null,
-                        null );
+                int tStatus = this->solve_numeric( aMatrix, tX.data(), tY.data(), tNumeric );
 
                 // check for error
                 if ( tStatus != 0 )
@@ -285,7 +308,7 @@ namespace belfem
                     std::string tMessage = this->error_message( tStatus );
 
                     BELFEM_ERROR( false,
-                                 "UMFPACK has thrown the error: %i at umfpack_di_solve(): %i\n%s",
+                                 "UMFPACK has thrown the error: %i at umfpack_solve(): %i\n%s",
                                  tStatus,
                                  tMessage.c_str() );
                 }
@@ -295,7 +318,238 @@ namespace belfem
             }
 
             // Free the numeric factorization.
-            umfpack_di_free_numeric ( &tNumeric );
+            this->free_numeric( &tNumeric );
+#else
+            BELFEM_ERROR( false, "We are not linked against UMFPACK." );
+#endif
+        }
+
+//------------------------------------------------------------------------------
+
+        bool
+        UMFPACK::supports_factorization_reuse() const
+        {
+            return true ;
+        }
+
+//------------------------------------------------------------------------------
+
+        bool
+        UMFPACK::supports_long_indices() const
+        {
+            return true ;
+        }
+
+//------------------------------------------------------------------------------
+
+        void
+        UMFPACK::compute_numeric( SpMatrix & aMatrix, void ** aNumeric )
+        {
+#ifdef BELFEM_SUITESPARSE
+            // create a null pointer
+            double *null = ( double * ) nullptr;
+
+            int tStatus = mLongIndices ?
+                    ( int ) umfpack_dl_numeric (
+                        ( const SuiteSparse_long * ) aMatrix.long_pointers(),
+                        ( const SuiteSparse_long * ) aMatrix.long_indices(),
+                        aMatrix.data(),
+                        mSymbolic,
+                        aNumeric,
+                        null,
+                        null ) :
+                    umfpack_di_numeric (
+                        aMatrix.pointers(),
+                        aMatrix.indices(),
+                        aMatrix.data(),
+                        mSymbolic,
+                        aNumeric,
+                        null,
+                        null );
+
+            // check for error
+            if( tStatus != 0 )
+            {
+                // create error message
+                string tMessage = this->error_message( tStatus );
+
+                // throw error
+                BELFEM_ERROR( false,
+                             "UMFPACK has thrown the error: %i at  umfpack_numeric():\n%s",
+                             tStatus,
+                             tMessage.c_str() );
+            }
+#endif
+        }
+
+//------------------------------------------------------------------------------
+
+        int
+        UMFPACK::solve_numeric(
+                SpMatrix & aMatrix,
+                real     * aX,
+                real     * aB,
+                void     * aNumeric )
+        {
+#ifdef BELFEM_SUITESPARSE
+            // create a null pointer
+            double *null = ( double * ) nullptr;
+
+            if( mLongIndices )
+            {
+                return ( int ) umfpack_dl_solve (
+                        mTransposedFlag,
+                        ( const SuiteSparse_long * ) aMatrix.long_pointers(),
+                        ( const SuiteSparse_long * ) aMatrix.long_indices(),
+                        aMatrix.data(),
+                        aX,
+                        aB,
+                        aNumeric,
+                        null,
+                        null );
+            }
+            else
+            {
+                return umfpack_di_solve (
+                        mTransposedFlag,
+                        aMatrix.pointers(),
+                        aMatrix.indices(),
+                        aMatrix.data(),
+                        aX,
+                        aB,
+                        aNumeric,
+                        null,
+                        null );
+            }
+#else
+            return 0 ;
+#endif
+        }
+
+//------------------------------------------------------------------------------
+
+        void
+        UMFPACK::free_numeric( void ** aNumeric )
+        {
+#ifdef BELFEM_SUITESPARSE
+            if( mLongIndices )
+            {
+                umfpack_dl_free_numeric ( aNumeric );
+            }
+            else
+            {
+                umfpack_di_free_numeric ( aNumeric );
+            }
+#endif
+        }
+
+//------------------------------------------------------------------------------
+
+        string
+        UMFPACK::ordering_key_file() const
+        {
+            return this->ordering_file() + ".key" ;
+        }
+
+//------------------------------------------------------------------------------
+
+        bool
+        UMFPACK::ordering_matches( const SpMatrix & aMatrix ) const
+        {
+            if( aMatrix.index_type() != SpMatrixIndexType::Int32
+                || ! file_exists( this->ordering_key_file() ) )
+            {
+                return false ;
+            }
+
+            std::ifstream tFile( this->ordering_key_file() );
+
+            luint tHash = 0 ;
+            luint tNumNonZeros = 0 ;
+
+            if( ! ( tFile >> tHash >> tNumNonZeros ) )
+            {
+                return false ;
+            }
+
+            return tNumNonZeros == ( luint ) aMatrix.number_of_nonzeros()
+                && tHash == aMatrix.pattern_hash() ;
+        }
+
+//------------------------------------------------------------------------------
+
+        void
+        UMFPACK::save_ordering_key( const SpMatrix & aMatrix ) const
+        {
+            // without a key, the ordering is never read
+            if( aMatrix.index_type() != SpMatrixIndexType::Int32 )
+            {
+                std::remove( this->ordering_key_file().c_str() );
+                return ;
+            }
+
+            std::ofstream tFile( this->ordering_key_file() );
+
+            tFile << aMatrix.pattern_hash() << " "
+                  << ( luint ) aMatrix.number_of_nonzeros() << std::endl ;
+        }
+
+//------------------------------------------------------------------------------
+
+        void
+        UMFPACK::factorize( SpMatrix & aMatrix )
+        {
+#ifdef BELFEM_SUITESPARSE
+            // delete the old factorization
+            if( mNumeric != nullptr )
+            {
+                this->free_numeric( &mNumeric );
+                mNumeric = nullptr ;
+            }
+
+            // make sure that matrix is stored zero-based
+            aMatrix.set_indexing_base( SpMatrixIndexingBase::Cpp );
+
+            this->compute_numeric( aMatrix, &mNumeric );
+#else
+            BELFEM_ERROR( false, "We are not linked against UMFPACK." );
+#endif
+        }
+
+//------------------------------------------------------------------------------
+
+        void
+        UMFPACK::backsubstitute(
+                SpMatrix       & aMatrix,
+                Vector< real > & aLHS,
+                Vector< real > & aRHS )
+        {
+#ifdef BELFEM_SUITESPARSE
+            BELFEM_ASSERT( mNumeric != nullptr,
+                           "UMFPACK has no numeric factorization" );
+
+            if( aLHS.length() != aRHS.length() )
+            {
+                aLHS.set_size( aRHS.length() );
+            }
+
+            // make sure that matrix is stored zero-based
+            aMatrix.set_indexing_base( SpMatrixIndexingBase::Cpp );
+
+            int tStatus = this->solve_numeric( aMatrix, aLHS.data(), aRHS.data(), mNumeric );
+
+            // check for error
+            if( tStatus != 0 )
+            {
+                // create error message
+                string tMessage = this->error_message( tStatus );
+
+                // throw error
+                BELFEM_ERROR( tStatus == 0,
+                             "UMFPACK has thrown the error: %i at  umfpack_solve():\n%s",
+                             tStatus,
+                             tMessage.c_str() );
+            }
 #else
             BELFEM_ERROR( false, "We are not linked against UMFPACK." );
 #endif
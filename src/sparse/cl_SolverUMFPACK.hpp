@@ -20,6 +20,12 @@ namespace belfem
             // symbolic factorization
             void * mSymbolic = nullptr ;
 
+            // numeric factorization, only kept if reuse mode is active
+            void * mNumeric = nullptr ;
+
+            // tells if the umfpack_dl interface is used
+            bool mLongIndices = false ;
+
 //------------------------------------------------------------------------------
         public:
 //------------------------------------------------------------------------------
@@ -52,6 +58,16 @@ namespace belfem
             void
             free();
 
+//------------------------------------------------------------------------------
+
+            bool
+            supports_factorization_reuse() const ;
+
+//------------------------------------------------------------------------------
+
+            bool
+            supports_long_indices() const ;
+
 //------------------------------------------------------------------------------
         protected :
 //------------------------------------------------------------------------------
@@ -61,11 +77,77 @@ namespace belfem
                         const SymmetryMode aSymmetryMode = SymmetryMode::Unsymmetric,
                         const int aNumRhsColumns = 1 );
 
+//------------------------------------------------------------------------------
+
+            void
+            factorize( SpMatrix & aMatrix );
+
+//------------------------------------------------------------------------------
+
+            void
+            backsubstitute( SpMatrix & aMatrix,
+                            Vector< real > & aLHS,
+                            Vector< real > & aRHS );
+
 //------------------------------------------------------------------------------
 
             string
             error_message( const int aStatus ) const;
 
+//------------------------------------------------------------------------------
+        private:
+//------------------------------------------------------------------------------
+
+            /**
+             * numeric factorization, picks umfpack_di or umfpack_dl
+             */
+            void
+            compute_numeric( SpMatrix & aMatrix, void ** aNumeric );
+
+//------------------------------------------------------------------------------
+
+            /**
+             * solve with a numeric factorization, returns the status
+             */
+            int
+            solve_numeric(
+                    SpMatrix & aMatrix,
+                    real     * aX,
+                    real     * aB,
+                    void     * aNumeric );
+
+//------------------------------------------------------------------------------
+
+            void
+            free_numeric( void ** aNumeric );
+
+//------------------------------------------------------------------------------
+
+            /**
+             * path of the file with the pattern hash and the number
+             * of nonzeros that belong to the ordering file
+             */
+            string
+            ordering_key_file() const ;
+
+//------------------------------------------------------------------------------
+
+            /**
+             * tells if the ordering file was written for the pattern
+             * of this matrix. Only matrices with 32-bit indices can match.
+             */
+            bool
+            ordering_matches( const SpMatrix & aMatrix ) const ;
+
+//------------------------------------------------------------------------------
+
+            /**
+             * write the pattern hash and the number of nonzeros
+             * next to the ordering file
+             */
+            void
+            save_ordering_key( const SpMatrix & aMatrix ) const ;
+
 //------------------------------------------------------------------------------
         };
     }
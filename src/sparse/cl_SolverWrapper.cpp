@@ -4,6 +4,7 @@
 #include "commtools.hpp"
 #include "cl_SolverWrapper.hpp"
 #include "assert.hpp"
+#include "fn_norm.hpp"
 
 namespace belfem
 {
@@ -50,6 +51,9 @@ namespace belfem
         {
             // set the initialized flag
             mIsInitialized = false ;
+
+            // a stored factorization is no longer valid
+            mRefactorize = true ;
         }
 
 //------------------------------------------------------------------------------
@@ -122,6 +126,219 @@ namespace belfem
             }
         }
 
+//------------------------------------------------------------------------------
+
+        bool
+        Wrapper::supports_factorization_reuse() const
+        {
+            return false ;
+        }
+
+//------------------------------------------------------------------------------
+
+        bool
+        Wrapper::supports_distributed_assembly() const
+        {
+            return false ;
+        }
+
+//------------------------------------------------------------------------------
+
+        bool
+        Wrapper::supports_long_indices() const
+        {
+            return false ;
+        }
+
+//------------------------------------------------------------------------------
+
+        void
+        Wrapper::set_row_block( SpMatrixRowBlock * aRowBlock )
+        {
+            BELFEM_ERROR( aRowBlock == nullptr || this->supports_distributed_assembly(),
+                          "Distributed assembly is not supported by %s",
+                          mLabel.c_str() );
+
+            BELFEM_ERROR( ! mIsInitialized,
+                          "The row block must be set before %s is initialized",
+                          mLabel.c_str() );
+
+            mRowBlock = aRowBlock ;
+        }
+
+//------------------------------------------------------------------------------
+
+        void
+        Wrapper::set_ordering_file( const string & aPath, const bool aLoad )
+        {
+            BELFEM_ERROR( ! mIsInitialized,
+                          "The ordering file must be set before %s is initialized",
+                          mLabel.c_str() );
+
+            mOrderingFile = aPath ;
+            mLoadOrdering = aLoad ;
+        }
+
+//------------------------------------------------------------------------------
+
+        void
+        Wrapper::set_factorization_reuse(
+                const bool aSwitch,
+                const uint aMaxSteps,
+                const real aMaxContraction,
+                const real aEpsilon )
+        {
+            BELFEM_ERROR( ! aSwitch || this->supports_factorization_reuse(),
+                          "Reuse of the numeric factorization is not supported by %s",
+                          mLabel.c_str() );
+
+            mReuseFactorization = aSwitch ;
+            mMaxRefinementSteps = aMaxSteps ;
+            mMaxContraction     = aMaxContraction ;
+            mRefinementEpsilon  = aEpsilon ;
+            mRefactorize        = true ;
+        }
+
+//------------------------------------------------------------------------------
+
+        void
+        Wrapper::request_refactorization()
+        {
+            mRefactorize = true ;
+        }
+
+//------------------------------------------------------------------------------
+
+        void
+        Wrapper::factorize( SpMatrix & aMatrix )
+        {
+            BELFEM_ERROR( false, "factorize() is not implemented for %s",
+                          mLabel.c_str() );
+        }
+
+//------------------------------------------------------------------------------
+
+        void
+        Wrapper::backsubstitute( SpMatrix & aMatrix,
+                                 Vector< real > & aLHS,
+                                 Vector< real > & aRHS )
+        {
+            BELFEM_ERROR( false, "backsubstitute() is not implemented for %s",
+                          mLabel.c_str() );
+        }
+
+//------------------------------------------------------------------------------
+
+        void
+        Wrapper::solve_with_reuse( SpMatrix & aMatrix,
+                                   Vector< real > & aLHS,
+                                   Vector< real > & aRHS )
+        {
+            if( mRefactorize )
+            {
+                this->factorize( aMatrix );
+                this->backsubstitute( aMatrix, aLHS, aRHS );
+                ++mNumberOfFactorizations ;
+                mRefactorize = false ;
+                return;
+            }
+
+            // use the old factorization as preconditioner
+            this->backsubstitute( aMatrix, aLHS, aRHS );
+
+            // the residuals are computed where the matrix lives
+            const bool tResidual = this->computes_residual() ;
+
+            real tNormB = tResidual ? norm( aRHS ) : 0.0 ;
+            real tNormR0 = tNormB ;
+
+            Vector< real > tR( aRHS.length() );
+            Vector< real > tDeltaX( aRHS.length() );
+
+            bool tConverged = this->share_decision( tNormB == 0.0 ) == 1 ;
+
+            for( uint k=0; k<mMaxRefinementSteps; ++k )
+            {
+                // 0: correct, 1: converged, 2: factorization too old
+                int tDecision = 0 ;
+
+                if( tResidual )
+                {
+                    // compute the residual r = b - A x
+                    tR = aRHS ;
+                    aMatrix.multiply( aLHS, tR, -1.0, 1.0 );
+
+                    real tNormR = norm( tR );
+
+                    if( tNormR <= mRefinementEpsilon * tNormB )
+                    {
+                        tDecision = 1 ;
+                    }
+                    else if( tNormR > mMaxContraction * tNormR0 )
+                    {
+                        // the old factorization is too far away from the new matrix
+                        tDecision = 2 ;
+                    }
+                    tNormR0 = tNormR ;
+                }
+
+                tDecision = this->share_decision( tDecision );
+
+                if( tDecision == 1 )
+                {
+                    tConverged = true ;
+                    break ;
+                }
+                else if( tDecision == 2 )
+                {
+                    break ;
+                }
+
+                // correct solution
+                this->backsubstitute( aMatrix, tDeltaX, tR );
+                aLHS += tDeltaX ;
+                ++mNumberOfRefinementSteps ;
+            }
+
+            if( ! tConverged )
+            {
+                // check residual of last correction
+                if( tResidual )
+                {
+                    tR = aRHS ;
+                    aMatrix.multiply( aLHS, tR, -1.0, 1.0 );
+
+                    tConverged = norm( tR ) <= mRefinementEpsilon * tNormB ;
+                }
+
+                tConverged = this->share_decision( tConverged ) == 1 ;
+            }
+
+            if( ! tConverged )
+            {
+                // compute a new factorization
+                this->factorize( aMatrix );
+                this->backsubstitute( aMatrix, aLHS, aRHS );
+                ++mNumberOfFactorizations ;
+            }
+        }
+
+//------------------------------------------------------------------------------
+
+        bool
+        Wrapper::computes_residual() const
+        {
+            return true ;
+        }
+
+//------------------------------------------------------------------------------
+
+        int
+        Wrapper::share_decision( const int aDecision )
+        {
+            return aDecision ;
+        }
+
 //------------------------------------------------------------------------------
 
         real
@@ -9,6 +9,7 @@
 #include "cl_Vector.hpp"
 #include "cl_Matrix.hpp"
 #include "cl_SpMatrix.hpp"
+#include "st_SpMatrixRowBlock.hpp"
 #include "en_SolverEnums.hpp"
 
 namespace belfem
@@ -34,6 +35,28 @@ namespace belfem
             // flag telling if we have been initialized
             bool mIsInitialized = false ;
 
+            // settings for reusing the numeric factorization
+            bool mReuseFactorization = false ;
+            uint mMaxRefinementSteps = 5 ;
+            real mMaxContraction     = 0.25 ;
+            real mRefinementEpsilon  = 1e-10 ;
+
+            // flag telling if the next solve must compute a new factorization
+            bool mRefactorize = true ;
+
+            // counters for statistics
+            uint mNumberOfFactorizations = 0 ;
+            uint mNumberOfRefinementSteps = 0 ;
+
+            // rows of the matrix that were assembled on this proc
+            SpMatrixRowBlock * mRowBlock = nullptr ;
+
+            // file for the ordering of the symbolic factorization
+            string mOrderingFile = "" ;
+
+            // flag telling if the ordering is read from the file
+            bool mLoadOrdering = false ;
+
 //------------------------------------------------------------------------------
         public:
 //------------------------------------------------------------------------------
@@ -131,13 +154,189 @@ namespace belfem
        virtual real
        get_cond1() const ;
 
+//------------------------------------------------------------------------------
+
+        /**
+         * tells if the numeric factorization of this solver can be kept
+         * and reused between two calls of solve()
+         */
+        virtual bool
+        supports_factorization_reuse() const ;
+
+//------------------------------------------------------------------------------
+
+        /**
+         * keep the numeric factorization between two solves. If the matrix
+         * has changed, the old factorization is used for an iterative
+         * refinement. A new factorization is computed if the residual does
+         * not contract fast enough.
+         *
+         * @param aSwitch          turn the reuse mode on or off
+         * @param aMaxSteps        maximum number of refinement steps
+         * @param aMaxContraction  refactorize if |r_k+1| > aMaxContraction * |r_k|
+         * @param aEpsilon         relative residual for convergence
+         */
+        void
+        set_factorization_reuse(
+                const bool aSwitch,
+                const uint aMaxSteps       = 5,
+                const real aMaxContraction = 0.25,
+                const real aEpsilon        = 1e-10 );
+
+//------------------------------------------------------------------------------
+
+        /**
+         * enforce a new numeric factorization during the next solve
+         */
+        void
+        request_refactorization() ;
+
+//------------------------------------------------------------------------------
+
+        /**
+         * tells if the reuse mode is active
+         */
+        bool
+        reuses_factorization() const ;
+
+//------------------------------------------------------------------------------
+
+        /**
+         * number of numeric factorizations in reuse mode
+         */
+        uint
+        number_of_factorizations() const ;
+
+//------------------------------------------------------------------------------
+
+        /**
+         * number of iterative refinement steps in reuse mode
+         */
+        uint
+        number_of_refinement_steps() const ;
+
+//------------------------------------------------------------------------------
+
+        /**
+         * tells if the solver can use matrix rows that were
+         * assembled by the procs that own them
+         */
+        virtual bool
+        supports_distributed_assembly() const ;
+
+//------------------------------------------------------------------------------
+
+        /**
+         * tells if the solver accepts matrices with 64-bit indices
+         */
+        virtual bool
+        supports_long_indices() const ;
+
+//------------------------------------------------------------------------------
+
+        /**
+         * link the rows of the matrix that belong to this proc.
+         * If set, the matrix values are not sent by the master.
+         * Must be called before the first solve.
+         */
+        void
+        set_row_block( SpMatrixRowBlock * aRowBlock );
+
+//------------------------------------------------------------------------------
+
+        /**
+         * file for the fill reducing ordering of the symbolic factorization.
+         * If aLoad is set and the file exists, the ordering is read,
+         * otherwise it is computed and written. Only used by solvers
+         * that can store their symbolic factorization.
+         * Must be called before the first solve.
+         */
+        void
+        set_ordering_file( const string & aPath, const bool aLoad );
+
 //------------------------------------------------------------------------------
         protected:
+//------------------------------------------------------------------------------
+
+            /**
+             * the ordering file, empty if not set
+             */
+            const string &
+            ordering_file() const ;
+
+//------------------------------------------------------------------------------
+
+            /**
+             * tells if the ordering is read from the file
+             */
+            bool
+            loads_ordering() const ;
+
+//------------------------------------------------------------------------------
+
+            /**
+             * the rows of the matrix that belong to this proc,
+             * nullptr if the matrix is gathered on the master
+             */
+            SpMatrixRowBlock *
+            row_block() ;
+
 //------------------------------------------------------------------------------
 
             virtual void
             initialize();
 
+//------------------------------------------------------------------------------
+
+            /**
+             * compute the numeric factorization and keep it,
+             * must be implemented by the child if reuse is supported
+             */
+            virtual void
+            factorize( SpMatrix & aMatrix );
+
+//------------------------------------------------------------------------------
+
+            /**
+             * solve the system using the stored numeric factorization,
+             * must be implemented by the child if reuse is supported
+             */
+            virtual void
+            backsubstitute( SpMatrix & aMatrix,
+                            Vector< real > & aLHS,
+                            Vector< real > & aRHS );
+
+//------------------------------------------------------------------------------
+
+            /**
+             * solve the system and reuse the numeric factorization
+             * from the last call if possible
+             */
+            void
+            solve_with_reuse( SpMatrix & aMatrix,
+                              Vector< real > & aLHS,
+                              Vector< real > & aRHS );
+
+//------------------------------------------------------------------------------
+
+            /**
+             * tells if this proc computes the residuals in reuse mode.
+             * Solvers that run on all procs with the matrix on the master
+             * return false on the other procs.
+             */
+            virtual bool
+            computes_residual() const ;
+
+//------------------------------------------------------------------------------
+
+            /**
+             * makes the other procs follow a decision of the reuse mode,
+             * must be implemented by the child if computes_residual()
+             * is not true on all procs
+             */
+            virtual int
+            share_decision( const int aDecision ) ;
+
 //------------------------------------------------------------------------------
 
             void
@@ -179,6 +378,54 @@ namespace belfem
             return mCommSize ;
         }
 
+//------------------------------------------------------------------------------
+
+        inline bool
+        Wrapper::reuses_factorization() const
+        {
+            return mReuseFactorization ;
+        }
+
+//------------------------------------------------------------------------------
+
+        inline uint
+        Wrapper::number_of_factorizations() const
+        {
+            return mNumberOfFactorizations ;
+        }
+
+//------------------------------------------------------------------------------
+
+        inline uint
+        Wrapper::number_of_refinement_steps() const
+        {
+            return mNumberOfRefinementSteps ;
+        }
+
+//------------------------------------------------------------------------------
+
+        inline SpMatrixRowBlock *
+        Wrapper::row_block()
+        {
+            return mRowBlock ;
+        }
+
+//------------------------------------------------------------------------------
+
+        inline const string &
+        Wrapper::ordering_file() const
+        {
+            return mOrderingFile ;
+        }
+
+//------------------------------------------------------------------------------
+
+        inline bool
+        Wrapper::loads_ordering() const
+        {
+            return mLoadOrdering ;
+        }
+
 //------------------------------------------------------------------------------
     }
 }
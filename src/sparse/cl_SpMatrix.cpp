@@ -9,14 +9,15 @@
 #include "cl_SpMatrix.hpp"
 #include "fn_max.hpp"
 #include "fn_unique.hpp"
+#include "fn_hash.hpp"
 #include "cl_Timer.hpp"
 #include "cl_Logger.hpp"
 
-#include "fspblas.hpp"
 #include "HDF5_Tools.hpp"
 #include "cl_HDF5.hpp"
 #include "stringtools.hpp"
 #include "fn_Graph_sort.hpp"
+#include "threadtools.hpp"
 
 #ifdef BELFEM_MPI
 #include "commtools.hpp"
@@ -24,14 +25,68 @@
 
 namespace belfem
 {
+    namespace
+    {
+//------------------------------------------------------------------------------
+
+        // below this size, the multiplication kernels run serially
+        constexpr index_t gSpMVParallelLimit = 4096 ;
+
+//------------------------------------------------------------------------------
+
+        /**
+         * pick the 32-bit or the 64-bit container
+         */
+        template< typename I >
+        const I *
+        select_container( const int * aInt, const lsint * aLong );
+
+        template<>
+        inline const int *
+        select_container< int >( const int * aInt, const lsint * aLong )
+        {
+            return aInt;
+        }
+
+        template<>
+        inline const lsint *
+        select_container< lsint >( const int * aInt, const lsint * aLong )
+        {
+            return aLong;
+        }
+
+//------------------------------------------------------------------------------
+
+        /**
+         * allocate a copy of an index array
+         */
+        template< typename I >
+        I *
+        copy_container( const I * aSource, const lsint aLength )
+        {
+            if( aSource == nullptr )
+            {
+                return nullptr;
+            }
+
+            I * aTarget = ( I * ) malloc( ( aLength > 0 ? aLength : 1 ) * sizeof( I ) );
+            std::memcpy( aTarget, aSource, aLength * sizeof( I ) );
+
+            return aTarget;
+        }
+
+//------------------------------------------------------------------------------
+    }
 
 //------------------------------------------------------------------------------
 
     SpMatrix::SpMatrix( Cell<graph::Vertex *> & aGraph,
                         const enum SpMatrixType aType,
                         const index_t aNumRows,
-                        const index_t aNumCols) :
-            mType( aType )
+                        const index_t aNumCols,
+                        const SpMatrixIndexType aIndexType ) :
+            mType( aType ),
+            mIndexType( aIndexType )
     {
         belfem::graph::sort( aGraph );
 
@@ -58,17 +113,33 @@ namespace belfem
             this->set_sizes( aNumRows, aNumCols );
         }
 
+        const bool tLong = aIndexType == SpMatrixIndexType::Int64 ;
+
         // chech which kind of matrix this is
         switch ( aType )
         {
             case ( SpMatrixType::CSR ) :
             {
-                this->create_csr_indices( aGraph );
+                if( tLong )
+                {
+                    this->create_csr_indices( aGraph, mLongPointers, mLongColumns );
+                }
+                else
+                {
+                    this->create_csr_indices( aGraph, mPointers, mColumns );
+                }
                 break;
             }
             case( SpMatrixType::CSC ):
             {
-                this->create_csc_indices( aGraph );
+                if( tLong )
+                {
+                    this->create_csc_indices( aGraph, mLongPointers, mLongRows );
+                }
+                else
+                {
+                    this->create_csc_indices( aGraph, mPointers, mRows );
+                }
                 break;
             }
             default:
@@ -84,9 +155,6 @@ namespace belfem
         // fill container with zeros
         this->fill( 0.0 );
 
-#ifdef BELFEM_NETLIB
-        this->allocate_swap();
-#endif
         this->set_indexing_base( SpMatrixIndexingBase::Cpp );
     }
 //------------------------------------------------------------------------------
@@ -117,9 +185,6 @@ namespace belfem
         }
 
 
-#ifdef BELFEM_NETLIB
-        this->allocate_swap();
-#endif
 
         this->allocate_values() ;
 
@@ -229,6 +294,76 @@ namespace belfem
 
     }
 
+//------------------------------------------------------------------------------
+
+    SpMatrix::SpMatrix( const Vector< index_t > & aOffsets,
+                        const Vector< index_t > & aRowIndices,
+                        const Vector< index_t > & aColIndices,
+                        const enum SpMatrixType   aType,
+                        const index_t             aNumRows,
+                        const index_t             aNumCols,
+                        const uint                aNumThreads,
+                        const SpMatrixIndexType   aIndexType ) :
+            mType( aType ),
+            mIndexType( aIndexType )
+    {
+        BELFEM_ASSERT( aRowIndices.length() == aColIndices.length(),
+                       "number of row and column indices does not match ( %lu vs %lu )",
+                       ( long unsigned int ) aRowIndices.length(),
+                       ( long unsigned int ) aColIndices.length() );
+
+        this->set_sizes( aNumRows, aNumCols );
+
+        const bool tLong = aIndexType == SpMatrixIndexType::Int64 ;
+
+        switch ( aType )
+        {
+            case ( SpMatrixType::CSR ) :
+            {
+                mPointerSize = mNumRows + 1;
+                if( tLong )
+                {
+                    this->create_indices_from_elements( aOffsets, aRowIndices, aColIndices,
+                                                        aNumRows, aNumThreads, mLongPointers, mLongColumns );
+                }
+                else
+                {
+                    this->create_indices_from_elements( aOffsets, aRowIndices, aColIndices,
+                                                        aNumRows, aNumThreads, mPointers, mColumns );
+                }
+                break;
+            }
+            case( SpMatrixType::CSC ):
+            {
+                mPointerSize = mNumCols + 1;
+                if( tLong )
+                {
+                    this->create_indices_from_elements( aOffsets, aColIndices, aRowIndices,
+                                                        aNumCols, aNumThreads, mLongPointers, mLongRows );
+                }
+                else
+                {
+                    this->create_indices_from_elements( aOffsets, aColIndices, aRowIndices,
+                                                        aNumCols, aNumThreads, mPointers, mRows );
+                }
+                break;
+            }
+            default:
+            {
+                BELFEM_ERROR( false, "Unknown SpMatrixType" );
+                break;
+            }
+        }
+
+        // allocate the data container
+        this->allocate_values();
+
+        // fill container with zeros
+        this->fill( 0.0 );
+
+        this->set_indexing_base( SpMatrixIndexingBase::Cpp );
+    }
+
 //------------------------------------------------------------------------------
 
     SpMatrix::~SpMatrix()
@@ -259,6 +394,24 @@ namespace belfem
             mColumns = nullptr;
             mNumCols = 0;
         }
+        if( mLongPointers != nullptr )
+        {
+            free( mLongPointers );
+            mLongPointers = nullptr;
+            mPointerSize = 0;
+        }
+        if( mLongRows != nullptr )
+        {
+            free( mLongRows );
+            mLongRows = nullptr;
+            mNumRows = 0;
+        }
+        if( mLongColumns != nullptr )
+        {
+            free( mLongColumns );
+            mLongColumns = nullptr;
+            mNumCols = 0;
+        }
         if( mValues != NULL )
         {
             free( mValues );
@@ -266,14 +419,6 @@ namespace belfem
             mNumNonZeros = 0;
         }
 
-#ifdef BELFEM_NETLIB
-        if( mSwap != NULL )
-        {
-            free( mSwap );
-            mSwap = nullptr;
-            mSwapSize = 0;
-        }
-#endif
 
     }
 
@@ -334,8 +479,12 @@ namespace belfem
 
 //------------------------------------------------------------------------------
 
+    template< typename I >
     void
-    SpMatrix::create_csr_indices( Cell< graph::Vertex * > & aGraph )
+    SpMatrix::create_csr_indices(
+            Cell< graph::Vertex * > & aGraph,
+            I                      *& aPointers,
+            I                      *& aColumns )
     {
         // number of vertices
         index_t tSize = aGraph.size();
@@ -343,37 +492,37 @@ namespace belfem
         mPointerSize = mNumRows + 1;
 
         // allocate pointer array
-        mPointers = ( int * ) malloc( ( mPointerSize ) * sizeof( int ) );
+        aPointers = ( I * ) malloc( ( mPointerSize ) * sizeof( I ) );
 
         // populate pointer array
-        std::fill_n( mPointers, mPointerSize, 0 );
+        std::fill_n( aPointers, mPointerSize, 0 );
 
         // create pointer array ( step 1 )
         for ( index_t k = 0; k < tSize; ++k )
         {
-            mPointers[ aGraph( k )->index() + 1 ] = ( int ) aGraph( k )->number_of_vertices();
+            aPointers[ aGraph( k )->index() + 1 ] = ( I ) aGraph( k )->number_of_vertices();
         }
 
         // counter to prevent data type overflow
-        index_t tCount = 0;
+        luint tCount = 0;
 
         // create pointer array ( step 2 )
         for ( int k = 1; k < mPointerSize; ++k )
         {
-            tCount += mPointers[ k ];
-            mPointers[ k ] += mPointers[ k - 1 ];
+            tCount += aPointers[ k ];
+            aPointers[ k ] += aPointers[ k - 1 ];
         }
 
         // set number of nonzeros and check int type boundaries
         this->set_nnz( tCount );
 
-        BELFEM_ASSERT( ( index_t ) mPointers[ mNumRows ] == tCount,
+        BELFEM_ASSERT( ( luint ) aPointers[ mNumRows ] == tCount,
             "Something went wrong while creating CSR index" );
 
         // allocate index vector
         tCount = ( tCount == 0 ) ? 1 : tCount;
 
-        mColumns = ( int * ) malloc( tCount * sizeof( int ) );
+        aColumns = ( I * ) malloc( tCount * sizeof( I ) );
 
         // reset counter
         tCount = 0;
@@ -385,20 +534,189 @@ namespace belfem
 
             for( uint k=0; k<tNumVertices; ++k )
             {
-                mColumns[ tCount++ ] = tVertex->vertex( k )->index();
+                aColumns[ tCount++ ] = tVertex->vertex( k )->index();
             }
         }
     }
 
 //------------------------------------------------------------------------------
 
+    template< typename I >
     void
-    SpMatrix::create_csc_indices(  Cell< graph::Vertex * > & aGraph )
+    SpMatrix::create_indices_from_elements(
+            const Vector< index_t > & aOffsets,
+            const Vector< index_t > & aMajor,
+            const Vector< index_t > & aMinor,
+            const index_t             aNumMajor,
+            const uint                aNumThreads,
+            I                      *& aPointers,
+            I                      *& aIndices )
+    {
+        const index_t tNumElements = aOffsets.length() > 0 ? aOffsets.length() - 1 : 0 ;
+
+        // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+        // step 1: elements per major index
+        // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+        Vector< index_t > tElementPointers( aNumMajor + 1, 0 );
+
+        // number of candidates per major index, needed for the buffer size
+        Vector< index_t > tCandidates( aNumMajor, 0 );
+
+        for( index_t e=0; e<tNumElements; ++e )
+        {
+            index_t tSize = aOffsets( e + 1 ) - aOffsets( e );
+
+            for( index_t k=aOffsets( e ); k<aOffsets( e + 1 ); ++k )
+            {
+                if( aMajor( k ) != gNoIndex )
+                {
+                    ++tElementPointers( aMajor( k ) + 1 );
+                    tCandidates( aMajor( k ) ) += tSize ;
+                }
+            }
+        }
+
+        index_t tBufferSize = 1 ;
+        for( index_t i=0; i<aNumMajor; ++i )
+        {
+            tElementPointers( i + 1 ) += tElementPointers( i );
+            tBufferSize = tCandidates( i ) > tBufferSize ? tCandidates( i ) : tBufferSize ;
+        }
+
+        // reuse the candidate counter as write position
+        for( index_t i=0; i<aNumMajor; ++i )
+        {
+            tCandidates( i ) = tElementPointers( i );
+        }
+
+        Vector< index_t > tElements( tElementPointers( aNumMajor ) );
+
+        for( index_t e=0; e<tNumElements; ++e )
+        {
+            for( index_t k=aOffsets( e ); k<aOffsets( e + 1 ); ++k )
+            {
+                if( aMajor( k ) != gNoIndex )
+                {
+                    tElements( tCandidates( aMajor( k ) )++ ) = e ;
+                }
+            }
+        }
+
+        tCandidates.set_size( 0 );
+
+        // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+        // step 2: count the nonzeros per major index
+        // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+        aPointers = ( I * ) malloc( ( mPointerSize ) * sizeof( I ) );
+        std::fill_n( aPointers, mPointerSize, 0 );
+
+        const int n = ( int ) aNumMajor ;
+
+#ifdef OMP
+        const int tNumThreads = aNumThreads == 0 ? max_number_of_threads() : aNumThreads ;
+
+        #pragma omp parallel num_threads( tNumThreads ) if( tNumThreads > 1 )
+#endif
+        {
+            // each thread has its own buffer
+            Vector< I > tBuffer( tBufferSize );
+
+#ifdef OMP
+            #pragma omp for schedule( dynamic, 256 )
+#endif
+            for( int i=0; i<n; ++i )
+            {
+                aPointers[ i + 1 ] = ( I ) this->collect_element_indices(
+                        i, tElementPointers, tElements, aOffsets, aMinor, tBuffer.data() );
+            }
+        }
+
+        // counter to prevent data type overflow
+        luint tCount = 0;
+
+        for ( int k = 1; k < mPointerSize; ++k )
+        {
+            tCount += aPointers[ k ];
+            aPointers[ k ] += aPointers[ k - 1 ];
+        }
+
+        // set number of nonzeros and check int type boundaries
+        this->set_nnz( tCount );
+
+        // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+        // step 3: fill the indices, they are sorted per major index
+        // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+        tCount = ( tCount == 0 ) ? 1 : tCount;
+
+        aIndices = ( I * ) malloc( tCount * sizeof( I ) );
+
+#ifdef OMP
+        #pragma omp parallel num_threads( tNumThreads ) if( tNumThreads > 1 )
+#endif
+        {
+            Vector< I > tBuffer( tBufferSize );
+
+#ifdef OMP
+            #pragma omp for schedule( dynamic, 256 )
+#endif
+            for( int i=0; i<n; ++i )
+            {
+                index_t tLength = this->collect_element_indices(
+                        i, tElementPointers, tElements, aOffsets, aMinor, tBuffer.data() );
+
+                std::memcpy( aIndices + aPointers[ i ], tBuffer.data(), tLength * sizeof( I ) );
+            }
+        }
+    }
+
+//------------------------------------------------------------------------------
+
+    template< typename I >
+    index_t
+    SpMatrix::collect_element_indices(
+            const index_t             aMajor,
+            const Vector< index_t > & aElementPointers,
+            const Vector< index_t > & aElements,
+            const Vector< index_t > & aOffsets,
+            const Vector< index_t > & aMinor,
+            I                       * aBuffer ) const
+    {
+        index_t tCount = 0 ;
+
+        for( index_t j=aElementPointers( aMajor ); j<aElementPointers( aMajor + 1 ); ++j )
+        {
+            index_t e = aElements( j );
+
+            for( index_t k=aOffsets( e ); k<aOffsets( e + 1 ); ++k )
+            {
+                if( aMinor( k ) != gNoIndex )
+                {
+                    aBuffer[ tCount++ ] = ( I ) aMinor( k );
+                }
+            }
+        }
+
+        std::sort( aBuffer, aBuffer + tCount );
+
+        return std::unique( aBuffer, aBuffer + tCount ) - aBuffer ;
+    }
+
+//------------------------------------------------------------------------------
+
+    template< typename I >
+    void
+    SpMatrix::create_csc_indices(
+            Cell< graph::Vertex * > & aGraph,
+            I                      *& aPointers,
+            I                      *& aRows )
     {
         // number of vertices
         index_t tSize = aGraph.size();
 
-        index_t tNumNonzeros = 0;
+        luint tNumNonzeros = 0;
 
         // allocate a counting array
         index_t * tCount = ( index_t * ) malloc( mNumCols * sizeof( index_t ) );
@@ -422,12 +740,12 @@ namespace belfem
         mPointerSize = mNumCols + 1;
 
         // populate pointer array
-        mPointers = ( int * ) malloc( ( mPointerSize ) * sizeof( int ) );
+        aPointers = ( I * ) malloc( ( mPointerSize ) * sizeof( I ) );
 
-        mPointers[ 0 ] = 0;
+        aPointers[ 0 ] = 0;
         for( int k=0; k<mNumCols; ++k )
         {
-            mPointers[ k+1 ] = mPointers[ k ] + tCount[ k ];
+            aPointers[ k+1 ] = aPointers[ k ] + tCount[ k ];
         }
 
         // reset counter
@@ -439,7 +757,7 @@ namespace belfem
         // populate indices
         tNumNonzeros = ( tNumNonzeros == 0 ) ? 1 : tNumNonzeros;
 
-        mRows = ( int * ) malloc( tNumNonzeros * sizeof( int ) );
+        aRows = ( I * ) malloc( tNumNonzeros * sizeof( I ) );
 
         int n = ( int ) tSize;
 
@@ -454,7 +772,7 @@ namespace belfem
                 index_t j = aGraph( k )->vertex( i )->index();
 
                 // write index into array
-                mRows[ mPointers[ j ] + tCount[ j ] ] = ( int ) aGraph( k )->index();
+                aRows[ aPointers[ j ] + tCount[ j ] ] = ( I ) aGraph( k )->index();
 
                 // increment counter
                 ++tCount[ j ];
@@ -491,16 +809,27 @@ namespace belfem
 //------------------------------------------------------------------------------
 
     void
-    SpMatrix::set_nnz( const index_t aNumNonZeros )
+    SpMatrix::set_nnz( const luint aNumNonZeros )
     {
-        // make sure that NNZ is OK
-        BELFEM_ERROR( aNumNonZeros < ( index_t )  BELFEM_INT_MAX,
-                     "too many non-zeros in matrix (%lu > %lu )",
-                     ( long unsigned int ) aNumNonZeros,
-                     ( long unsigned int ) BELFEM_INT_MAX );
+        // make sure that NNZ is OK, 64-bit matrices are limited
+        // by index_t, since the position tables use it
+        if( mIndexType == SpMatrixIndexType::Int64 )
+        {
+            BELFEM_ERROR( aNumNonZeros < ( luint ) gNoIndex,
+                         "too many non-zeros in matrix (%lu > %lu )",
+                         ( long unsigned int ) aNumNonZeros,
+                         ( long unsigned int ) gNoIndex );
+        }
+        else
+        {
+            BELFEM_ERROR( aNumNonZeros < ( luint ) BELFEM_INT_MAX,
+                         "too many non-zeros in matrix (%lu > %lu ), use 64-bit indices",
+                         ( long unsigned int ) aNumNonZeros,
+                         ( long unsigned int ) BELFEM_INT_MAX );
+        }
 
         // set data
-        mNumNonZeros = ( int ) aNumNonZeros;
+        mNumNonZeros = ( lsint ) aNumNonZeros;
     }
 
 //------------------------------------------------------------------------------
@@ -510,20 +839,6 @@ namespace belfem
     {
         mValues = ( real * ) malloc( mNumNonZeros * sizeof( real ) );
     }
-//------------------------------------------------------------------------------
-
-#ifdef BELFEM_NETLIB
-    /**
-     * allocate swap vector
-     */
-    void
-    SpMatrix::allocate_swap()
-    {
-        mSwapSize = ( mNumRows > mNumCols ) ? mNumRows : mNumCols ;
-        mSwap = ( real * ) malloc( mSwapSize * sizeof( real ) );
-    }
-#endif
-
 //------------------------------------------------------------------------------
 
     void
@@ -537,31 +852,24 @@ namespace belfem
     void
     SpMatrix::set_indexing_base( const enum SpMatrixIndexingBase & aBasis )
     {
+        const bool tLong = mIndexType == SpMatrixIndexType::Int64 ;
+
         switch( aBasis )
         {
             case( SpMatrixIndexingBase::Cpp ) :
             {
                 // test if this is in fortran base
-                if( mPointers[ 0 ] == 1 )
+                if( this->indexing_base() == 1 )
                 {
-                    // decrement all pointers
-                    std::for_each( mPointers, mPointers + mPointerSize,
-                                   [ ]( int & tValue ){ --tValue; } );
-
-                    // decrement all rows
-                    if( mRows != nullptr )
+                    // decrement all pointers and indices
+                    if( tLong )
                     {
-                        std::for_each( mRows, mRows + mNumNonZeros,
-                                       [ ]( int & tValue ){ --tValue; } );
+                        this->shift_indices( mLongPointers, mLongRows, mLongColumns, ( lsint ) -1 );
                     }
-
-                    // decrement all cols
-                    if( mColumns != nullptr )
+                    else
                     {
-                        std::for_each( mColumns, mColumns + mNumNonZeros,
-                                       [ ]( int & tValue ){ --tValue; } );
+                        this->shift_indices( mPointers, mRows, mColumns, -1 );
                     }
-
                 }
 
                 // set index function
@@ -569,12 +877,16 @@ namespace belfem
                 {
                     case( SpMatrixType::CSR ) :
                     {
-                        mIndexFunction = & SpMatrix::index_csr_zero_based;
+                        mIndexFunction = tLong ?
+                                & SpMatrix::index_csr_zero_based< lsint > :
+                                & SpMatrix::index_csr_zero_based< int > ;
                         break;
                     }
                     case( SpMatrixType::CSC ) :
                     {
-                        mIndexFunction = & SpMatrix::index_csc_zero_based;
+                        mIndexFunction = tLong ?
+                                & SpMatrix::index_csc_zero_based< lsint > :
+                                & SpMatrix::index_csc_zero_based< int > ;
                         break;
                     }
                     default:
@@ -588,38 +900,33 @@ namespace belfem
             case( SpMatrixIndexingBase::Fortran ) :
             {
                 // test if this is in c++ base
-                if( mPointers[ 0 ] == 0 )
+                if( this->indexing_base() == 0 )
                 {
-                    // decrement all pointers
-                    std::for_each( mPointers, mPointers + mPointerSize,
-                                   [ ]( int & tValue ){ ++tValue; } );
-
-                    // increment all rows
-                    if( mRows != nullptr )
+                    // increment all pointers and indices
+                    if( tLong )
                     {
-                        std::for_each( mRows, mRows + mNumNonZeros,
-                                       [ ]( int & tValue ){ ++tValue; } );
+                        this->shift_indices( mLongPointers, mLongRows, mLongColumns, ( lsint ) 1 );
                     }
-
-                    // increment all cols
-                    if( mColumns != nullptr )
+                    else
                     {
-                        std::for_each( mColumns, mColumns + mNumNonZeros,
-                                       [ ]( int & tValue ){ ++tValue; } );
+                        this->shift_indices( mPointers, mRows, mColumns, 1 );
                     }
-
                 }
                 // set index function
                 switch( mType )
                 {
                     case( SpMatrixType::CSR ) :
                     {
-                        mIndexFunction = & SpMatrix::index_csr_one_based;
+                        mIndexFunction = tLong ?
+                                & SpMatrix::index_csr_one_based< lsint > :
+                                & SpMatrix::index_csr_one_based< int > ;
                         break;
                     }
                     case( SpMatrixType::CSC ) :
                     {
-                        mIndexFunction = & SpMatrix::index_csc_one_based;
+                        mIndexFunction = tLong ?
+                                & SpMatrix::index_csc_one_based< lsint > :
+                                & SpMatrix::index_csc_one_based< int > ;
                         break;
                     }
                     default:
@@ -638,6 +945,28 @@ namespace belfem
         }
     }
 
+//------------------------------------------------------------------------------
+
+    template< typename I >
+    void
+    SpMatrix::shift_indices( I * aPointers, I * aRows, I * aColumns, const I aShift )
+    {
+        std::for_each( aPointers, aPointers + mPointerSize,
+                       [ aShift ]( I & tValue ){ tValue += aShift; } );
+
+        if( aRows != nullptr )
+        {
+            std::for_each( aRows, aRows + mNumNonZeros,
+                           [ aShift ]( I & tValue ){ tValue += aShift; } );
+        }
+
+        if( aColumns != nullptr )
+        {
+            std::for_each( aColumns, aColumns + mNumNonZeros,
+                           [ aShift ]( I & tValue ){ tValue += aShift; } );
+        }
+    }
+
 //------------------------------------------------------------------------------
 
     void
@@ -646,57 +975,31 @@ namespace belfem
         // make sure that we use Cpp indexing
         this->set_indexing_base( SpMatrixIndexingBase::Cpp );
 
+        const bool tLong = mIndexType == SpMatrixIndexType::Int64 ;
+
         switch( mType )
         {
             case( SpMatrixType::CSR ) :
             {
-                // test if rows already exist
-                if( mRows == nullptr )
+                if( tLong )
                 {
-                    if( mNumNonZeros == 0 )
-                    {
-                        mRows = ( int * ) malloc( 1 * sizeof( int ));
-                    }
-                   else
-                    {
-                        mRows = ( int * ) malloc( mNumNonZeros * sizeof( int ));
-                    }
-
-                    // populate row indices
-                    int tCount = 0;
-                    for ( int k = 0; k < mNumRows; ++k )
-                    {
-                        int tN = mPointers[ k + 1 ] - mPointers[ k ];
-                        for ( int i = 0; i < tN; ++i )
-                        {
-                            mRows[ tCount++ ] = k;
-                        }
-                    }
+                    this->create_coo_indices( mLongPointers, mNumRows, mLongRows );
+                }
+                else
+                {
+                    this->create_coo_indices( mPointers, mNumRows, mRows );
                 }
                 break;
             }
             case( SpMatrixType::CSC ) :
             {
-                if( mColumns == nullptr )
+                if( tLong )
                 {
-                    if ( mNumNonZeros == 0 )
-                    {
-                        mColumns = ( int * ) malloc( 1 * sizeof( int ));
-                    }
-                    else
-                    {
-                        mColumns = ( int * ) malloc( mNumNonZeros * sizeof( int ));
-                    }
-                    // populate row indices
-                    int tCount = 0;
-                    for ( int k = 0; k < mNumCols; ++k )
-                    {
-                        int tN = mPointers[ k + 1 ] - mPointers[ k ];
-                        for ( int i = 0; i < tN; ++i )
-                        {
-                            mColumns[ tCount++ ] = k;
-                        }
-                    }
+                    this->create_coo_indices( mLongPointers, mNumCols, mLongColumns );
+                }
+                else
+                {
+                    this->create_coo_indices( mPointers, mNumCols, mColumns );
                 }
                 break;
             }
@@ -708,6 +1011,40 @@ namespace belfem
         }
     }
 
+//------------------------------------------------------------------------------
+
+    template< typename I >
+    void
+    SpMatrix::create_coo_indices(
+            const I * aPointers,
+            const int aNumMajor,
+                  I *& aIndices )
+    {
+        // test if indices already exist
+        if( aIndices == nullptr )
+        {
+            if( mNumNonZeros == 0 )
+            {
+                aIndices = ( I * ) malloc( 1 * sizeof( I ));
+            }
+            else
+            {
+                aIndices = ( I * ) malloc( mNumNonZeros * sizeof( I ));
+            }
+
+            // populate indices
+            lsint tCount = 0;
+            for ( int k = 0; k < aNumMajor; ++k )
+            {
+                I tN = aPointers[ k + 1 ] - aPointers[ k ];
+                for ( I i = 0; i < tN; ++i )
+                {
+                    aIndices[ tCount++ ] = k;
+                }
+            }
+        }
+    }
+
 //------------------------------------------------------------------------------
 
     void
@@ -720,6 +1057,12 @@ namespace belfem
                 if ( mRows != NULL )
                 {
                     free( mRows );
+                    mRows = nullptr;
+                }
+                if ( mLongRows != nullptr )
+                {
+                    free( mLongRows );
+                    mLongRows = nullptr;
                 }
                 break;
             }
@@ -728,6 +1071,12 @@ namespace belfem
                 if ( mColumns != NULL )
                 {
                     free( mColumns );
+                    mColumns = nullptr;
+                }
+                if ( mLongColumns != nullptr )
+                {
+                    free( mLongColumns );
+                    mLongColumns = nullptr;
                 }
                 break;
             }
@@ -746,6 +1095,9 @@ namespace belfem
     void
     SpMatrix::print( const string aLabel  )
     {
+        BELFEM_ERROR( mIndexType == SpMatrixIndexType::Int32,
+                      "print() is only implemented for 32-bit indices" );
+
         int tCount = 0;
 
         std::cout<< "SpMatrix " << aLabel << " (" << mNumRows << ", " << mNumCols << ") " << std::endl;
@@ -785,6 +1137,9 @@ namespace belfem
     void
     SpMatrix::print2( const string aLabel  )
     {
+        BELFEM_ERROR( mIndexType == SpMatrixIndexType::Int32,
+                      "print2() is only implemented for 32-bit indices" );
+
         std::cout<< "SpMatrix " << aLabel << " (" << mNumRows << ", " << mNumCols << ") " << std::endl;
 
         for( int k=0; k<mPointerSize; ++k )
@@ -844,6 +1199,9 @@ namespace belfem
             herr_t       & aStatus )
     {
 #ifdef BELFEM_HDF5
+        BELFEM_ERROR( mIndexType == SpMatrixIndexType::Int32,
+                      "saving a sparse matrix is only implemented for 32-bit indices" );
+
         // the format label of this file
         string tFormatLabel;
 
@@ -873,7 +1231,8 @@ namespace belfem
         hdf5::save_scalar_to_file( aGroup, "NumRows", mNumRows, aStatus );
         hdf5::save_scalar_to_file( aGroup, "NumCols", mNumCols, aStatus );
         // save number of nonzeros
-        hdf5::save_scalar_to_file( aGroup, "NumNonZeros", mNumNonZeros, aStatus );
+        int tNumNonZeros = ( int ) mNumNonZeros;
+        hdf5::save_scalar_to_file( aGroup, "NumNonZeros", tNumNonZeros, aStatus );
 
         // save pointers
         hdf5::save_array_to_file( aGroup, "Pointers", mPointers, mPointerSize, aStatus );
@@ -953,7 +1312,12 @@ namespace belfem
         hdf5::load_scalar_from_file( aGroup, "NumCols", mNumCols, aStatus );
 
         // load number of nonzeros
-        hdf5::load_scalar_from_file( aGroup, "NumNonZeros", mNumNonZeros, aStatus );
+        int tNumNonZeros = 0;
+        hdf5::load_scalar_from_file( aGroup, "NumNonZeros", tNumNonZeros, aStatus );
+        mNumNonZeros = tNumNonZeros;
+
+        // files are always written with 32-bit indices
+        mIndexType = SpMatrixIndexType::Int32;
 
         // determine pointer size
         if( mType == SpMatrixType::CSC )
@@ -1007,9 +1371,6 @@ namespace belfem
         // load values
         hdf5::load_array_from_file( aGroup, "Values", mValues, mNumNonZeros, aStatus );
 
-#ifdef BELFEM_NETLIB
-        this->allocate_swap();
-#endif
 #else
         BELFEM_ERROR( false, "Trying to load a matrix from HDF5, but BELFEM is not link against HDF5 libraries." );
 #endif
@@ -1017,6 +1378,24 @@ namespace belfem
 
 //------------------------------------------------------------------------------
 
+    luint
+    SpMatrix::pattern_hash() const
+    {
+        BELFEM_ERROR( mIndexType == SpMatrixIndexType::Int32,
+                      "the pattern hash is only implemented for 32-bit indices" );
+
+        luint aHash = hash_value( mType );
+        aHash = hash_value( mNumRows, aHash );
+        aHash = hash_value( mNumCols, aHash );
+        aHash = hash_value( mNumNonZeros, aHash );
+        aHash = hash_bytes( mPointers, mPointerSize * sizeof( int ), aHash );
+
+        return hash_bytes( this->indices(), mNumNonZeros * sizeof( int ), aHash );
+    }
+
+//------------------------------------------------------------------------------
+
+    template< typename I >
     index_t
     SpMatrix::index_csr_zero_based(
             const index_t & aRowIndex,
@@ -1030,16 +1409,19 @@ namespace belfem
                       ( long unsigned int ) aColIndex ,
                       ( long unsigned int ) mNumCols );
 
-        auto tBegin = mColumns + mPointers[ aRowIndex ];
+        const I * tPointers = select_container< I >( mPointers, mLongPointers );
+        const I * tColumns  = select_container< I >( mColumns, mLongColumns );
+
+        auto tBegin = tColumns + tPointers[ aRowIndex ];
 
-        auto tEnd   = mColumns + mPointers[ aRowIndex+1 ];
+        auto tEnd   = tColumns + tPointers[ aRowIndex+1 ];
 
         // find position in memory
         auto tFound = std::find( tBegin, tEnd, aColIndex );
 
         if( tFound < tEnd )
         {
-            return ( tFound - tBegin ) + mPointers[ aRowIndex ];
+            return ( tFound - tBegin ) + tPointers[ aRowIndex ];
         }
         else
         {
@@ -1049,6 +1431,7 @@ namespace belfem
 
 //----------------------------------------------------------------------------
 
+    template< typename I >
     index_t
     SpMatrix::index_csc_zero_based(
             const index_t & aRowIndex,
@@ -1057,16 +1440,19 @@ namespace belfem
         BELFEM_ASSERT( aRowIndex < ( index_t ) mNumRows, "aRowIndex out of bounds" );
         BELFEM_ASSERT( aColIndex < ( index_t ) mNumCols, "aColIndex out of bounds" );
 
-        auto tBegin = mRows + mPointers[ aColIndex ];
+        const I * tPointers = select_container< I >( mPointers, mLongPointers );
+        const I * tRows     = select_container< I >( mRows, mLongRows );
+
+        auto tBegin = tRows + tPointers[ aColIndex ];
 
-        auto tEnd   = mRows + mPointers[ aColIndex+1 ];
+        auto tEnd   = tRows + tPointers[ aColIndex+1 ];
 
         // find position in memory
         auto tFound = std::find( tBegin, tEnd, aRowIndex );
 
         if( tFound < tEnd )
         {
-            return ( tFound - tBegin ) + mPointers[ aColIndex ];
+            return ( tFound - tBegin ) + tPointers[ aColIndex ];
         }
         else
         {
@@ -1076,6 +1462,7 @@ namespace belfem
 
 //----------------------------------------------------------------------------
 
+    template< typename I >
     index_t
     SpMatrix::index_csr_one_based(
             const index_t & aRowIndex,
@@ -1084,16 +1471,19 @@ namespace belfem
         BELFEM_ASSERT( aRowIndex < ( index_t ) mNumRows, "aRowIndex out of bounds" );
         BELFEM_ASSERT( aColIndex < ( index_t ) mNumCols, "aColIndex out of bounds" );
 
-        auto tBegin = mColumns + mPointers[ aRowIndex ] - 1;
+        const I * tPointers = select_container< I >( mPointers, mLongPointers );
+        const I * tColumns  = select_container< I >( mColumns, mLongColumns );
 
-        auto tEnd   = mColumns + mPointers[ aRowIndex+1 ] - 1;
+        auto tBegin = tColumns + tPointers[ aRowIndex ] - 1;
+
+        auto tEnd   = tColumns + tPointers[ aRowIndex+1 ] - 1;
 
         // find position in memory
         auto tFound = std::find( tBegin, tEnd, aColIndex+1 );
 
         if( tFound < tEnd )
         {
-            return ( tFound - tBegin ) + mPointers[ aRowIndex ] - 1;
+            return ( tFound - tBegin ) + tPointers[ aRowIndex ] - 1;
         }
         else
         {
@@ -1103,6 +1493,7 @@ namespace belfem
 
 //----------------------------------------------------------------------------
 
+    template< typename I >
     index_t
     SpMatrix::index_csc_one_based(
             const index_t & aRowIndex,
@@ -1111,9 +1502,12 @@ namespace belfem
         BELFEM_ASSERT( aRowIndex < ( index_t ) mNumRows, "aRowIndex out of bounds" );
         BELFEM_ASSERT( aColIndex < ( index_t ) mNumCols, "aColIndex out of bounds" );
 
-        auto tBegin = mRows + mPointers[ aColIndex ] - 1;
+        const I * tPointers = select_container< I >( mPointers, mLongPointers );
+        const I * tRows     = select_container< I >( mRows, mLongRows );
+
+        auto tBegin = tRows + tPointers[ aColIndex ] - 1;
 
-        auto tEnd   = mRows + mPointers[ aColIndex+1 ] - 1;
+        auto tEnd   = tRows + tPointers[ aColIndex+1 ] - 1;
 
         // find position in memory
         auto tFound = std::find( tBegin, tEnd, aRowIndex+1 );
@@ -1121,7 +1515,7 @@ namespace belfem
 
         if( tFound < tEnd )
         {
-            return ( tFound-tBegin ) + mPointers[ aColIndex ] - 1;
+            return ( tFound-tBegin ) + tPointers[ aColIndex ] - 1;
         }
         else
         {
@@ -1160,67 +1554,64 @@ namespace belfem
                       ( long unsigned int ) aY.length(),
                       ( long unsigned int ) tLengthY );
 
-        int  tOne   = 1;
-
-        // Bugfix see Issue #3
-        this->set_indexing_base( SpMatrixIndexingBase::Fortran );
-
-#ifdef BELFEM_NETLIB
-        int  tTransposedFlag  = ( aTransposedFlag ) ? 1 : 0 ;
-
-        int tParameters[ 5 ] = { 0, 0, 0, 0, 1 };
+        // the kernels work in both indexing bases,
+        // so the index arrays are left untouched
+        if( mIndexType == SpMatrixIndexType::Int64 )
+        {
+            this->spmv( mLongPointers, mLongRows, mLongColumns, tLengthX, tLengthY,
+                        aX.data(), aY.data(), aAlpha, aBeta, aTransposedFlag );
+        }
+        else
+        {
+            this->spmv( mPointers, mRows, mColumns, tLengthX, tLengthY,
+                        aX.data(), aY.data(), aAlpha, aBeta, aTransposedFlag );
+        }
+    }
 
-        // indexing base, zero or one-based
-        tParameters[ 3 ] = mPointers[ 0 ] ;
+//------------------------------------------------------------------------------
 
+    template< typename I >
+    void
+    SpMatrix::spmv(
+            const I    * aPointers,
+            const I    * aRows,
+            const I    * aColumns,
+            const int    aLengthX,
+            const int    aLengthY,
+            const real * aX,
+                  real * aY,
+            const real   aAlpha,
+            const real   aBeta,
+            const bool   aTransposedFlag ) const
+    {
         switch( mType )
         {
-            case( SpMatrixType::CSC ) :
+            case( SpMatrixType::CSR ) :
             {
-                // call fspblas
-                dcscmm_(
-                        &tTransposedFlag,
-                        &mNumRows,
-                        &tOne,
-                        &mNumCols,
-                        &aAlpha,
-                        tParameters,
-                        mValues,
-                        mRows,
-                        mPointers,
-                        mPointers+1,
-                        aX.data(),
-                        &tLengthX,
-                        &aBeta,
-                        aY.data(),
-                        &tLengthY,
-                        mSwap,
-                        &mSwapSize
-                );
+                if( aTransposedFlag )
+                {
+                    this->spmv_scatter( aPointers, aColumns, aLengthX, aLengthY,
+                                        aX, aY, aAlpha, aBeta );
+                }
+                else
+                {
+                    this->spmv_gather( aPointers, aColumns, aLengthY,
+                                       aX, aY, aAlpha, aBeta );
+                }
                 break;
             }
-            case( SpMatrixType::CSR ) :
+            case( SpMatrixType::CSC ) :
             {
-                // call fspblas
-                dcsrmm_(
-                        &tTransposedFlag,
-                        &mNumRows,
-                        &tOne,
-                        &mNumCols,
-                        &aAlpha,
-                        tParameters,
-                        mValues,
-                        mColumns,
-                        mPointers,
-                        mPointers+1,
-                        aX.data(),
-                        &tLengthX,
-                        &aBeta,
-                        aY.data(),
-                        &tLengthY,
-                        mSwap,
-                        &mSwapSize
-                );
+                if( aTransposedFlag )
+                {
+                    this->spmv_gather( aPointers, aRows, aLengthY,
+                                       aX, aY, aAlpha, aBeta );
+                }
+                else
+                {
+                    this->spmv_scatter( aPointers, aRows, aLengthX, aLengthY,
+                                        aX, aY, aAlpha, aBeta );
+                }
                 break;
             }
             default :
@@ -1229,70 +1620,290 @@ namespace belfem
                 break;
             }
         }
-#elif BELFEM_MKL
-        char tParameters[] = { 'G', ' ', 'N', 'C' };
+    }
 
-        if(  mPointers[ 0 ] == 1 )
+//------------------------------------------------------------------------------
+
+    void
+    SpMatrix::multiply(
+            const Matrix< real > & aX,
+                  Matrix< real > & aY,
+            const real aAlpha,
+            const real aBeta,
+            const bool aTransposedFlag )
+    {
+        int tLengthX = aTransposedFlag ? mNumRows : mNumCols ;
+        int tLengthY = aTransposedFlag ? mNumCols : mNumRows ;
+
+        int tNumVectors = aX.n_cols() ;
+
+        BELFEM_ASSERT( (index_t) tLengthX == (index_t) aX.n_rows(),
+                       "Number of rows and cols of matrices do not match ( %lu and %lu ).",
+                       ( long unsigned int ) tLengthX,
+                       ( long unsigned int ) aX.n_rows() );
+
+        BELFEM_ASSERT( (index_t) aY.n_rows() == ( index_t ) tLengthY
+                        && aY.n_cols() == aX.n_cols(),
+                       "Dimension of output matrix does not match ( is %lu x %lu, but should be %lu x %lu )",
+                       ( long unsigned int ) aY.n_rows(),
+                       ( long unsigned int ) aY.n_cols(),
+                       ( long unsigned int ) tLengthY,
+                       ( long unsigned int ) aX.n_cols() );
+
+        // data must be stored column wise for the kernels
+#ifdef BELFEM_ARMADILLO
+        const real * tX = aX.data() ;
+              real * tY = aY.data() ;
+#else
+        Vector< real > tXData( tLengthX * tNumVectors );
+        Vector< real > tYData( tLengthY * tNumVectors );
+        for( int c=0; c<tNumVectors; ++c )
         {
-            tParameters[ 3 ] = 'F';
+            for( int i=0; i<tLengthX; ++i )
+            {
+                tXData( c * tLengthX + i ) = aX( i, c );
+            }
+            for( int i=0; i<tLengthY; ++i )
+            {
+                tYData( c * tLengthY + i ) = aY( i, c );
+            }
         }
+        const real * tX = tXData.data() ;
+              real * tY = tYData.data() ;
+#endif
 
-        char tTransposedFlag = ( aTransposedFlag ) ? 'Y' : 'N' ;
+        if( mIndexType == SpMatrixIndexType::Int64 )
+        {
+            this->spmm( mLongPointers, this->long_indices(), tLengthX, tLengthY, tNumVectors,
+                        tX, tY, aAlpha, aBeta, aTransposedFlag );
+        }
+        else
+        {
+            this->spmm( mPointers, this->indices(), tLengthX, tLengthY, tNumVectors,
+                        tX, tY, aAlpha, aBeta, aTransposedFlag );
+        }
 
-        switch( mType )
+#ifndef BELFEM_ARMADILLO
+        for( int c=0; c<tNumVectors; ++c )
         {
-            case( SpMatrixType::CSC ) :
+            for( int i=0; i<tLengthY; ++i )
             {
-                // call mkl
-                mkl_dcscmm_(
-                        &tTransposedFlag,
-                        &mNumRows,
-                        &tOne,
-                        &mNumCols,
-                        &aAlpha,
-                        tParameters,
-                        mValues,
-                        mRows,
-                        mPointers,
-                        mPointers+1,
-                        aX.data(),
-                        &tLengthX,
-                        &aBeta,
-                        aY.data(),
-                        &tLengthY
-                );
-                break;
+                aY( i, c ) = tYData( c * tLengthY + i );
             }
-            case( SpMatrixType::CSR ) :
+        }
+#endif
+    }
+
+//------------------------------------------------------------------------------
+
+    template< typename I >
+    void
+    SpMatrix::spmm(
+            const I    * aPointers,
+            const I    * aIndices,
+            const int    aLengthX,
+            const int    aLengthY,
+            const int    aNumVectors,
+            const real * aX,
+                  real * aY,
+            const real   aAlpha,
+            const real   aBeta,
+            const bool   aTransposedFlag ) const
+    {
+        // rows of the storage run along Y
+        if( ( mType == SpMatrixType::CSR ) != aTransposedFlag )
+        {
+            this->spmm_gather( aPointers, aIndices, aLengthX, aLengthY, aNumVectors,
+                               aX, aY, aAlpha, aBeta );
+        }
+        else
+        {
+            for( int c=0; c<aNumVectors; ++c )
             {
-                // call mkl
-                mkl_dcsrmm_(
-                        &tTransposedFlag,
-                        &mNumRows,
-                        &tOne,
-                        &mNumCols,
-                        &aAlpha,
-                        tParameters,
-                        mValues,
-                        mColumns,
-                        mPointers,
-                        mPointers+1,
-                        aX.data(),
-                        &tLengthX,
-                        &aBeta,
-                        aY.data(),
-                        &tLengthY
-                );
-                break;
+                this->spmv_scatter( aPointers, aIndices, aLengthX, aLengthY,
+                                    aX + c * aLengthX, aY + c * aLengthY, aAlpha, aBeta );
             }
-            default :
+        }
+    }
+
+//------------------------------------------------------------------------------
+
+    template< typename I >
+    void
+    SpMatrix::spmv_gather(
+            const I    * aPointers,
+            const I    * aIndices,
+            const int    aLengthY,
+            const real * aX,
+                  real * aY,
+            const real   aAlpha,
+            const real   aBeta ) const
+    {
+        // offset for one-based indexing
+        const I tBase = aPointers[ 0 ];
+
+        // each output row is written by exactly one thread
+#ifdef OMP
+        #pragma omp parallel for schedule( static ) if( ( index_t ) aLengthY > gSpMVParallelLimit )
+#endif
+        for( int i=0; i<aLengthY; ++i )
+        {
+            real tSum = 0.0 ;
+
+            const I tBegin = aPointers[ i ] - tBase ;
+            const I tEnd   = aPointers[ i + 1 ] - tBase ;
+
+#ifdef OMP
+            #pragma omp simd reduction( + : tSum )
+#endif
+            for( I k=tBegin; k<tEnd; ++k )
             {
-                BELFEM_ERROR( false, "Unsupported matrix type.");
+                tSum += mValues[ k ] * aX[ aIndices[ k ] - tBase ];
+            }
+
+            aY[ i ] = aBeta == 0.0 ? aAlpha * tSum : aAlpha * tSum + aBeta * aY[ i ];
+        }
+    }
+
+//------------------------------------------------------------------------------
+
+    template< typename I >
+    void
+    SpMatrix::spmm_gather(
+            const I    * aPointers,
+            const I    * aIndices,
+            const int    aLengthX,
+            const int    aLengthY,
+            const int    aNumVectors,
+            const real * aX,
+                  real * aY,
+            const real   aAlpha,
+            const real   aBeta ) const
+    {
+        // offset for one-based indexing
+        const I tBase = aPointers[ 0 ];
+
+#ifdef OMP
+        #pragma omp parallel for schedule( static ) if( ( index_t ) aLengthY > gSpMVParallelLimit )
+#endif
+        for( int i=0; i<aLengthY; ++i )
+        {
+            const I tBegin = aPointers[ i ] - tBase ;
+            const I tEnd   = aPointers[ i + 1 ] - tBase ;
+
+            // the matrix row is loaded once for all vectors
+            for( int c=0; c<aNumVectors; ++c )
+            {
+                const real * tX = aX + c * aLengthX ;
+
+                real tSum = 0.0 ;
+
+#ifdef OMP
+                #pragma omp simd reduction( + : tSum )
+#endif
+                for( I k=tBegin; k<tEnd; ++k )
+                {
+                    tSum += mValues[ k ] * tX[ aIndices[ k ] - tBase ];
+                }
+
+                real & tY = aY[ c * aLengthY + i ];
+
+                tY = aBeta == 0.0 ? aAlpha * tSum : aAlpha * tSum + aBeta * tY ;
+            }
+        }
+    }
+
+//------------------------------------------------------------------------------
+
+    template< typename I >
+    void
+    SpMatrix::spmv_scatter(
+            const I    * aPointers,
+            const I    * aIndices,
+            const int    aLengthX,
+            const int    aLengthY,
+            const real * aX,
+                  real * aY,
+            const real   aAlpha,
+            const real   aBeta ) const
+    {
+        // offset for one-based indexing
+        const I tBase = aPointers[ 0 ];
+
+        // scale the output
+        if( aBeta == 0.0 )
+        {
+            std::fill_n( aY, aLengthY, 0.0 );
+        }
+        else if ( aBeta != 1.0 )
+        {
+            for( int i=0; i<aLengthY; ++i )
+            {
+                aY[ i ] *= aBeta ;
+            }
+        }
+
+#ifdef OMP
+        const int tNumThreads = max_number_of_threads() ;
+
+        if( tNumThreads > 1 && ( index_t ) aLengthX > gSpMVParallelLimit )
+        {
+            // several columns write into the same row,
+            // so each thread gets its own output buffer
+            const index_t tWorkSize = tNumThreads * aLengthY ;
+            if( mScatterWork.length() < tWorkSize )
+            {
+                mScatterWork.set_size( tWorkSize );
+            }
+            real * tWorkData = mScatterWork.data() ;
+
+            #pragma omp parallel num_threads( tNumThreads )
+            {
+                real * tY = tWorkData + thread_index() * aLengthY ;
+                std::fill_n( tY, aLengthY, 0.0 );
+
+                #pragma omp for schedule( static )
+                for( int j=0; j<aLengthX; ++j )
+                {
+                    const real tX = aAlpha * aX[ j ];
+
+                    const I tEnd = aPointers[ j + 1 ] - tBase ;
+
+                    for( I k=aPointers[ j ] - tBase; k<tEnd; ++k )
+                    {
+                        tY[ aIndices[ k ] - tBase ] += mValues[ k ] * tX ;
+                    }
+                }
+
+                // implicit barrier, then reduce the buffers
+                #pragma omp for schedule( static )
+                for( int i=0; i<aLengthY; ++i )
+                {
+                    real tSum = 0.0 ;
+                    for( int t=0; t<tNumThreads; ++t )
+                    {
+                        tSum += tWorkData[ t * aLengthY + i ];
+                    }
+                    aY[ i ] += tSum ;
+                }
             }
+            return;
         }
 #endif
+        for( int j=0; j<aLengthX; ++j )
+        {
+            const real tX = aAlpha * aX[ j ];
+
+            const I tEnd = aPointers[ j + 1 ] - tBase ;
+
+            for( I k=aPointers[ j ] - tBase; k<tEnd; ++k )
+            {
+                aY[ aIndices[ k ] - tBase ] += mValues[ k ] * tX ;
+            }
+        }
     }
 
+//------------------------------------------------------------------------------
 
     /**
      * copy operator
@@ -1320,44 +1931,31 @@ namespace belfem
         }
 
         // set number of nonzeros
-        mNumNonZeros = aMatrix.number_of_nonzeros();
+        mNumNonZeros = aMatrix.mNumNonZeros;
 
-        // copy pointers
-        mPointers = ( int * ) malloc( ( mPointerSize ) * sizeof( int ) );
-        std::memcpy( mPointers, aMatrix.pointers(), ( mPointerSize ) * sizeof( int ) );
-
-        // copy cols
-        if( aMatrix.rows() != NULL )
-        {
-            mRows = ( int * ) malloc( mNumNonZeros * sizeof( int ) );
-            std::memcpy( mRows, aMatrix.rows(), mNumNonZeros * sizeof( int ) );
-        }
-        else
-        {
-            mRows = nullptr;
-        }
+        // copy pointers and indices
+        mIndexType = aMatrix.index_type();
 
-        // copy cols
-        if( aMatrix.cols() != NULL )
+        if( mIndexType == SpMatrixIndexType::Int64 )
         {
-            mColumns = ( int * ) malloc( mNumNonZeros * sizeof( int ) );
-            std::memcpy( mColumns, aMatrix.cols(), mNumNonZeros * sizeof( int ) );
+            mLongPointers = copy_container( aMatrix.mLongPointers, mPointerSize );
+            mLongRows     = copy_container( aMatrix.mLongRows, mNumNonZeros );
+            mLongColumns  = copy_container( aMatrix.mLongColumns, mNumNonZeros );
         }
         else
         {
-            mColumns = nullptr;
+            mPointers = copy_container( aMatrix.mPointers, mPointerSize );
+            mRows     = copy_container( aMatrix.mRows, mNumNonZeros );
+            mColumns  = copy_container( aMatrix.mColumns, mNumNonZeros );
         }
 
         // copy data
         mValues = ( real * ) malloc( mNumNonZeros * sizeof( real ) ) ;
         std::memcpy( mValues, aMatrix.data(), mNumNonZeros * sizeof( real ) );
 
-#ifdef BELFEM_NETLIB
-        this->allocate_swap();
-#endif
 
         // link
-        if( mPointers[ 0 ] == 0 )
+        if( this->indexing_base() == 0 )
         {
             this->set_indexing_base( SpMatrixIndexingBase::Cpp );
         }
@@ -1385,6 +1983,14 @@ namespace belfem
             }
             mRows = std::move( mColumns );
             mColumns = nullptr;
+
+            if( mLongRows != nullptr )
+            {
+                free( mLongRows );
+            }
+            mLongRows = std::move( mLongColumns );
+            mLongColumns = nullptr;
+
             mType = SpMatrixType::CSR;
 
             mNumRows = tNumRows;
@@ -1398,6 +2004,14 @@ namespace belfem
             }
             mColumns = std::move( mRows );
             mRows = nullptr;
+
+            if( mLongColumns != nullptr )
+            {
+                free( mLongColumns );
+            }
+            mLongColumns = std::move( mLongRows );
+            mLongRows = nullptr;
+
             mType = SpMatrixType::CSC;
 
             mNumRows = tNumRows;
@@ -11,6 +11,7 @@
 #include "cl_Cell.hpp"
 #include "cl_Graph_Vertex.hpp"
 #include "cl_Vector.hpp"
+#include "cl_Matrix.hpp"
 #include "filetools.hpp"
 #include "HDF5_Tools.hpp"
 
@@ -33,6 +34,19 @@ namespace belfem
         Fortran    = 1
     };
 
+//------------------------------------------------------------------------------
+
+    /**
+     * integer type of the pointers and indices. 32-bit indices are
+     * faster, 64-bit indices are needed for more than 2^31 nonzeros.
+     */
+    enum class SpMatrixIndexType
+    {
+        Int32      = 0,
+        Int64      = 1,
+        UNDEFINED  = 2
+    };
+
 //------------------------------------------------------------------------------
 
     class SpMatrix
@@ -44,12 +58,15 @@ namespace belfem
         // type of matrix, CSC or CSR
         SpMatrixType mType;
 
+        // integer type of pointers and indices
+        SpMatrixIndexType mIndexType = SpMatrixIndexType::Int32 ;
+
         // size of matrix
         int mNumRows = 0;
         int mNumCols = 0;
 
         // number of nonzeros
-        int mNumNonZeros = 0;
+        lsint mNumNonZeros = 0;
 
         // container for pointers
         int * mPointers = nullptr;
@@ -61,17 +78,23 @@ namespace belfem
 
         int * mColumns = nullptr;
 
+        // containers for 64-bit indices, only used if mIndexType is Int64
+        lsint * mLongPointers = nullptr;
+
+        lsint * mLongRows = nullptr;
+
+        lsint * mLongColumns = nullptr;
+
         // values array
         real * mValues = nullptr;
 
-#ifdef BELFEM_NETLIB
-        real * mSwap = nullptr;
-        int mSwapSize = 0;
-#endif
-
         // pointer with zero value
         real mZero = 0.0;
 
+        // per thread output buffers of the threaded scatter product,
+        // allocated by the first product that needs them
+        mutable Vector< real > mScatterWork ;
+
         // function that finds the position in the array
         index_t
         ( SpMatrix:: * mIndexFunction )(
@@ -91,7 +114,8 @@ namespace belfem
         SpMatrix( Cell<graph::Vertex *> & aGraph,
                   const enum SpMatrixType aType = SpMatrixType::CSC,
                           const index_t   aNumRows = 0,
-                          const index_t   aNumCols = 0);
+                          const index_t   aNumCols = 0,
+                  const SpMatrixIndexType aIndexType = SpMatrixIndexType::Int32 );
 
 //------------------------------------------------------------------------------
 
@@ -103,6 +127,29 @@ namespace belfem
         // constructor for testing purposes using dense Matrix
         SpMatrix( const Matrix< real > & aMatrix, const SpMatrixType aType = SpMatrixType::CSC );
 
+//------------------------------------------------------------------------------
+
+        /**
+         * graph free constructor. The pattern is the union of the blocks
+         * rows( e ) x cols( e ) of all elements e. The entries of element e
+         * are stored from aOffsets( e ) to aOffsets( e+1 ), row or column
+         * indices with gNoIndex are skipped.
+         *
+         * @param aOffsets     element offsets, one more entry than elements
+         * @param aRowIndices  row index of each element entry
+         * @param aColIndices  column index of each element entry
+         * @param aNumThreads  threads for the symbolic phase, 0 means all
+         * @param aIndexType   integer type of pointers and indices
+         */
+        SpMatrix( const Vector< index_t > & aOffsets,
+                  const Vector< index_t > & aRowIndices,
+                  const Vector< index_t > & aColIndices,
+                  const enum SpMatrixType   aType,
+                  const index_t             aNumRows,
+                  const index_t             aNumCols,
+                  const uint                aNumThreads = 1,
+                  const SpMatrixIndexType   aIndexType = SpMatrixIndexType::Int32 );
+
 //------------------------------------------------------------------------------
 
         ~SpMatrix();
@@ -117,6 +164,14 @@ namespace belfem
         const SpMatrixType &
         type() const;
 
+//------------------------------------------------------------------------------
+
+        /**
+         * return the integer type of pointers and indices
+         */
+        SpMatrixIndexType
+        index_type() const;
+
 //------------------------------------------------------------------------------
 
         /**
@@ -152,7 +207,7 @@ namespace belfem
 //------------------------------------------------------------------------------
 
         /**
-         * expose the pointers
+         * expose the pointers ( Int32 only )
          */
         int *
         pointers();
@@ -213,6 +268,54 @@ namespace belfem
         const int *
         cols() const;
 
+//------------------------------------------------------------------------------
+
+        /**
+         * expose the pointers ( Int64 only )
+         */
+        lsint *
+        long_pointers();
+
+//------------------------------------------------------------------------------
+
+        /**
+         * expose the pointers ( Int64 only, const version )
+         */
+        const lsint *
+        long_pointers() const;
+
+//------------------------------------------------------------------------------
+
+        /**
+         * expose the index array ( Int64 only )
+         */
+        lsint *
+        long_indices();
+
+//------------------------------------------------------------------------------
+
+        /**
+         * expose the index array ( Int64 only, const version )
+         */
+        const lsint *
+        long_indices() const;
+
+//------------------------------------------------------------------------------
+
+        /**
+         * expose the row indices ( Int64 only )
+         */
+        lsint *
+        long_rows();
+
+//------------------------------------------------------------------------------
+
+        /**
+         * expose the col indices ( Int64 only )
+         */
+        lsint *
+        long_cols();
+
 //------------------------------------------------------------------------------
 
         /**
@@ -251,10 +354,26 @@ namespace belfem
         /*
          * get the index of a specific row and col
          * */
-        int
+        index_t
         index( const index_t & aRowIndex,
                const index_t & aColIndex ) const;
 
+//------------------------------------------------------------------------------
+
+        /**
+         * add a dense element matrix using a precomputed table of
+         * positions in the data container. The table is stored
+         * column wise, entries with gNoIndex are skipped.
+         *
+         * @param aTable   positions of the entries, see index()
+         * @param aValues  the element matrix
+         * @param aScale   scaling factor for the values
+         */
+        void
+        scatter_add( const Vector< index_t > & aTable,
+                     const Matrix< real >    & aValues,
+                     const real                aScale=1.0 );
+
 //------------------------------------------------------------------------------
 // Utilities
 //------------------------------------------------------------------------------
@@ -322,6 +441,21 @@ namespace belfem
                   const real aBeta  = 0.0,
                   const bool aTransposedFlag=false );
 
+//------------------------------------------------------------------------------
+
+        /**
+         * performs a matrix-matrix multiplication
+         * Y = alpha * A * X + beta * Y, where X and Y are dense
+         *
+         * @param aX
+         * @param aY
+         */
+        void
+        multiply( const Matrix< real > & aX,
+                        Matrix< real > & aY,
+                  const real aAlpha = 1.0,
+                  const real aBeta  = 0.0,
+                  const bool aTransposedFlag=false );
 //------------------------------------------------------------------------------
 
         void
@@ -374,6 +508,14 @@ namespace belfem
         load(   hid_t        & aGroup,
                 herr_t       & aStatus );
 
+//------------------------------------------------------------------------------
+
+        /**
+         * hash of the size, pointers and indices, the values are ignored
+         */
+        luint
+        pattern_hash() const;
+
 
 //------------------------------------------------------------------------------
 // Operators
@@ -424,13 +566,54 @@ namespace belfem
 
 //------------------------------------------------------------------------------
 
+        template< typename I >
+        void
+        create_csr_indices( Cell<graph::Vertex *> & aGraph,
+                            I                    *& aPointers,
+                            I                    *& aColumns );
+
+//------------------------------------------------------------------------------
+
+        template< typename I >
         void
-        create_csr_indices( Cell<graph::Vertex *> & aGraph );
+        create_csc_indices( Cell<graph::Vertex *> & aGraph,
+                            I                    *& aPointers,
+                            I                    *& aRows );
 
 //------------------------------------------------------------------------------
 
+        /**
+         * two pass count and fill of the pointers and indices from
+         * element tables. Major is the index the pointers run along,
+         * ie. rows for CSR and columns for CSC.
+         */
+        template< typename I >
         void
-        create_csc_indices( Cell<graph::Vertex *> & aGraph );
+        create_indices_from_elements(
+                const Vector< index_t > & aOffsets,
+                const Vector< index_t > & aMajor,
+                const Vector< index_t > & aMinor,
+                const index_t             aNumMajor,
+                const uint                aNumThreads,
+                I                      *& aPointers,
+                I                      *& aIndices );
+
+//------------------------------------------------------------------------------
+
+        /**
+         * write the sorted and unique minor indices of all elements
+         * that are connected to a major index into the buffer.
+         * Returns the number of indices.
+         */
+        template< typename I >
+        index_t
+        collect_element_indices(
+                const index_t             aMajor,
+                const Vector< index_t > & aElementPointers,
+                const Vector< index_t > & aElements,
+                const Vector< index_t > & aOffsets,
+                const Vector< index_t > & aMinor,
+                I                       * aBuffer ) const ;
 
 //------------------------------------------------------------------------------
 
@@ -443,7 +626,7 @@ namespace belfem
                 const index_t aNumCols );
 
         void
-        set_nnz( const index_t aNumberOfNonzeros );
+        set_nnz( const luint aNumberOfNonzeros );
 
 //------------------------------------------------------------------------------
 
@@ -463,18 +646,125 @@ namespace belfem
 
 //------------------------------------------------------------------------------
 
-#ifdef BELFEM_NETLIB
         /**
-         * allocate swap vector
+         * add a value to all pointers and indices
          */
+        template< typename I >
         void
-        allocate_swap();
-#endif
+        shift_indices( I * aPointers, I * aRows, I * aColumns, const I aShift );
+
+//------------------------------------------------------------------------------
+
+        /**
+         * populate the missing coordinate indices
+         */
+        template< typename I >
+        void
+        create_coo_indices( const I * aPointers,
+                            const int aNumMajor,
+                            I      *& aIndices );
+
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Multiplication kernels
+//------------------------------------------------------------------------------
+
+        /**
+         * y = alpha * A * x + beta * y for a compressed storage where the
+         * pointers run along y ( CSR, or transposed CSC ).
+         * Works for both indexing bases.
+         */
+        template< typename I >
+        void
+        spmv_gather(
+                const I    * aPointers,
+                const I    * aIndices,
+                const int    aLengthY,
+                const real * aX,
+                      real * aY,
+                const real   aAlpha,
+                const real   aBeta ) const ;
+
+//------------------------------------------------------------------------------
+
+        /**
+         * multi vector version of spmv_gather. X and Y are stored column wise
+         * with the leading dimensions aLengthX and aLengthY
+         */
+        template< typename I >
+        void
+        spmm_gather(
+                const I    * aPointers,
+                const I    * aIndices,
+                const int    aLengthX,
+                const int    aLengthY,
+                const int    aNumVectors,
+                const real * aX,
+                      real * aY,
+                const real   aAlpha,
+                const real   aBeta ) const ;
+//------------------------------------------------------------------------------
+
+        /**
+         * y = alpha * A * x + beta * y for a compressed storage where the
+         * pointers run along x ( CSC, or transposed CSR ).
+         * Works for both indexing bases.
+         */
+        template< typename I >
+        void
+        spmv_scatter(
+                const I    * aPointers,
+                const I    * aIndices,
+                const int    aLengthX,
+                const int    aLengthY,
+                const real * aX,
+                      real * aY,
+                const real   aAlpha,
+                const real   aBeta ) const ;
+
+//------------------------------------------------------------------------------
+
+        /**
+         * select the kernel for y = alpha * A * x + beta * y
+         */
+        template< typename I >
+        void
+        spmv( const I    * aPointers,
+              const I    * aRows,
+              const I    * aColumns,
+              const int    aLengthX,
+              const int    aLengthY,
+              const real * aX,
+                    real * aY,
+              const real   aAlpha,
+              const real   aBeta,
+              const bool   aTransposedFlag ) const ;
+
+//------------------------------------------------------------------------------
+
+        /**
+         * select the kernel for Y = alpha * A * X + beta * Y,
+         * X and Y are stored column wise
+         */
+        template< typename I >
+        void
+        spmm( const I    * aPointers,
+              const I    * aIndices,
+              const int    aLengthX,
+              const int    aLengthY,
+              const int    aNumVectors,
+              const real * aX,
+                    real * aY,
+              const real   aAlpha,
+              const real   aBeta,
+              const bool   aTransposedFlag ) const ;
 
 //------------------------------------------------------------------------------
 // Indexing
 //------------------------------------------------------------------------------
 
+        template< typename I >
         index_t
         index_csr_zero_based (
                 const index_t & aRowIndex,
@@ -482,6 +772,7 @@ namespace belfem
 
 //------------------------------------------------------------------------------
 
+        template< typename I >
         index_t
         index_csc_zero_based (
                 const index_t & aRowIndex,
@@ -489,6 +780,7 @@ namespace belfem
 
 //------------------------------------------------------------------------------
 
+        template< typename I >
         index_t
         index_csr_one_based (
                 const index_t & aRowIndex,
@@ -496,6 +788,7 @@ namespace belfem
 
 //------------------------------------------------------------------------------
 
+        template< typename I >
         index_t
         index_csc_one_based (
                 const index_t & aRowIndex,
@@ -545,6 +838,14 @@ namespace belfem
         return ( index_t ) mNumCols;
     }
 
+//------------------------------------------------------------------------------
+
+    inline SpMatrixIndexType
+    SpMatrix::index_type() const
+    {
+        return mIndexType;
+    }
+
 //------------------------------------------------------------------------------
 
     inline index_t
@@ -558,6 +859,9 @@ namespace belfem
     inline int *
     SpMatrix::indices()
     {
+        BELFEM_ASSERT( mIndexType == SpMatrixIndexType::Int32,
+                       "matrix uses 64-bit indices" );
+
         if( mType == SpMatrixType::CSC )
         {
             return mRows;
@@ -577,6 +881,9 @@ namespace belfem
     inline const int *
     SpMatrix::indices() const
     {
+        BELFEM_ASSERT( mIndexType == SpMatrixIndexType::Int32,
+                       "matrix uses 64-bit indices" );
+
         if( mType == SpMatrixType::CSC )
         {
             return mRows;
@@ -596,6 +903,9 @@ namespace belfem
     inline int *
     SpMatrix::rows()
     {
+        BELFEM_ASSERT( mIndexType == SpMatrixIndexType::Int32,
+                       "matrix uses 64-bit indices" );
+
         return mRows;
     }
 
@@ -604,6 +914,9 @@ namespace belfem
     inline const int *
     SpMatrix::rows() const
     {
+        BELFEM_ASSERT( mIndexType == SpMatrixIndexType::Int32,
+                       "matrix uses 64-bit indices" );
+
         return mRows;
     }
 
@@ -612,6 +925,9 @@ namespace belfem
     inline int *
     SpMatrix::cols()
     {
+        BELFEM_ASSERT( mIndexType == SpMatrixIndexType::Int32,
+                       "matrix uses 64-bit indices" );
+
         return mColumns;
     }
 
@@ -620,6 +936,9 @@ namespace belfem
     inline const int *
     SpMatrix::cols() const
     {
+        BELFEM_ASSERT( mIndexType == SpMatrixIndexType::Int32,
+                       "matrix uses 64-bit indices" );
+
         return mColumns;
     }
 
@@ -628,6 +947,9 @@ namespace belfem
     inline int *
     SpMatrix::pointers()
     {
+        BELFEM_ASSERT( mIndexType == SpMatrixIndexType::Int32,
+                       "matrix uses 64-bit indices" );
+
         return mPointers;
     }
 
@@ -636,9 +958,78 @@ namespace belfem
     const inline int *
     SpMatrix::pointers() const
     {
+        BELFEM_ASSERT( mIndexType == SpMatrixIndexType::Int32,
+                       "matrix uses 64-bit indices" );
+
         return mPointers;
     }
 
+//------------------------------------------------------------------------------
+
+    inline lsint *
+    SpMatrix::long_pointers()
+    {
+        BELFEM_ASSERT( mIndexType == SpMatrixIndexType::Int64,
+                       "matrix uses 32-bit indices" );
+
+        return mLongPointers;
+    }
+
+//------------------------------------------------------------------------------
+
+    inline const lsint *
+    SpMatrix::long_pointers() const
+    {
+        BELFEM_ASSERT( mIndexType == SpMatrixIndexType::Int64,
+                       "matrix uses 32-bit indices" );
+
+        return mLongPointers;
+    }
+
+//------------------------------------------------------------------------------
+
+    inline lsint *
+    SpMatrix::long_indices()
+    {
+        BELFEM_ASSERT( mIndexType == SpMatrixIndexType::Int64,
+                       "matrix uses 32-bit indices" );
+
+        return mType == SpMatrixType::CSC ? mLongRows : mLongColumns ;
+    }
+
+//------------------------------------------------------------------------------
+
+    inline const lsint *
+    SpMatrix::long_indices() const
+    {
+        BELFEM_ASSERT( mIndexType == SpMatrixIndexType::Int64,
+                       "matrix uses 32-bit indices" );
+
+        return mType == SpMatrixType::CSC ? mLongRows : mLongColumns ;
+    }
+
+//------------------------------------------------------------------------------
+
+    inline lsint *
+    SpMatrix::long_rows()
+    {
+        BELFEM_ASSERT( mIndexType == SpMatrixIndexType::Int64,
+                       "matrix uses 32-bit indices" );
+
+        return mLongRows;
+    }
+
+//------------------------------------------------------------------------------
+
+    inline lsint *
+    SpMatrix::long_cols()
+    {
+        BELFEM_ASSERT( mIndexType == SpMatrixIndexType::Int64,
+                       "matrix uses 32-bit indices" );
+
+        return mLongColumns;
+    }
+
 //------------------------------------------------------------------------------
 
     inline real *
@@ -686,17 +1077,54 @@ namespace belfem
     inline int
     SpMatrix::indexing_base() const
     {
-        return mPointers[ 0 ];
+        return mIndexType == SpMatrixIndexType::Int64 ?
+            ( int ) mLongPointers[ 0 ] : mPointers[ 0 ];
     }
 
 //------------------------------------------------------------------------------
 
-    inline int
+    inline index_t
     SpMatrix::index( const index_t & aRowIndex, const index_t & aColIndex ) const
     {
         return ( this->*mIndexFunction )( aRowIndex, aColIndex );
     }
 
+//------------------------------------------------------------------------------
+
+    inline void
+    SpMatrix::scatter_add(
+            const Vector< index_t > & aTable,
+            const Matrix< real >    & aValues,
+            const real                aScale )
+    {
+        const index_t tNumRows = aValues.n_rows() ;
+        const index_t tNumCols = aValues.n_cols() ;
+
+        BELFEM_ASSERT( aTable.length() == tNumRows * tNumCols,
+                       "Length of table does not match matrix dimensions ( is %u, expect %u )",
+                       ( unsigned int ) aTable.length(),
+                       ( unsigned int ) ( tNumRows * tNumCols ) );
+
+        index_t tCount = 0 ;
+
+        for( index_t j=0; j<tNumCols; ++j )
+        {
+            for( index_t i=0; i<tNumRows; ++i )
+            {
+                const index_t & tIndex = aTable( tCount++ );
+
+                if( tIndex != gNoIndex )
+                {
+                    BELFEM_ASSERT( tIndex < ( index_t ) mNumNonZeros,
+                                   "Invalid index in scatter table: %u",
+                                   ( unsigned int ) tIndex );
+
+                    mValues[ tIndex ] += aScale * aValues( i, j );
+                }
+            }
+        }
+    }
+
 //------------------------------------------------------------------------------
 
     /**
@@ -706,9 +1134,9 @@ namespace belfem
     SpMatrix::operator()( const index_t & aRowIndex,
                 const index_t & aColIndex )
     {
-        int tIndex = ( this->*mIndexFunction )( aRowIndex, aColIndex );
+        index_t tIndex = ( this->*mIndexFunction )( aRowIndex, aColIndex );
 
-        BELFEM_ASSERT( tIndex < mNumNonZeros, "tried to access zero value in writable mode( %u, %u )",
+        BELFEM_ASSERT( ( lsint ) tIndex < mNumNonZeros, "tried to access zero value in writable mode( %u, %u )",
                       ( unsigned int ) aRowIndex,
                       ( unsigned int ) aColIndex );
 
@@ -721,9 +1149,9 @@ namespace belfem
     SpMatrix::operator()( const index_t & aRowIndex,
                 const index_t & aColIndex ) const
     {
-        int tIndex = ( this->*mIndexFunction )( aRowIndex, aColIndex );
+        index_t tIndex = ( this->*mIndexFunction )( aRowIndex, aColIndex );
 
-        if( tIndex < mNumNonZeros )
+        if( ( lsint ) tIndex < mNumNonZeros )
         {
             return mValues[ tIndex ];
         }
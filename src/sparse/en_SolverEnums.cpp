@@ -33,6 +33,10 @@ namespace belfem
             {
                 return "PETSc" ;
             }
+            case( SolverType::KRYLOV ) :
+            {
+                return "Krylov" ;
+            }
             default:
             {
                 return "UNKNOWN" ;
@@ -67,6 +71,10 @@ namespace belfem
         {
             return SolverType::PETSC ;
         }
+        else if ( tString == "krylov" )
+        {
+            return SolverType::KRYLOV ;
+        }
         else
         {
             BELFEM_ERROR( false, "unknown solver: %s", aString.c_str() );
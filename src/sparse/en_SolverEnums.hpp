@@ -19,6 +19,7 @@ namespace belfem
         STRUMPACK,
         PARDISO,
         PETSC,
+        KRYLOV,
         UNDEFINED
     };
 
@@ -49,7 +50,7 @@ namespace belfem
 //------------------------------------------------------------------------------
 
     /**
-     * PETSC only
+     * PETSC and native Krylov solver
      */
     enum class Preconditioner
     {
@@ -71,7 +72,7 @@ namespace belfem
 //------------------------------------------------------------------------------
 
     /**
-     * PETSC only
+     * PETSC and native Krylov solver
      */
     enum class KrylovMethod
     {
@@ -28,6 +28,156 @@
 !>                       : 1 - full
 !>                       : 2 - main
 
+!------------------------------------------------------------------------------
+
+!> MUMPS instances that are kept between two calls, so that the analysis
+!> ( JOB=1 ) is done once and only the numeric factorization ( JOB=2 )
+!> and the solution ( JOB=3 ) are repeated
+module mumpstools_instances
+    use, intrinsic :: iso_c_binding
+    use, intrinsic :: iso_fortran_env, only : &
+            stdout=>output_unit, &
+            stderr=>error_unit
+    implicit none
+
+    include 'mpif.h'
+    include 'dmumps_struc.h'
+
+    !> maximum number of instances that can be kept at the same time
+    integer, parameter :: gMaxNumInstances = 16
+
+    !> the kept instances
+    type ( DMUMPS_STRUC ), dimension( gMaxNumInstances ), target, save :: gInstances
+
+    !> flags telling which instances are in use
+    logical, dimension( gMaxNumInstances ), save :: gIsUsed = .false.
+
+    !> rank of the host of each instance
+    integer, dimension( gMaxNumInstances ), save :: gMasterRank = 0
+
+contains
+
+!------------------------------------------------------------------------------
+
+    !> initialize MUMPS ( JOB=-1 )
+    subroutine mumpstools_initialize( aMUMPS, aIParameters )
+        type ( DMUMPS_STRUC ), intent( inout )             :: aMUMPS
+        integer( c_int ), intent( in ), dimension( 11 )    :: aIParameters
+
+        ! MPI status
+        integer :: tStatus
+
+        ! define the communicator
+        aMUMPS%COMM = MPI_COMM_WORLD
+
+        ! type of parallelism (PAR=1 host working, PAR=0 host not working)
+        aMUMPS%PAR = aIParameters( 2 )
+
+        ! symmetry setting (SYM=0 Unsymmetric, SYM=1 Sym. Positive Definite, SYM=2 General Symmetric)
+        aMUMPS%SYM = aIParameters( 3 )
+
+        ! procedure to call
+        aMUMPS%JOB = -1
+
+        ! initialize MUMPS
+        call MPI_BARRIER( MPI_COMM_WORLD, tStatus )
+        call DMUMPS( aMUMPS )
+
+    end subroutine mumpstools_initialize
+
+!------------------------------------------------------------------------------
+
+    !> write the user parameters into the control arrays
+    subroutine mumpstools_set_parameters( aMUMPS, aIParameters, aRParameters )
+        type ( DMUMPS_STRUC ), intent( inout )             :: aMUMPS
+        integer( c_int ), intent( in ), dimension( 11 )    :: aIParameters
+        real( c_double ), intent( in ), dimension( 1 )     :: aRParameters
+
+        ! set stream for errors
+        aMUMPS%ICNTL( 1 ) = stderr
+
+        ! set stream for diagnostics
+        aMUMPS%ICNTL( 2 ) = stdout
+
+        ! set stream for global information
+        aMUMPS%ICNTL( 3 ) = stdout
+
+        ! statistics
+        select case( aIParameters( 4 ) )
+        case( 5 )
+            ! set info level
+            aMUMPS%ICNTL( 4 ) = 2
+        case( 4 )
+            ! set info level
+            aMUMPS%ICNTL( 4 ) = 2
+
+        case default
+            ! set info level
+            aMUMPS%ICNTL( 4 ) = 0
+        end select
+
+        ! Matrix is already assembled
+        aMUMPS%ICNTL( 5 ) = 0
+
+        ! no zero-free permutation needed
+        aMUMPS%ICNTL( 6 ) = 0
+
+        ! permutation ordering
+        aMUMPS%ICNTL( 7 ) = aIParameters( 5 )
+
+        ! scaling strategy
+        aMUMPS%ICNTL( 8 ) = 0
+
+        ! refinement steps
+        aMUMPS%ICNTL( 10 ) = aIParameters( 7 )
+
+        ! statistics mode
+        aMUMPS%ICNTL( 11 ) = aIParameters( 11 )
+
+        if( aIParameters( 9 ) .gt. 0 ) then
+            aMUMPS%ICNTL( 14 ) = aIParameters( 9 )
+        end if
+
+        ! Matrix is centralized on the host
+        aMUMPS%ICNTL( 18 ) = 0
+
+        ! Right and side is always dense
+        aMUMPS%ICNTL( 20 ) = 0
+
+        ! Parallel refinement
+        aMUMPS%ICNTL( 29 ) = aIParameters( 6 )
+
+        ! Flag to be set if determinant shall be computed
+        aMUMPS%ICNTL( 33 ) = aIParameters( 8 )
+
+        ! for block low-ranking
+        aMUMPS%ICNTL( 35 ) = aIParameters( 10 )
+        aMUMPS%CNTL( 7 )   = aRParameters( 1 )
+
+    end subroutine mumpstools_set_parameters
+
+!------------------------------------------------------------------------------
+
+    !> copy the information of an instance into the output arrays
+    subroutine mumpstools_get_info( aMUMPS, aInfo, aRInfoG )
+        type ( DMUMPS_STRUC ), intent( in )                :: aMUMPS
+        integer( c_int ), intent( out ), dimension( 40 )   :: aInfo
+        real( c_double ), intent( out ), dimension( 20 )   :: aRInfoG
+
+        ! iteration index
+        integer :: k
+
+        forall( k=1:40 ) aInfo( k )   = aMUMPS%INFO( k )
+        forall( k=1:20 ) aRInfoG( k ) = aMUMPS%RINFOG( k )
+
+    end subroutine mumpstools_get_info
+
+!------------------------------------------------------------------------------
+
+end module mumpstools_instances
+
+!------------------------------------------------------------------------------
+
 subroutine mumpstools_solve( &
         aIParameters, & !> list of integer parameters, see above
         aRParameters, & !> list of real parameters
@@ -43,9 +193,7 @@ subroutine mumpstools_solve( &
         aRInfoG      & !> information for debugging
         ) bind( c )
     use, intrinsic :: iso_c_binding
-    use, intrinsic :: iso_fortran_env, only : &
-            stdout=>output_unit, &
-            stderr=>error_unit
+    use mumpstools_instances
     implicit none
     ! - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
     ! ARGUMENTS
@@ -63,30 +211,10 @@ subroutine mumpstools_solve( &
     integer( c_int ), intent( out   ), dimension( 40  )                :: aInfo
     real( c_double ), intent(out ), dimension( 20  )                   :: aRInfoG
 
-    ! - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-    ! Shortcuts for better code readability of user parameters
-    ! - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-
-    integer :: tMasterRank
-    integer :: tParallelMode
-    integer :: tSymmetryMode
-    integer :: tInfoLevel
-    integer :: tSerialPermutationOrdering
-    integer :: tParallelPermutationOrdering
-    integer :: tNumRefinementSteps
-    integer :: tComputeDeterminant
-    integer :: tMemoryRelaxation
-    integer :: tBlrMode
-    integer :: tErrorAnalysisMode
-    double precision :: tEpsilon
-
     ! - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
     ! MUMPS stuff
     ! - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-    include 'mpif.h'
-    include 'dmumps_struc.h'
-
     !> the parameters object
     type ( DMUMPS_STRUC ):: tMUMPS
 
@@ -103,115 +231,18 @@ subroutine mumpstools_solve( &
     ! MPI status
     integer :: tStatus
 
-    ! - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-    ! POPULATE DEFINED PARAMETERS
-    ! - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-
-    tMasterRank                  = aIParameters(  1 )
-    tParallelMode                = aIParameters(  2 )
-    tSymmetryMode                = aIParameters(  3 )
-    tInfoLevel                   = aIParameters(  4 )
-    tSerialPermutationOrdering   = aIParameters(  5 )
-    tParallelPermutationOrdering = aIParameters(  6 )
-    tNumRefinementSteps          = aIParameters(  7 )
-    tComputeDeterminant          = aIParameters(  8 )
-    tMemoryRelaxation            = aIParameters(  9 )
-    tBlrMode                     = aIParameters( 10 )
-    tErrorAnalysisMode           = aIParameters( 11 )
-
-    tEpsilon                     = aRParameters( 1 )
-
     ! - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
     ! INITIALIZE MUMPS
     ! - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-    ! define the communicator
-    tMUMPS%COMM = MPI_COMM_WORLD
-
-    ! type of parallelism (PAR=1 host working, PAR=0 host not working)
-    tMUMPS%PAR = tParallelMode
-
-    ! symmetry setting (SYM=0 Unsymmetric, SYM=1 Sym. Positive Definite, SYM=2 General Symmetric)
-    tMUMPS%SYM = tSymmetryMode
-
-    ! procedure to call
-    tMUMPS%JOB = -1
-
-    ! initialize MUMPS
-    call MPI_BARRIER( MPI_COMM_WORLD, tStatus )
-    call DMUMPS( tMUMPS )
-
-
-    ! - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-    ! Set PARAMETERS
-    ! - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-
-    ! set stream for errors
-    tMUMPS%ICNTL( 1 ) = stderr
-
-    ! set stream for diagnostics
-    tMUMPS%ICNTL( 2 ) = stdout
-
-    ! set stream for global information
-    tMUMPS%ICNTL( 3 ) = stdout
-
-    ! statistics
-    select case( tInfoLevel )
-    case( 5 )
-        ! set info level
-        tMUMPS%ICNTL( 4 ) = 2
-    case( 4 )
-        ! set info level
-        tMUMPS%ICNTL( 4 ) = 2
-
-    case default
-        ! set info level
-        tMUMPS%ICNTL( 4 ) = 0
-    end select
-
-    ! Matrix is already assembled
-    tMUMPS%ICNTL( 5 ) = 0
-
-    ! no zero-free permutation needed
-    tMUMPS%ICNTL( 6 ) = 0
-
-    ! permutation ordering
-    tMUMPS%ICNTL( 7 ) = tSerialPermutationOrdering
-
-    ! scaling strategy
-    tMUMPS%ICNTL( 8 ) = 0
-
-    ! refinement steps
-    tMUMPS%ICNTL( 10 ) = tNumRefinementSteps
-
-    ! statistics mode
-    tMUMPS%ICNTL( 11 ) = tErrorAnalysisMode
-
-    if( tMemoryRelaxation .gt. 0 ) then
-        tMUMPS%ICNTL( 14 ) = tMemoryRelaxation
-    end if
-
-    ! Matrix is centralized on the host
-    tMUMPS%ICNTL( 18 ) = 0
-
-    ! Right and side is always dense
-    tMUMPS%ICNTL( 20 ) = 0
-
-    ! Parallel refinement
-    tMUMPS%ICNTL( 29 ) = tParallelPermutationOrdering
-
-    ! Flag to be set if determinant shall be computed
-    tMUMPS%ICNTL( 33 ) = tComputeDeterminant
-
-    ! for block low-ranking
-    tMUMPS%ICNTL( 35 ) = tBlrMode
-    tMUMPS%CNTL( 7 )   = tEpsilon
+    call mumpstools_initialize( tMUMPS, aIParameters )
+    call mumpstools_set_parameters( tMUMPS, aIParameters, aRParameters )
 
     ! - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
     ! LINK TO MATRIX DATA
     ! - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-    if( tMUMPS%MYID .eq. tMasterRank ) then
+    if( tMUMPS%MYID .eq. aIParameters( 1 ) ) then
         tMUMPS%n    = aN
         tMUMPS%nz   = aNNZ
         tMUMPS%nrhs = aNRHS
@@ -255,4 +286,203 @@ subroutine mumpstools_solve( &
 
 end subroutine mumpstools_solve
 
-!------------------------------------------------------------------------------
\ No newline at end of file
+!------------------------------------------------------------------------------
+
+!> Analysis of a kept instance ( JOB=1 ). If aHandle is zero, a new
+!> instance is created and its index is written into aHandle. If no
+!> instance is free, aHandle remains zero.
+subroutine mumpstools_analyze( &
+        aHandle,     & !> index of the instance
+        aIParameters, & !> list of integer parameters, see above
+        aRParameters, & !> list of real parameters
+        aN,          & !> size of matrix
+        aNNZ,        & !> number of nonzeros
+        aRowIndices, & !> row indices of matrix
+        aColIndices, & !> column indices of matrix
+        aValues,     & !> data in matrix
+        aInfo,       & !> information for debugging
+        aRInfoG      & !> information for debugging
+        ) bind( c )
+    use, intrinsic :: iso_c_binding
+    use mumpstools_instances
+    implicit none
+    ! - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+    ! ARGUMENTS
+    ! - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+    integer( c_int ), intent( inout )                                  :: aHandle
+    integer( c_int ), intent( in    ), dimension( 11 )                 :: aIParameters
+    real( c_double ), intent( in ),    dimension( 1 )                  :: aRParameters
+    integer( c_int ), intent( in    )                                  :: aN
+    integer( c_int ), intent( in    )                                  :: aNNZ
+    integer( c_int ), intent( in    ), dimension( aNNZ ), target       :: aRowIndices
+    integer( c_int ), intent( in    ), dimension( aNNZ ), target       :: aColIndices
+    real( c_double ), intent( in    ), dimension( aNNZ ), target       :: aValues
+    integer( c_int ), intent( out   ), dimension( 40  )                :: aInfo
+    real( c_double ), intent(out ), dimension( 20  )                   :: aRInfoG
+
+    ! iteration index
+    integer :: k
+
+    ! MPI status
+    integer :: tStatus
+
+    ! - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+    ! CREATE A NEW INSTANCE IF NEEDED
+    ! - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    if( aHandle .eq. 0 ) then
+        do k=1,gMaxNumInstances
+            if( .not. gIsUsed( k ) ) then
+                aHandle = k
+                exit
+            end if
+        end do
+
+        if( aHandle .eq. 0 ) then
+            return
+        end if
+
+        gIsUsed( aHandle )     = .true.
+        gMasterRank( aHandle ) = aIParameters( 1 )
+
+        call mumpstools_initialize( gInstances( aHandle ), aIParameters )
+    end if
+
+    call mumpstools_set_parameters( gInstances( aHandle ), aIParameters, aRParameters )
+
+    ! - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+    ! LINK TO MATRIX DATA
+    ! - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    if( gInstances( aHandle )%MYID .eq. gMasterRank( aHandle ) ) then
+        gInstances( aHandle )%n    = aN
+        gInstances( aHandle )%nz   = aNNZ
+        gInstances( aHandle )%irn  => aRowIndices
+        gInstances( aHandle )%jcn  => aColIndices
+        gInstances( aHandle )%A    => aValues
+    end if
+
+    ! - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+    ! ANALYZE
+    ! - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    gInstances( aHandle )%JOB = 1
+
+    call MPI_BARRIER( MPI_COMM_WORLD, tStatus )
+    call DMUMPS( gInstances( aHandle ) )
+
+    call mumpstools_get_info( gInstances( aHandle ), aInfo, aRInfoG )
+
+end subroutine mumpstools_analyze
+
+!------------------------------------------------------------------------------
+
+!> Numeric factorization of a kept instance ( JOB=2 ). The pattern
+!> must be the same as during the analysis, the values may differ.
+subroutine mumpstools_factorize( &
+        aHandle,     & !> index of the instance
+        aN,          & !> size of matrix
+        aNNZ,        & !> number of nonzeros
+        aRowIndices, & !> row indices of matrix
+        aColIndices, & !> column indices of matrix
+        aValues,     & !> data in matrix
+        aInfo,       & !> information for debugging
+        aRInfoG      & !> information for debugging
+        ) bind( c )
+    use, intrinsic :: iso_c_binding
+    use mumpstools_instances
+    implicit none
+    ! - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+    ! ARGUMENTS
+    ! - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+    integer( c_int ), intent( in    )                                  :: aHandle
+    integer( c_int ), intent( in    )                                  :: aN
+    integer( c_int ), intent( in    )                                  :: aNNZ
+    integer( c_int ), intent( in    ), dimension( aNNZ ), target       :: aRowIndices
+    integer( c_int ), intent( in    ), dimension( aNNZ ), target       :: aColIndices
+    real( c_double ), intent( in    ), dimension( aNNZ ), target       :: aValues
+    integer( c_int ), intent( out   ), dimension( 40  )                :: aInfo
+    real( c_double ), intent(out ), dimension( 20  )                   :: aRInfoG
+
+    ! the matrix may have been moved since the last call
+    if( gInstances( aHandle )%MYID .eq. gMasterRank( aHandle ) ) then
+        gInstances( aHandle )%n    = aN
+        gInstances( aHandle )%nz   = aNNZ
+        gInstances( aHandle )%irn  => aRowIndices
+        gInstances( aHandle )%jcn  => aColIndices
+        gInstances( aHandle )%A    => aValues
+    end if
+
+    gInstances( aHandle )%JOB = 2
+    call DMUMPS( gInstances( aHandle ) )
+
+    call mumpstools_get_info( gInstances( aHandle ), aInfo, aRInfoG )
+
+end subroutine mumpstools_factorize
+
+!------------------------------------------------------------------------------
+
+!> Solution with the numeric factorization of a kept instance ( JOB=3 )
+subroutine mumpstools_backsubstitute( &
+        aHandle,     & !> index of the instance
+        aN,          & !> size of matrix
+        aNRHS,       & !> number of cols on right hand side
+        aX,          & !> left hand side
+        aY,          & !> right hand side
+        aInfo,       & !> information for debugging
+        aRInfoG      & !> information for debugging
+        ) bind( c )
+    use, intrinsic :: iso_c_binding
+    use mumpstools_instances
+    implicit none
+    ! - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+    ! ARGUMENTS
+    ! - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+    integer( c_int ), intent( in    )                                  :: aHandle
+    integer( c_int ), intent( in    )                                  :: aN
+    integer( c_int ), intent( in    )                                  :: aNRHS
+    real( c_double ), intent( inout ), dimension( aN * aNRHS ), target :: aX
+    real( c_double ), intent( in    ), dimension( aN * aNRHS )         :: aY
+    integer( c_int ), intent( out   ), dimension( 40  )                :: aInfo
+    real( c_double ), intent(out ), dimension( 20  )                   :: aRInfoG
+
+    ! iteration index
+    integer :: k
+
+    if( gInstances( aHandle )%MYID .eq. gMasterRank( aHandle ) ) then
+        ! copy solution into X-Vector, MUMPS wants that
+        forall ( k=1:aN * aNRHS ) aX( k ) = aY( k )
+
+        gInstances( aHandle )%nrhs = aNRHS
+        gInstances( aHandle )%lrhs = aN
+        gInstances( aHandle )%rhs  => aX
+    end if
+
+    gInstances( aHandle )%JOB = 3
+    call DMUMPS( gInstances( aHandle ) )
+
+    call mumpstools_get_info( gInstances( aHandle ), aInfo, aRInfoG )
+
+end subroutine mumpstools_backsubstitute
+
+!------------------------------------------------------------------------------
+
+!> Destroy a kept instance ( JOB=-2 )
+subroutine mumpstools_finalize( aHandle ) bind( c )
+    use, intrinsic :: iso_c_binding
+    use mumpstools_instances
+    implicit none
+
+    integer( c_int ), intent( in ) :: aHandle
+
+    if( aHandle .gt. 0 ) then
+        if( gIsUsed( aHandle ) ) then
+            gInstances( aHandle )%JOB = -2
+            call DMUMPS( gInstances( aHandle ) )
+            gIsUsed( aHandle ) = .false.
+        end if
+    end if
+
+end subroutine mumpstools_finalize
+
+!------------------------------------------------------------------------------
@@ -26,6 +26,51 @@ extern"C" {
         int          * aInfo,
         double       * aRInfoG ) ;
 
+//------------------------------------------------------------------------------
+
+    void
+    mumpstools_analyze(
+        int          & aHandle,
+        const int    * aIParameters,
+        const double * aRParameters,
+        const int    & aN,
+        const int    & aNNZ,
+        const int    * aRowIndices,
+        const int    * aColIndices,
+        const double * aValues,
+        int          * aInfo,
+        double       * aRInfoG ) ;
+
+//------------------------------------------------------------------------------
+
+    void
+    mumpstools_factorize(
+        const int    & aHandle,
+        const int    & aN,
+        const int    & aNNZ,
+        const int    * aRowIndices,
+        const int    * aColIndices,
+        const double * aValues,
+        int          * aInfo,
+        double       * aRInfoG ) ;
+
+//------------------------------------------------------------------------------
+
+    void
+    mumpstools_backsubstitute(
+        const int    & aHandle,
+        const int    & aN,
+        const int    & aNHRS,
+        double       * aX,
+        const double * aY,
+        int          * aInfo,
+        double       * aRInfoG ) ;
+
+//------------------------------------------------------------------------------
+
+    void
+    mumpstools_finalize( const int & aHandle ) ;
+
 //------------------------------------------------------------------------------
 #ifdef __cplusplus
 }
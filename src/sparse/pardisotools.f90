@@ -38,6 +38,9 @@ module pardisotools
     integer :: gN
     integer :: gNRHS
 
+    !> tells if the factorization uses the 64-bit interface pardiso_64
+    logical :: gLongIndices = .false.
+
 end module pardisotools
 
 !------------------------------------------------------------------------------
@@ -228,6 +231,8 @@ function pardisotools_symbolic_factorization( &
     !  Initiliaze the internal solver memory pointer.
     forall( k = 1:64 ) gMemoryPointers( k ) = 0
 
+    gLongIndices = .false.
+
     call pardiso ( &
             gMemoryPointers, &
             gMaxNumFactors, &
@@ -383,6 +388,125 @@ end function pardisotools_solve
 
 !------------------------------------------------------------------------------
 
+function pardisotools_numeric_factorization( &
+        aN,        & ! size of matrix
+        aNNZ,      & ! number of nonzeros
+        aNRHS,     & ! number of RHS columns
+        aPointers, & ! pointers of CSR / CSC matrix
+        aIndices,  & ! indoces of CSR / CSC matrix
+        aValues    & ! values of matrix
+        ) bind( c ) result( aStatus )
+    use pardisotools
+    implicit none
+    integer( c_int ), intent( in )                            :: aN
+    integer( c_int ), intent( in )                            :: aNNZ
+    integer( c_int ), intent( in )                            :: aNRHS
+    integer( c_int ), intent( in ),    dimension( aN+1 )      :: aPointers
+    integer( c_int ), intent( in ),    dimension( aNNZ )      :: aIndices
+    real( c_double ), intent( in ),    dimension( aNNZ )      :: aValues
+    integer( c_int )                                          :: aStatus
+
+    ! the phase of the current call
+    integer :: tPhase
+
+    ! some dummy values
+    integer :: tIntDummy
+    real*8  :: tRealDummy
+
+    ! remember size
+    gN = aN
+    gNRHS = aNRHS
+
+    !  Factorization, the factors are kept in gMemoryPointers
+    tPhase = 22
+    call pardiso ( &
+            gMemoryPointers, &
+            gMaxNumFactors, &
+            gNumFactors, &
+            gMatrixType, &
+            tPhase, &
+            aN, &
+            aValues, &
+            aPointers, &
+            aIndices, &
+            tIntDummy, &
+            aNRHS, &
+            gParameters, &
+            gInfoLevel, &
+            tRealDummy, &
+            tRealDummy, &
+            aStatus )
+
+end function pardisotools_numeric_factorization
+
+!------------------------------------------------------------------------------
+
+function pardisotools_backsubstitution( &
+        aN,        & ! size of matrix
+        aNNZ,      & ! number of nonzeros
+        aNRHS,     & ! number of RHS columns
+        aPointers, & ! pointers of CSR / CSC matrix
+        aIndices,  & ! indoces of CSR / CSC matrix
+        aValues,   & ! values of matrix
+        aLHS,      & ! Left hand side
+        aRHS       & ! Right hand side
+        ) bind( c ) result( aStatus )
+    use pardisotools
+    implicit none
+    integer( c_int ), intent( in )                            :: aN
+    integer( c_int ), intent( in )                            :: aNNZ
+    integer( c_int ), intent( in )                            :: aNRHS
+    integer( c_int ), intent( in ),    dimension( aN+1 )      :: aPointers
+    integer( c_int ), intent( in ),    dimension( aNNZ )      :: aIndices
+    real( c_double ), intent( in ),    dimension( aNNZ )      :: aValues
+    real( c_double ), intent( inout ), dimension( aN, aNRHS ) :: aLHS
+    real( c_double ), intent( in ),    dimension( aN, aNRHS ) :: aRHS
+    integer( c_int )                                          :: aStatus
+
+    ! iteration index
+    integer :: k
+
+    ! the phase of the current call
+    integer :: tPhase
+
+    ! some dummy values
+    integer :: tIntDummy
+
+    ! local copy of parameters
+    integer, dimension( 64 ) :: tParameters
+
+    ! create a local copy of the parameters
+    forall( k=1:64 ) tParameters( k ) = gParameters( k )
+
+    ! initialize parameters
+    forall( k=1:64 ) gDPARM( k ) = 0.0
+
+    !  Back substitution and iterative refinement using the stored factors
+    tPhase = 33
+
+    call pardiso ( &
+            gMemoryPointers, &
+            gMaxNumFactors, &
+            gNumFactors, &
+            gMatrixType, &
+            tPhase, &
+            aN, &
+            aValues, &
+            aPointers, &
+            aIndices, &
+            tIntDummy, &
+            aNRHS, &
+            tParameters, &
+            gInfoLevel, &
+            aRHS, &
+            aLHS, &
+            aStatus, &
+            gDPARM )
+
+end function pardisotools_backsubstitution
+
+!------------------------------------------------------------------------------
+
 function pardisotools_free() bind( c ) result( aStatus )
     use pardisotools
     implicit none
@@ -394,6 +518,21 @@ function pardisotools_free() bind( c ) result( aStatus )
     real*8  :: tRealDummy
     integer :: tPhase = -1
 
+    ! dummy values for the 64-bit interface
+    integer*8, dimension( 1 ) :: tLongDummy
+    real*8,    dimension( 1 ) :: tArrayDummy
+
+    ! local copy of parameters
+    integer, dimension( 64 ) :: tParameters
+
+    if( gLongIndices ) then
+        tParameters = gParameters
+        call pardisotools_call_64( tPhase, gN, gNRHS, tArrayDummy, tLongDummy, tLongDummy, &
+                tParameters, tArrayDummy, tArrayDummy, aStatus )
+        gLongIndices = .false.
+        return
+    end if
+
     call pardiso ( &
             gMemoryPointers, &
             gMaxNumFactors, &
@@ -416,6 +555,201 @@ end function pardisotools_free
 
 !------------------------------------------------------------------------------
 
+!> calls the 64-bit interface of PARDISO, which is needed if the number of
+!> nonzeros exceeds the range of a 32-bit integer. All scalar integers
+!> and the parameter list are passed as integer*8.
+subroutine pardisotools_call_64( &
+        aPhase,      & ! phase of the call
+        aN,          & ! size of matrix
+        aNRHS,       & ! number of RHS columns
+        aValues,     & ! values of matrix
+        aPointers,   & ! 64-bit pointers of CSR / CSC matrix
+        aIndices,    & ! 64-bit indices of CSR / CSC matrix
+        aParameters, & ! parameter list
+        aRHS,        & ! right hand side
+        aLHS,        & ! left hand side
+        aStatus )
+    use pardisotools
+    implicit none
+    integer,                    intent( in )    :: aPhase
+    integer,                    intent( in )    :: aN
+    integer,                    intent( in )    :: aNRHS
+    real*8,    dimension( * ),  intent( in )    :: aValues
+    integer*8, dimension( * ),  intent( in )    :: aPointers
+    integer*8, dimension( * ),  intent( in )    :: aIndices
+    integer,   dimension( 64 ), intent( inout ) :: aParameters
+    real*8,    dimension( * ),  intent( in )    :: aRHS
+    real*8,    dimension( * ),  intent( inout ) :: aLHS
+    integer,                    intent( out )   :: aStatus
+
+    ! 64-bit copies of the integer arguments
+    integer*8 :: tMaxNumFactors
+    integer*8 :: tNumFactors
+    integer*8 :: tMatrixType
+    integer*8 :: tPhase
+    integer*8 :: tN
+    integer*8 :: tNRHS
+    integer*8 :: tInfoLevel
+    integer*8 :: tStatus
+    integer*8 :: tIntDummy
+    integer*8, dimension( 64 ) :: tParameters
+
+    tMaxNumFactors = gMaxNumFactors
+    tNumFactors    = gNumFactors
+    tMatrixType    = gMatrixType
+    tPhase         = aPhase
+    tN             = aN
+    tNRHS          = aNRHS
+    tInfoLevel     = gInfoLevel
+    tParameters    = aParameters
+
+    call pardiso_64 ( &
+            gMemoryPointers, &
+            tMaxNumFactors, &
+            tNumFactors, &
+            tMatrixType, &
+            tPhase, &
+            tN, &
+            aValues, &
+            aPointers, &
+            aIndices, &
+            tIntDummy, &
+            tNRHS, &
+            tParameters, &
+            tInfoLevel, &
+            aRHS, &
+            aLHS, &
+            tStatus )
+
+    ! copy output parameters back
+    aParameters = int( tParameters )
+    aStatus     = int( tStatus )
+
+end subroutine pardisotools_call_64
+
+!------------------------------------------------------------------------------
+
+function pardisotools_symbolic_factorization_64( &
+        aN,        & ! size of matrix
+        aNNZ,      & ! number of nonzeros
+        aNRHS,     & ! number of RHS columns
+        aPointers, & ! 64-bit pointers of CSR / CSC matrix
+        aIndices,  & ! 64-bit indices of CSR / CSC matrix
+        aValues    & ! values of matrix
+        ) bind( c ) result( aStatus )
+    use pardisotools
+    implicit none
+    integer( c_int ),  intent( in )                            :: aN
+    integer( c_long ), intent( in )                            :: aNNZ
+    integer( c_int ),  intent( in )                            :: aNRHS
+    integer( c_long ), intent( in ),    dimension( aN+1 )      :: aPointers
+    integer( c_long ), intent( in ),    dimension( aNNZ )      :: aIndices
+    real( c_double ),  intent( in ),    dimension( aNNZ )      :: aValues
+    integer( c_int )                                           :: aStatus
+
+    ! iteration index
+    integer :: k
+
+    ! dummy values
+    real*8, dimension( 1 ) :: tArrayDummy
+
+    ! local copy of parameters
+    integer, dimension( 64 ) :: tParameters
+
+    ! initialize factors
+    gMaxNumFactors = 1
+    gNumFactors    = 1
+
+    !  Initiliaze the internal solver memory pointer.
+    forall( k = 1:64 ) gMemoryPointers( k ) = 0
+
+    gLongIndices = .true.
+    gN           = aN
+    gNRHS        = aNRHS
+
+    tParameters = gParameters
+
+    !  Reordering and Symbolic Factorization
+    call pardisotools_call_64( 11, aN, aNRHS, aValues, aPointers, aIndices, &
+            tParameters, tArrayDummy, tArrayDummy, aStatus )
+
+end function pardisotools_symbolic_factorization_64
+
+!------------------------------------------------------------------------------
+
+function pardisotools_numeric_factorization_64( &
+        aN,        & ! size of matrix
+        aNNZ,      & ! number of nonzeros
+        aNRHS,     & ! number of RHS columns
+        aPointers, & ! 64-bit pointers of CSR / CSC matrix
+        aIndices,  & ! 64-bit indices of CSR / CSC matrix
+        aValues    & ! values of matrix
+        ) bind( c ) result( aStatus )
+    use pardisotools
+    implicit none
+    integer( c_int ),  intent( in )                            :: aN
+    integer( c_long ), intent( in )                            :: aNNZ
+    integer( c_int ),  intent( in )                            :: aNRHS
+    integer( c_long ), intent( in ),    dimension( aN+1 )      :: aPointers
+    integer( c_long ), intent( in ),    dimension( aNNZ )      :: aIndices
+    real( c_double ),  intent( in ),    dimension( aNNZ )      :: aValues
+    integer( c_int )                                           :: aStatus
+
+    ! dummy values
+    real*8, dimension( 1 ) :: tArrayDummy
+
+    ! local copy of parameters
+    integer, dimension( 64 ) :: tParameters
+
+    ! remember size
+    gN = aN
+    gNRHS = aNRHS
+
+    tParameters = gParameters
+
+    !  Factorization, the factors are kept in gMemoryPointers
+    call pardisotools_call_64( 22, aN, aNRHS, aValues, aPointers, aIndices, &
+            tParameters, tArrayDummy, tArrayDummy, aStatus )
+
+end function pardisotools_numeric_factorization_64
+
+!------------------------------------------------------------------------------
+
+function pardisotools_backsubstitution_64( &
+        aN,        & ! size of matrix
+        aNNZ,      & ! number of nonzeros
+        aNRHS,     & ! number of RHS columns
+        aPointers, & ! 64-bit pointers of CSR / CSC matrix
+        aIndices,  & ! 64-bit indices of CSR / CSC matrix
+        aValues,   & ! values of matrix
+        aLHS,      & ! Left hand side
+        aRHS       & ! Right hand side
+        ) bind( c ) result( aStatus )
+    use pardisotools
+    implicit none
+    integer( c_int ),  intent( in )                            :: aN
+    integer( c_long ), intent( in )                            :: aNNZ
+    integer( c_int ),  intent( in )                            :: aNRHS
+    integer( c_long ), intent( in ),    dimension( aN+1 )      :: aPointers
+    integer( c_long ), intent( in ),    dimension( aNNZ )      :: aIndices
+    real( c_double ),  intent( in ),    dimension( aNNZ )      :: aValues
+    real( c_double ),  intent( inout ), dimension( aN, aNRHS ) :: aLHS
+    real( c_double ),  intent( in ),    dimension( aN, aNRHS ) :: aRHS
+    integer( c_int )                                           :: aStatus
+
+    ! local copy of parameters
+    integer, dimension( 64 ) :: tParameters
+
+    tParameters = gParameters
+
+    !  Back substitution and iterative refinement using the stored factors
+    call pardisotools_call_64( 33, aN, aNRHS, aValues, aPointers, aIndices, &
+            tParameters, aRHS, aLHS, aStatus )
+
+end function pardisotools_backsubstitution_64
+
+!------------------------------------------------------------------------------
+
 function pardisotools_get_determinant() bind( c ) result( aDet )
     use pardisotools
     implicit none
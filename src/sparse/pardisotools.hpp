@@ -32,6 +32,55 @@ extern"C" {
                          const double * aRHS,
                          int          * aInfo   );
 
+    int
+    pardisotools_numeric_factorization(
+            const int    & aN,
+            const int    & aNNZ,
+            const int    & aNRHS,
+            const int    * aPointers,
+            const int    * aIndices,
+            const double * aValues );
+
+    int
+    pardisotools_backsubstitution(
+            const int    & aN,
+            const int    & aNNZ,
+            const int    & aNRHS,
+            const int    * aPointers,
+            const int    * aIndices,
+            const double * aValues,
+            double       * aLHS,
+            const double * aRHS );
+
+    int
+    pardisotools_symbolic_factorization_64(
+            const int      & aN,
+            const long int & aNNZ,
+            const int      & aNRHS,
+            const long int * aPointers,
+            const long int * aIndices,
+            const double   * aValues );
+
+    int
+    pardisotools_numeric_factorization_64(
+            const int      & aN,
+            const long int & aNNZ,
+            const int      & aNRHS,
+            const long int * aPointers,
+            const long int * aIndices,
+            const double   * aValues );
+
+    int
+    pardisotools_backsubstitution_64(
+            const int      & aN,
+            const long int & aNNZ,
+            const int      & aNRHS,
+            const long int * aPointers,
+            const long int * aIndices,
+            const double   * aValues,
+            double         * aLHS,
+            const double   * aRHS );
+
     int
     pardisotools_free() ;
 
@@ -0,0 +1,48 @@
+//
+// Created by Christian Messe on 17.10.26.
+//
+
+#ifndef BELFEM_ST_SPMATRIXROWBLOCK_HPP
+#define BELFEM_ST_SPMATRIXROWBLOCK_HPP
+
+#include "typedefs.hpp"
+#include "cl_Vector.hpp"
+
+namespace belfem
+{
+//------------------------------------------------------------------------------
+
+    /**
+     * the rows of a global CSR matrix that are owned by this proc.
+     *
+     * Used for the distributed assembly, where each proc keeps
+     * its own part of the Jacobian and the master does not
+     * need to hold the values of the whole matrix.
+     */
+    struct SpMatrixRowBlock
+    {
+        // global number of rows and columns
+        index_t mNumberOfRows = 0 ;
+
+        // first global row that belongs to this proc
+        index_t mRowOffset = 0 ;
+
+        // number of rows that belong to this proc
+        index_t mMyNumberOfRows = 0 ;
+
+        // first row of each proc, has one more entry than procs
+        Vector< int > mDistribution ;
+
+        // zero based CSR pointers of the local rows
+        Vector< int > mPointers ;
+
+        // global column indices
+        Vector< int > mColumns ;
+
+        // values of the local rows
+        Vector< real > mValues ;
+    };
+
+//------------------------------------------------------------------------------
+}
+#endif //BELFEM_ST_SPMATRIXROWBLOCK_HPP
@@ -0,0 +1,132 @@
+//
+// Created by Christian Messe on 17.10.26.
+//
+
+#include <cmath>
+#include <gtest/gtest.h>
+
+#include "typedefs.hpp"
+#include "cl_Vector.hpp"
+#include "cl_HDF5.hpp"
+
+using namespace belfem;
+
+#ifdef BELFEM_HDF5
+//------------------------------------------------------------------------------
+
+/**
+ * some data that does not compress too well
+ */
+void
+create_hdf5_test_data( Vector< real > & aData )
+{
+    aData.set_size( 1000 );
+
+    for( index_t k=0; k<aData.length(); ++k )
+    {
+        aData( k ) = std::sin( 0.1 * ( real ) k ) * ( 1.0 + 0.001 * ( real ) k );
+    }
+}
+
+//------------------------------------------------------------------------------
+
+TEST( HDF5, Compression )
+{
+    Vector< real > tData ;
+    create_hdf5_test_data( tData );
+
+    string tPath = "/tmp/test_compression.hdf5" ;
+
+    {
+        HDF5 tFile( tPath, FileMode::NEW );
+        tFile.set_compression( 4 );
+        tFile.set_chunk_size( 64 );
+        tFile.save_data( "data", tData );
+        tFile.close();
+    }
+
+    Vector< real > tLoad ;
+    {
+        HDF5 tFile( tPath, FileMode::OPEN_RDONLY );
+        tFile.load_data( "data", tLoad );
+        tFile.close();
+    }
+
+    // deflate is lossless
+    ASSERT_EQ( tLoad.length(), tData.length() );
+    for( index_t k=0; k<tData.length(); ++k )
+    {
+        EXPECT_EQ( tLoad( k ), tData( k ) );
+    }
+}
+
+//------------------------------------------------------------------------------
+
+TEST( HDF5, LossyPrecision )
+{
+    Vector< real > tData ;
+    create_hdf5_test_data( tData );
+
+    string tPath = "/tmp/test_lossy.hdf5" ;
+
+    {
+        HDF5 tFile( tPath, FileMode::NEW );
+        tFile.set_compression( 4 );
+        tFile.set_lossy_precision( 3 );
+        tFile.save_data( "data", tData );
+        tFile.close();
+    }
+
+    Vector< real > tLoad ;
+    {
+        HDF5 tFile( tPath, FileMode::OPEN_RDONLY );
+        tFile.load_data( "data", tLoad );
+        tFile.close();
+    }
+
+    // three decimal digits are kept
+    ASSERT_EQ( tLoad.length(), tData.length() );
+    for( index_t k=0; k<tData.length(); ++k )
+    {
+        EXPECT_NEAR( tLoad( k ), tData( k ), 1e-3 );
+    }
+}
+
+//------------------------------------------------------------------------------
+
+TEST( HDF5, Distributed )
+{
+    Vector< real > tData ;
+    create_hdf5_test_data( tData );
+
+    // without MPI-IO, this is the same as save_data and load_data
+    bool tCollective = false ;
+#if defined( BELFEM_MPI ) && defined( H5_HAVE_PARALLEL )
+    tCollective = true ;
+#endif
+
+    string tPath = "/tmp/test_distributed.hdf5" ;
+
+    {
+        HDF5 tFile( tPath, FileMode::NEW, false, tCollective );
+        tFile.set_compression( 4 );
+        tFile.save_distributed( "data", tData );
+        tFile.close();
+    }
+
+    // the vector must have the length of the part
+    Vector< real > tLoad( tData.length(), 0.0 );
+    {
+        HDF5 tFile( tPath, FileMode::OPEN_RDONLY, false, tCollective );
+        tFile.load_distributed( "data", tLoad );
+        tFile.close();
+    }
+
+    for( index_t k=0; k<tData.length(); ++k )
+    {
+        EXPECT_EQ( tLoad( k ), tData( k ) );
+    }
+}
+
+//------------------------------------------------------------------------------
+#endif
@@ -0,0 +1,109 @@
+//
+// Created by Christian Messe on 17.10.26.
+//
+
+#include <fstream>
+#include <thread>
+#include <gtest/gtest.h>
+#include "typedefs.hpp"
+#include "cl_Cell.hpp"
+#include "cl_Map.hpp"
+#include "cl_Profiler.hpp"
+
+using namespace belfem ;
+
+//------------------------------------------------------------------------------
+
+/**
+ * returns the text after aKey in aLine, up to the next quote or comma
+ */
+string
+profiler_trace_value( const string & aLine, const string & aKey )
+{
+    size_t tStart = aLine.find( aKey );
+
+    if( tStart == string::npos )
+    {
+        return "" ;
+    }
+
+    tStart += aKey.length() ;
+
+    return aLine.substr( tStart, aLine.find_first_of( "\",", tStart ) - tStart );
+}
+
+//------------------------------------------------------------------------------
+
+TEST( CORE, ProfilerRegions )
+{
+    Profiler::reset_regions() ;
+    Profiler::enable_regions( true );
+
+    {
+        ProfilerRegion tOuter( "outer" );
+
+        for( uint k=0; k<3; ++k )
+        {
+            ProfilerRegion tInner( "inner" );
+        }
+
+        // regions of other threads are ignored
+        std::thread tThread( [](){ ProfilerRegion tIgnored( "thread" ); } );
+        tThread.join() ;
+    }
+    {
+        // the same label below the same parent is the same region
+        ProfilerRegion tOuter( "outer" );
+        ProfilerRegion tOther( "other" );
+        ProfilerRegion tInner( "inner" );
+    }
+
+    string tPath = "/tmp/test_profiler.json" ;
+    Profiler::report( tPath );
+    Profiler::enable_regions( false );
+
+    // read the paths, calls and durations from the Chrome trace
+    std::ifstream tFile( tPath );
+    ASSERT_TRUE( tFile.good() );
+
+    Cell< string > tPaths ;
+    Map< string, luint > tCalls ;
+    Map< string, real > tDurations ;
+
+    string tLine ;
+    while( std::getline( tFile, tLine ) )
+    {
+        string tRegion = profiler_trace_value( tLine, "\"path\": \"" );
+
+        if( ! tRegion.empty() )
+        {
+            tPaths.push( tRegion );
+            tCalls[ tRegion ] = std::stoul( profiler_trace_value( tLine, "\"calls\": " ) );
+            tDurations[ tRegion ] = std::stod( profiler_trace_value( tLine, "\"dur\": " ) );
+        }
+    }
+
+    // the reduced tree, parents are listed before their children
+    ASSERT_EQ( tPaths.size(), 5u );
+    EXPECT_EQ( tPaths( 0 ), "total" );
+    EXPECT_EQ( tPaths( 1 ), "total/outer" );
+    EXPECT_EQ( tPaths( 2 ), "total/outer/inner" );
+    EXPECT_EQ( tPaths( 3 ), "total/outer/other" );
+    EXPECT_EQ( tPaths( 4 ), "total/outer/other/inner" );
+
+    EXPECT_EQ( tCalls( "total" ), 1u );
+    EXPECT_EQ( tCalls( "total/outer" ), 2u );
+    EXPECT_EQ( tCalls( "total/outer/inner" ), 3u );
+    EXPECT_EQ( tCalls( "total/outer/other" ), 1u );
+    EXPECT_EQ( tCalls( "total/outer/other/inner" ), 1u );
+
+    // a child can't take longer than its parent
+    EXPECT_LE( tDurations( "total/outer" ), tDurations( "total" ) );
+    EXPECT_LE( tDurations( "total/outer/inner" ) + tDurations( "total/outer/other" ),
+               tDurations( "total/outer" ) );
+    EXPECT_LE( tDurations( "total/outer/other/inner" ), tDurations( "total/outer/other" ) );
+
+    Profiler::reset_regions() ;
+}
+
+//------------------------------------------------------------------------------
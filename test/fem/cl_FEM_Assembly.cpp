@@ -0,0 +1,183 @@
+//
+// Created by Christian Messe on 17.10.26.
+//
+
+#include <gtest/gtest.h>
+#include "typedefs.hpp"
+#include "cl_Vector.hpp"
+#include "cl_Cell.hpp"
+#include "cl_Mesh.hpp"
+#include "cl_TensorMeshFactory.hpp"
+#include "cl_SpMatrix.hpp"
+#include "cl_FEM_Kernel.hpp"
+#include "cl_FEM_KernelParameters.hpp"
+#include "cl_FEM_DofManager.hpp"
+#include "cl_FEM_Block.hpp"
+#include "cl_FEM_Element.hpp"
+#include "cl_FEM_Dof.hpp"
+#include "cl_IWG_StationaryHeatConduction.hpp"
+#include "en_Materials.hpp"
+
+using namespace belfem ;
+using namespace fem ;
+
+/**
+ * assemble a heat conduction problem on a tensor mesh
+ * and return the Jacobian values and the right hand side
+ */
+void
+assemble_heat_problem(
+        const uint       aNumberOfThreads,
+        Vector< real > & aJacobian,
+        Vector< real > & aRHS,
+        const bool       aCheckColors,
+        const bool       aUseTables=true )
+{
+    TensorMeshFactory tFactory ;
+    Vector< uint > tNumElems = { 6, 5, 4 };
+    Vector< real > tMinPoint = { 0.0, 0.0, 0.0 };
+    Vector< real > tMaxPoint = { 0.3, 0.2, 0.1 };
+
+    Mesh * tMesh = tFactory.create_tensor_mesh( tNumElems, tMinPoint, tMaxPoint );
+
+    // the kernel must be destroyed before the mesh
+    {
+        KernelParameters tParams( tMesh );
+        Kernel tKernel( &tParams );
+
+        IWG_StationaryHeatConduction tIWG( 3 );
+        tIWG.select_block( 1 );
+
+        DofManager * tField = tKernel.create_field( &tIWG );
+        tField->set_number_of_threads( aNumberOfThreads );
+        tField->block( 1 )->set_material( MaterialType::Copper );
+        tField->initialize() ;
+
+        // a temperature gradient, so that the conductivity is not constant
+        Vector< real > & tT = tMesh->field_data( "T" );
+        for( index_t k=0; k<tMesh->number_of_nodes(); ++k )
+        {
+            tT( k ) = 20.0 + 1000.0 * tMesh->nodes()( k )->x() ;
+        }
+
+        // without tables, the values are added entry by entry
+        if( ! aUseTables )
+        {
+            for( Element * tElement : tField->block( 1 )->elements() )
+            {
+                tElement->jacobian_table().set_size( 0 );
+                tElement->dirichlet_table().set_size( 0 );
+            }
+        }
+
+        tField->compute_jacobian_and_rhs() ;
+
+        if( aCheckColors )
+        {
+            Block * tBlock = tField->block( 1 );
+            tBlock->color_elements() ;
+
+            const Cell< Vector< index_t > > & tColors = tBlock->element_colors() ;
+            Cell< Element * > & tElements = tBlock->elements() ;
+
+            EXPECT_GT( tColors.size(), 1u );
+
+            // color that has last written into a dof
+            Vector< index_t > tDofColor( tField->jacobian()->n_rows(), gNoIndex );
+
+            index_t tNumColored = 0 ;
+
+            for( index_t c=0; c<tColors.size(); ++c )
+            {
+                for( index_t e=0; e<tColors( c ).length(); ++e )
+                {
+                    Element * tElement = tElements( tColors( c )( e ) );
+                    for( uint k=0; k<tElement->number_of_dofs(); ++k )
+                    {
+                        Dof * tDof = tElement->dof( k );
+                        if( ! tDof->is_fixed() )
+                        {
+                            EXPECT_NE( tDofColor( tDof->my_index() ), c );
+                            tDofColor( tDof->my_index() ) = c ;
+                        }
+                    }
+                    ++tNumColored ;
+                }
+            }
+
+            // each element is colored exactly once
+            EXPECT_EQ( tNumColored, tElements.size() );
+        }
+
+        SpMatrix * tJacobian = tField->jacobian() ;
+        aJacobian.set_size( tJacobian->number_of_nonzeros() );
+        for( index_t k=0; k<tJacobian->number_of_nonzeros(); ++k )
+        {
+            aJacobian( k ) = tJacobian->data()[ k ];
+        }
+
+        aRHS = tField->rhs_vector() ;
+    }
+
+    delete tMesh ;
+}
+
+//------------------------------------------------------------------------------
+
+TEST( FEM, ColoredAssembly )
+{
+    Vector< real > tSerialJacobian ;
+    Vector< real > tSerialRHS ;
+    assemble_heat_problem( 1, tSerialJacobian, tSerialRHS, false );
+
+    Vector< real > tThreadedJacobian ;
+    Vector< real > tThreadedRHS ;
+    assemble_heat_problem( 4, tThreadedJacobian, tThreadedRHS, true );
+
+    ASSERT_EQ( tSerialJacobian.length(), tThreadedJacobian.length() );
+    ASSERT_EQ( tSerialRHS.length(), tThreadedRHS.length() );
+
+    // the summation order differs between the colors
+    real tScale = 0.0 ;
+    for( index_t k=0; k<tSerialJacobian.length(); ++k )
+    {
+        tScale = std::max( tScale, std::abs( tSerialJacobian( k ) ) );
+    }
+
+    for( index_t k=0; k<tSerialJacobian.length(); ++k )
+    {
+        EXPECT_NEAR( tSerialJacobian( k ), tThreadedJacobian( k ), 1e-12 * tScale );
+    }
+
+    tScale = 0.0 ;
+    for( index_t k=0; k<tSerialRHS.length(); ++k )
+    {
+        tScale = std::max( tScale, std::abs( tSerialRHS( k ) ) );
+    }
+
+    for( index_t k=0; k<tSerialRHS.length(); ++k )
+    {
+        EXPECT_NEAR( tSerialRHS( k ), tThreadedRHS( k ), 1e-12 * tScale + 1e-12 );
+    }
+}
+
+//------------------------------------------------------------------------------
+
+TEST( FEM, TableAssembly )
+{
+    Vector< real > tTableJacobian ;
+    Vector< real > tTableRHS ;
+    assemble_heat_problem( 1, tTableJacobian, tTableRHS, false, true );
+
+    Vector< real > tEntryJacobian ;
+    Vector< real > tEntryRHS ;
+    assemble_heat_problem( 1, tEntryJacobian, tEntryRHS, false, false );
+
+    ASSERT_EQ( tTableJacobian.length(), tEntryJacobian.length() );
+
+    // both variants add the same values in the same order
+    for( index_t k=0; k<tTableJacobian.length(); ++k )
+    {
+        EXPECT_EQ( tTableJacobian( k ), tEntryJacobian( k ) );
+    }
+}
@@ -0,0 +1,122 @@
+//
+// Created by Christian Messe on 17.10.26.
+//
+
+#include <cstdio>
+#include <gtest/gtest.h>
+#include "typedefs.hpp"
+#include "cl_Vector.hpp"
+#include "cl_Mesh.hpp"
+#include "cl_TensorMeshFactory.hpp"
+#include "cl_SpMatrix.hpp"
+#include "cl_FEM_Kernel.hpp"
+#include "cl_FEM_KernelParameters.hpp"
+#include "cl_FEM_DofManager.hpp"
+#include "cl_FEM_Block.hpp"
+#include "cl_IWG_StationaryHeatConduction.hpp"
+#include "en_Materials.hpp"
+#include "filetools.hpp"
+
+using namespace belfem ;
+using namespace fem ;
+
+#ifdef BELFEM_HDF5
+/**
+ * assemble a heat conduction problem with a checkpoint,
+ * returns true if the setup was read from the checkpoint
+ */
+bool
+assemble_with_checkpoint(
+        const Vector< uint > & aNumElems,
+        const string         & aCheckpoint,
+        Vector< real >       & aJacobian,
+        Vector< real >       & aRHS )
+{
+    TensorMeshFactory tFactory ;
+    Vector< real > tMinPoint = { 0.0, 0.0, 0.0 };
+    Vector< real > tMaxPoint = { 0.3, 0.2, 0.1 };
+
+    Mesh * tMesh = tFactory.create_tensor_mesh( aNumElems, tMinPoint, tMaxPoint );
+
+    bool aLoaded = false ;
+
+    // the kernel must be destroyed before the mesh
+    {
+        KernelParameters tParams( tMesh );
+        Kernel tKernel( &tParams );
+
+        IWG_StationaryHeatConduction tIWG( 3 );
+        tIWG.select_block( 1 );
+
+        DofManager * tField = tKernel.create_field( &tIWG );
+        tField->block( 1 )->set_material( MaterialType::Copper );
+        tField->set_checkpoint( aCheckpoint );
+        tField->initialize() ;
+
+        aLoaded = tField->checkpoint_loaded() ;
+
+        Vector< real > & tT = tMesh->field_data( "T" );
+        for( index_t k=0; k<tMesh->number_of_nodes(); ++k )
+        {
+            tT( k ) = 20.0 + 1000.0 * tMesh->nodes()( k )->x() ;
+        }
+
+        tField->compute_jacobian_and_rhs() ;
+
+        SpMatrix * tJacobian = tField->jacobian() ;
+        aJacobian.set_size( tJacobian->number_of_nonzeros() );
+        for( index_t k=0; k<tJacobian->number_of_nonzeros(); ++k )
+        {
+            aJacobian( k ) = tJacobian->data()[ k ];
+        }
+
+        aRHS = tField->rhs_vector() ;
+    }
+
+    delete tMesh ;
+
+    return aLoaded ;
+}
+
+//------------------------------------------------------------------------------
+
+TEST( FEM, Checkpoint )
+{
+    string tCheckpoint = "/tmp/test_checkpoint.hdf5" ;
+    std::remove( make_path_parallel( tCheckpoint ).c_str() );
+
+    Vector< uint > tNumElems = { 6, 5, 4 };
+
+    // the first run writes the checkpoint
+    Vector< real > tJacobian ;
+    Vector< real > tRHS ;
+    EXPECT_FALSE( assemble_with_checkpoint( tNumElems, tCheckpoint, tJacobian, tRHS ) );
+
+    // the second run reads it and assembles the same system
+    Vector< real > tLoadedJacobian ;
+    Vector< real > tLoadedRHS ;
+    EXPECT_TRUE( assemble_with_checkpoint( tNumElems, tCheckpoint, tLoadedJacobian, tLoadedRHS ) );
+
+    ASSERT_EQ( tJacobian.length(), tLoadedJacobian.length() );
+    ASSERT_EQ( tRHS.length(), tLoadedRHS.length() );
+
+    for( index_t k=0; k<tJacobian.length(); ++k )
+    {
+        EXPECT_EQ( tJacobian( k ), tLoadedJacobian( k ) );
+    }
+    for( index_t k=0; k<tRHS.length(); ++k )
+    {
+        EXPECT_EQ( tRHS( k ), tLoadedRHS( k ) );
+    }
+
+    // a different mesh must not use the checkpoint, but overwrites it
+    Vector< uint > tOtherElems = { 6, 5, 5 };
+    Vector< real > tOtherJacobian ;
+    Vector< real > tOtherRHS ;
+    EXPECT_FALSE( assemble_with_checkpoint( tOtherElems, tCheckpoint, tOtherJacobian, tOtherRHS ) );
+    EXPECT_TRUE( assemble_with_checkpoint( tOtherElems, tCheckpoint, tOtherJacobian, tOtherRHS ) );
+    EXPECT_FALSE( assemble_with_checkpoint( tNumElems, tCheckpoint, tJacobian, tRHS ) );
+}
+
+//------------------------------------------------------------------------------
+#endif
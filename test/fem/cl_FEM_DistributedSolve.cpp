@@ -0,0 +1,105 @@
+//
+// Created by Christian Messe on 17.10.26.
+//
+
+#include <cmath>
+#include <gtest/gtest.h>
+#include "typedefs.hpp"
+#include "cl_Vector.hpp"
+#include "cl_Mesh.hpp"
+#include "cl_TensorMeshFactory.hpp"
+#include "cl_FEM_Kernel.hpp"
+#include "cl_FEM_KernelParameters.hpp"
+#include "cl_FEM_DofManager.hpp"
+#include "cl_FEM_Block.hpp"
+#include "cl_FEM_Dof.hpp"
+#include "cl_IWG_StationaryHeatConduction.hpp"
+#include "en_Materials.hpp"
+#include "en_SolverEnums.hpp"
+
+using namespace belfem ;
+using namespace fem ;
+
+/**
+ * solve a heat conduction problem with fixed temperatures at both ends
+ * and return the temperatures of this proc. With distributed assembly,
+ * each proc applies the fixed values and updates its own dofs,
+ * otherwise, the master sends the fields.
+ */
+void
+solve_heat_problem( const bool aDistributedAssembly, Vector< real > & aT )
+{
+    TensorMeshFactory tFactory ;
+    Vector< uint > tNumElems = { 8, 4, 4 };
+    Vector< real > tMinPoint = { 0.0, 0.0, 0.0 };
+    Vector< real > tMaxPoint = { 0.4, 0.2, 0.1 };
+
+    Mesh * tMesh = tFactory.create_tensor_mesh( tNumElems, tMinPoint, tMaxPoint );
+
+    // the kernel must be destroyed before the mesh
+    {
+        KernelParameters tParams( tMesh );
+        Kernel tKernel( &tParams );
+
+        IWG_StationaryHeatConduction tIWG( 3 );
+        tIWG.select_block( 1 );
+
+        DofManager * tField = tKernel.create_field( &tIWG );
+#ifdef BELFEM_PETSC
+        tField->set_solver( SolverType::PETSC );
+#endif
+        tField->set_distributed_assembly( aDistributedAssembly );
+        tField->block( 1 )->set_material( MaterialType::Copper );
+
+        // the Dirichlet values must be set before the dofs are indexed
+        for( mesh::Node * tNode : tMesh->nodes() )
+        {
+            if( tNode->x() < 1e-9 )
+            {
+                tField->dof( tField->calculate_dof_id( tNode, 0 ) )->fix( 20.0 );
+            }
+            else if( tNode->x() > 0.4 - 1e-9 )
+            {
+                tField->dof( tField->calculate_dof_id( tNode, 0 ) )->fix( 800.0 );
+            }
+        }
+
+        tField->initialize() ;
+
+        // Picard steps first, so that both updates are used
+        for( uint tIter=0; tIter<8; ++tIter )
+        {
+            tIWG.set_algorithm( tIter < 3 ? SolverAlgorithm::Picard : SolverAlgorithm::NewtonRaphson );
+            tIWG.set_omega( tIter < 3 ? 0.8 : 1.0 );
+
+            tField->compute_jacobian_and_rhs() ;
+            tField->solve() ;
+            tField->residual( tIter );
+        }
+
+        aT = tMesh->field_data( "T" );
+    }
+
+    delete tMesh ;
+}
+
+//------------------------------------------------------------------------------
+
+TEST( FEM, DistributedSolve )
+{
+    Vector< real > tGathered ;
+    solve_heat_problem( false, tGathered );
+
+    Vector< real > tDistributed ;
+    solve_heat_problem( true, tDistributed );
+
+    ASSERT_EQ( tGathered.length(), tDistributed.length() );
+
+    // the values of each proc must be the same in both runs
+    for( index_t k=0; k<tGathered.length(); ++k )
+    {
+        EXPECT_NEAR( tDistributed( k ), tGathered( k ), 1e-8 * std::abs( tGathered( k ) ) );
+    }
+}
+
+//------------------------------------------------------------------------------
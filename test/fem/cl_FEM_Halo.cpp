@@ -0,0 +1,75 @@
+//
+// Created by Christian Messe on 17.10.26.
+//
+
+#include <gtest/gtest.h>
+#include "typedefs.hpp"
+#include "cl_Vector.hpp"
+#include "cl_Cell.hpp"
+#include "cl_HaloExchange.hpp"
+#include "commtools.hpp"
+
+using namespace belfem ;
+
+TEST( FEM, HaloExchange )
+{
+    // two fields with three owned entries followed by three received ones,
+    // the first field stores two values per entity, like an edge field
+    Vector< real > tNodeField = { 1.0, 2.0, 3.0, 0.0, 0.0, 0.0 };
+    Vector< real > tEdgeField = { 1.5, 2.5, 3.5, 4.5, 0.0, 0.0, 0.0, 0.0 };
+
+    // this proc is its own neighbor, so that the test runs in serial
+    Vector< proc_t > tNeighbors( 1, comm_rank() );
+
+    Cell< Vector< index_t > > tSendIndices( 1, Vector< index_t >() );
+    Cell< Vector< index_t > > tReceiveIndices( 1, Vector< index_t >() );
+
+    tSendIndices( 0 ) = { 2, 0, 1 };
+    tReceiveIndices( 0 ) = { 5, 3, 4 };
+
+    HaloExchange tNodeHalo( tNeighbors, tSendIndices, tReceiveIndices );
+
+    tSendIndices( 0 ) = { 0, 1, 2, 3 };
+    tReceiveIndices( 0 ) = { 4, 5, 6, 7 };
+
+    HaloExchange tEdgeHalo( tNeighbors, tSendIndices, tReceiveIndices );
+
+    Cell< Vector< real > * > tNodeFields( 1, & tNodeField );
+    Cell< Vector< real > * > tEdgeFields( 1, & tEdgeField );
+
+    tNodeHalo.start( tNodeFields );
+    tEdgeHalo.start( tEdgeFields );
+
+    EXPECT_TRUE( tNodeHalo.is_active() );
+    EXPECT_TRUE( tEdgeHalo.is_active() );
+
+    // the sent values are packed by start, so changes during
+    // the interior assembly do not reach the neighbors
+    tNodeField( 0 ) = -1.0 ;
+
+    tNodeHalo.finish( tNodeFields );
+    tEdgeHalo.finish( tEdgeFields );
+
+    EXPECT_FALSE( tNodeHalo.is_active() );
+    EXPECT_FALSE( tEdgeHalo.is_active() );
+
+    EXPECT_EQ( tNodeField( 3 ), 1.0 );
+    EXPECT_EQ( tNodeField( 4 ), 2.0 );
+    EXPECT_EQ( tNodeField( 5 ), 3.0 );
+
+    for( index_t k=0; k<4; ++k )
+    {
+        EXPECT_EQ( tEdgeField( k + 4 ), tEdgeField( k ) );
+    }
+
+    // repeated exchanges with more fields reuse the halo
+    Vector< real > tSecondField = { 7.0, 8.0, 9.0, 0.0, 0.0, 0.0 };
+    tNodeFields.push( & tSecondField );
+
+    tNodeHalo.exchange( tNodeFields );
+
+    EXPECT_EQ( tNodeField( 3 ), -1.0 );
+    EXPECT_EQ( tSecondField( 3 ), 7.0 );
+    EXPECT_EQ( tSecondField( 4 ), 8.0 );
+    EXPECT_EQ( tSecondField( 5 ), 9.0 );
+}
@@ -0,0 +1,194 @@
+//
+// Created by Christian Messe on 17.10.26.
+//
+
+#include <gtest/gtest.h>
+#include "typedefs.hpp"
+#include "cl_Vector.hpp"
+#include "cl_Mesh.hpp"
+#include "cl_TensorMeshFactory.hpp"
+#include "cl_FEM_Kernel.hpp"
+#include "cl_FEM_KernelParameters.hpp"
+#include "cl_IWG_Maxwell_HPhi_Tri3.hpp"
+#include "en_FEM_DomainType.hpp"
+
+using namespace belfem ;
+using namespace fem ;
+
+/**
+ * create a tensor mesh and compute the header of its partition file.
+ * The partition is weighted if aCost is positive
+ */
+void
+compute_partition_header(
+        Vector< uint > & aHeader,
+        const bool aMoveNode,
+        const real aCost = 0.0,
+        const bool aBalanceDofs = true )
+{
+    TensorMeshFactory tFactory ;
+    Vector< uint > tNumElems = { 4, 3, 2 };
+    Vector< real > tMinPoint = { 0.0, 0.0, 0.0 };
+    Vector< real > tMaxPoint = { 0.4, 0.3, 0.2 };
+
+    Mesh * tMesh = tFactory.create_tensor_mesh( tNumElems, tMinPoint, tMaxPoint );
+
+    // a change that keeps all counts of the mesh
+    if( aMoveNode )
+    {
+        mesh::Node * tNode = tMesh->nodes()( 0 );
+        tNode->set_coords( tNode->x() - 0.01, tNode->y(), tNode->z() );
+    }
+
+    {
+        KernelParameters tParams( *tMesh );
+
+        if( aCost > 0.0 )
+        {
+            Vector< id_t > tBlocks = { 1 };
+            Vector< real > tCosts = { aCost };
+            tParams.set_partition_weights( tBlocks, tCosts, aBalanceDofs );
+        }
+
+        Kernel tKernel( &tParams );
+        tKernel.partition_header( aHeader );
+    }
+
+    delete tMesh ;
+}
+
+//------------------------------------------------------------------------------
+
+TEST( FEM, PartitionHeader )
+{
+    Vector< uint > tHeader ;
+    Vector< uint > tSameHeader ;
+    Vector< uint > tMovedHeader ;
+
+    compute_partition_header( tHeader, false );
+    compute_partition_header( tSameHeader, false );
+    compute_partition_header( tMovedHeader, true );
+
+    // the same mesh gives the same header
+    ASSERT_EQ( tHeader.length(), tSameHeader.length() );
+    for( index_t k=0; k<tHeader.length(); ++k )
+    {
+        EXPECT_EQ( tHeader( k ), tSameHeader( k ) );
+    }
+
+    // the selected block is part of the header
+    ASSERT_GE( tHeader.length(), 14u );
+    EXPECT_EQ( tHeader( 12 ), 1u );
+    EXPECT_EQ( tHeader( 13 ), 1u );
+
+    // a moved node is detected by the checksum, even though all counts are equal
+    ASSERT_EQ( tHeader.length(), tMovedHeader.length() );
+    for( index_t k=0; k<10; ++k )
+    {
+        EXPECT_EQ( tHeader( k ), tMovedHeader( k ) );
+    }
+    EXPECT_TRUE( tHeader( 10 ) != tMovedHeader( 10 ) || tHeader( 11 ) != tMovedHeader( 11 ) );
+}
+
+//------------------------------------------------------------------------------
+
+/**
+ * returns true if two headers are identical
+ */
+bool
+same_partition_header( const Vector< uint > & aA, const Vector< uint > & aB )
+{
+    if( aA.length() != aB.length() )
+    {
+        return false ;
+    }
+    for( index_t k=0; k<aA.length(); ++k )
+    {
+        if( aA( k ) != aB( k ) )
+        {
+            return false ;
+        }
+    }
+    return true ;
+}
+
+//------------------------------------------------------------------------------
+
+TEST( FEM, PartitionHeaderWeights )
+{
+    Vector< uint > tUnweighted ;
+    Vector< uint > tWeighted ;
+    Vector< uint > tSameWeighted ;
+    Vector< uint > tOtherCost ;
+    Vector< uint > tNoBalance ;
+
+    compute_partition_header( tUnweighted, false );
+    compute_partition_header( tWeighted, false, 4.0 );
+    compute_partition_header( tSameWeighted, false, 4.0 );
+    compute_partition_header( tOtherCost, false, 4.5 );
+    compute_partition_header( tNoBalance, false, 4.0, false );
+
+    // a partition file is only reused with the same weights
+    EXPECT_TRUE( same_partition_header( tWeighted, tSameWeighted ) );
+    EXPECT_FALSE( same_partition_header( tUnweighted, tWeighted ) );
+    EXPECT_FALSE( same_partition_header( tWeighted, tOtherCost ) );
+    EXPECT_FALSE( same_partition_header( tWeighted, tNoBalance ) );
+}
+
+//------------------------------------------------------------------------------
+
+TEST( FEM, PartitionWeights )
+{
+    // the h-phi formulation has edge dofs in conductors and node dofs in air
+    IWG_Maxwell_HPhi_Tri3 tIWG ;
+
+    Vector< uint > tConductorDofs ;
+    Vector< uint > tAirDofs ;
+    tIWG.dofs_per_domain( DomainType::Conductor, tConductorDofs );
+    tIWG.dofs_per_domain( DomainType::Air, tAirDofs );
+
+    ASSERT_EQ( tConductorDofs.length(), 3u );
+    ASSERT_EQ( tAirDofs.length(), 3u );
+    EXPECT_EQ( tConductorDofs( 0 ), 0u );
+    EXPECT_EQ( tConductorDofs( 1 ), 1u );
+    EXPECT_EQ( tAirDofs( 0 ), 1u );
+    EXPECT_EQ( tAirDofs( 1 ), 0u );
+
+    TensorMeshFactory tFactory ;
+    Vector< uint > tNumElems = { 2, 2, 2 };
+    Vector< real > tMinPoint = { 0.0, 0.0, 0.0 };
+    Vector< real > tMaxPoint = { 0.2, 0.2, 0.2 };
+
+    Mesh * tMesh = tFactory.create_tensor_mesh( tNumElems, tMinPoint, tMaxPoint );
+    mesh::Element * tElement = tMesh->elements()( 0 );
+
+    Map< id_t, real > tCosts ;
+    Map< id_t, Vector< uint > > tBlockDofs ;
+
+    // block 1 as air
+    tBlockDofs[ 1 ] = tAirDofs ;
+    tMesh->set_partition_weights( 1, 0, tCosts, tBlockDofs );
+
+    uint tAirNumDofs = tMesh->partition_dofs( tElement );
+    real tAirWork = tMesh->partition_work( tElement );
+
+    EXPECT_EQ( tAirNumDofs, tElement->number_of_nodes() );
+
+    // block 1 as conductor
+    tCosts[ 1 ] = 4.0 ;
+    tBlockDofs[ 1 ] = tConductorDofs ;
+    tMesh->set_partition_weights( 1, 0, tCosts, tBlockDofs );
+
+    uint tConductorNumDofs = tMesh->partition_dofs( tElement );
+    real tConductorWork = tMesh->partition_work( tElement );
+
+    EXPECT_EQ( tConductorNumDofs, tElement->number_of_edges() );
+
+    // both the dofs and the work differ between conductor and air
+    EXPECT_NE( tAirNumDofs, tConductorNumDofs );
+    EXPECT_EQ( tAirWork, ( real ) ( tAirNumDofs * tAirNumDofs ) );
+    EXPECT_EQ( tConductorWork, 4.0 * tConductorNumDofs * tConductorNumDofs );
+    EXPECT_GT( tConductorWork, tAirWork );
+
+    delete tMesh ;
+}
@@ -0,0 +1,93 @@
+//
+// Created by Christian Messe on 17.10.26.
+//
+
+#include <gtest/gtest.h>
+#include "typedefs.hpp"
+#include "cl_Vector.hpp"
+#include "cl_Matrix.hpp"
+#include "Mesh_Enums.hpp"
+#include "cl_IF_IntegrationData.hpp"
+#include "fn_det.hpp"
+#include "fn_inv.hpp"
+
+using namespace belfem ;
+using namespace fem ;
+
+void
+test_batch_geometry( const ElementType aType )
+{
+    IntegrationData tIntegration( aType );
+    tIntegration.populate( 0 );
+
+    const uint tNumPoints = tIntegration.number_of_integration_points() ;
+    const uint tNumNodes  = tIntegration.number_of_nodes() ;
+    const uint tNumDim    = tIntegration.number_of_dimensions() ;
+
+    ASSERT_EQ( tNumDim, 3u );
+
+    Matrix< real > tXiHat ;
+    tIntegration.function()->param_coords( tXiHat );
+
+    // two distorted copies of the reference element
+    const uint tNumElements = 2 ;
+    Cell< Matrix< real > > tX( tNumElements, Matrix< real >( tNumNodes, tNumDim ) );
+    Vector< real > tBatchX( tNumElements * tNumNodes * tNumDim );
+
+    uint tCount = 0 ;
+    for( uint e=0; e<tNumElements; ++e )
+    {
+        for( uint k=0; k<tNumNodes; ++k )
+        {
+            const real tXi   = tXiHat( 0, k );
+            const real tEta  = tXiHat( 1, k );
+            const real tZeta = tXiHat( 2, k );
+
+            tX( e )( k, 0 ) = 2.0 * tXi + 0.1 * tEta + 0.05 * tXi * tZeta + e ;
+            tX( e )( k, 1 ) = 0.2 * tXi + 1.5 * tEta - 0.1 * tEta * tEta ;
+            tX( e )( k, 2 ) = 0.1 * tEta + ( 1.0 + e ) * tZeta ;
+
+            for( uint i=0; i<tNumDim; ++i )
+            {
+                tBatchX( tCount++ ) = tX( e )( k, i );
+            }
+        }
+    }
+
+    Vector< real > tdNdX( tNumElements * tNumPoints * tNumNodes * tNumDim );
+    Vector< real > tDetJ( tNumElements * tNumPoints );
+
+    tIntegration.compute_dNdX( tIntegration, tNumElements,
+                               tBatchX.data(), tdNdX.data(), tDetJ.data() );
+
+    // compare with the matrix based computation
+    tCount = 0 ;
+    for( uint e=0; e<tNumElements; ++e )
+    {
+        for( uint k=0; k<tNumPoints; ++k )
+        {
+            Matrix< real > tJ = tIntegration.dNdXi( k ) * tX( e );
+            Matrix< real > tB = inv( tJ ) * tIntegration.dNdXi( k );
+
+            EXPECT_NEAR( tDetJ( e * tNumPoints + k ), std::abs( det( tJ ) ), 1e-12 );
+
+            for( uint n=0; n<tNumNodes; ++n )
+            {
+                for( uint i=0; i<tNumDim; ++i )
+                {
+                    EXPECT_NEAR( tdNdX( tCount++ ), tB( i, n ), 1e-10 );
+                }
+            }
+        }
+    }
+}
+
+TEST( GEOMETRY, BATCH_HEX27 )
+{
+    test_batch_geometry( ElementType::HEX27 );
+}
+
+TEST( GEOMETRY, BATCH_TET10 )
+{
+    test_batch_geometry( ElementType::TET10 );
+}
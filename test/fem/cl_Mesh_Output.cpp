@@ -0,0 +1,180 @@
+//
+// Created by Christian Messe on 17.10.26.
+//
+
+#include <gtest/gtest.h>
+#include <fstream>
+#include <iterator>
+#include <thread>
+#include <chrono>
+#include <cstdio>
+
+#include "typedefs.hpp"
+#include "cl_Vector.hpp"
+#include "cl_Cell.hpp"
+#include "cl_Mesh.hpp"
+#include "cl_TensorMeshFactory.hpp"
+#include "cl_AsyncWriter.hpp"
+
+#ifdef BELFEM_EXODUS
+#include "exodusII.h"
+#endif
+
+using namespace belfem ;
+
+/**
+ * read a file into a string
+ */
+string
+read_file( const string & aPath )
+{
+    std::ifstream tFile( aPath, std::ios::binary );
+    return string( std::istreambuf_iterator< char >( tFile ),
+                   std::istreambuf_iterator< char >() );
+}
+
+//------------------------------------------------------------------------------
+
+TEST( MESH, AsyncWriterOrder )
+{
+    Cell< int > tWritten ;
+
+    // the limit only allows one staged job, so that push has to wait
+    AsyncWriter tWriter( 8 );
+
+    for( int k=0; k<5; ++k )
+    {
+        tWriter.push( [ &tWritten, k ]()
+                      {
+                          std::this_thread::sleep_for( std::chrono::milliseconds( 2 ) );
+                          tWritten.push( k );
+
+                          return string() ;
+                      }, 8 );
+    }
+
+    tWriter.flush() ;
+
+    // all jobs are written, in the order in which they were pushed
+    ASSERT_EQ( tWritten.size(), 5u );
+    for( int k=0; k<5; ++k )
+    {
+        EXPECT_EQ( tWritten( k ), k );
+    }
+    EXPECT_EQ( tWriter.staged_bytes(), 0u );
+}
+
+//------------------------------------------------------------------------------
+
+TEST( MESH, AsyncWriterShutdown )
+{
+    Cell< int > tWritten ;
+
+    {
+        AsyncWriter tWriter ;
+
+        for( int k=0; k<3; ++k )
+        {
+            tWriter.push( [ &tWritten, k ]()
+                          {
+                              std::this_thread::sleep_for( std::chrono::milliseconds( 5 ) );
+                              tWritten.push( k );
+
+                              return string() ;
+                          }, 1 );
+        }
+
+        // the destructor writes the remaining jobs and joins the thread
+    }
+
+    EXPECT_EQ( tWritten.size(), 3u );
+}
+
+//------------------------------------------------------------------------------
+
+TEST( MESH, AsyncWriterError )
+{
+    AsyncWriter tWriter ;
+
+    tWriter.push( []() { return string( "disk full" ); }, 1 );
+
+#if !defined( NDEBUG ) || defined( DEBUG )
+    // the status of the job is raised on the calling thread
+    EXPECT_ANY_THROW( tWriter.flush() );
+#endif
+}
+
+//------------------------------------------------------------------------------
+
+#ifdef BELFEM_EXODUS
+TEST( MESH, ExodusAppend )
+{
+    TensorMeshFactory tFactory ;
+    Vector< uint > tNumElems = { 3, 2, 2 };
+    Vector< real > tMinPoint = { 0.0, 0.0, 0.0 };
+    Vector< real > tMaxPoint = { 0.3, 0.2, 0.2 };
+
+    Mesh * tMesh = tFactory.create_tensor_mesh( tNumElems, tMinPoint, tMaxPoint );
+
+    Vector< real > & tT = tMesh->create_field( "T" );
+
+    const string tSyncPath  = "/tmp/belfem_sync.exo" ;
+    const string tAsyncPath = "/tmp/belfem_async.exo" ;
+
+    // synchronous time series
+    for( uint s=0; s<3; ++s )
+    {
+        tMesh->time_stamp() = 0.5 * s ;
+        tT.fill( 20.0 + s );
+        tMesh->append( tSyncPath );
+    }
+    tMesh->close_time_series() ;
+
+    // the same series, written by the background thread
+    {
+        AsyncWriter tWriter ;
+
+        for( uint s=0; s<3; ++s )
+        {
+            tMesh->time_stamp() = 0.5 * s ;
+            tT.fill( 20.0 + s );
+            tMesh->append( tAsyncPath, tWriter );
+
+            // changing the field must not change the staged step
+            tT.fill( -1.0 );
+        }
+
+        // flushes the writer before it goes out of scope
+        tMesh->close_time_series() ;
+    }
+
+    // each step is appended, and not written into a new file
+    int tCpuWordSize = sizeof( real );
+    int tIoWordSize = 0 ;
+    float tVersion ;
+
+    int tHandle = ex_open( tSyncPath.c_str(), EX_READ, & tCpuWordSize, & tIoWordSize, & tVersion );
+    ASSERT_GE( tHandle, 0 );
+    EXPECT_EQ( ex_inquire_int( tHandle, EX_INQ_TIME ), 3 );
+
+    for( int s=0; s<3; ++s )
+    {
+        real tTime = -1.0 ;
+        ex_get_time( tHandle, s + 1, & tTime );
+        EXPECT_EQ( tTime, 0.5 * s );
+    }
+    ex_close( tHandle );
+
+    // both files are identical
+    string tSync  = read_file( tSyncPath );
+    string tAsync = read_file( tAsyncPath );
+
+    EXPECT_GT( tSync.length(), 0u );
+    EXPECT_TRUE( tSync == tAsync );
+
+    std::remove( tSyncPath.c_str() );
+    std::remove( tAsyncPath.c_str() );
+
+    delete tMesh ;
+}
+#endif
@@ -0,0 +1,190 @@
+//
+// Created by Christian Messe on 17.10.26.
+//
+
+#include <gtest/gtest.h>
+#include <fstream>
+#include <iterator>
+#include <cstdint>
+#include <cstdio>
+
+#include "typedefs.hpp"
+#include "cl_Mesh.hpp"
+
+using namespace belfem ;
+
+/**
+ * write a small Gmsh 4.1 file with two triangles and one boundary line
+ */
+void
+write_gmsh_file( const string & aPath, const bool aBinary )
+{
+    real tX[ 4 ] = { 0.0, 1.0, 1.0, 0.0 };
+    real tY[ 4 ] = { 0.0, 0.0, 1.0, 1.0 };
+
+    // node tags of the elements
+    luint tTriangles[ 2 ][ 3 ] = { { 1, 2, 3 }, { 1, 3, 4 } };
+    luint tLine[ 2 ] = { 1, 2 };
+
+    std::ofstream tFile( aPath, std::ios::binary );
+
+    if( aBinary )
+    {
+        int tOne = 1 ;
+
+        auto tInt = [ & ]( const int aValue )
+        {
+            tFile.write( reinterpret_cast< const char * >( & aValue ), sizeof( int ) );
+        };
+
+        auto tSize = [ & ]( const uint64_t aValue )
+        {
+            tFile.write( reinterpret_cast< const char * >( & aValue ), 8 );
+        };
+
+        auto tReal = [ & ]( const real aValue )
+        {
+            tFile.write( reinterpret_cast< const char * >( & aValue ), sizeof( real ) );
+        };
+
+        tFile << "$MeshFormat\n4.1 1 8\n" ;
+        tInt( tOne );
+        tFile << "\n$EndMeshFormat\n" ;
+
+        tFile << "$Nodes\n" ;
+        tSize( 1 ); tSize( 4 ); tSize( 1 ); tSize( 4 );
+        tInt( 2 ); tInt( 1 ); tInt( 0 ); tSize( 4 );
+        for( uint k=0; k<4; ++k )
+        {
+            tSize( k + 1 );
+        }
+        for( uint k=0; k<4; ++k )
+        {
+            tReal( tX[ k ] ); tReal( tY[ k ] ); tReal( 0.0 );
+        }
+        tFile << "\n$EndNodes\n" ;
+
+        tFile << "$Elements\n" ;
+        tSize( 2 ); tSize( 3 ); tSize( 1 ); tSize( 3 );
+        tInt( 1 ); tInt( 2 ); tInt( 1 ); tSize( 1 );
+        tSize( 1 ); tSize( tLine[ 0 ] ); tSize( tLine[ 1 ] );
+        tInt( 2 ); tInt( 1 ); tInt( 2 ); tSize( 2 );
+        for( uint e=0; e<2; ++e )
+        {
+            tSize( e + 2 );
+            for( uint k=0; k<3; ++k )
+            {
+                tSize( tTriangles[ e ][ k ] );
+            }
+        }
+        tFile << "\n$EndElements\n" ;
+    }
+    else
+    {
+        tFile << "$MeshFormat\n4.1 0 8\n$EndMeshFormat\n" ;
+
+        tFile << "$Nodes\n1 4 1 4\n2 1 0 4\n" ;
+        for( uint k=0; k<4; ++k )
+        {
+            tFile << k + 1 << "\n" ;
+        }
+        for( uint k=0; k<4; ++k )
+        {
+            tFile << tX[ k ] << " " << tY[ k ] << " 0\n" ;
+        }
+        tFile << "$EndNodes\n" ;
+
+        tFile << "$Elements\n2 3 1 3\n" ;
+        tFile << "1 2 1 1\n1 " << tLine[ 0 ] << " " << tLine[ 1 ] << "\n" ;
+        tFile << "2 1 2 2\n" ;
+        for( uint e=0; e<2; ++e )
+        {
+            tFile << e + 2 << " " << tTriangles[ e ][ 0 ] << " "
+                  << tTriangles[ e ][ 1 ] << " " << tTriangles[ e ][ 2 ] << "\n" ;
+        }
+        tFile << "$EndElements\n" ;
+    }
+}
+
+//------------------------------------------------------------------------------
+
+TEST( MESH, GmshBinary )
+{
+    const string tAsciiPath  = "/tmp/belfem_ascii.msh" ;
+    const string tBinaryPath = "/tmp/belfem_binary.msh" ;
+
+    write_gmsh_file( tAsciiPath, false );
+    write_gmsh_file( tBinaryPath, true );
+
+    Mesh tAscii( tAsciiPath );
+    Mesh tBinary( tBinaryPath );
+
+    ASSERT_EQ( tAscii.number_of_nodes(), 4u );
+    ASSERT_EQ( tAscii.number_of_nodes(), tBinary.number_of_nodes() );
+    ASSERT_EQ( tAscii.number_of_elements(), tBinary.number_of_elements() );
+    EXPECT_EQ( tAscii.number_of_blocks(), tBinary.number_of_blocks() );
+    EXPECT_EQ( tAscii.number_of_sidesets(), tBinary.number_of_sidesets() );
+
+    // both readers create the same nodes
+    for( index_t k=0; k<tAscii.number_of_nodes(); ++k )
+    {
+        mesh::Node * tA = tAscii.nodes()( k );
+        mesh::Node * tB = tBinary.nodes()( k );
+
+        EXPECT_EQ( tA->id(), tB->id() );
+        EXPECT_EQ( tA->x(), tB->x() );
+        EXPECT_EQ( tA->y(), tB->y() );
+        EXPECT_EQ( tA->z(), tB->z() );
+    }
+
+    // and the same elements
+    for( index_t e=0; e<tAscii.number_of_elements(); ++e )
+    {
+        mesh::Element * tA = tAscii.elements()( e );
+        mesh::Element * tB = tBinary.elements()( e );
+
+        EXPECT_EQ( tA->id(), tB->id() );
+        ASSERT_EQ( tA->number_of_nodes(), tB->number_of_nodes() );
+
+        for( uint k=0; k<tA->number_of_nodes(); ++k )
+        {
+            EXPECT_EQ( tA->node( k )->id(), tB->node( k )->id() );
+        }
+    }
+
+    std::remove( tAsciiPath.c_str() );
+    std::remove( tBinaryPath.c_str() );
+}
+
+//------------------------------------------------------------------------------
+
+TEST( MESH, GmshTruncated )
+{
+    const string tPath = "/tmp/belfem_truncated.msh" ;
+    const string tCutPath = "/tmp/belfem_truncated_cut.msh" ;
+
+    write_gmsh_file( tPath, false );
+
+    std::ifstream tIn( tPath, std::ios::binary );
+    string tContent = string( std::istreambuf_iterator< char >( tIn ),
+                              std::istreambuf_iterator< char >() );
+    tIn.close() ;
+
+    // cut the file in the middle of the last element, so that
+    // the last number ends at the end of the mapped memory
+    size_t tCut = tContent.find( "$EndElements" ) - 3 ;
+
+    std::ofstream tOut( tCutPath, std::ios::binary );
+    tOut << tContent.substr( 0, tCut );
+    tOut.close() ;
+
+#if !defined( NDEBUG ) || defined( DEBUG )
+    // the reader must stop at the end of the file
+    EXPECT_ANY_THROW( Mesh tMesh( tCutPath ) );
+#endif
+
+    std::remove( tPath.c_str() );
+    std::remove( tCutPath.c_str() );
+}
+
+//------------------------------------------------------------------------------
@@ -0,0 +1,54 @@
+//
+// Created by Christian Messe on 17.10.26.
+//
+
+#include <cmath>
+#include <gtest/gtest.h>
+#include "typedefs.hpp"
+#include "cl_Vector.hpp"
+#include "cl_Mesh.hpp"
+#include "cl_TensorMeshFactory.hpp"
+
+using namespace belfem ;
+
+#ifdef BELFEM_HDF5
+TEST( MESH, HDF5FieldPrecision )
+{
+    TensorMeshFactory tFactory ;
+    Vector< uint > tNumElems = { 6, 5, 4 };
+    Vector< real > tMinPoint = { 0.0, 0.0, 0.0 };
+    Vector< real > tMaxPoint = { 0.3, 0.2, 0.1 };
+
+    Mesh * tMesh = tFactory.create_tensor_mesh( tNumElems, tMinPoint, tMaxPoint );
+
+    Vector< real > & tT = tMesh->create_field( "T" );
+    for( index_t k=0; k<tMesh->number_of_nodes(); ++k )
+    {
+        tT( k ) = 20.0 + 1000.0 * std::sin( 7.0 * tMesh->nodes()( k )->x() );
+    }
+
+    string tPath = "/tmp/test_mesh_precision.hdf5" ;
+
+    // the fields keep three digits, the coordinates are exact
+    tMesh->set_field_precision( 3 );
+    tMesh->save( tPath );
+
+    Mesh tLoaded( tPath );
+
+    ASSERT_EQ( tLoaded.number_of_nodes(), tMesh->number_of_nodes() );
+
+    const Vector< real > & tLoadedT = tLoaded.field_data( "T" );
+
+    for( index_t k=0; k<tMesh->number_of_nodes(); ++k )
+    {
+        EXPECT_EQ( tLoaded.nodes()( k )->x(), tMesh->nodes()( k )->x() );
+        EXPECT_EQ( tLoaded.nodes()( k )->y(), tMesh->nodes()( k )->y() );
+        EXPECT_EQ( tLoaded.nodes()( k )->z(), tMesh->nodes()( k )->z() );
+        EXPECT_NEAR( tLoadedT( k ), tT( k ), 1e-3 );
+    }
+
+    delete tMesh ;
+}
+#endif
+
+//------------------------------------------------------------------------------
@@ -0,0 +1,75 @@
+//
+// Created by Christian Messe on 17.10.26.
+//
+
+#include <cmath>
+#include <gtest/gtest.h>
+
+#include "typedefs.hpp"
+#include "cl_Vector.hpp"
+#include "cl_MaterialTable.hpp"
+#include "cl_Material_Copper.hpp"
+
+using namespace belfem;
+
+TEST( MATERIALS, MaterialTable )
+{
+//------------------------------------------------------------------------------
+/**
+ * A function that spans several orders of magnitude. The error must be
+ * small relative to the local value, also where the function is small.
+ */
+//------------------------------------------------------------------------------
+
+    auto tFunction = []( const real aT ) { return std::exp( 0.01 * aT ); };
+
+    MaterialTable tTable( tFunction, 0.0, 2000.0, 1e-6 );
+
+    EXPECT_LE( tTable.error(), 1e-6 );
+
+    Vector< real > tT = { 0.3, 1.7, 12.5, 99.9, 1001.1, 1888.8, 1999.7 };
+
+    for( real tX : tT )
+    {
+        EXPECT_NEAR( tTable.eval( tX ), tFunction( tX ), 2e-6 * tFunction( tX ) );
+    }
+}
+
+//------------------------------------------------------------------------------
+
+TEST( MATERIALS, CopperTable )
+{
+//------------------------------------------------------------------------------
+/**
+ * Copper with tables is compared with the functions it tabulates.
+ * At low temperatures, the specific heat is many orders of magnitude
+ * below its value at room temperature.
+ */
+//------------------------------------------------------------------------------
+
+    material::Copper tCopper ;
+    material::Copper tTable ;
+    tTable.use_tables( true, 1e-6 );
+
+    Vector< real > tLow  = { 2.0, 4.2, 7.7, 15.0, 30.0 };
+    Vector< real > tHigh = { 293.15, 500.0, 800.0, 1100.0, 1300.0 };
+
+    for( uint l=0; l<2; ++l )
+    {
+        const Vector< real > & tT = l == 0 ? tLow : tHigh ;
+
+        for( real tX : tT )
+        {
+            real tExpect = tCopper.c( tX );
+            EXPECT_NEAR( tTable.c( tX ), tExpect, 1e-4 * std::abs( tExpect ) );
+
+            tExpect = tCopper.lambda( tX );
+            EXPECT_NEAR( tTable.lambda( tX ), tExpect, 1e-4 * std::abs( tExpect ) );
+
+            tExpect = tCopper.rho_el( 0.0, tX );
+            EXPECT_NEAR( tTable.rho_el( 0.0, tX ), tExpect, 1e-4 * std::abs( tExpect ) );
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
@@ -0,0 +1,59 @@
+//
+// Created by Christian Messe on 17.10.26.
+//
+
+#include <cmath>
+#include <gtest/gtest.h>
+
+#include "typedefs.hpp"
+#include "cl_Vector.hpp"
+#include "cl_Cell.hpp"
+#include "cl_BS_GasTableBuilder.hpp"
+
+using namespace belfem;
+using namespace bspline;
+
+TEST( TABLEGAS, GasTableBuilder )
+{
+//------------------------------------------------------------------------------
+/**
+ * This test builds the same table with one and with four threads. Since
+ * the threads start their warm starts at different points, the properties
+ * must not depend on where a slice starts.
+ */
+//------------------------------------------------------------------------------
+
+    Cell< string > tSpecies = { "N2", "O2", "NO", "N", "O" };
+    Vector< real > tMolarFractions = { 0.79, 0.21, 0.0, 0.0, 0.0 };
+
+    Vector< index_t > tNumElems = { 6, 2 };
+
+    // T in K and 1000 * log10( p ) with p in Pa
+    Vector< real > tMinPoint = { 200.0, 3000.0 };
+    Vector< real > tMaxPoint = { 6000.0, 6000.0 };
+
+    GasTableBuilder tSerial( tSpecies, tMolarFractions, tNumElems, tMinPoint, tMaxPoint );
+    tSerial.set_number_of_threads( 1 );
+    tSerial.compute() ;
+
+    GasTableBuilder tParallel( tSpecies, tMolarFractions, tNumElems, tMinPoint, tMaxPoint );
+    tParallel.set_number_of_threads( 4 );
+    tParallel.compute() ;
+
+    // M, h, s, mu, lambda and hd
+    ASSERT_EQ( tSerial.mapper().number_of_fields(), tParallel.mapper().number_of_fields() );
+
+    for( index_t f=0; f<tSerial.mapper().number_of_fields(); ++f )
+    {
+        const Vector< real > & tExpect = tSerial.mapper().field( f );
+        const Vector< real > & tValues = tParallel.mapper().field( f );
+
+        ASSERT_EQ( tExpect.length(), tValues.length() );
+
+        for( index_t k=0; k<tExpect.length(); ++k )
+        {
+            // the equilibrium is converged to about 1e-9
+            EXPECT_NEAR( tValues( k ), tExpect( k ), 1e-6 * std::abs( tExpect( k ) ) + 1e-9 );
+        }
+    }
+}
@@ -0,0 +1,188 @@
+//
+// Created by Christian Messe on 17.10.26.
+//
+
+#include <cmath>
+#include <gtest/gtest.h>
+
+#include "typedefs.hpp"
+#include "cl_Vector.hpp"
+#include "cl_Matrix.hpp"
+#include "cl_Cell.hpp"
+#include "threadtools.hpp"
+#include "cl_Gas.hpp"
+#include "cl_TableGas.hpp"
+#include "cl_GM_GasContext.hpp"
+#include "cl_BS_GasTableBuilder.hpp"
+
+using namespace belfem;
+
+// number of properties that are compared
+const uint gContextNumProperties = 11 ;
+
+//------------------------------------------------------------------------------
+
+/**
+ * ( T, p ) points inside the test table
+ */
+void
+create_context_points( Vector< real > & aT, Vector< real > & aP )
+{
+    index_t tNumPoints = 41 ;
+
+    aT.set_size( tNumPoints );
+    aP.set_size( tNumPoints );
+
+    for( index_t k=0; k<tNumPoints; ++k )
+    {
+        real tXi = ( real ) k / ( real ) ( tNumPoints - 1 );
+        aT( k ) = 300.0 + 5500.0 * tXi ;
+        aP( k ) = std::pow( 10.0, 3.1 + 2.8 * std::abs( std::cos( 7.0 * tXi ) ) );
+    }
+}
+
+//------------------------------------------------------------------------------
+
+/**
+ * write the properties of one point into a column of aValues
+ */
+template< typename T >
+void
+evaluate_context_properties(
+        T & aGas,
+        const real aT,
+        const real aP,
+        Matrix< real > & aValues,
+        const index_t aColumn )
+{
+    aValues(  0, aColumn ) = aGas.M( aT, aP );
+    aValues(  1, aColumn ) = aGas.R( aT, aP );
+    aValues(  2, aColumn ) = aGas.cp( aT, aP );
+    aValues(  3, aColumn ) = aGas.cv( aT, aP );
+    aValues(  4, aColumn ) = aGas.gamma( aT, aP );
+    aValues(  5, aColumn ) = aGas.c( aT, aP );
+    aValues(  6, aColumn ) = aGas.h( aT, aP );
+    aValues(  7, aColumn ) = aGas.s( aT, aP );
+    aValues(  8, aColumn ) = aGas.mu( aT, aP );
+    aValues(  9, aColumn ) = aGas.lambda( aT, aP );
+    aValues( 10, aColumn ) = aGas.Pr( aT, aP );
+}
+
+//------------------------------------------------------------------------------
+
+void
+expect_same_properties( const Matrix< real > & aExpect, const Matrix< real > & aValues )
+{
+    for( index_t k=0; k<aExpect.n_cols(); ++k )
+    {
+        for( uint i=0; i<gContextNumProperties; ++i )
+        {
+            EXPECT_NEAR( aValues( i, k ), aExpect( i, k ), 1e-12 * std::abs( aExpect( i, k ) ) + 1e-9 );
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+
+/**
+ * compare the contexts of a gas with its scalar functions, first with
+ * one context, then with one context per thread working at the same time
+ */
+void
+compare_contexts( Gas & aGas )
+{
+    Vector< real > tT ;
+    Vector< real > tP ;
+    create_context_points( tT, tP );
+
+    index_t tNumPoints = tT.length() ;
+
+    Matrix< real > tExpect( gContextNumProperties, tNumPoints );
+    for( index_t k=0; k<tNumPoints; ++k )
+    {
+        evaluate_context_properties( aGas, tT( k ), tP( k ), tExpect, k );
+    }
+
+    // one context
+    {
+        gasmodels::GasContext * tContext = aGas.create_context() ;
+
+        Matrix< real > tValues( gContextNumProperties, tNumPoints );
+        for( index_t k=0; k<tNumPoints; ++k )
+        {
+            evaluate_context_properties( *tContext, tT( k ), tP( k ), tValues, k );
+        }
+
+        delete tContext ;
+
+        expect_same_properties( tExpect, tValues );
+    }
+
+    // concurrent contexts, each thread starts at another point,
+    // so that the caches of the contexts hold different states
+    uint tNumThreads = 4 ;
+
+    Cell< gasmodels::GasContext * > tContexts( tNumThreads, nullptr );
+    Cell< Matrix< real > > tValues( tNumThreads, Matrix< real >( gContextNumProperties, tNumPoints ) );
+
+    for( uint t=0; t<tNumThreads; ++t )
+    {
+        tContexts( t ) = aGas.create_context() ;
+    }
+
+#ifdef OMP
+#pragma omp parallel for num_threads( tNumThreads ) schedule( static, 1 )
+#endif
+    for( uint t=0; t<tNumThreads; ++t )
+    {
+        for( index_t j=0; j<tNumPoints; ++j )
+        {
+            index_t k = ( j + 7 * t ) % tNumPoints ;
+            evaluate_context_properties( *tContexts( t ), tT( k ), tP( k ), tValues( t ), k );
+        }
+    }
+
+    for( uint t=0; t<tNumThreads; ++t )
+    {
+        delete tContexts( t );
+        expect_same_properties( tExpect, tValues( t ) );
+    }
+}
+
+//------------------------------------------------------------------------------
+
+TEST( TABLEGAS, GasContext )
+{
+    Cell< string > tSpecies = { "N2", "O2", "Ar" };
+    Vector< real > tMolarFractions = { 0.7812, 0.2096, 0.0092 };
+
+    Gas tAir( tSpecies, tMolarFractions );
+
+    compare_contexts( tAir );
+}
+
+//------------------------------------------------------------------------------
+
+TEST( TABLEGAS, TableGasContext )
+{
+    Cell< string > tSpecies = { "N2", "O2", "NO", "N", "O" };
+    Vector< real > tMolarFractions = { 0.79, 0.21, 0.0, 0.0, 0.0 };
+
+    Vector< index_t > tNumElems = { 6, 2 };
+    Vector< real > tMinPoint = { 200.0, 3000.0 };
+    Vector< real > tMaxPoint = { 6000.0, 6000.0 };
+
+    string tPath = "/tmp/test_tablegas_context.hdf5" ;
+
+    {
+        bspline::GasTableBuilder tBuilder( tSpecies, tMolarFractions, tNumElems, tMinPoint, tMaxPoint );
+        tBuilder.compute() ;
+        tBuilder.save( tPath );
+    }
+
+    TableGas tGas( tPath );
+
+    compare_contexts( tGas );
+}
+
+//------------------------------------------------------------------------------
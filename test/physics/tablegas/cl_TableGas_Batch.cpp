@@ -0,0 +1,131 @@
+//
+// Created by Christian Messe on 17.10.26.
+//
+
+#include <cmath>
+#include <gtest/gtest.h>
+
+#include "typedefs.hpp"
+#include "cl_Vector.hpp"
+#include "cl_Cell.hpp"
+#include "cl_Gas.hpp"
+#include "cl_TableGas.hpp"
+#include "cl_BS_GasTableBuilder.hpp"
+
+using namespace belfem;
+
+//------------------------------------------------------------------------------
+
+/**
+ * ( T, p ) points inside the test table. The number of points is odd,
+ * so that the columns of the batch matrices are padded if the
+ * matrix library does so.
+ */
+void
+create_batch_points( Vector< real > & aT, Vector< real > & aP )
+{
+    index_t tNumPoints = 37 ;
+
+    aT.set_size( tNumPoints );
+    aP.set_size( tNumPoints );
+
+    for( index_t k=0; k<tNumPoints; ++k )
+    {
+        real tXi = ( real ) k / ( real ) ( tNumPoints - 1 );
+        aT( k ) = 300.0 + 5500.0 * tXi ;
+        aP( k ) = std::pow( 10.0, 3.1 + 2.8 * std::abs( std::sin( 5.0 * tXi ) ) );
+    }
+}
+
+//------------------------------------------------------------------------------
+
+/**
+ * compare the batched properties of a gas with its scalar functions
+ */
+void
+compare_batched_properties( Gas & aGas )
+{
+    Vector< real > tT ;
+    Vector< real > tP ;
+    create_batch_points( tT, tP );
+
+    Vector< real > tM ;
+    Vector< real > tCp ;
+    Vector< real > tH ;
+    Vector< real > tS ;
+    Vector< real > tMu ;
+    Vector< real > tLambda ;
+
+    aGas.M( tT, tP, tM );
+    aGas.cp( tT, tP, tCp );
+    aGas.h( tT, tP, tH );
+    aGas.s( tT, tP, tS );
+    aGas.mu( tT, tP, tMu );
+    aGas.lambda( tT, tP, tLambda );
+
+    ASSERT_EQ( tM.length(), tT.length() );
+    ASSERT_EQ( tCp.length(), tT.length() );
+    ASSERT_EQ( tH.length(), tT.length() );
+    ASSERT_EQ( tS.length(), tT.length() );
+    ASSERT_EQ( tMu.length(), tT.length() );
+    ASSERT_EQ( tLambda.length(), tT.length() );
+
+    for( index_t k=0; k<tT.length(); ++k )
+    {
+        real tExpect = aGas.M( tT( k ), tP( k ) );
+        EXPECT_NEAR( tM( k ), tExpect, 1e-12 * std::abs( tExpect ) );
+
+        tExpect = aGas.cp( tT( k ), tP( k ) );
+        EXPECT_NEAR( tCp( k ), tExpect, 1e-12 * std::abs( tExpect ) );
+
+        tExpect = aGas.h( tT( k ), tP( k ) );
+        EXPECT_NEAR( tH( k ), tExpect, 1e-12 * std::abs( tExpect ) + 1e-9 );
+
+        tExpect = aGas.s( tT( k ), tP( k ) );
+        EXPECT_NEAR( tS( k ), tExpect, 1e-12 * std::abs( tExpect ) + 1e-9 );
+
+        tExpect = aGas.mu( tT( k ), tP( k ) );
+        EXPECT_NEAR( tMu( k ), tExpect, 1e-12 * std::abs( tExpect ) );
+
+        tExpect = aGas.lambda( tT( k ), tP( k ) );
+        EXPECT_NEAR( tLambda( k ), tExpect, 1e-12 * std::abs( tExpect ) );
+    }
+}
+
+//------------------------------------------------------------------------------
+
+TEST( TABLEGAS, BatchedGas )
+{
+    Cell< string > tSpecies = { "N2", "O2", "Ar" };
+    Vector< real > tMolarFractions = { 0.7812, 0.2096, 0.0092 };
+
+    Gas tAir( tSpecies, tMolarFractions );
+
+    compare_batched_properties( tAir );
+}
+
+//------------------------------------------------------------------------------
+
+TEST( TABLEGAS, BatchedTableGas )
+{
+    Cell< string > tSpecies = { "N2", "O2", "NO", "N", "O" };
+    Vector< real > tMolarFractions = { 0.79, 0.21, 0.0, 0.0, 0.0 };
+
+    Vector< index_t > tNumElems = { 6, 2 };
+    Vector< real > tMinPoint = { 200.0, 3000.0 };
+    Vector< real > tMaxPoint = { 6000.0, 6000.0 };
+
+    string tPath = "/tmp/test_tablegas.hdf5" ;
+
+    {
+        bspline::GasTableBuilder tBuilder( tSpecies, tMolarFractions, tNumElems, tMinPoint, tMaxPoint );
+        tBuilder.compute() ;
+        tBuilder.save( tPath );
+    }
+
+    TableGas tGas( tPath );
+
+    compare_batched_properties( tGas );
+}
+
+//------------------------------------------------------------------------------
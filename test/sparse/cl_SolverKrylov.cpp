@@ -0,0 +1,110 @@
+//
+// Created by Christian Messe on 17.10.26.
+//
+
+#include <gtest/gtest.h>
+
+#include "typedefs.hpp"
+#include "cl_Vector.hpp"
+#include "cl_Matrix.hpp"
+#include "cl_SpMatrix.hpp"
+#include "cl_Solver.hpp"
+#include "cl_SolverKrylov.hpp"
+#include "fn_r2.hpp"
+
+using namespace belfem;
+
+TEST( SOLVER, KRYLOV_SPD )
+{
+    // discrete laplace operator
+    index_t tN = 20 ;
+    Matrix< real > tA( tN, tN, 0.0 );
+
+    for( index_t k=0; k<tN; ++k )
+    {
+        tA( k, k ) = 2.0 ;
+        if( k > 0 )
+        {
+            tA( k, k-1 ) = -1.0 ;
+            tA( k-1, k ) = -1.0 ;
+        }
+    }
+
+    Vector< real > tExpect( tN );
+    for( index_t k=0; k<tN; ++k )
+    {
+        tExpect( k ) = 1.0 + k ;
+    }
+
+    Vector< real > tY( tN, 0.0 );
+    for( index_t i=0; i<tN; ++i )
+    {
+        for( index_t j=0; j<tN; ++j )
+        {
+            tY( i ) += tA( i, j ) * tExpect( j );
+        }
+    }
+
+    SpMatrix tM( tA, SpMatrixType::CSC );
+
+    // CG with IC(0)
+    Vector< real > tX( tN, 0.0 );
+    Solver tCG( SolverType::KRYLOV );
+    tCG.set_symmetry_mode( SymmetryMode::PositiveDefiniteSymmetric );
+    tCG.set_krylov( Preconditioner::ICC, KrylovMethod::CG, 1e-12 );
+    tCG.solve( tM, tX, tY );
+    EXPECT_NEAR( r2( tX, tExpect ), 1.0, 1e-9 );
+
+    // warm start from the exact solution must not iterate
+    tX = tExpect ;
+    tCG.solve( tM, tX, tY );
+    EXPECT_NEAR( r2( tX, tExpect ), 1.0, 1e-9 );
+    EXPECT_EQ( reinterpret_cast< solver::Krylov * >( tCG.wrapper() )->number_of_iterations(), 0u );
+
+    // CG with Jacobi
+    tX.fill( 0.0 );
+    Solver tJacobi( SolverType::KRYLOV );
+    tJacobi.set_krylov( Preconditioner::JACOBI, KrylovMethod::CG, 1e-12 );
+    tJacobi.solve( tM, tX, tY );
+    EXPECT_NEAR( r2( tX, tExpect ), 1.0, 1e-9 );
+}
+
+TEST( SOLVER, KRYLOV_UNSYMMETRIC )
+{
+    Matrix <real> tA( 5, 5, 0.0 );
+
+    tA( 0, 0 ) =  1.0;
+    tA( 0, 1 ) = -1.0;
+    tA( 0, 3 ) = -3.0;
+    tA( 1, 0 ) = -2.0;
+    tA( 1, 1 ) =  5.0;
+    tA( 2, 2 ) =  4.0;
+    tA( 2, 3 ) =  6.0;
+    tA( 2, 4 ) =  4.0;
+    tA( 3, 0 ) = -4.0;
+    tA( 3, 2 ) =  2.0;
+    tA( 3, 3 ) =  7.0;
+    tA( 4, 1 ) =  8.0;
+    tA( 4, 4 ) = -5.0;
+
+    Vector< real > tY = { -13., 8., 56., 30., -9. };
+    Vector< real > tExpect = { 1., 2., 3., 4., 5. };
+
+    // GMRES with ILU(0) on a CSR matrix
+    SpMatrix tCSR( tA, SpMatrixType::CSR );
+    Vector< real > tX( 5, 0.0 );
+
+    Solver tGMRES( SolverType::KRYLOV );
+    tGMRES.set_krylov( Preconditioner::ILU, KrylovMethod::GMRES, 1e-12 );
+    tGMRES.solve( tCSR, tX, tY );
+    EXPECT_NEAR( r2( tX, tExpect ), 1.0, 1e-9 );
+
+    // BiCGStab with ILU(0) on a CSC matrix
+    SpMatrix tCSC( tA, SpMatrixType::CSC );
+    tX.fill( 0.0 );
+
+    Solver tBCGS( SolverType::KRYLOV );
+    tBCGS.set_krylov( Preconditioner::ILU, KrylovMethod::BCGS, 1e-12 );
+    tBCGS.solve( tCSC, tX, tY );
+    EXPECT_NEAR( r2( tX, tExpect ), 1.0, 1e-9 );
+}
@@ -0,0 +1,157 @@
+//
+// Created by Christian Messe on 17.10.26.
+//
+#include <cstdio>
+#include <fstream>
+#include <gtest/gtest.h>
+
+#include "typedefs.hpp"
+#include "cl_Cell.hpp"
+#include "cl_Vector.hpp"
+#include "fn_r2.hpp"
+
+#include "cl_Graph_Vertex.hpp"
+#include "cl_SpMatrix.hpp"
+#include "cl_Solver.hpp"
+
+using namespace belfem;
+
+extern belfem::Cell< belfem::graph::Vertex * > gGraph;
+
+//------------------------------------------------------------------------------
+
+/**
+ * solve the system of the CSC test twice, the second time with a slightly
+ * perturbed matrix, and then once more after a forced refactorization
+ */
+void
+test_factorization_reuse( const SolverType aType )
+{
+    SpMatrix tMatrix( gGraph, SpMatrixType::CSC );
+
+    tMatrix( 0, 0 ) =  1.0;
+    tMatrix( 1, 0 ) = -2.0;
+    tMatrix( 3, 0 ) = -4.0;
+    tMatrix( 0, 1 ) = -1.0;
+    tMatrix( 1, 1 ) =  5.0;
+    tMatrix( 4, 1 ) =  8.0;
+    tMatrix( 2, 2 ) =  4.0;
+    tMatrix( 3, 2 ) =  2.0;
+    tMatrix( 0, 3 ) = -3.0;
+    tMatrix( 2, 3 ) =  6.0;
+    tMatrix( 3, 3 ) =  7.0;
+    tMatrix( 2, 4 ) =  4.0;
+    tMatrix( 4, 4 ) = -5.0;
+
+    Vector<real> tY = { -13., 8., 56., 30., -9. };
+    Vector<real> tX( 5, 0.0 );
+    Vector<real> tExpect = { 1, 2, 3, 4, 5 };
+
+    Solver tSolver( aType );
+    tSolver.set_factorization_reuse( true, 10, 0.5, 1e-12 );
+
+    // first solve computes the factorization
+    tSolver.solve( tMatrix, tX, tY );
+    EXPECT_NEAR( r2( tX, tExpect ), 1.0, BELFEM_EPSILON );
+    EXPECT_EQ( tSolver.wrapper()->number_of_factorizations(), ( uint ) 1 );
+
+    // perturb the matrix slightly, the old factorization is reused
+    tMatrix( 1, 1 ) = 5.05;
+    tY( 1 ) = -2.0 + 5.05 * 2.0 ;
+    tSolver.solve( tMatrix, tX, tY );
+    EXPECT_NEAR( r2( tX, tExpect ), 1.0, BELFEM_EPSILON );
+    EXPECT_EQ( tSolver.wrapper()->number_of_factorizations(), ( uint ) 1 );
+
+    // a forced refactorization keeps the pattern, but uses the new values
+    tMatrix( 1, 1 ) = 6.0;
+    tY( 1 ) = -2.0 + 6.0 * 2.0 ;
+    tSolver.request_refactorization() ;
+    tSolver.solve( tMatrix, tX, tY );
+    EXPECT_NEAR( r2( tX, tExpect ), 1.0, BELFEM_EPSILON );
+    EXPECT_EQ( tSolver.wrapper()->number_of_factorizations(), ( uint ) 2 );
+
+    tSolver.free();
+}
+
+//------------------------------------------------------------------------------
+
+TEST( SPARSE, FACTORIZATION_REUSE )
+{
+#ifdef BELFEM_SUITESPARSE
+    test_factorization_reuse( SolverType::UMFPACK );
+#endif
+
+#ifdef BELFEM_MUMPS
+    test_factorization_reuse( SolverType::MUMPS );
+#endif
+}
+
+//------------------------------------------------------------------------------
+
+#ifdef BELFEM_SUITESPARSE
+/**
+ * solve the system of the CSC test with an UMFPACK ordering file
+ * and return the content of the key that is written next to it
+ */
+string
+solve_with_ordering( const SpMatrixType aType, const string & aPath, const bool aLoad )
+{
+    SpMatrix tMatrix( gGraph, aType );
+
+    tMatrix( 0, 0 ) =  1.0;
+    tMatrix( 1, 0 ) = -2.0;
+    tMatrix( 3, 0 ) = -4.0;
+    tMatrix( 0, 1 ) = -1.0;
+    tMatrix( 1, 1 ) =  5.0;
+    tMatrix( 4, 1 ) =  8.0;
+    tMatrix( 2, 2 ) =  4.0;
+    tMatrix( 3, 2 ) =  2.0;
+    tMatrix( 0, 3 ) = -3.0;
+    tMatrix( 2, 3 ) =  6.0;
+    tMatrix( 3, 3 ) =  7.0;
+    tMatrix( 2, 4 ) =  4.0;
+    tMatrix( 4, 4 ) = -5.0;
+
+    Vector<real> tY = { -13., 8., 56., 30., -9. };
+    Vector<real> tX( 5, 0.0 );
+    Vector<real> tExpect = { 1, 2, 3, 4, 5 };
+
+    Solver tSolver( SolverType::UMFPACK );
+    tSolver.wrapper()->set_ordering_file( aPath, aLoad );
+
+    tSolver.solve( tMatrix, tX, tY );
+    EXPECT_NEAR( r2( tX, tExpect ), 1.0, BELFEM_EPSILON );
+
+    tSolver.free();
+
+    std::ifstream tFile( aPath + ".key" );
+    string aKey ;
+    std::getline( tFile, aKey );
+
+    return aKey ;
+}
+#endif
+
+//------------------------------------------------------------------------------
+
+TEST( SPARSE, ORDERING_FILE )
+{
+#ifdef BELFEM_SUITESPARSE
+    string tPath = "/tmp/test_ordering.umf" ;
+    std::remove( tPath.c_str() );
+
+    // the first run writes the ordering and its key
+    string tKey = solve_with_ordering( SpMatrixType::CSC, tPath, true );
+    EXPECT_FALSE( tKey.empty() );
+
+    // the same pattern reads the ordering and keeps the key
+    EXPECT_EQ( solve_with_ordering( SpMatrixType::CSC, tPath, true ), tKey );
+
+    // another pattern drops the ordering and writes a new key
+    string tOtherKey = solve_with_ordering( SpMatrixType::CSR, tPath, true );
+    EXPECT_FALSE( tOtherKey.empty() );
+    EXPECT_NE( tOtherKey, tKey );
+#endif
+}
+
+//------------------------------------------------------------------------------
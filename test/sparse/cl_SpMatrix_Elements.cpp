@@ -0,0 +1,104 @@
+//
+// Created by Christian Messe on 17.10.26.
+//
+#include <gtest/gtest.h>
+
+#include "typedefs.hpp"
+#include "cl_Vector.hpp"
+#include "cl_SpMatrix.hpp"
+
+using namespace belfem;
+
+TEST( SPARSE, ELEMENTS )
+{
+    // a chain of four line elements, the last node is fixed
+    Vector< index_t > tOffsets = { 0, 2, 4, 6, 8 };
+    Vector< index_t > tNodes   = { 1, 0, 2, 1, 2, 3, 4, 3 };
+
+    Vector< index_t > tFree( tNodes.length() );
+    Vector< index_t > tFixed( tNodes.length() );
+
+    for( index_t k=0; k<tNodes.length(); ++k )
+    {
+        tFree( k )  = tNodes( k ) < 4 ? tNodes( k ) : gNoIndex ;
+        tFixed( k ) = tNodes( k ) < 4 ? gNoIndex : 0 ;
+    }
+
+    Vector< int > tExpectPointers = { 0, 2, 5, 8, 10 };
+    Vector< int > tExpectIndices  = { 0, 1, 0, 1, 2, 1, 2, 3, 2, 3 };
+
+    // the pattern is symmetric, so CSR and CSC must be identical
+    SpMatrix tCSR( tOffsets, tFree, tFree, SpMatrixType::CSR, 4, 4 );
+    SpMatrix tCSC( tOffsets, tFree, tFree, SpMatrixType::CSC, 4, 4, 0 );
+
+    EXPECT_EQ( tCSR.number_of_nonzeros(), 10u );
+    EXPECT_EQ( tCSC.number_of_nonzeros(), 10u );
+
+    for( uint k=0; k<5; ++k )
+    {
+        EXPECT_EQ( tCSR.pointers()[ k ], tExpectPointers( k ) );
+        EXPECT_EQ( tCSC.pointers()[ k ], tExpectPointers( k ) );
+    }
+
+    for( uint k=0; k<10; ++k )
+    {
+        EXPECT_EQ( tCSR.indices()[ k ], tExpectIndices( k ) );
+        EXPECT_EQ( tCSC.indices()[ k ], tExpectIndices( k ) );
+    }
+
+    // the Dirichlet matrix only couples row 3 with the fixed node
+    SpMatrix tDirichlet( tOffsets, tFree, tFixed, SpMatrixType::CSR, 4, 1 );
+
+    EXPECT_EQ( tDirichlet.number_of_nonzeros(), 1u );
+    EXPECT_EQ( tDirichlet.pointers()[ 3 ], 0 );
+    EXPECT_EQ( tDirichlet.pointers()[ 4 ], 1 );
+    EXPECT_EQ( tDirichlet.indices()[ 0 ], 0 );
+}
+
+TEST( SPARSE, LONG_INDICES )
+{
+    Vector< index_t > tOffsets = { 0, 2, 4, 6 };
+    Vector< index_t > tNodes   = { 1, 0, 2, 1, 2, 3 };
+
+    SpMatrix tInt( tOffsets, tNodes, tNodes, SpMatrixType::CSR, 4, 4 );
+    SpMatrix tLong( tOffsets, tNodes, tNodes, SpMatrixType::CSR, 4, 4, 0,
+                    SpMatrixIndexType::Int64 );
+
+    EXPECT_EQ( tLong.index_type(), SpMatrixIndexType::Int64 );
+    ASSERT_EQ( tInt.number_of_nonzeros(), tLong.number_of_nonzeros() );
+
+    for( uint k=0; k<5; ++k )
+    {
+        EXPECT_EQ( ( lsint ) tInt.pointers()[ k ], tLong.long_pointers()[ k ] );
+    }
+
+    for( uint k=0; k<tInt.number_of_nonzeros(); ++k )
+    {
+        EXPECT_EQ( ( lsint ) tInt.indices()[ k ], tLong.long_indices()[ k ] );
+        tInt.data()[ k ]  = 1.0 + k ;
+        tLong.data()[ k ] = 1.0 + k ;
+    }
+
+    // both index types must give the same products
+    Vector< real > tX = { 1.0, 2.0, 3.0, 4.0 };
+    Vector< real > tA( 4, 0.0 );
+    Vector< real > tB( 4, 0.0 );
+
+    tInt.multiply( tX, tA );
+    tLong.multiply( tX, tB );
+
+    for( uint k=0; k<4; ++k )
+    {
+        EXPECT_NEAR( tA( k ), tB( k ), 1e-12 );
+    }
+
+    tInt.multiply( tX, tA, 1.0, 0.0, true );
+    tLong.multiply( tX, tB, 1.0, 0.0, true );
+
+    for( uint k=0; k<4; ++k )
+    {
+        EXPECT_NEAR( tA( k ), tB( k ), 1e-12 );
+    }
+
+    EXPECT_EQ( tInt.index( 2, 1 ), tLong.index( 2, 1 ) );
+}
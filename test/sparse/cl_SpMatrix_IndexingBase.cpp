@@ -0,0 +1,119 @@
+//
+// Created by Christian Messe on 17.10.26.
+//
+#include <gtest/gtest.h>
+
+#include "typedefs.hpp"
+#include "cl_Cell.hpp"
+#include "cl_Vector.hpp"
+#include "cl_Matrix.hpp"
+#include "cl_Graph_Vertex.hpp"
+#include "cl_SpMatrix.hpp"
+
+using namespace belfem;
+
+extern belfem::Cell< belfem::graph::Vertex * > gGraph;
+
+//------------------------------------------------------------------------------
+
+/**
+ * write the values of the test matrix
+ */
+void
+fill_indexing_base_matrix( SpMatrix & aMatrix )
+{
+    aMatrix( 0, 0 ) =  1.0;
+    aMatrix( 1, 0 ) = -2.0;
+    aMatrix( 3, 0 ) = -4.0;
+    aMatrix( 0, 1 ) = -1.0;
+    aMatrix( 1, 1 ) =  5.0;
+    aMatrix( 4, 1 ) =  8.0;
+    aMatrix( 2, 2 ) =  4.0;
+    aMatrix( 3, 2 ) =  2.0;
+    aMatrix( 0, 3 ) = -3.0;
+    aMatrix( 2, 3 ) =  6.0;
+    aMatrix( 3, 3 ) =  7.0;
+    aMatrix( 2, 4 ) =  4.0;
+    aMatrix( 4, 4 ) = -5.0;
+}
+
+//------------------------------------------------------------------------------
+
+/**
+ * multiply the matrix in zero- and one-based indexing and compare
+ * with the dense products. The multiplication must not change
+ * the indexing base of the matrix.
+ */
+void
+test_indexing_base( const SpMatrixType aType )
+{
+    SpMatrix tMatrix( gGraph, aType );
+    fill_indexing_base_matrix( tMatrix );
+
+    Vector< real > tX = { 1, 2, 3, 4, 5 };
+
+    // y = A x and y = A^T x
+    Vector< real > tExpect           = { -13., 8., 56., 30., -9. };
+    Vector< real > tExpectTransposed = { -19., 49., 20., 43., -13. };
+
+    // previous content of y for beta != 0
+    Vector< real > tY0 = { 0.5, -1.5, 2.5, -3.5, 4.5 };
+
+    Matrix< real > tXX( 5, 2 );
+    for( uint k=0; k<5; ++k )
+    {
+        tXX( k, 0 ) = tX( k );
+        tXX( k, 1 ) = 2.0 * tX( k );
+    }
+
+    for( uint b=0; b<2; ++b )
+    {
+        SpMatrixIndexingBase tBase = b == 0 ?
+                SpMatrixIndexingBase::Cpp : SpMatrixIndexingBase::Fortran ;
+
+        tMatrix.set_indexing_base( tBase );
+        int tOffset = tMatrix.indexing_base() ;
+        EXPECT_EQ( tOffset, ( int ) b );
+
+        // y = 2 A x + 0.5 y0
+        Vector< real > tY( tY0 );
+        tMatrix.multiply( tX, tY, 2.0, 0.5 );
+        for( uint k=0; k<5; ++k )
+        {
+            EXPECT_NEAR( tY( k ), 2.0 * tExpect( k ) + 0.5 * tY0( k ), BELFEM_EPSILON );
+        }
+
+        // y = A^T x
+        tY.fill( 0.0 );
+        tMatrix.multiply( tX, tY, 1.0, 0.0, true );
+        for( uint k=0; k<5; ++k )
+        {
+            EXPECT_NEAR( tY( k ), tExpectTransposed( k ), BELFEM_EPSILON );
+        }
+
+        // Y = A X for a multi vector
+        Matrix< real > tYY( 5, 2, 0.0 );
+        tMatrix.multiply( tXX, tYY );
+        for( uint k=0; k<5; ++k )
+        {
+            EXPECT_NEAR( tYY( k, 0 ), tExpect( k ), BELFEM_EPSILON );
+            EXPECT_NEAR( tYY( k, 1 ), 2.0 * tExpect( k ), BELFEM_EPSILON );
+        }
+
+        // the index arrays are not touched by the products
+        EXPECT_EQ( tMatrix.indexing_base(), tOffset );
+
+        // the first entry of the first row or column is on the diagonal
+        EXPECT_EQ( tMatrix.indices()[ 0 ], tOffset );
+    }
+}
+
+//------------------------------------------------------------------------------
+
+TEST( SPARSE, INDEXING_BASE )
+{
+    test_indexing_base( SpMatrixType::CSR );
+    test_indexing_base( SpMatrixType::CSC );
+}
+
+//------------------------------------------------------------------------------
@@ -0,0 +1,168 @@
+//
+// Created by Christian Messe on 17.10.26.
+//
+#include <cmath>
+#include <gtest/gtest.h>
+
+#include "typedefs.hpp"
+#include "cl_Cell.hpp"
+#include "cl_Vector.hpp"
+#include "cl_Matrix.hpp"
+#include "cl_Graph_Vertex.hpp"
+#include "cl_SpMatrix.hpp"
+
+using namespace belfem;
+
+extern belfem::Cell< belfem::graph::Vertex * > gGraph;
+
+//------------------------------------------------------------------------------
+
+TEST( SPARSE, CSC_MULTIPLY )
+{
+    SpMatrix tMatrix( gGraph, SpMatrixType::CSC );
+
+    tMatrix( 0, 0 ) =  1.0;
+    tMatrix( 1, 0 ) = -2.0;
+    tMatrix( 3, 0 ) = -4.0;
+    tMatrix( 0, 1 ) = -1.0;
+    tMatrix( 1, 1 ) =  5.0;
+    tMatrix( 4, 1 ) =  8.0;
+    tMatrix( 2, 2 ) =  4.0;
+    tMatrix( 3, 2 ) =  2.0;
+    tMatrix( 0, 3 ) = -3.0;
+    tMatrix( 2, 3 ) =  6.0;
+    tMatrix( 3, 3 ) =  7.0;
+    tMatrix( 2, 4 ) =  4.0;
+    tMatrix( 4, 4 ) = -5.0;
+
+    Vector< real > tX = { 1, 2, 3, 4, 5 };
+    Vector< real > tY( 5 );
+
+    // transposed product
+    tMatrix.multiply( tX, tY, 1.0, 0.0, true );
+    EXPECT_TRUE( tY == Vector<real>( { -19., 49., 20., 43., -13. } ));
+
+    // multi vector product
+    Matrix< real > tXX( 5, 2 );
+    Matrix< real > tYY( 5, 2, 0.0 );
+    for( uint k=0; k<5; ++k )
+    {
+        tXX( k, 0 ) = tX( k );
+        tXX( k, 1 ) = 2.0 * tX( k );
+    }
+    tMatrix.multiply( tXX, tYY );
+
+    Vector< real > tExpect = { -13., 8., 56., 30., -9. };
+    for( uint k=0; k<5; ++k )
+    {
+        EXPECT_NEAR( tYY( k, 0 ), tExpect( k ), BELFEM_EPSILON );
+        EXPECT_NEAR( tYY( k, 1 ), 2.0 * tExpect( k ), BELFEM_EPSILON );
+    }
+}
+
+//------------------------------------------------------------------------------
+
+TEST( SPARSE, THREADED_MULTIPLY )
+{
+    // a tridiagonal matrix that is large enough for the threaded kernels
+    index_t tN = 20000 ;
+
+    Vector< index_t > tOffsets( tN, 0 );
+    Vector< index_t > tNodes( 2 * ( tN - 1 ) );
+    for( index_t e=0; e<tN-1; ++e )
+    {
+        tOffsets( e + 1 ) = 2 * ( e + 1 );
+        tNodes( 2 * e )     = e ;
+        tNodes( 2 * e + 1 ) = e + 1 ;
+    }
+
+    SpMatrix tCSR( tOffsets, tNodes, tNodes, SpMatrixType::CSR, tN, tN );
+    SpMatrix tCSC( tOffsets, tNodes, tNodes, SpMatrixType::CSC, tN, tN );
+
+    // unsymmetric values
+    Vector< real > tLower( tN, 0.0 );
+    Vector< real > tDiag( tN );
+    Vector< real > tUpper( tN, 0.0 );
+
+    for( index_t i=0; i<tN; ++i )
+    {
+        tDiag( i ) = 4.0 + 0.001 * i ;
+        tCSR( i, i ) = tDiag( i );
+        tCSC( i, i ) = tDiag( i );
+
+        if( i > 0 )
+        {
+            tLower( i ) = -1.0 - 0.002 * ( i % 7 );
+            tCSR( i, i - 1 ) = tLower( i );
+            tCSC( i, i - 1 ) = tLower( i );
+        }
+        if( i < tN - 1 )
+        {
+            tUpper( i ) = -2.0 + 0.003 * ( i % 5 );
+            tCSR( i, i + 1 ) = tUpper( i );
+            tCSC( i, i + 1 ) = tUpper( i );
+        }
+    }
+
+    Vector< real > tX( tN );
+    for( index_t i=0; i<tN; ++i )
+    {
+        tX( i ) = 1.0 + 0.5 * std::sin( 0.01 * i );
+    }
+
+    // y = A x and y = A^T x
+    Vector< real > tExpect( tN );
+    Vector< real > tExpectTransposed( tN );
+    for( index_t i=0; i<tN; ++i )
+    {
+        tExpect( i ) = tDiag( i ) * tX( i );
+        tExpectTransposed( i ) = tDiag( i ) * tX( i );
+        if( i > 0 )
+        {
+            tExpect( i ) += tLower( i ) * tX( i - 1 );
+            tExpectTransposed( i ) += tUpper( i - 1 ) * tX( i - 1 );
+        }
+        if( i < tN - 1 )
+        {
+            tExpect( i ) += tUpper( i ) * tX( i + 1 );
+            tExpectTransposed( i ) += tLower( i + 1 ) * tX( i + 1 );
+        }
+    }
+
+    // the scatter products run twice, so that the second one
+    // works with the buffers allocated by the first one
+    for( uint r=0; r<2; ++r )
+    {
+        Vector< real > tY( tN, 1.0 );
+
+        // scatter kernel
+        tCSC.multiply( tX, tY, 1.0, ( real ) r );
+        for( index_t i=0; i<tN; ++i )
+        {
+            EXPECT_NEAR( tY( i ), tExpect( i ) + r, 1e-12 );
+        }
+
+        // scatter kernel
+        tY.fill( 1.0 );
+        tCSR.multiply( tX, tY, 1.0, ( real ) r, true );
+        for( index_t i=0; i<tN; ++i )
+        {
+            EXPECT_NEAR( tY( i ), tExpectTransposed( i ) + r, 1e-12 );
+        }
+
+        // gather kernels
+        tCSR.multiply( tX, tY );
+        for( index_t i=0; i<tN; ++i )
+        {
+            EXPECT_NEAR( tY( i ), tExpect( i ), 1e-12 );
+        }
+
+        tCSC.multiply( tX, tY, 1.0, 0.0, true );
+        for( index_t i=0; i<tN; ++i )
+        {
+            EXPECT_NEAR( tY( i ), tExpectTransposed( i ), 1e-12 );
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
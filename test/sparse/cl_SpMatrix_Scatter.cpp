@@ -0,0 +1,52 @@
+//
+// Created by Christian Messe on 17.10.26.
+//
+#include <gtest/gtest.h>
+
+#include "typedefs.hpp"
+#include "cl_Cell.hpp"
+#include "cl_Vector.hpp"
+#include "cl_Matrix.hpp"
+
+#include "cl_Graph_Vertex.hpp"
+#include "cl_SpMatrix.hpp"
+
+using namespace belfem;
+
+extern belfem::Cell< belfem::graph::Vertex * > gGraph;
+
+TEST( SPARSE, SCATTER )
+{
+    // create the matrix
+    SpMatrix tMatrix( gGraph, SpMatrixType::CSC );
+    tMatrix.fill( 0.0 );
+
+    // element matrix connecting dofs 0 and 1
+    Matrix< real > tKe = { { 1.0, 2.0 }, { 3.0, 4.0 } };
+
+    // table is stored column wise
+    Vector< index_t > tTable( 4 );
+    tTable( 0 ) = tMatrix.index( 0, 0 );
+    tTable( 1 ) = tMatrix.index( 1, 0 );
+    tTable( 2 ) = tMatrix.index( 0, 1 );
+    tTable( 3 ) = tMatrix.index( 1, 1 );
+
+    // add element twice
+    tMatrix.scatter_add( tTable, tKe );
+    tMatrix.scatter_add( tTable, tKe );
+
+    EXPECT_NEAR( tMatrix( 0, 0 ), 2.0, BELFEM_EPSILON );
+    EXPECT_NEAR( tMatrix( 1, 0 ), 6.0, BELFEM_EPSILON );
+    EXPECT_NEAR( tMatrix( 0, 1 ), 4.0, BELFEM_EPSILON );
+    EXPECT_NEAR( tMatrix( 1, 1 ), 8.0, BELFEM_EPSILON );
+
+    // skip the second row and subtract
+    tTable( 1 ) = gNoIndex ;
+    tTable( 3 ) = gNoIndex ;
+    tMatrix.scatter_add( tTable, tKe, -1.0 );
+
+    EXPECT_NEAR( tMatrix( 0, 0 ), 1.0, BELFEM_EPSILON );
+    EXPECT_NEAR( tMatrix( 1, 0 ), 6.0, BELFEM_EPSILON );
+    EXPECT_NEAR( tMatrix( 0, 1 ), 2.0, BELFEM_EPSILON );
+    EXPECT_NEAR( tMatrix( 1, 1 ), 8.0, BELFEM_EPSILON );
+}
@@ -14,6 +14,7 @@
 #include "cl_Vector.hpp"
 #include "cl_Spline.hpp"
 #include "cl_SpMatrix.hpp"
+#include "cl_Solver.hpp"
 
 using namespace belfem;
 
@@ -176,4 +177,101 @@ TEST( Spline, spline )
     EXPECT_TRUE(  tR2dCpdT < 2e-3 );  // 0.00157442
     EXPECT_TRUE(  tR2S     < 1e-6 );  // 8.03886e-08
     EXPECT_TRUE(  tR2dSdT  < 1e-9 );  // 4.63261e-12
-}
\ No newline at end of file
+}
+
+//------------------------------------------------------------------------------
+
+TEST( Spline, batch )
+{
+    // same grid as above
+    uint tN = 116 ;
+
+    Vector< real > tX( tN );
+    Vector< real > tY( tN );
+
+    for ( uint k=0; k<tN; ++k )
+    {
+        tX( k ) = 195.0 + 7.0 * k ;
+        tY( k ) = h0( tX( k ) );
+    }
+
+    SpMatrix tHelpMatrix;
+    spline::create_helpmatrix( tN, 7.0, tHelpMatrix );
+
+    Spline tSpline( tX, tY, tHelpMatrix, 273.15, s0( 273.25 ) );
+
+    // an odd number of points, also on the grid points and the boundaries
+    uint tM = 101 ;
+    Vector< real > tT( tM );
+    for ( uint k=0; k<tM; ++k )
+    {
+        tT( k ) = 195.0 + 805.0 * k / ( real ) ( tM - 1 );
+    }
+
+    Vector< real > tValues ;
+    Vector< real > tDerivatives ;
+    Vector< real > tSecondDerivatives ;
+
+    tSpline.eval( tT, tValues );
+    tSpline.deval( tT, tDerivatives );
+    tSpline.ddeval( tT, tSecondDerivatives );
+
+    ASSERT_EQ( tValues.length(), tM );
+    ASSERT_EQ( tDerivatives.length(), tM );
+    ASSERT_EQ( tSecondDerivatives.length(), tM );
+
+    for ( uint k=0; k<tM; ++k )
+    {
+        real tExpect = tSpline.eval( tT( k ) );
+        EXPECT_NEAR( tValues( k ), tExpect, 1e-14 * std::abs( tExpect ) );
+
+        tExpect = tSpline.deval( tT( k ) );
+        EXPECT_NEAR( tDerivatives( k ), tExpect, 1e-14 * std::abs( tExpect ) );
+
+        tExpect = tSpline.ddeval( tT( k ) );
+        EXPECT_NEAR( tSecondDerivatives( k ), tExpect, 1e-14 * std::abs( tExpect ) );
+    }
+}
+
+//------------------------------------------------------------------------------
+
+TEST( Spline, helpmatrix )
+{
+    // the Thomas algorithm must give the same result as a direct solver
+    uint tN = 57 ;
+
+    SpMatrix tHelpMatrix;
+    spline::create_helpmatrix( tN, 0.5, tHelpMatrix );
+
+    Vector< real > tB( tN );
+    for ( uint k=0; k<tN; ++k )
+    {
+        tB( k ) = std::sin( 0.3 * k ) + 0.01 * k ;
+    }
+
+    Vector< real > tThomas ;
+    spline::solve_helpmatrix( tHelpMatrix, tB, tThomas );
+
+    // the solver may change the matrix, so it gets its own one
+    SpMatrix tMatrix;
+    spline::create_helpmatrix( tN, 0.5, tMatrix );
+    Vector< real > tRHS( tB );
+    Vector< real > tDirect( tN, 0.0 );
+
+    Solver tSolver( SolverType::UMFPACK );
+    tSolver.solve( tMatrix, tDirect, tRHS );
+    tSolver.free();
+
+    ASSERT_EQ( tThomas.length(), tN );
+
+    real tScale = 0.0 ;
+    for ( uint k=0; k<tN; ++k )
+    {
+        tScale = std::max( tScale, std::abs( tDirect( k ) ) );
+    }
+
+    for ( uint k=0; k<tN; ++k )
+    {
+        EXPECT_NEAR( tThomas( k ), tDirect( k ), 1e-12 * tScale );
+    }
+}